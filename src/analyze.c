@@ -377,7 +377,12 @@ static inline void declAny (nodeType objects)
 
 
 
-static striType getProgramName (const const_striType sourceFileArgument)
+/**
+ *  Determine the name of a program from its source file argument.
+ *  The path and the extension .sd7 or .s7i are removed.
+ *  @return the name of the program, or NULL if there is not enough memory.
+ */
+striType getProgramName (const const_striType sourceFileArgument)
 
   {
     memSizeType nameLen;
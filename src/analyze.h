@@ -25,6 +25,7 @@
 /*                                                                  */
 /********************************************************************/
 
+striType getProgramName (const const_striType sourceFileArgument);
 progType analyzeFile (const const_striType sourceFileArgument, uintType options,
     const const_rtlArrayType libraryDirs, const const_striType protFileName,
     errInfoType *err_info);
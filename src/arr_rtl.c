@@ -55,6 +55,7 @@
 #include "str_rtl.h"
 #include "cmd_rtl.h"
 #include "cmd_drv.h"
+#include "numutl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -263,6 +264,52 @@ static rtlArrayType copyArgv (const int argc, const os_striType *const argv)
 
 
 
+/**
+ *  Take the name and the path of the program from the environment.
+ *  The interpreter option -n starts a native executable from its
+ *  cache with the environment variables SEED7_PROGRAM_NAME and
+ *  SEED7_PROGRAM_PATH. They describe the source file, such that
+ *  name(PROGRAM), path(PROGRAM) and dir(PROGRAM) return the same
+ *  values as in the interpreter. The variables are removed, such
+ *  that child processes do not inherit them.
+ *  @param programName Program name, which is replaced, if the
+ *         environment variables are set.
+ *  @param exePath Path of the executable, which is replaced, if
+ *         the environment variables are set.
+ */
+static void getSourceIdentity (striType *programName, striType *exePath)
+
+  {
+    striType nameVariable;
+    striType pathVariable;
+    striType name = NULL;
+    striType path = NULL;
+
+  /* getSourceIdentity */
+    nameVariable = CSTRI_LITERAL_TO_STRI("SEED7_PROGRAM_NAME");
+    pathVariable = CSTRI_LITERAL_TO_STRI("SEED7_PROGRAM_PATH");
+    if (nameVariable != NULL && pathVariable != NULL) {
+      name = cmdGetenv(nameVariable);
+      path = cmdGetenv(pathVariable);
+      if (name != NULL && path != NULL && name->size != 0 && path->size != 0) {
+        cmdUnsetenv(nameVariable);
+        cmdUnsetenv(pathVariable);
+        FREE_STRI(*programName, (*programName)->size);
+        *programName = name;
+        name = NULL;
+        FREE_STRI(*exePath, (*exePath)->size);
+        *exePath = path;
+        path = NULL;
+      } /* if */
+    } /* if */
+    strDestr(name);
+    strDestr(path);
+    strDestr(nameVariable);
+    strDestr(pathVariable);
+  } /* getSourceIdentity */
+
+
+
 /**
  *  Get the Seed7 argument vector of a program.
  *  The name of the program is not part of the Seed7 argument vector.
@@ -320,6 +367,10 @@ rtlArrayType getArgv (const int argc, const utf16striType *const argv,
             err_info = MEMORY_ERROR;
           } /* if */
         } /* if */
+        if (programName != NULL && exePath != NULL &&
+            err_info == OKAY_NO_ERROR) {
+          getSourceIdentity(programName, exePath);
+        } /* if */
         if (arg_0 != NULL) {
           *arg_0 = arg_0_temp;
         } else {
@@ -399,6 +450,10 @@ rtlArrayType getArgv (const int argc, const cstriType *const argv,
               err_info = MEMORY_ERROR;
             } /* if */
           } /* if */
+          if (programName != NULL && exePath != NULL &&
+              err_info == OKAY_NO_ERROR) {
+            getSourceIdentity(programName, exePath);
+          } /* if */
           if (arg_0 != NULL) {
             *arg_0 = arg_0_temp;
           } else {
@@ -473,6 +528,10 @@ rtlArrayType getArgv (const int argc, const cstriType *const argv,
             err_info = MEMORY_ERROR;
           } /* if */
         } /* if */
+        if (programName != NULL && exePath != NULL &&
+            err_info == OKAY_NO_ERROR) {
+          getSourceIdentity(programName, exePath);
+        } /* if */
         if (arg_0 != NULL) {
           *arg_0 = arg_0_temp;
         } else {
@@ -1591,6 +1650,142 @@ rtlArrayType arrSort (rtlArrayType arr1, compareType cmp_func)
 
 
 
+/**
+ *  Sort an array of integer elements in ascending order.
+ *  The elements are unboxed into a dense intType buffer, sorted
+ *  without calling a compare function and stored back afterwards.
+ *  @return the sorted array (the same as arr1).
+ *  @exception MEMORY_ERROR Not enough memory for the sort buffer.
+ */
+rtlArrayType arrSortInt (rtlArrayType arr1)
+
+  {
+    memSizeType arr1_size;
+    memSizeType pos;
+    intType *buffer;
+
+  /* arrSortInt */
+    arr1_size = arraySize(arr1);
+    if (arr1_size > 1) {
+      if (unlikely(!ALLOC_TABLE(buffer, intType, arr1_size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        for (pos = 0; pos < arr1_size; pos++) {
+          buffer[pos] = arr1->arr[pos].value.intValue;
+        } /* for */
+        sortIntArray(buffer, arr1_size);
+        for (pos = 0; pos < arr1_size; pos++) {
+          arr1->arr[pos].value.intValue = buffer[pos];
+        } /* for */
+        FREE_TABLE(buffer, intType, arr1_size);
+      } /* if */
+    } /* if */
+    return arr1;
+  } /* arrSortInt */
+
+
+
+/**
+ *  Sort an array of bin32 or bin64 elements in ascending order.
+ *  The elements are compared as unsigned values.
+ *  @return the sorted array (the same as arr1).
+ *  @exception MEMORY_ERROR Not enough memory for the sort buffer.
+ */
+rtlArrayType arrSortBin (rtlArrayType arr1)
+
+  {
+    memSizeType arr1_size;
+    memSizeType pos;
+    uintType *buffer;
+
+  /* arrSortBin */
+    arr1_size = arraySize(arr1);
+    if (arr1_size > 1) {
+      if (unlikely(!ALLOC_TABLE(buffer, uintType, arr1_size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        for (pos = 0; pos < arr1_size; pos++) {
+          buffer[pos] = arr1->arr[pos].value.binaryValue;
+        } /* for */
+        sortUIntArray(buffer, arr1_size);
+        for (pos = 0; pos < arr1_size; pos++) {
+          arr1->arr[pos].value.binaryValue = buffer[pos];
+        } /* for */
+        FREE_TABLE(buffer, uintType, arr1_size);
+      } /* if */
+    } /* if */
+    return arr1;
+  } /* arrSortBin */
+
+
+
+/**
+ *  Sort an array of char elements in ascending order.
+ *  @return the sorted array (the same as arr1).
+ *  @exception MEMORY_ERROR Not enough memory for the sort buffer.
+ */
+rtlArrayType arrSortChr (rtlArrayType arr1)
+
+  {
+    memSizeType arr1_size;
+    memSizeType pos;
+    uintType *buffer;
+
+  /* arrSortChr */
+    arr1_size = arraySize(arr1);
+    if (arr1_size > 1) {
+      if (unlikely(!ALLOC_TABLE(buffer, uintType, arr1_size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        for (pos = 0; pos < arr1_size; pos++) {
+          buffer[pos] = arr1->arr[pos].value.charValue;
+        } /* for */
+        sortUIntArray(buffer, arr1_size);
+        for (pos = 0; pos < arr1_size; pos++) {
+          arr1->arr[pos].value.charValue = (charType) buffer[pos];
+        } /* for */
+        FREE_TABLE(buffer, uintType, arr1_size);
+      } /* if */
+    } /* if */
+    return arr1;
+  } /* arrSortChr */
+
+
+
+/**
+ *  Sort an array of float elements in ascending order.
+ *  NaN elements are sorted to the end, as fltCmp() does it.
+ *  @return the sorted array (the same as arr1).
+ *  @exception MEMORY_ERROR Not enough memory for the sort buffer.
+ */
+rtlArrayType arrSortFlt (rtlArrayType arr1)
+
+  {
+    memSizeType arr1_size;
+    memSizeType pos;
+    floatType *buffer;
+
+  /* arrSortFlt */
+    arr1_size = arraySize(arr1);
+    if (arr1_size > 1) {
+      if (unlikely(!ALLOC_TABLE(buffer, floatType, arr1_size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        for (pos = 0; pos < arr1_size; pos++) {
+          buffer[pos] = arr1->arr[pos].value.floatValue;
+        } /* for */
+        sortFltArray(buffer, arr1_size);
+        for (pos = 0; pos < arr1_size; pos++) {
+          arr1->arr[pos].value.floatValue = buffer[pos];
+        } /* for */
+        FREE_TABLE(buffer, floatType, arr1_size);
+      } /* if */
+    } /* if */
+    return arr1;
+  } /* arrSortFlt */
+
+
+
 /**
  *  Get a sub array from the position 'start' with maximum length 'length'.
  *  @return the sub array from position 'start' with maximum length 'length'.
@@ -60,6 +60,10 @@ rtlArrayType arrRealloc (rtlArrayType arr, memSizeType oldSize, memSizeType newS
 genericType arrRemove (rtlArrayType *arr_to, intType position);
 rtlArrayType arrRemoveArray (rtlArrayType *arr_to, intType position, intType length);
 rtlArrayType arrSort (rtlArrayType arr1, compareType cmp_func);
+rtlArrayType arrSortBin (rtlArrayType arr1);
+rtlArrayType arrSortChr (rtlArrayType arr1);
+rtlArrayType arrSortFlt (rtlArrayType arr1);
+rtlArrayType arrSortInt (rtlArrayType arr1);
 rtlArrayType arrSubarr (const const_rtlArrayType arr1, intType start, intType len);
 rtlArrayType arrSubarrTemp (rtlArrayType *arr_temp, intType start, intType len);
 rtlArrayType arrTail (const const_rtlArrayType arr1, intType start);
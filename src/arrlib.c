@@ -36,13 +36,20 @@
 
 #include "common.h"
 #include "data.h"
+#include "data_rtl.h"
 #include "heaputl.h"
 #include "flistutl.h"
 #include "syvarutl.h"
+#include "arrutl.h"
 #include "traceutl.h"
 #include "executl.h"
 #include "objutl.h"
 #include "runerr.h"
+#include "intlib.h"
+#include "fltlib.h"
+#include "chrlib.h"
+#include "binlib.h"
+#include "arr_rtl.h"
 
 #undef EXTERN
 #define EXTERN
@@ -126,6 +133,56 @@ static void qsort_array (objectType begin_sort, objectType end_sort,
 
 
 
+/**
+ *  Sort an array of integer, float, char, bin32 or bin64 elements.
+ *  The elements are sorted with arrSortInt, arrSortFlt, arrSortChr
+ *  or arrSortBin, without calling the Seed7 compare function for
+ *  every comparison.
+ *  @param arr1 Array to be sorted in place.
+ *  @param cmp_action Action of the compare function of the elements.
+ *  @param err_info Set to MEMORY_ERROR if the rtl array cannot be allocated.
+ *  @return TRUE if the array has been sorted, or
+ *          FALSE if there is no unboxed sort for the compare action.
+ */
+static boolType unboxed_sort (arrayType arr1, actType cmp_action,
+    errInfoType *err_info)
+
+  {
+    memSizeType arr1_size;
+    memSizeType pos;
+    rtlArrayType rtlArray;
+
+  /* unboxed_sort */
+    if (cmp_action != int_cmp && cmp_action != bin_cmp &&
+        cmp_action != chr_cmp && cmp_action != flt_cmp) {
+      return FALSE;
+    } /* if */
+    arr1_size = arraySize(arr1);
+    if (arr1_size > 1) {
+      rtlArray = gen_rtl_array(arr1);
+      if (unlikely(rtlArray == NULL)) {
+        *err_info = MEMORY_ERROR;
+      } else {
+        if (cmp_action == int_cmp) {
+          arrSortInt(rtlArray);
+        } else if (cmp_action == flt_cmp) {
+          arrSortFlt(rtlArray);
+        } else if (cmp_action == chr_cmp) {
+          arrSortChr(rtlArray);
+        } else {
+          arrSortBin(rtlArray);
+        } /* if */
+        for (pos = 0; pos < arr1_size; pos++) {
+          arr1->arr[pos].value.striValue = rtlArray->arr[pos].value.striValue;
+        } /* for */
+        FREE_RTL_ARRAY(rtlArray, arr1_size);
+      } /* if */
+    } /* if */
+    return TRUE;
+  } /* unboxed_sort */
+
+
+
 /**
  *  Append the array 'extension' to the array 'arr_variable'.
  *  @exception MEMORY_ERROR Not enough memory for the concatenated
@@ -1400,6 +1457,7 @@ objectType arr_sort (listType arguments)
     arrayType arr1;
     memSizeType result_size;
     arrayType result;
+    errInfoType err_info = OKAY_NO_ERROR;
 
   /* arr_sort */
     arr_arg = arg_1(arguments);
@@ -1421,9 +1479,15 @@ objectType arr_sort (listType arguments)
         return raise_with_arguments(SYS_MEM_EXCEPTION, arguments);
       } /* if */
     } /* if */
-    qsort_array(result->arr,
-        &result->arr[result->max_position - result->min_position],
-        data_cmp_func);
+    if (CATEGORY_OF_OBJ(data_cmp_func) != ACTOBJECT ||
+        !unboxed_sort(result, take_action(data_cmp_func), &err_info)) {
+      qsort_array(result->arr,
+          &result->arr[result->max_position - result->min_position],
+          data_cmp_func);
+    } else if (unlikely(err_info != OKAY_NO_ERROR)) {
+      FREE_ARRAY(result, arraySize(result));
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } /* if */
     return bld_array_temp(result);
   } /* arr_sort */
 
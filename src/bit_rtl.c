@@ -0,0 +1,679 @@
+/********************************************************************/
+/*                                                                  */
+/*  bit_rtl.c     Primitive actions for bit streams and Huffman.    */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/bit_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for bit streams and Huffman codes.   */
+/*                                                                  */
+/*  A bit reader keeps up to 64 bits of the data in a buffer. The   */
+/*  data itself stays in a string of bytes and is passed to every   */
+/*  call together with the position of the next byte that has not   */
+/*  been loaded into the buffer. Bits can be read with the least    */
+/*  significant bit first (LSB) or with the most significant bit    */
+/*  first (MSB). If the string does not contain enough bits for a   */
+/*  request nothing is consumed and BITS_MISSING is returned. The   */
+/*  caller can then append data to the string and try again.        */
+/*                                                                  */
+/*  A Huffman decode table is created from a lookup table that is   */
+/*  indexed with the next maxBits bits. The primary table is        */
+/*  indexed with the next PRIMARY_BITS bits. Codes that are longer  */
+/*  refer to a secondary table that is indexed with the following   */
+/*  bits. Both tables are only as large as necessary.               */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "bit_rtl.h"
+
+
+#define BIT_READER_MAGIC     0x62697472
+#define HUFFMAN_TABLE_MAGIC  0x68756666
+#define BITS_MISSING         INTTYPE_MIN
+#define MAX_GET_BITS         57
+#define PRIMARY_BITS         10
+#define MAX_HUFFMAN_BITS     24
+#define INVALID_LENGTH       255
+
+typedef struct {
+    uint32Type magic;
+    boolType msbFirst;
+    unsigned int bitCount;
+    uint64Type buffer;
+  } bitReaderRecord, *bitReaderType;
+
+typedef struct {
+    intType symbol;
+    uint16Type length;
+    uint16Type subBits;
+  } huffmanEntryRecord, *huffmanEntryType;
+
+typedef const huffmanEntryRecord *const_huffmanEntryType;
+
+typedef struct {
+    uint32Type magic;
+    boolType msbFirst;
+    unsigned int maxBits;
+    unsigned int primaryBits;
+    memSizeType numEntries;
+  } huffmanTableRecord, *huffmanTableType;
+
+typedef const huffmanTableRecord *const_huffmanTableType;
+
+#define HUFFMAN_ENTRIES(table) ((const_huffmanEntryType) &(table)[1])
+
+
+
+static inline bitReaderType getReader (const bstriType reader)
+
+  {
+    bitReaderType bitReader;
+
+  /* getReader */
+    bitReader = (bitReaderType) reader->mem;
+    if (unlikely(reader->size != sizeof(bitReaderRecord) ||
+                 bitReader->magic != BIT_READER_MAGIC)) {
+      logError(printf("getReader: Illegal bit reader.\n"););
+      raise_error(RANGE_ERROR);
+      bitReader = NULL;
+    } /* if */
+    return bitReader;
+  } /* getReader */
+
+
+
+/**
+ *  Load bytes from stri[*bytePos] into the buffer of the reader.
+ *  Bytes are loaded as long as there is room for a whole byte.
+ *  @return TRUE if the bytes could be loaded, FALSE if stri
+ *          contains a character that is not a byte.
+ */
+static boolType refill (bitReaderType bitReader, const const_striType stri,
+    intType *const bytePos)
+
+  {
+    memSizeType pos;
+    uint64Type buffer;
+    unsigned int bitCount;
+    strElemType ch;
+    boolType okay = TRUE;
+
+  /* refill */
+    pos = (memSizeType) *bytePos - 1;
+    buffer = bitReader->buffer;
+    bitCount = bitReader->bitCount;
+    if (bitReader->msbFirst) {
+      while (bitCount <= 56 && pos < stri->size) {
+        ch = stri->mem[pos];
+        if (unlikely(ch > 255)) {
+          okay = FALSE;
+          break;
+        } /* if */
+        buffer |= (uint64Type) ch << (56 - bitCount);
+        bitCount += 8;
+        pos++;
+      } /* while */
+    } else {
+      while (bitCount <= 56 && pos < stri->size) {
+        ch = stri->mem[pos];
+        if (unlikely(ch > 255)) {
+          okay = FALSE;
+          break;
+        } /* if */
+        buffer |= (uint64Type) ch << bitCount;
+        bitCount += 8;
+        pos++;
+      } /* while */
+    } /* if */
+    bitReader->buffer = buffer;
+    bitReader->bitCount = bitCount;
+    *bytePos = (intType) pos + 1;
+    return okay;
+  } /* refill */
+
+
+
+static inline uint64Type peekBuffer (const bitReaderType bitReader,
+    unsigned int bitWidth)
+
+  { /* peekBuffer */
+    if (bitWidth == 0) {
+      return 0;
+    } else if (bitReader->msbFirst) {
+      return bitReader->buffer >> (64 - bitWidth);
+    } else if (bitWidth == 64) {
+      return bitReader->buffer;
+    } else {
+      return bitReader->buffer & (((uint64Type) 1 << bitWidth) - 1);
+    } /* if */
+  } /* peekBuffer */
+
+
+
+static inline void consume (bitReaderType bitReader, unsigned int bitWidth)
+
+  { /* consume */
+    if (bitWidth == 64) {
+      bitReader->buffer = 0;
+    } else if (bitReader->msbFirst) {
+      bitReader->buffer <<= bitWidth;
+    } else {
+      bitReader->buffer >>= bitWidth;
+    } /* if */
+    bitReader->bitCount -= bitWidth;
+  } /* consume */
+
+
+
+/**
+ *  Check the parameters of a bit reader function and make sure
+ *  that the buffer contains at least bitWidth bits if possible.
+ *  @return the bit reader or NULL if an exception has been raised.
+ */
+static bitReaderType prepare (const bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth)
+
+  {
+    bitReaderType bitReader;
+
+  /* prepare */
+    bitReader = getReader(reader);
+    if (bitReader != NULL) {
+      if (unlikely(*bytePos <= 0 || bitWidth < 0 || bitWidth > MAX_GET_BITS)) {
+        logError(printf("prepare: Illegal bytePos (" FMT_D ") or bitWidth ("
+                        FMT_D ").\n", *bytePos, bitWidth););
+        raise_error(RANGE_ERROR);
+        bitReader = NULL;
+      } else if (bitReader->bitCount < (unsigned int) bitWidth &&
+                 unlikely(!refill(bitReader, stri, bytePos))) {
+        logError(printf("prepare: Character > 255 in data.\n"););
+        raise_error(RANGE_ERROR);
+        bitReader = NULL;
+      } /* if */
+    } /* if */
+    return bitReader;
+  } /* prepare */
+
+
+
+/**
+ *  Move to the next byte boundary of the data.
+ *  Bits of a partially read byte are skipped. Whole bytes in the
+ *  buffer are given back, such that *bytePos refers to the first
+ *  byte that has not been read.
+ *  @param reader Bit reader state created with bitReaderInit.
+ *  @param bytePos Position of the next byte that is not in the buffer.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state.
+ */
+void bitAlign (bstriType reader, intType *const bytePos)
+
+  {
+    bitReaderType bitReader;
+
+  /* bitAlign */
+    logFunction(printf("bitAlign(*, " FMT_D ")\n", *bytePos););
+    bitReader = getReader(reader);
+    if (bitReader != NULL) {
+      *bytePos -= (intType) (bitReader->bitCount >> 3);
+      bitReader->buffer = 0;
+      bitReader->bitCount = 0;
+    } /* if */
+  } /* bitAlign */
+
+
+
+/**
+ *  Get bitWidth bits from the bit reader.
+ *  @param reader Bit reader state created with bitReaderInit.
+ *  @param stri String of bytes with the data.
+ *  @param bytePos Position of the next byte in stri that is not in the buffer.
+ *  @param bitWidth Number of bits requested (0 to 57).
+ *  @return the bits read, or BITS_MISSING (nothing has been read) if
+ *          stri does not contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is not in the allowed
+ *             range or stri contains a character that is not a byte.
+ */
+intType bitGetBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth)
+
+  {
+    bitReaderType bitReader;
+    intType resultBits;
+
+  /* bitGetBits */
+    logFunction(printf("bitGetBits(*, *, " FMT_D ", " FMT_D ")\n",
+                       *bytePos, bitWidth););
+    bitReader = prepare(reader, stri, bytePos, bitWidth);
+    if (unlikely(bitReader == NULL)) {
+      resultBits = 0;
+    } else if (unlikely(bitReader->bitCount < (unsigned int) bitWidth)) {
+      resultBits = BITS_MISSING;
+    } else {
+      resultBits = (intType) peekBuffer(bitReader, (unsigned int) bitWidth);
+      consume(bitReader, (unsigned int) bitWidth);
+    } /* if */
+    return resultBits;
+  } /* bitGetBits */
+
+
+
+/**
+ *  Get a Huffman symbol from the bit reader.
+ *  The bits of the symbol are skipped.
+ *  @param reader Bit reader state created with bitReaderInit.
+ *  @param stri String of bytes with the data.
+ *  @param bytePos Position of the next byte in stri that is not in the buffer.
+ *  @param table Huffman decode table created with bitHuffmanTable.
+ *  @return the symbol, or BITS_MISSING (nothing has been read) if
+ *          stri does not contain enough bits.
+ *  @exception RANGE_ERROR The reader or the table is not valid, the
+ *             table and the reader use a different bit order, the bits
+ *             do not encode a valid symbol or stri contains a character
+ *             that is not a byte.
+ */
+intType bitHuffmanSymbol (bstriType reader, const const_striType stri,
+    intType *const bytePos, const const_bstriType table)
+
+  {
+    const_huffmanTableType huffmanTable;
+    const_huffmanEntryType entry;
+    bitReaderType bitReader;
+    uint64Type buffer;
+    intType symbol;
+
+  /* bitHuffmanSymbol */
+    logFunction(printf("bitHuffmanSymbol(*, *, " FMT_D ", *)\n", *bytePos););
+    huffmanTable = (const_huffmanTableType) table->mem;
+    if (unlikely(table->size < sizeof(huffmanTableRecord) ||
+                 huffmanTable->magic != HUFFMAN_TABLE_MAGIC ||
+                 table->size != sizeof(huffmanTableRecord) +
+                 huffmanTable->numEntries * sizeof(huffmanEntryRecord))) {
+      logError(printf("bitHuffmanSymbol: Illegal Huffman table.\n"););
+      raise_error(RANGE_ERROR);
+      symbol = 0;
+    } else {
+      bitReader = prepare(reader, stri, bytePos, (intType) huffmanTable->maxBits);
+      if (unlikely(bitReader == NULL)) {
+        symbol = 0;
+      } else if (unlikely(bitReader->msbFirst != huffmanTable->msbFirst)) {
+        logError(printf("bitHuffmanSymbol: Bit order of reader and table differ.\n"););
+        raise_error(RANGE_ERROR);
+        symbol = 0;
+      } else if (unlikely(bitReader->bitCount < huffmanTable->maxBits)) {
+        symbol = BITS_MISSING;
+      } else {
+        buffer = bitReader->buffer;
+        if (bitReader->msbFirst) {
+          entry = &HUFFMAN_ENTRIES(huffmanTable)[
+              huffmanTable->primaryBits == 0 ? 0 :
+              buffer >> (64 - huffmanTable->primaryBits)];
+          if (entry->subBits != 0) {
+            entry = &HUFFMAN_ENTRIES(huffmanTable)[entry->symbol +
+                (intType) ((buffer << huffmanTable->primaryBits) >>
+                           (64 - entry->subBits))];
+          } /* if */
+        } else {
+          entry = &HUFFMAN_ENTRIES(huffmanTable)[
+              buffer & (((uint64Type) 1 << huffmanTable->primaryBits) - 1)];
+          if (entry->subBits != 0) {
+            entry = &HUFFMAN_ENTRIES(huffmanTable)[entry->symbol +
+                (intType) ((buffer >> huffmanTable->primaryBits) &
+                           (((uint64Type) 1 << entry->subBits) - 1))];
+          } /* if */
+        } /* if */
+        if (unlikely(entry->length == INVALID_LENGTH)) {
+          logError(printf("bitHuffmanSymbol: Invalid code.\n"););
+          raise_error(RANGE_ERROR);
+          symbol = 0;
+        } else {
+          symbol = entry->symbol;
+          consume(bitReader, entry->length);
+        } /* if */
+      } /* if */
+    } /* if */
+    return symbol;
+  } /* bitHuffmanSymbol */
+
+
+
+/**
+ *  Get the symbol and the code length of an index of a lookup table.
+ */
+static void lookupEntry (boolType msbFirst, const const_rtlArrayType symbols,
+    const const_rtlArrayType codeLengths, memSizeType index,
+    intType *const symbol, unsigned int *const length)
+
+  {
+    intType codeLength;
+
+  /* lookupEntry */
+    *symbol = symbols->arr[index].value.intValue;
+    if (msbFirst) {
+      codeLength = codeLengths->arr[index].value.intValue;
+    } else if (*symbol >= codeLengths->min_position &&
+               *symbol <= codeLengths->max_position) {
+      codeLength = codeLengths->arr[*symbol - codeLengths->min_position].value.intValue;
+    } else {
+      codeLength = -1;
+    } /* if */
+    if (codeLength >= 0 && codeLength <= MAX_HUFFMAN_BITS) {
+      *length = (unsigned int) codeLength;
+    } else {
+      *length = INVALID_LENGTH;
+    } /* if */
+  } /* lookupEntry */
+
+
+
+/**
+ *  Compute the index of a lookup table from a primary and a secondary index.
+ */
+static inline memSizeType lookupIndex (boolType msbFirst, unsigned int primaryBits,
+    unsigned int secondaryBits, memSizeType primary, memSizeType secondary)
+
+  { /* lookupIndex */
+    if (msbFirst) {
+      return (primary << secondaryBits) | secondary;
+    } else {
+      return primary | (secondary << primaryBits);
+    } /* if */
+  } /* lookupIndex */
+
+
+
+/**
+ *  Determine the number of bits needed to index the secondary table
+ *  of a primary index. Bits that do not change the symbol and the
+ *  code length are not used as index.
+ */
+static unsigned int secondaryTableBits (boolType msbFirst,
+    const const_rtlArrayType symbols, const const_rtlArrayType codeLengths,
+    unsigned int primaryBits, unsigned int secondaryBits, memSizeType primary)
+
+  {
+    unsigned int subBits;
+    memSizeType secondary;
+    memSizeType reduced;
+    intType symbol;
+    intType reducedSymbol;
+    unsigned int length;
+    unsigned int reducedLength;
+    boolType uniform;
+
+  /* secondaryTableBits */
+    for (subBits = 0; subBits < secondaryBits; subBits++) {
+      uniform = TRUE;
+      for (secondary = 0; uniform && secondary < (memSizeType) 1 << secondaryBits;
+           secondary++) {
+        if (msbFirst) {
+          reduced = secondary >> (secondaryBits - subBits) << (secondaryBits - subBits);
+        } else {
+          reduced = secondary & (((memSizeType) 1 << subBits) - 1);
+        } /* if */
+        if (reduced != secondary) {
+          lookupEntry(msbFirst, symbols, codeLengths,
+              lookupIndex(msbFirst, primaryBits, secondaryBits, primary, secondary),
+              &symbol, &length);
+          lookupEntry(msbFirst, symbols, codeLengths,
+              lookupIndex(msbFirst, primaryBits, secondaryBits, primary, reduced),
+              &reducedSymbol, &reducedLength);
+          uniform = symbol == reducedSymbol && length == reducedLength;
+        } /* if */
+      } /* for */
+      if (uniform) {
+        return subBits;
+      } /* if */
+    } /* for */
+    return secondaryBits;
+  } /* secondaryTableBits */
+
+
+
+/**
+ *  Create a Huffman decode table from a lookup table.
+ *  The lookup table is indexed with the next maxBits bits of the
+ *  data (in the bit order of the table). For an MSB table the
+ *  code lengths are indexed like the symbols. For an LSB table the
+ *  code lengths are indexed with the symbol. Symbols without code
+ *  length are not valid and raise RANGE_ERROR when they are decoded.
+ *  @param msbFirst TRUE for an MSB table, FALSE for an LSB table.
+ *  @param maxBits Maximum length of a code (0 to 24).
+ *  @param symbols Array (index 0 to 2 ** maxBits - 1) with the symbols.
+ *  @param codeLengths Array with the code lengths.
+ *  @return the Huffman decode table.
+ *  @exception RANGE_ERROR maxBits is not in the allowed range or the
+ *             size of the symbols array does not fit to maxBits.
+ *  @exception MEMORY_ERROR Not enough memory to create the table.
+ */
+bstriType bitHuffmanTable (boolType msbFirst, intType maxBits,
+    const const_rtlArrayType symbols, const const_rtlArrayType codeLengths)
+
+  {
+    unsigned int primaryBits;
+    unsigned int secondaryBits;
+    unsigned int subBits;
+    memSizeType primary;
+    memSizeType secondary;
+    memSizeType numEntries;
+    memSizeType subTablePos;
+    huffmanTableType huffmanTable;
+    huffmanEntryType entries;
+    unsigned int length;
+    bstriType table;
+
+  /* bitHuffmanTable */
+    logFunction(printf("bitHuffmanTable(%d, " FMT_D ", *, *)\n", msbFirst, maxBits););
+    if (unlikely(maxBits < 0 || maxBits > MAX_HUFFMAN_BITS ||
+                 symbols->min_position != 0 ||
+                 symbols->max_position != ((intType) 1 << maxBits) - 1 ||
+                 (msbFirst && (codeLengths->min_position != 0 ||
+                               codeLengths->max_position != symbols->max_position)))) {
+      logError(printf("bitHuffmanTable: Illegal maxBits (" FMT_D
+                      ") or array sizes.\n", maxBits););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    primaryBits = maxBits < PRIMARY_BITS ? (unsigned int) maxBits : PRIMARY_BITS;
+    secondaryBits = (unsigned int) maxBits - primaryBits;
+    numEntries = (memSizeType) 1 << primaryBits;
+    for (primary = 0; primary < (memSizeType) 1 << primaryBits; primary++) {
+      subBits = secondaryTableBits(msbFirst, symbols, codeLengths,
+                                   primaryBits, secondaryBits, primary);
+      if (subBits != 0) {
+        numEntries += (memSizeType) 1 << subBits;
+      } /* if */
+    } /* for */
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(table, sizeof(huffmanTableRecord) +
+                                      numEntries * sizeof(huffmanEntryRecord)))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    table->size = sizeof(huffmanTableRecord) + numEntries * sizeof(huffmanEntryRecord);
+    memset(table->mem, 0, table->size);
+    huffmanTable = (huffmanTableType) table->mem;
+    huffmanTable->magic = HUFFMAN_TABLE_MAGIC;
+    huffmanTable->msbFirst = msbFirst;
+    huffmanTable->maxBits = (unsigned int) maxBits;
+    huffmanTable->primaryBits = primaryBits;
+    huffmanTable->numEntries = numEntries;
+    entries = (huffmanEntryType) &huffmanTable[1];
+    subTablePos = (memSizeType) 1 << primaryBits;
+    for (primary = 0; primary < (memSizeType) 1 << primaryBits; primary++) {
+      subBits = secondaryTableBits(msbFirst, symbols, codeLengths,
+                                   primaryBits, secondaryBits, primary);
+      if (subBits == 0) {
+        lookupEntry(msbFirst, symbols, codeLengths,
+            lookupIndex(msbFirst, primaryBits, secondaryBits, primary, 0),
+            &entries[primary].symbol, &length);
+        entries[primary].length = (uint16Type) length;
+      } else {
+        entries[primary].symbol = (intType) subTablePos;
+        entries[primary].subBits = (uint16Type) subBits;
+        for (secondary = 0; secondary < (memSizeType) 1 << subBits; secondary++) {
+          lookupEntry(msbFirst, symbols, codeLengths,
+              lookupIndex(msbFirst, primaryBits, secondaryBits, primary,
+                          msbFirst ? secondary << (secondaryBits - subBits) : secondary),
+              &entries[subTablePos + secondary].symbol, &length);
+          entries[subTablePos + secondary].length = (uint16Type) length;
+        } /* for */
+        subTablePos += (memSizeType) 1 << subBits;
+      } /* if */
+    } /* for */
+    return table;
+  } /* bitHuffmanTable */
+
+
+
+/**
+ *  Peek bitWidth bits from the bit reader.
+ *  The position of the reader is not changed.
+ *  @param reader Bit reader state created with bitReaderInit.
+ *  @param stri String of bytes with the data.
+ *  @param bytePos Position of the next byte in stri that is not in the buffer.
+ *  @param bitWidth Number of bits requested (0 to 57).
+ *  @return the bits peeked, or BITS_MISSING if stri does not
+ *          contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is not in the allowed
+ *             range or stri contains a character that is not a byte.
+ */
+intType bitPeekBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth)
+
+  {
+    bitReaderType bitReader;
+    intType resultBits;
+
+  /* bitPeekBits */
+    logFunction(printf("bitPeekBits(*, *, " FMT_D ", " FMT_D ")\n",
+                       *bytePos, bitWidth););
+    bitReader = prepare(reader, stri, bytePos, bitWidth);
+    if (unlikely(bitReader == NULL)) {
+      resultBits = 0;
+    } else if (unlikely(bitReader->bitCount < (unsigned int) bitWidth)) {
+      resultBits = BITS_MISSING;
+    } else {
+      resultBits = (intType) peekBuffer(bitReader, (unsigned int) bitWidth);
+    } /* if */
+    return resultBits;
+  } /* bitPeekBits */
+
+
+
+/**
+ *  Create a bit reader state.
+ *  @param msbFirst TRUE if the most significant bit of a byte is
+ *         read first, FALSE if the least significant bit is read first.
+ *  @return the bit reader state with an empty buffer.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType bitReaderInit (boolType msbFirst)
+
+  {
+    bitReaderType bitReader;
+    bstriType reader;
+
+  /* bitReaderInit */
+    logFunction(printf("bitReaderInit(%d)\n", msbFirst););
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(reader, sizeof(bitReaderRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      reader->size = sizeof(bitReaderRecord);
+      memset(reader->mem, 0, sizeof(bitReaderRecord));
+      bitReader = (bitReaderType) reader->mem;
+      bitReader->magic = BIT_READER_MAGIC;
+      bitReader->msbFirst = msbFirst;
+    } /* if */
+    return reader;
+  } /* bitReaderInit */
+
+
+
+/**
+ *  Skip bitWidth bits of the bit reader.
+ *  @param reader Bit reader state created with bitReaderInit.
+ *  @param stri String of bytes with the data.
+ *  @param bytePos Position of the next byte in stri that is not in the buffer.
+ *  @param bitWidth Number of bits to be skipped (not negative).
+ *  @return TRUE if the bits have been skipped, or FALSE (nothing
+ *          has been skipped) if stri does not contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is negative or stri
+ *             contains a character that is not a byte.
+ */
+boolType bitSkipBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth)
+
+  {
+    bitReaderType bitReader;
+    uintType bytesAvailable;
+    uintType bytesSkipped;
+    boolType okay = TRUE;
+
+  /* bitSkipBits */
+    logFunction(printf("bitSkipBits(*, *, " FMT_D ", " FMT_D ")\n",
+                       *bytePos, bitWidth););
+    bitReader = prepare(reader, stri, bytePos, bitWidth <= MAX_GET_BITS ? bitWidth : 0);
+    if (unlikely(bitReader == NULL)) {
+      okay = FALSE;
+    } else if (bitReader->bitCount >= (uintType) bitWidth) {
+      consume(bitReader, (unsigned int) bitWidth);
+    } else {
+      bytesAvailable = (uintType) *bytePos <= stri->size ?
+          stri->size - (uintType) *bytePos + 1 : 0;
+      if (unlikely(((uintType) bitWidth - bitReader->bitCount + 7) >> 3 > bytesAvailable)) {
+        okay = FALSE;
+      } else {
+        bitWidth -= (intType) bitReader->bitCount;
+        bitReader->buffer = 0;
+        bitReader->bitCount = 0;
+        bytesSkipped = (uintType) bitWidth >> 3;
+        *bytePos += (intType) bytesSkipped;
+        if (unlikely(!refill(bitReader, stri, bytePos))) {
+          logError(printf("bitSkipBits: Character > 255 in data.\n"););
+          raise_error(RANGE_ERROR);
+          okay = FALSE;
+        } else {
+          consume(bitReader, (unsigned int) bitWidth & 7);
+        } /* if */
+      } /* if */
+    } /* if */
+    return okay;
+  } /* bitSkipBits */
@@ -0,0 +1,43 @@
+/********************************************************************/
+/*                                                                  */
+/*  bit_rtl.h     Primitive actions for bit streams and Huffman.    */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/bit_rtl.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for bit streams and Huffman codes.   */
+/*                                                                  */
+/********************************************************************/
+
+void bitAlign (bstriType reader, intType *const bytePos);
+intType bitGetBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth);
+intType bitHuffmanSymbol (bstriType reader, const const_striType stri,
+    intType *const bytePos, const const_bstriType table);
+bstriType bitHuffmanTable (boolType msbFirst, intType maxBits,
+    const const_rtlArrayType symbols, const const_rtlArrayType codeLengths);
+intType bitPeekBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth);
+bstriType bitReaderInit (boolType msbFirst);
+boolType bitSkipBits (bstriType reader, const const_striType stri,
+    intType *const bytePos, intType bitWidth);
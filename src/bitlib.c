@@ -0,0 +1,274 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/bitlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for bit streams and Huffman.     */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "arrutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "bit_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "bitlib.h"
+
+
+
+
+/**
+ *  Move the bit reader/arg_1 to the next byte boundary.
+ *  Bits of a partially read byte are skipped. Whole bytes in the
+ *  buffer are given back, such that bytePos/arg_2 refers to the
+ *  first byte that has not been read.
+ *  @exception RANGE_ERROR The reader/arg_1 is not a valid bit reader state.
+ */
+objectType bit_align (listType arguments)
+
+  {
+    objectType reader_variable;
+    objectType bytePos_variable;
+
+  /* bit_align */
+    reader_variable = arg_1(arguments);
+    isit_bstri(reader_variable);
+    is_variable(reader_variable);
+    bytePos_variable = arg_2(arguments);
+    isit_int(bytePos_variable);
+    is_variable(bytePos_variable);
+    bitAlign(take_bstri(reader_variable),
+             &bytePos_variable->value.intValue);
+    return SYS_EMPTY_OBJECT;
+  } /* bit_align */
+
+
+
+/**
+ *  Get bitWidth/arg_4 bits with the bit reader/arg_1.
+ *  Bytes are loaded from stri/arg_2 starting at bytePos/arg_3.
+ *  The bit reader/arg_1 and bytePos/arg_3 are updated.
+ *  @return the bits read, or integer.first if stri/arg_2 does
+ *          not contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is not in the range
+ *             0 to 57 or stri contains a character that is not a byte.
+ */
+objectType bit_get_bits (listType arguments)
+
+  {
+    objectType reader_variable;
+    objectType bytePos_variable;
+
+  /* bit_get_bits */
+    reader_variable = arg_1(arguments);
+    isit_bstri(reader_variable);
+    is_variable(reader_variable);
+    isit_stri(arg_2(arguments));
+    bytePos_variable = arg_3(arguments);
+    isit_int(bytePos_variable);
+    is_variable(bytePos_variable);
+    isit_int(arg_4(arguments));
+    return bld_int_temp(
+        bitGetBits(take_bstri(reader_variable),
+                   take_stri(arg_2(arguments)),
+                   &bytePos_variable->value.intValue,
+                   take_int(arg_4(arguments))));
+  } /* bit_get_bits */
+
+
+
+/**
+ *  Get a Huffman symbol with the bit reader/arg_1 and the table/arg_4.
+ *  Bytes are loaded from stri/arg_2 starting at bytePos/arg_3.
+ *  The bit reader/arg_1 and bytePos/arg_3 are updated.
+ *  @return the symbol, or integer.first if stri/arg_2 does
+ *          not contain enough bits.
+ *  @exception RANGE_ERROR The reader or the table is not valid, the
+ *             bits do not encode a symbol or stri contains a
+ *             character that is not a byte.
+ */
+objectType bit_huffman_symbol (listType arguments)
+
+  {
+    objectType reader_variable;
+    objectType bytePos_variable;
+
+  /* bit_huffman_symbol */
+    reader_variable = arg_1(arguments);
+    isit_bstri(reader_variable);
+    is_variable(reader_variable);
+    isit_stri(arg_2(arguments));
+    bytePos_variable = arg_3(arguments);
+    isit_int(bytePos_variable);
+    is_variable(bytePos_variable);
+    isit_bstri(arg_4(arguments));
+    return bld_int_temp(
+        bitHuffmanSymbol(take_bstri(reader_variable),
+                         take_stri(arg_2(arguments)),
+                         &bytePos_variable->value.intValue,
+                         take_bstri(arg_4(arguments))));
+  } /* bit_huffman_symbol */
+
+
+
+/**
+ *  Create a Huffman decode table from a lookup table.
+ *  The lookup table symbols/arg_3 is indexed with the next
+ *  maxBits/arg_2 bits. For an MSB table (msbFirst/arg_1 is TRUE)
+ *  codeLengths/arg_4 is indexed like symbols/arg_3. For an LSB table
+ *  codeLengths/arg_4 is indexed with the symbol.
+ *  @return the Huffman decode table.
+ *  @exception RANGE_ERROR maxBits is not in the range 0 to 24 or the
+ *             sizes of the arrays do not fit to maxBits.
+ *  @exception MEMORY_ERROR Not enough memory to create the table.
+ */
+objectType bit_huffman_table (listType arguments)
+
+  {
+    rtlArrayType symbols;
+    rtlArrayType codeLengths;
+    bstriType table;
+
+  /* bit_huffman_table */
+    isit_bool(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    isit_array(arg_4(arguments));
+    symbols = gen_rtl_array(take_array(arg_3(arguments)));
+    if (unlikely(symbols == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      codeLengths = gen_rtl_array(take_array(arg_4(arguments)));
+      if (unlikely(codeLengths == NULL)) {
+        FREE_RTL_ARRAY(symbols, ARRAY_LENGTH(symbols));
+        return raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        table = bitHuffmanTable(take_bool(arg_1(arguments)) == SYS_TRUE_OBJECT,
+                                take_int(arg_2(arguments)),
+                                symbols, codeLengths);
+        FREE_RTL_ARRAY(symbols, ARRAY_LENGTH(symbols));
+        FREE_RTL_ARRAY(codeLengths, ARRAY_LENGTH(codeLengths));
+      } /* if */
+    } /* if */
+    return bld_bstri_temp(table);
+  } /* bit_huffman_table */
+
+
+
+/**
+ *  Peek bitWidth/arg_4 bits with the bit reader/arg_1.
+ *  Bytes are loaded from stri/arg_2 starting at bytePos/arg_3.
+ *  The bits are not consumed.
+ *  @return the bits peeked, or integer.first if stri/arg_2 does
+ *          not contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is not in the range
+ *             0 to 57 or stri contains a character that is not a byte.
+ */
+objectType bit_peek_bits (listType arguments)
+
+  {
+    objectType reader_variable;
+    objectType bytePos_variable;
+
+  /* bit_peek_bits */
+    reader_variable = arg_1(arguments);
+    isit_bstri(reader_variable);
+    is_variable(reader_variable);
+    isit_stri(arg_2(arguments));
+    bytePos_variable = arg_3(arguments);
+    isit_int(bytePos_variable);
+    is_variable(bytePos_variable);
+    isit_int(arg_4(arguments));
+    return bld_int_temp(
+        bitPeekBits(take_bstri(reader_variable),
+                    take_stri(arg_2(arguments)),
+                    &bytePos_variable->value.intValue,
+                    take_int(arg_4(arguments))));
+  } /* bit_peek_bits */
+
+
+
+/**
+ *  Create a bit reader state with an empty bit buffer.
+ *  @return the bit reader state. If msbFirst/arg_1 is TRUE the bits
+ *          of a byte are read starting with the most significant bit.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+objectType bit_reader_init (listType arguments)
+
+  { /* bit_reader_init */
+    isit_bool(arg_1(arguments));
+    return bld_bstri_temp(
+        bitReaderInit(take_bool(arg_1(arguments)) == SYS_TRUE_OBJECT));
+  } /* bit_reader_init */
+
+
+
+/**
+ *  Skip bitWidth/arg_4 bits with the bit reader/arg_1.
+ *  Bytes are loaded from stri/arg_2 starting at bytePos/arg_3.
+ *  @return TRUE if the bits have been skipped, or FALSE (nothing
+ *          has been skipped) if stri/arg_2 does not contain enough bits.
+ *  @exception RANGE_ERROR The reader is not a valid bit reader state,
+ *             bytePos is not positive, bitWidth is negative or
+ *             stri contains a character that is not a byte.
+ */
+objectType bit_skip_bits (listType arguments)
+
+  {
+    objectType reader_variable;
+    objectType bytePos_variable;
+
+  /* bit_skip_bits */
+    reader_variable = arg_1(arguments);
+    isit_bstri(reader_variable);
+    is_variable(reader_variable);
+    isit_stri(arg_2(arguments));
+    bytePos_variable = arg_3(arguments);
+    isit_int(bytePos_variable);
+    is_variable(bytePos_variable);
+    isit_int(arg_4(arguments));
+    if (bitSkipBits(take_bstri(reader_variable),
+                    take_stri(arg_2(arguments)),
+                    &bytePos_variable->value.intValue,
+                    take_int(arg_4(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* bit_skip_bits */
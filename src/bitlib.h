@@ -0,0 +1,33 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/bitlib.h                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for bit streams and Huffman.     */
+/*                                                                  */
+/********************************************************************/
+objectType bit_align          (listType arguments);
+objectType bit_get_bits       (listType arguments);
+objectType bit_huffman_symbol (listType arguments);
+objectType bit_huffman_table  (listType arguments);
+objectType bit_peek_bits      (listType arguments);
+objectType bit_reader_init    (listType arguments);
+objectType bit_skip_bits      (listType arguments);
@@ -165,6 +165,7 @@ blockType new_block (locListType block_params, const_locObjType block_result,
       created_block->local_vars = block_local_vars;
       created_block->local_consts = block_local_consts;
       created_block->body = block_body;
+      created_block->call_count = 0;
     } /* if */
     logFunction(printf("new_block --> " FMT_U_MEM "\n", (memSizeType) created_block););
     return created_block;
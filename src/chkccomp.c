@@ -4568,6 +4568,198 @@ static void determineGetaddrlimit (FILE *versionFile)
 
 
 
+static void determineWait4 (FILE *versionFile)
+
+  {
+    int has_wait4;
+
+  /* determineWait4 */
+    has_wait4 = compileAndLinkOk("#include <stdio.h>\n"
+                                 "#include <sys/types.h>\n#include <sys/time.h>\n"
+                                 "#include <sys/resource.h>\n#include <sys/wait.h>\n"
+                                 "int main(int argc, char *argv[]){\n"
+                                 "int status;\n"
+                                 "struct rusage usage;\n"
+                                 "usage.ru_maxrss = 0;\n"
+                                 "printf(\"%d\\n\", wait4(-1, &status, WNOHANG, &usage) <= 0 &&\n"
+                                 "       usage.ru_maxrss == 0);\n"
+                                 "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_WAIT4 %d\n", has_wait4);
+    if (has_wait4) {
+      /* Linux and the BSDs measure ru_maxrss in kilobytes and macOS in bytes. */
+      fprintf(versionFile, "#define RU_MAXRSS_UNIT %d\n",
+              LIBRARY_TYPE == MACOS_LIBRARIES ? 1 : 1024);
+    } /* if */
+  } /* determineWait4 */
+
+
+
+static void determineShaNiIntrinsics (FILE *versionFile)
+
+  {
+    int has_sha_ni_intrinsics;
+
+  /* determineShaNiIntrinsics */
+    /* Checks if functions with SHA extension intrinsics can be */
+    /* compiled. Whether the processor supports them is checked */
+    /* at runtime. */
+    has_sha_ni_intrinsics =
+        compileAndLinkOk("#include <stdio.h>\n#include <cpuid.h>\n"
+                         "#include <immintrin.h>\n"
+                         "__attribute__((target(\"sha,sse4.1,ssse3\")))\n"
+                         "static int test (void) {\n"
+                         "__m128i a = _mm_set_epi32(1, 2, 3, 4);\n"
+                         "a = _mm_sha256rnds2_epu32(a, a, a);\n"
+                         "a = _mm_sha1rnds4_epu32(a, a, 0);\n"
+                         "return _mm_extract_epi32(a, 3) != 0;}\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "unsigned int eax, ebx, ecx, edx;\n"
+                         "if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&\n"
+                         "    (ebx & (1 << 29)) != 0) {\n"
+                         "  test();\n"
+                         "}\n"
+                         "printf(\"1\\n\");\n"
+                         "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_SHA_NI_INTRINSICS %d\n",
+            has_sha_ni_intrinsics);
+  } /* determineShaNiIntrinsics */
+
+
+
+static void determinePclmulIntrinsics (FILE *versionFile)
+
+  {
+    int has_pclmul_intrinsics;
+
+  /* determinePclmulIntrinsics */
+    /* Checks if functions with carry-less multiplication */
+    /* intrinsics can be compiled. Whether the processor */
+    /* supports them is checked at runtime. */
+    has_pclmul_intrinsics =
+        compileAndLinkOk("#include <stdio.h>\n#include <cpuid.h>\n"
+                         "#include <immintrin.h>\n"
+                         "__attribute__((target(\"pclmul,sse4.1\")))\n"
+                         "static int test (void) {\n"
+                         "__m128i a = _mm_set_epi64x(1, 2);\n"
+                         "a = _mm_clmulepi64_si128(a, a, 0x11);\n"
+                         "return _mm_extract_epi32(a, 1) != 0;}\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "unsigned int eax, ebx, ecx, edx;\n"
+                         "if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&\n"
+                         "    (ecx & (1 << 1)) != 0) {\n"
+                         "  test();\n"
+                         "}\n"
+                         "printf(\"1\\n\");\n"
+                         "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_PCLMUL_INTRINSICS %d\n",
+            has_pclmul_intrinsics);
+  } /* determinePclmulIntrinsics */
+
+
+
+static void determineAesNiIntrinsics (FILE *versionFile)
+
+  {
+    int has_aes_ni_intrinsics;
+
+  /* determineAesNiIntrinsics */
+    /* Checks if functions with AES-NI and carry-less */
+    /* multiplication intrinsics can be compiled. Whether the */
+    /* processor supports them is checked at runtime. */
+    has_aes_ni_intrinsics =
+        compileAndLinkOk("#include <stdio.h>\n#include <cpuid.h>\n"
+                         "#include <immintrin.h>\n"
+                         "__attribute__((target(\"aes,pclmul,ssse3\")))\n"
+                         "static int test (void) {\n"
+                         "__m128i a = _mm_set_epi64x(1, 2);\n"
+                         "a = _mm_aesenc_si128(a, a);\n"
+                         "a = _mm_aesdeclast_si128(a, _mm_aesimc_si128(a));\n"
+                         "a = _mm_clmulepi64_si128(a, a, 0x11);\n"
+                         "a = _mm_shuffle_epi8(a, a);\n"
+                         "return _mm_cvtsi128_si32(a) != 0;}\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "unsigned int eax, ebx, ecx, edx;\n"
+                         "if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&\n"
+                         "    (ecx & (1 << 25)) != 0) {\n"
+                         "  test();\n"
+                         "}\n"
+                         "printf(\"1\\n\");\n"
+                         "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_AES_NI_INTRINSICS %d\n",
+            has_aes_ni_intrinsics);
+  } /* determineAesNiIntrinsics */
+
+
+
+static void determineSse2Intrinsics (FILE *versionFile)
+
+  {
+    int has_sse2_intrinsics;
+
+  /* determineSse2Intrinsics */
+    /* Checks if functions with SSE2 intrinsics can be compiled. */
+    /* Whether the processor supports them is checked at runtime. */
+    has_sse2_intrinsics =
+        compileAndLinkOk("#include <stdio.h>\n#include <cpuid.h>\n"
+                         "#include <immintrin.h>\n"
+                         "__attribute__((target(\"sse2\")))\n"
+                         "static int test (void) {\n"
+                         "__m128i a = _mm_set1_epi32(1);\n"
+                         "a = _mm_add_epi32(a, _mm_slli_epi32(a, 7));\n"
+                         "a = _mm_unpacklo_epi64(_mm_unpackhi_epi32(a, a), a);\n"
+                         "return _mm_cvtsi128_si32(a) != 0;}\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "unsigned int eax, ebx, ecx, edx;\n"
+                         "if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&\n"
+                         "    (edx & (1 << 26)) != 0) {\n"
+                         "  test();\n"
+                         "}\n"
+                         "printf(\"1\\n\");\n"
+                         "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_SSE2_INTRINSICS %d\n",
+            has_sse2_intrinsics);
+  } /* determineSse2Intrinsics */
+
+
+
+static void determineAvx2Intrinsics (FILE *versionFile)
+
+  {
+    int has_avx2_intrinsics;
+
+  /* determineAvx2Intrinsics */
+    /* Checks if functions with AVX2 intrinsics can be compiled. */
+    /* Whether the processor and the operating system support */
+    /* them is checked at runtime. */
+    has_avx2_intrinsics =
+        compileAndLinkOk("#include <stdio.h>\n#include <cpuid.h>\n"
+                         "#include <immintrin.h>\n"
+                         "__attribute__((target(\"avx2\")))\n"
+                         "static int test (void) {\n"
+                         "__m256i a = _mm256_set1_epi32(1);\n"
+                         "a = _mm256_add_epi32(a, _mm256_shuffle_epi8(a, a));\n"
+                         "a = _mm256_permute2x128_si256(a, a, 0x31);\n"
+                         "return _mm256_extract_epi32(a, 7) != 0;}\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "unsigned int eax, ebx, ecx, edx;\n"
+                         "unsigned int xcr0Low, xcr0High;\n"
+                         "if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&\n"
+                         "    (ecx & (1 << 27)) != 0 && (ecx & (1 << 28)) != 0) {\n"
+                         "  __asm__ (\"xgetbv\" : \"=a\" (xcr0Low), \"=d\" (xcr0High) : \"c\" (0));\n"
+                         "  if ((xcr0Low & 6) == 6 &&\n"
+                         "      __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&\n"
+                         "      (ebx & (1 << 5)) != 0) {\n"
+                         "    test();\n"
+                         "  }\n"
+                         "}\n"
+                         "printf(\"1\\n\");\n"
+                         "return 0;}\n") && doTest() == 1;
+    fprintf(versionFile, "#define HAS_AVX2_INTRINSICS %d\n",
+            has_avx2_intrinsics);
+  } /* determineAvx2Intrinsics */
+
+
+
 static void determineGrpAndPwFunctions (FILE *versionFile)
 
   {
@@ -10686,6 +10878,12 @@ int main (int argc, char **argv)
     copyFile(versionFileName, "tst_vers.h");
     versionFile = openVersionFile(versionFileName);
     determineGetaddrlimit(versionFile);
+    determineWait4(versionFile);
+    determineShaNiIntrinsics(versionFile);
+    determinePclmulIntrinsics(versionFile);
+    determineAesNiIntrinsics(versionFile);
+    determineSse2Intrinsics(versionFile);
+    determineAvx2Intrinsics(versionFile);
     fprintf(versionFile, "#define MEMCMP_RETURNS_SIGNUM %d\n",
         compileAndLinkOk("#include <stdio.h>\n#include <string.h>\n"
                          "int main(int argc, char *argv[]){\n"
@@ -0,0 +1,2390 @@
+/********************************************************************/
+/*                                                                  */
+/*  cip_rtl.c     Primitive actions for ciphers.                    */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cip_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for ciphers.                         */
+/*                                                                  */
+/*  AES is supported with the modes ECB, CBC, CTR and GCM. An AES   */
+/*  key schedule is stored in a bstring. If the processor supports  */
+/*  AES-NI and PCLMULQDQ the blocks are encrypted with AES-NI and   */
+/*  GHASH uses carry-less multiplication. This is checked at        */
+/*  runtime. Otherwise a bitsliced AES and a GHASH based on integer */
+/*  multiplication are used. Both work in constant time and use no  */
+/*  lookup tables.                                                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_AES_NI_INTRINSICS || HAS_SSE2_INTRINSICS || HAS_AVX2_INTRINSICS
+#include "cpuid.h"
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "cip_rtl.h"
+
+
+#define AES_BLOCK_SIZE 16
+#define AES_MAX_ROUNDS 14
+#define GCM_TAG_SIZE   16
+#define CHACHA_BLOCK_SIZE   64
+#define CHACHA_KEY_SIZE     32
+#define CHACHA_NONCE_SIZE   12
+#define CHACHA_ROUNDS       20
+#define POLY1305_BLOCK_SIZE 16
+#define POLY1305_TAG_SIZE   16
+/* Must be a multiple of AES_BLOCK_SIZE and CHACHA_BLOCK_SIZE. */
+#define CONVERSION_BUFFER_SIZE 4096
+
+#define GET_UINT32_LE(p) ((uint32Type) (p)[0]       | \
+                          (uint32Type) (p)[1] <<  8 | \
+                          (uint32Type) (p)[2] << 16 | \
+                          (uint32Type) (p)[3] << 24)
+#define GET_UINT64_LE(p) ((uint64Type) (p)[0]       | \
+                          (uint64Type) (p)[1] <<  8 | \
+                          (uint64Type) (p)[2] << 16 | \
+                          (uint64Type) (p)[3] << 24 | \
+                          (uint64Type) (p)[4] << 32 | \
+                          (uint64Type) (p)[5] << 40 | \
+                          (uint64Type) (p)[6] << 48 | \
+                          (uint64Type) (p)[7] << 56)
+#define GET_UINT64_BE(p) ((uint64Type) (p)[0] << 56 | \
+                          (uint64Type) (p)[1] << 48 | \
+                          (uint64Type) (p)[2] << 40 | \
+                          (uint64Type) (p)[3] << 32 | \
+                          (uint64Type) (p)[4] << 24 | \
+                          (uint64Type) (p)[5] << 16 | \
+                          (uint64Type) (p)[6] <<  8 | \
+                          (uint64Type) (p)[7])
+
+/**
+ *  Key of an AES computation.
+ *  The encryption round keys are taken from the key schedule.
+ *  Depending on the block functions either the round keys for
+ *  AES-NI decryption or the bitsliced round keys are computed.
+ */
+typedef struct {
+    unsigned int rounds;
+    ucharType encKey[(AES_MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+    ucharType decKey[(AES_MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+    uint64Type bitslicedKey[AES_MAX_ROUNDS + 1][8];
+  } aesContextRecord, *aesContextType;
+
+typedef const aesContextRecord *const_aesContextType;
+
+typedef void (*aesBlockFuncType) (const_aesContextType context,
+    const ucharType *in, ucharType *out, memSizeType numBlocks);
+
+typedef void (*ghashFuncType) (ucharType *y, const ucharType *h,
+    const ucharType *data, memSizeType numBlocks);
+
+typedef void (*aesPrepareFuncType) (aesContextType context);
+
+/**
+ *  State of a Poly1305 computation.
+ *  The multiplier r and the accumulator h use five limbs of 26 bits.
+ */
+typedef struct {
+    uint32Type r[5];
+    uint32Type h[5];
+    uint32Type pad[4];
+  } poly1305Record, *poly1305Type;
+
+typedef const poly1305Record *const_poly1305Type;
+
+typedef void (*chachaFuncType) (uint32Type *state, ucharType *buffer,
+    memSizeType numBlocks);
+
+static aesBlockFuncType aesEncryptFunc = NULL;
+static aesBlockFuncType aesDecryptFunc = NULL;
+static ghashFuncType ghashFunc = NULL;
+static aesPrepareFuncType aesPrepareFunc = NULL;
+static chachaFuncType chachaXorFunc = NULL;
+
+
+
+static void putUInt32Le (ucharType *p, uint32Type value)
+
+  { /* putUInt32Le */
+    p[0] = (ucharType) (value & 0xff);
+    p[1] = (ucharType) (value >> 8 & 0xff);
+    p[2] = (ucharType) (value >> 16 & 0xff);
+    p[3] = (ucharType) (value >> 24);
+  } /* putUInt32Le */
+
+
+
+static void putUInt64Le (ucharType *p, uint64Type value)
+
+  {
+    int idx;
+
+  /* putUInt64Le */
+    for (idx = 0; idx <= 7; idx++) {
+      p[idx] = (ucharType) (value & 0xff);
+      value >>= 8;
+    } /* for */
+  } /* putUInt64Le */
+
+
+
+static void putUInt64Be (ucharType *p, uint64Type value)
+
+  {
+    int idx;
+
+  /* putUInt64Be */
+    for (idx = 7; idx >= 0; idx--) {
+      p[idx] = (ucharType) (value & 0xff);
+      value >>= 8;
+    } /* for */
+  } /* putUInt64Be */
+
+
+
+/**
+ *  Multiply two elements of GF(2**8) in constant time.
+ */
+static uint8Type gfMul (uint8Type factor1, uint8Type factor2)
+
+  {
+    unsigned int a;
+    unsigned int product = 0;
+    unsigned int bit;
+
+  /* gfMul */
+    a = factor1;
+    for (bit = 0; bit < 8; bit++) {
+      product ^= a & (0 - (((unsigned int) factor2 >> bit) & 1));
+      a = ((a << 1) ^ (0x1b & (0 - (a >> 7)))) & 0xff;
+    } /* for */
+    return (uint8Type) product;
+  } /* gfMul */
+
+
+
+/**
+ *  Compute the AES S-box without lookup table.
+ *  The multiplicative inverse is computed as x**254.
+ */
+static uint8Type aesSubByte (uint8Type x)
+
+  {
+    uint8Type x2, x3, x12, x15, x240, inv;
+    unsigned int b;
+
+  /* aesSubByte */
+    x2 = gfMul(x, x);
+    x3 = gfMul(x2, x);
+    x12 = gfMul(x3, x3);
+    x12 = gfMul(x12, x12);
+    x15 = gfMul(x12, x3);
+    x240 = gfMul(x15, x15);
+    x240 = gfMul(x240, x240);
+    x240 = gfMul(x240, x240);
+    x240 = gfMul(x240, x240);
+    inv = gfMul(gfMul(x240, x12), x2);
+    b = (unsigned int) inv * 0x101;
+    return (uint8Type) (inv ^ (b >> 4) ^ (b >> 5) ^ (b >> 6) ^ (b >> 7) ^ 0x63);
+  } /* aesSubByte */
+
+
+
+/**
+ *  Compute the encryption round keys of AES.
+ *  The round keys are stored as byte sequence.
+ */
+static void aesExpandKey (const ucharType *key, unsigned int keyLength,
+    ucharType *roundKey)
+
+  {
+    unsigned int numKeyWords;
+    unsigned int numWords;
+    unsigned int idx;
+    ucharType temp[4];
+    ucharType swap;
+    uint8Type rcon = 1;
+
+  /* aesExpandKey */
+    numKeyWords = keyLength / 4;
+    numWords = 4 * (numKeyWords + 7);
+    memcpy(roundKey, key, keyLength);
+    for (idx = numKeyWords; idx < numWords; idx++) {
+      memcpy(temp, &roundKey[4 * (idx - 1)], 4);
+      if (idx % numKeyWords == 0) {
+        swap = temp[0];
+        temp[0] = (ucharType) (aesSubByte(temp[1]) ^ rcon);
+        temp[1] = aesSubByte(temp[2]);
+        temp[2] = aesSubByte(temp[3]);
+        temp[3] = aesSubByte(swap);
+        rcon = gfMul(rcon, 2);
+      } else if (numKeyWords > 6 && idx % numKeyWords == 4) {
+        temp[0] = aesSubByte(temp[0]);
+        temp[1] = aesSubByte(temp[1]);
+        temp[2] = aesSubByte(temp[2]);
+        temp[3] = aesSubByte(temp[3]);
+      } /* if */
+      roundKey[4 * idx]     = roundKey[4 * (idx - numKeyWords)]     ^ temp[0];
+      roundKey[4 * idx + 1] = roundKey[4 * (idx - numKeyWords) + 1] ^ temp[1];
+      roundKey[4 * idx + 2] = roundKey[4 * (idx - numKeyWords) + 2] ^ temp[2];
+      roundKey[4 * idx + 3] = roundKey[4 * (idx - numKeyWords) + 3] ^ temp[3];
+    } /* for */
+  } /* aesExpandKey */
+
+
+
+/* The bitsliced AES works on 4 blocks at once. Bit j of byte i  */
+/* of block k is stored in bit 16 * k + i of the word q[j]. The  */
+/* byte i of a block is in row i % 4 and column i / 4.           */
+
+#define LANES(pattern) ((uint64Type) (pattern) * 0x0001000100010001)
+
+/* Swap the bits (a >> shift) & mask with the bits b & mask. */
+#define SWAP_MOVE(a, b, shift, mask) \
+    swap = (((a) >> (shift)) ^ (b)) & (mask); \
+    (b) ^= swap; \
+    (a) ^= swap << (shift);
+
+/* Swap the bits (x >> shift) & mask with the bits x & mask. */
+#define SWAP_MOVE_INSIDE(x, shift, mask) \
+    swap = (((x) >> (shift)) ^ (x)) & (mask); \
+    (x) ^= swap ^ (swap << (shift));
+
+/**
+ *  Transpose the 8x8 bit matrix inside each of the 8 words.
+ */
+static void aesTransposeBits (uint64Type *w)
+
+  {
+    uint64Type swap;
+    unsigned int idx;
+
+  /* aesTransposeBits */
+    for (idx = 0; idx < 8; idx++) {
+      SWAP_MOVE_INSIDE(w[idx], 7, 0x00aa00aa00aa00aa);
+      SWAP_MOVE_INSIDE(w[idx], 14, 0x0000cccc0000cccc);
+      SWAP_MOVE_INSIDE(w[idx], 28, 0x00000000f0f0f0f0);
+    } /* for */
+  } /* aesTransposeBits */
+
+
+
+/**
+ *  Transpose the 8x8 byte matrix formed by the 8 words.
+ *  Byte k of word i is exchanged with byte i of word k.
+ */
+static void aesTransposeBytes (uint64Type *w)
+
+  {
+    uint64Type swap;
+    unsigned int idx;
+
+  /* aesTransposeBytes */
+    for (idx = 0; idx < 4; idx++) {
+      SWAP_MOVE(w[idx], w[idx + 4], 32, 0x00000000ffffffff);
+    } /* for */
+    SWAP_MOVE(w[0], w[2], 16, 0x0000ffff0000ffff);
+    SWAP_MOVE(w[1], w[3], 16, 0x0000ffff0000ffff);
+    SWAP_MOVE(w[4], w[6], 16, 0x0000ffff0000ffff);
+    SWAP_MOVE(w[5], w[7], 16, 0x0000ffff0000ffff);
+    for (idx = 0; idx < 8; idx += 2) {
+      SWAP_MOVE(w[idx], w[idx + 1], 8, 0x00ff00ff00ff00ff);
+    } /* for */
+  } /* aesTransposeBytes */
+
+
+
+/**
+ *  Convert up to 4 blocks to the bitsliced representation.
+ *  Missing blocks are filled with zero bytes.
+ */
+static void aesBitslicePack (uint64Type *q, const ucharType *in,
+    unsigned int numBytes)
+
+  {
+    ucharType buffer[4 * AES_BLOCK_SIZE];
+    unsigned int idx;
+
+  /* aesBitslicePack */
+    if (numBytes < 4 * AES_BLOCK_SIZE) {
+      memcpy(buffer, in, numBytes);
+      memset(&buffer[numBytes], 0, 4 * AES_BLOCK_SIZE - numBytes);
+      in = buffer;
+    } /* if */
+    for (idx = 0; idx < 8; idx++) {
+      q[idx] = GET_UINT64_LE(&in[8 * idx]);
+    } /* for */
+    aesTransposeBits(q);
+    aesTransposeBytes(q);
+  } /* aesBitslicePack */
+
+
+
+/**
+ *  Convert the bitsliced representation back to numBytes bytes.
+ *  The transpositions of aesBitslicePack are undone in reverse order.
+ */
+static void aesBitsliceUnpack (const uint64Type *q, ucharType *out,
+    unsigned int numBytes)
+
+  {
+    uint64Type w[8];
+    ucharType buffer[4 * AES_BLOCK_SIZE];
+    unsigned int idx;
+
+  /* aesBitsliceUnpack */
+    memcpy(w, q, sizeof(w));
+    aesTransposeBytes(w);
+    aesTransposeBits(w);
+    for (idx = 0; idx < 8; idx++) {
+      putUInt64Le(&buffer[8 * idx], w[idx]);
+    } /* for */
+    memcpy(out, buffer, numBytes);
+  } /* aesBitsliceUnpack */
+
+
+
+/**
+ *  Multiply bitsliced elements of GF(2**4).
+ *  The polynomial z**4 + z + 1 is used.
+ */
+static inline void gf16MulBitsliced (uint64Type *out, const uint64Type *a,
+    const uint64Type *b)
+
+  {
+    uint64Type c[7];
+
+  /* gf16MulBitsliced */
+    c[0] = a[0] & b[0];
+    c[1] = (a[0] & b[1]) ^ (a[1] & b[0]);
+    c[2] = (a[0] & b[2]) ^ (a[1] & b[1]) ^ (a[2] & b[0]);
+    c[3] = (a[0] & b[3]) ^ (a[1] & b[2]) ^ (a[2] & b[1]) ^ (a[3] & b[0]);
+    c[4] = (a[1] & b[3]) ^ (a[2] & b[2]) ^ (a[3] & b[1]);
+    c[5] = (a[2] & b[3]) ^ (a[3] & b[2]);
+    c[6] = a[3] & b[3];
+    out[0] = c[0] ^ c[4];
+    out[1] = c[1] ^ c[4] ^ c[5];
+    out[2] = c[2] ^ c[5] ^ c[6];
+    out[3] = c[3] ^ c[6];
+  } /* gf16MulBitsliced */
+
+
+
+static inline void gf16SquareBitsliced (uint64Type *out, const uint64Type *a)
+
+  { /* gf16SquareBitsliced */
+    out[0] = a[0] ^ a[2];
+    out[1] = a[2];
+    out[2] = a[1] ^ a[3];
+    out[3] = a[3];
+  } /* gf16SquareBitsliced */
+
+
+
+/**
+ *  Compute the multiplicative inverse in the tower field.
+ *  An element ah * y + al of GF((2**4)**2) with y**2 = y + 8 is
+ *  stored with al in t[0..3] and ah in t[4..7]. The inverse is
+ *  (ah * y + ah + al) / d with d = 8 * ah**2 + ah * al + al**2.
+ *  The inverse of d is computed as d**14. The inverse of 0 is 0.
+ */
+static void aesTowerInvertBitsliced (uint64Type *t)
+
+  {
+    uint64Type ah2[4], al2[4], d[4];
+    uint64Type d2[4], d4[4], d8[4], dInv[4];
+    uint64Type sum[4];
+
+  /* aesTowerInvertBitsliced */
+    gf16SquareBitsliced(ah2, &t[4]);
+    gf16SquareBitsliced(al2, t);
+    gf16MulBitsliced(d, &t[4], t);
+    /* Multiply ah2 with 8 and add al2. */
+    d[0] ^= ah2[1] ^ al2[0];
+    d[1] ^= ah2[1] ^ ah2[2] ^ al2[1];
+    d[2] ^= ah2[2] ^ ah2[3] ^ al2[2];
+    d[3] ^= ah2[0] ^ ah2[3] ^ al2[3];
+    gf16SquareBitsliced(d2, d);
+    gf16SquareBitsliced(d4, d2);
+    gf16SquareBitsliced(d8, d4);
+    gf16MulBitsliced(dInv, d2, d4);
+    gf16MulBitsliced(dInv, dInv, d8);
+    sum[0] = t[0] ^ t[4];
+    sum[1] = t[1] ^ t[5];
+    sum[2] = t[2] ^ t[6];
+    sum[3] = t[3] ^ t[7];
+    gf16MulBitsliced(&t[4], &t[4], dInv);
+    gf16MulBitsliced(t, sum, dInv);
+  } /* aesTowerInvertBitsliced */
+
+
+
+/**
+ *  Compute the AES S-box for bitsliced bytes.
+ *  The bytes are mapped to the tower field GF((2**4)**2), inverted
+ *  there and mapped back. The mapping back is combined with the
+ *  affine transformation of the S-box. The linear maps have been
+ *  derived from the root 0x20 of the AES polynomial in the tower
+ *  field.
+ */
+static void aesSubBytesBitsliced (uint64Type *q)
+
+  {
+    uint64Type t[8];
+
+  /* aesSubBytesBitsliced */
+    t[0] = q[0] ^ q[5] ^ q[7];
+    t[1] = q[2];
+    t[2] = q[2] ^ q[3] ^ q[4] ^ q[5] ^ q[6] ^ q[7];
+    t[3] = q[3] ^ q[4];
+    t[4] = q[4] ^ q[5] ^ q[6];
+    t[5] = q[1] ^ q[4] ^ q[6] ^ q[7];
+    t[6] = q[2] ^ q[3] ^ q[5] ^ q[7];
+    t[7] = q[5] ^ q[7];
+    aesTowerInvertBitsliced(t);
+    q[0] = ~(t[0] ^ t[2] ^ t[6]);
+    q[1] = ~(t[0] ^ t[1] ^ t[2] ^ t[3] ^ t[4] ^ t[5]);
+    q[2] = t[0] ^ t[3] ^ t[5] ^ t[6];
+    q[3] = t[0] ^ t[2] ^ t[5];
+    q[4] = t[0] ^ t[1] ^ t[3] ^ t[4] ^ t[5];
+    q[5] = ~(t[1] ^ t[2] ^ t[3] ^ t[5] ^ t[6] ^ t[7]);
+    q[6] = ~(t[4] ^ t[6] ^ t[7]);
+    q[7] = t[1] ^ t[2];
+  } /* aesSubBytesBitsliced */
+
+
+
+/**
+ *  Compute the inverse AES S-box for bitsliced bytes.
+ *  The inverse affine transformation is combined with the mapping
+ *  to the tower field.
+ */
+static void aesInvSubBytesBitsliced (uint64Type *q)
+
+  {
+    uint64Type t[8];
+
+  /* aesInvSubBytesBitsliced */
+    t[0] = ~(q[1] ^ q[5] ^ q[6]);
+    t[1] = ~(q[1] ^ q[4] ^ q[7]);
+    t[2] = ~(q[1] ^ q[4]);
+    t[3] = q[0] ^ q[1] ^ q[2] ^ q[3] ^ q[5] ^ q[6];
+    t[4] = q[0] ^ q[1] ^ q[2] ^ q[4] ^ q[5] ^ q[6] ^ q[7];
+    t[5] = q[3] ^ q[4] ^ q[5] ^ q[6];
+    t[6] = ~(q[0] ^ q[4] ^ q[5] ^ q[6]);
+    t[7] = q[1] ^ q[2] ^ q[6] ^ q[7];
+    aesTowerInvertBitsliced(t);
+    q[0] = t[0] ^ t[7];
+    q[1] = t[4] ^ t[5] ^ t[7];
+    q[2] = t[1];
+    q[3] = t[1] ^ t[6] ^ t[7];
+    q[4] = t[1] ^ t[3] ^ t[6] ^ t[7];
+    q[5] = t[2] ^ t[4] ^ t[6];
+    q[6] = t[1] ^ t[2] ^ t[3] ^ t[7];
+    q[7] = t[2] ^ t[4] ^ t[6] ^ t[7];
+  } /* aesInvSubBytesBitsliced */
+
+
+
+/**
+ *  Rotate the columns of row r left by r positions.
+ *  Inside a lane the bits of a row are 4 positions apart.
+ */
+static void aesShiftRowsBitsliced (uint64Type *q)
+
+  {
+    unsigned int j;
+    unsigned int row;
+    uint64Type rowBits;
+    uint64Type result;
+
+  /* aesShiftRowsBitsliced */
+    for (j = 0; j < 8; j++) {
+      result = q[j] & LANES(0x1111);
+      for (row = 1; row < 4; row++) {
+        rowBits = q[j] & LANES(0x1111 << row);
+        result |= (rowBits & LANES((0xffff << (4 * row)) & 0xffff)) >> (4 * row) |
+                  (rowBits & LANES(0xffff >> (16 - 4 * row))) << (16 - 4 * row);
+      } /* for */
+      q[j] = result;
+    } /* for */
+  } /* aesShiftRowsBitsliced */
+
+
+
+static void aesInvShiftRowsBitsliced (uint64Type *q)
+
+  {
+    unsigned int j;
+    unsigned int row;
+    uint64Type rowBits;
+    uint64Type result;
+
+  /* aesInvShiftRowsBitsliced */
+    for (j = 0; j < 8; j++) {
+      result = q[j] & LANES(0x1111);
+      for (row = 1; row < 4; row++) {
+        rowBits = q[j] & LANES(0x1111 << row);
+        result |= (rowBits & LANES(0xffff >> (4 * row))) << (4 * row) |
+                  (rowBits & LANES((0xffff << (16 - 4 * row)) & 0xffff)) >> (16 - 4 * row);
+      } /* for */
+      q[j] = result;
+    } /* for */
+  } /* aesInvShiftRowsBitsliced */
+
+
+
+/* Rotate the rows of each column up by 1, 2 and 3 positions. */
+#define ROT_ROWS1(x) ((((x) >> 1) & LANES(0x7777)) | (((x) << 3) & LANES(0x8888)))
+#define ROT_ROWS2(x) ((((x) >> 2) & LANES(0x3333)) | (((x) << 2) & LANES(0xcccc)))
+#define ROT_ROWS3(x) ((((x) >> 3) & LANES(0x1111)) | (((x) << 1) & LANES(0xeeee)))
+
+/**
+ *  Multiply the bitsliced bytes a with 2 in GF(2**8).
+ */
+#define XTIME_BITSLICED(out, a) \
+    out[0] = a[7]; \
+    out[1] = a[0] ^ a[7]; \
+    out[2] = a[1]; \
+    out[3] = a[2] ^ a[7]; \
+    out[4] = a[3] ^ a[7]; \
+    out[5] = a[4]; \
+    out[6] = a[5]; \
+    out[7] = a[6];
+
+static void aesMixColumnsBitsliced (uint64Type *q)
+
+  {
+    uint64Type rot1[8];
+    uint64Type sum[8];
+    uint64Type twice[8];
+    unsigned int j;
+
+  /* aesMixColumnsBitsliced */
+    /* out[r] = 2 * (a[r] ^ a[r+1]) ^ a[r+1] ^ a[r+2] ^ a[r+3] */
+    for (j = 0; j < 8; j++) {
+      rot1[j] = ROT_ROWS1(q[j]);
+      sum[j] = q[j] ^ rot1[j];
+    } /* for */
+    XTIME_BITSLICED(twice, sum);
+    for (j = 0; j < 8; j++) {
+      q[j] = twice[j] ^ rot1[j] ^ ROT_ROWS2(q[j]) ^ ROT_ROWS3(q[j]);
+    } /* for */
+  } /* aesMixColumnsBitsliced */
+
+
+
+static void aesInvMixColumnsBitsliced (uint64Type *q)
+
+  {
+    uint64Type sum[8];
+    uint64Type twice[8];
+    uint64Type fourTimes[8];
+    unsigned int j;
+
+  /* aesInvMixColumnsBitsliced */
+    /* InvMixColumns is MixColumns after a[r] ^= 4 * (a[r] ^ a[r+2]). */
+    for (j = 0; j < 8; j++) {
+      sum[j] = q[j] ^ ROT_ROWS2(q[j]);
+    } /* for */
+    XTIME_BITSLICED(twice, sum);
+    XTIME_BITSLICED(fourTimes, twice);
+    for (j = 0; j < 8; j++) {
+      q[j] ^= fourTimes[j];
+    } /* for */
+    aesMixColumnsBitsliced(q);
+  } /* aesInvMixColumnsBitsliced */
+
+
+
+static inline void aesAddRoundKeyBitsliced (uint64Type *q,
+    const uint64Type *roundKey)
+
+  {
+    unsigned int j;
+
+  /* aesAddRoundKeyBitsliced */
+    for (j = 0; j < 8; j++) {
+      q[j] ^= roundKey[j];
+    } /* for */
+  } /* aesAddRoundKeyBitsliced */
+
+
+
+static void aesPrepareBitsliced (aesContextType context)
+
+  {
+    unsigned int round;
+    unsigned int j;
+
+  /* aesPrepareBitsliced */
+    for (round = 0; round <= context->rounds; round++) {
+      aesBitslicePack(context->bitslicedKey[round],
+                      &context->encKey[round * AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+      for (j = 0; j < 8; j++) {
+        context->bitslicedKey[round][j] = LANES(context->bitslicedKey[round][j]);
+      } /* for */
+    } /* for */
+  } /* aesPrepareBitsliced */
+
+
+
+static void aesEncryptBitsliced (const_aesContextType context,
+    const ucharType *in, ucharType *out, memSizeType numBlocks)
+
+  {
+    uint64Type q[8];
+    unsigned int numBytes;
+    unsigned int round;
+
+  /* aesEncryptBitsliced */
+    while (numBlocks != 0) {
+      numBytes = numBlocks >= 4 ? 4 * AES_BLOCK_SIZE :
+          (unsigned int) numBlocks * AES_BLOCK_SIZE;
+      aesBitslicePack(q, in, numBytes);
+      aesAddRoundKeyBitsliced(q, context->bitslicedKey[0]);
+      for (round = 1; round < context->rounds; round++) {
+        aesSubBytesBitsliced(q);
+        aesShiftRowsBitsliced(q);
+        aesMixColumnsBitsliced(q);
+        aesAddRoundKeyBitsliced(q, context->bitslicedKey[round]);
+      } /* for */
+      aesSubBytesBitsliced(q);
+      aesShiftRowsBitsliced(q);
+      aesAddRoundKeyBitsliced(q, context->bitslicedKey[context->rounds]);
+      aesBitsliceUnpack(q, out, numBytes);
+      in += numBytes;
+      out += numBytes;
+      numBlocks -= numBytes / AES_BLOCK_SIZE;
+    } /* while */
+  } /* aesEncryptBitsliced */
+
+
+
+static void aesDecryptBitsliced (const_aesContextType context,
+    const ucharType *in, ucharType *out, memSizeType numBlocks)
+
+  {
+    uint64Type q[8];
+    unsigned int numBytes;
+    unsigned int round;
+
+  /* aesDecryptBitsliced */
+    while (numBlocks != 0) {
+      numBytes = numBlocks >= 4 ? 4 * AES_BLOCK_SIZE :
+          (unsigned int) numBlocks * AES_BLOCK_SIZE;
+      aesBitslicePack(q, in, numBytes);
+      aesAddRoundKeyBitsliced(q, context->bitslicedKey[context->rounds]);
+      for (round = context->rounds - 1; round >= 1; round--) {
+        aesInvShiftRowsBitsliced(q);
+        aesInvSubBytesBitsliced(q);
+        aesAddRoundKeyBitsliced(q, context->bitslicedKey[round]);
+        aesInvMixColumnsBitsliced(q);
+      } /* for */
+      aesInvShiftRowsBitsliced(q);
+      aesInvSubBytesBitsliced(q);
+      aesAddRoundKeyBitsliced(q, context->bitslicedKey[0]);
+      aesBitsliceUnpack(q, out, numBytes);
+      in += numBytes;
+      out += numBytes;
+      numBlocks -= numBytes / AES_BLOCK_SIZE;
+    } /* while */
+  } /* aesDecryptBitsliced */
+
+
+
+/**
+ *  Carry-less multiplication of the lower 64 bits in constant time.
+ *  The integer multiplications of the masked factors leave holes of
+ *  3 bits, such that carries do not reach the bits of interest.
+ */
+static uint64Type clmulLow (uint64Type x, uint64Type y)
+
+  {
+    uint64Type x0, x1, x2, x3;
+    uint64Type y0, y1, y2, y3;
+    uint64Type z0, z1, z2, z3;
+
+  /* clmulLow */
+    x0 = x & 0x1111111111111111;
+    x1 = x & 0x2222222222222222;
+    x2 = x & 0x4444444444444444;
+    x3 = x & 0x8888888888888888;
+    y0 = y & 0x1111111111111111;
+    y1 = y & 0x2222222222222222;
+    y2 = y & 0x4444444444444444;
+    y3 = y & 0x8888888888888888;
+    z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & 0x1111111111111111) | (z1 & 0x2222222222222222) |
+           (z2 & 0x4444444444444444) | (z3 & 0x8888888888888888);
+  } /* clmulLow */
+
+
+
+static uint64Type reverseBits64 (uint64Type x)
+
+  { /* reverseBits64 */
+    x = ((x & 0x5555555555555555) << 1) | ((x >> 1) & 0x5555555555555555);
+    x = ((x & 0x3333333333333333) << 2) | ((x >> 2) & 0x3333333333333333);
+    x = ((x & 0x0f0f0f0f0f0f0f0f) << 4) | ((x >> 4) & 0x0f0f0f0f0f0f0f0f);
+    x = ((x & 0x00ff00ff00ff00ff) << 8) | ((x >> 8) & 0x00ff00ff00ff00ff);
+    x = ((x & 0x0000ffff0000ffff) << 16) | ((x >> 16) & 0x0000ffff0000ffff);
+    return (x << 32) | (x >> 32);
+  } /* reverseBits64 */
+
+
+
+/**
+ *  GHASH in constant time: y = (y ^ block) * h for all blocks.
+ *  The bit order of GHASH is reversed. The upper halves of the
+ *  products are computed as reversed lower halves of the products
+ *  of the reversed factors. Karatsuba needs three products.
+ */
+static void ghashPortable (ucharType *y, const ucharType *h,
+    const ucharType *data, memSizeType numBlocks)
+
+  {
+    uint64Type y0, y1, y2, y0r, y1r, y2r;
+    uint64Type h0, h1, h2, h0r, h1r, h2r;
+    uint64Type z0, z1, z2, z0h, z1h, z2h;
+    uint64Type v0, v1, v2, v3;
+
+  /* ghashPortable */
+    y1 = GET_UINT64_BE(y);
+    y0 = GET_UINT64_BE(&y[8]);
+    h1 = GET_UINT64_BE(h);
+    h0 = GET_UINT64_BE(&h[8]);
+    h0r = reverseBits64(h0);
+    h1r = reverseBits64(h1);
+    h2 = h0 ^ h1;
+    h2r = h0r ^ h1r;
+    for (; numBlocks != 0; numBlocks--) {
+      y1 ^= GET_UINT64_BE(data);
+      y0 ^= GET_UINT64_BE(&data[8]);
+      y0r = reverseBits64(y0);
+      y1r = reverseBits64(y1);
+      y2 = y0 ^ y1;
+      y2r = y0r ^ y1r;
+      z0 = clmulLow(y0, h0);
+      z1 = clmulLow(y1, h1);
+      z2 = clmulLow(y2, h2);
+      z0h = clmulLow(y0r, h0r);
+      z1h = clmulLow(y1r, h1r);
+      z2h = clmulLow(y2r, h2r);
+      z2 ^= z0 ^ z1;
+      z2h ^= z0h ^ z1h;
+      z0h = reverseBits64(z0h) >> 1;
+      z1h = reverseBits64(z1h) >> 1;
+      z2h = reverseBits64(z2h) >> 1;
+      v0 = z0;
+      v1 = z0h ^ z2;
+      v2 = z1 ^ z2h;
+      v3 = z1h;
+      /* Shift the 256-bit product left by one bit and reduce it */
+      /* with the polynomial x**128 + x**7 + x**2 + x + 1.       */
+      v3 = (v3 << 1) | (v2 >> 63);
+      v2 = (v2 << 1) | (v1 >> 63);
+      v1 = (v1 << 1) | (v0 >> 63);
+      v0 = (v0 << 1);
+      v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+      v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+      v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+      v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+      y0 = v2;
+      y1 = v3;
+      data += AES_BLOCK_SIZE;
+    } /* for */
+    putUInt64Be(y, y1);
+    putUInt64Be(&y[8], y0);
+  } /* ghashPortable */
+
+
+
+#if HAS_AES_NI_INTRINSICS
+#define AES_NI_ENCRYPT4(keys, rounds, b0, b1, b2, b3) \
+    b0 = _mm_xor_si128(b0, keys[0]); \
+    b1 = _mm_xor_si128(b1, keys[0]); \
+    b2 = _mm_xor_si128(b2, keys[0]); \
+    b3 = _mm_xor_si128(b3, keys[0]); \
+    for (round = 1; round < rounds; round++) { \
+      b0 = _mm_aesenc_si128(b0, keys[round]); \
+      b1 = _mm_aesenc_si128(b1, keys[round]); \
+      b2 = _mm_aesenc_si128(b2, keys[round]); \
+      b3 = _mm_aesenc_si128(b3, keys[round]); \
+    } \
+    b0 = _mm_aesenclast_si128(b0, keys[rounds]); \
+    b1 = _mm_aesenclast_si128(b1, keys[rounds]); \
+    b2 = _mm_aesenclast_si128(b2, keys[rounds]); \
+    b3 = _mm_aesenclast_si128(b3, keys[rounds]);
+
+#define AES_NI_DECRYPT4(keys, rounds, b0, b1, b2, b3) \
+    b0 = _mm_xor_si128(b0, keys[0]); \
+    b1 = _mm_xor_si128(b1, keys[0]); \
+    b2 = _mm_xor_si128(b2, keys[0]); \
+    b3 = _mm_xor_si128(b3, keys[0]); \
+    for (round = 1; round < rounds; round++) { \
+      b0 = _mm_aesdec_si128(b0, keys[round]); \
+      b1 = _mm_aesdec_si128(b1, keys[round]); \
+      b2 = _mm_aesdec_si128(b2, keys[round]); \
+      b3 = _mm_aesdec_si128(b3, keys[round]); \
+    } \
+    b0 = _mm_aesdeclast_si128(b0, keys[rounds]); \
+    b1 = _mm_aesdeclast_si128(b1, keys[rounds]); \
+    b2 = _mm_aesdeclast_si128(b2, keys[rounds]); \
+    b3 = _mm_aesdeclast_si128(b3, keys[rounds]);
+
+/**
+ *  Compute the round keys of the equivalent inverse cipher.
+ */
+__attribute__((target("aes,sse2")))
+static void aesPrepareAesNi (aesContextType context)
+
+  {
+    unsigned int round;
+    __m128i roundKey;
+
+  /* aesPrepareAesNi */
+    memcpy(context->decKey,
+           &context->encKey[context->rounds * AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+    for (round = 1; round < context->rounds; round++) {
+      roundKey = _mm_loadu_si128((const __m128i *)
+          &context->encKey[(context->rounds - round) * AES_BLOCK_SIZE]);
+      _mm_storeu_si128((__m128i *) &context->decKey[round * AES_BLOCK_SIZE],
+                       _mm_aesimc_si128(roundKey));
+    } /* for */
+    memcpy(&context->decKey[context->rounds * AES_BLOCK_SIZE],
+           context->encKey, AES_BLOCK_SIZE);
+  } /* aesPrepareAesNi */
+
+
+
+__attribute__((target("aes,sse2")))
+static void aesEncryptAesNi (const_aesContextType context,
+    const ucharType *in, ucharType *out, memSizeType numBlocks)
+
+  {
+    __m128i keys[AES_MAX_ROUNDS + 1];
+    __m128i b0, b1, b2, b3;
+    unsigned int rounds;
+    unsigned int round;
+
+  /* aesEncryptAesNi */
+    rounds = context->rounds;
+    for (round = 0; round <= rounds; round++) {
+      keys[round] = _mm_loadu_si128((const __m128i *)
+          &context->encKey[round * AES_BLOCK_SIZE]);
+    } /* for */
+    for (; numBlocks >= 4; numBlocks -= 4) {
+      b0 = _mm_loadu_si128((const __m128i *) &in[0]);
+      b1 = _mm_loadu_si128((const __m128i *) &in[16]);
+      b2 = _mm_loadu_si128((const __m128i *) &in[32]);
+      b3 = _mm_loadu_si128((const __m128i *) &in[48]);
+      AES_NI_ENCRYPT4(keys, rounds, b0, b1, b2, b3);
+      _mm_storeu_si128((__m128i *) &out[0], b0);
+      _mm_storeu_si128((__m128i *) &out[16], b1);
+      _mm_storeu_si128((__m128i *) &out[32], b2);
+      _mm_storeu_si128((__m128i *) &out[48], b3);
+      in += 4 * AES_BLOCK_SIZE;
+      out += 4 * AES_BLOCK_SIZE;
+    } /* for */
+    for (; numBlocks != 0; numBlocks--) {
+      b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) in), keys[0]);
+      for (round = 1; round < rounds; round++) {
+        b0 = _mm_aesenc_si128(b0, keys[round]);
+      } /* for */
+      _mm_storeu_si128((__m128i *) out, _mm_aesenclast_si128(b0, keys[rounds]));
+      in += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    } /* for */
+  } /* aesEncryptAesNi */
+
+
+
+__attribute__((target("aes,sse2")))
+static void aesDecryptAesNi (const_aesContextType context,
+    const ucharType *in, ucharType *out, memSizeType numBlocks)
+
+  {
+    __m128i keys[AES_MAX_ROUNDS + 1];
+    __m128i b0, b1, b2, b3;
+    unsigned int rounds;
+    unsigned int round;
+
+  /* aesDecryptAesNi */
+    rounds = context->rounds;
+    for (round = 0; round <= rounds; round++) {
+      keys[round] = _mm_loadu_si128((const __m128i *)
+          &context->decKey[round * AES_BLOCK_SIZE]);
+    } /* for */
+    for (; numBlocks >= 4; numBlocks -= 4) {
+      b0 = _mm_loadu_si128((const __m128i *) &in[0]);
+      b1 = _mm_loadu_si128((const __m128i *) &in[16]);
+      b2 = _mm_loadu_si128((const __m128i *) &in[32]);
+      b3 = _mm_loadu_si128((const __m128i *) &in[48]);
+      AES_NI_DECRYPT4(keys, rounds, b0, b1, b2, b3);
+      _mm_storeu_si128((__m128i *) &out[0], b0);
+      _mm_storeu_si128((__m128i *) &out[16], b1);
+      _mm_storeu_si128((__m128i *) &out[32], b2);
+      _mm_storeu_si128((__m128i *) &out[48], b3);
+      in += 4 * AES_BLOCK_SIZE;
+      out += 4 * AES_BLOCK_SIZE;
+    } /* for */
+    for (; numBlocks != 0; numBlocks--) {
+      b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) in), keys[0]);
+      for (round = 1; round < rounds; round++) {
+        b0 = _mm_aesdec_si128(b0, keys[round]);
+      } /* for */
+      _mm_storeu_si128((__m128i *) out, _mm_aesdeclast_si128(b0, keys[rounds]));
+      in += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    } /* for */
+  } /* aesDecryptAesNi */
+
+
+
+/**
+ *  GHASH with carry-less multiplication: y = (y ^ block) * h.
+ *  The factors are byte reversed. The product is shifted left by
+ *  one bit, because GHASH uses reflected bit order, and reduced
+ *  with the polynomial x**128 + x**7 + x**2 + x + 1 (see the Intel
+ *  paper "Intel Carry-Less Multiplication Instruction and its
+ *  Usage for Computing the GCM Mode").
+ */
+__attribute__((target("pclmul,ssse3")))
+static void ghashPclmul (ucharType *y, const ucharType *h,
+    const ucharType *data, memSizeType numBlocks)
+
+  {
+    __m128i byteSwap, a, b;
+    __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+
+  /* ghashPclmul */
+    byteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                            8, 9, 10, 11, 12, 13, 14, 15);
+    a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) y), byteSwap);
+    b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) h), byteSwap);
+    for (; numBlocks != 0; numBlocks--) {
+      a = _mm_xor_si128(a, _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *) data), byteSwap));
+      t3 = _mm_clmulepi64_si128(a, b, 0x00);
+      t4 = _mm_clmulepi64_si128(a, b, 0x10);
+      t5 = _mm_clmulepi64_si128(a, b, 0x01);
+      t6 = _mm_clmulepi64_si128(a, b, 0x11);
+      t4 = _mm_xor_si128(t4, t5);
+      t5 = _mm_slli_si128(t4, 8);
+      t4 = _mm_srli_si128(t4, 8);
+      t3 = _mm_xor_si128(t3, t5);
+      t6 = _mm_xor_si128(t6, t4);
+      /* Shift the 256-bit product <t6:t3> left by one bit. */
+      t7 = _mm_srli_epi32(t3, 31);
+      t8 = _mm_srli_epi32(t6, 31);
+      t3 = _mm_slli_epi32(t3, 1);
+      t6 = _mm_slli_epi32(t6, 1);
+      t9 = _mm_srli_si128(t7, 12);
+      t8 = _mm_slli_si128(t8, 4);
+      t7 = _mm_slli_si128(t7, 4);
+      t3 = _mm_or_si128(t3, t7);
+      t6 = _mm_or_si128(t6, t8);
+      t6 = _mm_or_si128(t6, t9);
+      /* Reduce the product. */
+      t7 = _mm_slli_epi32(t3, 31);
+      t8 = _mm_slli_epi32(t3, 30);
+      t9 = _mm_slli_epi32(t3, 25);
+      t7 = _mm_xor_si128(t7, t8);
+      t7 = _mm_xor_si128(t7, t9);
+      t8 = _mm_srli_si128(t7, 4);
+      t7 = _mm_slli_si128(t7, 12);
+      t3 = _mm_xor_si128(t3, t7);
+      t2 = _mm_srli_epi32(t3, 1);
+      t4 = _mm_srli_epi32(t3, 2);
+      t5 = _mm_srli_epi32(t3, 7);
+      t2 = _mm_xor_si128(t2, t4);
+      t2 = _mm_xor_si128(t2, t5);
+      t2 = _mm_xor_si128(t2, t8);
+      t3 = _mm_xor_si128(t3, t2);
+      a = _mm_xor_si128(t6, t3);
+      data += AES_BLOCK_SIZE;
+    } /* for */
+    _mm_storeu_si128((__m128i *) y, _mm_shuffle_epi8(a, byteSwap));
+  } /* ghashPclmul */
+
+
+
+static boolType cpuHasAesNi (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+
+  /* cpuHasAesNi */
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+           (ecx & (1 << 1)) != 0 &&   /* PCLMULQDQ */
+           (ecx & (1 << 9)) != 0 &&   /* SSSE3 */
+           (ecx & (1 << 25)) != 0;    /* AES */
+  } /* cpuHasAesNi */
+#endif
+
+
+
+static void selectAesFunctions (void)
+
+  { /* selectAesFunctions */
+#if HAS_AES_NI_INTRINSICS
+    if (cpuHasAesNi()) {
+      aesPrepareFunc = aesPrepareAesNi;
+      aesDecryptFunc = aesDecryptAesNi;
+      ghashFunc = ghashPclmul;
+      aesEncryptFunc = aesEncryptAesNi;
+    } else
+#endif
+    {
+      aesPrepareFunc = aesPrepareBitsliced;
+      aesDecryptFunc = aesDecryptBitsliced;
+      ghashFunc = ghashPortable;
+      aesEncryptFunc = aesEncryptBitsliced;
+    }
+    logFunction(printf("selectAesFunctions: AES-NI %s\n",
+                       aesEncryptFunc == aesEncryptBitsliced ?
+                       "not used" : "used"););
+  } /* selectAesFunctions */
+
+
+
+/**
+ *  Initialize an AES context from a key schedule.
+ *  @return TRUE if the key schedule is valid, FALSE otherwise.
+ */
+static boolType aesContextInit (const aesContextType context,
+    const const_bstriType keySchedule)
+
+  {
+    boolType okay = TRUE;
+
+  /* aesContextInit */
+    switch (keySchedule->size) {
+      case 11 * AES_BLOCK_SIZE: context->rounds = 10; break;
+      case 13 * AES_BLOCK_SIZE: context->rounds = 12; break;
+      case 15 * AES_BLOCK_SIZE: context->rounds = 14; break;
+      default: okay = FALSE; break;
+    } /* switch */
+    if (okay) {
+      /* aesEncryptFunc is assigned last in selectAesFunctions. */
+      if (unlikely(aesEncryptFunc == NULL)) {
+        selectAesFunctions();
+      } /* if */
+      memcpy(context->encKey, keySchedule->mem, keySchedule->size);
+      aesPrepareFunc(context);
+    } /* if */
+    return okay;
+  } /* aesContextInit */
+
+
+
+/**
+ *  Convert a string with bytes to a byte array.
+ *  @return TRUE if all characters are in the range 0 to 255,
+ *          FALSE otherwise.
+ */
+static inline boolType bytesFromStri (ucharType *dest,
+    const const_striType stri, memSizeType length)
+
+  { /* bytesFromStri */
+    return stri->size == length && !memcpy_from_strelem(dest, stri->mem, length);
+  } /* bytesFromStri */
+
+
+
+static striType allocResult (memSizeType size)
+
+  {
+    striType result;
+
+  /* allocResult */
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = size;
+    } /* if */
+    return result;
+  } /* allocResult */
+
+
+
+/**
+ *  Increment the counter in the last counterSize bytes of a block.
+ */
+static inline void incrementCounter (ucharType *block, unsigned int counterSize)
+
+  {
+    unsigned int idx = AES_BLOCK_SIZE;
+
+  /* incrementCounter */
+    do {
+      idx--;
+      block[idx]++;
+    } while (block[idx] == 0 && idx > AES_BLOCK_SIZE - counterSize);
+  } /* incrementCounter */
+
+
+
+/**
+ *  Encrypt or decrypt a string in counter mode.
+ *  The blocks of the key stream are created from the counter block,
+ *  which is incremented afterwards. If the ghash state is not NULL
+ *  the GHASH of the ciphertext is computed as well.
+ *  @return the encrypted or decrypted data or NULL if the data
+ *          contains a character beyond '\255;'.
+ */
+static striType aesCtrProcess (const_aesContextType context,
+    ucharType *counterBlock, unsigned int counterSize,
+    const const_striType data, ucharType *ghash, const ucharType *h,
+    boolType encrypt, memSizeType extraSize)
+
+  {
+    ucharType inBuffer[CONVERSION_BUFFER_SIZE];
+    ucharType keyStream[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType numBlocks;
+    memSizeType pos;
+    striType result;
+
+  /* aesCtrProcess */
+    result = allocResult(data->size + extraSize);
+    if (result != NULL) {
+      mem = data->mem;
+      resultMem = result->mem;
+      remaining = data->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(inBuffer, mem, chunkSize))) {
+          FREE_STRI(result, data->size + extraSize);
+          return NULL;
+        } /* if */
+        numBlocks = (chunkSize + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+        for (pos = 0; pos < numBlocks; pos++) {
+          memcpy(&keyStream[pos * AES_BLOCK_SIZE], counterBlock, AES_BLOCK_SIZE);
+          incrementCounter(counterBlock, counterSize);
+        } /* for */
+        aesEncryptFunc(context, keyStream, keyStream, numBlocks);
+        if (ghash != NULL && !encrypt) {
+          ghashFunc(ghash, h, inBuffer, chunkSize / AES_BLOCK_SIZE);
+        } /* if */
+        for (pos = 0; pos < chunkSize; pos++) {
+          keyStream[pos] ^= inBuffer[pos];
+        } /* for */
+        if (ghash != NULL && encrypt) {
+          ghashFunc(ghash, h, keyStream, chunkSize / AES_BLOCK_SIZE);
+        } /* if */
+        if (ghash != NULL && chunkSize % AES_BLOCK_SIZE != 0) {
+          /* Only the last chunk can have a partial block. */
+          pos = chunkSize - chunkSize % AES_BLOCK_SIZE;
+          memset(&inBuffer[chunkSize], 0, AES_BLOCK_SIZE - chunkSize % AES_BLOCK_SIZE);
+          if (encrypt) {
+            memcpy(&inBuffer[pos], &keyStream[pos], chunkSize - pos);
+          } /* if */
+          ghashFunc(ghash, h, &inBuffer[pos], 1);
+        } /* if */
+        memcpy_to_strelem(resultMem, keyStream, chunkSize);
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* aesCtrProcess */
+
+
+
+/**
+ *  Add the bytes of a string to a GHASH state.
+ *  A partial last block is padded with zero bytes.
+ *  @return TRUE if all characters are in the range 0 to 255,
+ *          FALSE otherwise.
+ */
+static boolType ghashStri (ucharType *ghash, const ucharType *h,
+    const const_striType stri)
+
+  {
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType paddedSize;
+
+  /* ghashStri */
+    mem = stri->mem;
+    remaining = stri->size;
+    while (remaining != 0) {
+      chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+          CONVERSION_BUFFER_SIZE : remaining;
+      if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+        return FALSE;
+      } /* if */
+      paddedSize = (chunkSize + AES_BLOCK_SIZE - 1) & ~(memSizeType) (AES_BLOCK_SIZE - 1);
+      memset(&buffer[chunkSize], 0, paddedSize - chunkSize);
+      ghashFunc(ghash, h, buffer, paddedSize / AES_BLOCK_SIZE);
+      mem += chunkSize;
+      remaining -= chunkSize;
+    } /* while */
+    return TRUE;
+  } /* ghashStri */
+
+
+
+/**
+ *  Encrypt or decrypt with AES in Galois/Counter Mode.
+ *  The result contains the encrypted or decrypted data followed by
+ *  the authentication tag, which is computed from the ciphertext.
+ */
+static striType aesGcm (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType aad,
+    const const_striType data, boolType encrypt)
+
+  {
+    aesContextRecord context;
+    ucharType h[AES_BLOCK_SIZE];
+    ucharType j0[AES_BLOCK_SIZE];
+    ucharType counterBlock[AES_BLOCK_SIZE];
+    ucharType ghash[AES_BLOCK_SIZE];
+    ucharType lengthBlock[AES_BLOCK_SIZE];
+    ucharType tagMask[AES_BLOCK_SIZE];
+    ucharType tag[AES_BLOCK_SIZE];
+    unsigned int idx;
+    striType result;
+
+  /* aesGcm */
+    if (unlikely(!aesContextInit(&context, keySchedule) || iv->size == 0)) {
+      logError(printf("aesGcm: Illegal key schedule or empty iv.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      memset(h, 0, AES_BLOCK_SIZE);
+      aesEncryptFunc(&context, h, h, 1);
+      memset(ghash, 0, AES_BLOCK_SIZE);
+      if (iv->size == 12) {
+        if (unlikely(memcpy_from_strelem(j0, iv->mem, 12))) {
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        j0[12] = 0;
+        j0[13] = 0;
+        j0[14] = 0;
+        j0[15] = 1;
+      } else {
+        memset(j0, 0, AES_BLOCK_SIZE);
+        if (unlikely(!ghashStri(j0, h, iv))) {
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        putUInt64Be(lengthBlock, 0);
+        putUInt64Be(&lengthBlock[8], (uint64Type) iv->size * 8);
+        ghashFunc(j0, h, lengthBlock, 1);
+      } /* if */
+      if (unlikely(!ghashStri(ghash, h, aad))) {
+        logError(printf("aesGcm: Character beyond '\\255;' in aad.\n"););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+      memcpy(counterBlock, j0, AES_BLOCK_SIZE);
+      incrementCounter(counterBlock, 4);
+      result = aesCtrProcess(&context, counterBlock, 4, data, ghash, h,
+                             encrypt, GCM_TAG_SIZE);
+      if (unlikely(result == NULL)) {
+        logError(printf("aesGcm: Character beyond '\\255;' in data.\n"););
+        raise_error(RANGE_ERROR);
+      } else {
+        putUInt64Be(lengthBlock, (uint64Type) aad->size * 8);
+        putUInt64Be(&lengthBlock[8], (uint64Type) data->size * 8);
+        ghashFunc(ghash, h, lengthBlock, 1);
+        aesEncryptFunc(&context, j0, tagMask, 1);
+        for (idx = 0; idx < AES_BLOCK_SIZE; idx++) {
+          tag[idx] = ghash[idx] ^ tagMask[idx];
+        } /* for */
+        memcpy_to_strelem(&result->mem[data->size], tag, GCM_TAG_SIZE);
+      } /* if */
+    } /* if */
+    return result;
+  } /* aesGcm */
+
+
+
+#define CHACHA_ROTL(x, n) ((x) << (n) | (x) >> (32 - (n)))
+
+#define CHACHA_QUARTER_ROUND(a, b, c, d) \
+    a += b; d ^= a; d = CHACHA_ROTL(d, 16); \
+    c += d; b ^= c; b = CHACHA_ROTL(b, 12); \
+    a += b; d ^= a; d = CHACHA_ROTL(d, 8); \
+    c += d; b ^= c; b = CHACHA_ROTL(b, 7);
+
+/**
+ *  Add the ChaCha20 key stream to numBlocks blocks of 64 bytes.
+ *  The block counter in state[12] is incremented afterwards.
+ */
+static void chachaXorPortable (uint32Type *state, ucharType *buffer,
+    memSizeType numBlocks)
+
+  {
+    uint32Type x[16];
+    int idx;
+    int round;
+
+  /* chachaXorPortable */
+    for (; numBlocks != 0; numBlocks--) {
+      memcpy(x, state, sizeof(x));
+      for (round = 0; round < CHACHA_ROUNDS; round += 2) {
+        CHACHA_QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+        CHACHA_QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+        CHACHA_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        CHACHA_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        CHACHA_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        CHACHA_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        CHACHA_QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+        CHACHA_QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+      } /* for */
+      for (idx = 0; idx < 16; idx++) {
+        putUInt32Le(&buffer[4 * idx],
+                    GET_UINT32_LE(&buffer[4 * idx]) ^ (x[idx] + state[idx]));
+      } /* for */
+      state[12]++;
+      buffer += CHACHA_BLOCK_SIZE;
+    } /* for */
+  } /* chachaXorPortable */
+
+
+
+#if HAS_SSE2_INTRINSICS
+#define ROTL_SSE2(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+
+#define QUARTER_ROUND_SSE2(a, b, c, d) \
+    a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTL_SSE2(d, 16); \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTL_SSE2(b, 12); \
+    a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTL_SSE2(d, 8); \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTL_SSE2(b, 7);
+
+/**
+ *  Add the ChaCha20 key stream to numBlocks blocks of 64 bytes.
+ *  Four blocks are computed in parallel. Every vector holds the same
+ *  word of four consecutive blocks. Remaining blocks are processed
+ *  with chachaXorPortable.
+ */
+__attribute__((target("sse2")))
+static void chachaXorSse2 (uint32Type *state, ucharType *buffer,
+    memSizeType numBlocks)
+
+  {
+    __m128i x[16];
+    __m128i t0, t1, t2, t3;
+    __m128i *out;
+    int idx;
+    int round;
+
+  /* chachaXorSse2 */
+    for (; numBlocks >= 4; numBlocks -= 4) {
+      for (idx = 0; idx < 16; idx++) {
+        x[idx] = _mm_set1_epi32((int) state[idx]);
+      } /* for */
+      x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+      for (round = 0; round < CHACHA_ROUNDS; round += 2) {
+        QUARTER_ROUND_SSE2(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND_SSE2(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND_SSE2(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND_SSE2(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND_SSE2(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND_SSE2(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND_SSE2(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND_SSE2(x[3], x[4], x[9],  x[14]);
+      } /* for */
+      for (idx = 0; idx < 16; idx++) {
+        x[idx] = _mm_add_epi32(x[idx], _mm_set1_epi32((int) state[idx]));
+      } /* for */
+      x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+      /* Transpose 4x4 words to get 16 consecutive bytes of each block. */
+      out = (__m128i *) buffer;
+      for (idx = 0; idx < 16; idx += 4) {
+        t0 = _mm_unpacklo_epi32(x[idx], x[idx + 1]);
+        t1 = _mm_unpacklo_epi32(x[idx + 2], x[idx + 3]);
+        t2 = _mm_unpackhi_epi32(x[idx], x[idx + 1]);
+        t3 = _mm_unpackhi_epi32(x[idx + 2], x[idx + 3]);
+        _mm_storeu_si128(&out[idx / 4], _mm_xor_si128(
+            _mm_loadu_si128(&out[idx / 4]), _mm_unpacklo_epi64(t0, t1)));
+        _mm_storeu_si128(&out[4 + idx / 4], _mm_xor_si128(
+            _mm_loadu_si128(&out[4 + idx / 4]), _mm_unpackhi_epi64(t0, t1)));
+        _mm_storeu_si128(&out[8 + idx / 4], _mm_xor_si128(
+            _mm_loadu_si128(&out[8 + idx / 4]), _mm_unpacklo_epi64(t2, t3)));
+        _mm_storeu_si128(&out[12 + idx / 4], _mm_xor_si128(
+            _mm_loadu_si128(&out[12 + idx / 4]), _mm_unpackhi_epi64(t2, t3)));
+      } /* for */
+      state[12] += 4;
+      buffer += 4 * CHACHA_BLOCK_SIZE;
+    } /* for */
+    chachaXorPortable(state, buffer, numBlocks);
+  } /* chachaXorSse2 */
+
+
+
+static boolType cpuHasSse2 (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+
+  /* cpuHasSse2 */
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+           (edx & (1 << 26)) != 0;
+  } /* cpuHasSse2 */
+#endif
+
+
+
+#if HAS_SSE2_INTRINSICS && HAS_AVX2_INTRINSICS
+#define ROTL_AVX2(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define QUARTER_ROUND_AVX2(a, b, c, d) \
+    a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); \
+    d = _mm256_shuffle_epi8(d, rot16); \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = ROTL_AVX2(b, 12); \
+    a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); \
+    d = _mm256_shuffle_epi8(d, rot8); \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = ROTL_AVX2(b, 7);
+
+/**
+ *  Add the ChaCha20 key stream to numBlocks blocks of 64 bytes.
+ *  Eight blocks are computed in parallel. The words are transposed
+ *  inside the 128-bit lanes, such that the lower lane holds the blocks
+ *  0 to 3 and the upper lane holds the blocks 4 to 7. Remaining blocks
+ *  are processed with chachaXorSse2.
+ */
+__attribute__((target("avx2")))
+static void chachaXorAvx2 (uint32Type *state, ucharType *buffer,
+    memSizeType numBlocks)
+
+  {
+    __m256i x[16];
+    __m256i y[16];
+    __m256i t0, t1, t2, t3;
+    __m256i rot16;
+    __m256i rot8;
+    __m256i *out;
+    int idx;
+    int round;
+
+  /* chachaXorAvx2 */
+    rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                            13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                           14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    for (; numBlocks >= 8; numBlocks -= 8) {
+      for (idx = 0; idx < 16; idx++) {
+        x[idx] = _mm256_set1_epi32((int) state[idx]);
+      } /* for */
+      x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+      for (round = 0; round < CHACHA_ROUNDS; round += 2) {
+        QUARTER_ROUND_AVX2(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND_AVX2(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND_AVX2(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND_AVX2(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND_AVX2(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND_AVX2(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND_AVX2(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND_AVX2(x[3], x[4], x[9],  x[14]);
+      } /* for */
+      for (idx = 0; idx < 16; idx++) {
+        x[idx] = _mm256_add_epi32(x[idx], _mm256_set1_epi32((int) state[idx]));
+      } /* for */
+      x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+      /* y[4 * b + w / 4] holds the words w to w + 3 of the */
+      /* blocks b (lower lane) and b + 4 (upper lane). */
+      for (idx = 0; idx < 16; idx += 4) {
+        t0 = _mm256_unpacklo_epi32(x[idx], x[idx + 1]);
+        t1 = _mm256_unpacklo_epi32(x[idx + 2], x[idx + 3]);
+        t2 = _mm256_unpackhi_epi32(x[idx], x[idx + 1]);
+        t3 = _mm256_unpackhi_epi32(x[idx + 2], x[idx + 3]);
+        y[idx / 4]      = _mm256_unpacklo_epi64(t0, t1);
+        y[4 + idx / 4]  = _mm256_unpackhi_epi64(t0, t1);
+        y[8 + idx / 4]  = _mm256_unpacklo_epi64(t2, t3);
+        y[12 + idx / 4] = _mm256_unpackhi_epi64(t2, t3);
+      } /* for */
+      out = (__m256i *) buffer;
+      for (idx = 0; idx < 16; idx += 2) {
+        /* Block idx / 4 gets out[idx / 2], block idx / 4 + 4 gets out[8 + idx / 2]. */
+        _mm256_storeu_si256(&out[idx / 2], _mm256_xor_si256(
+            _mm256_loadu_si256(&out[idx / 2]),
+            _mm256_permute2x128_si256(y[idx], y[idx + 1], 0x20)));
+        _mm256_storeu_si256(&out[8 + idx / 2], _mm256_xor_si256(
+            _mm256_loadu_si256(&out[8 + idx / 2]),
+            _mm256_permute2x128_si256(y[idx], y[idx + 1], 0x31)));
+      } /* for */
+      state[12] += 8;
+      buffer += 8 * CHACHA_BLOCK_SIZE;
+    } /* for */
+    chachaXorSse2(state, buffer, numBlocks);
+  } /* chachaXorAvx2 */
+
+
+
+static boolType cpuHasAvx2 (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int xcr0Low, xcr0High;
+    boolType hasAvx2 = FALSE;
+
+  /* cpuHasAvx2 */
+    /* The operating system must save the AVX registers (OSXSAVE). */
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+        (ecx & (1 << 27)) != 0 && (ecx & (1 << 28)) != 0) {
+      __asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+      hasAvx2 = (xcr0Low & 6) == 6 &&
+                __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                (ebx & (1 << 5)) != 0;
+    } /* if */
+    return hasAvx2;
+  } /* cpuHasAvx2 */
+#endif
+
+
+
+static void selectChaChaFunctions (void)
+
+  { /* selectChaChaFunctions */
+#if HAS_AVX2_INTRINSICS && HAS_SSE2_INTRINSICS
+    if (cpuHasAvx2() && cpuHasSse2()) {
+      chachaXorFunc = chachaXorAvx2;
+    } else
+#endif
+#if HAS_SSE2_INTRINSICS
+    if (cpuHasSse2()) {
+      chachaXorFunc = chachaXorSse2;
+    } else
+#endif
+    {
+      chachaXorFunc = chachaXorPortable;
+    }
+    logFunction(printf("selectChaChaFunctions: %s\n",
+                       chachaXorFunc == chachaXorPortable ?
+                       "not vectorized" : "vectorized"););
+  } /* selectChaChaFunctions */
+
+
+
+/**
+ *  Initialize the ChaCha20 state from key, nonce and block counter.
+ *  @return TRUE if key and nonce have the correct length and contain
+ *          only bytes, FALSE otherwise.
+ */
+static boolType chachaInit (uint32Type *state, const const_striType key,
+    const const_striType nonce, uint32Type counter)
+
+  {
+    ucharType keyBytes[CHACHA_KEY_SIZE];
+    ucharType nonceBytes[CHACHA_NONCE_SIZE];
+    int idx;
+
+  /* chachaInit */
+    if (!bytesFromStri(keyBytes, key, CHACHA_KEY_SIZE) ||
+        !bytesFromStri(nonceBytes, nonce, CHACHA_NONCE_SIZE)) {
+      return FALSE;
+    } /* if */
+    /* "expand 32-byte k" */
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (idx = 0; idx < 8; idx++) {
+      state[4 + idx] = GET_UINT32_LE(&keyBytes[4 * idx]);
+    } /* for */
+    state[12] = counter;
+    for (idx = 0; idx < 3; idx++) {
+      state[13 + idx] = GET_UINT32_LE(&nonceBytes[4 * idx]);
+    } /* for */
+    /* The selected function is assigned in selectChaChaFunctions. */
+    if (unlikely(chachaXorFunc == NULL)) {
+      selectChaChaFunctions();
+    } /* if */
+    return TRUE;
+  } /* chachaInit */
+
+
+
+/**
+ *  Initialize a Poly1305 state with a one-time key of 32 bytes.
+ *  The first 16 bytes are clamped and used as multiplier r. The last
+ *  16 bytes are added to the accumulator at the end.
+ */
+static void poly1305Init (poly1305Type poly, const ucharType *key)
+
+  {
+    int idx;
+
+  /* poly1305Init */
+    poly->r[0] = GET_UINT32_LE(&key[0]) & 0x3ffffff;
+    poly->r[1] = (GET_UINT32_LE(&key[3]) >> 2) & 0x3ffff03;
+    poly->r[2] = (GET_UINT32_LE(&key[6]) >> 4) & 0x3ffc0ff;
+    poly->r[3] = (GET_UINT32_LE(&key[9]) >> 6) & 0x3f03fff;
+    poly->r[4] = (GET_UINT32_LE(&key[12]) >> 8) & 0x00fffff;
+    for (idx = 0; idx < 5; idx++) {
+      poly->h[idx] = 0;
+    } /* for */
+    for (idx = 0; idx < 4; idx++) {
+      poly->pad[idx] = GET_UINT32_LE(&key[16 + 4 * idx]);
+    } /* for */
+  } /* poly1305Init */
+
+
+
+/**
+ *  Add numBlocks full blocks of 16 bytes to a Poly1305 state.
+ *  The accumulator uses five limbs of 26 bits. The computation is
+ *  done in constant time.
+ */
+static void poly1305Blocks (poly1305Type poly, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type r0, r1, r2, r3, r4;
+    uint32Type s1, s2, s3, s4;
+    uint32Type h0, h1, h2, h3, h4;
+    uint64Type d0, d1, d2, d3, d4;
+    uint32Type carry;
+
+  /* poly1305Blocks */
+    r0 = poly->r[0];
+    r1 = poly->r[1];
+    r2 = poly->r[2];
+    r3 = poly->r[3];
+    r4 = poly->r[4];
+    s1 = r1 * 5;
+    s2 = r2 * 5;
+    s3 = r3 * 5;
+    s4 = r4 * 5;
+    h0 = poly->h[0];
+    h1 = poly->h[1];
+    h2 = poly->h[2];
+    h3 = poly->h[3];
+    h4 = poly->h[4];
+    for (; numBlocks != 0; numBlocks--) {
+      h0 += GET_UINT32_LE(&data[0]) & 0x3ffffff;
+      h1 += (GET_UINT32_LE(&data[3]) >> 2) & 0x3ffffff;
+      h2 += (GET_UINT32_LE(&data[6]) >> 4) & 0x3ffffff;
+      h3 += (GET_UINT32_LE(&data[9]) >> 6) & 0x3ffffff;
+      h4 += (GET_UINT32_LE(&data[12]) >> 8) | (1 << 24);
+      d0 = (uint64Type) h0 * r0 + (uint64Type) h1 * s4 + (uint64Type) h2 * s3 +
+           (uint64Type) h3 * s2 + (uint64Type) h4 * s1;
+      d1 = (uint64Type) h0 * r1 + (uint64Type) h1 * r0 + (uint64Type) h2 * s4 +
+           (uint64Type) h3 * s3 + (uint64Type) h4 * s2;
+      d2 = (uint64Type) h0 * r2 + (uint64Type) h1 * r1 + (uint64Type) h2 * r0 +
+           (uint64Type) h3 * s4 + (uint64Type) h4 * s3;
+      d3 = (uint64Type) h0 * r3 + (uint64Type) h1 * r2 + (uint64Type) h2 * r1 +
+           (uint64Type) h3 * r0 + (uint64Type) h4 * s4;
+      d4 = (uint64Type) h0 * r4 + (uint64Type) h1 * r3 + (uint64Type) h2 * r2 +
+           (uint64Type) h3 * r1 + (uint64Type) h4 * r0;
+      carry = (uint32Type) (d0 >> 26);
+      h0 = (uint32Type) d0 & 0x3ffffff;
+      d1 += carry;
+      carry = (uint32Type) (d1 >> 26);
+      h1 = (uint32Type) d1 & 0x3ffffff;
+      d2 += carry;
+      carry = (uint32Type) (d2 >> 26);
+      h2 = (uint32Type) d2 & 0x3ffffff;
+      d3 += carry;
+      carry = (uint32Type) (d3 >> 26);
+      h3 = (uint32Type) d3 & 0x3ffffff;
+      d4 += carry;
+      carry = (uint32Type) (d4 >> 26);
+      h4 = (uint32Type) d4 & 0x3ffffff;
+      h0 += carry * 5;
+      carry = h0 >> 26;
+      h0 &= 0x3ffffff;
+      h1 += carry;
+      data += POLY1305_BLOCK_SIZE;
+    } /* for */
+    poly->h[0] = h0;
+    poly->h[1] = h1;
+    poly->h[2] = h2;
+    poly->h[3] = h3;
+    poly->h[4] = h4;
+  } /* poly1305Blocks */
+
+
+
+/**
+ *  Compute the Poly1305 tag from the accumulator.
+ *  The accumulator is reduced modulo 2**130 - 5 in constant time.
+ */
+static void poly1305Finish (const_poly1305Type poly, ucharType *tag)
+
+  {
+    uint32Type h0, h1, h2, h3, h4;
+    uint32Type g0, g1, g2, g3, g4;
+    uint32Type carry;
+    uint32Type mask;
+    uint64Type sum;
+
+  /* poly1305Finish */
+    h0 = poly->h[0];
+    h1 = poly->h[1];
+    h2 = poly->h[2];
+    h3 = poly->h[3];
+    h4 = poly->h[4];
+    carry = h1 >> 26;
+    h1 &= 0x3ffffff;
+    h2 += carry;
+    carry = h2 >> 26;
+    h2 &= 0x3ffffff;
+    h3 += carry;
+    carry = h3 >> 26;
+    h3 &= 0x3ffffff;
+    h4 += carry;
+    carry = h4 >> 26;
+    h4 &= 0x3ffffff;
+    h0 += carry * 5;
+    carry = h0 >> 26;
+    h0 &= 0x3ffffff;
+    h1 += carry;
+    /* g = h + 5 - 2**130 */
+    g0 = h0 + 5;
+    carry = g0 >> 26;
+    g0 &= 0x3ffffff;
+    g1 = h1 + carry;
+    carry = g1 >> 26;
+    g1 &= 0x3ffffff;
+    g2 = h2 + carry;
+    carry = g2 >> 26;
+    g2 &= 0x3ffffff;
+    g3 = h3 + carry;
+    carry = g3 >> 26;
+    g3 &= 0x3ffffff;
+    g4 = h4 + carry - (1 << 26);
+    /* Select h if g is negative and g otherwise. */
+    mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+    /* Convert to 4 words of 32 bits and add pad modulo 2**128. */
+    h0 = h0 | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+    sum = (uint64Type) h0 + poly->pad[0];
+    putUInt32Le(&tag[0], (uint32Type) sum);
+    sum = (uint64Type) h1 + poly->pad[1] + (sum >> 32);
+    putUInt32Le(&tag[4], (uint32Type) sum);
+    sum = (uint64Type) h2 + poly->pad[2] + (sum >> 32);
+    putUInt32Le(&tag[8], (uint32Type) sum);
+    sum = (uint64Type) h3 + poly->pad[3] + (sum >> 32);
+    putUInt32Le(&tag[12], (uint32Type) sum);
+  } /* poly1305Finish */
+
+
+
+/**
+ *  Add the bytes of a string to a Poly1305 state.
+ *  A partial last block is padded with zero bytes.
+ *  @return TRUE if all characters are in the range 0 to 255,
+ *          FALSE otherwise.
+ */
+static boolType poly1305Stri (poly1305Type poly, const const_striType stri)
+
+  {
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType paddedSize;
+
+  /* poly1305Stri */
+    mem = stri->mem;
+    remaining = stri->size;
+    while (remaining != 0) {
+      chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+          CONVERSION_BUFFER_SIZE : remaining;
+      if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+        return FALSE;
+      } /* if */
+      paddedSize = (chunkSize + POLY1305_BLOCK_SIZE - 1) &
+                   ~(memSizeType) (POLY1305_BLOCK_SIZE - 1);
+      memset(&buffer[chunkSize], 0, paddedSize - chunkSize);
+      poly1305Blocks(poly, buffer, paddedSize / POLY1305_BLOCK_SIZE);
+      mem += chunkSize;
+      remaining -= chunkSize;
+    } /* while */
+    return TRUE;
+  } /* poly1305Stri */
+
+
+
+/**
+ *  Encrypt or decrypt a string with the ChaCha20 key stream.
+ *  If poly is not NULL the ciphertext is added to the Poly1305 state.
+ *  @return the encrypted or decrypted data or NULL if the data
+ *          contains a character beyond '\255;'.
+ */
+static striType chachaProcess (uint32Type *state, const const_striType data,
+    poly1305Type poly, boolType encrypt, memSizeType extraSize)
+
+  {
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType paddedSize;
+    striType result;
+
+  /* chachaProcess */
+    result = allocResult(data->size + extraSize);
+    if (result != NULL) {
+      mem = data->mem;
+      resultMem = result->mem;
+      remaining = data->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+          FREE_STRI(result, data->size + extraSize);
+          return NULL;
+        } /* if */
+        /* Only the last chunk can have a partial block. */
+        paddedSize = (chunkSize + CHACHA_BLOCK_SIZE - 1) &
+                     ~(memSizeType) (CHACHA_BLOCK_SIZE - 1);
+        memset(&buffer[chunkSize], 0, paddedSize - chunkSize);
+        if (poly != NULL && !encrypt) {
+          poly1305Blocks(poly, buffer, (chunkSize + POLY1305_BLOCK_SIZE - 1) /
+                                       POLY1305_BLOCK_SIZE);
+        } /* if */
+        chachaXorFunc(state, buffer, paddedSize / CHACHA_BLOCK_SIZE);
+        memcpy_to_strelem(resultMem, buffer, chunkSize);
+        if (poly != NULL && encrypt) {
+          memset(&buffer[chunkSize], 0, paddedSize - chunkSize);
+          poly1305Blocks(poly, buffer, (chunkSize + POLY1305_BLOCK_SIZE - 1) /
+                                       POLY1305_BLOCK_SIZE);
+        } /* if */
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* chachaProcess */
+
+
+
+/**
+ *  Encrypt or decrypt with the AEAD construction ChaCha20-Poly1305.
+ *  The result contains the encrypted or decrypted data followed by
+ *  the authentication tag, which is computed from the ciphertext.
+ */
+static striType chachaPoly1305 (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType data, boolType encrypt)
+
+  {
+    uint32Type state[16];
+    ucharType polyKey[CHACHA_BLOCK_SIZE];
+    ucharType lengthBlock[POLY1305_BLOCK_SIZE];
+    ucharType tag[POLY1305_TAG_SIZE];
+    poly1305Record poly;
+    striType result;
+
+  /* chachaPoly1305 */
+    if (unlikely(!chachaInit(state, key, nonce, 0))) {
+      logError(printf("chachaPoly1305: Illegal key or nonce.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      /* The first key stream block is used as Poly1305 key. */
+      memset(polyKey, 0, CHACHA_BLOCK_SIZE);
+      chachaXorFunc(state, polyKey, 1);
+      poly1305Init(&poly, polyKey);
+      if (unlikely(!poly1305Stri(&poly, aad))) {
+        logError(printf("chachaPoly1305: Character beyond '\\255;' in aad.\n"););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+      result = chachaProcess(state, data, &poly, encrypt, POLY1305_TAG_SIZE);
+      if (unlikely(result == NULL)) {
+        logError(printf("chachaPoly1305: Character beyond '\\255;' in data.\n"););
+        raise_error(RANGE_ERROR);
+      } else {
+        putUInt64Le(lengthBlock, (uint64Type) aad->size);
+        putUInt64Le(&lengthBlock[8], (uint64Type) data->size);
+        poly1305Blocks(&poly, lengthBlock, 1);
+        poly1305Finish(&poly, tag);
+        memcpy_to_strelem(&result->mem[data->size], tag, POLY1305_TAG_SIZE);
+      } /* if */
+    } /* if */
+    return result;
+  } /* chachaPoly1305 */
+
+
+
+/**
+ *  Decrypt a string with AES in Cipher Block Chaining (CBC) mode.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param iv Initialization vector of 16 bytes.
+ *  @param encoded Encrypted data with a multiple of 16 bytes.
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv or
+ *             the data have an illegal length or contain characters
+ *             beyond '\255;'.
+ */
+striType cipAesCbcDecode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType encoded)
+
+  {
+    aesContextRecord context;
+    ucharType chain[AES_BLOCK_SIZE];
+    ucharType inBuffer[CONVERSION_BUFFER_SIZE];
+    ucharType outBuffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType pos;
+    striType result;
+
+  /* cipAesCbcDecode */
+    if (unlikely(!aesContextInit(&context, keySchedule) ||
+                 !bytesFromStri(chain, iv, AES_BLOCK_SIZE) ||
+                 encoded->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("cipAesCbcDecode: Illegal key schedule, iv or length.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if ((result = allocResult(encoded->size)) != NULL) {
+      mem = encoded->mem;
+      resultMem = result->mem;
+      remaining = encoded->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(inBuffer, mem, chunkSize))) {
+          FREE_STRI(result, encoded->size);
+          logError(printf("cipAesCbcDecode: Character beyond '\\255;'.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        aesDecryptFunc(&context, inBuffer, outBuffer, chunkSize / AES_BLOCK_SIZE);
+        for (pos = 0; pos < AES_BLOCK_SIZE; pos++) {
+          outBuffer[pos] ^= chain[pos];
+        } /* for */
+        for (pos = AES_BLOCK_SIZE; pos < chunkSize; pos++) {
+          outBuffer[pos] ^= inBuffer[pos - AES_BLOCK_SIZE];
+        } /* for */
+        memcpy(chain, &inBuffer[chunkSize - AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+        memcpy_to_strelem(resultMem, outBuffer, chunkSize);
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* cipAesCbcDecode */
+
+
+
+/**
+ *  Encrypt a string with AES in Cipher Block Chaining (CBC) mode.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param iv Initialization vector of 16 bytes.
+ *  @param plaintext Data with a multiple of 16 bytes.
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv or
+ *             the data have an illegal length or contain characters
+ *             beyond '\255;'.
+ */
+striType cipAesCbcEncode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType plaintext)
+
+  {
+    aesContextRecord context;
+    ucharType chain[AES_BLOCK_SIZE];
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType pos;
+    unsigned int idx;
+    striType result;
+
+  /* cipAesCbcEncode */
+    if (unlikely(!aesContextInit(&context, keySchedule) ||
+                 !bytesFromStri(chain, iv, AES_BLOCK_SIZE) ||
+                 plaintext->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("cipAesCbcEncode: Illegal key schedule, iv or length.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if ((result = allocResult(plaintext->size)) != NULL) {
+      mem = plaintext->mem;
+      resultMem = result->mem;
+      remaining = plaintext->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+          FREE_STRI(result, plaintext->size);
+          logError(printf("cipAesCbcEncode: Character beyond '\\255;'.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        for (pos = 0; pos < chunkSize; pos += AES_BLOCK_SIZE) {
+          for (idx = 0; idx < AES_BLOCK_SIZE; idx++) {
+            buffer[pos + idx] ^= chain[idx];
+          } /* for */
+          aesEncryptFunc(&context, &buffer[pos], &buffer[pos], 1);
+          memcpy(chain, &buffer[pos], AES_BLOCK_SIZE);
+        } /* for */
+        memcpy_to_strelem(resultMem, buffer, chunkSize);
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* cipAesCbcEncode */
+
+
+
+/**
+ *  Encrypt or decrypt a string with AES in Counter (CTR) mode.
+ *  The counter block is incremented as 128-bit big-endian number.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param counterBlock Initial counter block of 16 bytes.
+ *  @param data Data of any length.
+ *  @return the encrypted or decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the counter
+ *             block has an illegal length or a character beyond
+ *             '\255;' is found.
+ */
+striType cipAesCtr (const const_bstriType keySchedule,
+    const const_striType counterBlock, const const_striType data)
+
+  {
+    aesContextRecord context;
+    ucharType counter[AES_BLOCK_SIZE];
+    striType result;
+
+  /* cipAesCtr */
+    if (unlikely(!aesContextInit(&context, keySchedule) ||
+                 !bytesFromStri(counter, counterBlock, AES_BLOCK_SIZE))) {
+      logError(printf("cipAesCtr: Illegal key schedule or counter block.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      result = aesCtrProcess(&context, counter, AES_BLOCK_SIZE, data,
+                             NULL, NULL, TRUE, 0);
+      if (unlikely(result == NULL)) {
+        logError(printf("cipAesCtr: Character beyond '\\255;'.\n"););
+        raise_error(RANGE_ERROR);
+      } /* if */
+    } /* if */
+    return result;
+  } /* cipAesCtr */
+
+
+
+/**
+ *  Decrypt a string with AES in Electronic Codebook (ECB) mode.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param encoded Encrypted data with a multiple of 16 bytes.
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the data
+ *             has an illegal length or contains characters beyond
+ *             '\255;'.
+ */
+striType cipAesEcbDecode (const const_bstriType keySchedule,
+    const const_striType encoded)
+
+  {
+    aesContextRecord context;
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    striType result;
+
+  /* cipAesEcbDecode */
+    if (unlikely(!aesContextInit(&context, keySchedule) ||
+                 encoded->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("cipAesEcbDecode: Illegal key schedule or length.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if ((result = allocResult(encoded->size)) != NULL) {
+      mem = encoded->mem;
+      resultMem = result->mem;
+      remaining = encoded->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+          FREE_STRI(result, encoded->size);
+          logError(printf("cipAesEcbDecode: Character beyond '\\255;'.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        aesDecryptFunc(&context, buffer, buffer, chunkSize / AES_BLOCK_SIZE);
+        memcpy_to_strelem(resultMem, buffer, chunkSize);
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* cipAesEcbDecode */
+
+
+
+/**
+ *  Encrypt a string with AES in Electronic Codebook (ECB) mode.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param plaintext Data with a multiple of 16 bytes.
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the data
+ *             has an illegal length or contains characters beyond
+ *             '\255;'.
+ */
+striType cipAesEcbEncode (const const_bstriType keySchedule,
+    const const_striType plaintext)
+
+  {
+    aesContextRecord context;
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    strElemType *resultMem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    striType result;
+
+  /* cipAesEcbEncode */
+    if (unlikely(!aesContextInit(&context, keySchedule) ||
+                 plaintext->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("cipAesEcbEncode: Illegal key schedule or length.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if ((result = allocResult(plaintext->size)) != NULL) {
+      mem = plaintext->mem;
+      resultMem = result->mem;
+      remaining = plaintext->size;
+      while (remaining != 0) {
+        chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+            CONVERSION_BUFFER_SIZE : remaining;
+        if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+          FREE_STRI(result, plaintext->size);
+          logError(printf("cipAesEcbEncode: Character beyond '\\255;'.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        aesEncryptFunc(&context, buffer, buffer, chunkSize / AES_BLOCK_SIZE);
+        memcpy_to_strelem(resultMem, buffer, chunkSize);
+        mem += chunkSize;
+        resultMem += chunkSize;
+        remaining -= chunkSize;
+      } /* while */
+    } /* if */
+    return result;
+  } /* cipAesEcbEncode */
+
+
+
+/**
+ *  Decrypt a string with AES in Galois/Counter Mode (GCM).
+ *  The authentication tag is not checked. It is computed from the
+ *  ciphertext and appended to the decrypted data. The caller must
+ *  compare it with the received tag.
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param iv Initialization vector (12 bytes are recommended).
+ *  @param aad Additional authenticated data.
+ *  @param encoded Encrypted data without authentication tag.
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv is
+ *             empty or a character beyond '\255;' is found.
+ */
+striType cipAesGcmDecode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType aad,
+    const const_striType encoded)
+
+  { /* cipAesGcmDecode */
+    return aesGcm(keySchedule, iv, aad, encoded, FALSE);
+  } /* cipAesGcmDecode */
+
+
+
+/**
+ *  Encrypt a string with AES in Galois/Counter Mode (GCM).
+ *  @param keySchedule AES key schedule created with cipAesKey.
+ *  @param iv Initialization vector (12 bytes are recommended).
+ *  @param aad Additional authenticated data.
+ *  @param plaintext Data of any length.
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv is
+ *             empty or a character beyond '\255;' is found.
+ */
+striType cipAesGcmEncode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType aad,
+    const const_striType plaintext)
+
+  { /* cipAesGcmEncode */
+    return aesGcm(keySchedule, iv, aad, plaintext, TRUE);
+  } /* cipAesGcmEncode */
+
+
+
+/**
+ *  Compute the key schedule of AES.
+ *  @param key AES key with 16, 24 or 32 bytes.
+ *  @return the encryption round keys stored in a bstring.
+ *  @exception RANGE_ERROR The key has an illegal length or contains
+ *             characters beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType cipAesKey (const const_striType key)
+
+  {
+    ucharType keyBytes[32];
+    memSizeType size;
+    bstriType result;
+
+  /* cipAesKey */
+    logFunction(printf("cipAesKey(" FMT_U_MEM ")\n", key->size););
+    if (unlikely((key->size != 16 && key->size != 24 && key->size != 32) ||
+                 memcpy_from_strelem(keyBytes, key->mem, key->size))) {
+      logError(printf("cipAesKey: Illegal key length or character "
+                      "beyond '\\255;'.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      size = (key->size / 4 + 7) * AES_BLOCK_SIZE;
+      if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = size;
+        aesExpandKey(keyBytes, (unsigned int) key->size, result->mem);
+      } /* if */
+    } /* if */
+    return result;
+  } /* cipAesKey */
+
+
+
+/**
+ *  Encrypt or decrypt a string with the stream cipher ChaCha20.
+ *  @param key Key of 32 bytes.
+ *  @param nonce Nonce of 12 bytes.
+ *  @param counter Block counter of the first block (0 to 4294967295).
+ *  @param data Data of any length.
+ *  @return the data xored with the ChaCha20 key stream.
+ *  @exception RANGE_ERROR The key, the nonce or the counter are not
+ *             valid or a character beyond '\255;' is found.
+ */
+striType cipChaCha20 (const const_striType key, const const_striType nonce,
+    intType counter, const const_striType data)
+
+  {
+    uint32Type state[16];
+    striType result;
+
+  /* cipChaCha20 */
+    logFunction(printf("cipChaCha20(*, *, " FMT_D ", " FMT_U_MEM ")\n",
+                       counter, data->size););
+    if (unlikely(counter < 0 || (uintType) counter > UINT32TYPE_MAX ||
+                 !chachaInit(state, key, nonce, (uint32Type) counter))) {
+      logError(printf("cipChaCha20: Illegal key, nonce or counter.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      result = chachaProcess(state, data, NULL, TRUE, 0);
+      if (unlikely(result == NULL)) {
+        logError(printf("cipChaCha20: Character beyond '\\255;' in data.\n"););
+        raise_error(RANGE_ERROR);
+      } /* if */
+    } /* if */
+    return result;
+  } /* cipChaCha20 */
+
+
+
+/**
+ *  Decrypt a string with ChaCha20-Poly1305 (RFC 8439).
+ *  The authentication tag is not checked. It is computed from the
+ *  encrypted data and appended to the result. The caller must
+ *  compare it with the received tag.
+ *  @param key Key of 32 bytes.
+ *  @param nonce Nonce of 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @param encoded Encrypted data without authentication tag.
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *  @exception RANGE_ERROR The key or the nonce have an illegal length
+ *             or a character beyond '\255;' is found.
+ */
+striType cipChaCha20Poly1305Decode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType encoded)
+
+  { /* cipChaCha20Poly1305Decode */
+    return chachaPoly1305(key, nonce, aad, encoded, FALSE);
+  } /* cipChaCha20Poly1305Decode */
+
+
+
+/**
+ *  Encrypt a string with ChaCha20-Poly1305 (RFC 8439).
+ *  @param key Key of 32 bytes.
+ *  @param nonce Nonce of 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @param plaintext Data of any length.
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR The key or the nonce have an illegal length
+ *             or a character beyond '\255;' is found.
+ */
+striType cipChaCha20Poly1305Encode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType plaintext)
+
+  { /* cipChaCha20Poly1305Encode */
+    return chachaPoly1305(key, nonce, aad, plaintext, TRUE);
+  } /* cipChaCha20Poly1305Encode */
@@ -0,0 +1,56 @@
+/********************************************************************/
+/*                                                                  */
+/*  cip_rtl.h     Primitive actions for ciphers.                    */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cip_rtl.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for ciphers.                         */
+/*                                                                  */
+/********************************************************************/
+
+striType cipAesCbcDecode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType encoded);
+striType cipAesCbcEncode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType plaintext);
+striType cipAesCtr (const const_bstriType keySchedule,
+    const const_striType counterBlock, const const_striType data);
+striType cipAesEcbDecode (const const_bstriType keySchedule,
+    const const_striType encoded);
+striType cipAesEcbEncode (const const_bstriType keySchedule,
+    const const_striType plaintext);
+striType cipAesGcmDecode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType aad,
+    const const_striType encoded);
+striType cipAesGcmEncode (const const_bstriType keySchedule,
+    const const_striType iv, const const_striType aad,
+    const const_striType plaintext);
+bstriType cipAesKey (const const_striType key);
+striType cipChaCha20 (const const_striType key, const const_striType nonce,
+    intType counter, const const_striType data);
+striType cipChaCha20Poly1305Decode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType encoded);
+striType cipChaCha20Poly1305Encode (const const_striType key,
+    const const_striType nonce, const const_striType aad,
+    const const_striType plaintext);
@@ -0,0 +1,292 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/ciplib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for ciphers.                     */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "cip_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "ciplib.h"
+
+
+
+/**
+ *  Decrypt encoded/arg_3 with AES in CBC mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key and
+ *  the initialization vector iv/arg_2 has 16 bytes.
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv or
+ *             the data have an illegal length or contain characters
+ *             beyond '\255;'.
+ */
+objectType cip_aes_cbc_decode (listType arguments)
+
+  { /* cip_aes_cbc_decode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cipAesCbcDecode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments)),
+                        take_stri(arg_3(arguments))));
+  } /* cip_aes_cbc_decode */
+
+
+
+/**
+ *  Encrypt plaintext/arg_3 with AES in CBC mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key and
+ *  the initialization vector iv/arg_2 has 16 bytes.
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv or
+ *             the data have an illegal length or contain characters
+ *             beyond '\255;'.
+ */
+objectType cip_aes_cbc_encode (listType arguments)
+
+  { /* cip_aes_cbc_encode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cipAesCbcEncode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments)),
+                        take_stri(arg_3(arguments))));
+  } /* cip_aes_cbc_encode */
+
+
+
+/**
+ *  Encrypt or decrypt data/arg_3 with AES in CTR mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key and
+ *  the initial counter block counterBlock/arg_2 has 16 bytes.
+ *  @return the encrypted or decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the counter
+ *             block has an illegal length or a character beyond
+ *             '\255;' is found.
+ */
+objectType cip_aes_ctr (listType arguments)
+
+  { /* cip_aes_ctr */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cipAesCtr(take_bstri(arg_1(arguments)),
+                  take_stri(arg_2(arguments)),
+                  take_stri(arg_3(arguments))));
+  } /* cip_aes_ctr */
+
+
+
+/**
+ *  Decrypt encoded/arg_2 with AES in ECB mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key.
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the data
+ *             has an illegal length or contains characters beyond
+ *             '\255;'.
+ */
+objectType cip_aes_ecb_decode (listType arguments)
+
+  { /* cip_aes_ecb_decode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        cipAesEcbDecode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments))));
+  } /* cip_aes_ecb_decode */
+
+
+
+/**
+ *  Encrypt plaintext/arg_2 with AES in ECB mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key.
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR The key schedule is not valid, the data
+ *             has an illegal length or contains characters beyond
+ *             '\255;'.
+ */
+objectType cip_aes_ecb_encode (listType arguments)
+
+  { /* cip_aes_ecb_encode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        cipAesEcbEncode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments))));
+  } /* cip_aes_ecb_encode */
+
+
+
+/**
+ *  Decrypt encoded/arg_4 with AES in GCM mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key. The
+ *  initialization vector is iv/arg_2 and the additional
+ *  authenticated data is aad/arg_3.
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv is
+ *             empty or a character beyond '\255;' is found.
+ */
+objectType cip_aes_gcm_decode (listType arguments)
+
+  { /* cip_aes_gcm_decode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cipAesGcmDecode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments)),
+                        take_stri(arg_3(arguments)),
+                        take_stri(arg_4(arguments))));
+  } /* cip_aes_gcm_decode */
+
+
+
+/**
+ *  Encrypt plaintext/arg_4 with AES in GCM mode.
+ *  The keySchedule/arg_1 has been created with cip_aes_key. The
+ *  initialization vector is iv/arg_2 and the additional
+ *  authenticated data is aad/arg_3.
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR The key schedule is not valid, the iv is
+ *             empty or a character beyond '\255;' is found.
+ */
+objectType cip_aes_gcm_encode (listType arguments)
+
+  { /* cip_aes_gcm_encode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cipAesGcmEncode(take_bstri(arg_1(arguments)),
+                        take_stri(arg_2(arguments)),
+                        take_stri(arg_3(arguments)),
+                        take_stri(arg_4(arguments))));
+  } /* cip_aes_gcm_encode */
+
+
+
+/**
+ *  Compute the AES key schedule of key/arg_1.
+ *  @return the key schedule stored in a bstring.
+ *  @exception RANGE_ERROR The key has not 16, 24 or 32 bytes or
+ *             contains characters beyond '\255;'.
+ */
+objectType cip_aes_key (listType arguments)
+
+  { /* cip_aes_key */
+    isit_stri(arg_1(arguments));
+    return bld_bstri_temp(
+        cipAesKey(take_stri(arg_1(arguments))));
+  } /* cip_aes_key */
+
+
+
+/**
+ *  Encrypt or decrypt data/arg_4 with the stream cipher ChaCha20.
+ *  The key/arg_1 has 32 bytes and the nonce/arg_2 has 12 bytes.
+ *  The key stream starts with the block counter/arg_3.
+ *  @return the data xored with the ChaCha20 key stream.
+ *  @exception RANGE_ERROR The key, the nonce or the counter are not
+ *             valid or a character beyond '\255;' is found.
+ */
+objectType cip_chacha20 (listType arguments)
+
+  { /* cip_chacha20 */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cipChaCha20(take_stri(arg_1(arguments)),
+                    take_stri(arg_2(arguments)),
+                    take_int(arg_3(arguments)),
+                    take_stri(arg_4(arguments))));
+  } /* cip_chacha20 */
+
+
+
+/**
+ *  Decrypt encoded/arg_4 with ChaCha20-Poly1305.
+ *  The key/arg_1 has 32 bytes and the nonce/arg_2 has 12 bytes.
+ *  The additional authenticated data is aad/arg_3.
+ *  @return the decrypted data followed by the computed 16 byte tag.
+ *  @exception RANGE_ERROR The key or the nonce have an illegal length
+ *             or a character beyond '\255;' is found.
+ */
+objectType cip_chacha20_poly1305_decode (listType arguments)
+
+  { /* cip_chacha20_poly1305_decode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cipChaCha20Poly1305Decode(take_stri(arg_1(arguments)),
+                                  take_stri(arg_2(arguments)),
+                                  take_stri(arg_3(arguments)),
+                                  take_stri(arg_4(arguments))));
+  } /* cip_chacha20_poly1305_decode */
+
+
+
+/**
+ *  Encrypt plaintext/arg_4 with ChaCha20-Poly1305.
+ *  The key/arg_1 has 32 bytes and the nonce/arg_2 has 12 bytes.
+ *  The additional authenticated data is aad/arg_3.
+ *  @return the encrypted data followed by the 16 byte tag.
+ *  @exception RANGE_ERROR The key or the nonce have an illegal length
+ *             or a character beyond '\255;' is found.
+ */
+objectType cip_chacha20_poly1305_encode (listType arguments)
+
+  { /* cip_chacha20_poly1305_encode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        cipChaCha20Poly1305Encode(take_stri(arg_1(arguments)),
+                                  take_stri(arg_2(arguments)),
+                                  take_stri(arg_3(arguments)),
+                                  take_stri(arg_4(arguments))));
+  } /* cip_chacha20_poly1305_encode */
@@ -0,0 +1,38 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/ciplib.h                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for ciphers.                     */
+/*                                                                  */
+/********************************************************************/
+
+objectType cip_aes_cbc_decode           (listType arguments);
+objectType cip_aes_cbc_encode           (listType arguments);
+objectType cip_aes_ctr                  (listType arguments);
+objectType cip_aes_ecb_decode           (listType arguments);
+objectType cip_aes_ecb_encode           (listType arguments);
+objectType cip_aes_gcm_decode           (listType arguments);
+objectType cip_aes_gcm_encode           (listType arguments);
+objectType cip_aes_key                  (listType arguments);
+objectType cip_chacha20                 (listType arguments);
+objectType cip_chacha20_poly1305_decode (listType arguments);
+objectType cip_chacha20_poly1305_encode (listType arguments);
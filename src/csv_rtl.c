@@ -0,0 +1,645 @@
+/********************************************************************/
+/*                                                                  */
+/*  csv_rtl.c     Primitive actions for CSV records.                */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/csv_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for CSV records.                     */
+/*                                                                  */
+/*  A record is scanned in two steps. The first step determines     */
+/*  the start and the length of every field, without copying        */
+/*  anything. The second step creates strings (or numbers) just     */
+/*  for the requested columns. Double quoted fields are searched    */
+/*  with memchr_strelem and unquoted fields with a loop without     */
+/*  function calls, such that the C compiler can optimize them.     */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "wchar.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "int_rtl.h"
+#include "flt_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "csv_rtl.h"
+
+
+#define INITIAL_FIELD_CAPACITY 64
+
+typedef struct {
+    memSizeType start;
+    memSizeType length;
+    boolType quoted;
+  } csvFieldType;
+
+typedef struct {
+    memSizeType numFields;
+    memSizeType capacity;
+    csvFieldType *fields;
+    csvFieldType initialFields[INITIAL_FIELD_CAPACITY];
+  } csvRecordType;
+
+typedef enum {
+    RECORD_INCOMPLETE,
+    RECORD_COMPLETE,
+    RECORD_ILLEGAL,
+    RECORD_NO_MEMORY
+  } recordStatusType;
+
+
+
+static void initRecord (csvRecordType *record)
+
+  { /* initRecord */
+    record->numFields = 0;
+    record->capacity = INITIAL_FIELD_CAPACITY;
+    record->fields = record->initialFields;
+  } /* initRecord */
+
+
+
+static void freeRecord (csvRecordType *record)
+
+  { /* freeRecord */
+    if (record->fields != record->initialFields) {
+      free(record->fields);
+    } /* if */
+  } /* freeRecord */
+
+
+
+static boolType addField (csvRecordType *record, memSizeType start,
+    memSizeType length, boolType quoted)
+
+  {
+    csvFieldType *resizedFields;
+    boolType okay = TRUE;
+
+  /* addField */
+    if (record->numFields >= record->capacity) {
+      if (record->fields == record->initialFields) {
+        resizedFields = (csvFieldType *) malloc(
+            2 * record->capacity * sizeof(csvFieldType));
+        if (resizedFields != NULL) {
+          memcpy(resizedFields, record->initialFields,
+                 record->capacity * sizeof(csvFieldType));
+        } /* if */
+      } else {
+        resizedFields = (csvFieldType *) realloc(record->fields,
+            2 * record->capacity * sizeof(csvFieldType));
+      } /* if */
+      if (unlikely(resizedFields == NULL)) {
+        okay = FALSE;
+      } else {
+        record->fields = resizedFields;
+        record->capacity *= 2;
+      } /* if */
+    } /* if */
+    if (likely(okay)) {
+      record->fields[record->numFields].start = start;
+      record->fields[record->numFields].length = length;
+      record->fields[record->numFields].quoted = quoted;
+      record->numFields++;
+    } /* if */
+    return okay;
+  } /* addField */
+
+
+
+/**
+ *  Determine the fields of the record, which starts at recordStart.
+ *  Only the first maxFields fields are added to record. The record
+ *  ends with '\n', "\r\n" or with the end of the buffer. A '\r' at
+ *  the end of the buffer is treated like "\r\n". If atEnd is FALSE
+ *  the end of the buffer does not end the record.
+ *  @param recordEnd Index after the end of the record (only
+ *         defined, if RECORD_COMPLETE is returned).
+ */
+static recordStatusType scanRecord (const const_striType buffer,
+    memSizeType recordStart, charType separator, boolType atEnd,
+    memSizeType maxFields, csvRecordType *record, memSizeType *recordEnd)
+
+  {
+    const strElemType *mem;
+    memSizeType length;
+    memSizeType pos;
+    memSizeType fieldStart;
+    memSizeType fieldEnd;
+    memSizeType fieldNumber = 0;
+    const strElemType *found;
+    boolType quoted;
+    recordStatusType status = RECORD_INCOMPLETE;
+
+  /* scanRecord */
+    mem = buffer->mem;
+    length = buffer->size;
+    pos = recordStart;
+    do {
+      if (pos < length && mem[pos] == '"') {
+        quoted = TRUE;
+        fieldStart = pos + 1;
+        pos = fieldStart;
+        fieldEnd = 0;
+        do {
+          found = memchr_strelem(&mem[pos], '"', length - pos);
+          if (found == NULL) {
+            if (!atEnd) {
+              return RECORD_INCOMPLETE;
+            } /* if */
+            /* An unterminated quoted field ends with the data. */
+            pos = length;
+            fieldEnd = length;
+          } else {
+            pos = (memSizeType) (found - mem) + 1;
+            if (pos >= length) {
+              if (!atEnd) {
+                return RECORD_INCOMPLETE;
+              } /* if */
+              fieldEnd = pos - 1;
+            } else if (mem[pos] == '"') {
+              pos++;
+            } else {
+              fieldEnd = pos - 1;
+            } /* if */
+          } /* if */
+        } while (fieldEnd == 0);
+        if (pos >= length) {
+          status = RECORD_COMPLETE;
+        } else if (mem[pos] == separator) {
+          pos++;
+        } else if (mem[pos] == '\n') {
+          pos++;
+          status = RECORD_COMPLETE;
+        } else if (mem[pos] == '\r') {
+          pos++;
+          if (pos >= length) {
+            if (!atEnd) {
+              return RECORD_INCOMPLETE;
+            } /* if */
+            status = RECORD_COMPLETE;
+          } else if (mem[pos] == '\n') {
+            pos++;
+            status = RECORD_COMPLETE;
+          } else {
+            return RECORD_ILLEGAL;
+          } /* if */
+        } else {
+          return RECORD_ILLEGAL;
+        } /* if */
+      } else {
+        quoted = FALSE;
+        fieldStart = pos;
+        while (pos < length && mem[pos] != separator && mem[pos] != '\n') {
+          pos++;
+        } /* while */
+        fieldEnd = pos;
+        if (pos < length && mem[pos] == separator) {
+          pos++;
+        } else {
+          if (pos >= length) {
+            if (!atEnd) {
+              return RECORD_INCOMPLETE;
+            } /* if */
+          } else {
+            pos++;
+          } /* if */
+          /* A '\r' before '\n' or at the end of the data */
+          /* is part of the line ending and not of the field. */
+          if (fieldEnd > fieldStart && mem[fieldEnd - 1] == '\r') {
+            fieldEnd--;
+          } /* if */
+          status = RECORD_COMPLETE;
+        } /* if */
+      } /* if */
+      if (fieldNumber < maxFields) {
+        if (unlikely(!addField(record, fieldStart, fieldEnd - fieldStart,
+                               quoted))) {
+          return RECORD_NO_MEMORY;
+        } /* if */
+      } /* if */
+      fieldNumber++;
+    } while (status == RECORD_INCOMPLETE);
+    *recordEnd = pos;
+    return status;
+  } /* scanRecord */
+
+
+
+/**
+ *  Create a string with the value of a field.
+ *  Doubled double quotes inside a double quoted field are
+ *  replaced by a single double quote.
+ *  @return the new string, or NULL if there is not enough memory.
+ */
+static striType fieldToStri (const const_striType buffer,
+    const csvFieldType *field)
+
+  {
+    const strElemType *mem;
+    memSizeType pos;
+    memSizeType destPos;
+    memSizeType numQuotes = 0;
+    striType result;
+
+  /* fieldToStri */
+    mem = &buffer->mem[field->start];
+    if (field->quoted) {
+      for (pos = 0; pos < field->length; pos++) {
+        if (mem[pos] == '"') {
+          numQuotes++;
+        } /* if */
+      } /* for */
+    } /* if */
+    if (likely(ALLOC_STRI_SIZE_OK(result, field->length - numQuotes / 2))) {
+      result->size = field->length - numQuotes / 2;
+      if (numQuotes == 0) {
+        memcpy(result->mem, mem, field->length * sizeof(strElemType));
+      } else {
+        destPos = 0;
+        for (pos = 0; pos < field->length; pos++) {
+          result->mem[destPos] = mem[pos];
+          destPos++;
+          if (mem[pos] == '"') {
+            pos++;
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* if */
+    return result;
+  } /* fieldToStri */
+
+
+
+/**
+ *  Scan the record at position and check the requested columns.
+ *  @return RECORD_COMPLETE if the record is complete. In this case
+ *          position is advanced to the start of the next record.
+ */
+static recordStatusType csvRecord (const const_striType buffer,
+    intType *const position, charType separator,
+    const const_rtlArrayType columns, boolType atEnd,
+    csvRecordType *record)
+
+  {
+    memSizeType numColumns;
+    memSizeType index;
+    memSizeType maxFields;
+    memSizeType recordEnd;
+    recordStatusType status;
+
+  /* csvRecord */
+    numColumns = arraySize(columns);
+    if (numColumns == 0) {
+      maxFields = MAX_MEMSIZETYPE;
+    } else {
+      maxFields = 0;
+      for (index = 0; index < numColumns; index++) {
+        if (unlikely(columns->arr[index].value.intValue < 1)) {
+          logError(printf("csvRecord: Column " FMT_D " is not positive.\n",
+                          columns->arr[index].value.intValue););
+          return RECORD_ILLEGAL;
+        } else if ((uintType) columns->arr[index].value.intValue > maxFields) {
+          maxFields = (memSizeType) columns->arr[index].value.intValue;
+        } /* if */
+      } /* for */
+    } /* if */
+    if (unlikely(*position < 1 ||
+                 (uintType) *position > (uintType) buffer->size + 1)) {
+      logError(printf("csvRecord: Position " FMT_D " not in range 1 to "
+                      FMT_U_MEM ".\n", *position, buffer->size + 1););
+      return RECORD_ILLEGAL;
+    } /* if */
+    status = scanRecord(buffer, (memSizeType) (*position - 1), separator,
+                        atEnd, maxFields, record, &recordEnd);
+    if (status == RECORD_COMPLETE) {
+      *position = (intType) recordEnd + 1;
+    } /* if */
+    return status;
+  } /* csvRecord */
+
+
+
+/**
+ *  Determine the field of the record, which corresponds to a column.
+ *  @return the field, or NULL if the record has no such column.
+ */
+static const csvFieldType *columnField (const csvRecordType *record,
+    const const_rtlArrayType columns, memSizeType index)
+
+  {
+    memSizeType fieldIndex;
+
+  /* columnField */
+    if (arraySize(columns) == 0) {
+      fieldIndex = index;
+    } else {
+      fieldIndex = (memSizeType) columns->arr[index].value.intValue - 1;
+    } /* if */
+    if (fieldIndex < record->numFields) {
+      return &record->fields[fieldIndex];
+    } else {
+      return NULL;
+    } /* if */
+  } /* columnField */
+
+
+
+static inline memSizeType numberOfColumns (const csvRecordType *record,
+    const const_rtlArrayType columns)
+
+  { /* numberOfColumns */
+    if (arraySize(columns) == 0) {
+      return record->numFields;
+    } else {
+      return arraySize(columns);
+    } /* if */
+  } /* numberOfColumns */
+
+
+
+static rtlArrayType emptyRecord (void)
+
+  {
+    rtlArrayType result;
+
+  /* emptyRecord */
+    if (unlikely(!ALLOC_RTL_ARRAY(result, 0))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->min_position = 1;
+      result->max_position = 0;
+    } /* if */
+    return result;
+  } /* emptyRecord */
+
+
+
+static void raiseRecordError (recordStatusType status)
+
+  { /* raiseRecordError */
+    if (status == RECORD_NO_MEMORY) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      raise_error(RANGE_ERROR);
+    } /* if */
+  } /* raiseRecordError */
+
+
+
+/**
+ *  Read the fields of a CSV record from a buffer.
+ *  The record starts at position. It is terminated with '\n', "\r\n"
+ *  or with the end of the buffer. Fields are separated with the
+ *  separator character. A field might be enclosed in double quotes (").
+ *  A double quoted field might contain separator characters, double
+ *  quotes (") and line endings. Double quotes inside a double quoted
+ *  field are represented by doubling them.
+ *  @param buffer String with CSV data.
+ *  @param position Start of the record. If the record is complete,
+ *         position is advanced to the start of the next record.
+ *  @param separator Separator character used in the record.
+ *  @param columns Requested columns (1 for the first field). If
+ *         columns is empty, all fields are returned. Columns not
+ *         present in the record result in an empty string.
+ *  @param atEnd TRUE, if no data follows after the end of the buffer.
+ *         If atEnd is FALSE and the record is not terminated with a
+ *         line ending inside the buffer, the record is not complete.
+ *  @return the requested fields of the record, or an empty array if
+ *          the record is not complete.
+ *  @exception RANGE_ERROR If position is not in the buffer, if a
+ *             column is less than 1 or if the record is not in CSV format.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType csvFields (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd)
+
+  {
+    csvRecordType record;
+    recordStatusType status;
+    memSizeType numColumns;
+    memSizeType index;
+    const csvFieldType *field;
+    striType fieldValue;
+    rtlArrayType result;
+
+  /* csvFields */
+    logFunction(printf("csvFields(\"%s\", " FMT_D ", '\\" FMT_U32 ";', *, %d)\n",
+                       striAsUnquotedCStri(buffer), *position,
+                       separator, atEnd););
+    initRecord(&record);
+    status = csvRecord(buffer, position, separator, columns, atEnd, &record);
+    if (status == RECORD_INCOMPLETE) {
+      result = emptyRecord();
+    } else if (unlikely(status != RECORD_COMPLETE)) {
+      raiseRecordError(status);
+      result = NULL;
+    } else {
+      numColumns = numberOfColumns(&record, columns);
+      if (unlikely(!ALLOC_RTL_ARRAY(result, numColumns))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->min_position = 1;
+        result->max_position = (intType) numColumns;
+        for (index = 0; index < numColumns; index++) {
+          field = columnField(&record, columns, index);
+          if (field != NULL) {
+            fieldValue = fieldToStri(buffer, field);
+          } else if (likely(ALLOC_STRI_SIZE_OK(fieldValue, 0))) {
+            fieldValue->size = 0;
+          } /* if */
+          if (unlikely(fieldValue == NULL)) {
+            while (index != 0) {
+              index--;
+              FREE_STRI(result->arr[index].value.striValue,
+                        result->arr[index].value.striValue->size);
+            } /* while */
+            FREE_RTL_ARRAY(result, numColumns);
+            raise_error(MEMORY_ERROR);
+            result = NULL;
+            break;
+          } /* if */
+          result->arr[index].value.striValue = fieldValue;
+        } /* for */
+      } /* if */
+    } /* if */
+    freeRecord(&record);
+    logFunction(printf("csvFields --> " FMT_D "\n", *position););
+    return result;
+  } /* csvFields */
+
+
+
+/**
+ *  Read the fields of a CSV record from a buffer and convert them
+ *  to integers. The parameters are the same as for csvFields.
+ *  @return the requested fields converted to integers, or an empty
+ *          array if the record is not complete.
+ *  @exception RANGE_ERROR If position is not in the buffer, if a
+ *             column is less than 1, if the record is not in CSV
+ *             format or if a field does not contain an integer literal.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType csvIntegers (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd)
+
+  {
+    csvRecordType record;
+    recordStatusType status;
+    memSizeType numColumns;
+    memSizeType index;
+    const csvFieldType *field;
+    striType fieldValue;
+    rtlArrayType result;
+
+  /* csvIntegers */
+    logFunction(printf("csvIntegers(\"%s\", " FMT_D ", '\\" FMT_U32 ";', *, %d)\n",
+                       striAsUnquotedCStri(buffer), *position,
+                       separator, atEnd););
+    initRecord(&record);
+    status = csvRecord(buffer, position, separator, columns, atEnd, &record);
+    if (status == RECORD_INCOMPLETE) {
+      result = emptyRecord();
+    } else if (unlikely(status != RECORD_COMPLETE)) {
+      raiseRecordError(status);
+      result = NULL;
+    } else {
+      numColumns = numberOfColumns(&record, columns);
+      if (unlikely(!ALLOC_RTL_ARRAY(result, numColumns))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->min_position = 1;
+        result->max_position = (intType) numColumns;
+        for (index = 0; index < numColumns; index++) {
+          field = columnField(&record, columns, index);
+          if (unlikely(field == NULL)) {
+            logError(printf("csvIntegers: Column " FMT_U_MEM " missing.\n",
+                            index + 1););
+            FREE_RTL_ARRAY(result, numColumns);
+            raise_error(RANGE_ERROR);
+            result = NULL;
+            break;
+          } else {
+            fieldValue = fieldToStri(buffer, field);
+            if (unlikely(fieldValue == NULL)) {
+              FREE_RTL_ARRAY(result, numColumns);
+              raise_error(MEMORY_ERROR);
+              result = NULL;
+              break;
+            } else {
+              result->arr[index].value.intValue = intParse(fieldValue);
+              FREE_STRI(fieldValue, fieldValue->size);
+            } /* if */
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* if */
+    freeRecord(&record);
+    logFunction(printf("csvIntegers --> " FMT_D "\n", *position););
+    return result;
+  } /* csvIntegers */
+
+
+
+/**
+ *  Read the fields of a CSV record from a buffer and convert them
+ *  to floats. The parameters are the same as for csvFields.
+ *  @return the requested fields converted to floats, or an empty
+ *          array if the record is not complete.
+ *  @exception RANGE_ERROR If position is not in the buffer, if a
+ *             column is less than 1, if the record is not in CSV
+ *             format or if a field does not contain a float literal.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType csvFloats (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd)
+
+  {
+    csvRecordType record;
+    recordStatusType status;
+    memSizeType numColumns;
+    memSizeType index;
+    const csvFieldType *field;
+    striType fieldValue;
+    rtlArrayType result;
+
+  /* csvFloats */
+    logFunction(printf("csvFloats(\"%s\", " FMT_D ", '\\" FMT_U32 ";', *, %d)\n",
+                       striAsUnquotedCStri(buffer), *position,
+                       separator, atEnd););
+    initRecord(&record);
+    status = csvRecord(buffer, position, separator, columns, atEnd, &record);
+    if (status == RECORD_INCOMPLETE) {
+      result = emptyRecord();
+    } else if (unlikely(status != RECORD_COMPLETE)) {
+      raiseRecordError(status);
+      result = NULL;
+    } else {
+      numColumns = numberOfColumns(&record, columns);
+      if (unlikely(!ALLOC_RTL_ARRAY(result, numColumns))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->min_position = 1;
+        result->max_position = (intType) numColumns;
+        for (index = 0; index < numColumns; index++) {
+          field = columnField(&record, columns, index);
+          if (unlikely(field == NULL)) {
+            logError(printf("csvFloats: Column " FMT_U_MEM " missing.\n",
+                            index + 1););
+            FREE_RTL_ARRAY(result, numColumns);
+            raise_error(RANGE_ERROR);
+            result = NULL;
+            break;
+          } else {
+            fieldValue = fieldToStri(buffer, field);
+            if (unlikely(fieldValue == NULL)) {
+              FREE_RTL_ARRAY(result, numColumns);
+              raise_error(MEMORY_ERROR);
+              result = NULL;
+              break;
+            } else {
+              result->arr[index].value.floatValue = fltParse(fieldValue);
+              FREE_STRI(fieldValue, fieldValue->size);
+            } /* if */
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* if */
+    freeRecord(&record);
+    logFunction(printf("csvFloats --> " FMT_D "\n", *position););
+    return result;
+  } /* csvFloats */
@@ -0,0 +1,37 @@
+/********************************************************************/
+/*                                                                  */
+/*  csv_rtl.h     Primitive actions for CSV records.                */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/csv_rtl.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for CSV records.                     */
+/*                                                                  */
+/********************************************************************/
+
+rtlArrayType csvFields (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd);
+rtlArrayType csvIntegers (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd);
+rtlArrayType csvFloats (const const_striType buffer, intType *const position,
+    charType separator, const const_rtlArrayType columns, boolType atEnd);
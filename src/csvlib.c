@@ -0,0 +1,205 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/csvlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for CSV records.                 */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "arrutl.h"
+#include "str_rtl.h"
+#include "csv_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "csvlib.h"
+
+
+
+/**
+ *  Convert an rtlArrayType with fields of a CSV record to an array object.
+ *  The elements of 'anRtlArray' are reused in the created arrayType
+ *  object. The memory of 'anRtlArray' itself is freed.
+ *  @param category STRIOBJECT, INTOBJECT or FLOATOBJECT.
+ *  @return the new created array object.
+ */
+static objectType toArrayObject (rtlArrayType anRtlArray,
+    objectType elementType, objectCategory category)
+
+  {
+    memSizeType arraySize;
+    memSizeType pos;
+    arrayType anArray;
+    typeType typeOfElement;
+    objectType result;
+
+  /* toArrayObject */
+    if (unlikely(anRtlArray == NULL)) {
+      /* An exception has already been raised. */
+      result = NULL;
+    } else {
+      arraySize = arraySize(anRtlArray);
+      if (unlikely(!ALLOC_ARRAY(anArray, arraySize))) {
+        if (category == STRIOBJECT) {
+          for (pos = 0; pos < arraySize; pos++) {
+            strDestr(anRtlArray->arr[pos].value.striValue);
+          } /* for */
+        } /* if */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        anArray->min_position = anRtlArray->min_position;
+        anArray->max_position = anRtlArray->max_position;
+        typeOfElement = take_type(elementType);
+        for (pos = 0; pos < arraySize; pos++) {
+          anArray->arr[pos].type_of = typeOfElement;
+          anArray->arr[pos].descriptor.property = NULL;
+          switch (category) {
+            case STRIOBJECT:
+              anArray->arr[pos].value.striValue = anRtlArray->arr[pos].value.striValue;
+              break;
+            case INTOBJECT:
+              anArray->arr[pos].value.intValue = anRtlArray->arr[pos].value.intValue;
+              break;
+            default:
+              anArray->arr[pos].value.floatValue = anRtlArray->arr[pos].value.floatValue;
+              break;
+          } /* switch */
+          INIT_CATEGORY_OF_VAR(&anArray->arr[pos], category);
+        } /* for */
+        FREE_RTL_ARRAY(anRtlArray, arraySize);
+        result = bld_array_temp(anArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* toArrayObject */
+
+
+
+/**
+ *  Call csvFields, csvIntegers or csvFloats with the arguments of
+ *  an action. The arguments are buffer/arg_1, position/arg_2,
+ *  separator/arg_3, columns/arg_4 and atEnd/arg_5.
+ */
+static rtlArrayType csvCall (listType arguments,
+    rtlArrayType (*csvFunction) (const const_striType, intType *const,
+        charType, const const_rtlArrayType, boolType))
+
+  {
+    objectType position_variable;
+    rtlArrayType columns;
+    rtlArrayType result;
+
+  /* csvCall */
+    isit_stri(arg_1(arguments));
+    position_variable = arg_2(arguments);
+    isit_int(position_variable);
+    is_variable(position_variable);
+    isit_char(arg_3(arguments));
+    isit_array(arg_4(arguments));
+    isit_bool(arg_5(arguments));
+    columns = gen_rtl_array(take_array(arg_4(arguments)));
+    if (unlikely(columns == NULL)) {
+      raise_exception(SYS_MEM_EXCEPTION);
+      result = NULL;
+    } else {
+      result = csvFunction(take_stri(arg_1(arguments)),
+                           &position_variable->value.intValue,
+                           take_char(arg_3(arguments)),
+                           columns,
+                           take_bool(arg_5(arguments)) == SYS_TRUE_OBJECT);
+      FREE_RTL_ARRAY(columns, ARRAY_LENGTH(columns));
+    } /* if */
+    return result;
+  } /* csvCall */
+
+
+
+/**
+ *  Read the requested fields of a CSV record from buffer/arg_1.
+ *  The record starts at position/arg_2. If the record is complete
+ *  position/arg_2 is advanced to the start of the next record.
+ *  @return the fields from the columns/arg_4 (1 for the first field),
+ *          or all fields if columns/arg_4 is empty. If atEnd/arg_5 is
+ *          FALSE and the record has no line ending in buffer/arg_1
+ *          an empty array is returned.
+ *  @exception RANGE_ERROR If position/arg_2 is not in the buffer, if
+ *             a column is less than 1 or if the record is not in
+ *             CSV format.
+ */
+objectType csv_fields (listType arguments)
+
+  { /* csv_fields */
+    return toArrayObject(csvCall(arguments, csvFields),
+                         SYS_STRI_TYPE, STRIOBJECT);
+  } /* csv_fields */
+
+
+
+/**
+ *  Read the requested fields of a CSV record from buffer/arg_1 and
+ *  convert them to floats. The arguments are the same as for csv_fields.
+ *  @return the requested fields converted to floats, or an empty
+ *          array if the record is not complete.
+ *  @exception RANGE_ERROR If position/arg_2 is not in the buffer, if
+ *             a column is less than 1 or missing, if the record is not
+ *             in CSV format or if a field is not a float literal.
+ */
+objectType csv_floats (listType arguments)
+
+  { /* csv_floats */
+    return toArrayObject(csvCall(arguments, csvFloats),
+                         SYS_FLT_TYPE, FLOATOBJECT);
+  } /* csv_floats */
+
+
+
+/**
+ *  Read the requested fields of a CSV record from buffer/arg_1 and
+ *  convert them to integers. The arguments are the same as for csv_fields.
+ *  @return the requested fields converted to integers, or an empty
+ *          array if the record is not complete.
+ *  @exception RANGE_ERROR If position/arg_2 is not in the buffer, if
+ *             a column is less than 1 or missing, if the record is not
+ *             in CSV format or if a field is not an integer literal.
+ */
+objectType csv_integers (listType arguments)
+
+  { /* csv_integers */
+    return toArrayObject(csvCall(arguments, csvIntegers),
+                         SYS_INT_TYPE, INTOBJECT);
+  } /* csv_integers */
@@ -312,6 +312,7 @@ typedef struct blockStruct {
     locListType local_vars;
     listType local_consts;
     objectType body;
+    uintType call_count;
   } blockRecord;
 
 typedef struct arrayStruct {
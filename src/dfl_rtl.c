@@ -0,0 +1,2170 @@
+/********************************************************************/
+/*                                                                  */
+/*  dfl_rtl.c     Primitive actions for DEFLATE compression.        */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/dfl_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for DEFLATE compression.             */
+/*                                                                  */
+/*  The decoder (RFC 1951) reads the compressed data through a      */
+/*  64-bit bit buffer. Huffman codes are decoded with one lookup    */
+/*  in a primary table. Codes longer than the primary table index   */
+/*  use a second lookup in a subtable. Long matches are copied with */
+/*  memcpy. The state of a decompression is kept in a bstring. This */
+/*  way the data can be decompressed in pieces. Between two calls   */
+/*  the state keeps the last 32 KiB of output as dictionary.        */
+/*  The compressor searches matches with hash chains. The levels    */
+/*  1 to 3 use greedy matching and the levels 4 to 9 lazy matching. */
+/*  Every block is written with the block type (stored, fixed or    */
+/*  dynamic Huffman codes) that needs the fewest bits.              */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "limits.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfl_rtl.h"
+
+
+#define INFLATE_MAGIC      0x696e666c
+#define WINDOW_SIZE        32768
+#define MAX_CODE_BITS      15
+#define MAX_MATCH_LENGTH   258
+#define LIT_PRIMARY_BITS   10
+#define DIST_PRIMARY_BITS  8
+#define CL_PRIMARY_BITS    7
+#define NUM_LIT_SYMBOLS    288
+#define NUM_DIST_SYMBOLS   32
+#define NUM_CL_SYMBOLS     19
+
+/* A primary table and at most one subtable for every symbol. */
+#define LIT_TABLE_SIZE  ((1 << LIT_PRIMARY_BITS) + \
+                         NUM_LIT_SYMBOLS * (1 << (MAX_CODE_BITS - LIT_PRIMARY_BITS)))
+#define DIST_TABLE_SIZE ((1 << DIST_PRIMARY_BITS) + \
+                         NUM_DIST_SYMBOLS * (1 << (MAX_CODE_BITS - DIST_PRIMARY_BITS)))
+
+/* Values of op in a table entry. Values from 0 to 13 describe  */
+/* a length or distance with op extra bits and the base value.  */
+#define OP_SUBTABLE  0x10  /* Low 4 bits: Number of subtable index bits. */
+#define OP_END       0x20
+#define OP_LITERAL   0x40
+#define OP_INVALID   0x80
+
+#define MODE_BLOCK_HEADER 0
+#define MODE_STORED       1
+#define MODE_HUFFMAN      2
+#define MODE_FINISHED     3
+
+#define TABLE_LITERAL_LENGTH 0
+#define TABLE_DISTANCE       1
+#define TABLE_CODE_LENGTH    2
+
+typedef enum {
+    INFLATE_OKAY, INFLATE_NEED_INPUT, INFLATE_OUTPUT_FULL, INFLATE_ERROR
+  } inflateResultType;
+
+typedef struct {
+    uint16Type value;  /* Literal, base value or subtable offset. */
+    uint8Type bits;    /* Number of bits used by this lookup. */
+    uint8Type op;
+  } tableEntryType;
+
+typedef struct {
+    uint32Type magic;
+    int mode;
+    boolType lastBlock;
+    unsigned int bitCount;
+    uint64Type bitBuffer;
+    memSizeType storedRemaining;
+    unsigned int matchRemaining;
+    unsigned int matchDistance;
+    memSizeType windowFill;
+    memSizeType windowPos;
+    ucharType window[WINDOW_SIZE];
+    tableEntryType litTable[LIT_TABLE_SIZE];
+    tableEntryType distTable[DIST_TABLE_SIZE];
+  } inflateStateRecord, *inflateStateType;
+
+typedef const inflateStateRecord *const_inflateStateType;
+
+/**
+ *  Output of an inflate call. The string grows as needed up to limit.
+ */
+typedef struct {
+    striType stri;
+    memSizeType pos;
+    memSizeType capacity;
+    memSizeType limit;
+  } outputRecord, *outputType;
+
+static const uint16Type lengthBase[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+  };
+
+static const uint8Type lengthExtra[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+  };
+
+static const uint16Type distBase[] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+  };
+
+static const uint8Type distExtra[] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+  };
+
+static const uint8Type codeLengthOrder[NUM_CL_SYMBOLS] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+  };
+
+
+
+static tableEntryType symbolEntry (int kind, unsigned int symbol)
+
+  {
+    tableEntryType entry;
+
+  /* symbolEntry */
+    entry.bits = 0;
+    if (kind == TABLE_LITERAL_LENGTH) {
+      if (symbol < 256) {
+        entry.value = (uint16Type) symbol;
+        entry.op = OP_LITERAL;
+      } else if (symbol == 256) {
+        entry.value = 0;
+        entry.op = OP_END;
+      } else if (symbol <= 285) {
+        entry.value = lengthBase[symbol - 257];
+        entry.op = lengthExtra[symbol - 257];
+      } else {
+        entry.value = 0;
+        entry.op = OP_INVALID;
+      } /* if */
+    } else if (kind == TABLE_DISTANCE) {
+      if (symbol < 30) {
+        entry.value = distBase[symbol];
+        entry.op = distExtra[symbol];
+      } else {
+        entry.value = 0;
+        entry.op = OP_INVALID;
+      } /* if */
+    } else {
+      entry.value = (uint16Type) symbol;
+      entry.op = OP_LITERAL;
+    } /* if */
+    return entry;
+  } /* symbolEntry */
+
+
+
+/**
+ *  Build a lookup table for the canonical Huffman code with the given code lengths.
+ *  An index of the primary table consists of the next primaryBits bits
+ *  of the bit buffer. Codes that are longer than primaryBits use a
+ *  subtable. All subtables of a table have the same size.
+ *  @return TRUE if the table could be built, or
+ *          FALSE if the code lengths do not describe a valid code.
+ */
+static boolType buildTable (tableEntryType *table, unsigned int primaryBits,
+    const ucharType *codeLengths, unsigned int numSymbols, int kind)
+
+  {
+    unsigned int count[MAX_CODE_BITS + 1];
+    unsigned int nextCode[MAX_CODE_BITS + 1];
+    unsigned int length;
+    unsigned int maxLength = 0;
+    int left;
+    unsigned int code;
+    unsigned int reversed;
+    unsigned int symbol;
+    unsigned int index;
+    unsigned int subBits;
+    unsigned int subtableEnd;
+    tableEntryType entry;
+    tableEntryType invalid;
+    tableEntryType *subtable;
+
+  /* buildTable */
+    memset(count, 0, sizeof(count));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      count[codeLengths[symbol]]++;
+    } /* for */
+    count[0] = 0;
+    left = 1;
+    for (length = 1; length <= MAX_CODE_BITS; length++) {
+      left <<= 1;
+      left -= (int) count[length];
+      if (left < 0) {
+        /* Over-subscribed code */
+        return FALSE;
+      } /* if */
+      if (count[length] != 0) {
+        maxLength = length;
+      } /* if */
+    } /* for */
+    if (left > 0 && maxLength != 0 &&
+        (kind == TABLE_CODE_LENGTH || maxLength != 1)) {
+      /* Incomplete code. A single code of length 1 is allowed. */
+      return FALSE;
+    } /* if */
+    invalid.value = 0;
+    invalid.bits = 0;
+    invalid.op = OP_INVALID;
+    for (index = 0; index < (1U << primaryBits); index++) {
+      table[index] = invalid;
+    } /* for */
+    subBits = maxLength > primaryBits ? maxLength - primaryBits : 0;
+    subtableEnd = 1U << primaryBits;
+    code = 0;
+    nextCode[0] = 0;
+    for (length = 1; length <= MAX_CODE_BITS; length++) {
+      code = (code + count[length - 1]) << 1;
+      nextCode[length] = code;
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = codeLengths[symbol];
+      if (length != 0) {
+        code = nextCode[length]++;
+        reversed = 0;
+        for (index = 0; index < length; index++) {
+          reversed = (reversed << 1) | ((code >> index) & 1);
+        } /* for */
+        entry = symbolEntry(kind, symbol);
+        if (length <= primaryBits) {
+          entry.bits = (uint8Type) length;
+          for (index = reversed; index < (1U << primaryBits);
+               index += 1U << length) {
+            table[index] = entry;
+          } /* for */
+        } else {
+          index = reversed & ((1U << primaryBits) - 1);
+          if (table[index].op != (OP_SUBTABLE | subBits)) {
+            table[index].value = (uint16Type) subtableEnd;
+            table[index].bits = (uint8Type) primaryBits;
+            table[index].op = (uint8Type) (OP_SUBTABLE | subBits);
+            subtable = &table[subtableEnd];
+            for (code = 0; code < (1U << subBits); code++) {
+              subtable[code] = invalid;
+            } /* for */
+            subtableEnd += 1U << subBits;
+          } else {
+            subtable = &table[table[index].value];
+          } /* if */
+          entry.bits = (uint8Type) (length - primaryBits);
+          for (index = reversed >> primaryBits; index < (1U << subBits);
+               index += 1U << (length - primaryBits)) {
+            subtable[index] = entry;
+          } /* for */
+        } /* if */
+      } /* if */
+    } /* for */
+    return TRUE;
+  } /* buildTable */
+
+
+
+static void buildFixedTables (inflateStateType state)
+
+  {
+    ucharType codeLengths[NUM_LIT_SYMBOLS];
+
+  /* buildFixedTables */
+    memset(&codeLengths[0], 8, 144);
+    memset(&codeLengths[144], 9, 112);
+    memset(&codeLengths[256], 7, 24);
+    memset(&codeLengths[280], 8, 8);
+    buildTable(state->litTable, LIT_PRIMARY_BITS, codeLengths,
+               NUM_LIT_SYMBOLS, TABLE_LITERAL_LENGTH);
+    memset(codeLengths, 5, NUM_DIST_SYMBOLS);
+    buildTable(state->distTable, DIST_PRIMARY_BITS, codeLengths,
+               NUM_DIST_SYMBOLS, TABLE_DISTANCE);
+  } /* buildFixedTables */
+
+
+
+/**
+ *  Make sure that the output string has room for at least minimum
+ *  characters (but not more than allowed by the limit).
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType growOutput (outputType output, memSizeType minimum)
+
+  {
+    memSizeType newCapacity;
+    striType resized;
+
+  /* growOutput */
+    if (minimum > output->limit - output->pos) {
+      minimum = output->limit - output->pos;
+    } /* if */
+    if (output->capacity - output->pos < minimum) {
+      if (output->capacity > output->limit / 2) {
+        newCapacity = output->limit;
+      } else {
+        newCapacity = 2 * output->capacity;
+      } /* if */
+      if (newCapacity - output->pos < minimum) {
+        newCapacity = output->pos + minimum;
+      } /* if */
+      REALLOC_STRI_CHECK_SIZE(resized, output->stri, output->capacity, newCapacity);
+      if (unlikely(resized == NULL)) {
+        return FALSE;
+      } /* if */
+      COUNT3_STRI(output->capacity, newCapacity);
+      output->stri = resized;
+      output->capacity = newCapacity;
+    } /* if */
+    return TRUE;
+  } /* growOutput */
+
+
+
+/**
+ *  Copy a match of length characters from distance characters back.
+ *  The match may start in the window of the previous calls.
+ *  The caller assures that there is enough room in the output.
+ */
+static void copyMatch (const_inflateStateType state, strElemType *out,
+    memSizeType outPos, unsigned int length, unsigned int distance)
+
+  {
+    strElemType *dest;
+    const strElemType *source;
+    memSizeType windowIndex;
+    memSizeType fromWindow;
+    memSizeType count;
+
+  /* copyMatch */
+    dest = &out[outPos];
+    if (unlikely(distance > outPos)) {
+      fromWindow = distance - outPos;
+      windowIndex = (state->windowPos + WINDOW_SIZE - fromWindow) % WINDOW_SIZE;
+      if (fromWindow > length) {
+        fromWindow = length;
+      } /* if */
+      length -= (unsigned int) fromWindow;
+      while (fromWindow != 0) {
+        *dest++ = state->window[windowIndex];
+        windowIndex = (windowIndex + 1) % WINDOW_SIZE;
+        fromWindow--;
+      } /* while */
+      source = out;
+    } else {
+      source = dest - distance;
+    } /* if */
+    if (length <= 8) {
+      while (length != 0) {
+        *dest++ = *source++;
+        length--;
+      } /* while */
+    } else if ((memSizeType) (dest - source) >= length) {
+      memcpy(dest, source, length * sizeof(strElemType));
+    } else if (dest - source == 1) {
+      memset_to_strelem(dest, *source, length);
+    } else {
+      /* Overlapping match: The copied pattern doubles with every step. */
+      while (length != 0) {
+        count = (memSizeType) (dest - source);
+        if (count > length) {
+          count = length;
+        } /* if */
+        memcpy(dest, source, count * sizeof(strElemType));
+        dest += count;
+        length -= (unsigned int) count;
+      } /* while */
+    } /* if */
+  } /* copyMatch */
+
+
+
+/**
+ *  Keep the last 32 KiB of the output in the window of the state.
+ */
+static void updateWindow (inflateStateType state, const strElemType *out,
+    memSizeType outLength)
+
+  {
+    memSizeType count;
+
+  /* updateWindow */
+    if (outLength > WINDOW_SIZE) {
+      out += outLength - WINDOW_SIZE;
+      outLength = WINDOW_SIZE;
+    } /* if */
+    state->windowFill += outLength;
+    if (state->windowFill > WINDOW_SIZE) {
+      state->windowFill = WINDOW_SIZE;
+    } /* if */
+    while (outLength != 0) {
+      count = WINDOW_SIZE - state->windowPos;
+      if (count > outLength) {
+        count = outLength;
+      } /* if */
+      outLength -= count;
+      while (count != 0) {
+        state->window[state->windowPos++] = (ucharType) *out++;
+        count--;
+      } /* while */
+      if (state->windowPos == WINDOW_SIZE) {
+        state->windowPos = 0;
+      } /* if */
+    } /* while */
+  } /* updateWindow */
+
+
+
+/* Fill the bit buffer with at least 57 bits (if there is enough input). */
+#define REFILL_BITS \
+    while (bitCount <= 56 && inPos < inLength) { \
+      ch = in[inPos++]; \
+      charOr |= ch; \
+      bitBuffer |= (uint64Type) (ch & 0xff) << bitCount; \
+      bitCount += 8; \
+    }
+
+#define DROP_BITS(n) bitBuffer >>= (n); bitCount -= (n);
+
+#define BIT_MASK(n) ((1U << (n)) - 1)
+
+
+
+/**
+ *  Decompress DEFLATE data from in[inPos] until the output is full,
+ *  the input is exhausted or the last block has been processed.
+ *  If the input ends within a symbol or block header the state is
+ *  set back to the beginning of the symbol or block header.
+ */
+static inflateResultType inflateData (inflateStateType state,
+    const strElemType *in, memSizeType inLength, memSizeType *inPosition,
+    outputType output)
+
+  {
+    uint64Type bitBuffer;
+    unsigned int bitCount;
+    memSizeType inPos;
+    strElemType ch;
+    strElemType charOr = 0;
+    memSizeType savedInPos;
+    uint64Type savedBitBuffer;
+    unsigned int savedBitCount;
+    tableEntryType entry;
+    unsigned int codeBits;
+    unsigned int length;
+    unsigned int distance;
+    unsigned int available;
+    unsigned int numLitCodes;
+    unsigned int numDistCodes;
+    unsigned int numClCodes;
+    unsigned int index;
+    unsigned int repeat;
+    unsigned int extraBits;
+    ucharType repeatValue;
+    boolType lastBlock;
+    ucharType codeLengths[NUM_LIT_SYMBOLS + NUM_DIST_SYMBOLS];
+    tableEntryType clTable[1 << CL_PRIMARY_BITS];
+    const tableEntryType *litTable;
+    const tableEntryType *distTable;
+    strElemType *out;
+    memSizeType outPos;
+    memSizeType count;
+    inflateResultType result = INFLATE_OKAY;
+
+  /* inflateData */
+    bitBuffer = state->bitBuffer;
+    bitCount = state->bitCount;
+    inPos = *inPosition;
+    litTable = state->litTable;
+    distTable = state->distTable;
+    out = output->stri->mem;
+    outPos = output->pos;
+    if (state->matchRemaining != 0) {
+      length = state->matchRemaining;
+      if (length > output->limit - outPos) {
+        length = (unsigned int) (output->limit - outPos);
+      } /* if */
+      copyMatch(state, out, outPos, length, state->matchDistance);
+      outPos += length;
+      state->matchRemaining -= length;
+      if (state->matchRemaining != 0) {
+        result = INFLATE_OUTPUT_FULL;
+      } /* if */
+    } /* if */
+    while (result == INFLATE_OKAY) {
+      switch (state->mode) {
+        case MODE_BLOCK_HEADER:
+          if (state->lastBlock) {
+            state->mode = MODE_FINISHED;
+            break;
+          } /* if */
+          savedInPos = inPos;
+          savedBitBuffer = bitBuffer;
+          savedBitCount = bitCount;
+          REFILL_BITS;
+          if (bitCount < 3) {
+            result = INFLATE_NEED_INPUT;
+            break;
+          } /* if */
+          switch ((bitBuffer >> 1) & 3) {
+            case 0:
+              /* Non-compressed block */
+              lastBlock = (boolType) (bitBuffer & 1);
+              DROP_BITS(3);
+              DROP_BITS(bitCount & 7);
+              if (bitCount < 32) {
+                result = INFLATE_NEED_INPUT;
+              } else if (((bitBuffer ^ (bitBuffer >> 16)) & 0xffff) != 0xffff) {
+                logError(printf("inflateData: Block length check failed.\n"););
+                result = INFLATE_ERROR;
+              } else {
+                state->storedRemaining = (memSizeType) (bitBuffer & 0xffff);
+                DROP_BITS(32);
+                /* Give back the whole bytes of the bit buffer. */
+                inPos -= bitCount >> 3;
+                bitBuffer = 0;
+                bitCount = 0;
+                state->lastBlock = lastBlock;
+                state->mode = MODE_STORED;
+              } /* if */
+              break;
+            case 1:
+              state->lastBlock = (boolType) (bitBuffer & 1);
+              DROP_BITS(3);
+              buildFixedTables(state);
+              state->mode = MODE_HUFFMAN;
+              break;
+            case 2:
+              lastBlock = (boolType) (bitBuffer & 1);
+              DROP_BITS(3);
+              if (bitCount < 14) {
+                result = INFLATE_NEED_INPUT;
+                break;
+              } /* if */
+              numLitCodes = (unsigned int) (bitBuffer & 0x1f) + 257;
+              numDistCodes = (unsigned int) ((bitBuffer >> 5) & 0x1f) + 1;
+              numClCodes = (unsigned int) ((bitBuffer >> 10) & 0xf) + 4;
+              DROP_BITS(14);
+              if (numLitCodes > 286 || numDistCodes > 30) {
+                logError(printf("inflateData: Too many length or distance symbols.\n"););
+                result = INFLATE_ERROR;
+                break;
+              } /* if */
+              memset(codeLengths, 0, NUM_CL_SYMBOLS);
+              for (index = 0; index < numClCodes; index++) {
+                REFILL_BITS;
+                if (bitCount < 3) {
+                  result = INFLATE_NEED_INPUT;
+                  break;
+                } /* if */
+                codeLengths[codeLengthOrder[index]] = (ucharType) (bitBuffer & 7);
+                DROP_BITS(3);
+              } /* for */
+              if (result != INFLATE_OKAY) {
+                break;
+              } else if (!buildTable(clTable, CL_PRIMARY_BITS, codeLengths,
+                                     NUM_CL_SYMBOLS, TABLE_CODE_LENGTH)) {
+                logError(printf("inflateData: Illegal code length code.\n"););
+                result = INFLATE_ERROR;
+                break;
+              } /* if */
+              index = 0;
+              while (index < numLitCodes + numDistCodes) {
+                REFILL_BITS;
+                entry = clTable[bitBuffer & BIT_MASK(CL_PRIMARY_BITS)];
+                if (entry.op == OP_INVALID) {
+                  result = bitCount < CL_PRIMARY_BITS ?
+                      INFLATE_NEED_INPUT : INFLATE_ERROR;
+                  break;
+                } /* if */
+                if (entry.value < 16) {
+                  extraBits = 0;
+                } else if (entry.value == 16) {
+                  extraBits = 2;
+                } else if (entry.value == 17) {
+                  extraBits = 3;
+                } else {
+                  extraBits = 7;
+                } /* if */
+                if (entry.bits + extraBits > bitCount) {
+                  result = INFLATE_NEED_INPUT;
+                  break;
+                } /* if */
+                DROP_BITS(entry.bits);
+                if (entry.value < 16) {
+                  codeLengths[index++] = (ucharType) entry.value;
+                } else {
+                  if (entry.value == 16) {
+                    if (index == 0) {
+                      logError(printf("inflateData: Repeat without previous length.\n"););
+                      result = INFLATE_ERROR;
+                      break;
+                    } /* if */
+                    repeatValue = codeLengths[index - 1];
+                    repeat = 3 + (unsigned int) (bitBuffer & 3);
+                    DROP_BITS(2);
+                  } else if (entry.value == 17) {
+                    repeatValue = 0;
+                    repeat = 3 + (unsigned int) (bitBuffer & 7);
+                    DROP_BITS(3);
+                  } else {
+                    repeatValue = 0;
+                    repeat = 11 + (unsigned int) (bitBuffer & 0x7f);
+                    DROP_BITS(7);
+                  } /* if */
+                  if (index + repeat > numLitCodes + numDistCodes) {
+                    logError(printf("inflateData: Too many code lengths.\n"););
+                    result = INFLATE_ERROR;
+                    break;
+                  } /* if */
+                  memset(&codeLengths[index], repeatValue, repeat);
+                  index += repeat;
+                } /* if */
+              } /* while */
+              if (result != INFLATE_OKAY) {
+                break;
+              } else if (codeLengths[256] == 0) {
+                logError(printf("inflateData: Missing end-of-block code.\n"););
+                result = INFLATE_ERROR;
+              } else if (!buildTable(state->litTable, LIT_PRIMARY_BITS,
+                                     codeLengths, numLitCodes,
+                                     TABLE_LITERAL_LENGTH) ||
+                         !buildTable(state->distTable, DIST_PRIMARY_BITS,
+                                     &codeLengths[numLitCodes], numDistCodes,
+                                     TABLE_DISTANCE)) {
+                logError(printf("inflateData: Illegal literal/length or "
+                                "distance code.\n"););
+                result = INFLATE_ERROR;
+              } else {
+                state->lastBlock = lastBlock;
+                state->mode = MODE_HUFFMAN;
+              } /* if */
+              break;
+            default:
+              logError(printf("inflateData: Illegal block type.\n"););
+              result = INFLATE_ERROR;
+              break;
+          } /* switch */
+          break;
+        case MODE_STORED:
+          count = state->storedRemaining;
+          if (count > inLength - inPos) {
+            count = inLength - inPos;
+          } /* if */
+          output->pos = outPos;
+          if (!growOutput(output, count)) {
+            raise_error(MEMORY_ERROR);
+            result = INFLATE_ERROR;
+            break;
+          } /* if */
+          out = output->stri->mem;
+          if (count > output->limit - outPos) {
+            count = output->limit - outPos;
+          } /* if */
+          state->storedRemaining -= count;
+          while (count != 0) {
+            ch = in[inPos++];
+            charOr |= ch;
+            out[outPos++] = ch;
+            count--;
+          } /* while */
+          if (state->storedRemaining == 0) {
+            state->mode = MODE_BLOCK_HEADER;
+          } else if (outPos == output->limit) {
+            result = INFLATE_OUTPUT_FULL;
+          } else {
+            result = INFLATE_NEED_INPUT;
+          } /* if */
+          /* The stored data cannot be given back. */
+          savedInPos = inPos;
+          savedBitBuffer = 0;
+          savedBitCount = 0;
+          break;
+        case MODE_HUFFMAN:
+          for (;;) {
+            savedInPos = inPos;
+            savedBitBuffer = bitBuffer;
+            savedBitCount = bitCount;
+            if (unlikely(output->capacity - outPos < MAX_MATCH_LENGTH)) {
+              if (outPos == output->limit) {
+                result = INFLATE_OUTPUT_FULL;
+                break;
+              } /* if */
+              output->pos = outPos;
+              if (unlikely(!growOutput(output, MAX_MATCH_LENGTH))) {
+                raise_error(MEMORY_ERROR);
+                result = INFLATE_ERROR;
+                break;
+              } /* if */
+              out = output->stri->mem;
+            } /* if */
+            REFILL_BITS;
+            entry = litTable[bitBuffer & BIT_MASK(LIT_PRIMARY_BITS)];
+            codeBits = entry.bits;
+            if (entry.op & OP_SUBTABLE) {
+              entry = litTable[entry.value +
+                  ((bitBuffer >> LIT_PRIMARY_BITS) & BIT_MASK(entry.op & 0xf))];
+              codeBits += entry.bits;
+            } /* if */
+            if (unlikely(entry.op == OP_INVALID || codeBits > bitCount)) {
+              if (bitCount < MAX_CODE_BITS) {
+                result = INFLATE_NEED_INPUT;
+              } else {
+                logError(printf("inflateData: Illegal literal/length code.\n"););
+                result = INFLATE_ERROR;
+              } /* if */
+              break;
+            } /* if */
+            DROP_BITS(codeBits);
+            if (entry.op == OP_LITERAL) {
+              out[outPos++] = entry.value;
+            } else if (entry.op == OP_END) {
+              state->mode = MODE_BLOCK_HEADER;
+              break;
+            } else {
+              /* Length with entry.op extra bits */
+              if (unlikely(entry.op > bitCount)) {
+                result = INFLATE_NEED_INPUT;
+                break;
+              } /* if */
+              length = entry.value +
+                  (unsigned int) (bitBuffer & BIT_MASK(entry.op));
+              DROP_BITS(entry.op);
+              entry = distTable[bitBuffer & BIT_MASK(DIST_PRIMARY_BITS)];
+              codeBits = entry.bits;
+              if (entry.op & OP_SUBTABLE) {
+                entry = distTable[entry.value +
+                    ((bitBuffer >> DIST_PRIMARY_BITS) & BIT_MASK(entry.op & 0xf))];
+                codeBits += entry.bits;
+              } /* if */
+              if (unlikely(entry.op == OP_INVALID ||
+                           codeBits + entry.op > bitCount)) {
+                if (bitCount < MAX_CODE_BITS + 13) {
+                  result = INFLATE_NEED_INPUT;
+                } else {
+                  logError(printf("inflateData: Illegal distance code.\n"););
+                  result = INFLATE_ERROR;
+                } /* if */
+                break;
+              } /* if */
+              DROP_BITS(codeBits);
+              distance = entry.value +
+                  (unsigned int) (bitBuffer & BIT_MASK(entry.op));
+              DROP_BITS(entry.op);
+              if (unlikely(distance > outPos + state->windowFill)) {
+                logError(printf("inflateData: Distance too far back.\n"););
+                result = INFLATE_ERROR;
+                break;
+              } /* if */
+              available = (unsigned int) (output->limit - outPos);
+              if (unlikely(length > available)) {
+                copyMatch(state, out, outPos, available, distance);
+                outPos += available;
+                state->matchRemaining = length - available;
+                state->matchDistance = distance;
+                result = INFLATE_OUTPUT_FULL;
+                break;
+              } /* if */
+              copyMatch(state, out, outPos, length, distance);
+              outPos += length;
+            } /* if */
+          } /* for */
+          break;
+        case MODE_FINISHED:
+          /* Discard the bits up to the next byte boundary. */
+          DROP_BITS(bitCount & 7);
+          result = INFLATE_OUTPUT_FULL;
+          break;
+      } /* switch */
+    } /* while */
+    if (result == INFLATE_NEED_INPUT) {
+      inPos = savedInPos;
+      bitBuffer = savedBitBuffer;
+      bitCount = savedBitCount;
+    } else if (state->mode == MODE_FINISHED) {
+      result = INFLATE_OKAY;
+    } /* if */
+    if (unlikely(charOr > 255)) {
+      logError(printf("inflateData: Character beyond '\\255;' in input.\n"););
+      result = INFLATE_ERROR;
+    } /* if */
+    /* Give back the whole bytes of the bit buffer. */
+    inPos -= bitCount >> 3;
+    bitCount &= 7;
+    bitBuffer &= BIT_MASK(bitCount);
+    state->bitBuffer = bitBuffer;
+    state->bitCount = bitCount;
+    *inPosition = inPos;
+    output->pos = outPos;
+    return result;
+  } /* inflateData */
+
+
+
+static boolType isInflateState (const const_bstriType state)
+
+  { /* isInflateState */
+    return state->size == sizeof(inflateStateRecord) &&
+        ((const_inflateStateType) state->mem)->magic == INFLATE_MAGIC;
+  } /* isInflateState */
+
+
+
+/**
+ *  Decompress DEFLATE (RFC 1951) data from compressed[*position].
+ *  The decompression stops if maxLength characters have been
+ *  produced, if the last block has been processed or if the rest of
+ *  the compressed data does not contain a complete symbol. The state
+ *  is used in place. Afterwards *position refers to the first byte
+ *  that has not been processed. Bits of a partially processed byte
+ *  are kept in the state. To continue with more data the unprocessed
+ *  bytes must be passed again.
+ *  @param state Inflate state created with dflInflateInit.
+ *  @param compressed Compressed data (only bytes are allowed).
+ *  @param position Position (starting with 1) in compressed.
+ *  @param maxLength Maximum number of characters to be produced.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid inflate state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in DEFLATE format.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType dflInflate (bstriType state, const const_striType compressed,
+    intType *const position, intType maxLength)
+
+  {
+    inflateStateType inflateState;
+    memSizeType inPos;
+    outputRecord output;
+    inflateResultType inflateResult;
+    striType resized;
+
+  /* dflInflate */
+    logFunction(printf("dflInflate(*, \"%s\", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *position, maxLength););
+    if (unlikely(!isInflateState(state) || maxLength < 0 || *position <= 0)) {
+      logError(printf("dflInflate: Illegal state, maxLength (" FMT_D
+                      ") or position (" FMT_D ").\n", maxLength, *position););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* The memory of a bstring is aligned like memSizeType. */
+    inflateState = (inflateStateType) state->mem;
+    if ((uintType) *position > compressed->size) {
+      inPos = compressed->size;
+    } else {
+      inPos = (memSizeType) *position - 1;
+    } /* if */
+    if ((uintType) maxLength > MAX_STRI_LEN) {
+      output.limit = MAX_STRI_LEN;
+    } else {
+      output.limit = (memSizeType) maxLength;
+    } /* if */
+    /* Compressed data is usually expanded by a factor below 4. */
+    if (compressed->size - inPos > output.limit / 4) {
+      output.capacity = output.limit;
+    } else {
+      output.capacity = 4 * (compressed->size - inPos);
+      if (output.capacity < MAX_MATCH_LENGTH) {
+        output.capacity = output.limit < MAX_MATCH_LENGTH ?
+            output.limit : MAX_MATCH_LENGTH;
+      } /* if */
+    } /* if */
+    output.pos = 0;
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(output.stri, output.capacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    inflateResult = inflateData(inflateState, compressed->mem,
+                                compressed->size, &inPos, &output);
+    if (unlikely(inflateResult == INFLATE_ERROR)) {
+      FREE_STRI(output.stri, output.capacity);
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    updateWindow(inflateState, output.stri->mem, output.pos);
+    *position = (intType) inPos + 1;
+    if (output.pos != output.capacity) {
+      REALLOC_STRI_SIZE_OK(resized, output.stri, output.capacity, output.pos);
+      if (unlikely(resized == NULL)) {
+        FREE_STRI(output.stri, output.capacity);
+        raise_error(MEMORY_ERROR);
+        return NULL;
+      } /* if */
+      COUNT3_STRI(output.capacity, output.pos);
+      output.stri = resized;
+    } /* if */
+    output.stri->size = output.pos;
+    logFunction(printf("dflInflate --> \"%s\" (position=" FMT_D ")\n",
+                       striAsUnquotedCStri(output.stri), *position););
+    return output.stri;
+  } /* dflInflate */
+
+
+
+/**
+ *  Determine if the last block of a DEFLATE stream has been processed.
+ *  @param state Inflate state created with dflInflateInit.
+ *  @return TRUE if all data has been decompressed, FALSE otherwise.
+ *  @exception RANGE_ERROR The state is not a valid inflate state.
+ */
+boolType dflInflateFinished (const const_bstriType state)
+
+  { /* dflInflateFinished */
+    if (unlikely(!isInflateState(state))) {
+      logError(printf("dflInflateFinished: Illegal state.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    return ((const_inflateStateType) state->mem)->mode == MODE_FINISHED;
+  } /* dflInflateFinished */
+
+
+
+/**
+ *  Create a state for the decompression of DEFLATE data.
+ *  @return the initial inflate state.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType dflInflateInit (void)
+
+  {
+    inflateStateType inflateState;
+    bstriType result;
+
+  /* dflInflateInit */
+    logFunction(printf("dflInflateInit\n"););
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, sizeof(inflateStateRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = sizeof(inflateStateRecord);
+      inflateState = (inflateStateType) result->mem;
+      memset(inflateState, 0, sizeof(inflateStateRecord));
+      inflateState->magic = INFLATE_MAGIC;
+      inflateState->mode = MODE_BLOCK_HEADER;
+      inflateState->lastBlock = FALSE;
+    } /* if */
+    return result;
+  } /* dflInflateInit */
+
+
+
+/* The compressor uses the same block format as the decoder above. */
+
+#define DEFLATE_MAGIC      0x64666c74
+#define HASH_BITS          15
+#define HASH_SIZE          (1 << HASH_BITS)
+#define MIN_MATCH_LENGTH   3
+#define MIN_LOOKAHEAD      (MAX_MATCH_LENGTH + MIN_MATCH_LENGTH + 1)
+#define MAX_DISTANCE       (WINDOW_SIZE - MIN_LOOKAHEAD)
+#define TOO_FAR            4096
+#define SYMBOL_BUFFER_SIZE 16384
+#define MAX_STORED_LENGTH  65535
+#define NUM_LENGTH_CODES   29
+#define NUM_DIST_CODES     30
+#define END_OF_BLOCK       256
+#define MAX_CL_BITS        7
+
+#define FLUSH_NONE   0
+#define FLUSH_SYNC   1
+#define FLUSH_FULL   2
+#define FLUSH_FINISH 3
+
+#define HASH3(bytes) ((((uint32Type) (bytes)[0] << 16 | \
+                        (uint32Type) (bytes)[1] << 8 | \
+                        (uint32Type) (bytes)[2]) * 0x9e3779b1U & 0xffffffffU) >> \
+                      (32 - HASH_BITS))
+
+typedef struct {
+    uint32Type magic;
+    int level;
+    boolType finished;
+    unsigned int goodLength;
+    unsigned int maxLazy;
+    unsigned int niceLength;
+    unsigned int maxChain;
+    boolType lazyMatching;
+    unsigned int bitCount;
+    uint64Type bitBuffer;
+    memSizeType strStart;
+    memSizeType lookahead;
+    intType blockStart;      /* Negative if the block started before the window. */
+    unsigned int matchLength;
+    unsigned int matchDistance;
+    boolType matchAvailable;
+    memSizeType symbolCount;
+    unsigned int litFreq[NUM_LIT_SYMBOLS];
+    unsigned int distFreq[NUM_DIST_SYMBOLS];
+    uint16Type head[HASH_SIZE];
+    uint16Type prev[WINDOW_SIZE];
+    uint16Type symbolDist[SYMBOL_BUFFER_SIZE];
+    uint8Type symbolLitLen[SYMBOL_BUFFER_SIZE];
+    /* The hash of the last strings may read up to two bytes beyond. */
+    ucharType window[2 * WINDOW_SIZE + MIN_MATCH_LENGTH];
+  } deflateStateRecord, *deflateStateType;
+
+typedef const deflateStateRecord *const_deflateStateType;
+
+typedef struct {
+    uint8Type lengths[NUM_LIT_SYMBOLS];
+    uint16Type codes[NUM_LIT_SYMBOLS];
+  } huffmanCodeRecord, *huffmanCodeType;
+
+/**
+ *  Parameters of the compression levels 1 to 9 (same as zlib).
+ *  Levels 1 to 3 use greedy matching and levels 4 to 9 lazy matching.
+ *  Level 0 writes stored blocks.
+ */
+static const struct {
+    uint16Type goodLength;
+    uint16Type maxLazy;
+    uint16Type niceLength;
+    uint16Type maxChain;
+    boolType lazyMatching;
+  } levelConfig[] = {
+    { 0,   0,   0,    0, FALSE},
+    { 4,   4,   8,    4, FALSE},
+    { 4,   5,  16,    8, FALSE},
+    { 4,   6,  32,   32, FALSE},
+    { 4,   4,  16,   16, TRUE},
+    { 8,  16,  32,   32, TRUE},
+    { 8,  16, 128,  128, TRUE},
+    { 8,  32, 128,  256, TRUE},
+    {32, 128, 258, 1024, TRUE},
+    {32, 258, 258, 4096, TRUE}
+  };
+
+static boolType codeTablesInitialized = FALSE;
+static uint8Type lengthCodeTable[MAX_MATCH_LENGTH - MIN_MATCH_LENGTH + 1];
+static uint8Type distCodeTable[512];
+
+
+
+static void initCodeTables (void)
+
+  {
+    unsigned int code;
+    unsigned int index;
+
+  /* initCodeTables */
+    for (code = 0; code < NUM_LENGTH_CODES - 1; code++) {
+      for (index = 0; index < 1U << lengthExtra[code]; index++) {
+        lengthCodeTable[lengthBase[code] - MIN_MATCH_LENGTH + index] = (uint8Type) code;
+      } /* for */
+    } /* for */
+    /* The length 258 could also be coded with 284 and 31 extra bits. */
+    lengthCodeTable[MAX_MATCH_LENGTH - MIN_MATCH_LENGTH] = NUM_LENGTH_CODES - 1;
+    for (code = 0; code < 16; code++) {
+      for (index = 0; index < 1U << distExtra[code]; index++) {
+        distCodeTable[distBase[code] - 1 + index] = (uint8Type) code;
+      } /* for */
+    } /* for */
+    for (; code < NUM_DIST_CODES; code++) {
+      for (index = 0; index < 1U << (distExtra[code] - 7); index++) {
+        distCodeTable[256 + ((distBase[code] - 1U) >> 7) + index] = (uint8Type) code;
+      } /* for */
+    } /* for */
+    codeTablesInitialized = TRUE;
+  } /* initCodeTables */
+
+
+
+static inline unsigned int distanceCode (unsigned int distance)
+
+  { /* distanceCode */
+    distance--;
+    if (distance < 256) {
+      return distCodeTable[distance];
+    } else {
+      return distCodeTable[256 + (distance >> 7)];
+    } /* if */
+  } /* distanceCode */
+
+
+
+/**
+ *  Compute the code lengths of a Huffman code with the in-place
+ *  algorithm of Moffat and Katajainen. The weights must be sorted
+ *  in ascending order and there must be at least two of them.
+ *  Afterwards weight[i] contains the code length of the i-th symbol.
+ */
+static void minimumRedundancy (unsigned int *weight, int numWeights)
+
+  {
+    int root;
+    int leaf;
+    int next;
+    unsigned int avail;
+    unsigned int used;
+    unsigned int depth;
+
+  /* minimumRedundancy */
+    /* Combine the weights and store parent pointers. */
+    weight[0] += weight[1];
+    root = 0;
+    leaf = 2;
+    for (next = 1; next < numWeights - 1; next++) {
+      if (leaf >= numWeights || weight[root] < weight[leaf]) {
+        weight[next] = weight[root];
+        weight[root++] = (unsigned int) next;
+      } else {
+        weight[next] = weight[leaf++];
+      } /* if */
+      if (leaf >= numWeights || (root < next && weight[root] < weight[leaf])) {
+        weight[next] += weight[root];
+        weight[root++] = (unsigned int) next;
+      } else {
+        weight[next] += weight[leaf++];
+      } /* if */
+    } /* for */
+    /* Convert the parent pointers to depths of the internal nodes. */
+    weight[numWeights - 2] = 0;
+    for (next = numWeights - 3; next >= 0; next--) {
+      weight[next] = weight[weight[next]] + 1;
+    } /* for */
+    /* Compute the depths of the leaves. */
+    avail = 1;
+    used = 0;
+    depth = 0;
+    root = numWeights - 2;
+    next = numWeights - 1;
+    while (avail > 0) {
+      while (root >= 0 && weight[root] == depth) {
+        used++;
+        root--;
+      } /* while */
+      while (avail > used) {
+        weight[next--] = depth;
+        avail--;
+      } /* while */
+      avail = 2 * used;
+      depth++;
+      used = 0;
+    } /* while */
+  } /* minimumRedundancy */
+
+
+
+/**
+ *  Compute the code lengths of a Huffman code limited to maxBits.
+ *  At least two symbols get a code, such that the code is complete.
+ *  There can be up to 288 symbols and maxBits must not exceed 15.
+ */
+void dflCodeLengths (const unsigned int *freq, unsigned int numSymbols,
+    unsigned int maxBits, uint8Type *lengths)
+
+  {
+    uint32Type sortKey[NUM_LIT_SYMBOLS];
+    unsigned int weight[NUM_LIT_SYMBOLS];
+    unsigned int blCount[MAX_CODE_BITS + 1];
+    unsigned int numUsed = 0;
+    unsigned int symbol;
+    unsigned int index;
+    unsigned int pos;
+    uint32Type key;
+    unsigned int bits;
+    unsigned long total;
+
+  /* dflCodeLengths */
+    memset(lengths, 0, numSymbols * sizeof(uint8Type));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (freq[symbol] != 0) {
+        /* Insertion sort by frequency. Equal frequencies keep the symbol order. */
+        key = (uint32Type) freq[symbol] << 9 | symbol;
+        pos = numUsed;
+        while (pos > 0 && sortKey[pos - 1] > key) {
+          sortKey[pos] = sortKey[pos - 1];
+          pos--;
+        } /* while */
+        sortKey[pos] = key;
+        numUsed++;
+      } /* if */
+    } /* for */
+    if (numUsed <= 1) {
+      symbol = numUsed == 0 ? 0 : sortKey[0] & 0x1ff;
+      lengths[symbol] = 1;
+      lengths[symbol == 0 ? 1 : 0] = 1;
+    } else {
+      for (index = 0; index < numUsed; index++) {
+        weight[index] = sortKey[index] >> 9;
+      } /* for */
+      minimumRedundancy(weight, (int) numUsed);
+      memset(blCount, 0, sizeof(blCount));
+      for (index = 0; index < numUsed; index++) {
+        blCount[weight[index] > maxBits ? maxBits : weight[index]]++;
+      } /* for */
+      /* Shorten codes that are too long until the code is complete again. */
+      total = 0;
+      for (bits = 1; bits <= maxBits; bits++) {
+        total += (unsigned long) blCount[bits] << (maxBits - bits);
+      } /* for */
+      while (total > 1UL << maxBits) {
+        blCount[maxBits]--;
+        for (bits = maxBits - 1; bits > 0; bits--) {
+          if (blCount[bits] != 0) {
+            blCount[bits]--;
+            blCount[bits + 1] += 2;
+            break;
+          } /* if */
+        } /* for */
+        total--;
+      } /* while */
+      /* The least frequent symbols get the longest codes. */
+      index = 0;
+      for (bits = maxBits; bits > 0; bits--) {
+        for (pos = blCount[bits]; pos > 0; pos--) {
+          lengths[sortKey[index] & 0x1ff] = (uint8Type) bits;
+          index++;
+        } /* for */
+      } /* for */
+    } /* if */
+  } /* dflCodeLengths */
+
+
+
+/**
+ *  Assign canonical codes to the code lengths. The codes are bit
+ *  reversed, since DEFLATE writes Huffman codes starting with the
+ *  most significant bit into a stream that is filled from the
+ *  least significant bit.
+ */
+static void buildCodes (huffmanCodeType huffman, unsigned int numSymbols)
+
+  {
+    unsigned int blCount[MAX_CODE_BITS + 1];
+    unsigned int nextCode[MAX_CODE_BITS + 1];
+    unsigned int symbol;
+    unsigned int bits;
+    unsigned int code;
+    unsigned int reversed;
+
+  /* buildCodes */
+    memset(blCount, 0, sizeof(blCount));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      blCount[huffman->lengths[symbol]]++;
+    } /* for */
+    blCount[0] = 0;
+    code = 0;
+    for (bits = 1; bits <= MAX_CODE_BITS; bits++) {
+      code = (code + blCount[bits - 1]) << 1;
+      nextCode[bits] = code;
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      bits = huffman->lengths[symbol];
+      if (bits != 0) {
+        code = nextCode[bits]++;
+        reversed = 0;
+        for (; bits > 0; bits--) {
+          reversed = reversed << 1 | (code & 1);
+          code >>= 1;
+        } /* for */
+        huffman->codes[symbol] = (uint16Type) reversed;
+      } else {
+        huffman->codes[symbol] = 0;
+      } /* if */
+    } /* for */
+  } /* buildCodes */
+
+
+
+static void buildFixedCodes (huffmanCodeType litCode, huffmanCodeType distCode)
+
+  {
+    unsigned int symbol;
+
+  /* buildFixedCodes */
+    for (symbol = 0; symbol < NUM_LIT_SYMBOLS; symbol++) {
+      if (symbol <= 143) {
+        litCode->lengths[symbol] = 8;
+      } else if (symbol <= 255) {
+        litCode->lengths[symbol] = 9;
+      } else if (symbol <= 279) {
+        litCode->lengths[symbol] = 7;
+      } else {
+        litCode->lengths[symbol] = 8;
+      } /* if */
+    } /* for */
+    buildCodes(litCode, NUM_LIT_SYMBOLS);
+    memset(distCode->lengths, 5, NUM_DIST_SYMBOLS);
+    buildCodes(distCode, NUM_DIST_SYMBOLS);
+  } /* buildFixedCodes */
+
+
+
+/**
+ *  Append count bits to the bit buffer of the state. Whole bytes
+ *  are written to the output. The caller assures that there is
+ *  enough room in the output.
+ */
+static inline void putBits (deflateStateType state, outputType output,
+    uint32Type value, unsigned int count)
+
+  {
+    strElemType *out;
+
+  /* putBits */
+    state->bitBuffer |= (uint64Type) value << state->bitCount;
+    state->bitCount += count;
+    if (state->bitCount >= 32) {
+      out = &output->stri->mem[output->pos];
+      out[0] = (strElemType) (state->bitBuffer & 0xff);
+      out[1] = (strElemType) (state->bitBuffer >> 8 & 0xff);
+      out[2] = (strElemType) (state->bitBuffer >> 16 & 0xff);
+      out[3] = (strElemType) (state->bitBuffer >> 24 & 0xff);
+      output->pos += 4;
+      state->bitBuffer >>= 32;
+      state->bitCount -= 32;
+    } /* if */
+  } /* putBits */
+
+
+
+/**
+ *  Write the whole bytes of the bit buffer to the output.
+ *  If alignToByte is TRUE a partial byte is filled with zero bits.
+ */
+static void flushBits (deflateStateType state, outputType output,
+    boolType alignToByte)
+
+  { /* flushBits */
+    if (alignToByte) {
+      state->bitCount = (state->bitCount + 7) & ~7U;
+    } /* if */
+    while (state->bitCount >= 8) {
+      output->stri->mem[output->pos++] = (strElemType) (state->bitBuffer & 0xff);
+      state->bitBuffer >>= 8;
+      state->bitCount -= 8;
+    } /* while */
+  } /* flushBits */
+
+
+
+/**
+ *  Run-length encode the code lengths of the literal/length and the
+ *  distance code with the code length symbols 0 to 18.
+ *  @return the number of code length symbols.
+ */
+static unsigned int encodeCodeLengths (const uint8Type *lengths,
+    unsigned int numLengths, uint8Type *clSymbol, uint8Type *clExtra,
+    unsigned int *clFreq)
+
+  {
+    unsigned int numSymbols = 0;
+    unsigned int pos = 0;
+    unsigned int length;
+    unsigned int run;
+    unsigned int count;
+
+  /* encodeCodeLengths */
+    while (pos < numLengths) {
+      length = lengths[pos];
+      run = 1;
+      while (pos + run < numLengths && lengths[pos + run] == length) {
+        run++;
+      } /* while */
+      pos += run;
+      if (length == 0) {
+        while (run >= 11) {
+          count = run > 138 ? 138 : run;
+          clSymbol[numSymbols] = 18;
+          clExtra[numSymbols++] = (uint8Type) (count - 11);
+          run -= count;
+        } /* while */
+        if (run >= 3) {
+          clSymbol[numSymbols] = 17;
+          clExtra[numSymbols++] = (uint8Type) (run - 3);
+          run = 0;
+        } /* if */
+      } else {
+        clSymbol[numSymbols] = (uint8Type) length;
+        clExtra[numSymbols++] = 0;
+        run--;
+        while (run >= 3) {
+          count = run > 6 ? 6 : run;
+          clSymbol[numSymbols] = 16;
+          clExtra[numSymbols++] = (uint8Type) (count - 3);
+          run -= count;
+        } /* while */
+      } /* if */
+      for (; run > 0; run--) {
+        clSymbol[numSymbols] = (uint8Type) length;
+        clExtra[numSymbols++] = 0;
+      } /* for */
+    } /* while */
+    for (pos = 0; pos < numSymbols; pos++) {
+      clFreq[clSymbol[pos]]++;
+    } /* for */
+    return numSymbols;
+  } /* encodeCodeLengths */
+
+
+
+/**
+ *  Compute the number of bits needed to encode the symbols of the
+ *  current block (including the end-of-block code) with the given codes.
+ */
+static unsigned long blockDataBits (const_deflateStateType state,
+    const uint8Type *litLengths, const uint8Type *distLengths)
+
+  {
+    unsigned int symbol;
+    unsigned long bits = 0;
+
+  /* blockDataBits */
+    for (symbol = 0; symbol <= END_OF_BLOCK; symbol++) {
+      bits += (unsigned long) state->litFreq[symbol] * litLengths[symbol];
+    } /* for */
+    for (symbol = 0; symbol < NUM_LENGTH_CODES; symbol++) {
+      bits += (unsigned long) state->litFreq[END_OF_BLOCK + 1 + symbol] *
+          (litLengths[END_OF_BLOCK + 1 + symbol] + lengthExtra[symbol]);
+    } /* for */
+    for (symbol = 0; symbol < NUM_DIST_CODES; symbol++) {
+      bits += (unsigned long) state->distFreq[symbol] *
+          (distLengths[symbol] + distExtra[symbol]);
+    } /* for */
+    return bits;
+  } /* blockDataBits */
+
+
+
+static void sendSymbols (deflateStateType state, outputType output,
+    const huffmanCodeRecord *litCode, const huffmanCodeRecord *distCode)
+
+  {
+    memSizeType index;
+    unsigned int distance;
+    unsigned int litLen;
+    unsigned int code;
+
+  /* sendSymbols */
+    for (index = 0; index < state->symbolCount; index++) {
+      distance = state->symbolDist[index];
+      litLen = state->symbolLitLen[index];
+      if (distance == 0) {
+        putBits(state, output, litCode->codes[litLen], litCode->lengths[litLen]);
+      } else {
+        code = lengthCodeTable[litLen];
+        putBits(state, output, litCode->codes[END_OF_BLOCK + 1 + code],
+                litCode->lengths[END_OF_BLOCK + 1 + code]);
+        if (lengthExtra[code] != 0) {
+          putBits(state, output, litLen + MIN_MATCH_LENGTH - lengthBase[code],
+                  lengthExtra[code]);
+        } /* if */
+        code = distanceCode(distance);
+        putBits(state, output, distCode->codes[code], distCode->lengths[code]);
+        if (distExtra[code] != 0) {
+          putBits(state, output, distance - distBase[code], distExtra[code]);
+        } /* if */
+      } /* if */
+    } /* for */
+    putBits(state, output, litCode->codes[END_OF_BLOCK], litCode->lengths[END_OF_BLOCK]);
+  } /* sendSymbols */
+
+
+
+/**
+ *  Write the data from blockStart to strStart as stored blocks.
+ */
+static void sendStoredBlocks (deflateStateType state, outputType output,
+    boolType lastBlock)
+
+  {
+    memSizeType blockPos;
+    memSizeType length;
+    memSizeType remaining;
+    strElemType *out;
+    const ucharType *in;
+    memSizeType index;
+
+  /* sendStoredBlocks */
+    blockPos = (memSizeType) state->blockStart;
+    remaining = state->strStart - blockPos;
+    do {
+      length = remaining > MAX_STORED_LENGTH ? MAX_STORED_LENGTH : remaining;
+      remaining -= length;
+      putBits(state, output, lastBlock && remaining == 0, 3);
+      flushBits(state, output, TRUE);
+      out = &output->stri->mem[output->pos];
+      out[0] = (strElemType) (length & 0xff);
+      out[1] = (strElemType) (length >> 8);
+      out[2] = (strElemType) (~length & 0xff);
+      out[3] = (strElemType) (~length >> 8 & 0xff);
+      out += 4;
+      in = &state->window[blockPos];
+      for (index = 0; index < length; index++) {
+        out[index] = in[index];
+      } /* for */
+      output->pos += 4 + length;
+      blockPos += length;
+    } while (remaining != 0);
+  } /* sendStoredBlocks */
+
+
+
+/**
+ *  Write the symbols collected since blockStart as one block. The
+ *  block type (stored, fixed or dynamic Huffman codes) that needs
+ *  the fewest bits is used.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType flushBlock (deflateStateType state, outputType output,
+    boolType lastBlock)
+
+  {
+    huffmanCodeRecord litCode;
+    huffmanCodeRecord distCode;
+    huffmanCodeRecord clCode;
+    uint8Type allLengths[NUM_LIT_SYMBOLS + NUM_DIST_SYMBOLS];
+    uint8Type clSymbol[NUM_LIT_SYMBOLS + NUM_DIST_SYMBOLS];
+    uint8Type clExtra[NUM_LIT_SYMBOLS + NUM_DIST_SYMBOLS];
+    unsigned int clFreq[NUM_CL_SYMBOLS];
+    unsigned int numLit;
+    unsigned int numDist;
+    unsigned int numCl;
+    unsigned int numClSymbols;
+    unsigned int index;
+    unsigned long dynamicBits;
+    unsigned long fixedBits;
+    unsigned long storedBits;
+    memSizeType storedLength = 0;
+
+  /* flushBlock */
+    state->litFreq[END_OF_BLOCK] = 1;
+    if (state->blockStart >= 0) {
+      storedLength = state->strStart - (memSizeType) state->blockStart;
+      storedBits = (storedLength / MAX_STORED_LENGTH + 1) * (3 + 7 + 32) +
+          8 * (unsigned long) storedLength;
+    } else {
+      storedBits = ULONG_MAX;
+    } /* if */
+    if (state->level == 0) {
+      dynamicBits = ULONG_MAX;
+      fixedBits = ULONG_MAX;
+      numCl = 0;
+      numClSymbols = 0;
+    } else {
+      dflCodeLengths(state->litFreq, NUM_LIT_SYMBOLS - 2, MAX_CODE_BITS, litCode.lengths);
+      litCode.lengths[NUM_LIT_SYMBOLS - 2] = 0;
+      litCode.lengths[NUM_LIT_SYMBOLS - 1] = 0;
+      dflCodeLengths(state->distFreq, NUM_DIST_CODES, MAX_CODE_BITS, distCode.lengths);
+      distCode.lengths[NUM_DIST_SYMBOLS - 2] = 0;
+      distCode.lengths[NUM_DIST_SYMBOLS - 1] = 0;
+      numLit = NUM_LIT_SYMBOLS - 2;
+      while (numLit > END_OF_BLOCK + 1 && litCode.lengths[numLit - 1] == 0) {
+        numLit--;
+      } /* while */
+      numDist = NUM_DIST_CODES;
+      while (numDist > 1 && distCode.lengths[numDist - 1] == 0) {
+        numDist--;
+      } /* while */
+      memcpy(allLengths, litCode.lengths, numLit);
+      memcpy(&allLengths[numLit], distCode.lengths, numDist);
+      memset(clFreq, 0, sizeof(clFreq));
+      numClSymbols = encodeCodeLengths(allLengths, numLit + numDist,
+                                       clSymbol, clExtra, clFreq);
+      dflCodeLengths(clFreq, NUM_CL_SYMBOLS, MAX_CL_BITS, clCode.lengths);
+      numCl = NUM_CL_SYMBOLS;
+      while (numCl > 4 && clCode.lengths[codeLengthOrder[numCl - 1]] == 0) {
+        numCl--;
+      } /* while */
+      dynamicBits = 3 + 5 + 5 + 4 + 3 * numCl + 2 * clFreq[16] +
+          3 * clFreq[17] + 7 * clFreq[18];
+      for (index = 0; index < NUM_CL_SYMBOLS; index++) {
+        dynamicBits += clFreq[index] * clCode.lengths[index];
+      } /* for */
+      dynamicBits += blockDataBits(state, litCode.lengths, distCode.lengths);
+      buildFixedCodes(&litCode, &distCode);
+      fixedBits = 3 + blockDataBits(state, litCode.lengths, distCode.lengths);
+      if (dynamicBits < fixedBits) {
+        /* Restore the dynamic code lengths. */
+        memcpy(litCode.lengths, allLengths, numLit);
+        memset(&litCode.lengths[numLit], 0, NUM_LIT_SYMBOLS - numLit);
+        memcpy(distCode.lengths, &allLengths[numLit], numDist);
+        memset(&distCode.lengths[numDist], 0, NUM_DIST_SYMBOLS - numDist);
+      } /* if */
+    } /* if */
+    if (storedBits <= fixedBits && storedBits <= dynamicBits) {
+      if (unlikely(!growOutput(output, storedLength + 8 *
+          (storedLength / MAX_STORED_LENGTH + 2)))) {
+        return FALSE;
+      } /* if */
+      sendStoredBlocks(state, output, lastBlock);
+    } else if (fixedBits <= dynamicBits) {
+      if (unlikely(!growOutput(output, fixedBits / 8 + 16))) {
+        return FALSE;
+      } /* if */
+      putBits(state, output, (lastBlock ? 1 : 0) | 1 << 1, 3);
+      sendSymbols(state, output, &litCode, &distCode);
+    } else {
+      if (unlikely(!growOutput(output, dynamicBits / 8 + 16))) {
+        return FALSE;
+      } /* if */
+      buildCodes(&litCode, NUM_LIT_SYMBOLS);
+      buildCodes(&distCode, NUM_DIST_SYMBOLS);
+      buildCodes(&clCode, NUM_CL_SYMBOLS);
+      putBits(state, output, (lastBlock ? 1 : 0) | 2 << 1, 3);
+      putBits(state, output, numLit - 257, 5);
+      putBits(state, output, numDist - 1, 5);
+      putBits(state, output, numCl - 4, 4);
+      for (index = 0; index < numCl; index++) {
+        putBits(state, output, clCode.lengths[codeLengthOrder[index]], 3);
+      } /* for */
+      for (index = 0; index < numClSymbols; index++) {
+        putBits(state, output, clCode.codes[clSymbol[index]],
+                clCode.lengths[clSymbol[index]]);
+        if (clSymbol[index] >= 16) {
+          putBits(state, output, clExtra[index],
+                  clSymbol[index] == 16 ? 2 : (clSymbol[index] == 17 ? 3 : 7));
+        } /* if */
+      } /* for */
+      sendSymbols(state, output, &litCode, &distCode);
+    } /* if */
+    memset(state->litFreq, 0, sizeof(state->litFreq));
+    memset(state->distFreq, 0, sizeof(state->distFreq));
+    state->symbolCount = 0;
+    state->blockStart = (intType) state->strStart;
+    return TRUE;
+  } /* flushBlock */
+
+
+
+static inline boolType tallyLiteral (deflateStateType state, ucharType literal)
+
+  { /* tallyLiteral */
+    state->symbolLitLen[state->symbolCount] = literal;
+    state->symbolDist[state->symbolCount] = 0;
+    state->litFreq[literal]++;
+    state->symbolCount++;
+    return state->symbolCount == SYMBOL_BUFFER_SIZE;
+  } /* tallyLiteral */
+
+
+
+static inline boolType tallyMatch (deflateStateType state, unsigned int length,
+    unsigned int distance)
+
+  { /* tallyMatch */
+    length -= MIN_MATCH_LENGTH;
+    state->symbolLitLen[state->symbolCount] = (uint8Type) length;
+    state->symbolDist[state->symbolCount] = (uint16Type) distance;
+    state->litFreq[END_OF_BLOCK + 1 + lengthCodeTable[length]]++;
+    state->distFreq[distanceCode(distance)]++;
+    state->symbolCount++;
+    return state->symbolCount == SYMBOL_BUFFER_SIZE;
+  } /* tallyMatch */
+
+
+
+/**
+ *  Insert the string at pos into the hash chains.
+ *  @return the previous head of the hash chain (0 if the chain is empty).
+ */
+static inline unsigned int insertString (deflateStateType state, memSizeType pos)
+
+  {
+    unsigned int hash;
+    unsigned int previous;
+
+  /* insertString */
+    hash = HASH3(&state->window[pos]);
+    previous = state->head[hash];
+    state->prev[pos & (WINDOW_SIZE - 1)] = (uint16Type) previous;
+    state->head[hash] = (uint16Type) pos;
+    return previous;
+  } /* insertString */
+
+
+
+/**
+ *  Search the hash chain starting at curMatch for the longest match
+ *  of the string at strStart. Only matches longer than bestLength are
+ *  considered. The chain is followed at most maxChain times (a quarter
+ *  of it, if bestLength is already good).
+ *  @return the length of the longest match found (at most lookahead).
+ */
+static unsigned int longestMatch (deflateStateType state, unsigned int curMatch,
+    unsigned int bestLength, unsigned int *matchDistance)
+
+  {
+    const ucharType *scan;
+    const ucharType *match;
+    unsigned int chainLength;
+    unsigned int maxLength;
+    unsigned int niceLength;
+    unsigned int length;
+    memSizeType limit;
+
+  /* longestMatch */
+    maxLength = state->lookahead < MAX_MATCH_LENGTH ?
+        (unsigned int) state->lookahead : MAX_MATCH_LENGTH;
+    if (bestLength >= maxLength) {
+      return maxLength;
+    } /* if */
+    chainLength = state->maxChain;
+    if (bestLength >= state->goodLength) {
+      chainLength >>= 2;
+    } /* if */
+    niceLength = state->niceLength < maxLength ? state->niceLength : maxLength;
+    limit = state->strStart > MAX_DISTANCE ? state->strStart - MAX_DISTANCE : 0;
+    scan = &state->window[state->strStart];
+    while (curMatch > limit && chainLength != 0) {
+      match = &state->window[curMatch];
+      if (match[bestLength] == scan[bestLength] &&
+          match[0] == scan[0] && match[1] == scan[1]) {
+        length = 2;
+        while (length < maxLength && match[length] == scan[length]) {
+          length++;
+        } /* while */
+        if (length > bestLength) {
+          *matchDistance = (unsigned int) (state->strStart - curMatch);
+          bestLength = length;
+          if (length >= niceLength) {
+            break;
+          } /* if */
+        } /* if */
+      } /* if */
+      curMatch = state->prev[curMatch & (WINDOW_SIZE - 1)];
+      chainLength--;
+    } /* while */
+    return bestLength;
+  } /* longestMatch */
+
+
+
+/**
+ *  Move the upper half of the window to the lower half and adjust
+ *  the positions of the hash chains. Positions that leave the window
+ *  become 0 (end of chain).
+ */
+static void slideWindow (deflateStateType state)
+
+  {
+    unsigned int index;
+
+  /* slideWindow */
+    memcpy(state->window, &state->window[WINDOW_SIZE], WINDOW_SIZE);
+    state->strStart -= WINDOW_SIZE;
+    state->blockStart -= WINDOW_SIZE;
+    for (index = 0; index < HASH_SIZE; index++) {
+      state->head[index] = (uint16Type) (state->head[index] >= WINDOW_SIZE ?
+          state->head[index] - WINDOW_SIZE : 0);
+    } /* for */
+    for (index = 0; index < WINDOW_SIZE; index++) {
+      state->prev[index] = (uint16Type) (state->prev[index] >= WINDOW_SIZE ?
+          state->prev[index] - WINDOW_SIZE : 0);
+    } /* for */
+  } /* slideWindow */
+
+
+
+/**
+ *  Copy input to the window until the lookahead is MIN_LOOKAHEAD or
+ *  the input is exhausted.
+ *  @return FALSE if the input contains a character beyond '\255;'.
+ */
+static boolType fillWindow (deflateStateType state, const strElemType *in,
+    memSizeType inSize, memSizeType *inPos)
+
+  {
+    memSizeType more;
+    memSizeType count;
+    ucharType *dest;
+    const strElemType *source;
+    strElemType charOr = 0;
+    memSizeType index;
+
+  /* fillWindow */
+    while (state->lookahead < MIN_LOOKAHEAD && *inPos < inSize) {
+      if (state->strStart >= WINDOW_SIZE + MAX_DISTANCE) {
+        slideWindow(state);
+      } /* if */
+      more = 2 * WINDOW_SIZE - state->strStart - state->lookahead;
+      count = inSize - *inPos;
+      if (count > more) {
+        count = more;
+      } /* if */
+      dest = &state->window[state->strStart + state->lookahead];
+      source = &in[*inPos];
+      for (index = 0; index < count; index++) {
+        charOr |= source[index];
+        dest[index] = (ucharType) source[index];
+      } /* for */
+      *inPos += count;
+      state->lookahead += count;
+    } /* while */
+    return charOr <= 255;
+  } /* fillWindow */
+
+
+
+/**
+ *  Compress with greedy matching (levels 1 to 3). Every match is
+ *  taken immediately. Strings inside of long matches are not
+ *  inserted into the hash chains.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType deflateGreedy (deflateStateType state, outputType output,
+    memSizeType minLookahead)
+
+  {
+    unsigned int hashHead;
+    unsigned int matchLength;
+    unsigned int matchDistance = 0;
+    boolType blockFull;
+
+  /* deflateGreedy */
+    while (state->lookahead >= minLookahead) {
+      hashHead = 0;
+      if (state->lookahead >= MIN_MATCH_LENGTH) {
+        hashHead = insertString(state, state->strStart);
+      } /* if */
+      matchLength = 0;
+      if (hashHead != 0) {
+        matchLength = longestMatch(state, hashHead, MIN_MATCH_LENGTH - 1,
+                                   &matchDistance);
+        if (matchLength == MIN_MATCH_LENGTH && matchDistance > TOO_FAR) {
+          matchLength = 0;
+        } /* if */
+      } /* if */
+      if (matchLength >= MIN_MATCH_LENGTH) {
+        blockFull = tallyMatch(state, matchLength, matchDistance);
+        state->lookahead -= matchLength;
+        if (matchLength <= state->maxLazy &&
+            state->lookahead >= MIN_MATCH_LENGTH) {
+          do {
+            state->strStart++;
+            insertString(state, state->strStart);
+          } while (--matchLength != 1);
+          state->strStart++;
+        } else {
+          state->strStart += matchLength;
+        } /* if */
+      } else {
+        blockFull = tallyLiteral(state, state->window[state->strStart]);
+        state->lookahead--;
+        state->strStart++;
+      } /* if */
+      if (blockFull && unlikely(!flushBlock(state, output, FALSE))) {
+        return FALSE;
+      } /* if */
+    } /* while */
+    return TRUE;
+  } /* deflateGreedy */
+
+
+
+/**
+ *  Compress with lazy matching (levels 4 to 9). A match is only
+ *  taken, if the string at the next position has no longer match.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType deflateLazy (deflateStateType state, outputType output,
+    memSizeType minLookahead)
+
+  {
+    unsigned int hashHead;
+    unsigned int prevLength;
+    unsigned int prevDistance;
+    memSizeType maxInsert;
+    boolType blockFull;
+
+  /* deflateLazy */
+    while (state->lookahead >= minLookahead) {
+      hashHead = 0;
+      if (state->lookahead >= MIN_MATCH_LENGTH) {
+        hashHead = insertString(state, state->strStart);
+      } /* if */
+      prevLength = state->matchLength;
+      prevDistance = state->matchDistance;
+      state->matchLength = MIN_MATCH_LENGTH - 1;
+      if (hashHead != 0 && prevLength < state->maxLazy) {
+        state->matchLength = longestMatch(state, hashHead, prevLength,
+                                          &state->matchDistance);
+        if (state->matchLength == MIN_MATCH_LENGTH &&
+            state->matchDistance > TOO_FAR) {
+          state->matchLength = MIN_MATCH_LENGTH - 1;
+        } /* if */
+      } /* if */
+      if (prevLength >= MIN_MATCH_LENGTH && state->matchLength <= prevLength) {
+        /* The match at the previous position is better. */
+        maxInsert = state->strStart + state->lookahead - MIN_MATCH_LENGTH;
+        blockFull = tallyMatch(state, prevLength, prevDistance);
+        state->lookahead -= prevLength - 1;
+        prevLength -= 2;
+        do {
+          state->strStart++;
+          if (state->strStart <= maxInsert) {
+            insertString(state, state->strStart);
+          } /* if */
+        } while (--prevLength != 0);
+        state->matchAvailable = FALSE;
+        state->matchLength = MIN_MATCH_LENGTH - 1;
+        state->strStart++;
+        if (blockFull && unlikely(!flushBlock(state, output, FALSE))) {
+          return FALSE;
+        } /* if */
+      } else if (state->matchAvailable) {
+        /* No better match: The previous character is a literal. */
+        if (tallyLiteral(state, state->window[state->strStart - 1]) &&
+            unlikely(!flushBlock(state, output, FALSE))) {
+          return FALSE;
+        } /* if */
+        state->strStart++;
+        state->lookahead--;
+      } else {
+        /* Wait for the next step to decide. */
+        state->matchAvailable = TRUE;
+        state->strStart++;
+        state->lookahead--;
+      } /* if */
+    } /* while */
+    return TRUE;
+  } /* deflateLazy */
+
+
+
+/**
+ *  Collect input for stored blocks (level 0). A block does not
+ *  exceed MAX_DISTANCE bytes, such that it stays in the window.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType deflateStored (deflateStateType state, outputType output,
+    memSizeType minLookahead)
+
+  {
+    memSizeType count;
+
+  /* deflateStored */
+    while (state->lookahead >= minLookahead) {
+      count = MAX_DISTANCE - (state->strStart - (memSizeType) state->blockStart);
+      if (count > state->lookahead) {
+        count = state->lookahead;
+      } /* if */
+      state->strStart += count;
+      state->lookahead -= count;
+      if (state->strStart - (memSizeType) state->blockStart == MAX_DISTANCE &&
+          unlikely(!flushBlock(state, output, FALSE))) {
+        return FALSE;
+      } /* if */
+    } /* while */
+    return TRUE;
+  } /* deflateStored */
+
+
+
+static boolType compressWindow (deflateStateType state, outputType output,
+    memSizeType minLookahead)
+
+  { /* compressWindow */
+    if (state->level == 0) {
+      return deflateStored(state, output, minLookahead);
+    } else if (state->lazyMatching) {
+      return deflateLazy(state, output, minLookahead);
+    } else {
+      return deflateGreedy(state, output, minLookahead);
+    } /* if */
+  } /* compressWindow */
+
+
+
+static boolType isDeflateState (const const_bstriType state)
+
+  { /* isDeflateState */
+    return state->size == sizeof(deflateStateRecord) &&
+        ((const_deflateStateType) state->mem)->magic == DEFLATE_MAGIC;
+  } /* isDeflateState */
+
+
+
+/**
+ *  Compress data with DEFLATE (RFC 1951). Usually the compressor
+ *  collects data until a block is full. The flushMode allows to
+ *  write all pending data:
+ *  - 0: No flush. Only complete blocks are written.
+ *  - 1: Sync flush. The pending data is written and the output is
+ *       aligned to a byte boundary with an empty stored block.
+ *  - 2: Full flush. Like a sync flush, but later data does not
+ *       refer to data before the flush.
+ *  - 3: Finish. The last block is written. Afterwards the state
+ *       cannot be used any more.
+ *  @param state Deflate state created with dflDeflateInit.
+ *  @param uncompressed Data to be compressed (only bytes are allowed).
+ *  @param flushMode Flush mode from 0 to 3 (see above).
+ *  @return the compressed data produced by this call.
+ *  @exception RANGE_ERROR The state is not a valid deflate state,
+ *             the compression is already finished, the flushMode
+ *             is not in the allowed range or uncompressed contains
+ *             a character beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType dflDeflate (bstriType state, const const_striType uncompressed,
+    intType flushMode)
+
+  {
+    deflateStateType deflateState;
+    memSizeType inPos = 0;
+    outputRecord output;
+    boolType okay = TRUE;
+    striType resized;
+
+  /* dflDeflate */
+    logFunction(printf("dflDeflate(*, \"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(uncompressed), flushMode););
+    if (unlikely(!isDeflateState(state) ||
+                 ((deflateStateType) state->mem)->finished ||
+                 flushMode < FLUSH_NONE || flushMode > FLUSH_FINISH)) {
+      logError(printf("dflDeflate: Illegal state or flushMode (" FMT_D ").\n",
+                      flushMode););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* The memory of a bstring is aligned like memSizeType. */
+    deflateState = (deflateStateType) state->mem;
+    output.limit = MAX_STRI_LEN;
+    output.capacity = uncompressed->size / 4 + 64;
+    output.pos = 0;
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(output.stri, output.capacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    do {
+      if (unlikely(!fillWindow(deflateState, uncompressed->mem,
+                               uncompressed->size, &inPos))) {
+        FREE_STRI(output.stri, output.capacity);
+        logError(printf("dflDeflate: Character beyond '\\255;'.\n"););
+        raise_error(RANGE_ERROR);
+        return NULL;
+      } /* if */
+      okay = compressWindow(deflateState, &output, MIN_LOOKAHEAD);
+    } while (okay && inPos < uncompressed->size);
+    if (okay && flushMode != FLUSH_NONE) {
+      okay = compressWindow(deflateState, &output, 1);
+      if (okay && deflateState->matchAvailable) {
+        tallyLiteral(deflateState, deflateState->window[deflateState->strStart - 1]);
+        deflateState->matchAvailable = FALSE;
+      } /* if */
+      if (okay && (flushMode == FLUSH_FINISH ||
+                   deflateState->strStart != (memSizeType) deflateState->blockStart)) {
+        okay = flushBlock(deflateState, &output, flushMode == FLUSH_FINISH);
+      } /* if */
+      if (okay && flushMode == FLUSH_FINISH) {
+        deflateState->finished = TRUE;
+      } else if (okay && growOutput(&output, 16)) {
+        /* Empty stored block as marker for the byte boundary. */
+        putBits(deflateState, &output, 0, 3);
+        flushBits(deflateState, &output, TRUE);
+        putBits(deflateState, &output, 0xffff0000, 32);
+        if (flushMode == FLUSH_FULL) {
+          memset(deflateState->head, 0, sizeof(deflateState->head));
+        } /* if */
+      } else {
+        okay = FALSE;
+      } /* if */
+    } /* if */
+    if (okay && growOutput(&output, 16)) {
+      flushBits(deflateState, &output, deflateState->finished);
+    } else {
+      FREE_STRI(output.stri, output.capacity);
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    if (output.pos != output.capacity) {
+      REALLOC_STRI_SIZE_OK(resized, output.stri, output.capacity, output.pos);
+      if (unlikely(resized == NULL)) {
+        FREE_STRI(output.stri, output.capacity);
+        raise_error(MEMORY_ERROR);
+        return NULL;
+      } /* if */
+      COUNT3_STRI(output.capacity, output.pos);
+      output.stri = resized;
+    } /* if */
+    output.stri->size = output.pos;
+    logFunction(printf("dflDeflate --> \"%s\"\n",
+                       striAsUnquotedCStri(output.stri)););
+    return output.stri;
+  } /* dflDeflate */
+
+
+
+/**
+ *  Create a state for the compression of data with DEFLATE.
+ *  Level 1 is the fastest and level 9 gives the best compression.
+ *  Level 0 does not compress and writes stored blocks.
+ *  @param level Compression level from 0 to 9.
+ *  @return the initial deflate state.
+ *  @exception RANGE_ERROR The level is not in the range 0 to 9.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType dflDeflateInit (intType level)
+
+  {
+    deflateStateType deflateState;
+    bstriType result;
+
+  /* dflDeflateInit */
+    logFunction(printf("dflDeflateInit(" FMT_D ")\n", level););
+    if (unlikely(level < 0 || level > 9)) {
+      logError(printf("dflDeflateInit: Illegal level (" FMT_D ").\n", level););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, sizeof(deflateStateRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (!codeTablesInitialized) {
+        initCodeTables();
+      } /* if */
+      result->size = sizeof(deflateStateRecord);
+      deflateState = (deflateStateType) result->mem;
+      memset(deflateState, 0, sizeof(deflateStateRecord));
+      deflateState->magic = DEFLATE_MAGIC;
+      deflateState->level = (int) level;
+      deflateState->finished = FALSE;
+      deflateState->goodLength = levelConfig[level].goodLength;
+      deflateState->maxLazy = levelConfig[level].maxLazy;
+      deflateState->niceLength = levelConfig[level].niceLength;
+      deflateState->maxChain = levelConfig[level].maxChain;
+      deflateState->lazyMatching = levelConfig[level].lazyMatching;
+      deflateState->matchLength = MIN_MATCH_LENGTH - 1;
+      deflateState->matchAvailable = FALSE;
+    } /* if */
+    return result;
+  } /* dflDeflateInit */
@@ -0,0 +1,154 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/dfllib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for DEFLATE compression.         */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "dfl_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfllib.h"
+
+
+
+/**
+ *  Compress uncompressed/arg_2 with DEFLATE.
+ *  Depending on flushMode/arg_3 pending data is written (1: sync
+ *  flush, 2: full flush, 3: finish). The deflate state/arg_1 is
+ *  updated.
+ *  @return the compressed data produced by this call.
+ *  @exception RANGE_ERROR The state is not a valid deflate state,
+ *             the compression is already finished, the flushMode
+ *             is not in the allowed range or uncompressed contains
+ *             a character beyond '\255;'.
+ */
+objectType dfl_deflate (listType arguments)
+
+  {
+    objectType state_variable;
+
+  /* dfl_deflate */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_stri_temp(
+        dflDeflate(take_bstri(state_variable),
+                   take_stri(arg_2(arguments)),
+                   take_int(arg_3(arguments))));
+  } /* dfl_deflate */
+
+
+
+/**
+ *  Create a state for the compression of data with DEFLATE.
+ *  @return the initial deflate state for the level/arg_1.
+ *  @exception RANGE_ERROR The level is not in the range 0 to 9.
+ */
+objectType dfl_deflate_init (listType arguments)
+
+  { /* dfl_deflate_init */
+    isit_int(arg_1(arguments));
+    return bld_bstri_temp(dflDeflateInit(take_int(arg_1(arguments))));
+  } /* dfl_deflate_init */
+
+
+
+/**
+ *  Decompress DEFLATE data from compressed/arg_2 starting at position/arg_3.
+ *  The decompression stops if maxLength/arg_4 characters have been
+ *  produced, if the last block has been processed or if the rest of
+ *  the compressed data does not contain a complete symbol. The
+ *  inflate state/arg_1 and position/arg_3 are updated.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid inflate state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in DEFLATE format.
+ */
+objectType dfl_inflate (listType arguments)
+
+  {
+    objectType state_variable;
+    objectType position_variable;
+
+  /* dfl_inflate */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    position_variable = arg_3(arguments);
+    isit_int(position_variable);
+    is_variable(position_variable);
+    isit_int(arg_4(arguments));
+    return bld_stri_temp(
+        dflInflate(take_bstri(state_variable),
+                   take_stri(arg_2(arguments)),
+                   &position_variable->value.intValue,
+                   take_int(arg_4(arguments))));
+  } /* dfl_inflate */
+
+
+
+/**
+ *  Determine if the last block of a DEFLATE stream has been processed.
+ *  @return TRUE if all data has been decompressed, FALSE otherwise.
+ *  @exception RANGE_ERROR The state/arg_1 is not a valid inflate state.
+ */
+objectType dfl_inflate_finished (listType arguments)
+
+  { /* dfl_inflate_finished */
+    isit_bstri(arg_1(arguments));
+    if (dflInflateFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* dfl_inflate_finished */
+
+
+
+/**
+ *  Create a state for the decompression of DEFLATE data.
+ *  @return the initial inflate state.
+ */
+objectType dfl_inflate_init (listType arguments)
+
+  { /* dfl_inflate_init */
+    return bld_bstri_temp(dflInflateInit());
+  } /* dfl_inflate_init */
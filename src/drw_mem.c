@@ -0,0 +1,1214 @@
+/********************************************************************/
+/*                                                                  */
+/*  drw_mem.c     Graphic access to pixmaps in main memory.         */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/drw_mem.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Graphic access to pixmaps in main memory.              */
+/*                                                                  */
+/*  A memory pixmap stores its pixels as 32-bit values in a buffer  */
+/*  of the process. No display is needed to create, draw, copy or   */
+/*  read memory pixmaps. A graphic driver uses memory pixmaps,      */
+/*  when no display is available. The pixels use the format         */
+/*  0xRRGGBB. Fills and copies work on whole pixel lines with       */
+/*  memcpy() and with simple loops, which can be vectorized by the  */
+/*  C compiler. Lines and outlines use integer algorithms, arcs     */
+/*  are approximated by polygons.                                   */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "limits.h"
+#include "math.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "drw_mem.h"
+
+
+#define PI 3.141592653589793238462643383279502884197
+#define MAX_ARC_POINTS 65536
+
+#define to_pixels(win)     (((const_mem_winType) (win))->pixels)
+#define to_width(win)      (((const_mem_winType) (win))->width)
+#define to_height(win)     (((const_mem_winType) (win))->height)
+
+#define to_var_pixels(win)     (((mem_winType) (win))->pixels)
+
+
+
+static mem_winType newMemPixmap (memSizeType width, memSizeType height)
+
+  {
+    mem_winType pixmap;
+
+  /* newMemPixmap */
+    if (unlikely(!ALLOC_RECORD2(pixmap, mem_winRecord, count.win, count.win_bytes))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(pixmap, 0, sizeof(mem_winRecord));
+      if (unlikely(height > MAX_MEMSIZETYPE / sizeof(int32Type) / width ||
+                   (pixmap->pixels = (int32Type *) malloc(height * width *
+                                                          sizeof(int32Type))) == NULL)) {
+        FREE_RECORD2(pixmap, mem_winRecord, count.win, count.win_bytes);
+        raise_error(MEMORY_ERROR);
+        pixmap = NULL;
+      } else {
+        pixmap->usage_count = 1;
+        pixmap->width = (unsigned int) width;
+        pixmap->height = (unsigned int) height;
+        pixmap->clear_col = 0;
+        pixmap->hasTransparentPixel = FALSE;
+        pixmap->transparentPixel = 0;
+      } /* if */
+    } /* if */
+    return pixmap;
+  } /* newMemPixmap */
+
+
+
+/**
+ *  Fill the pixels from x1 to x2 (inclusive) of line y with col.
+ *  Pixels outside of the pixmap are ignored.
+ */
+static void fillSpan (const_winType actual_pixmap, intType y,
+    intType x1, intType x2, int32Type col)
+
+  {
+    int32Type *pixel;
+    memSizeType count;
+
+  /* fillSpan */
+    if (y >= 0 && y < (intType) to_height(actual_pixmap)) {
+      if (x1 < 0) {
+        x1 = 0;
+      } /* if */
+      if (x2 >= (intType) to_width(actual_pixmap)) {
+        x2 = (intType) to_width(actual_pixmap) - 1;
+      } /* if */
+      if (x1 <= x2) {
+        pixel = &to_pixels(actual_pixmap)[
+            (memSizeType) y * to_width(actual_pixmap) + (memSizeType) x1];
+        for (count = (memSizeType) (x2 - x1 + 1); count != 0; count--) {
+          *pixel = col;
+          pixel++;
+        } /* for */
+      } /* if */
+    } /* if */
+  } /* fillSpan */
+
+
+
+static inline void setPixel (const_winType actual_pixmap,
+    intType x, intType y, int32Type col)
+
+  { /* setPixel */
+    if (x >= 0 && x < (intType) to_width(actual_pixmap) &&
+        y >= 0 && y < (intType) to_height(actual_pixmap)) {
+      to_pixels(actual_pixmap)[
+          (memSizeType) y * to_width(actual_pixmap) + (memSizeType) x] = col;
+    } /* if */
+  } /* setPixel */
+
+
+
+/**
+ *  Draw a line with the Bresenham algorithm. Both end points are drawn.
+ */
+static void drawLine (const_winType actual_pixmap,
+    intType x1, intType y1, intType x2, intType y2, int32Type col)
+
+  {
+    intType deltaX;
+    intType deltaY;
+    intType stepX;
+    intType stepY;
+    intType error;
+    intType doubleError;
+
+  /* drawLine */
+    if (y1 == y2) {
+      if (x1 <= x2) {
+        fillSpan(actual_pixmap, y1, x1, x2, col);
+      } else {
+        fillSpan(actual_pixmap, y1, x2, x1, col);
+      } /* if */
+    } else if ((x1 >= 0 || x2 >= 0) && (y1 >= 0 || y2 >= 0) &&
+               (x1 < (intType) to_width(actual_pixmap) ||
+                x2 < (intType) to_width(actual_pixmap)) &&
+               (y1 < (intType) to_height(actual_pixmap) ||
+                y2 < (intType) to_height(actual_pixmap))) {
+      deltaX = x2 >= x1 ? x2 - x1 : x1 - x2;
+      deltaY = y2 >= y1 ? y1 - y2 : y2 - y1;
+      stepX = x1 < x2 ? 1 : -1;
+      stepY = y1 < y2 ? 1 : -1;
+      error = deltaX + deltaY;
+      setPixel(actual_pixmap, x1, y1, col);
+      while (x1 != x2 || y1 != y2) {
+        doubleError = 2 * error;
+        if (doubleError >= deltaY) {
+          error += deltaY;
+          x1 += stepX;
+        } /* if */
+        if (doubleError <= deltaX) {
+          error += deltaX;
+          y1 += stepY;
+        } /* if */
+        setPixel(actual_pixmap, x1, y1, col);
+      } /* while */
+    } /* if */
+  } /* drawLine */
+
+
+
+/**
+ *  Determine the pixels of line y, which are inside of an ellipse.
+ *  The ellipse has the center (centerX, centerY) and the radii
+ *  radiusX and radiusY. The pixel coordinates are the centers of
+ *  the pixels.
+ *  @return TRUE if line y contains pixels of the ellipse,
+ *          FALSE otherwise.
+ */
+static boolType ellipseSpan (double centerX, double centerY,
+    double radiusX, double radiusY, intType y, intType *left, intType *right)
+
+  {
+    double deltaY;
+    double factor;
+    double halfWidth;
+    boolType inside;
+
+  /* ellipseSpan */
+    deltaY = (double) y - centerY;
+    if (radiusY == 0.0) {
+      factor = deltaY == 0.0 ? 1.0 : -1.0;
+    } else {
+      factor = 1.0 - (deltaY / radiusY) * (deltaY / radiusY);
+    } /* if */
+    if (factor < -1.0E-9) {
+      inside = FALSE;
+    } else {
+      halfWidth = factor <= 0.0 ? 0.0 : radiusX * sqrt(factor);
+      *left = (intType) ceil(centerX - halfWidth - 1.0E-9);
+      *right = (intType) floor(centerX + halfWidth + 1.0E-9);
+      inside = *left <= *right;
+    } /* if */
+    return inside;
+  } /* ellipseSpan */
+
+
+
+/**
+ *  Fill the ellipse with the bounding box (x, y, width, height).
+ *  The pixels from x to x + width and from y to y + height are
+ *  covered like with an outline and a fill of X11.
+ */
+static void fillEllipse (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, int32Type col)
+
+  {
+    double radiusX;
+    double radiusY;
+    intType line;
+    intType lastLine;
+    intType left;
+    intType right;
+
+  /* fillEllipse */
+    radiusX = (double) width / 2.0;
+    radiusY = (double) height / 2.0;
+    line = y < 0 ? 0 : y;
+    lastLine = y + height;
+    if (lastLine >= (intType) to_height(actual_pixmap)) {
+      lastLine = (intType) to_height(actual_pixmap) - 1;
+    } /* if */
+    for (; line <= lastLine; line++) {
+      if (ellipseSpan((double) x + radiusX, (double) y + radiusY,
+                      radiusX, radiusY, line, &left, &right)) {
+        fillSpan(actual_pixmap, line, left, right, col);
+      } /* if */
+    } /* for */
+  } /* fillEllipse */
+
+
+
+/**
+ *  Draw the outline of the ellipse with the bounding box (x, y, width, height).
+ *  A pixel of the ellipse is part of the outline, if one of its four
+ *  neighbours is not part of the ellipse.
+ */
+static void drawEllipse (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, int32Type col)
+
+  {
+    double centerX;
+    double centerY;
+    double radiusX;
+    double radiusY;
+    intType line;
+    intType lastLine;
+    intType left;
+    intType right;
+    intType aboveLeft;
+    intType aboveRight;
+    intType belowLeft;
+    intType belowRight;
+    intType innerLeft;
+    intType innerRight;
+
+  /* drawEllipse */
+    radiusX = (double) width / 2.0;
+    radiusY = (double) height / 2.0;
+    centerX = (double) x + radiusX;
+    centerY = (double) y + radiusY;
+    line = y < 0 ? 0 : y;
+    lastLine = y + height;
+    if (lastLine >= (intType) to_height(actual_pixmap)) {
+      lastLine = (intType) to_height(actual_pixmap) - 1;
+    } /* if */
+    for (; line <= lastLine; line++) {
+      if (ellipseSpan(centerX, centerY, radiusX, radiusY, line, &left, &right)) {
+        if (ellipseSpan(centerX, centerY, radiusX, radiusY, line - 1,
+                        &aboveLeft, &aboveRight) &&
+            ellipseSpan(centerX, centerY, radiusX, radiusY, line + 1,
+                        &belowLeft, &belowRight)) {
+          innerLeft = aboveLeft > belowLeft ? aboveLeft : belowLeft;
+          innerRight = aboveRight < belowRight ? aboveRight : belowRight;
+          if (innerLeft <= left) {
+            innerLeft = left + 1;
+          } /* if */
+          if (innerRight >= right) {
+            innerRight = right - 1;
+          } /* if */
+          if (innerLeft > innerRight) {
+            fillSpan(actual_pixmap, line, left, right, col);
+          } else {
+            fillSpan(actual_pixmap, line, left, innerLeft - 1, col);
+            fillSpan(actual_pixmap, line, innerRight + 1, right, col);
+          } /* if */
+        } else {
+          fillSpan(actual_pixmap, line, left, right, col);
+        } /* if */
+      } /* if */
+    } /* for */
+  } /* drawEllipse */
+
+
+
+/**
+ *  Fill a polygon with the even-odd rule.
+ *  A pixel is filled, if its center is inside of the polygon.
+ *  The center of the pixel (x, y) is at (x + 0.5, y + 0.5).
+ */
+static void fillPolygon (const_winType actual_pixmap, const double *xCoords,
+    const double *yCoords, memSizeType numPoints, int32Type col)
+
+  {
+    double minY;
+    double maxY;
+    double lineCenter;
+    double *crossings;
+    double crossing;
+    memSizeType numCrossings;
+    memSizeType pos;
+    memSizeType next;
+    memSizeType insertPos;
+    intType line;
+    intType lastLine;
+
+  /* fillPolygon */
+    if (numPoints >= 3) {
+      if (unlikely((crossings = (double *) malloc(numPoints * sizeof(double))) == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        minY = yCoords[0];
+        maxY = yCoords[0];
+        for (pos = 1; pos < numPoints; pos++) {
+          if (yCoords[pos] < minY) {
+            minY = yCoords[pos];
+          } else if (yCoords[pos] > maxY) {
+            maxY = yCoords[pos];
+          } /* if */
+        } /* for */
+        line = minY < 0.0 ? 0 : (intType) floor(minY);
+        lastLine = maxY >= (double) to_height(actual_pixmap) ?
+            (intType) to_height(actual_pixmap) - 1 : (intType) ceil(maxY);
+        for (; line <= lastLine; line++) {
+          lineCenter = (double) line + 0.5;
+          numCrossings = 0;
+          for (pos = 0; pos < numPoints; pos++) {
+            next = pos + 1 == numPoints ? 0 : pos + 1;
+            if ((yCoords[pos] <= lineCenter) != (yCoords[next] <= lineCenter)) {
+              crossing = xCoords[pos] + (lineCenter - yCoords[pos]) *
+                  (xCoords[next] - xCoords[pos]) / (yCoords[next] - yCoords[pos]);
+              insertPos = numCrossings;
+              while (insertPos > 0 && crossings[insertPos - 1] > crossing) {
+                crossings[insertPos] = crossings[insertPos - 1];
+                insertPos--;
+              } /* while */
+              crossings[insertPos] = crossing;
+              numCrossings++;
+            } /* if */
+          } /* for */
+          for (pos = 0; pos + 1 < numCrossings; pos += 2) {
+            fillSpan(actual_pixmap, line, (intType) ceil(crossings[pos] - 0.5),
+                     (intType) ceil(crossings[pos + 1] - 0.5) - 1, col);
+          } /* for */
+        } /* for */
+        free(crossings);
+      } /* if */
+    } /* if */
+  } /* fillPolygon */
+
+
+
+/**
+ *  Compute the points of a circular arc.
+ *  The angles are measured counterclockwise from the 3 o'clock
+ *  position. With pixelCenter the coordinates are shifted by 0.5,
+ *  so they can be used for fillPolygon().
+ *  @return the number of points.
+ */
+static memSizeType arcPoints (intType x, intType y, double radius,
+    floatType startAngle, floatType sweepAngle, boolType pixelCenter,
+    double *xCoords, double *yCoords)
+
+  {
+    double offset;
+    double angle;
+    memSizeType numPoints;
+    memSizeType pos;
+
+  /* arcPoints */
+    offset = pixelCenter ? 0.5 : 0.0;
+    numPoints = (memSizeType) (fabs(sweepAngle) * radius / 2.0) + 8;
+    if (numPoints > MAX_ARC_POINTS) {
+      numPoints = MAX_ARC_POINTS;
+    } /* if */
+    for (pos = 0; pos < numPoints; pos++) {
+      angle = startAngle + sweepAngle * (double) pos / (double) (numPoints - 1);
+      xCoords[pos] = (double) x + radius * cos(angle) + offset;
+      yCoords[pos] = (double) y - radius * sin(angle) + offset;
+    } /* for */
+    return numPoints;
+  } /* arcPoints */
+
+
+
+static boolType allocArcPoints (double **xCoords, double **yCoords,
+    memSizeType numPoints)
+
+  {
+    boolType okay;
+
+  /* allocArcPoints */
+    *xCoords = (double *) malloc(numPoints * sizeof(double));
+    *yCoords = (double *) malloc(numPoints * sizeof(double));
+    okay = *xCoords != NULL && *yCoords != NULL;
+    if (unlikely(!okay)) {
+      free(*xCoords);
+      free(*yCoords);
+      raise_error(MEMORY_ERROR);
+    } /* if */
+    return okay;
+  } /* allocArcPoints */
+
+
+
+static void drawPolyline (const_winType actual_pixmap, const double *xCoords,
+    const double *yCoords, memSizeType numPoints, int32Type col)
+
+  {
+    memSizeType pos;
+
+  /* drawPolyline */
+    for (pos = 1; pos < numPoints; pos++) {
+      drawLine(actual_pixmap,
+               (intType) floor(xCoords[pos - 1] + 0.5), (intType) floor(yCoords[pos - 1] + 0.5),
+               (intType) floor(xCoords[pos] + 0.5), (intType) floor(yCoords[pos] + 0.5), col);
+    } /* for */
+  } /* drawPolyline */
+
+
+
+/**
+ *  Copy a rectangular area from 'src_pixmap' to 'dest_pixmap'.
+ *  The parts of the area, which are outside of one of the pixmaps,
+ *  are not copied. Source and destination may overlap. With
+ *  useTransparency the transparent pixels of 'src_pixmap' are skipped.
+ */
+static void copyArea (const_winType src_pixmap, const_winType dest_pixmap,
+    intType src_x, intType src_y, intType width, intType height,
+    intType dest_x, intType dest_y, boolType useTransparency)
+
+  {
+    const int32Type *srcPixel;
+    int32Type *destPixel;
+    int32Type transparentPixel;
+    memSizeType srcWidth;
+    memSizeType destWidth;
+    memSizeType column;
+    intType line;
+
+  /* copyArea */
+    if (src_x < 0) {
+      width += src_x;
+      dest_x -= src_x;
+      src_x = 0;
+    } /* if */
+    if (src_y < 0) {
+      height += src_y;
+      dest_y -= src_y;
+      src_y = 0;
+    } /* if */
+    if (dest_x < 0) {
+      width += dest_x;
+      src_x -= dest_x;
+      dest_x = 0;
+    } /* if */
+    if (dest_y < 0) {
+      height += dest_y;
+      src_y -= dest_y;
+      dest_y = 0;
+    } /* if */
+    if (src_x + width > (intType) to_width(src_pixmap)) {
+      width = (intType) to_width(src_pixmap) - src_x;
+    } /* if */
+    if (src_y + height > (intType) to_height(src_pixmap)) {
+      height = (intType) to_height(src_pixmap) - src_y;
+    } /* if */
+    if (dest_x + width > (intType) to_width(dest_pixmap)) {
+      width = (intType) to_width(dest_pixmap) - dest_x;
+    } /* if */
+    if (dest_y + height > (intType) to_height(dest_pixmap)) {
+      height = (intType) to_height(dest_pixmap) - dest_y;
+    } /* if */
+    if (width > 0 && height > 0) {
+      srcWidth = to_width(src_pixmap);
+      destWidth = to_width(dest_pixmap);
+      if (useTransparency && ((const_mem_winType) src_pixmap)->hasTransparentPixel) {
+        transparentPixel = ((const_mem_winType) src_pixmap)->transparentPixel;
+        for (line = 0; line < height; line++) {
+          srcPixel = &to_pixels(src_pixmap)[
+              (memSizeType) (src_y + line) * srcWidth + (memSizeType) src_x];
+          destPixel = &to_pixels(dest_pixmap)[
+              (memSizeType) (dest_y + line) * destWidth + (memSizeType) dest_x];
+          for (column = 0; column < (memSizeType) width; column++) {
+            if (srcPixel[column] != transparentPixel) {
+              destPixel[column] = srcPixel[column];
+            } /* if */
+          } /* for */
+        } /* for */
+      } else if (src_pixmap == dest_pixmap && dest_y > src_y) {
+        /* Overlapping areas: Copy from the bottom line upward. */
+        for (line = height - 1; line >= 0; line--) {
+          memmove(&to_pixels(dest_pixmap)[
+                      (memSizeType) (dest_y + line) * destWidth + (memSizeType) dest_x],
+                  &to_pixels(src_pixmap)[
+                      (memSizeType) (src_y + line) * srcWidth + (memSizeType) src_x],
+                  (memSizeType) width * sizeof(int32Type));
+        } /* for */
+      } else {
+        for (line = 0; line < height; line++) {
+          memmove(&to_pixels(dest_pixmap)[
+                      (memSizeType) (dest_y + line) * destWidth + (memSizeType) dest_x],
+                  &to_pixels(src_pixmap)[
+                      (memSizeType) (src_y + line) * srcWidth + (memSizeType) src_x],
+                  (memSizeType) width * sizeof(int32Type));
+        } /* for */
+      } /* if */
+    } /* if */
+  } /* copyArea */
+
+
+
+/**
+ *  Create a new memory pixmap with the given 'width' and 'height'.
+ *  The pixels of the new pixmap are black.
+ *  @exception RANGE_ERROR If 'height' or 'width' are less than 1.
+ *  @exception MEMORY_ERROR Not enough memory to create the pixmap.
+ */
+winType memNewPixmap (intType width, intType height)
+
+  {
+    mem_winType pixmap;
+
+  /* memNewPixmap */
+    logFunction(printf("memNewPixmap(" FMT_D ", " FMT_D ")\n", width, height););
+    if (unlikely(!inIntRange(width) || !inIntRange(height) ||
+                 width < 1 || height < 1)) {
+      raise_error(RANGE_ERROR);
+      pixmap = NULL;
+    } else {
+      pixmap = newMemPixmap((memSizeType) width, (memSizeType) height);
+      if (pixmap != NULL) {
+        memset(pixmap->pixels, 0,
+               (memSizeType) width * (memSizeType) height * sizeof(int32Type));
+      } /* if */
+    } /* if */
+    logFunction(printf("memNewPixmap --> " FMT_U_MEM " (usage=" FMT_U ")\n",
+                       (memSizeType) pixmap,
+                       pixmap != NULL ? pixmap->usage_count : (uintType) 0););
+    return (winType) pixmap;
+  } /* memNewPixmap */
+
+
+
+/**
+ *  Create an empty memory pixmap with a width and height of zero.
+ *  The empty pixmap does not use reference counting (it is not freed).
+ */
+winType memEmpty (void)
+
+  {
+    mem_winType emptyPixmap;
+
+  /* memEmpty */
+    logFunction(printf("memEmpty()\n"););
+    if (unlikely(!ALLOC_RECORD2(emptyPixmap, mem_winRecord, count.win, count.win_bytes))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(emptyPixmap, 0, sizeof(mem_winRecord));
+      emptyPixmap->usage_count = 0;
+      emptyPixmap->pixels = NULL;
+      emptyPixmap->width = 0;
+      emptyPixmap->height = 0;
+    } /* if */
+    logFunction(printf("memEmpty --> " FMT_U_MEM "\n", (memSizeType) emptyPixmap););
+    return (winType) emptyPixmap;
+  } /* memEmpty */
+
+
+
+/**
+ *  Create a new memory pixmap from the pixels in 'image_data'.
+ *  The pixels are stored line by line without padding.
+ *  @exception RANGE_ERROR If 'height' or 'width' are not in the
+ *             allowed range.
+ */
+winType memImage (const int32Type *image_data, memSizeType width,
+    memSizeType height, boolType hasAlphaChannel)
+
+  {
+    mem_winType pixmap;
+
+  /* memImage */
+    logFunction(printf("memImage(" FMT_U_MEM ", " FMT_U_MEM ", %d)\n",
+                       width, height, hasAlphaChannel););
+    if (unlikely(width < 1 || width > INT_MAX ||
+                 height < 1 || height > INT_MAX)) {
+      raise_error(RANGE_ERROR);
+      pixmap = NULL;
+    } else {
+      pixmap = newMemPixmap(width, height);
+      if (pixmap != NULL) {
+        memcpy(pixmap->pixels, image_data, width * height * sizeof(int32Type));
+      } /* if */
+    } /* if */
+    logFunction(printf("memImage --> " FMT_U_MEM " (usage=" FMT_U ")\n",
+                       (memSizeType) pixmap,
+                       pixmap != NULL ? pixmap->usage_count : (uintType) 0););
+    return (winType) pixmap;
+  } /* memImage */
+
+
+
+/**
+ *  Create a new memory pixmap from a rectangular area of 'sourceWin'.
+ *  The rectangle may extend to areas outside of 'sourceWin'. The
+ *  rectangle areas outside of 'sourceWin' are colored with black.
+ *  @exception RANGE_ERROR If 'height' or 'width' are less than 1.
+ */
+winType memGetPixmap (const_winType sourceWin, intType left, intType upper,
+    intType width, intType height)
+
+  {
+    winType pixmap;
+
+  /* memGetPixmap */
+    logFunction(printf("memGetPixmap(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ")\n",
+                       (memSizeType) sourceWin, left, upper, width, height););
+    if (unlikely(!inIntRange(left) || !inIntRange(upper))) {
+      raise_error(RANGE_ERROR);
+      pixmap = NULL;
+    } else {
+      pixmap = memNewPixmap(width, height);
+      if (pixmap != NULL) {
+        copyArea(sourceWin, pixmap, left, upper, width, height, 0, 0, FALSE);
+      } /* if */
+    } /* if */
+    return pixmap;
+  } /* memGetPixmap */
+
+
+
+void memFree (winType old_pixmap)
+
+  { /* memFree */
+    logFunction(printf("memFree(" FMT_U_MEM ") (usage=" FMT_U ")\n",
+                       (memSizeType) old_pixmap,
+                       old_pixmap != NULL ? old_pixmap->usage_count : (uintType) 0););
+    free(to_var_pixels(old_pixmap));
+    FREE_RECORD2(old_pixmap, mem_winRecord, count.win, count.win_bytes);
+  } /* memFree */
+
+
+
+intType memWidth (const_winType actual_pixmap)
+
+  { /* memWidth */
+    return (intType) to_width(actual_pixmap);
+  } /* memWidth */
+
+
+
+intType memHeight (const_winType actual_pixmap)
+
+  { /* memHeight */
+    return (intType) to_height(actual_pixmap);
+  } /* memHeight */
+
+
+
+/**
+ *  Get the pixel at the position (x, y) of 'sourceWin'.
+ *  @exception RANGE_ERROR If (x, y) is outside of the pixmap.
+ */
+intType memGetPixel (const_winType sourceWin, intType x, intType y)
+
+  {
+    intType pixel;
+
+  /* memGetPixel */
+    if (unlikely(x < 0 || x >= (intType) to_width(sourceWin) ||
+                 y < 0 || y >= (intType) to_height(sourceWin))) {
+      raise_error(RANGE_ERROR);
+      pixel = 0;
+    } else {
+      pixel = (intType) (uint32Type) to_pixels(sourceWin)[
+          (memSizeType) y * to_width(sourceWin) + (memSizeType) x];
+    } /* if */
+    logFunction(printf("memGetPixel(" FMT_U_MEM ", " FMT_D ", " FMT_D ") --> " F_X(08) "\n",
+                       (memSizeType) sourceWin, x, y, pixel););
+    return pixel;
+  } /* memGetPixel */
+
+
+
+/**
+ *  Get the pixels of 'sourceWin' as string of 32-bit values.
+ */
+bstriType memGetPixelData (const_winType sourceWin)
+
+  {
+    memSizeType result_size;
+    bstriType result;
+
+  /* memGetPixelData */
+    logFunction(printf("memGetPixelData(" FMT_U_MEM ")\n", (memSizeType) sourceWin););
+    result_size = (memSizeType) to_width(sourceWin) * to_height(sourceWin) *
+                  sizeof(int32Type);
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, result_size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = result_size;
+      memcpy(result->mem, to_pixels(sourceWin), result_size);
+    } /* if */
+    return result;
+  } /* memGetPixelData */
+
+
+
+void memClear (winType actual_pixmap, intType col)
+
+  {
+    int32Type *pixel;
+    memSizeType count;
+
+  /* memClear */
+    logFunction(printf("memClear(" FMT_U_MEM ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, col););
+    ((mem_winType) actual_pixmap)->clear_col = col;
+    pixel = to_var_pixels(actual_pixmap);
+    for (count = (memSizeType) to_width(actual_pixmap) * to_height(actual_pixmap);
+         count != 0; count--) {
+      *pixel = (int32Type) col;
+      pixel++;
+    } /* for */
+  } /* memClear */
+
+
+
+void memPPoint (const_winType actual_pixmap, intType x, intType y, intType col)
+
+  { /* memPPoint */
+    logFunction(printf("memPPoint(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, col););
+    setPixel(actual_pixmap, x, y, (int32Type) col);
+  } /* memPPoint */
+
+
+
+void memPLine (const_winType actual_pixmap,
+    intType x1, intType y1, intType x2, intType y2, intType col)
+
+  { /* memPLine */
+    logFunction(printf("memPLine(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x1, y1, x2, y2, col););
+    drawLine(actual_pixmap, x1, y1, x2, y2, (int32Type) col);
+  } /* memPLine */
+
+
+
+/**
+ *  Fill a rectangle with 'col'.
+ *  A rectangle with a width or height of zero or less is not drawn.
+ */
+void memPRect (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, intType col)
+
+  {
+    intType line;
+    intType lastLine;
+    intType lastColumn;
+    memSizeType lineWidth;
+    const int32Type *firstLine;
+
+  /* memPRect */
+    logFunction(printf("memPRect(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, width, height, col););
+    if (width > 0 && height > 0 &&
+        x < (intType) to_width(actual_pixmap) &&
+        y < (intType) to_height(actual_pixmap) && x + width > 0 && y + height > 0) {
+      line = y < 0 ? 0 : y;
+      lastLine = y + height - 1;
+      if (lastLine >= (intType) to_height(actual_pixmap)) {
+        lastLine = (intType) to_height(actual_pixmap) - 1;
+      } /* if */
+      lastColumn = x + width - 1;
+      if (lastColumn >= (intType) to_width(actual_pixmap)) {
+        lastColumn = (intType) to_width(actual_pixmap) - 1;
+      } /* if */
+      if (x < 0) {
+        x = 0;
+      } /* if */
+      fillSpan(actual_pixmap, line, x, lastColumn, (int32Type) col);
+      /* The other lines are copies of the first line. */
+      lineWidth = to_width(actual_pixmap);
+      firstLine = &to_pixels(actual_pixmap)[(memSizeType) line * lineWidth + (memSizeType) x];
+      for (line++; line <= lastLine; line++) {
+        memcpy(&to_pixels(actual_pixmap)[(memSizeType) line * lineWidth + (memSizeType) x],
+               firstLine, (memSizeType) (lastColumn - x + 1) * sizeof(int32Type));
+      } /* for */
+    } /* if */
+  } /* memPRect */
+
+
+
+void memPCircle (const_winType actual_pixmap,
+    intType x, intType y, intType radius, intType col)
+
+  { /* memPCircle */
+    logFunction(printf("memPCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius, col););
+    if (radius >= 0) {
+      drawEllipse(actual_pixmap, x - radius, y - radius,
+                  2 * radius, 2 * radius, (int32Type) col);
+    } /* if */
+  } /* memPCircle */
+
+
+
+void memPFCircle (const_winType actual_pixmap,
+    intType x, intType y, intType radius, intType col)
+
+  { /* memPFCircle */
+    logFunction(printf("memPFCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius, col););
+    if (radius >= 0) {
+      fillEllipse(actual_pixmap, x - radius, y - radius,
+                  2 * radius, 2 * radius, (int32Type) col);
+    } /* if */
+  } /* memPFCircle */
+
+
+
+/**
+ *  Fill the ellipse with the bounding box (x, y, width, height).
+ *  @exception RANGE_ERROR If 'width' or 'height' are less than 1.
+ */
+void memPFEllipse (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, intType col)
+
+  { /* memPFEllipse */
+    logFunction(printf("memPFEllipse(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, width, height, col););
+    if (unlikely(width < 1 || height < 1)) {
+      raise_error(RANGE_ERROR);
+    } else {
+      fillEllipse(actual_pixmap, x, y, width, height, (int32Type) col);
+    } /* if */
+  } /* memPFEllipse */
+
+
+
+void memPArc (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col)
+
+  {
+    double *xCoords;
+    double *yCoords;
+    memSizeType numPoints;
+
+  /* memPArc */
+    logFunction(printf("memPArc(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", %.4f, %.4f, " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius,
+                       startAngle, sweepAngle, col););
+    if (radius >= 0 && allocArcPoints(&xCoords, &yCoords, MAX_ARC_POINTS)) {
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            FALSE, xCoords, yCoords);
+      drawPolyline(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      free(xCoords);
+      free(yCoords);
+    } /* if */
+  } /* memPArc */
+
+
+
+/**
+ *  Fill an arc with the given line 'width'.
+ *  The outer edge of the arc has the given 'radius'.
+ */
+void memPFArc (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle,
+    intType width, intType col)
+
+  {
+    double *xCoords;
+    double *yCoords;
+    double swap;
+    memSizeType numPoints;
+    memSizeType innerPoints;
+    memSizeType pos;
+
+  /* memPFArc */
+    logFunction(printf("memPFArc(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", %.4f, %.4f, " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius,
+                       startAngle, sweepAngle, width, col););
+    if (radius >= 0 && width >= 1 &&
+        allocArcPoints(&xCoords, &yCoords, 2 * MAX_ARC_POINTS)) {
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            TRUE, xCoords, yCoords);
+      if (width >= radius) {
+        xCoords[numPoints] = (double) x + 0.5;
+        yCoords[numPoints] = (double) y + 0.5;
+        numPoints++;
+      } else {
+        innerPoints = arcPoints(x, y, (double) (radius - width), startAngle,
+                                sweepAngle, TRUE, &xCoords[numPoints],
+                                &yCoords[numPoints]);
+        /* The inner arc is traversed backward. */
+        for (pos = 0; pos < innerPoints / 2; pos++) {
+          swap = xCoords[numPoints + pos];
+          xCoords[numPoints + pos] = xCoords[numPoints + innerPoints - 1 - pos];
+          xCoords[numPoints + innerPoints - 1 - pos] = swap;
+          swap = yCoords[numPoints + pos];
+          yCoords[numPoints + pos] = yCoords[numPoints + innerPoints - 1 - pos];
+          yCoords[numPoints + innerPoints - 1 - pos] = swap;
+        } /* for */
+        numPoints += innerPoints;
+      } /* if */
+      fillPolygon(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      free(xCoords);
+      free(yCoords);
+    } /* if */
+  } /* memPFArc */
+
+
+
+void memPFArcChord (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col)
+
+  {
+    double *xCoords;
+    double *yCoords;
+    memSizeType numPoints;
+
+  /* memPFArcChord */
+    logFunction(printf("memPFArcChord(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", %.4f, %.4f, " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius,
+                       startAngle, sweepAngle, col););
+    if (radius >= 0 && allocArcPoints(&xCoords, &yCoords, MAX_ARC_POINTS)) {
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            FALSE, xCoords, yCoords);
+      drawPolyline(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            TRUE, xCoords, yCoords);
+      fillPolygon(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      free(xCoords);
+      free(yCoords);
+    } /* if */
+  } /* memPFArcChord */
+
+
+
+void memPFArcPieSlice (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col)
+
+  {
+    double *xCoords;
+    double *yCoords;
+    memSizeType numPoints;
+
+  /* memPFArcPieSlice */
+    logFunction(printf("memPFArcPieSlice(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", %.4f, %.4f, " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, x, y, radius,
+                       startAngle, sweepAngle, col););
+    if (unlikely(radius < 0)) {
+      raise_error(RANGE_ERROR);
+    } else if (allocArcPoints(&xCoords, &yCoords, MAX_ARC_POINTS + 1)) {
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            FALSE, xCoords, yCoords);
+      drawPolyline(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      numPoints = arcPoints(x, y, (double) radius, startAngle, sweepAngle,
+                            TRUE, xCoords, yCoords);
+      xCoords[numPoints] = (double) x + 0.5;
+      yCoords[numPoints] = (double) y + 0.5;
+      fillPolygon(actual_pixmap, xCoords, yCoords, numPoints + 1, (int32Type) col);
+      free(xCoords);
+      free(yCoords);
+    } /* if */
+  } /* memPFArcPieSlice */
+
+
+
+/**
+ *  Draw lines between the points (x, y pairs with absolute coordinates).
+ */
+void memPolyLine (const_winType actual_pixmap, const intType *points,
+    memSizeType numPoints, intType col)
+
+  {
+    memSizeType pos;
+
+  /* memPolyLine */
+    logFunction(printf("memPolyLine(" FMT_U_MEM ", *, " FMT_U_MEM ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, numPoints, col););
+    if (numPoints == 1) {
+      setPixel(actual_pixmap, points[0], points[1], (int32Type) col);
+    } else {
+      for (pos = 1; pos < numPoints; pos++) {
+        drawLine(actual_pixmap, points[2 * pos - 2], points[2 * pos - 1],
+                 points[2 * pos], points[2 * pos + 1], (int32Type) col);
+      } /* for */
+    } /* if */
+  } /* memPolyLine */
+
+
+
+/**
+ *  Fill the polygon described by the points and draw its outline.
+ *  The points are x, y pairs with absolute coordinates.
+ */
+void memFPolyLine (const_winType actual_pixmap, const intType *points,
+    memSizeType numPoints, intType col)
+
+  {
+    double *xCoords;
+    double *yCoords;
+    memSizeType pos;
+
+  /* memFPolyLine */
+    logFunction(printf("memFPolyLine(" FMT_U_MEM ", *, " FMT_U_MEM ", " F_X(08) ")\n",
+                       (memSizeType) actual_pixmap, numPoints, col););
+    memPolyLine(actual_pixmap, points, numPoints, col);
+    if (numPoints >= 3 && allocArcPoints(&xCoords, &yCoords, numPoints)) {
+      for (pos = 0; pos < numPoints; pos++) {
+        xCoords[pos] = (double) points[2 * pos];
+        yCoords[pos] = (double) points[2 * pos + 1];
+      } /* for */
+      fillPolygon(actual_pixmap, xCoords, yCoords, numPoints, (int32Type) col);
+      free(xCoords);
+      free(yCoords);
+    } /* if */
+  } /* memFPolyLine */
+
+
+
+/**
+ *  Copy a rectangular area from 'src_pixmap' to 'dest_pixmap'.
+ *  @exception RANGE_ERROR If 'width' or 'height' are less than 1.
+ */
+void memCopyArea (const_winType src_pixmap, const_winType dest_pixmap,
+    intType src_x, intType src_y, intType width, intType height,
+    intType dest_x, intType dest_y)
+
+  { /* memCopyArea */
+    logFunction(printf("memCopyArea(" FMT_U_MEM ", " FMT_U_MEM ", "
+                       FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) src_pixmap, (memSizeType) dest_pixmap,
+                       src_x, src_y, width, height, dest_x, dest_y););
+    if (unlikely(!inIntRange(src_x) || !inIntRange(src_y) ||
+                 !inIntRange(width) || !inIntRange(height) ||
+                 !inIntRange(dest_x) || !inIntRange(dest_y) ||
+                 width < 1 || height < 1)) {
+      raise_error(RANGE_ERROR);
+    } else {
+      copyArea(src_pixmap, dest_pixmap, src_x, src_y, width, height,
+               dest_x, dest_y, FALSE);
+    } /* if */
+  } /* memCopyArea */
+
+
+
+/**
+ *  Copy 'pixmap' to the position (xDest, yDest) of 'destPixmap'.
+ *  Pixels with the transparent color of 'pixmap' are not copied.
+ */
+void memPut (const_winType destPixmap, intType xDest, intType yDest,
+    const_winType pixmap)
+
+  { /* memPut */
+    logFunction(printf("memPut(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_U_MEM ")\n",
+                       (memSizeType) destPixmap, xDest, yDest, (memSizeType) pixmap););
+    if (unlikely(!inIntRange(xDest) || !inIntRange(yDest))) {
+      raise_error(RANGE_ERROR);
+    } else if (pixmap != NULL) {
+      /* A pixmap value of NULL is used to describe an empty pixmap. */
+      copyArea(pixmap, destPixmap, 0, 0, (intType) to_width(pixmap),
+               (intType) to_height(pixmap), xDest, yDest, TRUE);
+    } /* if */
+  } /* memPut */
+
+
+
+/**
+ *  Scale 'pixmap' to 'width' and 'height' and put it to the position
+ *  (xDest, yDest) of 'destPixmap'. The nearest source pixel is used.
+ */
+void memPutScaled (const_winType destPixmap, intType xDest, intType yDest,
+    intType width, intType height, const_winType pixmap)
+
+  {
+    intType line;
+    intType column;
+    intType firstColumn;
+    intType lastLine;
+    intType lastColumn;
+    const int32Type *srcLine;
+    int32Type *destLine;
+
+  /* memPutScaled */
+    logFunction(printf("memPutScaled(" FMT_U_MEM  ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_U_MEM")\n",
+                       (memSizeType) destPixmap, xDest, yDest,
+                       width, height, (memSizeType) pixmap););
+    if (unlikely(!inIntRange(xDest) || !inIntRange(yDest) ||
+                 !inIntRange(width) || width < 0 ||
+                 !inIntRange(height) || height < 0)) {
+      raise_error(RANGE_ERROR);
+    } else if (pixmap != NULL && to_pixels(pixmap) != NULL &&
+               width > 0 && height > 0) {
+      line = yDest < 0 ? -yDest : 0;
+      lastLine = height - 1;
+      if (yDest + lastLine >= (intType) to_height(destPixmap)) {
+        lastLine = (intType) to_height(destPixmap) - 1 - yDest;
+      } /* if */
+      firstColumn = xDest < 0 ? -xDest : 0;
+      lastColumn = width - 1;
+      if (xDest + lastColumn >= (intType) to_width(destPixmap)) {
+        lastColumn = (intType) to_width(destPixmap) - 1 - xDest;
+      } /* if */
+      for (; line <= lastLine; line++) {
+        srcLine = &to_pixels(pixmap)[
+            (memSizeType) (line * (intType) to_height(pixmap) / height) * to_width(pixmap)];
+        destLine = &to_pixels(destPixmap)[
+            (memSizeType) (yDest + line) * to_width(destPixmap) + (memSizeType) xDest];
+        for (column = firstColumn; column <= lastColumn; column++) {
+          destLine[column] = srcLine[column * (intType) to_width(pixmap) / width];
+        } /* for */
+      } /* for */
+    } /* if */
+  } /* memPutScaled */
+
+
+
+void memSetTransparentColor (winType pixmap, intType col)
+
+  { /* memSetTransparentColor */
+    logFunction(printf("memSetTransparentColor(" FMT_U_MEM ", " F_X(08) ")\n",
+                       (memSizeType) pixmap, col););
+    if (pixmap != NULL) {
+      ((mem_winType) pixmap)->hasTransparentPixel = TRUE;
+      ((mem_winType) pixmap)->transparentPixel = (int32Type) col;
+    } /* if */
+  } /* memSetTransparentColor */
+
+
+
+/**
+ *  Convert the colors of light to a pixel of a memory pixmap.
+ *  The range of the colors of light is from 0 to 65535.
+ *  The pixel has the format 0xRRGGBB.
+ */
+intType memRgbColor (intType redLight, intType greenLight, intType blueLight)
+
+  { /* memRgbColor */
+    return (intType) ((((uintType) redLight   & 0xFF00) << 8) |
+                       ((uintType) greenLight & 0xFF00) |
+                      (((uintType) blueLight  & 0xFF00) >> 8));
+  } /* memRgbColor */
+
+
+
+void memPixelToRgb (intType col, intType *redLight, intType *greenLight,
+    intType *blueLight)
+
+  { /* memPixelToRgb */
+    *redLight   = (intType) (((uintType) col >> 8) & 0xFF00);
+    *greenLight = (intType) ( (uintType) col       & 0xFF00);
+    *blueLight  = (intType) (((uintType) col << 8) & 0xFF00);
+  } /* memPixelToRgb */
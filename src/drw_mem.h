@@ -0,0 +1,92 @@
+/********************************************************************/
+/*                                                                  */
+/*  drw_mem.h     Graphic access to pixmaps in main memory.         */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/drw_mem.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Graphic access to pixmaps in main memory.              */
+/*                                                                  */
+/********************************************************************/
+
+typedef struct {
+    uintType usage_count;
+    /* Up to here the structure is identical to struct winStruct */
+    int32Type *pixels;
+    unsigned int width;  /* Always <= INT_MAX: Cast to int is safe. */
+    unsigned int height; /* Always <= INT_MAX: Cast to int is safe. */
+    intType clear_col;
+    boolType hasTransparentPixel;
+    int32Type transparentPixel;
+  } mem_winRecord, *mem_winType;
+
+typedef const mem_winRecord *const_mem_winType;
+
+
+winType memEmpty (void);
+winType memNewPixmap (intType width, intType height);
+winType memImage (const int32Type *image_data, memSizeType width,
+    memSizeType height, boolType hasAlphaChannel);
+winType memGetPixmap (const_winType sourceWin, intType left, intType upper,
+    intType width, intType height);
+void memFree (winType old_pixmap);
+intType memWidth (const_winType actual_pixmap);
+intType memHeight (const_winType actual_pixmap);
+intType memGetPixel (const_winType sourceWin, intType x, intType y);
+bstriType memGetPixelData (const_winType sourceWin);
+void memClear (winType actual_pixmap, intType col);
+void memPPoint (const_winType actual_pixmap, intType x, intType y, intType col);
+void memPLine (const_winType actual_pixmap,
+    intType x1, intType y1, intType x2, intType y2, intType col);
+void memPRect (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, intType col);
+void memPCircle (const_winType actual_pixmap,
+    intType x, intType y, intType radius, intType col);
+void memPFCircle (const_winType actual_pixmap,
+    intType x, intType y, intType radius, intType col);
+void memPFEllipse (const_winType actual_pixmap,
+    intType x, intType y, intType width, intType height, intType col);
+void memPArc (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col);
+void memPFArc (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle,
+    intType width, intType col);
+void memPFArcChord (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col);
+void memPFArcPieSlice (const_winType actual_pixmap, intType x, intType y,
+    intType radius, floatType startAngle, floatType sweepAngle, intType col);
+void memPolyLine (const_winType actual_pixmap, const intType *points,
+    memSizeType numPoints, intType col);
+void memFPolyLine (const_winType actual_pixmap, const intType *points,
+    memSizeType numPoints, intType col);
+void memCopyArea (const_winType src_pixmap, const_winType dest_pixmap,
+    intType src_x, intType src_y, intType width, intType height,
+    intType dest_x, intType dest_y);
+void memPut (const_winType destPixmap, intType xDest, intType yDest,
+    const_winType pixmap);
+void memPutScaled (const_winType destPixmap, intType xDest, intType yDest,
+    intType width, intType height, const_winType pixmap);
+void memSetTransparentColor (winType pixmap, intType col);
+intType memRgbColor (intType redLight, intType greenLight, intType blueLight);
+void memPixelToRgb (intType col, intType *redLight, intType *greenLight,
+    intType *blueLight);
@@ -37,10 +37,12 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "math.h"
 
 #include "common.h"
 #include "data_rtl.h"
 #include "heaputl.h"
+#include "striutl.h"
 #include "bst_rtl.h"
 #include "rtl_err.h"
 #include "drw_drv.h"
@@ -51,6 +53,23 @@
 
 
 #define USE_DUFFS_UNROLLING 1
+#define PI 3.141592653589793238462643383279502884197
+#define RESAMPLE_PRECISION 22
+#define RESAMPLE_ROUNDING (1 << (RESAMPLE_PRECISION - 1))
+#define ROTATE_TILE_SIZE 32
+
+#define clampSample(sum) (unsigned char) ((sum) <= 0 ? 0 : \
+    ((sum) >= 256 << RESAMPLE_PRECISION ? 255 : (sum) >> RESAMPLE_PRECISION))
+
+/* Support radius of the resampling filters (box, bilinear and lanczos). */
+static const double filterSupport[] = {0.5, 1.0, 3.0};
+
+#if RSHIFT_DOES_SIGN_EXTEND
+#define signedRShift(number, shift) ((number) >> (shift))
+#else
+#define signedRShift(number, shift) \
+    ((number) < 0 ? ~(~(number) >> (shift)) : (number) >> (shift))
+#endif
 
 
 
@@ -181,6 +200,80 @@ static void memcpy_from_pixel (register intType *const dest,
 
 
 
+/**
+ *  Blend 'pixmap' with the constant opacity 'alpha' into 'destWindow'.
+ *  The color samples are combined with dest * (255 - alpha) +
+ *  source * alpha and divided by 255 (with rounding). The samples
+ *  of a whole pixel area are processed in one loop, which can be
+ *  vectorized by the C compiler. Pixels outside of 'destWindow' are
+ *  ignored.
+ *  @param alpha Opacity of 'pixmap' between 0 (transparent) and
+ *         255 (opaque).
+ *  @exception RANGE_ERROR If 'alpha' is not in the range 0 to 255.
+ */
+void drwBlend (const_winType destWindow, intType xDest, intType yDest,
+    const_winType pixmap, intType alpha)
+
+  {
+    intType width;
+    intType height;
+    winType background;
+    bstriType backgroundData;
+    bstriType pixmapData;
+    unsigned char *destSample;
+    const unsigned char *sourceSample;
+    memSizeType numSamples;
+    memSizeType idx;
+    unsigned int opacity;
+    unsigned int sum;
+    winType blended;
+
+  /* drwBlend */
+    logFunction(printf("drwBlend(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) destWindow, xDest, yDest,
+                       (memSizeType) pixmap, alpha););
+    if (unlikely(alpha < 0 || alpha > 255)) {
+      raise_error(RANGE_ERROR);
+    } else if (alpha == 255) {
+      drwPut(destWindow, xDest, yDest, pixmap);
+    } else if (alpha != 0 && pixmap != NULL) {
+      width = drwWidth(pixmap);
+      height = drwHeight(pixmap);
+      if (width >= 1 && height >= 1) {
+        background = drwGetPixmap(destWindow, xDest, yDest, width, height);
+        if (background != NULL) {
+          backgroundData = drwGetPixelData(background);
+          drwDestr(background);
+          if (backgroundData != NULL) {
+            pixmapData = drwGetPixelData(pixmap);
+            if (pixmapData != NULL) {
+              destSample = (unsigned char *) backgroundData->mem;
+              sourceSample = (const unsigned char *) pixmapData->mem;
+              numSamples = backgroundData->size;
+              opacity = (unsigned int) alpha;
+              for (idx = 0; idx < numSamples; idx++) {
+                sum = sourceSample[idx] * opacity +
+                      destSample[idx] * (255 - opacity) + 128;
+                destSample[idx] = (unsigned char) ((sum + (sum >> 8)) >> 8);
+              } /* for */
+              bstDestr(pixmapData);
+              blended = drwImage((int32Type *) backgroundData->mem,
+                                 (memSizeType) width, (memSizeType) height, FALSE);
+              if (blended != NULL) {
+                drwPut(destWindow, xDest, yDest, blended);
+                drwDestr(blended);
+              } /* if */
+            } /* if */
+            bstDestr(backgroundData);
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* drwBlend */
+
+
+
 /**
  *  Assign source to *dest.
  *  A copy function assumes that *dest contains a legal value.
@@ -391,6 +484,204 @@ rtlArrayType drwGetPixelArray (const_winType sourceWindow)
 
 
 
+/**
+ *  Convert the samples of one reconstructed PNG scanline to pixels.
+ *  Samples with up to 8 bits of grayscale and palette images are
+ *  converted with the lookup table. Alpha channels are ignored.
+ *  @return TRUE if the conversion succeeded, or
+ *          FALSE if a sample is not in the lookup table.
+ */
+static boolType pngScanlineToPixels (rtlObjectType *line,
+    const strElemType *sampleData, memSizeType width, unsigned int bitDepth,
+    memSizeType channels, const intType *lookup, unsigned int lookupSize)
+
+  {
+    memSizeType xPos;
+    unsigned int sample;
+    boolType okay = TRUE;
+
+  /* pngScanlineToPixels */
+    if (bitDepth < 8) {
+      for (xPos = 0; xPos < width; xPos++) {
+        sample = ((sampleData[xPos * bitDepth / 8] & 0xff) >>
+                  (8 - bitDepth - xPos * bitDepth % 8)) & ((1U << bitDepth) - 1);
+        if (unlikely(sample >= lookupSize)) {
+          okay = FALSE;
+        } else {
+          line[xPos].value.intValue = lookup[sample];
+        } /* if */
+      } /* for */
+    } else if (lookup != NULL) {
+      for (xPos = 0; xPos < width; xPos++) {
+        sample = sampleData[0] & 0xff;
+        if (unlikely(sample >= lookupSize)) {
+          okay = FALSE;
+        } else {
+          line[xPos].value.intValue = lookup[sample];
+        } /* if */
+        sampleData += channels;
+      } /* for */
+    } else if (bitDepth == 16 && channels <= 2) {
+      for (xPos = 0; xPos < width; xPos++) {
+        sample = (sampleData[0] & 0xff) << 8 | (sampleData[1] & 0xff);
+        line[xPos].value.intValue = drwRgbColor((intType) sample,
+            (intType) sample, (intType) sample);
+        sampleData += 2 * channels;
+      } /* for */
+    } else if (bitDepth == 8) {
+      for (xPos = 0; xPos < width; xPos++) {
+        line[xPos].value.intValue = drwRgbColor(
+            (intType) (sampleData[0] & 0xff) << 8,
+            (intType) (sampleData[1] & 0xff) << 8,
+            (intType) (sampleData[2] & 0xff) << 8);
+        sampleData += channels;
+      } /* for */
+    } else {
+      for (xPos = 0; xPos < width; xPos++) {
+        line[xPos].value.intValue = drwRgbColor(
+            (intType) ((sampleData[0] & 0xff) << 8 | (sampleData[1] & 0xff)),
+            (intType) ((sampleData[2] & 0xff) << 8 | (sampleData[3] & 0xff)),
+            (intType) ((sampleData[4] & 0xff) << 8 | (sampleData[5] & 0xff)));
+        sampleData += 2 * channels;
+      } /* for */
+    } /* if */
+    return okay;
+  } /* pngScanlineToPixels */
+
+
+
+/**
+ *  Convert reconstructed PNG scanlines to an array of pixel lines.
+ *  The scanlines start at startIndex and every scanline starts with
+ *  a filter type byte, which is ignored. Grayscale samples with less
+ *  than 8 bits are scaled to the full intensity. Samples with 8 bits
+ *  are multiplied by 256. Alpha channels are ignored.
+ *  @param pixelData Data with the reconstructed scanlines.
+ *  @param startIndex Index of the filter type byte of the first scanline.
+ *  @param bitDepth Number of bits per sample (1, 2, 4, 8 or 16).
+ *  @param colorType PNG color type (0, 2, 3, 4 or 6).
+ *  @param palette Palette for the color type 3 (indexed from 0).
+ *  @return an array of height lines with width pixels each.
+ *  @exception RANGE_ERROR If a parameter is out of range, if pixelData
+ *             is too short or if a palette index is not in the palette.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType drwGetPixelArrayFromPng (const const_striType pixelData,
+    intType startIndex, intType width, intType height, intType bitDepth,
+    intType colorType, const const_rtlArrayType palette)
+
+  {
+    memSizeType channels;
+    memSizeType bytesPerScanline;
+    memSizeType yPos;
+    intType lookup[256];
+    const intType *lookupTable = NULL;
+    unsigned int lookupSize = 0;
+    unsigned int sample;
+    intType intensity;
+    const strElemType *scanline;
+    rtlArrayType imageLine;
+    rtlArrayType imageArray = NULL;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* drwGetPixelArrayFromPng */
+    logFunction(printf("drwGetPixelArrayFromPng(\"%s\", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(pixelData), startIndex, width,
+                       height, bitDepth, colorType););
+    switch (colorType) {
+      case 0:  channels = 1; break;
+      case 2:  channels = 3; break;
+      case 3:  channels = 1; break;
+      case 4:  channels = 2; break;
+      case 6:  channels = 4; break;
+      default: channels = 0; break;
+    } /* switch */
+    if (unlikely(channels == 0 ||
+                 (bitDepth != 1 && bitDepth != 2 && bitDepth != 4 &&
+                  bitDepth != 8 && bitDepth != 16) ||
+                 (bitDepth < 8 && colorType != 0 && colorType != 3) ||
+                 (bitDepth == 16 && colorType == 3) ||
+                 width < 1 || (uintType) width > MAX_RTL_ARR_LEN ||
+                 height < 1 || (uintType) height > MAX_RTL_ARR_LEN ||
+                 startIndex < 1 ||
+                 (uintType) startIndex - 1 > pixelData->size)) {
+      logError(printf("drwGetPixelArrayFromPng: Illegal parameter.\n"););
+      err_info = RANGE_ERROR;
+    } else {
+      bytesPerScanline = ((memSizeType) width / 8 * channels *
+                          (memSizeType) bitDepth) +
+                         (((memSizeType) width % 8 * channels *
+                           (memSizeType) bitDepth + 7) / 8) + 1;
+      if (unlikely((uintType) height > (pixelData->size -
+                   ((memSizeType) startIndex - 1)) / bytesPerScanline)) {
+        logError(printf("drwGetPixelArrayFromPng: Data too short.\n"););
+        err_info = RANGE_ERROR;
+      } else if (unlikely(!ALLOC_RTL_ARRAY(imageArray, (memSizeType) height))) {
+        err_info = MEMORY_ERROR;
+      } else {
+        imageArray->min_position = 1;
+        imageArray->max_position = height;
+        if (colorType == 3) {
+          while (lookupSize < 256 &&
+                 (intType) lookupSize + palette->min_position <=
+                 palette->max_position) {
+            lookup[lookupSize] = palette->arr[lookupSize].value.intValue;
+            lookupSize++;
+          } /* while */
+          lookupTable = lookup;
+        } else if (bitDepth <= 8 && channels <= 2) {
+          lookupSize = 1U << bitDepth;
+          for (sample = 0; sample < lookupSize; sample++) {
+            if (bitDepth == 8) {
+              intensity = (intType) sample << 8;
+            } else {
+              intensity = (intType) sample * 65535 / (intType) (lookupSize - 1);
+            } /* if */
+            lookup[sample] = drwRgbColor(intensity, intensity, intensity);
+          } /* for */
+          lookupTable = lookup;
+        } /* if */
+        scanline = &pixelData->mem[startIndex];
+        yPos = 0;
+        while (err_info == OKAY_NO_ERROR && yPos < (memSizeType) height) {
+          if (unlikely(!ALLOC_RTL_ARRAY(imageLine, (memSizeType) width))) {
+            err_info = MEMORY_ERROR;
+          } else {
+            imageLine->min_position = 1;
+            imageLine->max_position = width;
+            imageArray->arr[yPos].value.arrayValue = imageLine;
+            yPos++;
+            if (unlikely(!pngScanlineToPixels(imageLine->arr, scanline,
+                (memSizeType) width, (unsigned int) bitDepth, channels,
+                lookupTable, lookupSize))) {
+              logError(printf("drwGetPixelArrayFromPng: "
+                              "Palette index not in palette.\n"););
+              err_info = RANGE_ERROR;
+            } /* if */
+            scanline += bytesPerScanline;
+          } /* if */
+        } /* while */
+        if (unlikely(err_info != OKAY_NO_ERROR)) {
+          /* Lines 0 .. yPos - 1 have been allocated. */
+          while (yPos >= 1) {
+            yPos--;
+            FREE_RTL_ARRAY(imageArray->arr[yPos].value.arrayValue,
+                           (memSizeType) width);
+          } /* while */
+          FREE_RTL_ARRAY(imageArray, (memSizeType) height);
+          imageArray = NULL;
+        } /* if */
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    return imageArray;
+  } /* drwGetPixelArrayFromPng */
+
+
+
 bstriType drwGetPixelDataFromArray (const const_rtlArrayType image)
 
   {
@@ -487,6 +778,639 @@ winType drwGetPixmapFromPixels (const const_rtlArrayType image)
 
 
 
+/**
+ *  Convert the samples of a JPEG minimum coded unit (MCU) to pixels.
+ *  The MCU consists of horizontal * vertical luma blocks (in
+ *  line-major order) and one block for each chroma component.
+ *  Every block has the samples in the upper left blockSize x blockSize
+ *  corner of 8x8 elements. The samples are scaled with factor 8 and
+ *  are not clamped. The chroma samples are upsampled by replication.
+ *  The color conversion and the clamping are done for a whole pixel
+ *  line with loops, which can be vectorized by the C compiler.
+ *  @param pixels Destination for the pixels of the MCU. The MCU has
+ *         horizontal * blockSize columns and vertical * blockSize lines.
+ *  @param chromaBlue Blue chroma block, or NULL for grayscale images.
+ *  @param chromaRed Red chroma block, or NULL for grayscale images.
+ */
+void drwJpegMcuToPixels (intType *pixels, const intType *const *lumaBlock,
+    const intType *chromaBlue, const intType *chromaRed,
+    unsigned int horizontal, unsigned int vertical, unsigned int blockSize)
+
+  {
+    unsigned int mcuWidth;
+    unsigned int mcuHeight;
+    unsigned int yPos;
+    unsigned int xPos;
+    unsigned int blockColumn;
+    const intType *lumaLine;
+    const intType *chromaBlueLine;
+    const intType *chromaRedLine;
+    intType chromaBlueSample;
+    intType chromaRedSample;
+    intType luminance[8 * JPEG_MAX_SAMPLING_FACTOR];
+    intType red[8 * JPEG_MAX_SAMPLING_FACTOR];
+    intType green[8 * JPEG_MAX_SAMPLING_FACTOR];
+    intType blue[8 * JPEG_MAX_SAMPLING_FACTOR];
+
+  /* drwJpegMcuToPixels */
+    mcuWidth = horizontal * blockSize;
+    mcuHeight = vertical * blockSize;
+    for (yPos = 0; yPos < mcuHeight; yPos++) {
+      for (blockColumn = 0; blockColumn < horizontal; blockColumn++) {
+        lumaLine = &lumaBlock[yPos / blockSize * horizontal + blockColumn]
+                             [yPos % blockSize * 8];
+        for (xPos = 0; xPos < blockSize; xPos++) {
+          luminance[blockColumn * blockSize + xPos] =
+              signedRShift(lumaLine[xPos], 3) + 128;
+        } /* for */
+      } /* for */
+      if (chromaBlue == NULL) {
+        for (xPos = 0; xPos < mcuWidth; xPos++) {
+          red[xPos] = luminance[xPos] < 0 ? 0 :
+                      (luminance[xPos] > 255 ? 255 : luminance[xPos]);
+        } /* for */
+        for (xPos = 0; xPos < mcuWidth; xPos++) {
+          pixels[xPos] = drwRgbColor(red[xPos] << 8, red[xPos] << 8,
+                                     red[xPos] << 8);
+        } /* for */
+      } else {
+        chromaBlueLine = &chromaBlue[yPos / vertical * 8];
+        chromaRedLine = &chromaRed[yPos / vertical * 8];
+        for (xPos = 0; xPos < mcuWidth; xPos++) {
+          chromaBlueSample = chromaBlueLine[xPos / horizontal];
+          chromaRedSample = chromaRedLine[xPos / horizontal];
+          red[xPos] = signedRShift(chromaRedSample * 359, 11) + luminance[xPos];
+          green[xPos] = luminance[xPos] - signedRShift(
+              chromaBlueSample * 88 + chromaRedSample * 183, 11);
+          blue[xPos] = signedRShift(chromaBlueSample * 454, 11) + luminance[xPos];
+        } /* for */
+        for (xPos = 0; xPos < mcuWidth; xPos++) {
+          red[xPos] = red[xPos] < 0 ? 0 : (red[xPos] > 255 ? 255 : red[xPos]);
+          green[xPos] = green[xPos] < 0 ? 0 : (green[xPos] > 255 ? 255 : green[xPos]);
+          blue[xPos] = blue[xPos] < 0 ? 0 : (blue[xPos] > 255 ? 255 : blue[xPos]);
+        } /* for */
+        for (xPos = 0; xPos < mcuWidth; xPos++) {
+          pixels[xPos] = drwRgbColor(red[xPos] << 8, green[xPos] << 8,
+                                     blue[xPos] << 8);
+        } /* for */
+      } /* if */
+      pixels += mcuWidth;
+    } /* for */
+  } /* drwJpegMcuToPixels */
+
+
+
+/**
+ *  Value of the resampling filter 'filter' at the position 'x'.
+ *  The position is measured in source pixels.
+ */
+static double filterValue (intType filter, double x)
+
+  {
+    double value;
+
+  /* filterValue */
+    if (x < 0.0) {
+      x = -x;
+    } /* if */
+    if (filter == RESAMPLE_BOX) {
+      value = x <= 0.5 ? 1.0 : 0.0;
+    } else if (filter == RESAMPLE_BILINEAR) {
+      value = x < 1.0 ? 1.0 - x : 0.0;
+    } else if (x == 0.0) {
+      value = 1.0;
+    } else if (x < 3.0) {
+      /* Lanczos filter with three lobes: sinc(x) * sinc(x / 3) */
+      value = 3.0 * sin(PI * x) * sin(PI * x / 3.0) / (PI * PI * x * x);
+    } else {
+      value = 0.0;
+    } /* if */
+    return value;
+  } /* filterValue */
+
+
+
+/**
+ *  Compute the weights to resample one dimension from inSize to outSize.
+ *  For every destination position 'bounds' gets the first source
+ *  position and the number of source positions used. The weights of
+ *  a destination position are normalized and stored as fixed point
+ *  numbers with RESAMPLE_PRECISION fraction bits. Every destination
+ *  position has 'kernelSize' weights (unused weights are zero).
+ *  @return the kernel size, or 0 if there is not enough memory.
+ */
+static memSizeType resampleWeights (memSizeType inSize, memSizeType outSize,
+    intType filter, memSizeType **bounds, int32Type **weights)
+
+  {
+    double scale;
+    double filterScale;
+    double support;
+    double center;
+    double weightSum;
+    double weight;
+    double *kernel;
+    memSizeType kernelSize;
+    memSizeType pos;
+    memSizeType first;
+    memSizeType beyond;
+    memSizeType idx;
+
+  /* resampleWeights */
+    scale = (double) inSize / (double) outSize;
+    filterScale = scale < 1.0 ? 1.0 : scale;
+    support = filterSupport[filter] * filterScale;
+    kernelSize = (memSizeType) ceil(support) * 2 + 1;
+    *bounds = (memSizeType *) malloc(outSize * 2 * sizeof(memSizeType));
+    *weights = (int32Type *) malloc(outSize * kernelSize * sizeof(int32Type));
+    kernel = (double *) malloc(kernelSize * sizeof(double));
+    if (unlikely(*bounds == NULL || *weights == NULL || kernel == NULL)) {
+      free(*bounds);
+      free(*weights);
+      free(kernel);
+      *bounds = NULL;
+      *weights = NULL;
+      kernelSize = 0;
+    } else {
+      for (pos = 0; pos < outSize; pos++) {
+        center = ((double) pos + 0.5) * scale;
+        if (center - support + 0.5 <= 0.0) {
+          first = 0;
+        } else {
+          first = (memSizeType) (center - support + 0.5);
+        } /* if */
+        if (center + support + 0.5 >= (double) inSize) {
+          beyond = inSize;
+        } else {
+          beyond = (memSizeType) (center + support + 0.5);
+        } /* if */
+        weightSum = 0.0;
+        for (idx = 0; idx < beyond - first; idx++) {
+          kernel[idx] = filterValue(filter,
+              ((double) (first + idx) - center + 0.5) / filterScale);
+          weightSum += kernel[idx];
+        } /* for */
+        for (idx = 0; idx < kernelSize; idx++) {
+          if (idx < beyond - first && weightSum != 0.0) {
+            weight = kernel[idx] / weightSum * (double) (1 << RESAMPLE_PRECISION);
+            (*weights)[pos * kernelSize + idx] =
+                (int32Type) (weight < 0.0 ? weight - 0.5 : weight + 0.5);
+          } else {
+            (*weights)[pos * kernelSize + idx] = 0;
+          } /* if */
+        } /* for */
+        (*bounds)[2 * pos] = first;
+        (*bounds)[2 * pos + 1] = beyond - first;
+      } /* for */
+      free(kernel);
+    } /* if */
+    return kernelSize;
+  } /* resampleWeights */
+
+
+
+/**
+ *  Resample the lines of an image horizontally.
+ *  The four bytes of a pixel are processed independently.
+ */
+static void resampleHorizontal (const unsigned char *source,
+    memSizeType inWidth, unsigned char *dest, memSizeType outWidth,
+    memSizeType height, const memSizeType *bounds,
+    const int32Type *weights, memSizeType kernelSize)
+
+  {
+    memSizeType line;
+    memSizeType pos;
+    memSizeType idx;
+    memSizeType count;
+    const unsigned char *sourcePixel;
+    const int32Type *kernel;
+    int32Type sum0;
+    int32Type sum1;
+    int32Type sum2;
+    int32Type sum3;
+
+  /* resampleHorizontal */
+    for (line = 0; line < height; line++) {
+      for (pos = 0; pos < outWidth; pos++) {
+        sourcePixel = &source[(line * inWidth + bounds[2 * pos]) * 4];
+        count = bounds[2 * pos + 1];
+        kernel = &weights[pos * kernelSize];
+        sum0 = RESAMPLE_ROUNDING;
+        sum1 = RESAMPLE_ROUNDING;
+        sum2 = RESAMPLE_ROUNDING;
+        sum3 = RESAMPLE_ROUNDING;
+        for (idx = 0; idx < count; idx++) {
+          sum0 += sourcePixel[0] * kernel[idx];
+          sum1 += sourcePixel[1] * kernel[idx];
+          sum2 += sourcePixel[2] * kernel[idx];
+          sum3 += sourcePixel[3] * kernel[idx];
+          sourcePixel += 4;
+        } /* for */
+        dest[0] = clampSample(sum0);
+        dest[1] = clampSample(sum1);
+        dest[2] = clampSample(sum2);
+        dest[3] = clampSample(sum3);
+        dest += 4;
+      } /* for */
+    } /* for */
+  } /* resampleHorizontal */
+
+
+
+/**
+ *  Resample the columns of an image vertically.
+ *  A destination line is computed by adding weighted source lines
+ *  to 'sum'. The loops over all bytes of a line can be vectorized
+ *  by the C compiler.
+ *  @param sum Buffer for 4 * width sums.
+ */
+static void resampleVertical (const unsigned char *source,
+    unsigned char *dest, memSizeType width, memSizeType outHeight,
+    const memSizeType *bounds, const int32Type *weights,
+    memSizeType kernelSize, int32Type *sum)
+
+  {
+    memSizeType lineSize;
+    memSizeType line;
+    memSizeType tap;
+    memSizeType idx;
+    const unsigned char *sourceLine;
+    int32Type weight;
+
+  /* resampleVertical */
+    lineSize = width * 4;
+    for (line = 0; line < outHeight; line++) {
+      for (idx = 0; idx < lineSize; idx++) {
+        sum[idx] = RESAMPLE_ROUNDING;
+      } /* for */
+      sourceLine = &source[bounds[2 * line] * lineSize];
+      for (tap = 0; tap < bounds[2 * line + 1]; tap++) {
+        weight = weights[line * kernelSize + tap];
+        for (idx = 0; idx < lineSize; idx++) {
+          sum[idx] += sourceLine[idx] * weight;
+        } /* for */
+        sourceLine += lineSize;
+      } /* for */
+      for (idx = 0; idx < lineSize; idx++) {
+        dest[idx] = clampSample(sum[idx]);
+      } /* for */
+      dest += lineSize;
+    } /* for */
+  } /* resampleVertical */
+
+
+
+/**
+ *  Create a new pixmap with the content of 'source' scaled to the
+ *  given 'width' and 'height'. The image is resampled in two
+ *  separable passes (horizontal and vertical) with fixed point
+ *  weights. A pass is omitted, if the size does not change in its
+ *  direction. When the image is reduced the filter is widened, such
+ *  that every source pixel contributes to the result.
+ *  @param filter RESAMPLE_BOX (area average), RESAMPLE_BILINEAR
+ *         or RESAMPLE_LANCZOS (Lanczos filter with three lobes).
+ *  @return the resampled pixmap.
+ *  @exception RANGE_ERROR If 'width' or 'height' are less than 1,
+ *             if 'source' is empty or if 'filter' is illegal.
+ *  @exception MEMORY_ERROR Not enough memory to resample the image.
+ */
+winType drwResample (const_winType source, intType width, intType height,
+    intType filter)
+
+  {
+    memSizeType inWidth;
+    memSizeType inHeight;
+    memSizeType outWidth;
+    memSizeType outHeight;
+    bstriType pixelData;
+    const unsigned char *lineData;
+    unsigned char *horizontalData = NULL;
+    int32Type *resultData;
+    memSizeType *bounds;
+    int32Type *weights;
+    int32Type *sum;
+    memSizeType kernelSize;
+    boolType okay = TRUE;
+    winType result;
+
+  /* drwResample */
+    logFunction(printf("drwResample(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ")\n",
+                       (memSizeType) source, width, height, filter););
+    if (source == NULL) {
+      inWidth = 0;
+      inHeight = 0;
+    } else {
+      inWidth = (memSizeType) drwWidth(source);
+      inHeight = (memSizeType) drwHeight(source);
+    } /* if */
+    if (unlikely(width < 1 || height < 1 || inWidth == 0 || inHeight == 0 ||
+                 filter < RESAMPLE_BOX || filter > RESAMPLE_LANCZOS)) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely((uintType) width > MAX_MEMSIZETYPE / 4 /
+                        ((uintType) height > inHeight ?
+                         (uintType) height : inHeight))) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      outWidth = (memSizeType) width;
+      outHeight = (memSizeType) height;
+      pixelData = drwGetPixelData(source);
+      if (unlikely(pixelData == NULL)) {
+        /* An exception has already been raised. */
+        result = NULL;
+      } else {
+        lineData = (const unsigned char *) pixelData->mem;
+        resultData = (int32Type *) malloc(outWidth * outHeight *
+                                          sizeof(int32Type));
+        if (unlikely(resultData == NULL)) {
+          okay = FALSE;
+        } else {
+          if (outWidth != inWidth) {
+            if (outHeight == inHeight) {
+              horizontalData = (unsigned char *) resultData;
+            } else {
+              horizontalData = (unsigned char *) malloc(outWidth * inHeight *
+                                                        sizeof(int32Type));
+            } /* if */
+            kernelSize = resampleWeights(inWidth, outWidth, filter,
+                                         &bounds, &weights);
+            if (unlikely(horizontalData == NULL || kernelSize == 0)) {
+              okay = FALSE;
+            } else {
+              resampleHorizontal(lineData, inWidth, horizontalData,
+                                 outWidth, inHeight, bounds, weights,
+                                 kernelSize);
+              lineData = horizontalData;
+            } /* if */
+            free(bounds);
+            free(weights);
+          } /* if */
+          if (okay) {
+            if (outHeight != inHeight) {
+              sum = (int32Type *) malloc(outWidth * 4 * sizeof(int32Type));
+              kernelSize = resampleWeights(inHeight, outHeight, filter,
+                                           &bounds, &weights);
+              if (unlikely(sum == NULL || kernelSize == 0)) {
+                okay = FALSE;
+              } else {
+                resampleVertical(lineData, (unsigned char *) resultData,
+                                 outWidth, outHeight, bounds, weights,
+                                 kernelSize, sum);
+              } /* if */
+              free(sum);
+              free(bounds);
+              free(weights);
+            } else if (outWidth == inWidth) {
+              memcpy(resultData, lineData,
+                     outWidth * outHeight * sizeof(int32Type));
+            } /* if */
+          } /* if */
+          if (horizontalData != (unsigned char *) resultData) {
+            free(horizontalData);
+          } /* if */
+        } /* if */
+        bstDestr(pixelData);
+        if (unlikely(!okay)) {
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          result = drwImage(resultData, outWidth, outHeight, FALSE);
+        } /* if */
+        free(resultData);
+      } /* if */
+    } /* if */
+    logFunction(printf("drwResample --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return result;
+  } /* drwResample */
+
+
+
+/**
+ *  Create a new pixmap with the content of 'source' rotated clockwise
+ *  by 'quarterTurns' * 90 degrees. Negative values rotate counter-
+ *  clockwise. The pixels are copied in tiles of ROTATE_TILE_SIZE *
+ *  ROTATE_TILE_SIZE pixels, such that reading and writing stays
+ *  in the cache.
+ *  @return the rotated pixmap.
+ *  @exception RANGE_ERROR If 'source' is empty.
+ */
+winType drwRotate (const_winType source, intType quarterTurns)
+
+  {
+    memSizeType width;
+    memSizeType height;
+    unsigned int turns;
+    bstriType pixelData;
+    const int32Type *sourceData;
+    int32Type *resultData;
+    memSizeType numPixels;
+    memSizeType xTile;
+    memSizeType yTile;
+    memSizeType xEnd;
+    memSizeType yEnd;
+    memSizeType xPos;
+    memSizeType yPos;
+    winType result;
+
+  /* drwRotate */
+    logFunction(printf("drwRotate(" FMT_U_MEM ", " FMT_D ")\n",
+                       (memSizeType) source, quarterTurns););
+    if (source == NULL) {
+      width = 0;
+      height = 0;
+    } else {
+      width = (memSizeType) drwWidth(source);
+      height = (memSizeType) drwHeight(source);
+    } /* if */
+    turns = (unsigned int) ((uintType) quarterTurns & 3);
+    if (unlikely(width == 0 || height == 0)) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      pixelData = drwGetPixelData(source);
+      if (unlikely(pixelData == NULL)) {
+        /* An exception has already been raised. */
+        result = NULL;
+      } else {
+        sourceData = (const int32Type *) pixelData->mem;
+        numPixels = width * height;
+        if (unlikely((resultData = (int32Type *) malloc(
+            numPixels * sizeof(int32Type))) == NULL)) {
+          bstDestr(pixelData);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          if (turns == 0) {
+            memcpy(resultData, sourceData, numPixels * sizeof(int32Type));
+          } else if (turns == 2) {
+            for (xPos = 0; xPos < numPixels; xPos++) {
+              resultData[numPixels - 1 - xPos] = sourceData[xPos];
+            } /* for */
+          } else {
+            for (yTile = 0; yTile < height; yTile += ROTATE_TILE_SIZE) {
+              yEnd = yTile + ROTATE_TILE_SIZE < height ?
+                     yTile + ROTATE_TILE_SIZE : height;
+              for (xTile = 0; xTile < width; xTile += ROTATE_TILE_SIZE) {
+                xEnd = xTile + ROTATE_TILE_SIZE < width ?
+                       xTile + ROTATE_TILE_SIZE : width;
+                for (yPos = yTile; yPos < yEnd; yPos++) {
+                  if (turns == 1) {
+                    for (xPos = xTile; xPos < xEnd; xPos++) {
+                      resultData[xPos * height + height - 1 - yPos] =
+                          sourceData[yPos * width + xPos];
+                    } /* for */
+                  } else {
+                    for (xPos = xTile; xPos < xEnd; xPos++) {
+                      resultData[(width - 1 - xPos) * height + yPos] =
+                          sourceData[yPos * width + xPos];
+                    } /* for */
+                  } /* if */
+                } /* for */
+              } /* for */
+            } /* for */
+          } /* if */
+          bstDestr(pixelData);
+          if (turns == 1 || turns == 3) {
+            result = drwImage(resultData, height, width, FALSE);
+          } else {
+            result = drwImage(resultData, width, height, FALSE);
+          } /* if */
+          free(resultData);
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("drwRotate --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return result;
+  } /* drwRotate */
+
+
+
+/**
+ *  Convert a JPEG minimum coded unit (MCU) to pixels and write them
+ *  into an image. The MCU consists of horizontal * vertical luma
+ *  blocks (in line-major order) and one block for each chroma component.
+ *  The blocks have been transformed with an inverse DCT of blockSize
+ *  (see jpgIdct). Pixels outside of the image are ignored.
+ *  @param image Array of pixel lines, which is changed in place.
+ *  @param luma Array with the luma blocks of the MCU.
+ *  @param chromaBlue Blue chroma block, or an empty array for
+ *         grayscale images.
+ *  @param chromaRed Red chroma block, or an empty array for
+ *         grayscale images.
+ *  @param horizontal Horizontal sampling factor of the luma component.
+ *  @param vertical Vertical sampling factor of the luma component.
+ *  @param blockSize Width and height of the samples in a block
+ *         (8, 4, 2 or 1).
+ *  @param mcuTopLine Image line of the upper left corner of the MCU.
+ *  @param mcuLeftColumn Image column of the upper left corner of the MCU.
+ *  @exception RANGE_ERROR If a parameter is out of range or if a
+ *             block has less than 64 elements.
+ */
+void drwSetJpegMcuPixels (rtlArrayType image, const const_rtlArrayType luma,
+    const const_rtlArrayType chromaBlue, const const_rtlArrayType chromaRed,
+    intType horizontal, intType vertical, intType blockSize,
+    intType mcuTopLine, intType mcuLeftColumn)
+
+  {
+    intType lumaData[JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR][64];
+    const intType *lumaBlock[JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR];
+    intType chromaBlueData[64];
+    intType chromaRedData[64];
+    intType pixels[64 * JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR];
+    boolType grayscale;
+    memSizeType numLuma = 0;
+    memSizeType blockNum;
+    memSizeType mcuWidth;
+    memSizeType mcuHeight;
+    memSizeType yPos;
+    memSizeType xPos;
+    memSizeType columns;
+    rtlArrayType imageLine;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* drwSetJpegMcuPixels */
+    logFunction(printf("drwSetJpegMcuPixels(arr (size=" FMT_U_MEM "), "
+                       "arr (size=" FMT_U_MEM "), arr, arr, " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       arraySize(image), arraySize(luma), horizontal,
+                       vertical, blockSize, mcuTopLine, mcuLeftColumn););
+    grayscale = arraySize(chromaBlue) == 0 && arraySize(chromaRed) == 0;
+    if (unlikely(horizontal < 1 || horizontal > JPEG_MAX_SAMPLING_FACTOR ||
+                 vertical < 1 || vertical > JPEG_MAX_SAMPLING_FACTOR ||
+                 (blockSize != 8 && blockSize != 4 &&
+                  blockSize != 2 && blockSize != 1) ||
+                 mcuTopLine < image->min_position ||
+                 (!grayscale && (arraySize(chromaBlue) < 64 ||
+                                 arraySize(chromaRed) < 64)))) {
+      logError(printf("drwSetJpegMcuPixels: Illegal parameter.\n"););
+      err_info = RANGE_ERROR;
+    } else {
+      numLuma = (memSizeType) (horizontal * vertical);
+      if (unlikely(arraySize(luma) < numLuma)) {
+        logError(printf("drwSetJpegMcuPixels: Not enough luma blocks.\n"););
+        err_info = RANGE_ERROR;
+      } /* if */
+    } /* if */
+    for (blockNum = 0; err_info == OKAY_NO_ERROR && blockNum < numLuma;
+         blockNum++) {
+      if (unlikely(arraySize(luma->arr[blockNum].value.arrayValue) < 64)) {
+        logError(printf("drwSetJpegMcuPixels: Luma block with less "
+                        "than 64 elements.\n"););
+        err_info = RANGE_ERROR;
+      } else {
+        for (xPos = 0; xPos < 64; xPos++) {
+          lumaData[blockNum][xPos] =
+              luma->arr[blockNum].value.arrayValue->arr[xPos].value.intValue;
+        } /* for */
+        lumaBlock[blockNum] = lumaData[blockNum];
+      } /* if */
+    } /* for */
+    if (likely(err_info == OKAY_NO_ERROR)) {
+      if (!grayscale) {
+        for (xPos = 0; xPos < 64; xPos++) {
+          chromaBlueData[xPos] = chromaBlue->arr[xPos].value.intValue;
+          chromaRedData[xPos] = chromaRed->arr[xPos].value.intValue;
+        } /* for */
+      } /* if */
+      drwJpegMcuToPixels(pixels, lumaBlock,
+                         grayscale ? NULL : chromaBlueData,
+                         grayscale ? NULL : chromaRedData,
+                         (unsigned int) horizontal, (unsigned int) vertical,
+                         (unsigned int) blockSize);
+      mcuWidth = (memSizeType) (horizontal * blockSize);
+      mcuHeight = (memSizeType) (vertical * blockSize);
+      for (yPos = 0; err_info == OKAY_NO_ERROR && yPos < mcuHeight &&
+           mcuTopLine <= image->max_position - (intType) yPos; yPos++) {
+        imageLine = image->arr[(memSizeType) (mcuTopLine - image->min_position) +
+                               yPos].value.arrayValue;
+        if (unlikely(mcuLeftColumn < imageLine->min_position)) {
+          logError(printf("drwSetJpegMcuPixels: Column " FMT_D
+                          " outside of the image.\n", mcuLeftColumn););
+          err_info = RANGE_ERROR;
+        } else if (mcuLeftColumn <= imageLine->max_position) {
+          columns = (memSizeType) (imageLine->max_position - mcuLeftColumn) + 1;
+          if (columns > mcuWidth) {
+            columns = mcuWidth;
+          } /* if */
+          for (xPos = 0; xPos < columns; xPos++) {
+            imageLine->arr[(memSizeType) (mcuLeftColumn - imageLine->min_position) +
+                           xPos].value.intValue = pixels[yPos * mcuWidth + xPos];
+          } /* for */
+        } /* if */
+      } /* for */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* drwSetJpegMcuPixels */
+
+
+
 const_bstriType pltAlign (const const_bstriType pointList)
 
   {
@@ -29,10 +29,31 @@
 /*                                                                  */
 /********************************************************************/
 
+#define JPEG_MAX_SAMPLING_FACTOR 4
+
+#define RESAMPLE_BOX      0
+#define RESAMPLE_BILINEAR 1
+#define RESAMPLE_LANCZOS  2
+
+void drwBlend (const_winType destWindow, intType xDest, intType yDest,
+    const_winType pixmap, intType alpha);
 void drwCpy (winType *const dest, const winType source);
 winType drwCreate (const winType source);
 void drwDestr (const winType old_win);
 intType drwGetImagePixel (const_bstriType image, intType width,
     intType height, intType x, intType y);
+rtlArrayType drwGetPixelArrayFromPng (const const_striType pixelData,
+    intType startIndex, intType width, intType height, intType bitDepth,
+    intType colorType, const const_rtlArrayType palette);
 winType drwGetPixmapFromPixels (const const_rtlArrayType image);
+void drwJpegMcuToPixels (intType *pixels, const intType *const *lumaBlock,
+    const intType *chromaBlue, const intType *chromaRed,
+    unsigned int horizontal, unsigned int vertical, unsigned int blockSize);
+winType drwResample (const_winType source, intType width, intType height,
+    intType filter);
+winType drwRotate (const_winType source, intType quarterTurns);
+void drwSetJpegMcuPixels (rtlArrayType image, const const_rtlArrayType luma,
+    const const_rtlArrayType chromaBlue, const const_rtlArrayType chromaRed,
+    intType horizontal, intType vertical, intType blockSize,
+    intType mcuTopLine, intType mcuLeftColumn);
 const_bstriType pltAlign (const const_bstriType pointList);
@@ -64,6 +64,7 @@
 #include "heaputl.h"
 #include "striutl.h"
 #include "rtl_err.h"
+#include "drw_mem.h"
 
 #undef EXTERN
 #define EXTERN
@@ -96,6 +97,10 @@ static int myscreen;
 
 static boolType init_called = FALSE;
 
+/* With SEED7_HEADLESS all pixmaps are kept in main memory (see drw_mem.c). */
+static boolType memory_pixmaps = FALSE;
+static intType memory_foreground = 0;
+
 typedef struct {
     uintType usage_count;
     /* Up to here the structure is identical to struct winStruct */
@@ -437,6 +442,12 @@ static int get_highest_bit (unsigned long number)
 
 
 
+/**
+ *  Open the display and initialize the X11 driver.
+ *  If the environment variable SEED7_HEADLESS is set to a non-empty
+ *  value no display is opened. In this case all pixmaps are kept in
+ *  main memory and windows cannot be opened.
+ */
 void drawInit (void)
 
   {
@@ -446,10 +457,14 @@ void drawInit (void)
     XColor color;
     static const char data[1] = {0};
     Pixmap blankPixmap;
+    const char *headless;
 
   /* drawInit */
     logFunction(printf("drawInit()\n"););
-    if (findX11Dll()) {
+    headless = getenv("SEED7_HEADLESS");
+    if (headless != NULL && headless[0] != '\0') {
+      memory_pixmaps = TRUE;
+    } else if (findX11Dll()) {
       /* If linking with a profiling standard library XOpenDisplay */
       /* deadlocked. Be careful to avoid this situation.           */
       mydisplay = XOpenDisplay("");
@@ -596,6 +611,10 @@ intType drwPointerXpos (const_winType actual_window)
   /* drwPointerXpos */
     logFunction(printf("drwPointerXpos(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
     window = to_window(actual_window);
     if (window == 0) {
       window = DefaultRootWindow(mydisplay);
@@ -631,6 +650,10 @@ intType drwPointerYpos (const_winType actual_window)
   /* drwPointerYpos */
     logFunction(printf("drwPointerYpos(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
     window = to_window(actual_window);
     if (window == 0) {
       window = DefaultRootWindow(mydisplay);
@@ -655,6 +678,10 @@ void drwArc (const_winType actual_window, intType x, intType y,
   /* drwArc */
     logFunction(printf("drwArc(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", %.4f, %.4f)\n",
                        (memSizeType) actual_window, x, y, radius, startAngle, sweepAngle););
+    if (memory_pixmaps) {
+      memPArc(actual_window, x, y, radius, startAngle, sweepAngle, memory_foreground);
+      return;
+    } /* if */
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
     sweepAng = (int) (sweepAngle * (23040.0 / (2 * PI)));
     XDrawArc(mydisplay, to_window(actual_window), mygc,
@@ -682,6 +709,10 @@ void drwPArc (const_winType actual_window, intType x, intType y,
                        ", %.4f, %.4f, " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius,
                        startAngle, sweepAngle, col););
+    if (memory_pixmaps) {
+      memPArc(actual_window, x, y, radius, startAngle, sweepAngle, col);
+      return;
+    } /* if */
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
     sweepAng = (int) (sweepAngle * (23040.0 / (2 * PI)));
     XSetForeground(mydisplay, mygc, (unsigned long) col);
@@ -713,6 +744,11 @@ void drwPFArc (const_winType actual_window, intType x, intType y,
                        ", %.4f, %.4f, " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius,
                        startAngle, sweepAngle, width, col););
+    if (memory_pixmaps) {
+      memPFArc(actual_window, x, y, radius, startAngle, sweepAngle,
+          width, col);
+      return;
+    } /* if */
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
     sweepAng = (int) (sweepAngle * (23040.0 / (2 * PI)));
     if ((width & 1) != 0) {
@@ -756,6 +792,11 @@ void drwFArcChord (const_winType actual_window, intType x, intType y,
   /* drwFArcChord */
     logFunction(printf("drwFArcChord(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", %.4f, %.4f)\n",
                        (memSizeType) actual_window, x, y, radius, startAngle, sweepAngle););
+    if (memory_pixmaps) {
+      memPFArcChord(actual_window, x, y, radius, startAngle, sweepAngle,
+          memory_foreground);
+      return;
+    } /* if */
     XSetArcMode(mydisplay, mygc, ArcChord);
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
     sweepAng = (int) (sweepAngle * (23040.0 / (2 * PI)));
@@ -792,6 +833,10 @@ void drwPFArcChord (const_winType actual_window, intType x, intType y,
                        ", %.4f, %.4f, " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius,
                        startAngle, sweepAngle, col););
+    if (memory_pixmaps) {
+      memPFArcChord(actual_window, x, y, radius, startAngle, sweepAngle, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XSetArcMode(mydisplay, mygc, ArcChord);
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
@@ -827,6 +872,11 @@ void drwFArcPieSlice (const_winType actual_window, intType x, intType y,
   /* drwFArcPieSlice */
     logFunction(printf("drwFArcPieSlice(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", %.4f, %.4f)\n",
                        (memSizeType) actual_window, x, y, radius, startAngle, sweepAngle););
+    if (memory_pixmaps) {
+      memPFArcPieSlice(actual_window, x, y, radius, startAngle, sweepAngle,
+          memory_foreground);
+      return;
+    } /* if */
     XSetArcMode(mydisplay, mygc, ArcPieSlice);
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
     sweepAng = (int) (sweepAngle * (23040.0 / (2 * PI)));
@@ -863,6 +913,10 @@ void drwPFArcPieSlice (const_winType actual_window, intType x, intType y,
                        ", %.4f, %.4f, " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius,
                        startAngle, sweepAngle, col););
+    if (memory_pixmaps) {
+      memPFArcPieSlice(actual_window, x, y, radius, startAngle, sweepAngle, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XSetArcMode(mydisplay, mygc, ArcPieSlice);
     startAng = (int) (startAngle * (23040.0 / (2 * PI)));
@@ -898,6 +952,11 @@ void drwArc2 (const_winType actual_window,
     intType x1, intType y1, intType x2, intType y2, intType radius)
 
   { /* drwArc2 */
+    if (memory_pixmaps) {
+      memPCircle(actual_window, x1, y1, radius, memory_foreground);
+      memPLine(actual_window, x1, y1, x2, y2, memory_foreground);
+      return;
+    } /* if */
 /*  printf("drwArc2(%d, %d, %d, %d)\n", x1, y1, radius); */
     XDrawArc(mydisplay, to_window(actual_window), mygc,
         castToInt(x1 - radius), castToInt(y1 - radius),
@@ -930,6 +989,10 @@ rtlArrayType drwBorder (const_winType actual_window)
   /* drwBorder */
     logFunction(printf("drwBorder(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
     window = to_window(actual_window);
     if (is_pixmap(actual_window)) {
       raise_error(RANGE_ERROR);
@@ -1002,6 +1065,10 @@ void drwCircle (const_winType actual_window,
   { /* drwCircle */
     logFunction(printf("drwCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x, y, radius););
+    if (memory_pixmaps) {
+      memPCircle(actual_window, x, y, radius, memory_foreground);
+      return;
+    } /* if */
     XDrawArc(mydisplay, to_window(actual_window), mygc,
         castToInt(x - radius), castToInt(y - radius),
         (unsigned) (2 * radius), (unsigned) (2 * radius), 0, 23040);
@@ -1020,6 +1087,10 @@ void drwPCircle (const_winType actual_window,
   { /* drwPCircle */
     logFunction(printf("drwPCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius, col););
+    if (memory_pixmaps) {
+      memPCircle(actual_window, x, y, radius, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XDrawArc(mydisplay, to_window(actual_window), mygc,
         castToInt(x - radius), castToInt(y - radius),
@@ -1038,6 +1109,10 @@ void drwClear (winType actual_window, intType col)
   { /* drwClear */
     logFunction(printf("drwClear(" FMT_U_MEM ", " F_X(08) ")\n",
                        (memSizeType) actual_window, col););
+    if (memory_pixmaps) {
+      memClear(actual_window, col);
+      return;
+    } /* if */
     to_var_clear_col(actual_window) = col;
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     /* The main window is cleared with the real window size. */
@@ -1073,6 +1148,11 @@ void drwCopyArea (const_winType src_window, const_winType dest_window,
                        FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) src_window, (memSizeType) dest_window,
                        src_x, src_y, width, height, dest_x, dest_y););
+    if (memory_pixmaps) {
+      memCopyArea(src_window, dest_window, src_x, src_y, width, height,
+                  dest_x, dest_y);
+      return;
+    } /* if */
     if (unlikely(!inIntRange(src_x) || !inIntRange(src_y) ||
                  !inIntRange(width) || !inIntRange(height) ||
                  !inIntRange(dest_x) || !inIntRange(dest_y) ||
@@ -1111,6 +1191,10 @@ void drwFCircle (const_winType actual_window,
   { /* drwFCircle */
     logFunction(printf("drwFCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x, y, radius););
+    if (memory_pixmaps) {
+      memPFCircle(actual_window, x, y, radius, memory_foreground);
+      return;
+    } /* if */
     XDrawArc(mydisplay, to_window(actual_window), mygc,
         castToInt(x - radius), castToInt(y - radius),
         (unsigned) (2 * radius), (unsigned) (2 * radius), 0, 23040);
@@ -1135,6 +1219,10 @@ void drwPFCircle (const_winType actual_window,
   { /* drwPFCircle */
     logFunction(printf("drwPFCircle(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius, col););
+    if (memory_pixmaps) {
+      memPFCircle(actual_window, x, y, radius, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XDrawArc(mydisplay, to_window(actual_window), mygc,
         castToInt(x - radius), castToInt(y - radius),
@@ -1160,6 +1248,10 @@ void drwFEllipse (const_winType actual_window,
   { /* drwFEllipse */
     logFunction(printf("drwFEllipse(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x, y, width, height););
+    if (memory_pixmaps) {
+      memPFEllipse(actual_window, x, y, width, height, memory_foreground);
+      return;
+    } /* if */
     if (unlikely(width < 1 || height < 1)) {
       raise_error(RANGE_ERROR);
     } else {
@@ -1184,6 +1276,10 @@ void drwPFEllipse (const_winType actual_window,
   { /* drwPFEllipse */
     logFunction(printf("drwPFEllipse(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, width, height, col););
+    if (memory_pixmaps) {
+      memPFEllipse(actual_window, x, y, width, height, col);
+      return;
+    } /* if */
     if (unlikely(width < 1 || height < 1)) {
       raise_error(RANGE_ERROR);
     } else {
@@ -1210,6 +1306,9 @@ winType drwEmpty (void)
 
   /* drwEmpty */
     logFunction(printf("drwEmpty()\n"););
+    if (memory_pixmaps) {
+      return memEmpty();
+    } /* if */
     if (unlikely(!ALLOC_RECORD2(emptyWindow, x11_winRecord, count.win, count.win_bytes))) {
       raise_error(MEMORY_ERROR);
     } else {
@@ -1237,6 +1336,10 @@ void drwFree (winType old_window)
     logFunction(printf("drwFree(" FMT_U_MEM ") (usage=" FMT_U ")\n",
                        (memSizeType) old_window,
                        old_window != NULL ? old_window->usage_count : (uintType) 0););
+    if (memory_pixmaps) {
+      memFree(old_window);
+      return;
+    } /* if */
     if (is_pixmap(old_window)) {
       if (to_window(old_window) != 0) {
         XFreePixmap(mydisplay, to_window(old_window));
@@ -1282,6 +1385,11 @@ winType drwCapture (intType left, intType upper,
   /* drwCapture */
     logFunction(printf("drwCapture(" FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        left, upper, width, height););
+    if (memory_pixmaps) {
+      logError(printf("drwCapture: There is no screen to capture.\n"););
+      raise_error(GRAPHIC_ERROR);
+      return NULL;
+    } /* if */
     if (unlikely(!inIntRange(left) || !inIntRange(upper) ||
                  !inIntRange(width) || !inIntRange(height) ||
                  width < 1 || height < 1)) {
@@ -1339,6 +1447,9 @@ intType drwGetPixel (const_winType sourceWindow, intType x, intType y)
   /* drwGetPixel */
     logFunction(printf("drwGetPixel(" FMT_U_MEM ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) sourceWindow, x, y););
+    if (memory_pixmaps) {
+      return memGetPixel(sourceWindow, x, y);
+    } /* if */
     if (to_backup(sourceWindow) != 0) {
       image = XGetImage(mydisplay, to_backup(sourceWindow),
                         castToInt(x), castToInt(y), 1, 1,
@@ -1370,6 +1481,9 @@ bstriType drwGetPixelData (const_winType sourceWindow)
 
   /* drwGetPixelData */
     logFunction(printf("drwGetPixelData(" FMT_U_MEM ")\n", (memSizeType) sourceWindow););
+    if (memory_pixmaps) {
+      return memGetPixelData(sourceWindow);
+    } /* if */
     if (to_window(sourceWindow) == 0) {
       if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, 0))) {
         raise_error(MEMORY_ERROR);
@@ -1434,6 +1548,9 @@ winType drwGetPixmap (const_winType sourceWindow, intType left, intType upper,
   /* drwGetPixmap */
     logFunction(printf("drwGetPixmap(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) sourceWindow, left, upper, width, height););
+    if (memory_pixmaps) {
+      return memGetPixmap(sourceWindow, left, upper, width, height);
+    } /* if */
     if (unlikely(!inIntRange(left) || !inIntRange(upper) ||
                  !inIntRange(width) || !inIntRange(height) ||
                  width < 1 || height < 1)) {
@@ -1492,6 +1609,9 @@ intType drwHeight (const_winType actual_window)
     unsigned int depth;
 
   /* drwHeight */
+    if (memory_pixmaps) {
+      return memHeight(actual_window);
+    } /* if */
     /* printf("drwHeight(" FMT_U_MEM "), usage=" FMT_U "\n",
        actual_window, actual_window != 0 ? actual_window->usage_count: 0); */
     if (is_pixmap(actual_window)) {
@@ -1518,6 +1638,9 @@ winType drwImage (int32Type *image_data, memSizeType width, memSizeType height,
   /* drwImage */
     logFunction(printf("drwImage(" FMT_U_MEM ", " FMT_U_MEM ", %d)\n",
                        width, height, hasAlphaChannel););
+    if (memory_pixmaps) {
+      return memImage(image_data, width, height, hasAlphaChannel);
+    } /* if */
     if (unlikely(width < 1 || width > UINT_MAX ||
                  height < 1 || height > UINT_MAX)) {
       raise_error(RANGE_ERROR);
@@ -1571,6 +1694,10 @@ void drwLine (const_winType actual_window,
   { /* drwLine */
     logFunction(printf("drwLine(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x1, y1, x2, y2););
+    if (memory_pixmaps) {
+      memPLine(actual_window, x1, y1, x2, y2, memory_foreground);
+      return;
+    } /* if */
     XDrawLine(mydisplay, to_window(actual_window), mygc,
               castToInt(x1), castToInt(y1), castToInt(x2), castToInt(y2));
     if (to_backup(actual_window) != 0) {
@@ -1587,6 +1714,10 @@ void drwPLine (const_winType actual_window,
   { /* drwPLine */
     logFunction(printf("drwPLine(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x1, y1, x2, y2, col););
+    if (memory_pixmaps) {
+      memPLine(actual_window, x1, y1, x2, y2, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XDrawLine(mydisplay, to_window(actual_window), mygc,
               castToInt(x1), castToInt(y1), castToInt(x2), castToInt(y2));
@@ -1605,6 +1736,9 @@ winType drwNewPixmap (intType width, intType height)
 
   /* drwNewPixmap */
     logFunction(printf("drwNewPixmap(" FMT_D ", " FMT_D ")\n", width, height););
+    if (memory_pixmaps) {
+      return memNewPixmap(width, height);
+    } /* if */
     if (unlikely(!inIntRange(width) || !inIntRange(height) ||
                  width < 1 || height < 1)) {
       raise_error(RANGE_ERROR);
@@ -1650,6 +1784,9 @@ winType drwNewBitmap (const_winType actual_window, intType width, intType height
 
   /* drwNewBitmap */
     logFunction(printf("drwNewBitmap(" FMT_D ", " FMT_D ")\n", width, height););
+    if (memory_pixmaps) {
+      return memNewPixmap(width, height);
+    } /* if */
     if (unlikely(width < 1 || height < 1)) {
       raise_error(RANGE_ERROR);
       pixmap = NULL;
@@ -1936,6 +2073,10 @@ winType drwOpenSubWindow (const_winType parent_window, intType xPos, intType yPo
 void drwSetCloseAction (winType actual_window, intType closeAction)
 
   { /* drwSetCloseAction */
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     if (closeAction < 0 || closeAction > 2) {
       raise_error(RANGE_ERROR);
     } else {
@@ -1956,6 +2097,10 @@ void drwSetCursorVisible (winType aWindow, boolType visible)
   { /* drwSetCursorVisible */
     logFunction(printf("drwSetCursorVisible(" FMT_U_MEM ", %d)\n",
                        (memSizeType) aWindow, visible););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     if (visible) {
       XUndefineCursor(mydisplay, to_window(aWindow));
     } else {
@@ -1981,6 +2126,10 @@ void drwSetPointerPos (const_winType aWindow, intType xPos, intType yPos)
   /* drwSetPointerPos */
     logFunction(printf("drwSetPointerPos(" FMT_U_MEM ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) aWindow, xPos, yPos););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     if (unlikely(!inIntRange(xPos) || !inIntRange(yPos))) {
       raise_error(RANGE_ERROR);
     } else {
@@ -1999,6 +2148,10 @@ void drwPoint (const_winType actual_window, intType x, intType y)
   { /* drwPoint */
     logFunction(printf("drwPoint(" FMT_U_MEM ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x, y););
+    if (memory_pixmaps) {
+      memPPoint(actual_window, x, y, memory_foreground);
+      return;
+    } /* if */
     XDrawPoint(mydisplay, to_window(actual_window), mygc, castToInt(x), castToInt(y));
     if (to_backup(actual_window) != 0) {
       XDrawPoint(mydisplay, to_backup(actual_window), mygc, castToInt(x), castToInt(y));
@@ -2012,6 +2165,10 @@ void drwPPoint (const_winType actual_window, intType x, intType y, intType col)
   { /* drwPPoint */
     logFunction(printf("drwPPoint(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, col););
+    if (memory_pixmaps) {
+      memPPoint(actual_window, x, y, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XDrawPoint(mydisplay, to_window(actual_window), mygc, castToInt(x), castToInt(y));
     if (to_backup(actual_window) != 0) {
@@ -2128,6 +2285,50 @@ intType drwLngPointList (bstriType point_list)
 
 
 
+/**
+ *  Draw a point list into a memory pixmap.
+ *  The points of 'point_list' are relative to the previous point
+ *  (CoordModePrevious). The first point is relative to (x, y).
+ */
+static void memDrawPolyLine (const_winType actual_pixmap,
+    intType x, intType y, const_bstriType point_list, intType col,
+    boolType filled)
+
+  {
+    const XPoint *points;
+    memSizeType numPoints;
+    memSizeType pos;
+    intType *absPoints;
+
+  /* memDrawPolyLine */
+    numPoints = point_list->size / sizeof(XPoint);
+    if (unlikely(!inShortRange(x) || !inShortRange(y))) {
+      raise_error(RANGE_ERROR);
+    } else if (numPoints != 0) {
+      if (unlikely(numPoints > MAX_MEMSIZETYPE / (2 * sizeof(intType)) ||
+                   (absPoints = (intType *) malloc(
+                    numPoints * 2 * sizeof(intType))) == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        points = (const XPoint *) point_list->mem;
+        for (pos = 0; pos < numPoints; pos++) {
+          x += (intType) points[pos].x;
+          y += (intType) points[pos].y;
+          absPoints[pos << 1] = x;
+          absPoints[(pos << 1) + 1] = y;
+        } /* for */
+        if (filled) {
+          memFPolyLine(actual_pixmap, absPoints, numPoints, col);
+        } else {
+          memPolyLine(actual_pixmap, absPoints, numPoints, col);
+        } /* if */
+        free(absPoints);
+      } /* if */
+    } /* if */
+  } /* memDrawPolyLine */
+
+
+
 void drwPolyLine (const_winType actual_window,
     intType x, intType y, bstriType point_list, intType col)
 
@@ -2139,6 +2340,10 @@ void drwPolyLine (const_winType actual_window,
   /* drwPolyLine */
     logFunction(printf("drwPolyLine(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_U_MEM ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, (memSizeType) point_list, col););
+    if (memory_pixmaps) {
+      memDrawPolyLine(actual_window, x, y, point_list, col, FALSE);
+      return;
+    } /* if */
     if (unlikely(!inShortRange(x) || !inShortRange(y))) {
       raise_error(RANGE_ERROR);
     } else {
@@ -2169,6 +2374,10 @@ void drwFPolyLine (const_winType actual_window,
   /* drwFPolyLine */
     logFunction(printf("drwFPolyLine(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_U_MEM ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, (memSizeType) point_list, col););
+    if (memory_pixmaps) {
+      memDrawPolyLine(actual_window, x, y, point_list, col, TRUE);
+      return;
+    } /* if */
     if (unlikely(!inShortRange(x) || !inShortRange(y))) {
       raise_error(RANGE_ERROR);
     } else {
@@ -2198,6 +2407,10 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest,
   { /* drwPut */
     logFunction(printf("drwPut(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_U_MEM ")\n",
                        (memSizeType) destWindow, xDest, yDest, (memSizeType) pixmap););
+    if (memory_pixmaps) {
+      memPut(destWindow, xDest, yDest, pixmap);
+      return;
+    } /* if */
     /* printf("destWindow=%lu, pixmap=%lu\n", to_window(destWindow),
         pixmap != NULL ? to_window(pixmap) : NULL); */
     if (unlikely(!inIntRange(xDest) || !inIntRange(yDest))) {
@@ -2238,6 +2451,10 @@ void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
                        FMT_D ", " FMT_D ", " FMT_U_MEM")\n",
                        (memSizeType) destWindow, xDest, yDest,
                        width, height, (memSizeType) pixmap););
+    if (memory_pixmaps) {
+      memPutScaled(destWindow, xDest, yDest, width, height, pixmap);
+      return;
+    } /* if */
     if (unlikely(!inIntRange(xDest) || !inIntRange(yDest) ||
                  !inIntRange(width) || width < 0 ||
                  !inIntRange(height) || height < 0)) {
@@ -2291,6 +2508,10 @@ void drwRect (const_winType actual_window,
   { /* drwRect */
     logFunction(printf("drwRect(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, x, y, width, height););
+    if (memory_pixmaps) {
+      memPRect(actual_window, x, y, width, height, memory_foreground);
+      return;
+    } /* if */
     XFillRectangle(mydisplay, to_window(actual_window), mygc, castToInt(x), castToInt(y),
         (unsigned) width, (unsigned) height);
     if (to_backup(actual_window) != 0) {
@@ -2307,6 +2528,10 @@ void drwPRect (const_winType actual_window,
   { /* drwPRect */
     logFunction(printf("drwPRect(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, width, height, col););
+    if (memory_pixmaps) {
+      memPRect(actual_window, x, y, width, height, col);
+      return;
+    } /* if */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
     XFillRectangle(mydisplay, to_window(actual_window), mygc, castToInt(x), castToInt(y),
         (unsigned) width, (unsigned) height);
@@ -2339,6 +2564,9 @@ intType drwRgbColor (intType redLight, intType greenLight, intType blueLight)
   /* drwRgbColor */
     logFunction(printf("drwRgbColor(" FMT_D ", " FMT_D ", " FMT_D ")\n",
                        redLight, greenLight, blueLight););
+    if (memory_pixmaps) {
+      return memRgbColor(redLight, greenLight, blueLight);
+    } /* if */
 #ifdef rgbToPixel
     if (useRgbToPixel) {
       logFunction(printf("drwRgbColor(" FMT_D ", " FMT_D ", " FMT_D ") --> " F_X(08) "\n",
@@ -2579,6 +2807,10 @@ void drwPixelToRgb (intType col, intType *redLight, intType *greenLight, intType
     XColor color;
 
   /* drwPixelToRgb */
+    if (memory_pixmaps) {
+      memPixelToRgb(col, redLight, greenLight, blueLight);
+      return;
+    } /* if */
     if (default_visual->c_class == TrueColor) {
       *redLight   = (intType)(((unsigned long) col & default_visual->red_mask)   << rshift_red   >> lshift_red);
       *greenLight = (intType)(((unsigned long) col & default_visual->green_mask) << rshift_green >> lshift_green);
@@ -2600,6 +2832,9 @@ void drwPixelToRgb (intType col, intType *redLight, intType *greenLight, intType
 void drwBackground (intType col)
 
   { /* drwBackground */
+    if (memory_pixmaps) {
+      return;
+    } /* if */
 /*  printf("set color = %ld\n", (long) col); */
     XSetBackground(mydisplay, mygc, (unsigned long) col);
   } /* drwBackground */
@@ -2609,6 +2844,10 @@ void drwBackground (intType col)
 void drwColor (intType col)
 
   { /* drwColor */
+    if (memory_pixmaps) {
+      memory_foreground = col;
+      return;
+    } /* if */
 /*  printf("set color = %ld\n", (long) col); */
     XSetForeground(mydisplay, mygc, (unsigned long) col);
   } /* drwColor */
@@ -2629,6 +2868,11 @@ intType drwScreenHeight (void)
 
   /* drwScreenHeight */
     logFunction(printf("drwScreenHeight()\n"););
+    if (memory_pixmaps) {
+      logError(printf("drwScreenHeight: There is no screen.\n"););
+      raise_error(GRAPHIC_ERROR);
+      return 0;
+    } /* if */
     if (!init_called) {
       drawInit();
     } /* if */
@@ -2657,6 +2901,11 @@ intType drwScreenWidth (void)
 
   /* drwScreenWidth */
     logFunction(printf("drwScreenWidth()\n"););
+    if (memory_pixmaps) {
+      logError(printf("drwScreenWidth: There is no screen.\n"););
+      raise_error(GRAPHIC_ERROR);
+      return 0;
+    } /* if */
     if (!init_called) {
       drawInit();
     } /* if */
@@ -2676,6 +2925,10 @@ void drwSetContent (const_winType actual_window, const_winType pixmap)
   { /* drwSetContent */
     logFunction(printf("drwSetContent(" FMT_U_MEM ", " FMT_U_MEM ")\n",
                        (memSizeType) actual_window, (memSizeType) pixmap););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     if (pixmap != NULL) {
 #ifdef WITH_XSHAPE_EXTENSION
       if (to_clip_mask(pixmap) != 0) {
@@ -2709,6 +2962,10 @@ void drwSetPos (const_winType actual_window, intType xPos, intType yPos)
   { /* drwSetPos */
     logFunction(printf("drwSetPos(" FMT_U_MEM ", " FMT_D ", " FMT_D ")\n",
                        (memSizeType) actual_window, xPos, yPos););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     XMoveWindow(mydisplay, to_window(actual_window), castToInt(xPos), castToInt(yPos));
     /* printf("end drwSetPos(%lu, %ld, %ld)\n",
         to_window(actual_window), xPos, yPos); */
@@ -2729,6 +2986,10 @@ void drwSetTransparentColor (winType pixmap, intType col)
                        (memSizeType) pixmap, col);
                 printf("pixmap=" FMT_U_MEM "\n",
                        pixmap != NULL ? to_window(pixmap) : (memSizeType) 0););
+    if (memory_pixmaps) {
+      memSetTransparentColor(pixmap, col);
+      return;
+    } /* if */
     /* A pixmap value of NULL or a pixmap with a window of 0 */
     /* is used to describe an empty pixmap. In this case     */
     /* nothing should be done.                               */
@@ -2785,6 +3046,10 @@ void drwSetWindowName (winType aWindow, const const_striType windowName)
     logFunction(printf("drwSetWindowName(" FMT_U_MEM ", \"%s\")\n",
                        (memSizeType) aWindow,
                        striAsUnquotedCStri(windowName)););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     winName = stri_to_cstri8(windowName, &err_info);
     if (unlikely(winName == NULL)) {
       raise_error(err_info);
@@ -2815,6 +3080,11 @@ void drwText (const_winType actual_window, intType x, intType y,
   /* drwText */
     logFunction(printf("drwText(" FMT_U_MEM ", " FMT_D ", " FMT_D ", ...)\n",
                        (memSizeType) actual_window, x, y););
+    if (memory_pixmaps) {
+      logError(printf("drwText: No font available for memory pixmaps.\n"););
+      raise_error(GRAPHIC_ERROR);
+      return;
+    } /* if */
     if (unlikely(!inIntRange(x) || !inIntRange(y) ||
                  stri->size >= (unsigned int) INT_MAX)) {
       raise_error(RANGE_ERROR);
@@ -2857,6 +3127,10 @@ void drwToBottom (const_winType actual_window)
   { /* drwToBottom */
     logFunction(printf("drwToBottom(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     XLowerWindow(mydisplay, to_window(actual_window));
     logFunction(printf("drwToBottom(" FMT_U_MEM ") -->\n",
                        (memSizeType) actual_window););
@@ -2872,6 +3146,10 @@ void drwToTop (const_winType actual_window)
   { /* drwToTop */
     logFunction(printf("drwToTop(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return;
+    } /* if */
     XRaiseWindow(mydisplay, to_window(actual_window));
     logFunction(printf("drwToTop(" FMT_U_MEM ") -->\n",
                        (memSizeType) actual_window););
@@ -2894,6 +3172,9 @@ intType drwWidth (const_winType actual_window)
     unsigned int depth;
 
   /* drwWidth */
+    if (memory_pixmaps) {
+      return memWidth(actual_window);
+    } /* if */
     /* printf("drwWidth(" FMT_U_MEM "), usage=" FMT_U "\n",
        actual_window, actual_window != 0 ? actual_window->usage_count: 0); */
     if (is_pixmap(actual_window)) {
@@ -2933,6 +3214,10 @@ intType drwXPos (const_winType actual_window)
   /* drwXPos */
     logFunction(printf("drwXPos(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
     window = to_window(actual_window);
     if (is_pixmap(actual_window)) {
       raise_error(RANGE_ERROR);
@@ -2983,6 +3268,10 @@ intType drwYPos (const_winType actual_window)
   /* drwYPos */
     logFunction(printf("drwYPos(" FMT_U_MEM ")\n",
                        (memSizeType) actual_window););
+    if (memory_pixmaps) {
+      raise_error(RANGE_ERROR);
+      return 0;
+    } /* if */
     window = to_window(actual_window);
     if (is_pixmap(actual_window)) {
       raise_error(RANGE_ERROR);
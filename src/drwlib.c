@@ -44,6 +44,7 @@
 #include "objutl.h"
 #include "traceutl.h"
 #include "runerr.h"
+#include "arrutl.h"
 #include "bst_rtl.h"
 #include "drw_rtl.h"
 #include "gkb_rtl.h"
@@ -310,6 +311,28 @@ objectType drw_background (listType arguments)
 
 
 
+/**
+ *  Blend 'pixmap' with the opacity 'alpha' into 'destWindow'.
+ *  @exception RANGE_ERROR If 'alpha' is not in the range 0 to 255.
+ */
+objectType drw_blend (listType arguments)
+
+  { /* drw_blend */
+    isit_win(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_win(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    drwBlend(take_win(arg_1(arguments)),
+        take_int(arg_2(arguments)),
+        take_int(arg_3(arguments)),
+        take_win(arg_4(arguments)),
+        take_int(arg_5(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* drw_blend */
+
+
+
 /**
  *  Determine the border widths of a window in pixels.
  *  These are the widths of the window decorations in the succession
@@ -838,6 +861,98 @@ objectType drw_get_pixel_array (listType arguments)
 
 
 
+/**
+ *  Convert reconstructed PNG scanlines to an array of pixel lines.
+ *  The scanlines in pixelData/arg_1 start at startIndex/arg_2.
+ *  Every scanline starts with a filter type byte, which is ignored.
+ *  @return an array of height/arg_4 lines with width/arg_3 pixels each.
+ *  @exception RANGE_ERROR If a parameter is out of range, if pixelData
+ *             is too short or if a palette index is not in the palette.
+ */
+objectType drw_get_pixel_array_from_png (listType arguments)
+
+  {
+    rtlArrayType palette;
+    rtlArrayType rtlImage;
+    memSizeType height;
+    memSizeType width;
+    memSizeType yPos;
+    memSizeType xPos;
+    rtlArrayType rtlLine;
+    arrayType imageLine;
+    arrayType imageArray;
+    objectType result;
+
+  /* drw_get_pixel_array_from_png */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_array(arg_7(arguments));
+    palette = gen_rtl_array(take_array(arg_7(arguments)));
+    if (unlikely(palette == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } /* if */
+    rtlImage = drwGetPixelArrayFromPng(take_stri(arg_1(arguments)),
+                                       take_int(arg_2(arguments)),
+                                       take_int(arg_3(arguments)),
+                                       take_int(arg_4(arguments)),
+                                       take_int(arg_5(arguments)),
+                                       take_int(arg_6(arguments)),
+                                       palette);
+    FREE_RTL_ARRAY(palette, ARRAY_LENGTH(palette));
+    if (unlikely(rtlImage == NULL)) {
+      /* An exception has already been raised. */
+      result = NULL;
+    } else {
+      height = (memSizeType) take_int(arg_4(arguments));
+      width = (memSizeType) take_int(arg_3(arguments));
+      if (likely(ALLOC_ARRAY(imageArray, height))) {
+        imageArray->min_position = 1;
+        imageArray->max_position = (intType) height;
+        for (yPos = 0; yPos < height; yPos++) {
+          if (likely(ALLOC_ARRAY(imageLine, width))) {
+            imageLine->min_position = 1;
+            imageLine->max_position = (intType) width;
+            rtlLine = rtlImage->arr[yPos].value.arrayValue;
+            for (xPos = 0; xPos < width; xPos++) {
+              imageLine->arr[xPos].type_of = take_type(SYS_INT_TYPE);
+              imageLine->arr[xPos].descriptor.property = NULL;
+              imageLine->arr[xPos].value.intValue = rtlLine->arr[xPos].value.intValue;
+              INIT_CATEGORY_OF_VAR(&imageLine->arr[xPos], INTOBJECT);
+            } /* for */
+            imageArray->arr[yPos].type_of = NULL;
+            imageArray->arr[yPos].descriptor.property = NULL;
+            imageArray->arr[yPos].value.arrayValue = imageLine;
+            INIT_CATEGORY_OF_VAR(&imageArray->arr[yPos], ARRAYOBJECT);
+          } else {
+            while (yPos >= 1) {
+              yPos--;
+              FREE_ARRAY(imageArray->arr[yPos].value.arrayValue, width);
+            } /* while */
+            FREE_ARRAY(imageArray, height);
+            imageArray = NULL;
+            yPos = height; /* leave for-loop */
+          } /* if */
+        } /* for */
+      } /* if */
+      for (yPos = 0; yPos < height; yPos++) {
+        FREE_RTL_ARRAY(rtlImage->arr[yPos].value.arrayValue, width);
+      } /* for */
+      FREE_RTL_ARRAY(rtlImage, height);
+      if (unlikely(imageArray == NULL)) {
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        result = bld_array_temp(imageArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* drw_get_pixel_array_from_png */
+
+
+
 objectType drw_get_pixel_data (listType arguments)
 
   {
@@ -1560,6 +1675,28 @@ objectType drw_rect (listType arguments)
 
 
 
+/**
+ *  Create a new pixmap with 'source' scaled to 'width' and 'height'.
+ *  @return the resampled pixmap.
+ *  @exception RANGE_ERROR If 'width' or 'height' are less than 1,
+ *             if 'source' is empty or if 'filter' is illegal.
+ */
+objectType drw_resample (listType arguments)
+
+  { /* drw_resample */
+    isit_win(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    return bld_win_temp(
+        drwResample(take_win(arg_1(arguments)),
+                    take_int(arg_2(arguments)),
+                    take_int(arg_3(arguments)),
+                    take_int(arg_4(arguments))));
+  } /* drw_resample */
+
+
+
 objectType drw_rgbcol (listType arguments)
 
   { /* drw_rgbcol */
@@ -1578,6 +1715,24 @@ objectType drw_rot (listType arguments)
 
 
 
+/**
+ *  Create a new pixmap with 'source' rotated clockwise by 90 degrees
+ *  times 'quarterTurns'.
+ *  @return the rotated pixmap.
+ *  @exception RANGE_ERROR If 'source' is empty.
+ */
+objectType drw_rotate (listType arguments)
+
+  { /* drw_rotate */
+    isit_win(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_win_temp(
+        drwRotate(take_win(arg_1(arguments)),
+                  take_int(arg_2(arguments))));
+  } /* drw_rotate */
+
+
+
 objectType drw_scale (listType arguments)
 
   { /* drw_scale */
@@ -1648,6 +1803,135 @@ objectType drw_set_cursor_visible (listType arguments)
 
 
 
+/**
+ *  Convert a JPEG minimum coded unit (MCU) to pixels and write them
+ *  into the image/arg_1. The MCU consists of the luma blocks luma/arg_2
+ *  and the chroma blocks chromaBlue/arg_3 and chromaRed/arg_4. For
+ *  grayscale images the chroma blocks are empty arrays. The blocks
+ *  have been transformed with an inverse DCT of blockSize/arg_7.
+ *  The MCU has horizontal/arg_5 * vertical/arg_6 luma blocks and
+ *  its upper left corner is at mcuTopLine/arg_8 and mcuLeftColumn/arg_9.
+ *  Pixels outside of the image are ignored.
+ *  @exception RANGE_ERROR If a parameter is out of range or if a
+ *             block has less than 64 elements.
+ */
+objectType drw_set_jpeg_mcu_pixels (listType arguments)
+
+  {
+    objectType image_variable;
+    arrayType image;
+    arrayType luma;
+    arrayType chromaBlue;
+    arrayType chromaRed;
+    arrayType lumaArray;
+    arrayType imageLine;
+    intType horizontal;
+    intType vertical;
+    intType blockSize;
+    intType mcuTopLine;
+    intType mcuLeftColumn;
+    intType lumaData[JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR][64];
+    const intType *lumaBlock[JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR];
+    intType chromaBlueData[64];
+    intType chromaRedData[64];
+    intType pixels[64 * JPEG_MAX_SAMPLING_FACTOR * JPEG_MAX_SAMPLING_FACTOR];
+    boolType grayscale;
+    memSizeType numLuma;
+    memSizeType blockNum;
+    memSizeType mcuWidth;
+    memSizeType mcuHeight;
+    memSizeType yPos;
+    memSizeType xPos;
+    memSizeType columns;
+
+  /* drw_set_jpeg_mcu_pixels */
+    image_variable = arg_1(arguments);
+    isit_array(image_variable);
+    is_variable(image_variable);
+    isit_array(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    isit_array(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    isit_int(arg_8(arguments));
+    isit_int(arg_9(arguments));
+    image = take_array(image_variable);
+    luma = take_array(arg_2(arguments));
+    chromaBlue = take_array(arg_3(arguments));
+    chromaRed = take_array(arg_4(arguments));
+    horizontal = take_int(arg_5(arguments));
+    vertical = take_int(arg_6(arguments));
+    blockSize = take_int(arg_7(arguments));
+    mcuTopLine = take_int(arg_8(arguments));
+    mcuLeftColumn = take_int(arg_9(arguments));
+    grayscale = arraySize(chromaBlue) == 0 && arraySize(chromaRed) == 0;
+    if (unlikely(horizontal < 1 || horizontal > JPEG_MAX_SAMPLING_FACTOR ||
+                 vertical < 1 || vertical > JPEG_MAX_SAMPLING_FACTOR ||
+                 (blockSize != 8 && blockSize != 4 &&
+                  blockSize != 2 && blockSize != 1) ||
+                 mcuTopLine < image->min_position ||
+                 (!grayscale && (arraySize(chromaBlue) < 64 ||
+                                 arraySize(chromaRed) < 64)) ||
+                 arraySize(luma) < (memSizeType) (horizontal * vertical))) {
+      logError(printf("drw_set_jpeg_mcu_pixels(arr1, arr2 (size=" FMT_U_MEM
+                      "), arr3, arr4, " FMT_D ", " FMT_D ", " FMT_D ", "
+                      FMT_D ", " FMT_D "): Illegal parameter.\n",
+                      arraySize(luma), horizontal, vertical, blockSize,
+                      mcuTopLine, mcuLeftColumn););
+      return raise_exception(SYS_RNG_EXCEPTION);
+    } /* if */
+    numLuma = (memSizeType) (horizontal * vertical);
+    for (blockNum = 0; blockNum < numLuma; blockNum++) {
+      isit_array(&luma->arr[blockNum]);
+      lumaArray = take_array(&luma->arr[blockNum]);
+      if (unlikely(arraySize(lumaArray) < 64)) {
+        logError(printf("drw_set_jpeg_mcu_pixels: Luma block with less "
+                        "than 64 elements.\n"););
+        return raise_exception(SYS_RNG_EXCEPTION);
+      } /* if */
+      for (xPos = 0; xPos < 64; xPos++) {
+        lumaData[blockNum][xPos] = lumaArray->arr[xPos].value.intValue;
+      } /* for */
+      lumaBlock[blockNum] = lumaData[blockNum];
+    } /* for */
+    if (!grayscale) {
+      for (xPos = 0; xPos < 64; xPos++) {
+        chromaBlueData[xPos] = chromaBlue->arr[xPos].value.intValue;
+        chromaRedData[xPos] = chromaRed->arr[xPos].value.intValue;
+      } /* for */
+    } /* if */
+    drwJpegMcuToPixels(pixels, lumaBlock,
+                       grayscale ? NULL : chromaBlueData,
+                       grayscale ? NULL : chromaRedData,
+                       (unsigned int) horizontal, (unsigned int) vertical,
+                       (unsigned int) blockSize);
+    mcuWidth = (memSizeType) (horizontal * blockSize);
+    mcuHeight = (memSizeType) (vertical * blockSize);
+    for (yPos = 0; yPos < mcuHeight &&
+         mcuTopLine <= image->max_position - (intType) yPos; yPos++) {
+      imageLine = take_array(&image->arr[(memSizeType) (mcuTopLine -
+                                         image->min_position) + yPos]);
+      if (unlikely(mcuLeftColumn < imageLine->min_position)) {
+        logError(printf("drw_set_jpeg_mcu_pixels: Column " FMT_D
+                        " outside of the image.\n", mcuLeftColumn););
+        return raise_exception(SYS_RNG_EXCEPTION);
+      } else if (mcuLeftColumn <= imageLine->max_position) {
+        columns = (memSizeType) (imageLine->max_position - mcuLeftColumn) + 1;
+        if (columns > mcuWidth) {
+          columns = mcuWidth;
+        } /* if */
+        for (xPos = 0; xPos < columns; xPos++) {
+          imageLine->arr[(memSizeType) (mcuLeftColumn - imageLine->min_position) +
+                         xPos].value.intValue = pixels[yPos * mcuWidth + xPos];
+        } /* for */
+      } /* if */
+    } /* for */
+    return SYS_EMPTY_OBJECT;
+  } /* drw_set_jpeg_mcu_pixels */
+
+
+
 /**
  *  Set the pointer x/arg_2 and y/arg_3 position relative to aWindow/arg_1.
  *  The point of origin is the top left corner of the drawing area
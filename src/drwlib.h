@@ -39,6 +39,7 @@ objectType gkb_word_read                 (listType arguments);
 objectType drw_arc                       (listType arguments);
 objectType drw_arc2                      (listType arguments);
 objectType drw_background                (listType arguments);
+objectType drw_blend                     (listType arguments);
 objectType drw_border                    (listType arguments);
 objectType drw_capture                   (listType arguments);
 objectType drw_circle                    (listType arguments);
@@ -62,6 +63,7 @@ objectType drw_gen_point_list            (listType arguments);
 objectType drw_get_image_pixel           (listType arguments);
 objectType drw_get_pixel                 (listType arguments);
 objectType drw_get_pixel_array           (listType arguments);
+objectType drw_get_pixel_array_from_png  (listType arguments);
 objectType drw_get_pixel_data            (listType arguments);
 objectType drw_get_pixel_data_from_array (listType arguments);
 objectType drw_get_pixmap                (listType arguments);
@@ -91,14 +93,17 @@ objectType drw_prect                     (listType arguments);
 objectType drw_put                       (listType arguments);
 objectType drw_put_scaled                (listType arguments);
 objectType drw_rect                      (listType arguments);
+objectType drw_resample                  (listType arguments);
 objectType drw_rgbcol                    (listType arguments);
 objectType drw_rot                       (listType arguments);
+objectType drw_rotate                    (listType arguments);
 objectType drw_screen_height             (listType arguments);
 objectType drw_screen_width              (listType arguments);
 objectType drw_scale                     (listType arguments);
 objectType drw_set_close_action          (listType arguments);
 objectType drw_set_content               (listType arguments);
 objectType drw_set_cursor_visible        (listType arguments);
+objectType drw_set_jpeg_mcu_pixels       (listType arguments);
 objectType drw_set_pointer_pos           (listType arguments);
 objectType drw_set_pos                   (listType arguments);
 objectType drw_set_transparent_color     (listType arguments);
@@ -0,0 +1,1180 @@
+/********************************************************************/
+/*                                                                  */
+/*  ecc_rtl.c     Primitive actions for elliptic curves.            */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/ecc_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for elliptic curves.                 */
+/*                                                                  */
+/*  The curves secp256r1 and secp384r1 and the X25519 function of   */
+/*  Curve25519 are supported. Field elements have a fixed number of */
+/*  limbs and are kept in Montgomery form. Points of the curves     */
+/*  secp256r1 and secp384r1 use projective coordinates and the      */
+/*  complete addition formulas of Renes, Costello and Batina. So    */
+/*  there are no special cases for the neutral element or for       */
+/*  doubling. A scalar multiplication processes all bits of the     */
+/*  scalar and selects table entries by scanning the whole table.   */
+/*  Therefore the computations with secret scalars run in constant  */
+/*  time. For the base point a table with all multiples of the form */
+/*  j * 16 ** i is computed once.                                   */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "ecc_rtl.h"
+
+
+#ifdef INT128TYPE
+typedef uint64Type  limbType;
+typedef uint128Type doubleLimbType;
+#define LIMB_BITS 64
+#else
+typedef uint32Type  limbType;
+typedef uint64Type  doubleLimbType;
+#define LIMB_BITS 32
+#endif
+
+#define LIMB_BYTES      (LIMB_BITS / 8)
+#define MAX_FIELD_BYTES 48
+#define MAX_LIMBS       (MAX_FIELD_BYTES / LIMB_BYTES)
+#define WINDOW_BITS     4
+#define WINDOW_SIZE     (1 << WINDOW_BITS)
+#define X25519_BYTES    32
+
+#define ECC_SECP256R1 1
+#define ECC_SECP384R1 2
+
+/**
+ *  Prime field with elements in Montgomery form.
+ *  With R = 2 ** (LIMB_BITS * limbs) an element a is stored as a * R mod p.
+ */
+typedef struct {
+    unsigned int limbs;
+    unsigned int bytes;
+    limbType p[MAX_LIMBS];
+    limbType pMinus2[MAX_LIMBS];
+    limbType n0;               /* -p ** -1 mod 2 ** LIMB_BITS */
+    limbType rr[MAX_LIMBS];    /* R ** 2 mod p */
+    limbType one[MAX_LIMBS];   /* R mod p, the number 1 in Montgomery form */
+  } fieldRecord, *fieldType;
+
+typedef const fieldRecord *const_fieldType;
+
+/**
+ *  Point in projective coordinates (x = X / Z, y = Y / Z).
+ *  The neutral element is (0 : 1 : 0).
+ */
+typedef struct {
+    limbType x[MAX_LIMBS];
+    limbType y[MAX_LIMBS];
+    limbType z[MAX_LIMBS];
+  } pointRecord, *pointType;
+
+typedef const pointRecord *const_pointType;
+
+/**
+ *  Short Weierstrass curve y ** 2 = x ** 3 - 3 * x + b (mod p).
+ */
+typedef struct {
+    const char *pHex;
+    const char *bHex;
+    const char *gxHex;
+    const char *gyHex;
+    boolType initialized;
+    fieldRecord field;
+    limbType b[MAX_LIMBS];
+    ucharType gBytes[2 * MAX_FIELD_BYTES];
+    pointRecord g;
+    pointType baseTable;       /* baseTable[i * WINDOW_SIZE + j] = j * 16 ** i * g */
+  } curveRecord, *curveType;
+
+typedef const curveRecord *const_curveType;
+
+static curveRecord secp256r1 = {
+    "ffffffff00000001000000000000000000000000ffffffffffffffffffffffff",
+    "5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b",
+    "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+    "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+    FALSE
+  };
+
+static curveRecord secp384r1 = {
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe"
+    "ffffffff0000000000000000ffffffff",
+    "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875a"
+    "c656398d8a2ed19d2a85c8edd3ec2aef",
+    "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a38"
+    "5502f25dbf55296c3a545e3872760ab7",
+    "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c0"
+    "0a60b1ce1d7e819d7a431d7c90ea0e5f",
+    FALSE
+  };
+
+static const char curve25519PHex[] =
+    "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed";
+
+static fieldRecord curve25519Field;
+static boolType curve25519Initialized = FALSE;
+static limbType curve25519A24[MAX_LIMBS];
+
+
+
+/**
+ *  Convert a hexadecimal literal to a big-endian byte array.
+ *  @return the number of bytes written to dest.
+ */
+static unsigned int bytesFromHex (ucharType *dest, const char *hex)
+
+  {
+    unsigned int length;
+    unsigned int idx;
+    unsigned int digit;
+    unsigned int nibble;
+
+  /* bytesFromHex */
+    length = (unsigned int) strlen(hex) / 2;
+    for (idx = 0; idx < 2 * length; idx++) {
+      digit = (unsigned char) hex[idx];
+      if (digit >= 'a') {
+        nibble = digit - 'a' + 10;
+      } else {
+        nibble = digit - '0';
+      } /* if */
+      if ((idx & 1) == 0) {
+        dest[idx / 2] = (ucharType) (nibble << 4);
+      } else {
+        dest[idx / 2] |= (ucharType) nibble;
+      } /* if */
+    } /* for */
+    return length;
+  } /* bytesFromHex */
+
+
+
+/**
+ *  Convert a big-endian byte array with field->bytes bytes to limbs.
+ *  The least significant limb is stored first.
+ */
+static void limbsFromBytes (const_fieldType field, limbType *limbs,
+    const ucharType *bytes)
+
+  {
+    unsigned int idx;
+    unsigned int pos;
+
+  /* limbsFromBytes */
+    memset(limbs, 0, MAX_LIMBS * sizeof(limbType));
+    for (idx = 0; idx < field->bytes; idx++) {
+      pos = field->bytes - 1 - idx;
+      limbs[idx / LIMB_BYTES] |= (limbType) bytes[pos] << (8 * (idx % LIMB_BYTES));
+    } /* for */
+  } /* limbsFromBytes */
+
+
+
+static void limbsToBytes (const_fieldType field, ucharType *bytes,
+    const limbType *limbs)
+
+  {
+    unsigned int idx;
+    unsigned int pos;
+
+  /* limbsToBytes */
+    for (idx = 0; idx < field->bytes; idx++) {
+      pos = field->bytes - 1 - idx;
+      bytes[pos] = (ucharType) (limbs[idx / LIMB_BYTES] >> (8 * (idx % LIMB_BYTES)));
+    } /* for */
+  } /* limbsToBytes */
+
+
+
+/**
+ *  Determine if the number in limbs is less than p.
+ *  This is only used for public values.
+ */
+static boolType limbsLessThanP (const_fieldType field, const limbType *limbs)
+
+  {
+    int idx;
+
+  /* limbsLessThanP */
+    for (idx = (int) field->limbs - 1; idx >= 0; idx--) {
+      if (limbs[idx] != field->p[idx]) {
+        return limbs[idx] < field->p[idx];
+      } /* if */
+    } /* for */
+    return FALSE;
+  } /* limbsLessThanP */
+
+
+
+/**
+ *  Subtract p from (hi, t) if the result is not negative.
+ *  The value (hi, t) must be less than 2 * p.
+ *  The number of limbs is a parameter, such that the loops can be
+ *  unrolled if a constant is used.
+ */
+static inline void fieldReduceOnce (const_fieldType field, limbType *r,
+    const limbType *t, limbType hi, const unsigned int limbs)
+
+  {
+    limbType diff[MAX_LIMBS];
+    doubleLimbType sum;
+    limbType borrow = 0;
+    limbType mask;
+    unsigned int idx;
+
+  /* fieldReduceOnce */
+    for (idx = 0; idx < limbs; idx++) {
+      sum = (doubleLimbType) t[idx] - field->p[idx] - borrow;
+      diff[idx] = (limbType) sum;
+      borrow = (limbType) (sum >> LIMB_BITS) & 1;
+    } /* for */
+    /* Use diff if hi is set or if there was no borrow. */
+    mask = (limbType) 0 - (hi | (borrow ^ 1));
+    for (idx = 0; idx < limbs; idx++) {
+      r[idx] = (diff[idx] & mask) | (t[idx] & ~mask);
+    } /* for */
+  } /* fieldReduceOnce */
+
+
+
+static inline void fieldAddLimbs (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b, const unsigned int limbs)
+
+  {
+    limbType sum[MAX_LIMBS];
+    doubleLimbType acc;
+    limbType carry = 0;
+    unsigned int idx;
+
+  /* fieldAddLimbs */
+    for (idx = 0; idx < limbs; idx++) {
+      acc = (doubleLimbType) a[idx] + b[idx] + carry;
+      sum[idx] = (limbType) acc;
+      carry = (limbType) (acc >> LIMB_BITS);
+    } /* for */
+    fieldReduceOnce(field, r, sum, carry, limbs);
+  } /* fieldAddLimbs */
+
+
+
+static inline void fieldSubLimbs (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b, const unsigned int limbs)
+
+  {
+    doubleLimbType acc;
+    limbType borrow = 0;
+    limbType carry = 0;
+    limbType mask;
+    unsigned int idx;
+
+  /* fieldSubLimbs */
+    for (idx = 0; idx < limbs; idx++) {
+      acc = (doubleLimbType) a[idx] - b[idx] - borrow;
+      r[idx] = (limbType) acc;
+      borrow = (limbType) (acc >> LIMB_BITS) & 1;
+    } /* for */
+    /* Add p if the difference is negative. */
+    mask = (limbType) 0 - borrow;
+    for (idx = 0; idx < limbs; idx++) {
+      acc = (doubleLimbType) r[idx] + (field->p[idx] & mask) + carry;
+      r[idx] = (limbType) acc;
+      carry = (limbType) (acc >> LIMB_BITS);
+    } /* for */
+  } /* fieldSubLimbs */
+
+
+
+/**
+ *  Montgomery multiplication r = a * b / R mod p.
+ *  The operands must be less than p. The result r is less than p.
+ *  The function uses the coarsely integrated operand scanning method.
+ *  It is inlined with a constant number of limbs by fieldMul.
+ */
+static inline void fieldMulLimbs (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b, const unsigned int limbs)
+
+  {
+    limbType t[MAX_LIMBS + 2];
+    doubleLimbType acc;
+    limbType carry;
+    limbType m;
+    unsigned int i;
+    unsigned int j;
+
+  /* fieldMulLimbs */
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < limbs; i++) {
+      carry = 0;
+      for (j = 0; j < limbs; j++) {
+        acc = (doubleLimbType) a[j] * b[i] + t[j] + carry;
+        t[j] = (limbType) acc;
+        carry = (limbType) (acc >> LIMB_BITS);
+      } /* for */
+      acc = (doubleLimbType) t[limbs] + carry;
+      t[limbs] = (limbType) acc;
+      t[limbs + 1] = (limbType) (acc >> LIMB_BITS);
+      m = t[0] * field->n0;
+      acc = (doubleLimbType) m * field->p[0] + t[0];
+      carry = (limbType) (acc >> LIMB_BITS);
+      for (j = 1; j < limbs; j++) {
+        acc = (doubleLimbType) m * field->p[j] + t[j] + carry;
+        t[j - 1] = (limbType) acc;
+        carry = (limbType) (acc >> LIMB_BITS);
+      } /* for */
+      acc = (doubleLimbType) t[limbs] + carry;
+      t[limbs - 1] = (limbType) acc;
+      t[limbs] = t[limbs + 1] + (limbType) (acc >> LIMB_BITS);
+    } /* for */
+    fieldReduceOnce(field, r, t, t[limbs], limbs);
+  } /* fieldMulLimbs */
+
+
+
+static void fieldMul (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b)
+
+  { /* fieldMul */
+    if (field->limbs == 256 / LIMB_BITS) {
+      fieldMulLimbs(field, r, a, b, 256 / LIMB_BITS);
+    } else {
+      fieldMulLimbs(field, r, a, b, 384 / LIMB_BITS);
+    } /* if */
+  } /* fieldMul */
+
+
+
+static void fieldAdd (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b)
+
+  { /* fieldAdd */
+    if (field->limbs == 256 / LIMB_BITS) {
+      fieldAddLimbs(field, r, a, b, 256 / LIMB_BITS);
+    } else {
+      fieldAddLimbs(field, r, a, b, 384 / LIMB_BITS);
+    } /* if */
+  } /* fieldAdd */
+
+
+
+static void fieldSub (const_fieldType field, limbType *r,
+    const limbType *a, const limbType *b)
+
+  { /* fieldSub */
+    if (field->limbs == 256 / LIMB_BITS) {
+      fieldSubLimbs(field, r, a, b, 256 / LIMB_BITS);
+    } else {
+      fieldSubLimbs(field, r, a, b, 384 / LIMB_BITS);
+    } /* if */
+  } /* fieldSub */
+
+
+
+/**
+ *  Compute the inverse r = a ** (p - 2) mod p.
+ *  The exponent is public, so the sequence of operations does not
+ *  depend on a. The inverse of zero is zero.
+ */
+static void fieldInv (const_fieldType field, limbType *r, const limbType *a)
+
+  {
+    limbType result[MAX_LIMBS];
+    int bit;
+
+  /* fieldInv */
+    memcpy(result, field->one, sizeof(result));
+    for (bit = (int) (field->limbs * LIMB_BITS) - 1; bit >= 0; bit--) {
+      fieldMul(field, result, result, result);
+      if ((field->pMinus2[bit / LIMB_BITS] >> (bit % LIMB_BITS)) & 1) {
+        fieldMul(field, result, result, a);
+      } /* if */
+    } /* for */
+    memcpy(r, result, sizeof(result));
+  } /* fieldInv */
+
+
+
+/**
+ *  Return all ones if a is zero and zero otherwise (in constant time).
+ */
+static inline limbType fieldIsZeroMask (const_fieldType field, const limbType *a)
+
+  {
+    limbType bits = 0;
+    unsigned int idx;
+
+  /* fieldIsZeroMask */
+    for (idx = 0; idx < field->limbs; idx++) {
+      bits |= a[idx];
+    } /* for */
+    bits = (bits | ((limbType) 0 - bits)) >> (LIMB_BITS - 1);
+    return bits - 1;
+  } /* fieldIsZeroMask */
+
+
+
+/**
+ *  Convert a number less than p to Montgomery form.
+ */
+static inline void fieldToMontgomery (const_fieldType field, limbType *r,
+    const limbType *a)
+
+  { /* fieldToMontgomery */
+    fieldMul(field, r, a, field->rr);
+  } /* fieldToMontgomery */
+
+
+
+static inline void fieldFromMontgomery (const_fieldType field, limbType *r,
+    const limbType *a)
+
+  {
+    limbType plainOne[MAX_LIMBS];
+
+  /* fieldFromMontgomery */
+    memset(plainOne, 0, sizeof(plainOne));
+    plainOne[0] = 1;
+    fieldMul(field, r, a, plainOne);
+  } /* fieldFromMontgomery */
+
+
+
+static void fieldInit (fieldType field, const char *pHex)
+
+  {
+    ucharType pBytes[MAX_FIELD_BYTES];
+    limbType inverse;
+    limbType borrow;
+    unsigned int idx;
+
+  /* fieldInit */
+    field->bytes = bytesFromHex(pBytes, pHex);
+    field->limbs = (field->bytes + LIMB_BYTES - 1) / LIMB_BYTES;
+    limbsFromBytes(field, field->p, pBytes);
+    /* Newton iteration: Each step doubles the number of correct bits. */
+    inverse = field->p[0];
+    for (idx = 0; idx < 6; idx++) {
+      inverse *= 2 - field->p[0] * inverse;
+    } /* for */
+    field->n0 = (limbType) 0 - inverse;
+    borrow = 2;
+    for (idx = 0; idx < field->limbs; idx++) {
+      field->pMinus2[idx] = field->p[idx] - borrow;
+      borrow = field->p[idx] < borrow;
+    } /* for */
+    /* Compute R ** 2 mod p by doubling 1 (2 * LIMB_BITS * limbs) times. */
+    memset(field->rr, 0, sizeof(field->rr));
+    field->rr[0] = 1;
+    for (idx = 0; idx < 2 * LIMB_BITS * field->limbs; idx++) {
+      fieldAdd(field, field->rr, field->rr, field->rr);
+    } /* for */
+    memset(field->one, 0, sizeof(field->one));
+    field->one[0] = 1;
+    fieldToMontgomery(field, field->one, field->one);
+  } /* fieldInit */
+
+
+
+static inline void setNeutralPoint (const_curveType curve, pointType point)
+
+  { /* setNeutralPoint */
+    memset(point, 0, sizeof(pointRecord));
+    memcpy(point->y, curve->field.one, sizeof(point->y));
+  } /* setNeutralPoint */
+
+
+
+/**
+ *  Complete addition sum = p1 + p2 for curves with a = -3.
+ *  This is algorithm 4 of Renes, Costello and Batina (2016).
+ *  It works for all inputs including the neutral element and p1 = p2.
+ */
+static void pointAdd (const_curveType curve, pointType sum,
+    const_pointType p1, const_pointType p2)
+
+  {
+    const_fieldType field = &curve->field;
+    limbType t0[MAX_LIMBS], t1[MAX_LIMBS], t2[MAX_LIMBS];
+    limbType t3[MAX_LIMBS], t4[MAX_LIMBS];
+    limbType x3[MAX_LIMBS], y3[MAX_LIMBS], z3[MAX_LIMBS];
+
+  /* pointAdd */
+    fieldMul(field, t0, p1->x, p2->x);
+    fieldMul(field, t1, p1->y, p2->y);
+    fieldMul(field, t2, p1->z, p2->z);
+    fieldAdd(field, t3, p1->x, p1->y);
+    fieldAdd(field, t4, p2->x, p2->y);
+    fieldMul(field, t3, t3, t4);
+    fieldAdd(field, t4, t0, t1);
+    fieldSub(field, t3, t3, t4);
+    fieldAdd(field, t4, p1->y, p1->z);
+    fieldAdd(field, x3, p2->y, p2->z);
+    fieldMul(field, t4, t4, x3);
+    fieldAdd(field, x3, t1, t2);
+    fieldSub(field, t4, t4, x3);
+    fieldAdd(field, x3, p1->x, p1->z);
+    fieldAdd(field, y3, p2->x, p2->z);
+    fieldMul(field, x3, x3, y3);
+    fieldAdd(field, y3, t0, t2);
+    fieldSub(field, y3, x3, y3);
+    fieldMul(field, z3, curve->b, t2);
+    fieldSub(field, x3, y3, z3);
+    fieldAdd(field, z3, x3, x3);
+    fieldAdd(field, x3, x3, z3);
+    fieldSub(field, z3, t1, x3);
+    fieldAdd(field, x3, t1, x3);
+    fieldMul(field, y3, curve->b, y3);
+    fieldAdd(field, t1, t2, t2);
+    fieldAdd(field, t2, t1, t2);
+    fieldSub(field, y3, y3, t2);
+    fieldSub(field, y3, y3, t0);
+    fieldAdd(field, t1, y3, y3);
+    fieldAdd(field, y3, t1, y3);
+    fieldAdd(field, t1, t0, t0);
+    fieldAdd(field, t0, t1, t0);
+    fieldSub(field, t0, t0, t2);
+    fieldMul(field, t1, t4, y3);
+    fieldMul(field, t2, t0, y3);
+    fieldMul(field, y3, x3, z3);
+    fieldAdd(field, y3, y3, t2);
+    fieldMul(field, x3, x3, t3);
+    fieldSub(field, x3, x3, t1);
+    fieldMul(field, z3, t4, z3);
+    fieldMul(field, t1, t3, t0);
+    fieldAdd(field, z3, z3, t1);
+    memcpy(sum->x, x3, field->limbs * sizeof(limbType));
+    memcpy(sum->y, y3, field->limbs * sizeof(limbType));
+    memcpy(sum->z, z3, field->limbs * sizeof(limbType));
+  } /* pointAdd */
+
+
+
+/**
+ *  Doubling sum = 2 * point for curves with a = -3.
+ *  This is algorithm 6 of Renes, Costello and Batina (2016).
+ */
+static void pointDouble (const_curveType curve, pointType sum,
+    const_pointType point)
+
+  {
+    const_fieldType field = &curve->field;
+    limbType t0[MAX_LIMBS], t1[MAX_LIMBS], t2[MAX_LIMBS], t3[MAX_LIMBS];
+    limbType x3[MAX_LIMBS], y3[MAX_LIMBS], z3[MAX_LIMBS];
+
+  /* pointDouble */
+    fieldMul(field, t0, point->x, point->x);
+    fieldMul(field, t1, point->y, point->y);
+    fieldMul(field, t2, point->z, point->z);
+    fieldMul(field, t3, point->x, point->y);
+    fieldAdd(field, t3, t3, t3);
+    fieldMul(field, z3, point->x, point->z);
+    fieldAdd(field, z3, z3, z3);
+    fieldMul(field, y3, curve->b, t2);
+    fieldSub(field, y3, y3, z3);
+    fieldAdd(field, x3, y3, y3);
+    fieldAdd(field, y3, x3, y3);
+    fieldSub(field, x3, t1, y3);
+    fieldAdd(field, y3, t1, y3);
+    fieldMul(field, y3, x3, y3);
+    fieldMul(field, x3, x3, t3);
+    fieldAdd(field, t3, t2, t2);
+    fieldAdd(field, t2, t2, t3);
+    fieldMul(field, z3, curve->b, z3);
+    fieldSub(field, z3, z3, t2);
+    fieldSub(field, z3, z3, t0);
+    fieldAdd(field, t3, z3, z3);
+    fieldAdd(field, z3, z3, t3);
+    fieldAdd(field, t3, t0, t0);
+    fieldAdd(field, t0, t3, t0);
+    fieldSub(field, t0, t0, t2);
+    fieldMul(field, t0, t0, z3);
+    fieldAdd(field, y3, y3, t0);
+    fieldMul(field, t0, point->y, point->z);
+    fieldAdd(field, t0, t0, t0);
+    fieldMul(field, z3, t0, z3);
+    fieldSub(field, x3, x3, z3);
+    fieldMul(field, z3, t0, t1);
+    fieldAdd(field, z3, z3, z3);
+    fieldAdd(field, z3, z3, z3);
+    memcpy(sum->x, x3, field->limbs * sizeof(limbType));
+    memcpy(sum->y, y3, field->limbs * sizeof(limbType));
+    memcpy(sum->z, z3, field->limbs * sizeof(limbType));
+  } /* pointDouble */
+
+
+
+/**
+ *  Copy table[index] to point without secret dependent memory access.
+ *  All WINDOW_SIZE entries of the table are read.
+ */
+static void pointSelect (const_curveType curve, pointType point,
+    const_pointType table, unsigned int index)
+
+  {
+    unsigned int limbs = curve->field.limbs;
+    unsigned int entry;
+    unsigned int idx;
+    limbType mask;
+
+  /* pointSelect */
+    memset(point, 0, sizeof(pointRecord));
+    for (entry = 0; entry < WINDOW_SIZE; entry++) {
+      mask = (limbType) 0 - (limbType) (((entry ^ index) - 1) >> (8 * sizeof(unsigned int) - 1));
+      for (idx = 0; idx < limbs; idx++) {
+        point->x[idx] |= table[entry].x[idx] & mask;
+        point->y[idx] |= table[entry].y[idx] & mask;
+        point->z[idx] |= table[entry].z[idx] & mask;
+      } /* for */
+    } /* for */
+  } /* pointSelect */
+
+
+
+static inline unsigned int scalarWindow (const ucharType *scalar,
+    unsigned int scalarBytes, unsigned int window)
+
+  {
+    ucharType byte;
+
+  /* scalarWindow */
+    byte = scalar[scalarBytes - 1 - window / 2];
+    return (window & 1) ? (unsigned int) (byte >> 4) : (unsigned int) (byte & 0xf);
+  } /* scalarWindow */
+
+
+
+/**
+ *  Compute product = scalar * point with a fixed window of 4 bits.
+ *  The scalar is big-endian and has curve->field.bytes bytes.
+ */
+static void pointMult (const_curveType curve, pointType product,
+    const_pointType point, const ucharType *scalar)
+
+  {
+    pointRecord table[WINDOW_SIZE];
+    pointRecord selected;
+    unsigned int scalarBytes = curve->field.bytes;
+    int window;
+    unsigned int idx;
+
+  /* pointMult */
+    setNeutralPoint(curve, &table[0]);
+    memcpy(&table[1], point, sizeof(pointRecord));
+    for (idx = 2; idx < WINDOW_SIZE; idx += 2) {
+      pointDouble(curve, &table[idx], &table[idx / 2]);
+      pointAdd(curve, &table[idx + 1], &table[idx], point);
+    } /* for */
+    setNeutralPoint(curve, product);
+    for (window = (int) (2 * scalarBytes) - 1; window >= 0; window--) {
+      for (idx = 0; idx < WINDOW_BITS; idx++) {
+        pointDouble(curve, product, product);
+      } /* for */
+      pointSelect(curve, &selected, table,
+                  scalarWindow(scalar, scalarBytes, (unsigned int) window));
+      pointAdd(curve, product, product, &selected);
+    } /* for */
+  } /* pointMult */
+
+
+
+/**
+ *  Compute the table with j * 16 ** i * g for all windows i and 0 <= j < 16.
+ *  The table is computed once and kept until the program terminates.
+ *  @return TRUE if the table is available, FALSE otherwise.
+ */
+static boolType initBaseTable (curveType curve)
+
+  {
+    unsigned int windows;
+    unsigned int window;
+    unsigned int idx;
+    pointType row;
+    pointRecord multiple;
+
+  /* initBaseTable */
+    if (curve->baseTable == NULL) {
+      windows = 2 * curve->field.bytes;
+      curve->baseTable = (pointType) malloc(windows * WINDOW_SIZE * sizeof(pointRecord));
+      if (curve->baseTable != NULL) {
+        memcpy(&multiple, &curve->g, sizeof(pointRecord));
+        for (window = 0; window < windows; window++) {
+          row = &curve->baseTable[window * WINDOW_SIZE];
+          setNeutralPoint(curve, &row[0]);
+          memcpy(&row[1], &multiple, sizeof(pointRecord));
+          for (idx = 2; idx < WINDOW_SIZE; idx++) {
+            pointAdd(curve, &row[idx], &row[idx - 1], &multiple);
+          } /* for */
+          pointAdd(curve, &multiple, &row[WINDOW_SIZE - 1], &multiple);
+        } /* for */
+      } /* if */
+    } /* if */
+    return curve->baseTable != NULL;
+  } /* initBaseTable */
+
+
+
+/**
+ *  Compute product = scalar * g with the precomputed base point table.
+ *  No doublings are necessary. Every window adds one table entry.
+ */
+static void pointMultBase (const_curveType curve, pointType product,
+    const ucharType *scalar)
+
+  {
+    unsigned int scalarBytes = curve->field.bytes;
+    unsigned int window;
+    pointRecord selected;
+
+  /* pointMultBase */
+    setNeutralPoint(curve, product);
+    for (window = 0; window < 2 * scalarBytes; window++) {
+      pointSelect(curve, &selected, &curve->baseTable[window * WINDOW_SIZE],
+                  scalarWindow(scalar, scalarBytes, window));
+      pointAdd(curve, product, product, &selected);
+    } /* for */
+  } /* pointMultBase */
+
+
+
+static void curveInit (curveType curve)
+
+  {
+    fieldType field;
+    ucharType bytes[MAX_FIELD_BYTES];
+    limbType limbs[MAX_LIMBS];
+
+  /* curveInit */
+    field = &curve->field;
+    fieldInit(field, curve->pHex);
+    bytesFromHex(bytes, curve->bHex);
+    limbsFromBytes(field, limbs, bytes);
+    fieldToMontgomery(field, curve->b, limbs);
+    bytesFromHex(curve->gBytes, curve->gxHex);
+    bytesFromHex(&curve->gBytes[field->bytes], curve->gyHex);
+    limbsFromBytes(field, limbs, curve->gBytes);
+    fieldToMontgomery(field, curve->g.x, limbs);
+    limbsFromBytes(field, limbs, &curve->gBytes[field->bytes]);
+    fieldToMontgomery(field, curve->g.y, limbs);
+    memcpy(curve->g.z, field->one, sizeof(curve->g.z));
+    curve->baseTable = NULL;
+    curve->initialized = TRUE;
+  } /* curveInit */
+
+
+
+static curveType getCurve (intType curveNumber)
+
+  {
+    curveType curve;
+
+  /* getCurve */
+    if (curveNumber == ECC_SECP256R1) {
+      curve = &secp256r1;
+    } else if (curveNumber == ECC_SECP384R1) {
+      curve = &secp384r1;
+    } else {
+      curve = NULL;
+    } /* if */
+    if (curve != NULL && !curve->initialized) {
+      curveInit(curve);
+    } /* if */
+    return curve;
+  } /* getCurve */
+
+
+
+/**
+ *  Convert an encoded point (x and y big-endian) to projective coordinates.
+ *  An empty string is the neutral element.
+ *  @return TRUE if the point is on the curve, FALSE otherwise.
+ */
+static boolType pointFromStri (const_curveType curve, pointType point,
+    boolType *isBasePoint, const const_striType stri)
+
+  {
+    const_fieldType field = &curve->field;
+    ucharType bytes[2 * MAX_FIELD_BYTES];
+    limbType x[MAX_LIMBS];
+    limbType y[MAX_LIMBS];
+    limbType lhs[MAX_LIMBS];
+    limbType rhs[MAX_LIMBS];
+    limbType threeX[MAX_LIMBS];
+    boolType okay;
+
+  /* pointFromStri */
+    *isBasePoint = FALSE;
+    if (stri->size == 0) {
+      setNeutralPoint(curve, point);
+      okay = TRUE;
+    } else if (stri->size != 2 * field->bytes ||
+               memcpy_from_strelem(bytes, stri->mem, stri->size)) {
+      okay = FALSE;
+    } else {
+      limbsFromBytes(field, x, bytes);
+      limbsFromBytes(field, y, &bytes[field->bytes]);
+      if (!limbsLessThanP(field, x) || !limbsLessThanP(field, y)) {
+        okay = FALSE;
+      } else {
+        fieldToMontgomery(field, point->x, x);
+        fieldToMontgomery(field, point->y, y);
+        memcpy(point->z, field->one, sizeof(point->z));
+        /* Check y ** 2 = x ** 3 - 3 * x + b */
+        fieldMul(field, lhs, point->y, point->y);
+        fieldMul(field, rhs, point->x, point->x);
+        fieldMul(field, rhs, rhs, point->x);
+        fieldAdd(field, threeX, point->x, point->x);
+        fieldAdd(field, threeX, threeX, point->x);
+        fieldSub(field, rhs, rhs, threeX);
+        fieldAdd(field, rhs, rhs, curve->b);
+        okay = memcmp(lhs, rhs, field->limbs * sizeof(limbType)) == 0;
+        *isBasePoint = memcmp(bytes, curve->gBytes, 2 * field->bytes) == 0;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* pointFromStri */
+
+
+
+/**
+ *  Convert a point to an encoded point (x and y big-endian).
+ *  @return the encoded point or an empty string for the neutral element.
+ */
+static striType pointToStri (const_curveType curve, const_pointType point)
+
+  {
+    const_fieldType field = &curve->field;
+    ucharType bytes[2 * MAX_FIELD_BYTES];
+    limbType zInverse[MAX_LIMBS];
+    limbType coordinate[MAX_LIMBS];
+    memSizeType size;
+    striType result;
+
+  /* pointToStri */
+    if (fieldIsZeroMask(field, point->z) != 0) {
+      size = 0;
+    } else {
+      size = 2 * field->bytes;
+      fieldInv(field, zInverse, point->z);
+      fieldMul(field, coordinate, point->x, zInverse);
+      fieldFromMontgomery(field, coordinate, coordinate);
+      limbsToBytes(field, bytes, coordinate);
+      fieldMul(field, coordinate, point->y, zInverse);
+      fieldFromMontgomery(field, coordinate, coordinate);
+      limbsToBytes(field, &bytes[field->bytes], coordinate);
+    } /* if */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = size;
+      memcpy_to_strelem(result->mem, bytes, size);
+    } /* if */
+    return result;
+  } /* pointToStri */
+
+
+
+static boolType scalarFromStri (const_curveType curve, ucharType *scalar,
+    const const_striType stri)
+
+  { /* scalarFromStri */
+    return stri->size == curve->field.bytes &&
+           !memcpy_from_strelem(scalar, stri->mem, stri->size);
+  } /* scalarFromStri */
+
+
+
+/**
+ *  Multiply a point with a scalar. Use the base table for the base point.
+ */
+static void multiply (curveType curve, pointType product,
+    const_pointType point, boolType isBasePoint, const ucharType *scalar)
+
+  { /* multiply */
+    if (isBasePoint && initBaseTable(curve)) {
+      pointMultBase(curve, product, scalar);
+    } else {
+      pointMult(curve, product, point, scalar);
+    } /* if */
+  } /* multiply */
+
+
+
+static inline void conditionalSwap (const_fieldType field, limbType *a,
+    limbType *b, limbType mask)
+
+  {
+    limbType diff;
+    unsigned int idx;
+
+  /* conditionalSwap */
+    for (idx = 0; idx < field->limbs; idx++) {
+      diff = (a[idx] ^ b[idx]) & mask;
+      a[idx] ^= diff;
+      b[idx] ^= diff;
+    } /* for */
+  } /* conditionalSwap */
+
+
+
+static void curve25519Init (void)
+
+  {
+    limbType limbs[MAX_LIMBS];
+
+  /* curve25519Init */
+    fieldInit(&curve25519Field, curve25519PHex);
+    memset(limbs, 0, sizeof(limbs));
+    limbs[0] = 121665;
+    fieldToMontgomery(&curve25519Field, curve25519A24, limbs);
+    curve25519Initialized = TRUE;
+  } /* curve25519Init */
+
+
+
+/**
+ *  Montgomery ladder of RFC 7748 for the u-coordinate of Curve25519.
+ */
+static void x25519Ladder (ucharType *resultBytes, const ucharType *scalar,
+    const ucharType *uBytes)
+
+  {
+    const_fieldType field = &curve25519Field;
+    limbType x1[MAX_LIMBS], x2[MAX_LIMBS], z2[MAX_LIMBS];
+    limbType x3[MAX_LIMBS], z3[MAX_LIMBS];
+    limbType a[MAX_LIMBS], aa[MAX_LIMBS], b[MAX_LIMBS], bb[MAX_LIMBS];
+    limbType c[MAX_LIMBS], d[MAX_LIMBS], e[MAX_LIMBS];
+    limbType da[MAX_LIMBS], cb[MAX_LIMBS];
+    limbType swap = 0;
+    limbType bit;
+    int pos;
+
+  /* x25519Ladder */
+    limbsFromBytes(field, x1, uBytes);
+    fieldReduceOnce(field, x1, x1, 0, field->limbs);
+    fieldToMontgomery(field, x1, x1);
+    memcpy(x2, field->one, sizeof(x2));
+    memset(z2, 0, sizeof(z2));
+    memcpy(x3, x1, sizeof(x3));
+    memcpy(z3, field->one, sizeof(z3));
+    for (pos = 254; pos >= 0; pos--) {
+      bit = (scalar[X25519_BYTES - 1 - pos / 8] >> (pos % 8)) & 1;
+      swap ^= bit;
+      conditionalSwap(field, x2, x3, (limbType) 0 - swap);
+      conditionalSwap(field, z2, z3, (limbType) 0 - swap);
+      swap = bit;
+      fieldAdd(field, a, x2, z2);
+      fieldMul(field, aa, a, a);
+      fieldSub(field, b, x2, z2);
+      fieldMul(field, bb, b, b);
+      fieldSub(field, e, aa, bb);
+      fieldAdd(field, c, x3, z3);
+      fieldSub(field, d, x3, z3);
+      fieldMul(field, da, d, a);
+      fieldMul(field, cb, c, b);
+      fieldAdd(field, x3, da, cb);
+      fieldMul(field, x3, x3, x3);
+      fieldSub(field, z3, da, cb);
+      fieldMul(field, z3, z3, z3);
+      fieldMul(field, z3, z3, x1);
+      fieldMul(field, x2, aa, bb);
+      fieldMul(field, z2, curve25519A24, e);
+      fieldAdd(field, z2, z2, aa);
+      fieldMul(field, z2, z2, e);
+    } /* for */
+    conditionalSwap(field, x2, x3, (limbType) 0 - swap);
+    conditionalSwap(field, z2, z3, (limbType) 0 - swap);
+    fieldInv(field, z2, z2);
+    fieldMul(field, x2, x2, z2);
+    fieldFromMontgomery(field, x2, x2);
+    limbsToBytes(field, resultBytes, x2);
+  } /* x25519Ladder */
+
+
+
+/**
+ *  Multiply a point of an elliptic curve with a scalar.
+ *  Points are encoded as x and y coordinate (big-endian, each with
+ *  the size of the curve in bytes). The neutral element is encoded
+ *  as empty string. The computation takes the same time for all
+ *  scalars. If the point is the base point of the curve a
+ *  precomputed table is used.
+ *  @param curveNumber 1 for secp256r1 and 2 for secp384r1.
+ *  @param point Encoded point on the curve.
+ *  @param scalar Big-endian scalar with the size of the curve in bytes.
+ *  @return the encoded product.
+ *  @exception RANGE_ERROR The curve is not supported, the point is
+ *             not on the curve or the scalar has an illegal length.
+ */
+striType eccMult (intType curveNumber, const const_striType point,
+    const const_striType scalar)
+
+  {
+    curveType curve;
+    pointRecord factor;
+    pointRecord product;
+    boolType isBasePoint;
+    ucharType scalarBytes[MAX_FIELD_BYTES];
+    striType result;
+
+  /* eccMult */
+    logFunction(printf("eccMult(" FMT_D ", " FMT_U_MEM ", " FMT_U_MEM ")\n",
+                       curveNumber, point->size, scalar->size););
+    curve = getCurve(curveNumber);
+    if (unlikely(curve == NULL ||
+                 !pointFromStri(curve, &factor, &isBasePoint, point) ||
+                 !scalarFromStri(curve, scalarBytes, scalar))) {
+      logError(printf("eccMult: Illegal curve, point or scalar.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      multiply(curve, &product, &factor, isBasePoint, scalarBytes);
+      result = pointToStri(curve, &product);
+    } /* if */
+    return result;
+  } /* eccMult */
+
+
+
+/**
+ *  Compute the sum of two products (point times scalar).
+ *  The encoding of points and scalars is the same as for eccMult.
+ *  This is used to verify ECDSA signatures.
+ *  @param curveNumber 1 for secp256r1 and 2 for secp384r1.
+ *  @return the encoded sum point1 * scalar1 + point2 * scalar2.
+ *  @exception RANGE_ERROR The curve is not supported, a point is
+ *             not on the curve or a scalar has an illegal length.
+ */
+striType eccMultAdd (intType curveNumber, const const_striType point1,
+    const const_striType scalar1, const const_striType point2,
+    const const_striType scalar2)
+
+  {
+    curveType curve;
+    pointRecord factor1;
+    pointRecord factor2;
+    pointRecord product1;
+    pointRecord product2;
+    boolType isBasePoint1;
+    boolType isBasePoint2;
+    ucharType scalarBytes1[MAX_FIELD_BYTES];
+    ucharType scalarBytes2[MAX_FIELD_BYTES];
+    striType result;
+
+  /* eccMultAdd */
+    logFunction(printf("eccMultAdd(" FMT_D ", *, *, *, *)\n", curveNumber););
+    curve = getCurve(curveNumber);
+    if (unlikely(curve == NULL ||
+                 !pointFromStri(curve, &factor1, &isBasePoint1, point1) ||
+                 !scalarFromStri(curve, scalarBytes1, scalar1) ||
+                 !pointFromStri(curve, &factor2, &isBasePoint2, point2) ||
+                 !scalarFromStri(curve, scalarBytes2, scalar2))) {
+      logError(printf("eccMultAdd: Illegal curve, point or scalar.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      multiply(curve, &product1, &factor1, isBasePoint1, scalarBytes1);
+      multiply(curve, &product2, &factor2, isBasePoint2, scalarBytes2);
+      pointAdd(curve, &product1, &product1, &product2);
+      result = pointToStri(curve, &product1);
+    } /* if */
+    return result;
+  } /* eccMultAdd */
+
+
+
+/**
+ *  Compute the X25519 function of RFC 7748.
+ *  The scalar is clamped as described in RFC 7748. The most
+ *  significant bit of the u-coordinate is ignored. The computation
+ *  takes the same time for all scalars.
+ *  @param scalar Little-endian scalar of 32 bytes.
+ *  @param uCoordinate Little-endian u-coordinate of 32 bytes.
+ *  @return the little-endian u-coordinate of the product (32 bytes).
+ *  @exception RANGE_ERROR The scalar or the u-coordinate have an
+ *             illegal length or contain characters beyond '\255;'.
+ */
+striType eccX25519 (const const_striType scalar, const const_striType uCoordinate)
+
+  {
+    ucharType scalarBytes[X25519_BYTES];
+    ucharType uBytes[X25519_BYTES];
+    ucharType resultBytes[X25519_BYTES];
+    ucharType reversed[X25519_BYTES];
+    unsigned int idx;
+    striType result;
+
+  /* eccX25519 */
+    logFunction(printf("eccX25519(" FMT_U_MEM ", " FMT_U_MEM ")\n",
+                       scalar->size, uCoordinate->size););
+    if (unlikely(scalar->size != X25519_BYTES ||
+                 uCoordinate->size != X25519_BYTES ||
+                 memcpy_from_strelem(scalarBytes, scalar->mem, X25519_BYTES) ||
+                 memcpy_from_strelem(uBytes, uCoordinate->mem, X25519_BYTES))) {
+      logError(printf("eccX25519: Illegal scalar or u-coordinate.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      if (!curve25519Initialized) {
+        curve25519Init();
+      } /* if */
+      /* Convert to big-endian and clamp the scalar. */
+      for (idx = 0; idx < X25519_BYTES; idx++) {
+        reversed[idx] = scalarBytes[X25519_BYTES - 1 - idx];
+      } /* for */
+      reversed[0] = (ucharType) ((reversed[0] & 127) | 64);
+      reversed[X25519_BYTES - 1] &= 248;
+      memcpy(scalarBytes, reversed, X25519_BYTES);
+      for (idx = 0; idx < X25519_BYTES; idx++) {
+        reversed[idx] = uBytes[X25519_BYTES - 1 - idx];
+      } /* for */
+      reversed[0] &= 127;
+      x25519Ladder(resultBytes, scalarBytes, reversed);
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, X25519_BYTES))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = X25519_BYTES;
+        for (idx = 0; idx < X25519_BYTES; idx++) {
+          result->mem[idx] = (strElemType) resultBytes[X25519_BYTES - 1 - idx];
+        } /* for */
+      } /* if */
+    } /* if */
+    return result;
+  } /* eccX25519 */
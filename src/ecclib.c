@@ -0,0 +1,113 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/ecclib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for elliptic curves.             */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "ecc_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "ecclib.h"
+
+
+
+/**
+ *  Multiply the point/arg_2 of an elliptic curve with scalar/arg_3.
+ *  The curve is selected with curveNumber/arg_1 (1 for secp256r1 and
+ *  2 for secp384r1). Points are encoded as big-endian x and y
+ *  coordinate. The neutral element is encoded as empty string.
+ *  @return the encoded product.
+ *  @exception RANGE_ERROR The curve is not supported, the point is
+ *             not on the curve or the scalar has an illegal length.
+ */
+objectType ecc_mult (listType arguments)
+
+  { /* ecc_mult */
+    isit_int(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        eccMult(take_int(arg_1(arguments)),
+                take_stri(arg_2(arguments)),
+                take_stri(arg_3(arguments))));
+  } /* ecc_mult */
+
+
+
+/**
+ *  Compute point1/arg_2 * scalar1/arg_3 + point2/arg_4 * scalar2/arg_5.
+ *  The curve and the encoding of the points are as for ecc_mult.
+ *  @return the encoded sum of the two products.
+ *  @exception RANGE_ERROR The curve is not supported, a point is
+ *             not on the curve or a scalar has an illegal length.
+ */
+objectType ecc_mult_add (listType arguments)
+
+  { /* ecc_mult_add */
+    isit_int(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    isit_stri(arg_5(arguments));
+    return bld_stri_temp(
+        eccMultAdd(take_int(arg_1(arguments)),
+                   take_stri(arg_2(arguments)),
+                   take_stri(arg_3(arguments)),
+                   take_stri(arg_4(arguments)),
+                   take_stri(arg_5(arguments))));
+  } /* ecc_mult_add */
+
+
+
+/**
+ *  Compute the X25519 function of RFC 7748.
+ *  The scalar/arg_1 and the u-coordinate/arg_2 are little-endian
+ *  strings with 32 bytes.
+ *  @return the little-endian u-coordinate of the product.
+ *  @exception RANGE_ERROR The scalar or the u-coordinate have an
+ *             illegal length or contain characters beyond '\255;'.
+ */
+objectType ecc_x25519 (listType arguments)
+
+  { /* ecc_x25519 */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        eccX25519(take_stri(arg_1(arguments)),
+                  take_stri(arg_2(arguments))));
+  } /* ecc_x25519 */
@@ -52,6 +52,7 @@
 #include "runerr.h"
 #include "match.h"
 #include "prclib.h"
+#include "blnlib.h"
 
 #undef EXTERN
 #define EXTERN
@@ -61,6 +62,32 @@
 
 extern boolType interpreter_exception;
 
+#define DYN_CACHE_SIZE 512
+#define DYN_CACHE_WAYS   4
+#define DYN_KEY_LENGTH   8
+
+#define DYN_KEY_VAR      1
+#define DYN_KEY_OBJECT   2
+
+typedef struct {
+    unsigned int length;
+    const void *key[DYN_KEY_LENGTH];
+    unsigned char flags[DYN_KEY_LENGTH];
+    objectType function;
+  } dynCacheEntryRecord, *dynCacheEntryType;
+
+typedef const dynCacheEntryRecord *const_dynCacheEntryType;
+
+typedef struct {
+    const_objectType callSite;
+    const_progType prog;
+    unsigned int numEntries;
+    boolType megamorphic;
+    dynCacheEntryRecord entry[DYN_CACHE_WAYS];
+  } dynCacheSiteRecord, *dynCacheSiteType;
+
+static dynCacheSiteRecord dynamicCache[DYN_CACHE_SIZE];
+
 
 
 void doSuspendInterpreter (int signalNum)
@@ -155,6 +182,19 @@ objectType exec_object (register objectType object)
 
 
 
+static void dump_temp_params (listType param_list_elem)
+
+  { /* dump_temp_params */
+    while (param_list_elem != NULL) {
+      if (param_list_elem->obj != NULL && TEMP_OBJECT(param_list_elem->obj)) {
+        dump_any_temp(param_list_elem->obj);
+      } /* if */
+      param_list_elem = param_list_elem->next;
+    } /* while */
+  } /* dump_temp_params */
+
+
+
 /**
  *  When a temporary value is entered into a reference parameter
  *  the TEMP flag must be cleared. This is necessary to avoid
@@ -173,6 +213,70 @@ objectType exec_object (register objectType object)
  *  When a TEMP2 parameter is used for a deeper function call
  *  The TEMP2 flag is cleared to avoid unwanted effects.
  */
+static inline void par_bind (locListType form_param,
+    listType param_list_elem)
+
+  {
+    objectType param_value;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* par_bind */
+    logFunction(printf("par_bind\n"););
+    while (form_param != NULL && err_info == OKAY_NO_ERROR) {
+      param_value = param_list_elem->obj;
+      switch (CATEGORY_OF_OBJ(form_param->local.object)) {
+        case VALUEPARAMOBJECT:
+/*            printf("value param formal ");
+          trace1(form_param->local.object);
+          printf(" %lu\nparam value ", (unsigned long) form_param->local.object);
+          trace1(param_value);
+          printf(" %lu\n", (unsigned long) param_value); */
+          if (TEMP_OBJECT(param_value)) {
+            CLEAR_TEMP_FLAG(param_value);
+            COPY_VAR_FLAG(param_value, form_param->local.object);
+            form_param->local.object->value.objValue = param_value;
+            param_list_elem->obj = NULL;
+/*              printf("assign temp ");
+            trace1(form_param->local.object);
+            printf(" %lu\n", (unsigned long) form_param->local.object); */
+          } else {
+            CLEAR_TEMP2_FLAG(param_value);
+            create_local_object(&form_param->local, param_value, &err_info);
+/*              printf("assign obj ");
+            trace1(form_param->local.object);
+            printf(" %lu\n", (unsigned long) form_param->local.object); */
+          } /* if */
+          break;
+        case REFPARAMOBJECT:
+/*            printf("ref param formal ");
+          trace1(form_param->local.object);
+          printf(" %lu\nparam value ", (unsigned long) form_param->local.object);
+          trace1(param_value);
+          printf(" %lu\n", (unsigned long) param_value); */
+          form_param->local.object->value.objValue = param_value;
+          if (TEMP_OBJECT(param_value)) {
+            CLEAR_TEMP_FLAG(param_value);
+            SET_TEMP2_FLAG(param_value);
+            /* printf("ref to temp ");
+            trace1(form_param->local.object);
+            printf(" %lu\n", (unsigned long) form_param->local.object); */
+          } else {
+            CLEAR_TEMP2_FLAG(param_value);
+            param_list_elem->obj = NULL;
+          } /* if */
+          break;
+        default:
+          /* Do nothing for SYMBOLOBJECT and TYPEOBJECT. */
+          break;
+      } /* switch */
+      form_param = form_param->next;
+      param_list_elem = param_list_elem->next;
+    } /* while */
+    logFunction(printf("par_bind -->\n"););
+  } /* par_bind */
+
+
+
 static inline void par_init (locListType form_param_list,
     listType *backup_form_params, listType act_param_list,
     listType *evaluated_act_params)
@@ -181,9 +285,7 @@ static inline void par_init (locListType form_param_list,
     locListType form_param;
     listType *backup_insert_place;
     listType *evaluated_insert_place;
-    listType param_list_elem;
     objectType param_value;
-    errInfoType err_info = OKAY_NO_ERROR;
 
   /* par_init */
     logFunction(printf("par_init\n"););
@@ -201,72 +303,70 @@ static inline void par_init (locListType form_param_list,
       act_param_list = act_param_list->next;
     } /* while */
     if (fail_flag) {
-      param_list_elem = *evaluated_act_params;
-      while (param_list_elem != NULL) {
-        if (param_list_elem->obj != NULL && TEMP_OBJECT(param_list_elem->obj)) {
-          dump_any_temp(param_list_elem->obj);
-        } /* if */
-        param_list_elem = param_list_elem->next;
-      } /* while */
+      dump_temp_params(*evaluated_act_params);
     } else {
-      form_param = form_param_list;
-      param_list_elem = *evaluated_act_params;
-      while (form_param != NULL && err_info == OKAY_NO_ERROR) {
-        param_value = param_list_elem->obj;
-        switch (CATEGORY_OF_OBJ(form_param->local.object)) {
-          case VALUEPARAMOBJECT:
-/*            printf("value param formal ");
-            trace1(form_param->local.object);
-            printf(" %lu\nparam value ", (unsigned long) form_param->local.object);
-            trace1(param_value);
-            printf(" %lu\n", (unsigned long) param_value); */
-            if (TEMP_OBJECT(param_value)) {
-              CLEAR_TEMP_FLAG(param_value);
-              COPY_VAR_FLAG(param_value, form_param->local.object);
-              form_param->local.object->value.objValue = param_value;
-              param_list_elem->obj = NULL;
-/*              printf("assign temp ");
-              trace1(form_param->local.object);
-              printf(" %lu\n", (unsigned long) form_param->local.object); */
-            } else {
-              CLEAR_TEMP2_FLAG(param_value);
-              create_local_object(&form_param->local, param_value, &err_info);
-/*              printf("assign obj ");
-              trace1(form_param->local.object);
-              printf(" %lu\n", (unsigned long) form_param->local.object); */
-            } /* if */
-            break;
-          case REFPARAMOBJECT:
-/*            printf("ref param formal ");
-            trace1(form_param->local.object);
-            printf(" %lu\nparam value ", (unsigned long) form_param->local.object);
-            trace1(param_value);
-            printf(" %lu\n", (unsigned long) param_value); */
-            form_param->local.object->value.objValue = param_value;
-            if (TEMP_OBJECT(param_value)) {
-              CLEAR_TEMP_FLAG(param_value);
-              SET_TEMP2_FLAG(param_value);
-              /* printf("ref to temp ");
-              trace1(form_param->local.object);
-              printf(" %lu\n", (unsigned long) form_param->local.object); */
-            } else {
-              CLEAR_TEMP2_FLAG(param_value);
-              param_list_elem->obj = NULL;
-            } /* if */
-            break;
-          default:
-            /* Do nothing for SYMBOLOBJECT and TYPEOBJECT. */
-            break;
-        } /* switch */
-        form_param = form_param->next;
-        param_list_elem = param_list_elem->next;
-      } /* while */
+      par_bind(form_param_list, *evaluated_act_params);
     } /* if */
     logFunction(printf("par_init -->\n"););
   } /* par_init */
 
 
 
+/**
+ *  Evaluate the actual parameters of a tail call.
+ *  The formal parameters are neither saved nor changed. This is
+ *  done by par_backup and par_bind, when the frame of the calling
+ *  function has been released.
+ *  @return the list of evaluated actual parameters or NULL if
+ *          an exception was raised.
+ */
+static listType par_eval (const_locListType form_param,
+    listType act_param_list)
+
+  {
+    listType evaluated_act_params = NULL;
+    listType *evaluated_insert_place;
+    objectType param_value;
+
+  /* par_eval */
+    logFunction(printf("par_eval\n"););
+    evaluated_insert_place = &evaluated_act_params;
+    while (form_param != NULL && !fail_flag) {
+      param_value = exec_object(act_param_list->obj);
+      append_to_list(evaluated_insert_place, param_value, act_param_list);
+      form_param = form_param->next;
+      act_param_list = act_param_list->next;
+    } /* while */
+    if (fail_flag) {
+      dump_temp_params(evaluated_act_params);
+      free_list(evaluated_act_params);
+      evaluated_act_params = NULL;
+    } /* if */
+    logFunction(printf("par_eval -->\n"););
+    return evaluated_act_params;
+  } /* par_eval */
+
+
+
+static listType par_backup (const_locListType form_param,
+    listType act_param_list)
+
+  {
+    listType backup_form_params = NULL;
+    listType *backup_insert_place;
+
+  /* par_backup */
+    backup_insert_place = &backup_form_params;
+    while (form_param != NULL && !fail_flag) {
+      append_to_list(backup_insert_place,
+          form_param->local.object->value.objValue, act_param_list);
+      form_param = form_param->next;
+    } /* while */
+    return backup_form_params;
+  } /* par_backup */
+
+
+
 static inline void par_restore (const_locListType form_param,
     const_listType backup_form_params, const_listType evaluated_act_params)
 
@@ -481,32 +581,286 @@ static void show_arg_list (listType act_param_list)
 
 
 
-static objectType exec_lambda (const_blockType block,
-    listType actual_parameters, objectType object)
+static boolType belongs_to_block (const_blockType block,
+    const_objectType object)
+
+  {
+    const_locListType loc_var;
+
+  /* belongs_to_block */
+    if (block->result.object == object) {
+      return TRUE;
+    } /* if */
+    for (loc_var = block->params; loc_var != NULL; loc_var = loc_var->next) {
+      if (loc_var->local.object == object) {
+        return TRUE;
+      } /* if */
+    } /* for */
+    for (loc_var = block->local_vars; loc_var != NULL; loc_var = loc_var->next) {
+      if (loc_var->local.object == object) {
+        return TRUE;
+      } /* if */
+    } /* for */
+    return FALSE;
+  } /* belongs_to_block */
+
+
+
+/**
+ *  Determine if the frame of 'block' can be released before a tail call.
+ *  This is not possible, if a reference parameter of the tail call
+ *  refers to a value of the frame. Temporary values owned by the
+ *  frame (see par_bind) are excluded, since they can be passed to
+ *  the tail call. The result of an expression might be a part
+ *  of a local variable. In this case the frame is kept also.
+ *  @return TRUE if the frame can be released, FALSE otherwise.
+ */
+static boolType frame_reusable (const_blockType block,
+    const_blockType tail_block, const_listType tail_act_params,
+    const_listType tail_evaluated)
+
+  {
+    const_locListType form_param;
+    objectType param_value;
+    boolType reusable = TRUE;
+
+  /* frame_reusable */
+    form_param = tail_block->params;
+    while (form_param != NULL && reusable) {
+      param_value = tail_evaluated->obj;
+      if (CATEGORY_OF_OBJ(form_param->local.object) == REFPARAMOBJECT &&
+          param_value != NULL && !TEMP_OBJECT(param_value)) {
+        switch (CATEGORY_OF_OBJ(tail_act_params->obj)) {
+          case VALUEPARAMOBJECT:
+          case LOCALVOBJECT:
+          case RESULTOBJECT:
+            reusable = !belongs_to_block(block, tail_act_params->obj);
+            break;
+          case CALLOBJECT:
+          case MATCHOBJECT:
+            reusable = FALSE;
+            break;
+          default:
+            break;
+        } /* switch */
+      } /* if */
+      form_param = form_param->next;
+      tail_act_params = tail_act_params->next;
+      tail_evaluated = tail_evaluated->next;
+    } /* while */
+    return reusable;
+  } /* frame_reusable */
+
+
+
+/**
+ *  Make the evaluated parameters of a tail call independent from
+ *  the frame of 'block', which is released afterwards. Values for
+ *  value parameters are copied, if they are not temporary. Temporary
+ *  values owned by the frame and referred by reference parameters of
+ *  the tail call are handed over to the tail call.
+ */
+static void pass_tail_params (const_blockType block,
+    listType evaluated_act_params, const_blockType tail_block,
+    const_listType tail_act_params, listType tail_evaluated)
+
+  {
+    const_locListType form_param;
+    listType owned_param;
+    objectType param_value;
+    objectType backup_value;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* pass_tail_params */
+    form_param = tail_block->params;
+    while (form_param != NULL && err_info == OKAY_NO_ERROR) {
+      param_value = tail_evaluated->obj;
+      switch (CATEGORY_OF_OBJ(form_param->local.object)) {
+        case VALUEPARAMOBJECT:
+          if (!TEMP_OBJECT(param_value)) {
+            backup_value = form_param->local.object->value.objValue;
+            CLEAR_TEMP2_FLAG(param_value);
+            create_local_object(&form_param->local, param_value, &err_info);
+            if (err_info == OKAY_NO_ERROR) {
+              tail_evaluated->obj = form_param->local.object->value.objValue;
+              SET_TEMP_FLAG(tail_evaluated->obj);
+            } else {
+              tail_evaluated->obj = NULL;
+            } /* if */
+            form_param->local.object->value.objValue = backup_value;
+          } /* if */
+          break;
+        case REFPARAMOBJECT:
+          if (param_value != NULL && !TEMP_OBJECT(param_value) &&
+              CATEGORY_OF_OBJ(tail_act_params->obj) == REFPARAMOBJECT &&
+              belongs_to_block(block, tail_act_params->obj)) {
+            owned_param = evaluated_act_params;
+            while (owned_param != NULL && owned_param->obj != param_value) {
+              owned_param = owned_param->next;
+            } /* while */
+            if (owned_param != NULL) {
+              owned_param->obj = NULL;
+              CLEAR_TEMP2_FLAG(param_value);
+              SET_TEMP_FLAG(param_value);
+            } /* if */
+          } /* if */
+          break;
+        default:
+          /* Do nothing for SYMBOLOBJECT and TYPEOBJECT. */
+          break;
+      } /* switch */
+      form_param = form_param->next;
+      tail_act_params = tail_act_params->next;
+      tail_evaluated = tail_evaluated->next;
+    } /* while */
+    if (unlikely(err_info != OKAY_NO_ERROR && !fail_flag)) {
+      raise_with_arguments(SYS_MEM_EXCEPTION, NULL);
+    } /* if */
+  } /* pass_tail_params */
+
+
+
+/**
+ *  Execute the body of a function without result variable.
+ *  The alternatives of ternary operators are in tail position as
+ *  well. They are chosen here, instead of calling bln_ternary.
+ *  When the expression in tail position is a call of a function
+ *  defined in Seed7, the call is not executed. Instead it is
+ *  assigned to 'tail_call' and NULL is returned.
+ *  @return the result of the body or NULL if 'tail_call' was set.
+ */
+static objectType exec_tail (objectType body, objectType *tail_call)
 
   {
+    listType ternary_params;
+    objectType condition;
+    boolType via_ternary = FALSE;
     objectType result;
-    listType evaluated_act_params;
-    listType backup_form_params;
-    objectType backup_block_result;
-    listType backup_loc_var;
 
-  /* exec_lambda */
-    logFunction(printf("exec_lambda\n"););
-    par_init(block->params, &backup_form_params, actual_parameters,
-        &evaluated_act_params);
-    if (fail_flag) {
-      free_list(backup_form_params);
-      free_list(evaluated_act_params);
-      result = fail_value;
+  /* exec_tail */
+    logFunction(printf("exec_tail\n"););
+    while ((CATEGORY_OF_OBJ(body) == CALLOBJECT ||
+            CATEGORY_OF_OBJ(body) == MATCHOBJECT) &&
+           CATEGORY_OF_OBJ(body->value.listValue->obj) == ACTOBJECT &&
+           body->value.listValue->obj->value.actValue == bln_ternary &&
+           CATEGORY_OF_OBJ(arg_3(body->value.listValue->next)) != CALLOBJECT &&
+           CATEGORY_OF_OBJ(arg_5(body->value.listValue->next)) != CALLOBJECT) {
+      ternary_params = body->value.listValue->next;
+      condition = exec_object(arg_1(ternary_params));
+      if (unlikely(fail_flag)) {
+        return fail_value;
+      } /* if */
+      if (take_bool(condition) == SYS_TRUE_OBJECT) {
+        body = arg_3(ternary_params);
+      } else {
+        body = arg_5(ternary_params);
+      } /* if */
+      if (TEMP_OBJECT(condition)) {
+        dump_any_temp(condition);
+      } /* if */
+      via_ternary = TRUE;
+    } /* while */
+    if ((CATEGORY_OF_OBJ(body) == CALLOBJECT ||
+         CATEGORY_OF_OBJ(body) == MATCHOBJECT) &&
+        CATEGORY_OF_OBJ(body->value.listValue->obj) == BLOCKOBJECT) {
+      *tail_call = body;
+      result = NULL;
+    } else if (via_ternary) {
+      result = evaluate(body);
+      if (result != NULL &&
+          (CATEGORY_OF_OBJ(result) == CONSTENUMOBJECT ||
+           CATEGORY_OF_OBJ(result) == VARENUMOBJECT)) {
+        result = result->value.objValue;
+      } /* if */
     } else {
+      result = exec_call(body);
+    } /* if */
+    logFunction(printf("exec_tail -->\n"););
+    return result;
+  } /* exec_tail */
+
+
+
+/**
+ *  Execute a function with bound parameters.
+ *  A tail call of a function defined in Seed7 reuses the frame,
+ *  if the frame of the calling function can be released before.
+ *  This way deep tail recursions do not use up the stack.
+ */
+static objectType exec_frame (blockType block,
+    listType actual_parameters, objectType object,
+    listType backup_form_params, listType evaluated_act_params)
+
+  {
+    objectType result;
+    objectType backup_block_result;
+    listType backup_loc_var;
+    objectType tail_call;
+    blockType tail_block = NULL;
+    listType tail_act_params = NULL;
+    listType tail_evaluated = NULL;
+    listType tail_backup;
+    boolType reuse_frame;
+
+  /* exec_frame */
+    logFunction(printf("exec_frame\n"););
+    do {
+      reuse_frame = FALSE;
+      if (unlikely(hot_call_threshold != 0) &&
+          ++block->call_count == hot_call_threshold) {
+        hot_block_count++;
+        if (hot_block_count == 1 && hot_program_handler != NULL) {
+          hot_program_handler();
+        } /* if */
+      } /* if */
       loc_init(block->local_vars, &backup_loc_var, actual_parameters);
       if (fail_flag) {
         free_list(backup_loc_var);
         result = fail_value;
       } else {
         if (res_init(&block->result, &backup_block_result)) {
-          result = exec_call(block->body);
+          tail_call = NULL;
+#ifdef WITH_PROTOCOL
+          if (block->result.object == NULL && !trace.actions) {
+#else
+          if (block->result.object == NULL) {
+#endif
+            result = exec_tail(block->body, &tail_call);
+          } else {
+            result = exec_call(block->body);
+          } /* if */
+          if (tail_call != NULL) {
+            tail_block = tail_call->value.listValue->obj->value.blockValue;
+            tail_act_params = tail_call->value.listValue->next;
+            tail_evaluated = par_eval(tail_block->params, tail_act_params);
+            if (!fail_flag) {
+              if (frame_reusable(block, tail_block, tail_act_params,
+                                 tail_evaluated)) {
+                pass_tail_params(block, evaluated_act_params, tail_block,
+                                 tail_act_params, tail_evaluated);
+                if (fail_flag) {
+                  dump_temp_params(tail_evaluated);
+                  free_list(tail_evaluated);
+                } else {
+                  reuse_frame = TRUE;
+                } /* if */
+              } else {
+                tail_backup = par_backup(tail_block->params, tail_act_params);
+                if (unlikely(fail_flag)) {
+                  free_list(tail_backup);
+                  dump_temp_params(tail_evaluated);
+                  free_list(tail_evaluated);
+                } else {
+                  par_bind(tail_block->params, tail_evaluated);
+                  result = exec_frame(tail_block, tail_act_params, tail_call,
+                      tail_backup, tail_evaluated);
+                } /* if */
+              } /* if */
+            } /* if */
+            if (fail_flag) {
+              result = fail_value;
+            } /* if */
+          } /* if */
           if (fail_flag) {
             errInfoType ignored_err_info;
 
@@ -524,6 +878,48 @@ static objectType exec_lambda (const_blockType block,
       par_restore(block->params, backup_form_params, evaluated_act_params);
       free_list(backup_form_params);
       free_list(evaluated_act_params);
+      if (reuse_frame) {
+        backup_form_params = par_backup(tail_block->params, tail_act_params);
+        if (unlikely(fail_flag)) {
+          free_list(backup_form_params);
+          dump_temp_params(tail_evaluated);
+          free_list(tail_evaluated);
+          result = fail_value;
+          reuse_frame = FALSE;
+        } else {
+          par_bind(tail_block->params, tail_evaluated);
+          evaluated_act_params = tail_evaluated;
+          block = tail_block;
+          actual_parameters = tail_act_params;
+          object = tail_call;
+        } /* if */
+      } /* if */
+    } while (reuse_frame);
+    logFunction(printf("exec_frame -->\n"););
+    return result;
+  } /* exec_frame */
+
+
+
+static objectType exec_lambda (blockType block,
+    listType actual_parameters, objectType object)
+
+  {
+    objectType result;
+    listType evaluated_act_params;
+    listType backup_form_params;
+
+  /* exec_lambda */
+    logFunction(printf("exec_lambda\n"););
+    par_init(block->params, &backup_form_params, actual_parameters,
+        &evaluated_act_params);
+    if (fail_flag) {
+      free_list(backup_form_params);
+      free_list(evaluated_act_params);
+      result = fail_value;
+    } else {
+      result = exec_frame(block, actual_parameters, object,
+          backup_form_params, evaluated_act_params);
     } /* if */
     logFunction(printf("exec_lambda -->\n"););
     return result;
@@ -972,6 +1368,137 @@ objectType eval_expression (objectType object)
 
 
 
+/**
+ *  Compute the inline cache key element for a parameter of a dynamic call.
+ *  The match of a dynamic call depends on the types of the values
+ *  and on the identity of symbols, type values and named objects.
+ *  @param element_value Value of the parameter.
+ *  @param key Place to store the key (type or object).
+ *  @param flags Place to store the DYN_KEY_... flags.
+ *  @return TRUE if the parameter can be part of a cache key, or
+ *          FALSE if the match might depend on more than its type.
+ */
+static boolType dynamic_cache_key (const_objectType element_value,
+    const void **key, unsigned char *flags)
+
+  { /* dynamic_cache_key */
+    switch (CATEGORY_OF_OBJ(element_value)) {
+      case BLOCKOBJECT:
+      case ACTOBJECT:
+      case EXPROBJECT:
+      case CALLOBJECT:
+      case MATCHOBJECT:
+        return FALSE;
+      case SYMBOLOBJECT:
+      case TYPEOBJECT:
+        *key = element_value;
+        *flags = DYN_KEY_OBJECT;
+        break;
+      default:
+        if (HAS_ENTITY(element_value)) {
+          *key = element_value;
+          *flags = DYN_KEY_OBJECT;
+        } else {
+          *key = element_value->type_of;
+          *flags = VAR_OBJECT(element_value) ? DYN_KEY_VAR : 0;
+        } /* if */
+        break;
+    } /* switch */
+    return TRUE;
+  } /* dynamic_cache_key */
+
+
+
+/**
+ *  Search the inline cache of a call site for a key.
+ *  @return the cached implementation function, or NULL if the key
+ *          is not in the cache of the call site.
+ */
+static objectType dynamic_cache_lookup (const dynCacheSiteType site,
+    const dynCacheEntryType key)
+
+  {
+    unsigned int entryNum;
+    const_dynCacheEntryType entry;
+
+  /* dynamic_cache_lookup */
+    for (entryNum = 0; entryNum < site->numEntries; entryNum++) {
+      entry = &site->entry[entryNum];
+      if (entry->length == key->length &&
+          memcmp(entry->key, key->key, key->length * sizeof(void *)) == 0 &&
+          memcmp(entry->flags, key->flags, key->length) == 0) {
+        return entry->function;
+      } /* if */
+    } /* for */
+    return NULL;
+  } /* dynamic_cache_lookup */
+
+
+
+/**
+ *  Remember the implementation function matched for a key.
+ *  A call site that sees more than DYN_CACHE_WAYS different keys
+ *  is marked as megamorphic and is not cached any more.
+ *  The implementation is only cached, if the match kept the
+ *  parameters of the call unchanged. In this case the matched
+ *  expression can be reconstructed by prepending the function.
+ */
+static void dynamic_cache_insert (const dynCacheSiteType site,
+    const dynCacheEntryType key, const const_objectType *const element_values,
+    const_objectType match_result)
+
+  {
+    const_listType matched_element;
+    unsigned int pos = 0;
+
+  /* dynamic_cache_insert */
+    if (CATEGORY_OF_OBJ(match_result) == CALLOBJECT &&
+        match_result->value.listValue != NULL) {
+      matched_element = match_result->value.listValue->next;
+      while (pos < key->length && matched_element != NULL &&
+             element_values[pos] == matched_element->obj) {
+        pos++;
+        matched_element = matched_element->next;
+      } /* while */
+      if (pos == key->length && matched_element == NULL) {
+        if (site->numEntries < DYN_CACHE_WAYS) {
+          memcpy(&site->entry[site->numEntries], key, sizeof(dynCacheEntryRecord));
+          site->entry[site->numEntries].function =
+              match_result->value.listValue->obj;
+          site->numEntries++;
+        } else {
+          site->megamorphic = TRUE;
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* dynamic_cache_insert */
+
+
+
+/**
+ *  Remove all entries from the inline caches of dynamic calls.
+ *  This must be done when a program is freed, because the cached
+ *  implementation functions refer to objects of the program.
+ */
+void flush_dynamic_cache (void)
+
+  { /* flush_dynamic_cache */
+    logFunction(printf("flush_dynamic_cache\n"););
+    memset(dynamicCache, 0, sizeof(dynamicCache));
+  } /* flush_dynamic_cache */
+
+
+
+/**
+ *  Execute a call of a DYNAMIC function.
+ *  The implementation function is determined by matching the
+ *  parameter values against the declarations of the program.
+ *  Every call site has an inline cache with up to DYN_CACHE_WAYS
+ *  entries. Monomorphic and polymorphic call sites use the cached
+ *  implementation function and skip the match. Call sites with
+ *  more different parameter types (megamorphic call sites) and
+ *  calls with parameters that cannot be cached use the match.
+ */
 objectType exec_dynamic (listType expr_list)
 
   {
@@ -981,6 +1508,11 @@ objectType exec_dynamic (listType expr_list)
     listType *list_insert_place;
     objectType element_value;
     objectType match_result;
+    dynCacheSiteType site;
+    dynCacheEntryRecord key;
+    const_objectType element_values[DYN_KEY_LENGTH];
+    boolType cacheable;
+    objectType cached_function = NULL;
     objectType result = NULL;
     errInfoType err_info = OKAY_NO_ERROR;
 
@@ -998,6 +1530,15 @@ objectType exec_dynamic (listType expr_list)
     } /* if */
 #endif
     dynamic_call_obj = curr_exec_object;
+    site = &dynamicCache[((memSizeType) dynamic_call_obj >> 4) & (DYN_CACHE_SIZE - 1)];
+    if (site->callSite != dynamic_call_obj || site->prog != prog) {
+      site->callSite = dynamic_call_obj;
+      site->prog = prog;
+      site->numEntries = 0;
+      site->megamorphic = FALSE;
+    } /* if */
+    cacheable = !site->megamorphic;
+    key.length = 0;
     if (ALLOC_OBJECT(match_expr)) {
       match_expr->type_of = take_type(SYS_EXPR_TYPE);
       match_expr->descriptor.property = prog->property.literal;
@@ -1038,6 +1579,16 @@ printf("\n"); */
           CLEAR_TEMP_FLAG(element_value);
         } /* if */
 #endif
+        if (cacheable) {
+          if (key.length < DYN_KEY_LENGTH &&
+              dynamic_cache_key(element_value, &key.key[key.length],
+                                &key.flags[key.length])) {
+            element_values[key.length] = element_value;
+            key.length++;
+          } else {
+            cacheable = FALSE;
+          } /* if */
+        } /* if */
         /* err_info is not checked after append! */
         list_insert_place = append_element_to_list(list_insert_place,
             element_value, &err_info);
@@ -1057,11 +1608,31 @@ printf("\n"); */
       /* printf("match_expr ");
       trace1(match_expr);
       printf("\n"); */
-      if (match_prog_expression(prog->declaration_root, match_expr) != NULL &&
+      if (cacheable) {
+        cached_function = dynamic_cache_lookup(site, &key);
+      } /* if */
+      if (cached_function != NULL) {
+        incl_list(&match_expr->value.listValue, cached_function, &err_info);
+        if (unlikely(err_info != OKAY_NO_ERROR)) {
+          free_list(match_expr->value.listValue);
+          FREE_OBJECT(match_expr);
+          return raise_with_arguments(SYS_MEM_EXCEPTION, expr_list);
+        } /* if */
+        match_expr->type_of = cached_function->type_of;
+        SET_CATEGORY_OF_OBJ(match_expr, CALLOBJECT);
+        match_result = match_expr;
+      } else if (match_prog_expression(prog->declaration_root, match_expr) != NULL &&
           (match_result = match_object(match_expr)) != NULL) {
+        if (cacheable && match_result == match_expr) {
+          dynamic_cache_insert(site, &key, element_values, match_result);
+        } /* if */
+      } else {
+        match_result = NULL;
+      } /* if */
+      if (match_result != NULL) {
 #ifdef WITH_PROTOCOL
         if (trace.dynamic) {
-          prot_cstri("matched ==> ");
+          prot_cstri(cached_function != NULL ? "cached ==> " : "matched ==> ");
           trace1(match_result);
         } /* if */
 #endif
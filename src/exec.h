@@ -32,6 +32,12 @@ EXTERN volatile boolType interrupt_flag;
 #endif
 EXTERN volatile int signal_number;
 
+/* Calls of a block, after which it is counted as hot (0: no counting) */
+EXTERN uintType hot_call_threshold;
+EXTERN uintType hot_block_count;
+/* Called, when the first block is counted as hot (NULL: no call) */
+EXTERN void (*hot_program_handler) (void);
+
 
 void doSuspendInterpreter (int signalNum);
 objectType exec_object (register objectType object);
@@ -39,6 +45,7 @@ objectType exec_call (objectType object);
 objectType do_exec_call (objectType object, errInfoType *err_info);
 objectType evaluate (objectType object);
 objectType eval_expression (objectType object);
+void flush_dynamic_cache (void);
 objectType exec_dynamic (listType expr_list);
 objectType exec_expr (const progType currentProg, objectType object,
                       errInfoType *err_info);
@@ -531,3 +531,15 @@ const_ustriType get_file_name_ustri (fileNumType file_num)
     logFunction(printf("get_file_name_ustri -->\n"););
     return file_name;
   } /* get_file_name_ustri */
+
+
+
+/**
+ *  Determine the number of files opened by the analyzer.
+ *  The files have the file numbers from 1 to get_file_count().
+ */
+fileNumType get_file_count (void)
+
+  { /* get_file_count */
+    return file_counter;
+  } /* get_file_count */
@@ -106,3 +106,4 @@ void next_file (void);
 int next_line (void);
 striType get_file_name (fileNumType file_num);
 const_ustriType get_file_name_ustri (fileNumType file_num);
+fileNumType get_file_count (void);
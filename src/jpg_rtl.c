@@ -0,0 +1,354 @@
+/********************************************************************/
+/*                                                                  */
+/*  jpg_rtl.c     Primitive actions for JPEG block decoding.        */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/jpg_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for JPEG block decoding.             */
+/*                                                                  */
+/*  A JPEG block consists of 64 quantized DCT coefficients in       */
+/*  zigzag order. The coefficients are dequantized, brought into    */
+/*  natural order and transformed with an integer inverse DCT.      */
+/*  The full size IDCT uses the same fixed point butterflies as     */
+/*  the former Seed7 implementation in jpeg.s7i, so the decoded     */
+/*  samples do not change. The rows are transformed first (most     */
+/*  rows contain only a DC value). The columns are transformed      */
+/*  afterwards with a loop over all eight columns, which has no     */
+/*  conditions and can be vectorized by the C compiler.             */
+/*  For the reduced sizes 4x4, 2x2 and 1x1 only the low frequency   */
+/*  coefficients are used. This scales the image down in the DCT    */
+/*  domain by 1/2, 1/4 and 1/8.                                     */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "jpg_rtl.h"
+
+
+#define JPEG_BLOCK_SIZE 64
+#define MAX_COEFFICIENT 65535
+#define MAX_QUANTIZATION 65535
+
+#if RSHIFT_DOES_SIGN_EXTEND
+#define signedRShift(number, shift) ((number) >> (shift))
+#else
+#define signedRShift(number, shift) \
+    ((number) < 0 ? ~(~(number) >> (shift)) : (number) >> (shift))
+#endif
+
+/* 2048 * sqrt(2.0) * cos(n * PI / 16) */
+#define W1 2841
+#define W2 2676
+#define W3 2408
+#define W5 1609
+#define W6 1108
+#define W7  565
+
+/* Position of the coefficient in zigzag order for the natural order. */
+static const unsigned char zigzag[JPEG_BLOCK_SIZE] = {
+     0,  1,  5,  6, 14, 15, 27, 28,
+     2,  4,  7, 13, 16, 26, 29, 42,
+     3,  8, 12, 17, 25, 30, 41, 43,
+     9, 11, 18, 24, 31, 40, 44, 53,
+    10, 19, 23, 32, 39, 45, 52, 54,
+    20, 22, 33, 38, 46, 51, 55, 60,
+    21, 34, 37, 47, 50, 56, 59, 61,
+    35, 36, 48, 49, 57, 58, 62, 63};
+
+/* 2048 * (u == 0 ? 1.0 : sqrt(2.0)) * cos((2 * x + 1) * u * PI / 8) */
+static const int idct4Weight[4][4] = {
+    {2048,  2676,  2048,  1108},
+    {2048,  1108, -2048, -2676},
+    {2048, -1108, -2048,  2676},
+    {2048, -2676,  2048, -1108}};
+
+/* 2048 * (u == 0 ? 1.0 : sqrt(2.0)) * cos((2 * x + 1) * u * PI / 4) */
+static const int idct2Weight[2][2] = {
+    {2048,  2048},
+    {2048, -2048}};
+
+
+
+/**
+ *  Inverse DCT of the eight rows of a block (in place).
+ *  For the internal calculation the values are scaled by 2048.
+ *  At the end the scaling is reversed.
+ */
+static void idctRows (intType block[JPEG_BLOCK_SIZE])
+
+  {
+    intType *row;
+    intType x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  /* idctRows */
+    for (row = block; row < &block[JPEG_BLOCK_SIZE]; row += 8) {
+      if ((row[1] | row[2] | row[3] | row[4] |
+           row[5] | row[6] | row[7]) == 0) {
+        row[1] = row[0];
+        row[2] = row[0];
+        row[3] = row[0];
+        row[4] = row[0];
+        row[5] = row[0];
+        row[6] = row[0];
+        row[7] = row[0];
+      } else {
+        x0 = row[0] * 2048 + 128;
+        x1 = row[4] * 2048;
+        x2 = row[6];
+        x3 = row[2];
+        x4 = row[1];
+        x5 = row[7];
+        x6 = row[5];
+        x7 = row[3];
+        /* First stage */
+        x8 = W7 * (x4 + x5);
+        x4 = x8 + (W1 - W7) * x4;
+        x5 = x8 - (W1 + W7) * x5;
+        x8 = W3 * (x6 + x7);
+        x6 = x8 - (W3 - W5) * x6;
+        x7 = x8 - (W3 + W5) * x7;
+        /* Second stage */
+        x8 = x0 + x1;
+        x0 -= x1;
+        x1 = W6 * (x3 + x2);
+        x2 = x1 - (W2 + W6) * x2;
+        x3 = x1 + (W2 - W6) * x3;
+        x1 = x4 + x6;
+        x4 -= x6;
+        x6 = x5 + x7;
+        x5 -= x7;
+        /* Third stage */
+        x7 = x8 + x3;
+        x8 -= x3;
+        x3 = x0 + x2;
+        x0 -= x2;
+        x2 = signedRShift(181 * (x4 + x5) + 128, 8);
+        x4 = signedRShift(181 * (x4 - x5) + 128, 8);
+        /* Fourth stage */
+        row[0] = signedRShift(x7 + x1, 11);
+        row[1] = signedRShift(x3 + x2, 11);
+        row[2] = signedRShift(x0 + x4, 11);
+        row[3] = signedRShift(x8 + x6, 11);
+        row[4] = signedRShift(x8 - x6, 11);
+        row[5] = signedRShift(x0 - x4, 11);
+        row[6] = signedRShift(x3 - x2, 11);
+        row[7] = signedRShift(x7 - x1, 11);
+      } /* if */
+    } /* for */
+  } /* idctRows */
+
+
+
+/**
+ *  Inverse DCT of the eight columns of a block (in place).
+ *  A column with only a DC value is transformed to eight copies
+ *  of the DC value, so no special case is necessary.
+ */
+static void idctColumns (intType block[JPEG_BLOCK_SIZE])
+
+  {
+    int column;
+    intType x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  /* idctColumns */
+    for (column = 0; column < 8; column++) {
+      x0 = block[column] * 2048 + 128;
+      x1 = block[column + 32] * 2048;
+      x2 = block[column + 48];
+      x3 = block[column + 16];
+      x4 = block[column + 8];
+      x5 = block[column + 56];
+      x6 = block[column + 40];
+      x7 = block[column + 24];
+      /* First stage */
+      x8 = W7 * (x4 + x5);
+      x4 = x8 + (W1 - W7) * x4;
+      x5 = x8 - (W1 + W7) * x5;
+      x8 = W3 * (x6 + x7);
+      x6 = x8 - (W3 - W5) * x6;
+      x7 = x8 - (W3 + W5) * x7;
+      /* Second stage */
+      x8 = x0 + x1;
+      x0 -= x1;
+      x1 = W6 * (x3 + x2);
+      x2 = x1 - (W2 + W6) * x2;
+      x3 = x1 + (W2 - W6) * x3;
+      x1 = x4 + x6;
+      x4 -= x6;
+      x6 = x5 + x7;
+      x5 -= x7;
+      /* Third stage */
+      x7 = x8 + x3;
+      x8 -= x3;
+      x3 = x0 + x2;
+      x0 -= x2;
+      x2 = signedRShift(181 * (x4 + x5) + 128, 8);
+      x4 = signedRShift(181 * (x4 - x5) + 128, 8);
+      /* Fourth stage */
+      block[column]      = signedRShift(x7 + x1, 11);
+      block[column + 8]  = signedRShift(x3 + x2, 11);
+      block[column + 16] = signedRShift(x0 + x4, 11);
+      block[column + 24] = signedRShift(x8 + x6, 11);
+      block[column + 32] = signedRShift(x8 - x6, 11);
+      block[column + 40] = signedRShift(x0 - x4, 11);
+      block[column + 48] = signedRShift(x3 - x2, 11);
+      block[column + 56] = signedRShift(x7 - x1, 11);
+    } /* for */
+  } /* idctColumns */
+
+
+
+/**
+ *  Reduced inverse DCT, which uses the size x size coefficients
+ *  with the lowest frequencies. The result is written to the
+ *  upper left size x size corner of the block. All other
+ *  elements of the block are set to zero.
+ */
+static void idctReduced (intType block[JPEG_BLOCK_SIZE], int size)
+
+  {
+    intType rows[4][4];
+    intType sum;
+    int line;
+    int column;
+    int freq;
+
+  /* idctReduced */
+    for (line = 0; line < size; line++) {
+      for (column = 0; column < size; column++) {
+        sum = 0;
+        for (freq = 0; freq < size; freq++) {
+          sum += (size == 4 ? idct4Weight[column][freq] :
+                              idct2Weight[column][freq]) *
+                 block[line * 8 + freq];
+        } /* for */
+        rows[line][column] = sum;
+      } /* for */
+    } /* for */
+    for (line = 0; line < JPEG_BLOCK_SIZE; line++) {
+      block[line] = 0;
+    } /* for */
+    for (line = 0; line < size; line++) {
+      for (column = 0; column < size; column++) {
+        sum = 1 << 21;
+        for (freq = 0; freq < size; freq++) {
+          sum += (size == 4 ? idct4Weight[line][freq] :
+                              idct2Weight[line][freq]) *
+                 rows[freq][column];
+        } /* for */
+        block[line * 8 + column] = signedRShift(sum, 22);
+      } /* for */
+    } /* for */
+  } /* idctReduced */
+
+
+
+/**
+ *  Dequantize, unzigzag and transform a JPEG block in place.
+ *  The 64 coefficients of dataBlock are in zigzag order. They are
+ *  multiplied with the corresponding elements of quantizationTable
+ *  (also in zigzag order) and transformed with an inverse DCT.
+ *  The result contains samples in natural order scaled with factor 8
+ *  (luma values are in the range -1024 .. 1023). The samples are not
+ *  clamped, so they might also be higher or lower than the limit.
+ *  If blockSize is 4, 2 or 1 only the upper left blockSize x blockSize
+ *  corner of the result contains samples and the other elements are 0.
+ *  This way an image is scaled down by 1/2, 1/4 or 1/8.
+ *  @param dataBlock Block with 64 coefficients, which is transformed.
+ *  @param quantizationTable Table with 64 quantization values.
+ *  @param blockSize Width and height of the resulting samples
+ *         (8, 4, 2 or 1).
+ *  @exception RANGE_ERROR If the arrays have less than 64 elements,
+ *             if blockSize is not 8, 4, 2 or 1 or if a coefficient
+ *             or a quantization value is out of range.
+ */
+void jpgIdct (rtlArrayType dataBlock,
+    const const_rtlArrayType quantizationTable, intType blockSize)
+
+  {
+    intType coefficient[JPEG_BLOCK_SIZE];
+    intType quantization[JPEG_BLOCK_SIZE];
+    intType block[JPEG_BLOCK_SIZE];
+    boolType outOfRange = FALSE;
+    int pos;
+
+  /* jpgIdct */
+    logFunction(printf("jpgIdct(arr (size=" FMT_U_MEM "), arr (size="
+                       FMT_U_MEM "), " FMT_D ")\n",
+                       arraySize(dataBlock), arraySize(quantizationTable),
+                       blockSize););
+    if (unlikely(arraySize(dataBlock) < JPEG_BLOCK_SIZE ||
+                 arraySize(quantizationTable) < JPEG_BLOCK_SIZE ||
+                 (blockSize != 8 && blockSize != 4 &&
+                  blockSize != 2 && blockSize != 1))) {
+      logError(printf("jpgIdct: Illegal block size (" FMT_D ") or arrays "
+                      "with less than %d elements.\n",
+                      blockSize, JPEG_BLOCK_SIZE););
+      raise_error(RANGE_ERROR);
+    } else {
+      for (pos = 0; pos < JPEG_BLOCK_SIZE; pos++) {
+        coefficient[pos] = dataBlock->arr[pos].value.intValue;
+        quantization[pos] = quantizationTable->arr[pos].value.intValue;
+        outOfRange |= coefficient[pos] < -MAX_COEFFICIENT ||
+                      coefficient[pos] > MAX_COEFFICIENT ||
+                      quantization[pos] < 0 ||
+                      quantization[pos] > MAX_QUANTIZATION;
+      } /* for */
+      if (unlikely(outOfRange)) {
+        logError(printf("jpgIdct: Coefficient or quantization value "
+                        "out of range.\n"););
+        raise_error(RANGE_ERROR);
+      } else {
+        for (pos = 0; pos < JPEG_BLOCK_SIZE; pos++) {
+          block[pos] = coefficient[zigzag[pos]] * quantization[zigzag[pos]];
+        } /* for */
+        if (blockSize == 8) {
+          idctRows(block);
+          idctColumns(block);
+        } else if (blockSize == 1) {
+          for (pos = 1; pos < JPEG_BLOCK_SIZE; pos++) {
+            block[pos] = 0;
+          } /* for */
+        } else {
+          idctReduced(block, (int) blockSize);
+        } /* if */
+        for (pos = 0; pos < JPEG_BLOCK_SIZE; pos++) {
+          dataBlock->arr[pos].value.intValue = block[pos];
+        } /* for */
+      } /* if */
+    } /* if */
+  } /* jpgIdct */
@@ -0,0 +1,97 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/jpglib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for JPEG block decoding.         */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "arrutl.h"
+#include "jpg_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "jpglib.h"
+
+
+
+
+/**
+ *  Dequantize, unzigzag and transform the JPEG block dataBlock/arg_1
+ *  in place. The coefficients are multiplied with the elements of
+ *  quantizationTable/arg_2 and transformed with an inverse DCT.
+ *  If blockSize/arg_3 is 4, 2 or 1 only the upper left corner of
+ *  dataBlock contains samples.
+ *  @exception RANGE_ERROR If the arrays have less than 64 elements,
+ *             if blockSize is not 8, 4, 2 or 1 or if a coefficient
+ *             or a quantization value is out of range.
+ */
+objectType jpg_idct (listType arguments)
+
+  {
+    objectType dataBlock_variable;
+    arrayType dataBlock;
+    rtlArrayType rtlDataBlock;
+    rtlArrayType quantizationTable;
+    memSizeType pos;
+
+  /* jpg_idct */
+    dataBlock_variable = arg_1(arguments);
+    isit_array(dataBlock_variable);
+    is_variable(dataBlock_variable);
+    isit_array(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    dataBlock = take_array(dataBlock_variable);
+    rtlDataBlock = gen_rtl_array(dataBlock);
+    quantizationTable = gen_rtl_array(take_array(arg_2(arguments)));
+    if (unlikely(rtlDataBlock == NULL || quantizationTable == NULL)) {
+      if (rtlDataBlock != NULL) {
+        FREE_RTL_ARRAY(rtlDataBlock, ARRAY_LENGTH(rtlDataBlock));
+      } /* if */
+      if (quantizationTable != NULL) {
+        FREE_RTL_ARRAY(quantizationTable, ARRAY_LENGTH(quantizationTable));
+      } /* if */
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } /* if */
+    jpgIdct(rtlDataBlock, quantizationTable, take_int(arg_3(arguments)));
+    for (pos = 0; pos < arraySize(dataBlock); pos++) {
+      dataBlock->arr[pos].value.intValue = rtlDataBlock->arr[pos].value.intValue;
+    } /* for */
+    FREE_RTL_ARRAY(rtlDataBlock, ARRAY_LENGTH(rtlDataBlock));
+    FREE_RTL_ARRAY(quantizationTable, ARRAY_LENGTH(quantizationTable));
+    return SYS_EMPTY_OBJECT;
+  } /* jpg_idct */
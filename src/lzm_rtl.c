@@ -0,0 +1,1402 @@
+/********************************************************************/
+/*                                                                  */
+/*  lzm_rtl.c     Primitive actions for LZMA decompression.         */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/lzm_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for LZMA decompression.              */
+/*                                                                  */
+/*  The decoder processes LZMA data (as used by .lzma files) and    */
+/*  LZMA2 data (as used by the blocks of .xz files). The state      */
+/*  keeps the probabilities of the range decoder and a buffer with  */
+/*  the dictionary and space for further output. The range decoder  */
+/*  reads the compressed bytes directly from the input string. As   */
+/*  long as enough input is present no bounds checks are necessary. */
+/*  Near the end of the input the probability changes of a symbol   */
+/*  are recorded, such that a symbol, which is not complete in the  */
+/*  input, can be undone. This way the data can be decompressed in  */
+/*  pieces of any size. Optionally a CRC-32 or CRC-64 check of the  */
+/*  decompressed data is computed.                                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "lzm_rtl.h"
+
+
+#define DECOMPRESS_MAGIC      0x6c7a6d64
+#define LZMA2_PROPERTIES      -1
+#define MIN_DICT_SIZE         4096
+#define MAX_DICT_SIZE         0xffffffff
+#define DECODE_PIECE          65536
+#define REQUIRED_INPUT_MAX    20  /* Maximum number of input bytes of one symbol. */
+#define UNDO_SIZE             64  /* Maximum number of probability changes of one symbol. */
+
+#define CHECK_NONE            0
+#define CHECK_CRC32           1
+#define CHECK_CRC64           4
+
+#define PROB_BITS             11
+#define PROB_INIT             (1 << (PROB_BITS - 1))
+#define MOVE_BITS             5
+#define TOP_VALUE             ((uint32Type) 1 << 24)
+
+#define NUM_STATES            12
+#define POS_BITS_MAX          4
+#define NUM_LEN_TO_POS_STATES 4
+#define NUM_POS_SLOT_BITS     6
+#define END_POS_MODEL_INDEX   14
+#define NUM_FULL_DISTANCES    (1 << (END_POS_MODEL_INDEX >> 1))
+#define NUM_ALIGN_BITS        4
+#define LEN_LOW_BITS          3
+#define LEN_MID_BITS          3
+#define LEN_HIGH_BITS         8
+#define MATCH_MIN_LEN         2
+#define LITERAL_CODER_SIZE    0x300
+#define LZMA2_LC_LP_MAX       4
+
+#define CHUNK_NONE            0
+#define CHUNK_LZMA            1
+#define CHUNK_UNCOMPRESSED    2
+
+#define DECODE_OK             0
+#define DECODE_ERROR          1
+#define DECODE_END_MARKER     2
+
+#define CRC64_POLYNOMIAL      UINT64_SUFFIX(0xc96c5795d7870f42)
+#define CRC32_POLYNOMIAL      0xedb88320
+
+
+typedef struct {
+    uint16Type choice;
+    uint16Type choice2;
+    uint16Type low[1 << POS_BITS_MAX][1 << LEN_LOW_BITS];
+    uint16Type mid[1 << POS_BITS_MAX][1 << LEN_MID_BITS];
+    uint16Type high[1 << LEN_HIGH_BITS];
+  } lenProbsType;
+
+/**
+ *  Probabilities of the range decoder (except the literal coder).
+ *  All elements are uint16Type, such that they can be initialized
+ *  like an array.
+ */
+typedef struct {
+    uint16Type isMatch[NUM_STATES][1 << POS_BITS_MAX];
+    uint16Type isRep[NUM_STATES];
+    uint16Type isRepG0[NUM_STATES];
+    uint16Type isRepG1[NUM_STATES];
+    uint16Type isRepG2[NUM_STATES];
+    uint16Type isRep0Long[NUM_STATES][1 << POS_BITS_MAX];
+    uint16Type posSlot[NUM_LEN_TO_POS_STATES][1 << NUM_POS_SLOT_BITS];
+    uint16Type posSpecial[1 + NUM_FULL_DISTANCES - END_POS_MODEL_INDEX];
+    uint16Type align[1 << NUM_ALIGN_BITS];
+    lenProbsType lenProbs;
+    lenProbsType repLenProbs;
+  } probsType;
+
+typedef struct {
+    uint32Type magic;
+    boolType lzma2;
+    boolType finished;
+    boolType rangeInitialized;
+    int checkType;
+    uint32Type crc32;
+    uint64Type crc64;
+    unsigned int lc;
+    unsigned int lp;
+    unsigned int pb;
+    memSizeType dictSize;
+    intType unpackSize;  /* -1 if the uncompressed size is unknown. */
+    uint64Type produced;
+    uint64Type processed;  /* Bytes since the last dictionary reset. */
+    uint32Type range;
+    uint32Type code;
+    unsigned int lzmaState;
+    uint32Type rep[4];
+    memSizeType remainLen;  /* Rest of a match, that did not fit into the output. */
+    int chunkType;
+    memSizeType chunkUnpacked;
+    memSizeType chunkPacked;
+    boolType needDictReset;
+    boolType needProperties;
+    memSizeType literalProbCount;
+    memSizeType bufferSize;
+    memSizeType outputPos;
+    memSizeType deliverPos;
+    probsType probs;
+    /* The literal probabilities (literalProbCount elements) and */
+    /* the buffer with bufferSize bytes follow.                  */
+  } decompressStateRecord, *decompressStateType;
+
+typedef const decompressStateRecord *const_decompressStateType;
+
+#define LITERAL_PROBS(state) ((uint16Type *) &(state)[1])
+#define WINDOW(state) ((ucharType *) &LITERAL_PROBS(state)[(state)->literalProbCount])
+
+typedef struct {
+    uint16Type *prob;
+    uint16Type value;
+  } undoType;
+
+/**
+ *  Output of a call. The string grows as needed up to limit.
+ */
+typedef struct {
+    striType stri;
+    memSizeType pos;
+    memSizeType capacity;
+    memSizeType limit;
+  } outputRecord, *outputType;
+
+static boolType crcTablesBuilt = FALSE;
+static uint32Type crc32Table[4][256];
+static uint64Type crc64Table[4][256];
+
+
+
+/**
+ *  Build the slice-by-4 tables of CRC-32 and CRC-64.
+ *  Table k contains the CRC of a byte followed by k zero bytes.
+ */
+static void buildCrcTables (void)
+
+  {
+    unsigned int index;
+    unsigned int bit;
+    unsigned int slice;
+    uint32Type crc32;
+    uint64Type crc64;
+
+  /* buildCrcTables */
+    for (index = 0; index < 256; index++) {
+      crc32 = (uint32Type) index;
+      crc64 = (uint64Type) index;
+      for (bit = 0; bit < 8; bit++) {
+        crc32 = (crc32 >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc32 & 1)));
+        crc64 = (crc64 >> 1) ^ (CRC64_POLYNOMIAL & (0 - (crc64 & 1)));
+      } /* for */
+      crc32Table[0][index] = crc32;
+      crc64Table[0][index] = crc64;
+    } /* for */
+    for (slice = 1; slice < 4; slice++) {
+      for (index = 0; index < 256; index++) {
+        crc32 = crc32Table[slice - 1][index];
+        crc32Table[slice][index] = (crc32 >> 8) ^ crc32Table[0][crc32 & 0xff];
+        crc64 = crc64Table[slice - 1][index];
+        crc64Table[slice][index] = (crc64 >> 8) ^ crc64Table[0][crc64 & 0xff];
+      } /* for */
+    } /* for */
+    crcTablesBuilt = TRUE;
+  } /* buildCrcTables */
+
+
+
+static uint32Type updateCrc32 (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  { /* updateCrc32 */
+    crc = ~crc;
+    for (; length >= 4; length -= 4) {
+      crc ^= (uint32Type) data[0] | (uint32Type) data[1] << 8 |
+             (uint32Type) data[2] << 16 | (uint32Type) data[3] << 24;
+      crc = crc32Table[3][crc & 0xff] ^ crc32Table[2][(crc >> 8) & 0xff] ^
+            crc32Table[1][(crc >> 16) & 0xff] ^ crc32Table[0][crc >> 24];
+      data += 4;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = (crc >> 8) ^ crc32Table[0][(crc ^ *data) & 0xff];
+      data++;
+    } /* for */
+    return ~crc;
+  } /* updateCrc32 */
+
+
+
+static uint64Type updateCrc64 (uint64Type crc, const ucharType *data,
+    memSizeType length)
+
+  { /* updateCrc64 */
+    crc = ~crc;
+    for (; length >= 4; length -= 4) {
+      crc ^= (uint64Type) ((uint32Type) data[0] | (uint32Type) data[1] << 8 |
+                           (uint32Type) data[2] << 16 | (uint32Type) data[3] << 24);
+      crc = crc64Table[3][crc & 0xff] ^ crc64Table[2][(crc >> 8) & 0xff] ^
+            crc64Table[1][(crc >> 16) & 0xff] ^ crc64Table[0][(crc >> 24) & 0xff] ^
+            (crc >> 32);
+      data += 4;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = (crc >> 8) ^ crc64Table[0][(crc ^ *data) & 0xff];
+      data++;
+    } /* for */
+    return ~crc;
+  } /* updateCrc64 */
+
+
+
+/**
+ *  Make sure that the output string has room for at least minimum
+ *  characters (but not more than allowed by the limit).
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType growOutput (outputType output, memSizeType minimum)
+
+  {
+    memSizeType newCapacity;
+    striType resized;
+
+  /* growOutput */
+    if (minimum > output->limit - output->pos) {
+      minimum = output->limit - output->pos;
+    } /* if */
+    if (output->capacity - output->pos < minimum) {
+      if (output->capacity > output->limit / 2) {
+        newCapacity = output->limit;
+      } else {
+        newCapacity = 2 * output->capacity;
+      } /* if */
+      if (newCapacity - output->pos < minimum) {
+        newCapacity = output->pos + minimum;
+      } /* if */
+      REALLOC_STRI_CHECK_SIZE(resized, output->stri, output->capacity, newCapacity);
+      if (unlikely(resized == NULL)) {
+        return FALSE;
+      } /* if */
+      COUNT3_STRI(output->capacity, newCapacity);
+      output->stri = resized;
+      output->capacity = newCapacity;
+    } /* if */
+    return TRUE;
+  } /* growOutput */
+
+
+
+/**
+ *  Shrink the output string to its actual size.
+ *  @return the output string, or NULL if there is not enough memory.
+ */
+static striType finishOutput (outputType output)
+
+  {
+    striType resized;
+
+  /* finishOutput */
+    if (output->pos != output->capacity) {
+      REALLOC_STRI_SIZE_OK(resized, output->stri, output->capacity, output->pos);
+      if (unlikely(resized == NULL)) {
+        FREE_STRI(output->stri, output->capacity);
+        return NULL;
+      } /* if */
+      COUNT3_STRI(output->capacity, output->pos);
+      output->stri = resized;
+    } /* if */
+    output->stri->size = output->pos;
+    return output->stri;
+  } /* finishOutput */
+
+
+
+/**
+ *  Set all probabilities to their initial value and reset the
+ *  state of the LZMA decoder.
+ */
+static void resetState (decompressStateType state)
+
+  {
+    uint16Type *probs;
+    memSizeType index;
+
+  /* resetState */
+    probs = (uint16Type *) &state->probs;
+    for (index = 0; index < sizeof(probsType) / sizeof(uint16Type); index++) {
+      probs[index] = PROB_INIT;
+    } /* for */
+    probs = LITERAL_PROBS(state);
+    for (index = 0; index < LITERAL_CODER_SIZE << (state->lc + state->lp); index++) {
+      probs[index] = PROB_INIT;
+    } /* for */
+    state->lzmaState = 0;
+    state->rep[0] = 0;
+    state->rep[1] = 0;
+    state->rep[2] = 0;
+    state->rep[3] = 0;
+    state->remainLen = 0;
+  } /* resetState */
+
+
+
+/**
+ *  Decode the lc, lp and pb values from an LZMA properties byte.
+ *  @return FALSE if the properties byte is not valid.
+ */
+static boolType setProperties (decompressStateType state, unsigned int properties)
+
+  { /* setProperties */
+    if (properties >= 9 * 5 * 5) {
+      return FALSE;
+    } /* if */
+    state->lc = properties % 9;
+    properties /= 9;
+    state->lp = properties % 5;
+    state->pb = properties / 5;
+    return TRUE;
+  } /* setProperties */
+
+
+
+/**
+ *  Start the range decoder with five bytes from input.
+ *  @return FALSE if the bytes are not valid.
+ */
+static boolType initRangeDecoder (decompressStateType state,
+    const strElemType *input)
+
+  {
+    unsigned int index;
+
+  /* initRangeDecoder */
+    if (unlikely(input[0] != 0)) {
+      return FALSE;
+    } /* if */
+    state->code = 0;
+    for (index = 1; index <= 4; index++) {
+      if (unlikely(input[index] > 255)) {
+        return FALSE;
+      } /* if */
+      state->code = (state->code << 8) | (uint32Type) input[index];
+    } /* for */
+    state->range = 0xffffffff;
+    return state->code != state->range;
+  } /* initRangeDecoder */
+
+
+
+static inline void copyMatch (ucharType *window, memSizeType outPos,
+    memSizeType distance, memSizeType length)
+
+  {
+    ucharType *dest;
+    const ucharType *source;
+
+  /* copyMatch */
+    dest = &window[outPos];
+    source = dest - distance;
+    if (distance >= length) {
+      memcpy(dest, source, length);
+    } else {
+      do {
+        *dest++ = *source++;
+      } while (--length != 0);
+    } /* if */
+  } /* copyMatch */
+
+
+
+/* Bytes beyond the end of the input are read as 0. Such a  */
+/* symbol is undone afterwards. */
+#define NEXT_BYTE(dest) \
+    if (likely(inPos < inputSize)) { \
+      if (unlikely(input[inPos] > 255)) { \
+        goto invalidData; \
+      } \
+      dest = (uint32Type) input[inPos]; \
+    } else { \
+      dest = 0; \
+    } \
+    inPos++;
+
+#define NORMALIZE \
+    if (range < TOP_VALUE) { \
+      NEXT_BYTE(byteValue); \
+      range <<= 8; \
+      code = (code << 8) | byteValue; \
+    }
+
+#define SET_PROB(probPtr, newValue) \
+    if (safe) { \
+      undo[undoCount].prob = (probPtr); \
+      undo[undoCount].value = *(probPtr); \
+      undoCount++; \
+    } \
+    *(probPtr) = (uint16Type) (newValue);
+
+#define DECODE_BIT(probPtr, bit) { \
+    uint16Type *prob_ = (probPtr); \
+    uint32Type bound_; \
+    NORMALIZE \
+    bound_ = (range >> PROB_BITS) * *prob_; \
+    if (code < bound_) { \
+      range = bound_; \
+      SET_PROB(prob_, *prob_ + (((1 << PROB_BITS) - *prob_) >> MOVE_BITS)); \
+      bit = 0; \
+    } else { \
+      range -= bound_; \
+      code -= bound_; \
+      SET_PROB(prob_, *prob_ - (*prob_ >> MOVE_BITS)); \
+      bit = 1; \
+    } }
+
+#define BIT_TREE(probs, numBits, result) { \
+    unsigned int index_; \
+    unsigned int bit_; \
+    result = 1; \
+    for (index_ = 0; index_ < (numBits); index_++) { \
+      DECODE_BIT(&(probs)[result], bit_); \
+      result = (result << 1) | bit_; \
+    } \
+    result -= 1 << (numBits); }
+
+#define BIT_TREE_REVERSE(probs, numBits, result) { \
+    unsigned int index_; \
+    unsigned int bit_; \
+    unsigned int node_ = 1; \
+    result = 0; \
+    for (index_ = 0; index_ < (numBits); index_++) { \
+      DECODE_BIT(&(probs)[node_], bit_); \
+      node_ = (node_ << 1) | bit_; \
+      result |= bit_ << index_; \
+    } }
+
+#define DECODE_LEN(lenProbs, posState, len) { \
+    unsigned int choice_; \
+    DECODE_BIT(&(lenProbs)->choice, choice_); \
+    if (choice_ == 0) { \
+      BIT_TREE((lenProbs)->low[posState], LEN_LOW_BITS, len); \
+    } else { \
+      DECODE_BIT(&(lenProbs)->choice2, choice_); \
+      if (choice_ == 0) { \
+        BIT_TREE((lenProbs)->mid[posState], LEN_MID_BITS, len); \
+        len += 1 << LEN_LOW_BITS; \
+      } else { \
+        BIT_TREE((lenProbs)->high, LEN_HIGH_BITS, len); \
+        len += (1 << LEN_LOW_BITS) + (1 << LEN_MID_BITS); \
+      } \
+    } }
+
+
+
+/**
+ *  Decode LZMA symbols until the output reaches outLimit, the end
+ *  marker is found or the input is exhausted. A symbol that is not
+ *  complete in the input is undone. If inputComplete is TRUE the
+ *  input cannot be continued and such a symbol is an error. If
+ *  markerOnly is TRUE exactly one symbol is decoded, which must
+ *  be the end marker.
+ *  @param used Number of input bytes, that have been processed.
+ *  @return DECODE_OK, DECODE_ERROR or DECODE_END_MARKER.
+ */
+static int decodeLzma (decompressStateType state, const strElemType *input,
+    memSizeType inputSize, boolType inputComplete, memSizeType outLimit,
+    boolType markerOnly, memSizeType *used)
+
+  {
+    probsType *probs;
+    uint16Type *literalProbs;
+    uint16Type *prob;
+    ucharType *window;
+    memSizeType inPos = 0;
+    uint32Type range;
+    uint32Type code;
+    uint32Type byteValue;
+    memSizeType outPos;
+    uint64Type processed;
+    unsigned int lzmaState;
+    uint32Type rep0, rep1, rep2, rep3;
+    memSizeType remainLen;
+    unsigned int lc;
+    uint32Type lpMask;
+    uint32Type pbMask;
+    memSizeType dictSize;
+    unsigned int posState;
+    unsigned int symbol;
+    unsigned int bit;
+    unsigned int matchByte;
+    unsigned int matchBit;
+    unsigned int len;
+    unsigned int posSlot;
+    unsigned int numDirectBits;
+    unsigned int extra;
+    uint32Type distance;
+    memSizeType copyLen;
+    boolType safe = FALSE;
+    undoType undo[UNDO_SIZE];
+    unsigned int undoCount = 0;
+    memSizeType savedInPos = 0;
+    uint32Type savedRange = 0;
+    uint32Type savedCode = 0;
+    memSizeType savedOutPos = 0;
+    uint64Type savedProcessed = 0;
+    unsigned int savedState = 0;
+    uint32Type savedRep[4] = {0, 0, 0, 0};
+    int result = DECODE_OK;
+
+  /* decodeLzma */
+    probs = &state->probs;
+    literalProbs = LITERAL_PROBS(state);
+    window = WINDOW(state);
+    range = state->range;
+    code = state->code;
+    outPos = state->outputPos;
+    processed = state->processed;
+    lzmaState = state->lzmaState;
+    rep0 = state->rep[0];
+    rep1 = state->rep[1];
+    rep2 = state->rep[2];
+    rep3 = state->rep[3];
+    remainLen = state->remainLen;
+    lc = state->lc;
+    lpMask = ((uint32Type) 1 << state->lp) - 1;
+    pbMask = ((uint32Type) 1 << state->pb) - 1;
+    dictSize = state->dictSize;
+    for (;;) {
+      if (remainLen != 0) {
+        copyLen = outLimit - outPos;
+        if (copyLen > remainLen) {
+          copyLen = remainLen;
+        } /* if */
+        if (copyLen == 0) {
+          break;
+        } /* if */
+        copyMatch(window, outPos, (memSizeType) rep0 + 1, copyLen);
+        outPos += copyLen;
+        processed += copyLen;
+        remainLen -= copyLen;
+        continue;
+      } else if (outPos >= outLimit && !markerOnly) {
+        break;
+      } /* if */
+      if (inputSize - inPos < REQUIRED_INPUT_MAX || inPos > inputSize) {
+        safe = TRUE;
+        undoCount = 0;
+        savedInPos = inPos;
+        savedRange = range;
+        savedCode = code;
+        savedOutPos = outPos;
+        savedProcessed = processed;
+        savedState = lzmaState;
+        savedRep[0] = rep0;
+        savedRep[1] = rep1;
+        savedRep[2] = rep2;
+        savedRep[3] = rep3;
+      } else {
+        safe = FALSE;
+      } /* if */
+      posState = (unsigned int) processed & pbMask;
+      DECODE_BIT(&probs->isMatch[lzmaState][posState], bit);
+      if (bit == 0) {
+        symbol = processed == 0 ? 0 : window[outPos - 1];
+        prob = &literalProbs[LITERAL_CODER_SIZE *
+            ((((unsigned int) processed & lpMask) << lc) + (symbol >> (8 - lc)))];
+        symbol = 1;
+        if (lzmaState >= 7) {
+          matchByte = window[outPos - rep0 - 1];
+          do {
+            matchBit = (matchByte >> 7) & 1;
+            matchByte <<= 1;
+            DECODE_BIT(&prob[((1 + matchBit) << 8) + symbol], bit);
+            symbol = (symbol << 1) | bit;
+          } while (symbol < 0x100 && matchBit == bit);
+        } /* if */
+        while (symbol < 0x100) {
+          DECODE_BIT(&prob[symbol], bit);
+          symbol = (symbol << 1) | bit;
+        } /* while */
+        if (unlikely(outPos >= outLimit)) {
+          goto invalidData;
+        } /* if */
+        window[outPos++] = (ucharType) symbol;
+        processed++;
+        lzmaState = lzmaState < 4 ? 0 : (lzmaState < 10 ? lzmaState - 3 : lzmaState - 6);
+      } else {
+        DECODE_BIT(&probs->isRep[lzmaState], bit);
+        if (bit == 0) {
+          DECODE_LEN(&probs->lenProbs, posState, len);
+          lzmaState = lzmaState < 7 ? 7 : 10;
+          BIT_TREE(probs->posSlot[len < NUM_LEN_TO_POS_STATES ?
+                                  len : NUM_LEN_TO_POS_STATES - 1],
+                   NUM_POS_SLOT_BITS, posSlot);
+          if (posSlot < 4) {
+            distance = posSlot;
+          } else {
+            numDirectBits = (posSlot >> 1) - 1;
+            distance = (2 | (posSlot & 1)) << numDirectBits;
+            if (posSlot < END_POS_MODEL_INDEX) {
+              BIT_TREE_REVERSE(&probs->posSpecial[distance - posSlot],
+                               numDirectBits, extra);
+              distance += extra;
+            } else {
+              for (numDirectBits -= NUM_ALIGN_BITS; numDirectBits != 0; numDirectBits--) {
+                NORMALIZE;
+                range >>= 1;
+                code -= range;
+                extra = 0 - (code >> 31);
+                code += range & extra;
+                distance += (extra + 1) << (numDirectBits + NUM_ALIGN_BITS - 1);
+              } /* for */
+              BIT_TREE_REVERSE(probs->align, NUM_ALIGN_BITS, extra);
+              distance += extra;
+            } /* if */
+          } /* if */
+          if (distance == 0xffffffff) {
+            NORMALIZE;
+            if (unlikely(inPos > inputSize || code != 0)) {
+              goto invalidData;
+            } /* if */
+            result = DECODE_END_MARKER;
+            break;
+          } /* if */
+          rep3 = rep2;
+          rep2 = rep1;
+          rep1 = rep0;
+          rep0 = distance;
+        } else {
+          DECODE_BIT(&probs->isRepG0[lzmaState], bit);
+          if (bit == 0) {
+            DECODE_BIT(&probs->isRep0Long[lzmaState][posState], bit);
+            if (bit == 0) {
+              if (unlikely(rep0 >= processed || outPos >= outLimit)) {
+                goto invalidData;
+              } /* if */
+              lzmaState = lzmaState < 7 ? 9 : 11;
+              window[outPos] = window[outPos - rep0 - 1];
+              outPos++;
+              processed++;
+              goto symbolDecoded;
+            } /* if */
+          } else {
+            DECODE_BIT(&probs->isRepG1[lzmaState], bit);
+            if (bit == 0) {
+              distance = rep1;
+            } else {
+              DECODE_BIT(&probs->isRepG2[lzmaState], bit);
+              if (bit == 0) {
+                distance = rep2;
+              } else {
+                distance = rep3;
+                rep3 = rep2;
+              } /* if */
+              rep2 = rep1;
+            } /* if */
+            rep1 = rep0;
+            rep0 = distance;
+          } /* if */
+          DECODE_LEN(&probs->repLenProbs, posState, len);
+          lzmaState = lzmaState < 7 ? 8 : 11;
+        } /* if */
+        if (unlikely(rep0 >= processed || rep0 >= dictSize || outPos >= outLimit)) {
+          goto invalidData;
+        } /* if */
+        len += MATCH_MIN_LEN;
+        copyLen = outLimit - outPos;
+        if (copyLen > len) {
+          copyLen = len;
+        } /* if */
+        copyMatch(window, outPos, (memSizeType) rep0 + 1, copyLen);
+        outPos += copyLen;
+        processed += copyLen;
+        remainLen = len - copyLen;
+      } /* if */
+    symbolDecoded:
+      if (safe && inPos > inputSize) {
+        goto invalidData;
+      } /* if */
+      if (markerOnly) {
+        goto invalidData;
+      } /* if */
+    } /* for */
+    goto done;
+
+  invalidData:
+    if (safe && inPos > inputSize && !inputComplete) {
+      /* The symbol is not complete in the input. */
+      while (undoCount != 0) {
+        undoCount--;
+        *undo[undoCount].prob = undo[undoCount].value;
+      } /* while */
+      inPos = savedInPos;
+      range = savedRange;
+      code = savedCode;
+      outPos = savedOutPos;
+      processed = savedProcessed;
+      lzmaState = savedState;
+      rep0 = savedRep[0];
+      rep1 = savedRep[1];
+      rep2 = savedRep[2];
+      rep3 = savedRep[3];
+      remainLen = 0;
+    } else {
+      result = DECODE_ERROR;
+    } /* if */
+
+  done:
+    state->range = range;
+    state->code = code;
+    state->outputPos = outPos;
+    state->processed = processed;
+    state->lzmaState = lzmaState;
+    state->rep[0] = rep0;
+    state->rep[1] = rep1;
+    state->rep[2] = rep2;
+    state->rep[3] = rep3;
+    state->remainLen = remainLen;
+    *used = inPos;
+    return result;
+  } /* decodeLzma */
+
+
+
+/**
+ *  Normalize the range decoder at the end of the data.
+ *  @return 1 if a byte has been used, 0 if no byte was necessary
+ *          and -1 if a byte is necessary but the input is empty.
+ */
+static int finishRange (decompressStateType state,
+    const strElemType *input, memSizeType inputSize)
+
+  { /* finishRange */
+    if (state->range < TOP_VALUE) {
+      if (inputSize == 0) {
+        return -1;
+      } else if (unlikely(input[0] > 255)) {
+        state->code = 1;
+        return 1;
+      } /* if */
+      state->range <<= 8;
+      state->code = (state->code << 8) | (uint32Type) input[0];
+      return 1;
+    } /* if */
+    return 0;
+  } /* finishRange */
+
+
+
+/**
+ *  Compute the limit of the output position for the next decoding
+ *  step. At least DECODE_PIECE bytes are decoded if there is room.
+ */
+static memSizeType outputLimit (const_decompressStateType state,
+    memSizeType wanted, memSizeType maximum)
+
+  {
+    memSizeType room;
+
+  /* outputLimit */
+    room = state->bufferSize - state->outputPos;
+    if (wanted < DECODE_PIECE) {
+      wanted = DECODE_PIECE;
+    } /* if */
+    if (room > wanted) {
+      room = wanted;
+    } /* if */
+    if (room > maximum) {
+      room = maximum;
+    } /* if */
+    return state->outputPos + room;
+  } /* outputLimit */
+
+
+
+/**
+ *  Decode LZMA data (as used by .lzma files). The data ends with
+ *  an end marker or when the uncompressed size has been reached.
+ *  @return the number of input bytes used or -1 if the data is
+ *          not valid.
+ */
+static intType decodeLzmaStep (decompressStateType state,
+    const strElemType *input, memSizeType inputSize, memSizeType wanted)
+
+  {
+    memSizeType used = 0;
+    memSizeType maximum = MAX_MEMSIZETYPE;
+    boolType markerOnly = FALSE;
+    int finish;
+    memSizeType decoded;
+    int result;
+
+  /* decodeLzmaStep */
+    if (!state->rangeInitialized) {
+      if (inputSize < 5) {
+        return 0;
+      } else if (unlikely(!initRangeDecoder(state, input))) {
+        return -1;
+      } /* if */
+      state->rangeInitialized = TRUE;
+      used = 5;
+    } /* if */
+    if (state->unpackSize >= 0) {
+      maximum = (memSizeType) ((uint64Type) state->unpackSize - state->produced);
+      if (maximum == 0) {
+        if (unlikely(state->remainLen != 0)) {
+          return -1;
+        } /* if */
+        finish = finishRange(state, &input[used], inputSize - used);
+        if (finish < 0) {
+          return (intType) used;
+        } /* if */
+        used += (memSizeType) finish;
+        if (state->code == 0) {
+          state->finished = TRUE;
+          return (intType) used;
+        } /* if */
+        markerOnly = TRUE;
+      } /* if */
+    } /* if */
+    if (!markerOnly && state->outputPos == state->bufferSize) {
+      return -1;
+    } /* if */
+    result = decodeLzma(state, &input[used], inputSize - used, FALSE,
+                        outputLimit(state, wanted, maximum), markerOnly,
+                        &decoded);
+    used += decoded;
+    if (result == DECODE_ERROR) {
+      return -1;
+    } else if (result == DECODE_END_MARKER) {
+      state->finished = TRUE;
+    } /* if */
+    return (intType) used;
+  } /* decodeLzmaStep */
+
+
+
+/**
+ *  Decode the chunks of LZMA2 data (as used by .xz files).
+ *  Uncompressed chunks are copied. LZMA chunks are decoded with
+ *  a new range decoder. The data ends with a control byte of 0.
+ *  @return the number of input bytes used or -1 if the data is
+ *          not valid.
+ */
+static intType decodeLzma2Step (decompressStateType state,
+    const strElemType *input, memSizeType inputSize, memSizeType wanted)
+
+  {
+    unsigned int control;
+    unsigned int index;
+    memSizeType headerSize;
+    memSizeType available;
+    memSizeType used = 0;
+    memSizeType decoded;
+    memSizeType outputStart;
+    ucharType *dest;
+    int finish;
+    int result;
+
+  /* decodeLzma2Step */
+    if (state->chunkType == CHUNK_NONE) {
+      if (inputSize < 1) {
+        return 0;
+      } else if (unlikely(input[0] > 255)) {
+        return -1;
+      } /* if */
+      control = (unsigned int) input[0];
+      if (control == 0) {
+        state->finished = TRUE;
+        return 1;
+      } else if (control < 0x80 && control > 2) {
+        return -1;
+      } /* if */
+      headerSize = control >= 0xc0 ? 6 : (control >= 0x80 ? 5 : 3);
+      if (inputSize < headerSize + (control >= 0x80 ? 5 : 0)) {
+        return 0;
+      } /* if */
+      for (index = 1; index < headerSize; index++) {
+        if (unlikely(input[index] > 255)) {
+          return -1;
+        } /* if */
+      } /* for */
+      if (control >= 0xe0 || control == 1) {
+        state->needProperties = TRUE;
+        state->processed = 0;
+      } else if (unlikely(state->needDictReset)) {
+        return -1;
+      } /* if */
+      state->needDictReset = FALSE;
+      if (control >= 0x80) {
+        state->chunkUnpacked = (((memSizeType) control & 0x1f) << 16) +
+            ((memSizeType) input[1] << 8) + (memSizeType) input[2] + 1;
+        state->chunkPacked = ((memSizeType) input[3] << 8) +
+            (memSizeType) input[4] + 1;
+        if (control >= 0xc0) {
+          if (unlikely(!setProperties(state, (unsigned int) input[5]) ||
+                       state->lc + state->lp > LZMA2_LC_LP_MAX)) {
+            return -1;
+          } /* if */
+          state->needProperties = FALSE;
+        } else if (unlikely(state->needProperties)) {
+          return -1;
+        } /* if */
+        if (control >= 0xa0) {
+          resetState(state);
+        } /* if */
+        if (unlikely(state->chunkPacked < 5 ||
+                     !initRangeDecoder(state, &input[headerSize]))) {
+          return -1;
+        } /* if */
+        state->chunkPacked -= 5;
+        state->chunkType = CHUNK_LZMA;
+        used = headerSize + 5;
+      } else {
+        state->chunkUnpacked = ((memSizeType) input[1] << 8) +
+            (memSizeType) input[2] + 1;
+        state->chunkType = CHUNK_UNCOMPRESSED;
+        used = headerSize;
+      } /* if */
+    } /* if */
+    if (state->chunkUnpacked != 0 && state->outputPos == state->bufferSize) {
+      return -1;
+    } /* if */
+    outputStart = state->outputPos;
+    if (state->chunkType == CHUNK_UNCOMPRESSED) {
+      available = outputLimit(state, wanted, state->chunkUnpacked) - outputStart;
+      if (available > inputSize - used) {
+        available = inputSize - used;
+      } /* if */
+      dest = &WINDOW(state)[outputStart];
+      for (index = 0; index < available; index++) {
+        if (unlikely(input[used + index] > 255)) {
+          return -1;
+        } /* if */
+        dest[index] = (ucharType) input[used + index];
+      } /* for */
+      used += available;
+      state->outputPos += available;
+      state->processed += available;
+      state->chunkUnpacked -= available;
+      if (state->chunkUnpacked == 0) {
+        state->chunkType = CHUNK_NONE;
+      } /* if */
+    } else {
+      if (state->chunkUnpacked != 0) {
+        available = inputSize - used;
+        if (available > state->chunkPacked) {
+          available = state->chunkPacked;
+        } /* if */
+        result = decodeLzma(state, &input[used], available,
+                            available == state->chunkPacked,
+                            outputLimit(state, wanted, state->chunkUnpacked),
+                            FALSE, &decoded);
+        if (result != DECODE_OK) {
+          return -1;
+        } /* if */
+        used += decoded;
+        state->chunkPacked -= decoded;
+        state->chunkUnpacked -= state->outputPos - outputStart;
+      } /* if */
+      if (state->chunkUnpacked == 0) {
+        if (unlikely(state->remainLen != 0)) {
+          return -1;
+        } /* if */
+        available = inputSize - used;
+        if (available > state->chunkPacked) {
+          available = state->chunkPacked;
+        } /* if */
+        finish = finishRange(state, &input[used], available);
+        if (finish < 0) {
+          if (state->chunkPacked == 0) {
+            return -1;
+          } /* if */
+        } else {
+          used += (memSizeType) finish;
+          state->chunkPacked -= (memSizeType) finish;
+          if (unlikely(state->chunkPacked != 0 || state->code != 0)) {
+            return -1;
+          } /* if */
+          state->chunkType = CHUNK_NONE;
+        } /* if */
+      } /* if */
+    } /* if */
+    return (intType) used;
+  } /* decodeLzma2Step */
+
+
+
+/**
+ *  Make room for the next decoding step. The buffer keeps the last
+ *  dictSize bytes, which can be referred by matches.
+ */
+static void slideWindow (decompressStateType state)
+
+  {
+    memSizeType keep;
+
+  /* slideWindow */
+    if (state->bufferSize - state->outputPos < DECODE_PIECE) {
+      keep = state->outputPos < state->dictSize ?
+          state->outputPos : state->dictSize;
+      if (keep != state->outputPos) {
+        memmove(WINDOW(state), &WINDOW(state)[state->outputPos - keep], keep);
+        state->outputPos = keep;
+        state->deliverPos = keep;
+      } /* if */
+    } /* if */
+  } /* slideWindow */
+
+
+
+/**
+ *  Decode the next piece of data and update the check.
+ *  @return the number of input bytes used or -1 if the data is
+ *          not valid.
+ */
+static intType decodeStep (decompressStateType state,
+    const strElemType *input, memSizeType inputSize, memSizeType wanted)
+
+  {
+    memSizeType outputStart;
+    memSizeType produced;
+    intType used;
+
+  /* decodeStep */
+    slideWindow(state);
+    outputStart = state->outputPos;
+    if (state->lzma2) {
+      used = decodeLzma2Step(state, input, inputSize, wanted);
+    } else {
+      used = decodeLzmaStep(state, input, inputSize, wanted);
+    } /* if */
+    if (likely(used >= 0)) {
+      produced = state->outputPos - outputStart;
+      state->produced += produced;
+      if (unlikely(state->unpackSize >= 0 &&
+                   (state->produced > (uint64Type) state->unpackSize ||
+                    (state->finished &&
+                     state->produced != (uint64Type) state->unpackSize)))) {
+        return -1;
+      } /* if */
+      if (state->checkType == CHECK_CRC32) {
+        state->crc32 = updateCrc32(state->crc32, &WINDOW(state)[outputStart], produced);
+      } else if (state->checkType == CHECK_CRC64) {
+        state->crc64 = updateCrc64(state->crc64, &WINDOW(state)[outputStart], produced);
+      } /* if */
+    } /* if */
+    return used;
+  } /* decodeStep */
+
+
+
+static boolType isDecompressState (const const_bstriType state)
+
+  {
+    const_decompressStateType decompressState;
+
+  /* isDecompressState */
+    decompressState = (const_decompressStateType) state->mem;
+    return state->size >= sizeof(decompressStateRecord) &&
+        decompressState->magic == DECOMPRESS_MAGIC &&
+        state->size == sizeof(decompressStateRecord) +
+        decompressState->literalProbCount * sizeof(uint16Type) +
+        decompressState->bufferSize;
+  } /* isDecompressState */
+
+
+
+/**
+ *  Decompress LZMA or LZMA2 data from compressed[*position].
+ *  The header of the data (e.g. the header of a .lzma file or the
+ *  block header of a .xz file) must have been read before and its
+ *  values must have been used to create the state. The decompression
+ *  stops if maxLength characters have been produced, if the end of
+ *  the data has been reached or if the rest of the compressed data
+ *  does not contain a complete symbol. Afterwards *position refers
+ *  to the first byte that has not been processed. To continue with
+ *  more data the unprocessed bytes must be passed again.
+ *  @param state Decompress state created with lzmDecompressInit.
+ *  @param compressed Compressed data (only bytes are allowed).
+ *  @param position Position (starting with 1) in compressed.
+ *  @param maxLength Maximum number of characters to be produced.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid decompress state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in LZMA or LZMA2 format.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType lzmDecompress (bstriType state, const const_striType compressed,
+    intType *const position, intType maxLength)
+
+  {
+    decompressStateType decompressState;
+    memSizeType inPos;
+    outputRecord output;
+    memSizeType available;
+    memSizeType index;
+    memSizeType outputStart;
+    const ucharType *source;
+    intType used;
+    striType result;
+
+  /* lzmDecompress */
+    logFunction(printf("lzmDecompress(*, \"%s\", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *position, maxLength););
+    if (unlikely(!isDecompressState(state) || maxLength < 0 || *position <= 0)) {
+      logError(printf("lzmDecompress: Illegal state, maxLength (" FMT_D
+                      ") or position (" FMT_D ").\n", maxLength, *position););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* The memory of a bstring is aligned like memSizeType. */
+    decompressState = (decompressStateType) state->mem;
+    if ((uintType) *position > compressed->size) {
+      inPos = compressed->size;
+    } else {
+      inPos = (memSizeType) *position - 1;
+    } /* if */
+    if ((uintType) maxLength > MAX_STRI_LEN) {
+      output.limit = MAX_STRI_LEN;
+    } else {
+      output.limit = (memSizeType) maxLength;
+    } /* if */
+    output.capacity = output.limit < DECODE_PIECE ? output.limit : DECODE_PIECE;
+    output.pos = 0;
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(output.stri, output.capacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    while (output.pos < output.limit) {
+      if (decompressState->deliverPos < decompressState->outputPos) {
+        available = decompressState->outputPos - decompressState->deliverPos;
+        if (unlikely(!growOutput(&output, available))) {
+          FREE_STRI(output.stri, output.capacity);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+        if (available > output.capacity - output.pos) {
+          available = output.capacity - output.pos;
+        } /* if */
+        source = &WINDOW(decompressState)[decompressState->deliverPos];
+        for (index = 0; index < available; index++) {
+          output.stri->mem[output.pos + index] = source[index];
+        } /* for */
+        output.pos += available;
+        decompressState->deliverPos += available;
+      } else if (decompressState->finished) {
+        break;
+      } else {
+        outputStart = decompressState->outputPos;
+        used = decodeStep(decompressState, &compressed->mem[inPos],
+                          compressed->size - inPos, output.limit - output.pos);
+        if (unlikely(used < 0)) {
+          FREE_STRI(output.stri, output.capacity);
+          logError(printf("lzmDecompress: Data not in LZMA format.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } else if (used == 0 && !decompressState->finished &&
+                   decompressState->outputPos == outputStart) {
+          break;
+        } /* if */
+        inPos += (memSizeType) used;
+      } /* if */
+    } /* while */
+    *position = (intType) inPos + 1;
+    result = finishOutput(&output);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    logFunction(printf("lzmDecompress --> \"%s\" (position=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *position););
+    return result;
+  } /* lzmDecompress */
+
+
+
+/**
+ *  Get the check of the data that has been decompressed so far.
+ *  @param state Decompress state created with lzmDecompressInit.
+ *  @return the CRC-32 (4 bytes) or CRC-64 (8 bytes) in little endian
+ *          byte order, or "" if no check is computed.
+ *  @exception RANGE_ERROR The state is not a valid decompress state.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType lzmDecompressCheck (const const_bstriType state)
+
+  {
+    const_decompressStateType decompressState;
+    memSizeType length;
+    uint64Type check;
+    memSizeType index;
+    striType result;
+
+  /* lzmDecompressCheck */
+    if (unlikely(!isDecompressState(state))) {
+      logError(printf("lzmDecompressCheck: Illegal state.\n"););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    decompressState = (const_decompressStateType) state->mem;
+    if (decompressState->checkType == CHECK_CRC32) {
+      length = 4;
+      check = decompressState->crc32;
+    } else if (decompressState->checkType == CHECK_CRC64) {
+      length = 8;
+      check = decompressState->crc64;
+    } else {
+      length = 0;
+      check = 0;
+    } /* if */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, length))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result->size = length;
+    for (index = 0; index < length; index++) {
+      result->mem[index] = (strElemType) ((check >> (8 * index)) & 0xff);
+    } /* for */
+    return result;
+  } /* lzmDecompressCheck */
+
+
+
+/**
+ *  Determine if LZMA or LZMA2 data has been decompressed completely.
+ *  @param state Decompress state created with lzmDecompressInit.
+ *  @return TRUE if the end of the data has been reached and all
+ *          data has been delivered, FALSE otherwise.
+ *  @exception RANGE_ERROR The state is not a valid decompress state.
+ */
+boolType lzmDecompressFinished (const const_bstriType state)
+
+  {
+    const_decompressStateType decompressState;
+
+  /* lzmDecompressFinished */
+    if (unlikely(!isDecompressState(state))) {
+      logError(printf("lzmDecompressFinished: Illegal state.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    decompressState = (const_decompressStateType) state->mem;
+    return decompressState->finished &&
+        decompressState->deliverPos == decompressState->outputPos;
+  } /* lzmDecompressFinished */
+
+
+
+/**
+ *  Create a state for the decompression of LZMA or LZMA2 data.
+ *  The state keeps a buffer with the dictionary and space to decode
+ *  further data. If the uncompressed size is known the buffer is
+ *  not larger than the uncompressed data.
+ *  @param properties The lc/lp/pb properties byte of LZMA data or
+ *         -1 for LZMA2 data (which contains the properties).
+ *  @param dictSize Dictionary size.
+ *  @param unpackSize Uncompressed size or -1 if it is unknown.
+ *  @param checkType Check of the uncompressed data (0: None,
+ *         1: CRC-32, 4: CRC-64), as defined by the .xz format.
+ *  @return the initial decompress state.
+ *  @exception RANGE_ERROR One of the parameters is not valid.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType lzmDecompressInit (intType properties, intType dictSize,
+    intType unpackSize, intType checkType)
+
+  {
+    decompressStateType decompressState;
+    decompressStateRecord stateRecord;
+    memSizeType literalProbCount;
+    memSizeType bufferSize;
+    memSizeType extra;
+    memSizeType headerSize;
+    bstriType result;
+
+  /* lzmDecompressInit */
+    logFunction(printf("lzmDecompressInit(" FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ")\n",
+                       properties, dictSize, unpackSize, checkType););
+    memset(&stateRecord, 0, sizeof(decompressStateRecord));
+    if (unlikely(properties < LZMA2_PROPERTIES ||
+                 (properties != LZMA2_PROPERTIES &&
+                  !setProperties(&stateRecord, (unsigned int) properties)) ||
+                 dictSize < 0 || (uintType) dictSize > MAX_DICT_SIZE ||
+                 unpackSize < -1 ||
+                 (checkType != CHECK_NONE && checkType != CHECK_CRC32 &&
+                  checkType != CHECK_CRC64))) {
+      logError(printf("lzmDecompressInit: Illegal properties (" FMT_D
+                      "), dictSize (" FMT_D "), unpackSize (" FMT_D
+                      ") or checkType (" FMT_D ").\n",
+                      properties, dictSize, unpackSize, checkType););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    if (dictSize < MIN_DICT_SIZE) {
+      dictSize = MIN_DICT_SIZE;
+    } /* if */
+    if (properties == LZMA2_PROPERTIES) {
+      literalProbCount = LITERAL_CODER_SIZE << LZMA2_LC_LP_MAX;
+    } else {
+      literalProbCount = LITERAL_CODER_SIZE << (stateRecord.lc + stateRecord.lp);
+    } /* if */
+    /* Room for at least four pieces after the dictionary. */
+    extra = (memSizeType) dictSize / 2;
+    if (extra < 4 * DECODE_PIECE) {
+      extra = 4 * DECODE_PIECE;
+    } /* if */
+    if ((uintType) dictSize > MAX_MEMSIZETYPE - extra) {
+      bufferSize = MAX_MEMSIZETYPE;
+    } else {
+      bufferSize = (memSizeType) dictSize + extra;
+    } /* if */
+    if (unpackSize >= 0 && (uintType) unpackSize < bufferSize) {
+      bufferSize = (memSizeType) unpackSize;
+    } /* if */
+    headerSize = sizeof(decompressStateRecord) + literalProbCount * sizeof(uint16Type);
+    if (unlikely(bufferSize > MAX_BSTRI_LEN - headerSize ||
+                 !ALLOC_BSTRI_SIZE_OK(result, headerSize + bufferSize))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    if (!crcTablesBuilt) {
+      buildCrcTables();
+    } /* if */
+    result->size = headerSize + bufferSize;
+    decompressState = (decompressStateType) result->mem;
+    memcpy(decompressState, &stateRecord, sizeof(decompressStateRecord));
+    decompressState->magic = DECOMPRESS_MAGIC;
+    decompressState->lzma2 = properties == LZMA2_PROPERTIES;
+    decompressState->checkType = (int) checkType;
+    decompressState->dictSize = (memSizeType) dictSize;
+    decompressState->unpackSize = unpackSize;
+    decompressState->needDictReset = TRUE;
+    decompressState->needProperties = TRUE;
+    decompressState->literalProbCount = literalProbCount;
+    decompressState->bufferSize = bufferSize;
+    if (!decompressState->lzma2) {
+      resetState(decompressState);
+    } /* if */
+    return result;
+  } /* lzmDecompressInit */
@@ -0,0 +1,136 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/lzmlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for LZMA decompression.          */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "lzm_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "lzmlib.h"
+
+
+
+
+/**
+ *  Decompress LZMA or LZMA2 data from compressed/arg_2 starting at position/arg_3.
+ *  The decompression stops if maxLength/arg_4 characters have been
+ *  produced, if the end of the data has been reached or if the rest
+ *  of the compressed data does not contain a complete symbol. The
+ *  decompress state/arg_1 and position/arg_3 are updated.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid decompress state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in LZMA or LZMA2 format.
+ */
+objectType lzm_decompress (listType arguments)
+
+  {
+    objectType state_variable;
+    objectType position_variable;
+
+  /* lzm_decompress */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    position_variable = arg_3(arguments);
+    isit_int(position_variable);
+    is_variable(position_variable);
+    isit_int(arg_4(arguments));
+    return bld_stri_temp(
+        lzmDecompress(take_bstri(state_variable),
+                      take_stri(arg_2(arguments)),
+                      &position_variable->value.intValue,
+                      take_int(arg_4(arguments))));
+  } /* lzm_decompress */
+
+
+
+/**
+ *  Get the check of the data that has been decompressed so far.
+ *  @return the CRC-32 or CRC-64 as string of bytes in little endian
+ *          byte order, or "" if the state/arg_1 computes no check.
+ *  @exception RANGE_ERROR The state/arg_1 is not a valid decompress state.
+ */
+objectType lzm_decompress_check (listType arguments)
+
+  { /* lzm_decompress_check */
+    isit_bstri(arg_1(arguments));
+    return bld_stri_temp(lzmDecompressCheck(take_bstri(arg_1(arguments))));
+  } /* lzm_decompress_check */
+
+
+
+/**
+ *  Determine if LZMA or LZMA2 data has been decompressed completely.
+ *  @return TRUE if all data has been decompressed, FALSE otherwise.
+ *  @exception RANGE_ERROR The state/arg_1 is not a valid decompress state.
+ */
+objectType lzm_decompress_finished (listType arguments)
+
+  { /* lzm_decompress_finished */
+    isit_bstri(arg_1(arguments));
+    if (lzmDecompressFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* lzm_decompress_finished */
+
+
+
+/**
+ *  Create a state for the decompression of LZMA or LZMA2 data.
+ *  @return the initial decompress state for the properties/arg_1
+ *          (-1 for LZMA2), the dictSize/arg_2, the unpackSize/arg_3
+ *          and the checkType/arg_4.
+ *  @exception RANGE_ERROR One of the parameters is not valid.
+ */
+objectType lzm_decompress_init (listType arguments)
+
+  { /* lzm_decompress_init */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    return bld_bstri_temp(lzmDecompressInit(take_int(arg_1(arguments)),
+                                            take_int(arg_2(arguments)),
+                                            take_int(arg_3(arguments)),
+                                            take_int(arg_4(arguments))));
+  } /* lzm_decompress_init */
@@ -0,0 +1,1290 @@
+/********************************************************************/
+/*                                                                  */
+/*  mdg_rtl.c     Primitive actions for message digests.            */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/mdg_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for message digests.                 */
+/*                                                                  */
+/*  The algorithms are identified with the ordinal numbers of the   */
+/*  enumeration type digestAlgorithm from msgdigest.s7i. MD5,       */
+/*  SHA-1, SHA-224, SHA-256, SHA-384 and SHA-512 are supported.     */
+/*  If the processor supports the SHA extensions the block          */
+/*  functions of SHA-1 and SHA-256 use them. This is checked at     */
+/*  runtime. The CRC-32 checksum uses slice-by-16 tables or, if     */
+/*  the processor supports PCLMULQDQ, carry-less multiplication.    */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_SHA_NI_INTRINSICS || HAS_PCLMUL_INTRINSICS
+#include "cpuid.h"
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "mdg_rtl.h"
+
+
+/* Ordinal numbers of the enumeration type digestAlgorithm. */
+#define DIGEST_MD5     2
+#define DIGEST_SHA1    4
+#define DIGEST_SHA224  5
+#define DIGEST_SHA256  6
+#define DIGEST_SHA384  7
+#define DIGEST_SHA512  8
+
+#define MAX_BLOCK_SIZE   128
+#define MAX_DIGEST_SIZE   64
+#define CONVERSION_BUFFER_SIZE 4096
+#define CRC32_POLYNOMIAL 0xedb88320
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define GET_UINT32_LE(p) ((uint32Type) (p)[0]        | \
+                          (uint32Type) (p)[1] <<  8 | \
+                          (uint32Type) (p)[2] << 16 | \
+                          (uint32Type) (p)[3] << 24)
+#define GET_UINT32_BE(p) ((uint32Type) (p)[0] << 24 | \
+                          (uint32Type) (p)[1] << 16 | \
+                          (uint32Type) (p)[2] <<  8 | \
+                          (uint32Type) (p)[3])
+#define GET_UINT64_BE(p) ((uint64Type) GET_UINT32_BE(p) << 32 | \
+                          (uint64Type) GET_UINT32_BE(&(p)[4]))
+
+/**
+ *  State of an incremental message digest computation.
+ *  The state is stored in the memory of a bstring. Therefore it
+ *  must not contain pointers.
+ */
+typedef struct {
+    intType algorithm;
+    uint64Type length;
+    union {
+      uint32Type h32[8];
+      uint64Type h64[8];
+    } hash;
+    memSizeType bufferLength;
+    ucharType buffer[MAX_BLOCK_SIZE];
+  } digestStateRecord, *digestStateType;
+
+typedef void (*blockFuncType) (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks);
+
+typedef uint32Type (*crc32FuncType) (uint32Type crc, const ucharType *data,
+    memSizeType length);
+
+static const uint32Type md5K[] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+    0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+    0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+    0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+    0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+    0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+  };
+
+static const uint32Type sha256K[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+static const uint64Type sha512K[] = {
+    UINT64_SUFFIX(0x428a2f98d728ae22), UINT64_SUFFIX(0x7137449123ef65cd),
+    UINT64_SUFFIX(0xb5c0fbcfec4d3b2f), UINT64_SUFFIX(0xe9b5dba58189dbbc),
+    UINT64_SUFFIX(0x3956c25bf348b538), UINT64_SUFFIX(0x59f111f1b605d019),
+    UINT64_SUFFIX(0x923f82a4af194f9b), UINT64_SUFFIX(0xab1c5ed5da6d8118),
+    UINT64_SUFFIX(0xd807aa98a3030242), UINT64_SUFFIX(0x12835b0145706fbe),
+    UINT64_SUFFIX(0x243185be4ee4b28c), UINT64_SUFFIX(0x550c7dc3d5ffb4e2),
+    UINT64_SUFFIX(0x72be5d74f27b896f), UINT64_SUFFIX(0x80deb1fe3b1696b1),
+    UINT64_SUFFIX(0x9bdc06a725c71235), UINT64_SUFFIX(0xc19bf174cf692694),
+    UINT64_SUFFIX(0xe49b69c19ef14ad2), UINT64_SUFFIX(0xefbe4786384f25e3),
+    UINT64_SUFFIX(0x0fc19dc68b8cd5b5), UINT64_SUFFIX(0x240ca1cc77ac9c65),
+    UINT64_SUFFIX(0x2de92c6f592b0275), UINT64_SUFFIX(0x4a7484aa6ea6e483),
+    UINT64_SUFFIX(0x5cb0a9dcbd41fbd4), UINT64_SUFFIX(0x76f988da831153b5),
+    UINT64_SUFFIX(0x983e5152ee66dfab), UINT64_SUFFIX(0xa831c66d2db43210),
+    UINT64_SUFFIX(0xb00327c898fb213f), UINT64_SUFFIX(0xbf597fc7beef0ee4),
+    UINT64_SUFFIX(0xc6e00bf33da88fc2), UINT64_SUFFIX(0xd5a79147930aa725),
+    UINT64_SUFFIX(0x06ca6351e003826f), UINT64_SUFFIX(0x142929670a0e6e70),
+    UINT64_SUFFIX(0x27b70a8546d22ffc), UINT64_SUFFIX(0x2e1b21385c26c926),
+    UINT64_SUFFIX(0x4d2c6dfc5ac42aed), UINT64_SUFFIX(0x53380d139d95b3df),
+    UINT64_SUFFIX(0x650a73548baf63de), UINT64_SUFFIX(0x766a0abb3c77b2a8),
+    UINT64_SUFFIX(0x81c2c92e47edaee6), UINT64_SUFFIX(0x92722c851482353b),
+    UINT64_SUFFIX(0xa2bfe8a14cf10364), UINT64_SUFFIX(0xa81a664bbc423001),
+    UINT64_SUFFIX(0xc24b8b70d0f89791), UINT64_SUFFIX(0xc76c51a30654be30),
+    UINT64_SUFFIX(0xd192e819d6ef5218), UINT64_SUFFIX(0xd69906245565a910),
+    UINT64_SUFFIX(0xf40e35855771202a), UINT64_SUFFIX(0x106aa07032bbd1b8),
+    UINT64_SUFFIX(0x19a4c116b8d2d0c8), UINT64_SUFFIX(0x1e376c085141ab53),
+    UINT64_SUFFIX(0x2748774cdf8eeb99), UINT64_SUFFIX(0x34b0bcb5e19b48a8),
+    UINT64_SUFFIX(0x391c0cb3c5c95a63), UINT64_SUFFIX(0x4ed8aa4ae3418acb),
+    UINT64_SUFFIX(0x5b9cca4f7763e373), UINT64_SUFFIX(0x682e6ff3d6b2b8a3),
+    UINT64_SUFFIX(0x748f82ee5defb2fc), UINT64_SUFFIX(0x78a5636f43172f60),
+    UINT64_SUFFIX(0x84c87814a1f0ab72), UINT64_SUFFIX(0x8cc702081a6439ec),
+    UINT64_SUFFIX(0x90befffa23631e28), UINT64_SUFFIX(0xa4506cebde82bde9),
+    UINT64_SUFFIX(0xbef9a3f7b2c67915), UINT64_SUFFIX(0xc67178f2e372532b),
+    UINT64_SUFFIX(0xca273eceea26619c), UINT64_SUFFIX(0xd186b8c721c0c207),
+    UINT64_SUFFIX(0xeada7dd6cde0eb1e), UINT64_SUFFIX(0xf57d4f7fee6ed178),
+    UINT64_SUFFIX(0x06f067aa72176fba), UINT64_SUFFIX(0x0a637dc5a2c898a6),
+    UINT64_SUFFIX(0x113f9804bef90dae), UINT64_SUFFIX(0x1b710b35131c471b),
+    UINT64_SUFFIX(0x28db77f523047d84), UINT64_SUFFIX(0x32caab7b40c72493),
+    UINT64_SUFFIX(0x3c9ebe0a15c9bebc), UINT64_SUFFIX(0x431d67c49c100d4c),
+    UINT64_SUFFIX(0x4cc5d4becb3e42b6), UINT64_SUFFIX(0x597f299cfc657e2a),
+    UINT64_SUFFIX(0x5fcb6fab3ad6faec), UINT64_SUFFIX(0x6c44198c4a475817)
+  };
+
+static const uint32Type sha224Init[] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+    0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+  };
+
+static const uint32Type sha256Init[] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+
+static const uint64Type sha384Init[] = {
+    UINT64_SUFFIX(0xcbbb9d5dc1059ed8), UINT64_SUFFIX(0x629a292a367cd507),
+    UINT64_SUFFIX(0x9159015a3070dd17), UINT64_SUFFIX(0x152fecd8f70e5939),
+    UINT64_SUFFIX(0x67332667ffc00b31), UINT64_SUFFIX(0x8eb44a8768581511),
+    UINT64_SUFFIX(0xdb0c2e0d64f98fa7), UINT64_SUFFIX(0x47b5481dbefa4fa4)
+  };
+
+static const uint64Type sha512Init[] = {
+    UINT64_SUFFIX(0x6a09e667f3bcc908), UINT64_SUFFIX(0xbb67ae8584caa73b),
+    UINT64_SUFFIX(0x3c6ef372fe94f82b), UINT64_SUFFIX(0xa54ff53a5f1d36f1),
+    UINT64_SUFFIX(0x510e527fade682d1), UINT64_SUFFIX(0x9b05688c2b3e6c1f),
+    UINT64_SUFFIX(0x1f83d9abfb41bd6b), UINT64_SUFFIX(0x5be0cd19137e2179)
+  };
+
+static const uint8Type md5Shift[] = {
+    7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+  };
+
+static blockFuncType sha1BlockFunc = NULL;
+static blockFuncType sha256BlockFunc = NULL;
+
+/* Slice-by-16 tables, created with createCrc32Tables. */
+static uint32Type crc32Table[16][256];
+static crc32FuncType crc32Func = NULL;
+
+
+
+#define MD5_STEP(func, index) \
+    f = a + (func) + md5K[i] + x[index]; \
+    a = d; \
+    d = c; \
+    c = b; \
+    b += ROTL32(f, md5Shift[((i >> 2) & 12) | (i & 3)]);
+
+
+
+static void md5Blocks (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type x[16];
+    uint32Type a, b, c, d, f;
+    unsigned int i;
+
+  /* md5Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (i = 0; i < 16; i++) {
+        x[i] = GET_UINT32_LE(&data[4 * i]);
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      for (i = 0; i < 16; i++) {
+        MD5_STEP(d ^ (b & (c ^ d)), i);
+      } /* for */
+      for (; i < 32; i++) {
+        MD5_STEP(c ^ (d & (b ^ c)), (5 * i + 1) & 15);
+      } /* for */
+      for (; i < 48; i++) {
+        MD5_STEP(b ^ c ^ d, (3 * i + 5) & 15);
+      } /* for */
+      for (; i < 64; i++) {
+        MD5_STEP(c ^ (b | ~d), (7 * i) & 15);
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+    } /* for */
+  } /* md5Blocks */
+
+
+
+#define SHA1_STEP(funcAndConst) \
+    temp = ROTL32(a, 5) + (funcAndConst) + e + w[i]; \
+    e = d; \
+    d = c; \
+    c = ROTL32(b, 30); \
+    b = a; \
+    a = temp;
+
+
+
+static void sha1BlocksPortable (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type w[80];
+    uint32Type a, b, c, d, e, temp;
+    unsigned int i;
+
+  /* sha1BlocksPortable */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (i = 0; i < 16; i++) {
+        w[i] = GET_UINT32_BE(&data[4 * i]);
+      } /* for */
+      for (; i < 80; i++) {
+        temp = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+        w[i] = ROTL32(temp, 1);
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      for (i = 0; i < 20; i++) {
+        SHA1_STEP((d ^ (b & (c ^ d))) + 0x5a827999);
+      } /* for */
+      for (; i < 40; i++) {
+        SHA1_STEP((b ^ c ^ d) + 0x6ed9eba1);
+      } /* for */
+      for (; i < 60; i++) {
+        SHA1_STEP(((b & c) | (d & (b | c))) + 0x8f1bbcdc);
+      } /* for */
+      for (; i < 80; i++) {
+        SHA1_STEP((b ^ c ^ d) + 0xca62c1d6);
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+    } /* for */
+  } /* sha1BlocksPortable */
+
+
+
+/* The roles of the variables rotate instead of moving the values. */
+#define SHA256_STEP(a, b, c, d, e, f, g, h, i) \
+    temp = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + \
+        (g ^ (e & (f ^ g))) + sha256K[i] + w[i]; \
+    d += temp; \
+    h = temp + (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + \
+        ((a & b) | (c & (a | b)));
+
+
+
+static void sha256BlocksPortable (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type w[64];
+    uint32Type a, b, c, d, e, f, g, h;
+    uint32Type s0, s1, temp;
+    unsigned int i;
+
+  /* sha256BlocksPortable */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      for (i = 0; i < 16; i++) {
+        w[i] = GET_UINT32_BE(&data[4 * i]);
+      } /* for */
+      for (; i < 64; i++) {
+        s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      f = hash[5];
+      g = hash[6];
+      h = hash[7];
+      for (i = 0; i < 64; i += 8) {
+        SHA256_STEP(a, b, c, d, e, f, g, h, i);
+        SHA256_STEP(h, a, b, c, d, e, f, g, i + 1);
+        SHA256_STEP(g, h, a, b, c, d, e, f, i + 2);
+        SHA256_STEP(f, g, h, a, b, c, d, e, i + 3);
+        SHA256_STEP(e, f, g, h, a, b, c, d, i + 4);
+        SHA256_STEP(d, e, f, g, h, a, b, c, i + 5);
+        SHA256_STEP(c, d, e, f, g, h, a, b, i + 6);
+        SHA256_STEP(b, c, d, e, f, g, h, a, i + 7);
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+      hash[5] += f;
+      hash[6] += g;
+      hash[7] += h;
+    } /* for */
+  } /* sha256BlocksPortable */
+
+
+
+#define SHA512_STEP(a, b, c, d, e, f, g, h, i) \
+    temp = h + (ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41)) + \
+        (g ^ (e & (f ^ g))) + sha512K[i] + w[i]; \
+    d += temp; \
+    h = temp + (ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39)) + \
+        ((a & b) | (c & (a | b)));
+
+
+
+static void sha512Blocks (uint64Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint64Type w[80];
+    uint64Type a, b, c, d, e, f, g, h;
+    uint64Type s0, s1, temp;
+    unsigned int i;
+
+  /* sha512Blocks */
+    for (; numBlocks != 0; numBlocks--, data += 128) {
+      for (i = 0; i < 16; i++) {
+        w[i] = GET_UINT64_BE(&data[8 * i]);
+      } /* for */
+      for (; i < 80; i++) {
+        s0 = ROTR64(w[i - 15], 1) ^ ROTR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        s1 = ROTR64(w[i - 2], 19) ^ ROTR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+      } /* for */
+      a = hash[0];
+      b = hash[1];
+      c = hash[2];
+      d = hash[3];
+      e = hash[4];
+      f = hash[5];
+      g = hash[6];
+      h = hash[7];
+      for (i = 0; i < 80; i += 8) {
+        SHA512_STEP(a, b, c, d, e, f, g, h, i);
+        SHA512_STEP(h, a, b, c, d, e, f, g, i + 1);
+        SHA512_STEP(g, h, a, b, c, d, e, f, i + 2);
+        SHA512_STEP(f, g, h, a, b, c, d, e, i + 3);
+        SHA512_STEP(e, f, g, h, a, b, c, d, i + 4);
+        SHA512_STEP(d, e, f, g, h, a, b, c, i + 5);
+        SHA512_STEP(c, d, e, f, g, h, a, b, i + 6);
+        SHA512_STEP(b, c, d, e, f, g, h, a, i + 7);
+      } /* for */
+      hash[0] += a;
+      hash[1] += b;
+      hash[2] += c;
+      hash[3] += d;
+      hash[4] += e;
+      hash[5] += f;
+      hash[6] += g;
+      hash[7] += h;
+    } /* for */
+  } /* sha512Blocks */
+
+
+
+#if HAS_SHA_NI_INTRINSICS
+#define SHA1_ROUNDS(msg, func) \
+    eRounds = _mm_sha1nexte_epu32(eSaved, msg); \
+    eSaved = abcd; \
+    abcd = _mm_sha1rnds4_epu32(abcd, eRounds, func);
+
+/* Computes the message words msg_i from msg_i-4 .. msg_i-1. */
+#define SHA1_SCHEDULE(msg0, msg1, msg2, msg3) \
+    msg0 = _mm_sha1msg2_epu32(_mm_xor_si128( \
+        _mm_sha1msg1_epu32(msg0, msg1), msg2), msg3);
+
+
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha1BlocksShaNi (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    const __m128i byteSwapMask = _mm_set_epi64x(
+        INT64_SUFFIX(0x0001020304050607), INT64_SUFFIX(0x08090a0b0c0d0e0f));
+    __m128i abcd, abcdStart, eStart, eSaved, eRounds;
+    __m128i msg0, msg1, msg2, msg3;
+
+  /* sha1BlocksShaNi */
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) hash), 0x1b);
+    eSaved = _mm_set_epi32((int) hash[4], 0, 0, 0);
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      abcdStart = abcd;
+      eStart = eSaved;
+      msg0 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[0]), byteSwapMask);
+      msg1 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[16]), byteSwapMask);
+      msg2 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[32]), byteSwapMask);
+      msg3 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[48]), byteSwapMask);
+      eRounds = _mm_add_epi32(eSaved, msg0);
+      eSaved = abcd;
+      abcd = _mm_sha1rnds4_epu32(abcd, eRounds, 0);
+      SHA1_ROUNDS(msg1, 0);
+      SHA1_ROUNDS(msg2, 0);
+      SHA1_ROUNDS(msg3, 0);
+      SHA1_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA1_ROUNDS(msg0, 0);
+      SHA1_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA1_ROUNDS(msg1, 1);
+      SHA1_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA1_ROUNDS(msg2, 1);
+      SHA1_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA1_ROUNDS(msg3, 1);
+      SHA1_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA1_ROUNDS(msg0, 1);
+      SHA1_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA1_ROUNDS(msg1, 1);
+      SHA1_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA1_ROUNDS(msg2, 2);
+      SHA1_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA1_ROUNDS(msg3, 2);
+      SHA1_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA1_ROUNDS(msg0, 2);
+      SHA1_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA1_ROUNDS(msg1, 2);
+      SHA1_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA1_ROUNDS(msg2, 2);
+      SHA1_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA1_ROUNDS(msg3, 3);
+      SHA1_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA1_ROUNDS(msg0, 3);
+      SHA1_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA1_ROUNDS(msg1, 3);
+      SHA1_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA1_ROUNDS(msg2, 3);
+      SHA1_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA1_ROUNDS(msg3, 3);
+      eSaved = _mm_sha1nexte_epu32(eSaved, eStart);
+      abcd = _mm_add_epi32(abcd, abcdStart);
+    } /* for */
+    _mm_storeu_si128((__m128i *) hash, _mm_shuffle_epi32(abcd, 0x1b));
+    hash[4] = (uint32Type) _mm_extract_epi32(eSaved, 3);
+  } /* sha1BlocksShaNi */
+
+
+
+#define SHA256_ROUNDS(msg, k) \
+    temp = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i *) &sha256K[k])); \
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, temp); \
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(temp, 0x0e));
+
+/* Computes the message words msg_i from msg_i-4 .. msg_i-1. */
+#define SHA256_SCHEDULE(msg0, msg1, msg2, msg3) \
+    msg0 = _mm_sha256msg2_epu32(_mm_add_epi32( \
+        _mm_sha256msg1_epu32(msg0, msg1), \
+        _mm_alignr_epi8(msg3, msg2, 4)), msg3);
+
+
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256BlocksShaNi (uint32Type *hash, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    const __m128i byteSwapMask = _mm_set_epi64x(
+        INT64_SUFFIX(0x0c0d0e0f08090a0b), INT64_SUFFIX(0x0405060700010203));
+    __m128i abef, cdgh, abefStart, cdghStart, temp;
+    __m128i msg0, msg1, msg2, msg3;
+
+  /* sha256BlocksShaNi */
+    temp = _mm_shuffle_epi32(_mm_loadu_si128(
+        (const __m128i *) &hash[0]), 0xb1);                 /* CDAB */
+    cdgh = _mm_shuffle_epi32(_mm_loadu_si128(
+        (const __m128i *) &hash[4]), 0x1b);                 /* EFGH */
+    abef = _mm_alignr_epi8(temp, cdgh, 8);                  /* ABEF */
+    cdgh = _mm_blend_epi16(cdgh, temp, 0xf0);               /* CDGH */
+    for (; numBlocks != 0; numBlocks--, data += 64) {
+      abefStart = abef;
+      cdghStart = cdgh;
+      msg0 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[0]), byteSwapMask);
+      msg1 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[16]), byteSwapMask);
+      msg2 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[32]), byteSwapMask);
+      msg3 = _mm_shuffle_epi8(_mm_loadu_si128(
+          (const __m128i *) &data[48]), byteSwapMask);
+      SHA256_ROUNDS(msg0, 0);
+      SHA256_ROUNDS(msg1, 4);
+      SHA256_ROUNDS(msg2, 8);
+      SHA256_ROUNDS(msg3, 12);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg0, 16);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg1, 20);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg2, 24);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg3, 28);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg0, 32);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg1, 36);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg2, 40);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg3, 44);
+      SHA256_SCHEDULE(msg0, msg1, msg2, msg3);
+      SHA256_ROUNDS(msg0, 48);
+      SHA256_SCHEDULE(msg1, msg2, msg3, msg0);
+      SHA256_ROUNDS(msg1, 52);
+      SHA256_SCHEDULE(msg2, msg3, msg0, msg1);
+      SHA256_ROUNDS(msg2, 56);
+      SHA256_SCHEDULE(msg3, msg0, msg1, msg2);
+      SHA256_ROUNDS(msg3, 60);
+      abef = _mm_add_epi32(abef, abefStart);
+      cdgh = _mm_add_epi32(cdgh, cdghStart);
+    } /* for */
+    temp = _mm_shuffle_epi32(abef, 0x1b);                   /* FEBA */
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);                   /* DCHG */
+    _mm_storeu_si128((__m128i *) &hash[0],
+        _mm_blend_epi16(temp, cdgh, 0xf0));                 /* DCBA */
+    _mm_storeu_si128((__m128i *) &hash[4],
+        _mm_alignr_epi8(cdgh, temp, 8));                    /* HGFE */
+  } /* sha256BlocksShaNi */
+
+
+
+static boolType cpuHasShaExtensions (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+
+  /* cpuHasShaExtensions */
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+           (ecx & (1 << 9)) != 0 &&   /* SSSE3 */
+           (ecx & (1 << 19)) != 0 &&  /* SSE4.1 */
+           __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+           (ebx & (1 << 29)) != 0;    /* SHA */
+  } /* cpuHasShaExtensions */
+#endif
+
+
+
+static void selectBlockFunctions (void)
+
+  { /* selectBlockFunctions */
+#if HAS_SHA_NI_INTRINSICS
+    if (cpuHasShaExtensions()) {
+      sha1BlockFunc = sha1BlocksShaNi;
+      sha256BlockFunc = sha256BlocksShaNi;
+    } else
+#endif
+    {
+      sha1BlockFunc = sha1BlocksPortable;
+      sha256BlockFunc = sha256BlocksPortable;
+    }
+    logFunction(printf("selectBlockFunctions: SHA extensions %s\n",
+                       sha1BlockFunc == sha1BlocksPortable ?
+                       "not used" : "used"););
+  } /* selectBlockFunctions */
+
+
+
+static void createCrc32Tables (void)
+
+  {
+    unsigned int index;
+    unsigned int slice;
+    unsigned int bit;
+    uint32Type crc;
+
+  /* createCrc32Tables */
+    for (index = 0; index < 256; index++) {
+      crc = (uint32Type) index;
+      for (bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+      } /* for */
+      crc32Table[0][index] = crc;
+    } /* for */
+    for (index = 0; index < 256; index++) {
+      for (slice = 1; slice < 16; slice++) {
+        crc = crc32Table[slice - 1][index];
+        crc32Table[slice][index] = (crc >> 8) ^ crc32Table[0][crc & 0xff];
+      } /* for */
+    } /* for */
+  } /* createCrc32Tables */
+
+
+
+/**
+ *  Update a CRC-32 shift register with 16 bytes per step.
+ *  The register is used without the initial and final inversion.
+ */
+static uint32Type crc32SliceBy16 (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  {
+    uint32Type word0;
+    uint32Type word1;
+    uint32Type word2;
+    uint32Type word3;
+
+  /* crc32SliceBy16 */
+    for (; length >= 16; length -= 16) {
+      word0 = crc ^ GET_UINT32_LE(data);
+      word1 = GET_UINT32_LE(&data[4]);
+      word2 = GET_UINT32_LE(&data[8]);
+      word3 = GET_UINT32_LE(&data[12]);
+      crc = crc32Table[15][word0 & 0xff] ^
+            crc32Table[14][(word0 >> 8) & 0xff] ^
+            crc32Table[13][(word0 >> 16) & 0xff] ^
+            crc32Table[12][word0 >> 24] ^
+            crc32Table[11][word1 & 0xff] ^
+            crc32Table[10][(word1 >> 8) & 0xff] ^
+            crc32Table[ 9][(word1 >> 16) & 0xff] ^
+            crc32Table[ 8][word1 >> 24] ^
+            crc32Table[ 7][word2 & 0xff] ^
+            crc32Table[ 6][(word2 >> 8) & 0xff] ^
+            crc32Table[ 5][(word2 >> 16) & 0xff] ^
+            crc32Table[ 4][word2 >> 24] ^
+            crc32Table[ 3][word3 & 0xff] ^
+            crc32Table[ 2][(word3 >> 8) & 0xff] ^
+            crc32Table[ 1][(word3 >> 16) & 0xff] ^
+            crc32Table[ 0][word3 >> 24];
+      data += 16;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = crc32Table[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+      data++;
+    } /* for */
+    return crc;
+  } /* crc32SliceBy16 */
+
+
+
+#if HAS_PCLMUL_INTRINSICS
+/* Fold 128 bits of acc forward and add the next 128 bits of data. */
+#define CRC32_FOLD(acc, k, next) \
+    acc = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x00), \
+                                      _mm_clmulepi64_si128(acc, k, 0x11)), \
+                        next)
+
+/**
+ *  Update a CRC-32 shift register with carry-less multiplication.
+ *  The data is folded with 4 registers of 128 bits. Afterwards the
+ *  registers are folded into one, which is reduced to 32 bits with
+ *  a Barrett reduction. The constants are powers of x modulo the
+ *  bit-reflected polynomial (see the Intel paper "Fast CRC
+ *  Computation for Generic Polynomials Using PCLMULQDQ").
+ *  Bytes that do not fill 16 bytes are processed with slice-by-16.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32Type crc32Pclmul (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  {
+    __m128i x1, x2, x3, x4, k, mask;
+
+  /* crc32Pclmul */
+    if (length >= 64) {
+      x1 = _mm_loadu_si128((const __m128i *) &data[0]);
+      x2 = _mm_loadu_si128((const __m128i *) &data[16]);
+      x3 = _mm_loadu_si128((const __m128i *) &data[32]);
+      x4 = _mm_loadu_si128((const __m128i *) &data[48]);
+      x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+      data += 64;
+      length -= 64;
+      k = _mm_set_epi64x(0x1c6e41596, 0x154442bd4);
+      for (; length >= 64; length -= 64) {
+        CRC32_FOLD(x1, k, _mm_loadu_si128((const __m128i *) &data[0]));
+        CRC32_FOLD(x2, k, _mm_loadu_si128((const __m128i *) &data[16]));
+        CRC32_FOLD(x3, k, _mm_loadu_si128((const __m128i *) &data[32]));
+        CRC32_FOLD(x4, k, _mm_loadu_si128((const __m128i *) &data[48]));
+        data += 64;
+      } /* for */
+      k = _mm_set_epi64x(0x0ccaa009e, 0x1751997d0);
+      CRC32_FOLD(x1, k, x2);
+      CRC32_FOLD(x1, k, x3);
+      CRC32_FOLD(x1, k, x4);
+      for (; length >= 16; length -= 16) {
+        CRC32_FOLD(x1, k, _mm_loadu_si128((const __m128i *) data));
+        data += 16;
+      } /* for */
+      /* Fold 128 bits to 64 bits. */
+      x1 = _mm_xor_si128(_mm_clmulepi64_si128(k, x1, 0x01),
+                         _mm_srli_si128(x1, 8));
+      /* Fold 64 bits to 32 bits. */
+      mask = _mm_setr_epi32(-1, 0, 0, 0);
+      x2 = _mm_srli_si128(x1, 4);
+      x1 = _mm_and_si128(x1, mask);
+      x1 = _mm_clmulepi64_si128(x1, _mm_set_epi64x(0, 0x163cd6124), 0x00);
+      x1 = _mm_xor_si128(x1, x2);
+      /* Barrett reduction to 32 bits. */
+      k = _mm_set_epi64x(0x1f7011641, 0x1db710641);
+      x2 = x1;
+      x1 = _mm_and_si128(x1, mask);
+      x1 = _mm_clmulepi64_si128(x1, k, 0x10);
+      x1 = _mm_and_si128(x1, mask);
+      x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+      x1 = _mm_xor_si128(x1, x2);
+      crc = (uint32Type) _mm_extract_epi32(x1, 1);
+    } /* if */
+    return crc32SliceBy16(crc, data, length);
+  } /* crc32Pclmul */
+
+
+
+static boolType cpuHasPclmul (void)
+
+  {
+    unsigned int eax, ebx, ecx, edx;
+
+  /* cpuHasPclmul */
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+           (ecx & (1 << 1)) != 0 &&   /* PCLMULQDQ */
+           (ecx & (1 << 19)) != 0;    /* SSE4.1 */
+  } /* cpuHasPclmul */
+#endif
+
+
+
+static void selectCrc32Function (void)
+
+  { /* selectCrc32Function */
+    createCrc32Tables();
+#if HAS_PCLMUL_INTRINSICS
+    if (cpuHasPclmul()) {
+      crc32Func = crc32Pclmul;
+    } else
+#endif
+    {
+      crc32Func = crc32SliceBy16;
+    }
+    logFunction(printf("selectCrc32Function: PCLMULQDQ %s\n",
+                       crc32Func == crc32SliceBy16 ?
+                       "not used" : "used"););
+  } /* selectCrc32Function */
+
+
+
+static inline memSizeType blockSize (intType algorithm)
+
+  { /* blockSize */
+    return algorithm >= DIGEST_SHA384 ? 128 : 64;
+  } /* blockSize */
+
+
+
+static memSizeType digestSize (intType algorithm)
+
+  {
+    memSizeType size;
+
+  /* digestSize */
+    switch (algorithm) {
+      case DIGEST_MD5:    size = 16; break;
+      case DIGEST_SHA1:   size = 20; break;
+      case DIGEST_SHA224: size = 28; break;
+      case DIGEST_SHA256: size = 32; break;
+      case DIGEST_SHA384: size = 48; break;
+      case DIGEST_SHA512: size = 64; break;
+      default:            size =  0; break;
+    } /* switch */
+    return size;
+  } /* digestSize */
+
+
+
+static void processBlocks (const digestStateType state,
+    const ucharType *data, memSizeType numBlocks)
+
+  { /* processBlocks */
+    switch (state->algorithm) {
+      case DIGEST_MD5:
+        md5Blocks(state->hash.h32, data, numBlocks);
+        break;
+      case DIGEST_SHA1:
+        sha1BlockFunc(state->hash.h32, data, numBlocks);
+        break;
+      case DIGEST_SHA224:
+      case DIGEST_SHA256:
+        sha256BlockFunc(state->hash.h32, data, numBlocks);
+        break;
+      default:
+        sha512Blocks(state->hash.h64, data, numBlocks);
+        break;
+    } /* switch */
+  } /* processBlocks */
+
+
+
+/**
+ *  Initialize the digest state for the given algorithm.
+ *  @return TRUE if the algorithm is supported, FALSE otherwise.
+ */
+static boolType digestInit (const digestStateType state, intType algorithm)
+
+  {
+    boolType okay = TRUE;
+
+  /* digestInit */
+    if (unlikely(sha1BlockFunc == NULL)) {
+      selectBlockFunctions();
+    } /* if */
+    memset(state, 0, sizeof(digestStateRecord));
+    state->algorithm = algorithm;
+    switch (algorithm) {
+      case DIGEST_MD5:
+        state->hash.h32[0] = 0x67452301;
+        state->hash.h32[1] = 0xefcdab89;
+        state->hash.h32[2] = 0x98badcfe;
+        state->hash.h32[3] = 0x10325476;
+        break;
+      case DIGEST_SHA1:
+        state->hash.h32[0] = 0x67452301;
+        state->hash.h32[1] = 0xefcdab89;
+        state->hash.h32[2] = 0x98badcfe;
+        state->hash.h32[3] = 0x10325476;
+        state->hash.h32[4] = 0xc3d2e1f0;
+        break;
+      case DIGEST_SHA224:
+        memcpy(state->hash.h32, sha224Init, sizeof(sha224Init));
+        break;
+      case DIGEST_SHA256:
+        memcpy(state->hash.h32, sha256Init, sizeof(sha256Init));
+        break;
+      case DIGEST_SHA384:
+        memcpy(state->hash.h64, sha384Init, sizeof(sha384Init));
+        break;
+      case DIGEST_SHA512:
+        memcpy(state->hash.h64, sha512Init, sizeof(sha512Init));
+        break;
+      default:
+        okay = FALSE;
+        break;
+    } /* switch */
+    return okay;
+  } /* digestInit */
+
+
+
+static void digestUpdate (const digestStateType state,
+    const ucharType *data, memSizeType length)
+
+  {
+    memSizeType size;
+    memSizeType numBytes;
+
+  /* digestUpdate */
+    size = blockSize(state->algorithm);
+    state->length += length;
+    if (state->bufferLength != 0) {
+      numBytes = size - state->bufferLength;
+      if (numBytes > length) {
+        numBytes = length;
+      } /* if */
+      memcpy(&state->buffer[state->bufferLength], data, numBytes);
+      state->bufferLength += numBytes;
+      data += numBytes;
+      length -= numBytes;
+      if (state->bufferLength == size) {
+        processBlocks(state, state->buffer, 1);
+        state->bufferLength = 0;
+      } /* if */
+    } /* if */
+    if (length >= size) {
+      processBlocks(state, data, length / size);
+      data += length - length % size;
+      length %= size;
+    } /* if */
+    if (length != 0) {
+      memcpy(state->buffer, data, length);
+      state->bufferLength = length;
+    } /* if */
+  } /* digestUpdate */
+
+
+
+/**
+ *  Add the padding and compute the digest.
+ *  The state is changed by this function.
+ *  @param digest Destination for the digest. It must have room
+ *         for MAX_DIGEST_SIZE bytes.
+ *  @return the size of the digest in bytes.
+ */
+static memSizeType digestFinish (const digestStateType state,
+    ucharType *digest)
+
+  {
+    memSizeType size;
+    memSizeType lengthPos;
+    uint64Type bitLength;
+    memSizeType resultSize;
+    memSizeType pos;
+
+  /* digestFinish */
+    size = blockSize(state->algorithm);
+    lengthPos = size == 128 ? 112 : 56;
+    bitLength = state->length << 3;
+    state->buffer[state->bufferLength] = 0x80;
+    state->bufferLength++;
+    if (state->bufferLength > lengthPos) {
+      memset(&state->buffer[state->bufferLength], 0,
+             size - state->bufferLength);
+      processBlocks(state, state->buffer, 1);
+      state->bufferLength = 0;
+    } /* if */
+    memset(&state->buffer[state->bufferLength], 0,
+           size - state->bufferLength);
+    if (state->algorithm == DIGEST_MD5) {
+      for (pos = 0; pos < 8; pos++) {
+        state->buffer[lengthPos + pos] = (ucharType) (bitLength >> (8 * pos));
+      } /* for */
+    } else {
+      if (size == 128) {
+        /* The high 64 bits of the 128 bit length field. */
+        state->buffer[lengthPos + 7] = (ucharType) (state->length >> 61);
+        lengthPos += 8;
+      } /* if */
+      for (pos = 0; pos < 8; pos++) {
+        state->buffer[lengthPos + pos] =
+            (ucharType) (bitLength >> (8 * (7 - pos)));
+      } /* for */
+    } /* if */
+    processBlocks(state, state->buffer, 1);
+    resultSize = digestSize(state->algorithm);
+    if (state->algorithm == DIGEST_MD5) {
+      for (pos = 0; pos < resultSize; pos++) {
+        digest[pos] = (ucharType) (state->hash.h32[pos >> 2] >> (8 * (pos & 3)));
+      } /* for */
+    } else if (size == 128) {
+      for (pos = 0; pos < resultSize; pos++) {
+        digest[pos] = (ucharType)
+            (state->hash.h64[pos >> 3] >> (8 * (7 - (pos & 7))));
+      } /* for */
+    } else {
+      for (pos = 0; pos < resultSize; pos++) {
+        digest[pos] = (ucharType)
+            (state->hash.h32[pos >> 2] >> (8 * (3 - (pos & 3))));
+      } /* for */
+    } /* if */
+    return resultSize;
+  } /* digestFinish */
+
+
+
+/**
+ *  Process the characters of a string with digestUpdate.
+ *  @return TRUE if all characters are in the range 0 to 255,
+ *          FALSE otherwise.
+ */
+static boolType digestUpdateStri (const digestStateType state,
+    const const_striType data)
+
+  {
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    boolType okay = TRUE;
+
+  /* digestUpdateStri */
+    mem = data->mem;
+    remaining = data->size;
+    while (remaining != 0 && okay) {
+      chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+          CONVERSION_BUFFER_SIZE : remaining;
+      if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+        okay = FALSE;
+      } else {
+        digestUpdate(state, buffer, chunkSize);
+        mem += chunkSize;
+        remaining -= chunkSize;
+      } /* if */
+    } /* while */
+    return okay;
+  } /* digestUpdateStri */
+
+
+
+static striType digestToStri (const ucharType *digest, memSizeType size)
+
+  {
+    striType result;
+
+  /* digestToStri */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = size;
+      memcpy_to_strelem(result->mem, digest, size);
+    } /* if */
+    return result;
+  } /* digestToStri */
+
+
+
+/**
+ *  Compute the CRC-32 checksum of a bstring.
+ *  The checksum of data, that is split into several parts, can
+ *  be computed by passing the checksum of the previous parts as
+ *  oldCrc. The checksum of the first part uses an oldCrc of 0.
+ *  @param bstri Data to be checksummed.
+ *  @param oldCrc CRC-32 checksum of the previous parts.
+ *  @return the CRC-32 checksum of the previous parts and bstri.
+ */
+uintType mdgBstriCrc32 (const const_bstriType bstri, uintType oldCrc)
+
+  {
+    uint32Type crc;
+
+  /* mdgBstriCrc32 */
+    if (unlikely(crc32Func == NULL)) {
+      selectCrc32Function();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    crc = crc32Func(crc, bstri->mem, bstri->size);
+    return (uintType) ~crc;
+  } /* mdgBstriCrc32 */
+
+
+
+/**
+ *  Compute the CRC-32 checksum of a string of bytes.
+ *  The checksum of data, that is split into several parts, can
+ *  be computed by passing the checksum of the previous parts as
+ *  oldCrc. The checksum of the first part uses an oldCrc of 0.
+ *  @param stri Data to be checksummed.
+ *  @param oldCrc CRC-32 checksum of the previous parts.
+ *  @return the CRC-32 checksum of the previous parts and stri.
+ *  @exception RANGE_ERROR The string contains characters beyond '\255;'.
+ */
+uintType mdgCrc32 (const const_striType stri, uintType oldCrc)
+
+  {
+    ucharType buffer[CONVERSION_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    uint32Type crc;
+
+  /* mdgCrc32 */
+    if (unlikely(crc32Func == NULL)) {
+      selectCrc32Function();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    mem = stri->mem;
+    remaining = stri->size;
+    while (remaining != 0) {
+      chunkSize = remaining > CONVERSION_BUFFER_SIZE ?
+          CONVERSION_BUFFER_SIZE : remaining;
+      if (unlikely(memcpy_from_strelem(buffer, mem, chunkSize))) {
+        logError(printf("mdgCrc32(\"%s\", " FMT_U "): "
+                        "Character beyond '\\255;'.\n",
+                        striAsUnquotedCStri(stri), oldCrc););
+        raise_error(RANGE_ERROR);
+        return 0;
+      } /* if */
+      crc = crc32Func(crc, buffer, chunkSize);
+      mem += chunkSize;
+      remaining -= chunkSize;
+    } /* while */
+    return (uintType) ~crc;
+  } /* mdgCrc32 */
+
+
+
+/**
+ *  Compute the message digest of a string with the given algorithm.
+ *  @param algorithm Ordinal number of the digestAlgorithm.
+ *  @return the digest as string of bytes.
+ *  @exception RANGE_ERROR The algorithm is not supported or the
+ *             message contains characters beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType mdgDigest (intType algorithm, const const_striType message)
+
+  {
+    digestStateRecord state;
+    ucharType digest[MAX_DIGEST_SIZE];
+    memSizeType size;
+    striType result;
+
+  /* mdgDigest */
+    logFunction(printf("mdgDigest(" FMT_D ", \"%s\")\n",
+                       algorithm, striAsUnquotedCStri(message)););
+    if (unlikely(!digestInit(&state, algorithm) ||
+                 !digestUpdateStri(&state, message))) {
+      logError(printf("mdgDigest(" FMT_D ", \"%s\"): "
+                      "Algorithm not supported or character beyond '\\255;'.\n",
+                      algorithm, striAsUnquotedCStri(message)););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      size = digestFinish(&state, digest);
+      result = digestToStri(digest, size);
+    } /* if */
+    return result;
+  } /* mdgDigest */
+
+
+
+/**
+ *  Compute the message digest of the data added to a digest state.
+ *  The state is not changed. More data can be added afterwards.
+ *  @param state Digest state created with mdgInit.
+ *  @return the digest as string of bytes.
+ *  @exception RANGE_ERROR The state is not a valid digest state.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType mdgFinish (const const_bstriType state)
+
+  {
+    digestStateRecord stateCopy;
+    ucharType digest[MAX_DIGEST_SIZE];
+    memSizeType size;
+    striType result;
+
+  /* mdgFinish */
+    if (unlikely(state->size != sizeof(digestStateRecord))) {
+      logError(printf("mdgFinish: Illegal digest state.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      /* The copy is aligned and keeps the state unchanged. */
+      memcpy(&stateCopy, state->mem, sizeof(digestStateRecord));
+      if (unlikely(digestSize(stateCopy.algorithm) == 0)) {
+        logError(printf("mdgFinish: Illegal digest algorithm.\n"););
+        raise_error(RANGE_ERROR);
+        result = NULL;
+      } else {
+        size = digestFinish(&stateCopy, digest);
+        result = digestToStri(digest, size);
+      } /* if */
+    } /* if */
+    return result;
+  } /* mdgFinish */
+
+
+
+/**
+ *  Create a digest state for an incremental digest computation.
+ *  @param algorithm Ordinal number of the digestAlgorithm.
+ *  @return the digest state stored in a bstring.
+ *  @exception RANGE_ERROR The algorithm is not supported.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType mdgInit (intType algorithm)
+
+  {
+    digestStateRecord state;
+    bstriType result;
+
+  /* mdgInit */
+    logFunction(printf("mdgInit(" FMT_D ")\n", algorithm););
+    if (unlikely(!digestInit(&state, algorithm))) {
+      logError(printf("mdgInit(" FMT_D "): Algorithm not supported.\n",
+                      algorithm););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_SIZE_OK(result,
+                                              sizeof(digestStateRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = sizeof(digestStateRecord);
+      memcpy(result->mem, &state, sizeof(digestStateRecord));
+    } /* if */
+    return result;
+  } /* mdgInit */
+
+
+
+/**
+ *  Add data to a digest state.
+ *  The digest state is changed in place.
+ *  @param state Digest state created with mdgInit.
+ *  @exception RANGE_ERROR The state is not a valid digest state or
+ *             the data contains characters beyond '\255;'.
+ */
+void mdgUpdate (bstriType state, const const_striType data)
+
+  {
+    digestStateRecord stateCopy;
+
+  /* mdgUpdate */
+    if (unlikely(state->size != sizeof(digestStateRecord))) {
+      logError(printf("mdgUpdate: Illegal digest state.\n"););
+      raise_error(RANGE_ERROR);
+    } else {
+      memcpy(&stateCopy, state->mem, sizeof(digestStateRecord));
+      if (unlikely(digestSize(stateCopy.algorithm) == 0 ||
+                   !digestUpdateStri(&stateCopy, data))) {
+        logError(printf("mdgUpdate: Illegal digest algorithm or "
+                        "character beyond '\\255;'.\n"););
+        raise_error(RANGE_ERROR);
+      } else {
+        memcpy(state->mem, &stateCopy, sizeof(digestStateRecord));
+      } /* if */
+    } /* if */
+  } /* mdgUpdate */
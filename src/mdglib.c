@@ -0,0 +1,151 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/mdglib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for message digests.             */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "mdg_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "mdglib.h"
+
+
+
+/**
+ *  Compute the CRC-32 checksum of bstri/arg_1.
+ *  The checksum oldCrc/arg_2 of previous parts is continued.
+ *  @return the CRC-32 checksum of the previous parts and bstri/arg_1.
+ */
+objectType mdg_bstri_crc32 (listType arguments)
+
+  { /* mdg_bstri_crc32 */
+    isit_bstri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        mdgBstriCrc32(take_bstri(arg_1(arguments)),
+                      take_binary(arg_2(arguments))));
+  } /* mdg_bstri_crc32 */
+
+
+
+/**
+ *  Compute the CRC-32 checksum of stri/arg_1.
+ *  The checksum oldCrc/arg_2 of previous parts is continued.
+ *  @return the CRC-32 checksum of the previous parts and stri/arg_1.
+ *  @exception RANGE_ERROR The string contains characters beyond '\255;'.
+ */
+objectType mdg_crc32 (listType arguments)
+
+  { /* mdg_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        mdgCrc32(take_stri(arg_1(arguments)),
+                 take_binary(arg_2(arguments))));
+  } /* mdg_crc32 */
+
+
+
+/**
+ *  Compute the message digest of a string with the given algorithm.
+ *  The algorithm/arg_1 is the ordinal number of a digestAlgorithm.
+ *  @return the digest as string of bytes.
+ *  @exception RANGE_ERROR The algorithm is not supported or the
+ *             message contains characters beyond '\255;'.
+ */
+objectType mdg_digest (listType arguments)
+
+  { /* mdg_digest */
+    isit_int(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        mdgDigest(take_int(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* mdg_digest */
+
+
+
+/**
+ *  Compute the message digest of the data added to state/arg_1.
+ *  The state is not changed.
+ *  @return the digest as string of bytes.
+ *  @exception RANGE_ERROR The state is not a valid digest state.
+ */
+objectType mdg_finish (listType arguments)
+
+  { /* mdg_finish */
+    isit_bstri(arg_1(arguments));
+    return bld_stri_temp(
+        mdgFinish(take_bstri(arg_1(arguments))));
+  } /* mdg_finish */
+
+
+
+/**
+ *  Create a digest state for the algorithm/arg_1.
+ *  The algorithm/arg_1 is the ordinal number of a digestAlgorithm.
+ *  @return the digest state stored in a bstring.
+ *  @exception RANGE_ERROR The algorithm is not supported.
+ */
+objectType mdg_init (listType arguments)
+
+  { /* mdg_init */
+    isit_int(arg_1(arguments));
+    return bld_bstri_temp(
+        mdgInit(take_int(arg_1(arguments))));
+  } /* mdg_init */
+
+
+
+/**
+ *  Add the data/arg_2 to the digest state/arg_1.
+ *  @exception RANGE_ERROR The state is not a valid digest state or
+ *             the data contains characters beyond '\255;'.
+ */
+objectType mdg_update (listType arguments)
+
+  {
+    objectType state_variable;
+
+  /* mdg_update */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    mdgUpdate(take_bstri(state_variable), take_stri(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* mdg_update */
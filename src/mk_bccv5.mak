@@ -35,24 +35,24 @@ CC = bcc32
 
 MOBJ = s7.obj
 POBJ = runerr.obj option.obj primitiv.obj
-LOBJ = actlib.obj arrlib.obj biglib.obj binlib.obj blnlib.obj bstlib.obj chrlib.obj cmdlib.obj conlib.obj dcllib.obj \
-       drwlib.obj enulib.obj fillib.obj fltlib.obj hshlib.obj intlib.obj itflib.obj kbdlib.obj lstlib.obj pcslib.obj \
+LOBJ = actlib.obj arrlib.obj biglib.obj binlib.obj bitlib.obj blnlib.obj bstlib.obj chrlib.obj ciplib.obj cmdlib.obj conlib.obj csvlib.obj dcllib.obj \
+       dfllib.obj drwlib.obj ecclib.obj enulib.obj fillib.obj fltlib.obj hshlib.obj intlib.obj itflib.obj jpglib.obj kbdlib.obj lstlib.obj lzmlib.obj mdglib.obj pcslib.obj pnglib.obj \
        pollib.obj prclib.obj prglib.obj reflib.obj rfllib.obj sctlib.obj setlib.obj soclib.obj sqllib.obj strlib.obj \
-       timlib.obj typlib.obj ut8lib.obj
+       timlib.obj typlib.obj ut8lib.obj xmllib.obj zstlib.obj
 EOBJ = exec.obj doany.obj objutl.obj
 AOBJ = act_comp.obj prg_comp.obj analyze.obj syntax.obj token.obj parser.obj name.obj type.obj \
        expr.obj atom.obj object.obj scanner.obj literal.obj numlit.obj findid.obj \
        error.obj infile.obj libpath.obj symbol.obj info.obj stat.obj fatal.obj match.obj
 GOBJ = syvarutl.obj traceutl.obj actutl.obj executl.obj blockutl.obj \
        entutl.obj identutl.obj chclsutl.obj arrutl.obj
-ROBJ = arr_rtl.obj bln_rtl.obj bst_rtl.obj chr_rtl.obj cmd_rtl.obj con_rtl.obj dir_rtl.obj drw_rtl.obj fil_rtl.obj \
-       flt_rtl.obj hsh_rtl.obj int_rtl.obj itf_rtl.obj pcs_rtl.obj set_rtl.obj soc_rtl.obj sql_rtl.obj str_rtl.obj \
-       tim_rtl.obj ut8_rtl.obj heaputl.obj numutl.obj sigutl.obj striutl.obj
+ROBJ = arr_rtl.obj bit_rtl.obj bln_rtl.obj bst_rtl.obj chr_rtl.obj cip_rtl.obj cmd_rtl.obj con_rtl.obj csv_rtl.obj dfl_rtl.obj dir_rtl.obj drw_rtl.obj ecc_rtl.obj fil_rtl.obj \
+       flt_rtl.obj hsh_rtl.obj int_rtl.obj itf_rtl.obj jpg_rtl.obj lzm_rtl.obj mdg_rtl.obj pcs_rtl.obj png_rtl.obj set_rtl.obj soc_rtl.obj sql_rtl.obj str_rtl.obj \
+       tim_rtl.obj ut8_rtl.obj xml_rtl.obj zst_rtl.obj heaputl.obj numutl.obj sigutl.obj striutl.obj
 DOBJ = big_rtl.obj big_gmp.obj cmd_win.obj dir_win.obj dll_win.obj fil_win.obj pcs_win.obj pol_sel.obj soc_none.obj \
        stat_win.obj tim_win.obj
 OBJ = $(MOBJ)
 SEED7_LIB_OBJ = $(ROBJ) $(DOBJ)
-DRAW_LIB_OBJ = gkb_rtl.obj drw_win.obj gkb_win.obj
+DRAW_LIB_OBJ = gkb_rtl.obj drw_win.obj drw_mem.obj gkb_win.obj
 CONSOLE_LIB_OBJ = kbd_rtl.obj con_win.obj
 DATABASE_LIB_OBJ = sql_base.obj sql_db2.obj sql_fire.obj sql_ifx.obj sql_lite.obj sql_my.obj sql_oci.obj \
                    sql_odbc.obj sql_post.obj sql_srv.obj sql_tds.obj
@@ -61,24 +61,24 @@ COMPILER_LIB_OBJ = $(POBJ) $(LOBJ) $(EOBJ) $(AOBJ) $(GOBJ)
 
 MSRC = s7.c
 PSRC = runerr.c option.c primitiv.c
-LSRC = actlib.c arrlib.c biglib.c binlib.c blnlib.c bstlib.c chrlib.c cmdlib.c conlib.c dcllib.c \
-       drwlib.c enulib.c fillib.c fltlib.c hshlib.c intlib.c itflib.c kbdlib.c lstlib.c pcslib.c \
+LSRC = actlib.c arrlib.c biglib.c binlib.c bitlib.c blnlib.c bstlib.c chrlib.c ciplib.c cmdlib.c conlib.c csvlib.c dcllib.c \
+       dfllib.c drwlib.c ecclib.c enulib.c fillib.c fltlib.c hshlib.c intlib.c itflib.c jpglib.c kbdlib.c lstlib.c lzmlib.c mdglib.c pcslib.c pnglib.c \
        pollib.c prclib.c prglib.c reflib.c rfllib.c sctlib.c setlib.c soclib.c sqllib.c strlib.c \
-       timlib.c typlib.c ut8lib.c
+       timlib.c typlib.c ut8lib.c xmllib.c zstlib.c
 ESRC = exec.c doany.c objutl.c
 ASRC = act_comp.c prg_comp.c analyze.c syntax.c token.c parser.c name.c type.c \
        expr.c atom.c object.c scanner.c literal.c numlit.c findid.c \
        error.c infile.c libpath.c symbol.c info.c stat.c fatal.c match.c
 GSRC = syvarutl.c traceutl.c actutl.c executl.c blockutl.c \
        entutl.c identutl.c chclsutl.c arrutl.c
-RSRC = arr_rtl.c bln_rtl.c bst_rtl.c chr_rtl.c cmd_rtl.c con_rtl.c dir_rtl.c drw_rtl.c fil_rtl.c \
-       flt_rtl.c hsh_rtl.c int_rtl.c itf_rtl.c pcs_rtl.c set_rtl.c soc_rtl.c sql_rtl.c str_rtl.c \
-       tim_rtl.c ut8_rtl.c heaputl.c numutl.c sigutl.c striutl.c
+RSRC = arr_rtl.c bit_rtl.c bln_rtl.c bst_rtl.c chr_rtl.c cip_rtl.c cmd_rtl.c con_rtl.c csv_rtl.c dfl_rtl.c dir_rtl.c drw_rtl.c ecc_rtl.c fil_rtl.c \
+       flt_rtl.c hsh_rtl.c int_rtl.c itf_rtl.c jpg_rtl.c lzm_rtl.c mdg_rtl.c pcs_rtl.c png_rtl.c set_rtl.c soc_rtl.c sql_rtl.c str_rtl.c \
+       tim_rtl.c ut8_rtl.c xml_rtl.c zst_rtl.c heaputl.c numutl.c sigutl.c striutl.c
 DSRC = big_rtl.c big_gmp.c cmd_win.c dir_win.c dll_win.c fil_win.c pcs_win.c pol_sel.c soc_none.c \
        stat_win.c tim_win.c
 SRC = $(MSRC)
 SEED7_LIB_SRC = $(RSRC) $(DSRC)
-DRAW_LIB_SRC = gkb_rtl.c drw_win.c gkb_win.c
+DRAW_LIB_SRC = gkb_rtl.c drw_win.c drw_mem.c gkb_win.c
 CONSOLE_LIB_SRC = kbd_rtl.c con_win.c
 DATABASE_LIB_SRC = sql_base.c sql_db2.c sql_fire.c sql_ifx.c sql_lite.c sql_my.c sql_oci.c \
                    sql_odbc.c sql_post.c sql_srv.c sql_tds.c
@@ -192,6 +192,9 @@ test:
 	@echo and use 'make install' (with your make command) to install Seed7.
 	@echo.
 
+bench:
+	..\bin\s7 -l ..\lib ..\prg\bench build
+
 install: setwpath.exe
 	.\setwpath.exe add ..\bin
 
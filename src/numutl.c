@@ -56,6 +56,7 @@
 
 #define MAX_DECIMAL_BUFFER_LENGTH 128
 #define AND_SO_ON_LIMIT           128
+#define QSORT_LIMIT                16
 
 /* DECIMAL_WITH_LIMIT provides parameters for the format string \"%.*s%s\" */
 #define DECIMAL_WITH_LIMIT(decimal, length) \
@@ -708,3 +709,133 @@ ustriType bigRatToDecimal (const const_bigIntType numerator,
                        *length, *err_info););
     return decimal;
   } /* bigRatToDecimal */
+
+
+
+/**
+ *  Define a function that sorts a dense array of C values in
+ *  ascending order. The values are compared with < and >, without
+ *  a compare function. Quicksort is used for partitions with at
+ *  least QSORT_LIMIT elements and insertion sort for the rest.
+ *  The generated function has the parameters begin_sort (pointer to
+ *  the first element) and end_sort (pointer to the last element).
+ */
+#define DEFINE_QSORT_FUNCTION(funcName, elemType) \
+static void funcName (elemType *begin_sort, elemType *end_sort) \
+  { \
+    elemType compare_elem; \
+    elemType help_element; \
+    elemType *middle_elem; \
+    elemType *less_elem; \
+    elemType *greater_elem; \
+    \
+    while (end_sort - begin_sort >= QSORT_LIMIT) { \
+      middle_elem = &begin_sort[((memSizeType) (end_sort - begin_sort)) >> 1]; \
+      compare_elem = *middle_elem; \
+      *middle_elem = *end_sort; \
+      *end_sort = compare_elem; \
+      less_elem = begin_sort - 1; \
+      greater_elem = end_sort; \
+      do { \
+        do { \
+          less_elem++; \
+        } while (*less_elem < compare_elem); \
+        do { \
+          greater_elem--; \
+        } while (*greater_elem > compare_elem && greater_elem != begin_sort); \
+        help_element = *less_elem; \
+        *less_elem = *greater_elem; \
+        *greater_elem = help_element; \
+      } while (greater_elem > less_elem); \
+      *greater_elem = *less_elem; \
+      *less_elem = compare_elem; \
+      *end_sort = help_element; \
+      /* Recurse into the smaller part to limit the stack depth. */ \
+      if (less_elem - begin_sort < end_sort - less_elem) { \
+        funcName(begin_sort, less_elem - 1); \
+        begin_sort = less_elem + 1; \
+      } else { \
+        funcName(less_elem + 1, end_sort); \
+        end_sort = less_elem - 1; \
+      } \
+    } \
+    for (middle_elem = begin_sort + 1; middle_elem <= end_sort; middle_elem++) { \
+      compare_elem = *middle_elem; \
+      less_elem = middle_elem; \
+      while (less_elem != begin_sort && less_elem[-1] > compare_elem) { \
+        *less_elem = less_elem[-1]; \
+        less_elem--; \
+      } \
+      *less_elem = compare_elem; \
+    } \
+  }
+
+DEFINE_QSORT_FUNCTION(qsortIntArray, intType)
+DEFINE_QSORT_FUNCTION(qsortUIntArray, uintType)
+/* The floatType values sorted by qsortFltArray must not contain NaN. */
+DEFINE_QSORT_FUNCTION(qsortFltArray, floatType)
+
+
+
+/**
+ *  Sort 'length' intType values in ascending order.
+ *  The elements are compared like intCmp() does it.
+ */
+void sortIntArray (intType *const values, const memSizeType length)
+
+  { /* sortIntArray */
+    logFunction(printf("sortIntArray(*, " FMT_U_MEM ")\n", length););
+    if (length > 1) {
+      qsortIntArray(values, &values[length - 1]);
+    } /* if */
+  } /* sortIntArray */
+
+
+
+/**
+ *  Sort 'length' uintType values in ascending order.
+ *  The elements are compared like uintCmp() and chrCmp() do it.
+ */
+void sortUIntArray (uintType *const values, const memSizeType length)
+
+  { /* sortUIntArray */
+    logFunction(printf("sortUIntArray(*, " FMT_U_MEM ")\n", length););
+    if (length > 1) {
+      qsortUIntArray(values, &values[length - 1]);
+    } /* if */
+  } /* sortUIntArray */
+
+
+
+/**
+ *  Sort 'length' floatType values in ascending order.
+ *  The elements are compared like fltCmp() does it: NaN is
+ *  considered greater than all other values (including Infinity)
+ *  and equal to other NaN values.
+ */
+void sortFltArray (floatType *const values, const memSizeType length)
+
+  {
+    memSizeType pos;
+    memSizeType nanPos;
+    floatType help_element;
+
+  /* sortFltArray */
+    logFunction(printf("sortFltArray(*, " FMT_U_MEM ")\n", length););
+    /* Move all NaN values to the end. */
+    nanPos = length;
+    pos = 0;
+    while (pos < nanPos) {
+      if (unlikely(os_isnan(values[pos]))) {
+        nanPos--;
+        help_element = values[pos];
+        values[pos] = values[nanPos];
+        values[nanPos] = help_element;
+      } else {
+        pos++;
+      } /* if */
+    } /* while */
+    if (nanPos > 1) {
+      qsortFltArray(values, &values[nanPos - 1]);
+    } /* if */
+  } /* sortFltArray */
@@ -46,3 +46,6 @@ ustriType bigIntToDecimal (const const_bigIntType bigIntValue,
 ustriType bigRatToDecimal (const const_bigIntType numerator,
                            const const_bigIntType denominator, memSizeType scale,
                            memSizeType *length, errInfoType *err_info);
+void sortIntArray (intType *const values, const memSizeType length);
+void sortUIntArray (uintType *const values, const memSizeType length);
+void sortFltArray (floatType *const values, const memSizeType length);
@@ -45,6 +45,8 @@ typedef struct optionStruct {
     boolType          writeHelp;
     boolType          analyzeOnly;
     boolType          executeAlways;
+    boolType          compileHot;
+    boolType          compileNative;
     uintType          parserOptions;
     uintType          execOptions;
     rtlArrayType      libraryDirs;
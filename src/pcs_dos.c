@@ -147,6 +147,15 @@ void pcsKill (const processType aProcess)
 
 
 
+intType pcsPeakMemory (const const_processType process)
+
+  { /* pcsPeakMemory */
+    return 0;
+  } /* pcsPeakMemory */
+
+
+
+
 void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters,
     fileType *childStdin, fileType *childStdout)
 
@@ -194,6 +203,15 @@ striType pcsStr (const const_processType process)
 
 
 
+intType pcsUserTime (const const_processType process)
+
+  { /* pcsUserTime */
+    return 0;
+  } /* pcsUserTime */
+
+
+
+
 void pcsWaitFor (const processType process)
 
   { /* pcsWaitFor */
@@ -36,6 +36,7 @@ void pcsFree (processType oldProcess);
 intType pcsHashCode (const const_processType aProcess);
 boolType pcsIsAlive (const processType aProcess);
 void pcsKill (const processType aProcess);
+intType pcsPeakMemory (const const_processType process);
 void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters,
     fileType *childStdin, fileType *childStdout);
 void pcsPty (const const_striType command, const const_rtlArrayType parameters,
@@ -43,4 +44,5 @@ void pcsPty (const const_striType command, const const_rtlArrayType parameters,
 processType pcsStart (const const_striType command, const const_rtlArrayType parameters,
     fileType redirectStdin, fileType redirectStdout, fileType redirectStderr);
 striType pcsStr (const const_processType process);
+intType pcsUserTime (const const_processType process);
 void pcsWaitFor (const processType process);
@@ -35,11 +35,19 @@
 #include "version.h"
 
 #define _XOPEN_SOURCE 600
+#if HAS_WAIT4
+/* The glibc declares wait4() only, if _DEFAULT_SOURCE is defined. */
+#define _DEFAULT_SOURCE
+#endif
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
 #include "sys/types.h"
 #include "sys/wait.h"
+#if HAS_WAIT4
+#include "sys/time.h"
+#include "sys/resource.h"
+#endif
 #include "fcntl.h"
 #include "signal.h"
 #include "errno.h"
@@ -67,6 +75,8 @@ typedef struct {
     pid_t pid;
     boolType isTerminated;
     int exitValue;
+    intType userTime;
+    intType peakMemory;
   } unx_processRecord, *unx_processType;
 
 typedef const unx_processRecord *const_unx_processType;
@@ -78,10 +88,45 @@ size_t sizeof_processRecord = sizeof(unx_processRecord);
 #define to_pid(process)          (((const_unx_processType) (process))->pid)
 #define to_isTerminated(process) (((const_unx_processType) (process))->isTerminated)
 #define to_exitValue(process)    (((const_unx_processType) (process))->exitValue)
+#define to_userTime(process)     (((const_unx_processType) (process))->userTime)
+#define to_peakMemory(process)   (((const_unx_processType) (process))->peakMemory)
 
 #define to_var_pid(process)          (((unx_processType) (process))->pid)
 #define to_var_isTerminated(process) (((unx_processType) (process))->isTerminated)
 #define to_var_exitValue(process)    (((unx_processType) (process))->exitValue)
+#define to_var_userTime(process)     (((unx_processType) (process))->userTime)
+#define to_var_peakMemory(process)   (((unx_processType) (process))->peakMemory)
+
+
+
+/**
+ *  Wait for a state change of the child process and collect its status.
+ *  When the child has terminated its resource usage is stored in the
+ *  process record as well.
+ *  @return the process id of the child, 0 if WNOHANG is used and the
+ *          child has not changed its state, or -1 in case of an error.
+ */
+static pid_t waitForChild (const processType process, int *status, int options)
+
+  {
+#if HAS_WAIT4
+    struct rusage usage;
+#endif
+    pid_t waitpid_result;
+
+  /* waitForChild */
+#if HAS_WAIT4
+    waitpid_result = wait4(to_pid(process), status, options, &usage);
+    if (waitpid_result == to_pid(process)) {
+      to_var_userTime(process) = (intType) usage.ru_utime.tv_sec * 1000000 +
+                                 (intType) usage.ru_utime.tv_usec;
+      to_var_peakMemory(process) = (intType) usage.ru_maxrss * RU_MAXRSS_UNIT;
+    } /* if */
+#else
+    waitpid_result = waitpid(to_pid(process), status, options);
+#endif
+    return waitpid_result;
+  } /* waitForChild */
 
 
 
@@ -327,7 +372,7 @@ boolType pcsIsAlive (const processType process)
       isAlive = FALSE;
     } else {
       status = 0;
-      waitpid_result = waitpid(to_pid(process), &status, WNOHANG);
+      waitpid_result = waitForChild(process, &status, WNOHANG);
       /*
       printf("pcsIsAlive: waitpid_result=%d\n", waitpid_result);
       printf("pcsIsAlive: status=0x%08x\n", status);
@@ -382,6 +427,31 @@ void pcsKill (const processType process)
 
 
 
+/**
+ *  Return the peak resident set size of a terminated child process.
+ *  @return the maximum resident set size of the process in bytes, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+intType pcsPeakMemory (const const_processType process)
+
+  {
+    intType peakMemory;
+
+  /* pcsPeakMemory */
+    if (unlikely(!to_isTerminated(process))) {
+      logError(printf("pcsPeakMemory(%d): Process has not terminated.\n",
+                      to_pid(process)););
+      raise_error(FILE_ERROR);
+      peakMemory = 0;
+    } else {
+      peakMemory = to_peakMemory(process);
+    } /* if */
+    return peakMemory;
+  } /* pcsPeakMemory */
+
+
+
 void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters,
     fileType *childStdin, fileType *childStdout)
 
@@ -901,6 +971,31 @@ striType pcsStr (const const_processType process)
 
 
 
+/**
+ *  Return the user CPU time used by a terminated child process.
+ *  @return the user CPU time of the process in microseconds, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+intType pcsUserTime (const const_processType process)
+
+  {
+    intType userTime;
+
+  /* pcsUserTime */
+    if (unlikely(!to_isTerminated(process))) {
+      logError(printf("pcsUserTime(%d): Process has not terminated.\n",
+                      to_pid(process)););
+      raise_error(FILE_ERROR);
+      userTime = 0;
+    } else {
+      userTime = to_userTime(process);
+    } /* if */
+    return userTime;
+  } /* pcsUserTime */
+
+
+
 /**
  *  Wait until the specified child process has terminated.
  *  Suspend the execution of the calling process until the
@@ -917,7 +1012,7 @@ void pcsWaitFor (const processType process)
                        process != NULL ? (memSizeType) to_pid(process) : (memSizeType) 0););
     if (!to_isTerminated(process)) {
       status = 0;
-      waitpid_result = waitpid(to_pid(process), &status, 0);
+      waitpid_result = waitForChild(process, &status, 0);
       if (waitpid_result == to_pid(process)) {
         to_var_isTerminated(process) = TRUE;
         if (WIFEXITED(status)) {
@@ -56,6 +56,23 @@
 
 #define MAXIMUM_COMMAND_LINE_LENGTH 32768
 
+/* Layout of PROCESS_MEMORY_COUNTERS. Not all compilers provide psapi.h. */
+typedef struct {
+    DWORD cb;
+    DWORD PageFaultCount;
+    SIZE_T PeakWorkingSetSize;
+    SIZE_T WorkingSetSize;
+    SIZE_T QuotaPeakPagedPoolUsage;
+    SIZE_T QuotaPagedPoolUsage;
+    SIZE_T QuotaPeakNonPagedPoolUsage;
+    SIZE_T QuotaNonPagedPoolUsage;
+    SIZE_T PagefileUsage;
+    SIZE_T PeakPagefileUsage;
+  } processMemoryCountersRecord;
+
+typedef BOOL (WINAPI *pGetProcessMemoryInfoType) (HANDLE,
+    processMemoryCountersRecord *, DWORD);
+
 typedef struct {
     uintType usage_count;
     fileType stdIn;
@@ -469,6 +486,52 @@ void pcsKill (const processType process)
 
 
 
+/**
+ *  Return the peak resident set size of a terminated child process.
+ *  The peak working set size is used as resident set size.
+ *  @return the maximum resident set size of the process in bytes, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+intType pcsPeakMemory (const const_processType process)
+
+  {
+    HMODULE hKernel32;
+    HMODULE hPsapi;
+    pGetProcessMemoryInfoType pGetProcessMemoryInfo = NULL;
+    processMemoryCountersRecord memoryCounters;
+    intType peakMemory = 0;
+
+  /* pcsPeakMemory */
+    if (unlikely(!to_isTerminated(process))) {
+      raise_error(FILE_ERROR);
+    } else {
+      /* The function is loaded dynamically, such that psapi.lib */
+      /* is not needed. Since Windows 7 kernel32.dll provides it. */
+      hKernel32 = GetModuleHandleA("kernel32.dll");
+      if (hKernel32 != NULL) {
+        pGetProcessMemoryInfo = (pGetProcessMemoryInfoType)
+            GetProcAddress(hKernel32, "K32GetProcessMemoryInfo");
+      } /* if */
+      if (pGetProcessMemoryInfo == NULL) {
+        hPsapi = LoadLibraryA("psapi.dll");
+        if (hPsapi != NULL) {
+          pGetProcessMemoryInfo = (pGetProcessMemoryInfoType)
+              GetProcAddress(hPsapi, "GetProcessMemoryInfo");
+        } /* if */
+      } /* if */
+      memoryCounters.cb = sizeof(memoryCounters);
+      if (pGetProcessMemoryInfo != NULL &&
+          pGetProcessMemoryInfo(to_hProcess(process), &memoryCounters,
+                                sizeof(memoryCounters)) != 0) {
+        peakMemory = (intType) memoryCounters.PeakWorkingSetSize;
+      } /* if */
+    } /* if */
+    return peakMemory;
+  } /* pcsPeakMemory */
+
+
+
 void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters,
     fileType *childStdin, fileType *childStdout)
 
@@ -940,6 +1003,35 @@ striType pcsStr (const const_processType process)
 
 
 
+/**
+ *  Return the user CPU time used by a terminated child process.
+ *  @return the user CPU time of the process in microseconds, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+intType pcsUserTime (const const_processType process)
+
+  {
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    intType userMicroseconds = 0;
+
+  /* pcsUserTime */
+    if (unlikely(!to_isTerminated(process))) {
+      raise_error(FILE_ERROR);
+    } else if (GetProcessTimes(to_hProcess(process), &creationTime,
+                               &exitTime, &kernelTime, &userTime) != 0) {
+      /* A FILETIME counts intervals of 100 nanoseconds. */
+      userMicroseconds = (intType) ((((uint64Type) userTime.dwHighDateTime << 32) |
+                                     (uint64Type) userTime.dwLowDateTime) / 10);
+    } /* if */
+    return userMicroseconds;
+  } /* pcsUserTime */
+
+
+
 /**
  *  Wait until the specified child process has terminated.
  *  Suspend the execution of the calling process until the
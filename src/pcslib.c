@@ -305,6 +305,22 @@ objectType pcs_kill (listType arguments)
 
 
 
+/**
+ *  Return the peak resident set size of a terminated child process.
+ *  @return the maximum resident set size of the process in bytes, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+objectType pcs_peak_memory (listType arguments)
+
+  { /* pcs_peak_memory */
+    isit_process(arg_1(arguments));
+    return bld_int_temp(
+        pcsPeakMemory(take_process(arg_1(arguments))));
+  } /* pcs_peak_memory */
+
+
+
 /**
  *  Check if two processes are not equal.
  *  @return TRUE if both processes are not equal,
@@ -431,6 +447,22 @@ objectType pcs_str (listType arguments)
 
 
 
+/**
+ *  Return the user CPU time used by a terminated child process.
+ *  @return the user CPU time of the process in microseconds, or 0
+ *          if the operating system does not provide this information.
+ *  @exception FILE_ERROR The process has not yet terminated.
+ */
+objectType pcs_user_time (listType arguments)
+
+  { /* pcs_user_time */
+    isit_process(arg_1(arguments));
+    return bld_int_temp(
+        pcsUserTime(take_process(arg_1(arguments))));
+  } /* pcs_user_time */
+
+
+
 /**
  *  Get 'process' value of the object referenced by 'aReference/arg_1'.
  *  @return the 'process' value of the referenced object.
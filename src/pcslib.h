@@ -39,9 +39,11 @@ objectType pcs_hashcode     (listType arguments);
 objectType pcs_is_alive     (listType arguments);
 objectType pcs_kill         (listType arguments);
 objectType pcs_ne           (listType arguments);
+objectType pcs_peak_memory  (listType arguments);
 objectType pcs_pipe2        (listType arguments);
 objectType pcs_pty          (listType arguments);
 objectType pcs_start        (listType arguments);
 objectType pcs_str          (listType arguments);
+objectType pcs_user_time    (listType arguments);
 objectType pcs_value        (listType arguments);
 objectType pcs_wait_for     (listType arguments);
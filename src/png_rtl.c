@@ -0,0 +1,379 @@
+/********************************************************************/
+/*                                                                  */
+/*  png_rtl.c     Primitive actions for PNG scanline filters.       */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/png_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for PNG scanline filters.            */
+/*                                                                  */
+/*  Every scanline of a PNG image starts with a filter type byte.   */
+/*  The filters None, Sub, Up, Average and Paeth predict a byte     */
+/*  from the byte of the previous pixel (left), the byte above      */
+/*  (up) and the byte of the previous pixel above (upper left).     */
+/*  The loops below are split, such that the first pixel of a       */
+/*  scanline (which has no left neighbour) and the first scanline   */
+/*  (which has no neighbour above) are handled separately. This     */
+/*  way the inner loops have no conditions and Up (which has no     */
+/*  dependency inside a scanline) can be vectorized by the C        */
+/*  compiler.                                                       */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "png_rtl.h"
+
+
+#define PNG_FILTER_NONE     0
+#define PNG_FILTER_SUB      1
+#define PNG_FILTER_UP       2
+#define PNG_FILTER_AVERAGE  3
+#define PNG_FILTER_PAETH    4
+#define MAX_BYTES_PER_PIXEL 8
+
+
+
+static inline unsigned int paethPredictor (unsigned int left,
+    unsigned int up, unsigned int upperLeft)
+
+  {
+    int pa;
+    int pb;
+    int pc;
+    unsigned int predicted;
+
+  /* paethPredictor */
+    pa = (int) up - (int) upperLeft;
+    pb = (int) left - (int) upperLeft;
+    pc = pa + pb;
+    if (pa < 0) pa = -pa;
+    if (pb < 0) pb = -pb;
+    if (pc < 0) pc = -pc;
+    if (pa <= pb && pa <= pc) {
+      predicted = left;
+    } else if (pb <= pc) {
+      predicted = up;
+    } else {
+      predicted = upperLeft;
+    } /* if */
+    return predicted;
+  } /* paethPredictor */
+
+
+
+/**
+ *  Reconstruct one scanline. The scanline row and the previous
+ *  (already reconstructed) scanline prior have the length rowBytes.
+ *  If prior is NULL the scanline is the first one.
+ */
+static boolType unfilterScanline (strElemType *row, const strElemType *prior,
+    memSizeType rowBytes, memSizeType bpp, strElemType filterType)
+
+  {
+    memSizeType pos;
+    boolType okay = TRUE;
+
+  /* unfilterScanline */
+    if (bpp > rowBytes) {
+      bpp = rowBytes;
+    } /* if */
+    switch (filterType) {
+      case PNG_FILTER_NONE:
+        break;
+      case PNG_FILTER_SUB:
+        for (pos = bpp; pos < rowBytes; pos++) {
+          row[pos] = (row[pos] + row[pos - bpp]) & 0xff;
+        } /* for */
+        break;
+      case PNG_FILTER_UP:
+        if (prior != NULL) {
+          for (pos = 0; pos < rowBytes; pos++) {
+            row[pos] = (row[pos] + prior[pos]) & 0xff;
+          } /* for */
+        } /* if */
+        break;
+      case PNG_FILTER_AVERAGE:
+        if (prior != NULL) {
+          for (pos = 0; pos < bpp; pos++) {
+            row[pos] = (row[pos] + (prior[pos] >> 1)) & 0xff;
+          } /* for */
+          for (; pos < rowBytes; pos++) {
+            row[pos] = (row[pos] + ((row[pos - bpp] + prior[pos]) >> 1)) & 0xff;
+          } /* for */
+        } else {
+          for (pos = bpp; pos < rowBytes; pos++) {
+            row[pos] = (row[pos] + (row[pos - bpp] >> 1)) & 0xff;
+          } /* for */
+        } /* if */
+        break;
+      case PNG_FILTER_PAETH:
+        if (prior != NULL) {
+          for (pos = 0; pos < bpp; pos++) {
+            row[pos] = (row[pos] + prior[pos]) & 0xff;
+          } /* for */
+          for (; pos < rowBytes; pos++) {
+            row[pos] = (row[pos] + paethPredictor(row[pos - bpp], prior[pos],
+                                                  prior[pos - bpp])) & 0xff;
+          } /* for */
+        } else {
+          /* Without a scanline above Paeth is identical to Sub. */
+          for (pos = bpp; pos < rowBytes; pos++) {
+            row[pos] = (row[pos] + row[pos - bpp]) & 0xff;
+          } /* for */
+        } /* if */
+        break;
+      default:
+        okay = FALSE;
+        break;
+    } /* switch */
+    return okay;
+  } /* unfilterScanline */
+
+
+
+/**
+ *  Compute the filtered bytes of one scanline with the given filter type.
+ *  If dest is NULL only the sum of the absolute values of the filtered
+ *  bytes (interpreted as signed bytes) is computed.
+ *  @return the sum of the absolute values of the filtered bytes.
+ */
+static uintType filterScanline (ustriType dest, const strElemType *row,
+    const strElemType *prior, memSizeType rowBytes, memSizeType bpp,
+    int filterType)
+
+  {
+    memSizeType pos;
+    unsigned int left;
+    unsigned int up;
+    unsigned int upperLeft;
+    unsigned int filtered;
+    uintType sum = 0;
+
+  /* filterScanline */
+    for (pos = 0; pos < rowBytes; pos++) {
+      left = pos >= bpp ? row[pos - bpp] : 0;
+      up = prior != NULL ? prior[pos] : 0;
+      upperLeft = prior != NULL && pos >= bpp ? prior[pos - bpp] : 0;
+      switch (filterType) {
+        case PNG_FILTER_SUB:
+          filtered = (row[pos] - left) & 0xff;
+          break;
+        case PNG_FILTER_UP:
+          filtered = (row[pos] - up) & 0xff;
+          break;
+        case PNG_FILTER_AVERAGE:
+          filtered = (row[pos] - ((left + up) >> 1)) & 0xff;
+          break;
+        case PNG_FILTER_PAETH:
+          filtered = (row[pos] - paethPredictor(left, up, upperLeft)) & 0xff;
+          break;
+        default:
+          filtered = row[pos];
+          break;
+      } /* switch */
+      if (dest != NULL) {
+        dest[pos] = (ucharType) filtered;
+      } /* if */
+      sum += filtered < 128 ? filtered : 256 - filtered;
+    } /* for */
+    return sum;
+  } /* filterScanline */
+
+
+
+/**
+ *  Filter the scanlines of a PNG image.
+ *  For every scanline the filter, which leads to the smallest sum of
+ *  absolute differences, is selected. The result starts every
+ *  scanline with the filter type byte and can be compressed with
+ *  DEFLATE afterwards.
+ *  @param pixelData Scanlines without filter type bytes.
+ *  @param bytesPerPixel Number of bytes per complete pixel (rounded up to 1).
+ *  @param bytesPerRow Number of bytes per scanline (without filter type).
+ *  @return the filtered scanlines.
+ *  @exception RANGE_ERROR If bytesPerPixel or bytesPerRow is not
+ *             positive, if the length of pixelData is not a multiple
+ *             of bytesPerRow or if pixelData contains a character
+ *             beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType pngFilter (const const_striType pixelData, intType bytesPerPixel,
+    intType bytesPerRow)
+
+  {
+    memSizeType rowBytes;
+    memSizeType bpp;
+    memSizeType height;
+    memSizeType line;
+    memSizeType pos;
+    const strElemType *row;
+    const strElemType *prior;
+    int filterType;
+    int bestFilterType;
+    uintType sum;
+    uintType bestSum;
+    ucharType *filtered;
+    strElemType *dest;
+    striType result;
+
+  /* pngFilter */
+    logFunction(printf("pngFilter(\"%s\", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(pixelData), bytesPerPixel,
+                       bytesPerRow););
+    if (unlikely(bytesPerPixel < 1 || bytesPerPixel > MAX_BYTES_PER_PIXEL ||
+                 bytesPerRow < 1 ||
+                 (uintType) bytesPerRow >= MAX_STRI_LEN ||
+                 pixelData->size % (memSizeType) bytesPerRow != 0)) {
+      logError(printf("pngFilter: Illegal bytesPerPixel (" FMT_D
+                      ") or bytesPerRow (" FMT_D ").\n",
+                      bytesPerPixel, bytesPerRow););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      rowBytes = (memSizeType) bytesPerRow;
+      bpp = (memSizeType) bytesPerPixel;
+      height = pixelData->size / rowBytes;
+      pos = 0;
+      while (pos < pixelData->size && pixelData->mem[pos] <= 255) {
+        pos++;
+      } /* while */
+      if (unlikely(pos < pixelData->size)) {
+        logError(printf("pngFilter: Character > 255 in data.\n"););
+        raise_error(RANGE_ERROR);
+        result = NULL;
+      } else if (unlikely(height > (MAX_STRI_LEN - height) / rowBytes ||
+                          !ALLOC_STRI_SIZE_OK(result, height * (rowBytes + 1)))) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else if (unlikely((filtered = (ucharType *) malloc(rowBytes)) == NULL)) {
+        FREE_STRI(result, height * (rowBytes + 1));
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->size = height * (rowBytes + 1);
+        dest = result->mem;
+        prior = NULL;
+        for (line = 0; line < height; line++) {
+          row = &pixelData->mem[line * rowBytes];
+          bestFilterType = PNG_FILTER_NONE;
+          bestSum = filterScanline(NULL, row, prior, rowBytes, bpp,
+                                   PNG_FILTER_NONE);
+          for (filterType = PNG_FILTER_SUB; filterType <= PNG_FILTER_PAETH;
+               filterType++) {
+            sum = filterScanline(NULL, row, prior, rowBytes, bpp, filterType);
+            if (sum < bestSum) {
+              bestSum = sum;
+              bestFilterType = filterType;
+            } /* if */
+          } /* for */
+          filterScanline(filtered, row, prior, rowBytes, bpp, bestFilterType);
+          *dest++ = (strElemType) bestFilterType;
+          for (pos = 0; pos < rowBytes; pos++) {
+            *dest++ = filtered[pos];
+          } /* for */
+          prior = row;
+        } /* for */
+        free(filtered);
+      } /* if */
+    } /* if */
+    return result;
+  } /* pngFilter */
+
+
+
+/**
+ *  Reconstruct the scanlines of a PNG image in place.
+ *  The scanlines start at startIndex and every scanline starts with
+ *  a filter type byte, which is left unchanged.
+ *  @param pixelData Data with filtered scanlines, which is changed
+ *         to contain the reconstructed scanlines.
+ *  @param startIndex Index of the filter type byte of the first scanline.
+ *  @param bytesPerPixel Number of bytes per complete pixel (rounded up to 1).
+ *  @param bytesPerScanline Number of bytes per scanline
+ *         (including the filter type byte).
+ *  @param height Number of scanlines.
+ *  @exception RANGE_ERROR If a parameter is out of range, if pixelData
+ *             is too short or if a filter type is not valid.
+ */
+void pngUnfilter (striType pixelData, intType startIndex,
+    intType bytesPerPixel, intType bytesPerScanline, intType height)
+
+  {
+    memSizeType rowBytes;
+    memSizeType line;
+    strElemType *row;
+    strElemType *prior;
+
+  /* pngUnfilter */
+    logFunction(printf("pngUnfilter(\"%s\", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(pixelData), startIndex,
+                       bytesPerPixel, bytesPerScanline, height););
+    if (unlikely(startIndex < 1 ||
+                 bytesPerPixel < 1 || bytesPerPixel > MAX_BYTES_PER_PIXEL ||
+                 bytesPerScanline < 1 || height < 0 ||
+                 (uintType) startIndex - 1 > pixelData->size ||
+                 (height != 0 &&
+                  (uintType) bytesPerScanline > (pixelData->size -
+                  ((memSizeType) startIndex - 1)) / (uintType) height))) {
+      logError(printf("pngUnfilter: Illegal startIndex (" FMT_D
+                      "), bytesPerPixel (" FMT_D "), bytesPerScanline ("
+                      FMT_D ") or height (" FMT_D ").\n",
+                      startIndex, bytesPerPixel, bytesPerScanline, height););
+      raise_error(RANGE_ERROR);
+    } else {
+      rowBytes = (memSizeType) bytesPerScanline - 1;
+      row = &pixelData->mem[startIndex - 1];
+      prior = NULL;
+      for (line = 0; line < (memSizeType) height; line++) {
+        /* The first element of row is the filter type byte. */
+        if (unlikely(!unfilterScanline(&row[1], prior, rowBytes,
+                                       (memSizeType) bytesPerPixel,
+                                       row[0]))) {
+          logError(printf("pngUnfilter: Illegal filter type (" FMT_U32
+                          ").\n", row[0]););
+          raise_error(RANGE_ERROR);
+          line = (memSizeType) height; /* leave for-loop */
+        } else {
+          prior = &row[1];
+          row += rowBytes + 1;
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* pngUnfilter */
@@ -0,0 +1,100 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/pnglib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for PNG scanline filters.        */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "png_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "pnglib.h"
+
+
+
+
+/**
+ *  Filter the scanlines in pixelData/arg_1 for the PNG format.
+ *  For every scanline the filter with the smallest sum of absolute
+ *  differences is selected.
+ *  @return the filtered scanlines, each starting with a filter type byte.
+ *  @exception RANGE_ERROR If bytesPerPixel/arg_2 or bytesPerRow/arg_3
+ *             is not positive, if the length of pixelData is not a
+ *             multiple of bytesPerRow or if pixelData contains a
+ *             character beyond '\255;'.
+ */
+objectType png_filter (listType arguments)
+
+  { /* png_filter */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_stri_temp(
+        pngFilter(take_stri(arg_1(arguments)),
+                  take_int(arg_2(arguments)),
+                  take_int(arg_3(arguments))));
+  } /* png_filter */
+
+
+
+/**
+ *  Reconstruct the PNG scanlines in pixelData/arg_1 in place.
+ *  The scanlines start at startIndex/arg_2 and every scanline
+ *  starts with a filter type byte.
+ *  @exception RANGE_ERROR If a parameter is out of range, if pixelData
+ *             is too short or if a filter type is not valid.
+ */
+objectType png_unfilter (listType arguments)
+
+  {
+    objectType pixelData_variable;
+
+  /* png_unfilter */
+    pixelData_variable = arg_1(arguments);
+    isit_stri(pixelData_variable);
+    is_variable(pixelData_variable);
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    pngUnfilter(take_stri(pixelData_variable),
+                take_int(arg_2(arguments)),
+                take_int(arg_3(arguments)),
+                take_int(arg_4(arguments)),
+                take_int(arg_5(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* png_unfilter */
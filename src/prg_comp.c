@@ -281,6 +281,7 @@ void prgDestr (progType old_prog)
         /* printf("heapsize: %ld\n", heapsize()); */
         /* heapStatistic(); */
         dump_list(old_prog->exec_expr_temp_results);
+        flush_dynamic_cache();
         close_stack(old_prog);
         close_declaration_root(old_prog);
         close_entity(old_prog);
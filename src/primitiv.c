@@ -36,22 +36,31 @@
 #include "arrlib.h"
 #include "biglib.h"
 #include "binlib.h"
+#include "bitlib.h"
 #include "blnlib.h"
 #include "bstlib.h"
 #include "chrlib.h"
+#include "ciplib.h"
 #include "cmdlib.h"
 #include "conlib.h"
+#include "csvlib.h"
 #include "dcllib.h"
+#include "dfllib.h"
 #include "drwlib.h"
+#include "ecclib.h"
 #include "enulib.h"
 #include "fillib.h"
 #include "fltlib.h"
 #include "hshlib.h"
 #include "intlib.h"
 #include "itflib.h"
+#include "jpglib.h"
 #include "kbdlib.h"
 #include "lstlib.h"
+#include "lzmlib.h"
+#include "mdglib.h"
 #include "pcslib.h"
+#include "pnglib.h"
 #include "pollib.h"
 #include "prclib.h"
 #include "prglib.h"
@@ -65,6 +74,8 @@
 #include "timlib.h"
 #include "typlib.h"
 #include "ut8lib.h"
+#include "xmllib.h"
+#include "zstlib.h"
 
 #undef EXTERN
 #define EXTERN
@@ -193,6 +204,14 @@ static const actEntryRecord actEntryTable[] = {
     { "BIN_XOR_ASSIGN",               bin_xor_assign,               },
     { "BIN_radix",                    bin_radix,                    },
 
+    { "BIT_ALIGN",                    bit_align,                    },
+    { "BIT_GET_BITS",                 bit_get_bits,                 },
+    { "BIT_HUFFMAN_SYMBOL",           bit_huffman_symbol,           },
+    { "BIT_HUFFMAN_TABLE",            bit_huffman_table,            },
+    { "BIT_PEEK_BITS",                bit_peek_bits,                },
+    { "BIT_READER_INIT",              bit_reader_init,              },
+    { "BIT_SKIP_BITS",                bit_skip_bits,                },
+
     { "BLN_AND",                      bln_and,                      },
     { "BLN_CPY",                      bln_cpy,                      },
     { "BLN_CREATE",                   bln_create,                   },
@@ -253,6 +272,18 @@ static const actEntryRecord actEntryTable[] = {
     { "CHR_VALUE",                    chr_value,                    },
     { "CHR_WIDTH",                    chr_width,                    },
 
+    { "CIP_AES_CBC_DECODE",           cip_aes_cbc_decode,           },
+    { "CIP_AES_CBC_ENCODE",           cip_aes_cbc_encode,           },
+    { "CIP_AES_CTR",                  cip_aes_ctr,                  },
+    { "CIP_AES_ECB_DECODE",           cip_aes_ecb_decode,           },
+    { "CIP_AES_ECB_ENCODE",           cip_aes_ecb_encode,           },
+    { "CIP_AES_GCM_DECODE",           cip_aes_gcm_decode,           },
+    { "CIP_AES_GCM_ENCODE",           cip_aes_gcm_encode,           },
+    { "CIP_AES_KEY",                  cip_aes_key,                  },
+    { "CIP_CHACHA20",                 cip_chacha20,                 },
+    { "CIP_CHACHA20_POLY1305_DECODE", cip_chacha20_poly1305_decode, },
+    { "CIP_CHACHA20_POLY1305_ENCODE", cip_chacha20_poly1305_encode, },
+
     { "CMD_BIG_FILESIZE",             cmd_big_filesize,             },
     { "CMD_CHDIR",                    cmd_chdir,                    },
     { "CMD_CLONE_FILE",               cmd_clone_file,               },
@@ -314,6 +345,10 @@ static const actEntryRecord actEntryTable[] = {
     { "CON_WIDTH",                    con_width,                    },
     { "CON_WRITE",                    con_write,                    },
 
+    { "CSV_FIELDS",                   csv_fields,                   },
+    { "CSV_FLOATS",                   csv_floats,                   },
+    { "CSV_INTEGERS",                 csv_integers,                 },
+
     { "DCL_ATTR",                     dcl_attr,                     },
     { "DCL_CONST",                    dcl_const,                    },
     { "DCL_ELEMENTS",                 dcl_elements,                 },
@@ -337,10 +372,17 @@ static const actEntryRecord actEntryTable[] = {
     { "DCL_VAL2",                     dcl_val2,                     },
     { "DCL_VAR",                      dcl_var,                      },
 
+    { "DFL_DEFLATE",                  dfl_deflate,                  },
+    { "DFL_DEFLATE_INIT",             dfl_deflate_init,             },
+    { "DFL_INFLATE",                  dfl_inflate,                  },
+    { "DFL_INFLATE_FINISHED",         dfl_inflate_finished,         },
+    { "DFL_INFLATE_INIT",             dfl_inflate_init,             },
+
 #if WITH_DRAW
     { "DRW_ARC",                      drw_arc,                      },
     { "DRW_ARC2",                     drw_arc2,                     },
     { "DRW_BACKGROUND",               drw_background,               },
+    { "DRW_BLEND",                    drw_blend,                    },
     { "DRW_BORDER",                   drw_border,                   },
     { "DRW_CAPTURE",                  drw_capture,                  },
     { "DRW_CIRCLE",                   drw_circle,                   },
@@ -364,6 +406,7 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_GET_IMAGE_PIXEL",          drw_get_image_pixel,          },
     { "DRW_GET_PIXEL",                drw_get_pixel,                },
     { "DRW_GET_PIXEL_ARRAY",          drw_get_pixel_array,          },
+    { "DRW_GET_PIXEL_ARRAY_FROM_PNG", drw_get_pixel_array_from_png, },
     { "DRW_GET_PIXEL_DATA",           drw_get_pixel_data,           },
     { "DRW_GET_PIXEL_DATA_FROM_ARRAY",drw_get_pixel_data_from_array,},
     { "DRW_GET_PIXMAP",               drw_get_pixmap,               },
@@ -393,14 +436,17 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_PUT",                      drw_put,                      },
     { "DRW_PUT_SCALED",               drw_put_scaled,               },
     { "DRW_RECT",                     drw_rect,                     },
+    { "DRW_RESAMPLE",                 drw_resample,                 },
     { "DRW_RGBCOL",                   drw_rgbcol,                   },
  /* { "DRW_ROT",                      drw_rot,                      }, */
+    { "DRW_ROTATE",                   drw_rotate,                   },
  /* { "DRW_SCALE",                    drw_scale,                    }, */
     { "DRW_SCREEN_HEIGHT",            drw_screen_height,            },
     { "DRW_SCREEN_WIDTH",             drw_screen_width,             },
     { "DRW_SET_CLOSE_ACTION",         drw_set_close_action,         },
     { "DRW_SET_CONTENT",              drw_set_content,              },
     { "DRW_SET_CURSOR_VISIBLE",       drw_set_cursor_visible,       },
+    { "DRW_SET_JPEG_MCU_PIXELS",      drw_set_jpeg_mcu_pixels,      },
     { "DRW_SET_POINTER_POS",          drw_set_pointer_pos,          },
     { "DRW_SET_POS",                  drw_set_pos,                  },
     { "DRW_SET_TRANSPARENT_COLOR",    drw_set_transparent_color,    },
@@ -414,6 +460,10 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_YPOS",                     drw_ypos,                     },
 #endif
 
+    { "ECC_MULT",                     ecc_mult,                     },
+    { "ECC_MULT_ADD",                 ecc_mult_add,                 },
+    { "ECC_X25519",                   ecc_x25519,                   },
+
     { "ENU_CONV",                     enu_conv,                     },
     { "ENU_CPY",                      enu_cpy,                      },
     { "ENU_CREATE",                   enu_create,                   },
@@ -638,6 +688,8 @@ static const actEntryRecord actEntryTable[] = {
     { "ITF_SELECT",                   itf_select,                   },
     { "ITF_TO_INTERFACE",             itf_to_interface,             },
 
+    { "JPG_IDCT",                     jpg_idct,                     },
+
     { "KBD_GETC",                     kbd_getc,                     },
     { "KBD_GETS",                     kbd_gets,                     },
     { "KBD_INPUT_READY",              kbd_input_ready,              },
@@ -658,6 +710,18 @@ static const actEntryRecord actEntryTable[] = {
     { "LST_RANGE",                    lst_range,                    },
     { "LST_TAIL",                     lst_tail,                     },
 
+    { "LZM_DECOMPRESS",               lzm_decompress,               },
+    { "LZM_DECOMPRESS_CHECK",         lzm_decompress_check,         },
+    { "LZM_DECOMPRESS_FINISHED",      lzm_decompress_finished,      },
+    { "LZM_DECOMPRESS_INIT",          lzm_decompress_init,          },
+
+    { "MDG_BSTRI_CRC32",              mdg_bstri_crc32,              },
+    { "MDG_CRC32",                    mdg_crc32,                    },
+    { "MDG_DIGEST",                   mdg_digest,                   },
+    { "MDG_FINISH",                   mdg_finish,                   },
+    { "MDG_INIT",                     mdg_init,                     },
+    { "MDG_UPDATE",                   mdg_update,                   },
+
     { "PCS_CHILD_STDERR",             pcs_child_stderr,             },
     { "PCS_CHILD_STDIN",              pcs_child_stdin,              },
     { "PCS_CHILD_STDOUT",             pcs_child_stdout,             },
@@ -672,10 +736,12 @@ static const actEntryRecord actEntryTable[] = {
     { "PCS_IS_ALIVE",                 pcs_is_alive,                 },
     { "PCS_KILL",                     pcs_kill,                     },
     { "PCS_NE",                       pcs_ne,                       },
+    { "PCS_PEAK_MEMORY",              pcs_peak_memory,              },
     { "PCS_PIPE2",                    pcs_pipe2,                    },
     { "PCS_PTY",                      pcs_pty,                      },
     { "PCS_START",                    pcs_start,                    },
     { "PCS_STR",                      pcs_str,                      },
+    { "PCS_USER_TIME",                pcs_user_time,                },
     { "PCS_VALUE",                    pcs_value,                    },
     { "PCS_WAIT_FOR",                 pcs_wait_for,                 },
 
@@ -693,6 +759,9 @@ static const actEntryRecord actEntryTable[] = {
     { "PLT_VALUE",                    plt_value,                    },
 #endif
 
+    { "PNG_FILTER",                   png_filter,                   },
+    { "PNG_UNFILTER",                 png_unfilter,                 },
+
     { "POL_ADD_CHECK",                pol_add_check,                },
     { "POL_CLEAR",                    pol_clear,                    },
     { "POL_CPY",                      pol_cpy,                      },
@@ -1095,6 +1164,15 @@ static const actEntryRecord actEntryTable[] = {
     { "UT8_SEEK",                     ut8_seek,                     },
     { "UT8_WORD_READ",                ut8_word_read,                },
     { "UT8_WRITE",                    ut8_write,                    },
+
+    { "XML_MARKUP_END",               xml_markup_end,               },
+    { "XML_TAG_PARTS",                xml_tag_parts,                },
+
+    { "ZST_COMPRESS",                 zst_compress,                 },
+    { "ZST_COMPRESS_INIT",            zst_compress_init,            },
+    { "ZST_DECOMPRESS",               zst_decompress,               },
+    { "ZST_DECOMPRESS_FINISHED",      zst_decompress_finished,      },
+    { "ZST_DECOMPRESS_INIT",          zst_decompress_init,          },
   };
 
 
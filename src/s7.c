@@ -34,6 +34,7 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "time.h"
 
 #include "common.h"
 #include "sigutl.h"
@@ -59,7 +60,12 @@
 #include "flt_rtl.h"
 #include "arr_rtl.h"
 #include "cmd_rtl.h"
+#include "cmd_drv.h"
+#include "fil_rtl.h"
+#include "pcs_rtl.h"
+#include "pcs_drv.h"
 #include "str_rtl.h"
+#include "tim_rtl.h"
 #include "sql_rtl.h"
 #include "con_rtl.h"
 #include "con_drv.h"
@@ -76,6 +82,23 @@ typedef HINSTANCE__ *HINSTANCE;
 
 #define VERSION_INFO "SEED7 INTERPRETER Version 5.2.%d  Copyright (c) 1990-2023 Thomas Mertes\n"
 
+/* A program is compiled to native code, when a block is called so often. */
+#define HOT_CALL_THRESHOLD 10000
+
+/* Seconds after which the lock of a native compilation is ignored. */
+#define NATIVE_LOCK_TIMEOUT 3600
+
+/* Start value and prime of the FNV-1a hash used by the native code cache. */
+#define FNV_OFFSET_BASIS 14695981039346656037U
+#define FNV_PRIME 1099511628211U
+#define HASH_CHUNK_SIZE 65536
+
+#ifdef EXECUTABLE_FILE_EXTENSION
+#define EXECUTABLE_EXTENSION EXECUTABLE_FILE_EXTENSION
+#else
+#define EXECUTABLE_EXTENSION ""
+#endif
+
 
 
 void raise_error2 (int exception_num, const_cstriType filename, int line)
@@ -98,6 +121,8 @@ static void writeHelp (void)
     printf("Options:\n");
     printf("  -?   Write Seed7 interpreter usage.\n");
     printf("  -a   Analyze only and suppress the execution phase.\n");
+    printf("  -c   Compile the program to native code with s7c and put the executable\n");
+    printf("       into the cache of option -n.\n");
     printf("  -dx  Set compile time trace level to x. Where x is a string consisting of:\n");
     printf("         a Trace primitive actions\n");
     printf("         c Do action check\n");
@@ -108,6 +133,11 @@ static void writeHelp (void)
     printf("  -d   Equivalent to -da\n");
     printf("  -i   Show the identifier table after the analysis phase.\n");
     printf("  -l   Add a directory to the include library search path (e.g.: -l ../lib).\n");
+    printf("  -n   Execute the native executable of the program from the cache. If\n");
+    printf("       there is none, interpret the program and compile it in the background\n");
+    printf("       (with option -c), when it turns hot. The executable in the cache is\n");
+    printf("       used, as long as s7, s7c and the source and include files are\n");
+    printf("       unchanged (see environment variable SEED7_CACHE).\n");
     printf("  -p   Specify a protocol file, for trace output (e.g.: -p prot.txt).\n");
     printf("  -q   Compile quiet. Line and file information and compilation\n");
     printf("       statistics are suppressed.\n");
@@ -168,6 +198,8 @@ static void printOptions (const optionType option)
     printf("writeHelp:          %s\n", option->writeHelp ? "TRUE" : "FALSE");
     printf("analyzeOnly:        %s\n", option->analyzeOnly ? "TRUE" : "FALSE");
     printf("executeAlways:      %s\n", option->executeAlways ? "TRUE" : "FALSE");
+    printf("compileHot:         %s\n", option->compileHot ? "TRUE" : "FALSE");
+    printf("compileNative:      %s\n", option->compileNative ? "TRUE" : "FALSE");
     printf("parserOptions:      " FMT_U "\n", option->parserOptions);
     printf("libraryDirs:        ");
     printArray(option->libraryDirs);
@@ -235,6 +267,9 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
             case 'a':
               option->analyzeOnly = TRUE;
               break;
+            case 'c':
+              option->compileNative = TRUE;
+              break;
             case 'd':
               if (ALLOC_STRI_SIZE_OK(traceLevel, 1)) {
                 traceLevel->mem[0] = 'a';
@@ -250,6 +285,9 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
             case 'i':
               option->parserOptions |= SHOW_IDENT_TABLE;
               break;
+            case 'n':
+              option->compileHot = TRUE;
+              break;
             case 'p':
               if (position < arg_v->max_position - 1) {
                 arg_v->arr[position].value.striValue = NULL;
@@ -382,6 +420,832 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
 
 
 
+/**
+ *  Determine the path of the cache directory for native executables.
+ *  The environment variable SEED7_CACHE can be used to specify the
+ *  directory. Otherwise the directory .cache/seed7 in the home
+ *  directory is used. The directory is created if necessary.
+ *  @return the path of the cache directory, or NULL if it is not
+ *          available.
+ */
+static striType nativeCacheDir (void)
+
+  {
+    striType cacheDirEnv;
+    striType cacheDir = NULL;
+    striType subDir;
+
+  /* nativeCacheDir */
+    cacheDirEnv = CSTRI_LITERAL_TO_STRI("SEED7_CACHE");
+    if (cacheDirEnv != NULL) {
+      cacheDir = cmdGetenv(cacheDirEnv);
+      FREE_STRI(cacheDirEnv, cacheDirEnv->size);
+      if (cacheDir != NULL && cacheDir->size == 0) {
+        FREE_STRI(cacheDir, cacheDir->size);
+        cacheDir = NULL;
+      } /* if */
+    } /* if */
+    if (cacheDir == NULL && !fail_flag) {
+      cacheDir = cmdHomeDir();
+      if (cacheDir != NULL) {
+        subDir = CSTRI_LITERAL_TO_STRI("/.cache");
+        if (subDir != NULL) {
+          strAppend(&cacheDir, subDir);
+          FREE_STRI(subDir, subDir->size);
+          if (!fail_flag && cmdFileType(cacheDir) == FILE_ABSENT) {
+            cmdMkdir(cacheDir);
+          } /* if */
+        } /* if */
+        subDir = CSTRI_LITERAL_TO_STRI("/seed7");
+        if (subDir != NULL) {
+          strAppend(&cacheDir, subDir);
+          FREE_STRI(subDir, subDir->size);
+        } /* if */
+      } /* if */
+    } /* if */
+    if (cacheDir != NULL && !fail_flag && cmdFileType(cacheDir) == FILE_ABSENT) {
+      cmdMkdir(cacheDir);
+    } /* if */
+    if (fail_flag && cacheDir != NULL) {
+      FREE_STRI(cacheDir, cacheDir->size);
+      cacheDir = NULL;
+    } /* if */
+    return cacheDir;
+  } /* nativeCacheDir */
+
+
+
+/**
+ *  Compute the FNV-1a hash of the characters of a string.
+ *  @param stri String with the characters to be hashed.
+ *  @param hash Hash of the data that precedes the string.
+ *  @return the hash of the data including the string.
+ */
+static uintType fnvHash (const const_striType stri, uintType hash)
+
+  {
+    memSizeType pos;
+
+  /* fnvHash */
+    for (pos = 0; pos < stri->size; pos++) {
+      hash ^= (uintType) stri->mem[pos];
+      hash *= FNV_PRIME;
+    } /* for */
+    return hash;
+  } /* fnvHash */
+
+
+
+/**
+ *  Determine the path of a file in the native code cache.
+ *  The name of the file is derived from a hash of the absolute path
+ *  of the source file.
+ *  @param sourcePath Absolute path of the source file.
+ *  @param extension File extension (e.g.: ".sd7") or "".
+ *  @return the path of the file in the cache, or NULL if the
+ *          cache is not available.
+ */
+static striType nativeCachePath (const const_striType sourcePath,
+    const const_cstriType extension)
+
+  {
+    char buffer[40];
+    striType fileName;
+    striType cachePath;
+
+  /* nativeCachePath */
+    sprintf(buffer, "/s7_" F_X(016) "%s",
+            fnvHash(sourcePath, FNV_OFFSET_BASIS), extension);
+    cachePath = nativeCacheDir();
+    if (cachePath != NULL) {
+      fileName = cstri_to_stri(buffer);
+      if (fileName == NULL) {
+        FREE_STRI(cachePath, cachePath->size);
+        cachePath = NULL;
+      } else {
+        strAppend(&cachePath, fileName);
+        FREE_STRI(fileName, fileName->size);
+      } /* if */
+    } /* if */
+    return cachePath;
+  } /* nativeCachePath */
+
+
+
+/**
+ *  Determine the absolute path of the source file of the program.
+ *  Like the analyzer the extension .sd7 is added, if necessary.
+ *  @return the absolute path of the source file, or NULL if it
+ *          does not exist.
+ */
+static striType nativeSourcePath (const const_striType sourceFileArgument)
+
+  {
+    striType extension;
+    striType sourceFile;
+    striType sourcePath = NULL;
+
+  /* nativeSourcePath */
+    extension = CSTRI_LITERAL_TO_STRI(".sd7");
+    if (extension != NULL) {
+      sourceFile = strConcat(sourceFileArgument, extension);
+      FREE_STRI(extension, extension->size);
+      if (sourceFile != NULL && !fail_flag) {
+        if (cmdFileType(sourceFile) == FILE_REGULAR) {
+          sourcePath = getAbsolutePath(sourceFile);
+        } else if (cmdFileType(sourceFileArgument) == FILE_REGULAR) {
+          sourcePath = getAbsolutePath(sourceFileArgument);
+        } /* if */
+        FREE_STRI(sourceFile, sourceFile->size);
+      } /* if */
+    } /* if */
+    return sourcePath;
+  } /* nativeSourcePath */
+
+
+
+/**
+ *  Determine the path of the compiler s7c.
+ *  The compiler s7c is searched in the directory of s7.
+ *  @return the path of s7c, or NULL if it does not exist.
+ */
+static striType nativeCompilerPath (const const_striType arg_0)
+
+  {
+    striType compilerDir;
+    striType compilerName;
+    intType lastSlashPos;
+    striType compiler;
+
+  /* nativeCompilerPath */
+    compiler = getExecutablePath(arg_0);
+    if (compiler != NULL && !fail_flag) {
+      lastSlashPos = strRChPos(compiler, (charType) '/');
+      compilerName = CSTRI_LITERAL_TO_STRI("s7c" EXECUTABLE_EXTENSION);
+      if (compilerName != NULL) {
+        compilerDir = strHead(compiler, lastSlashPos);
+        FREE_STRI(compiler, compiler->size);
+        compiler = strConcat(compilerDir, compilerName);
+        strDestr(compilerDir);
+        FREE_STRI(compilerName, compilerName->size);
+      } /* if */
+    } /* if */
+    if (compiler != NULL && (fail_flag || cmdFileType(compiler) != FILE_REGULAR)) {
+      strDestr(compiler);
+      compiler = NULL;
+    } /* if */
+    return compiler;
+  } /* nativeCompilerPath */
+
+
+
+static striType readFileContent (const const_striType path)
+
+  {
+    striType mode;
+    fileType aFile;
+    intType length;
+    striType content = NULL;
+
+  /* readFileContent */
+    mode = CSTRI_LITERAL_TO_STRI("r");
+    aFile = filOpen(path, mode);
+    strDestr(mode);
+    if (aFile != NULL && aFile->cFile != NULL) {
+      length = filLng(aFile);
+      if (!fail_flag) {
+        content = filGets(aFile, length);
+      } /* if */
+      filClose(aFile);
+    } /* if */
+    if (aFile != NULL) {
+      filDestr(aFile);
+    } /* if */
+    return content;
+  } /* readFileContent */
+
+
+
+static void writeFileContent (const const_striType path,
+    const const_striType content)
+
+  {
+    striType mode;
+    fileType aFile;
+
+  /* writeFileContent */
+    mode = CSTRI_LITERAL_TO_STRI("w");
+    aFile = filOpen(path, mode);
+    strDestr(mode);
+    if (aFile != NULL && aFile->cFile != NULL) {
+      filWrite(aFile, content);
+      filClose(aFile);
+    } /* if */
+    if (aFile != NULL) {
+      filDestr(aFile);
+    } /* if */
+  } /* writeFileContent */
+
+
+
+/**
+ *  Compute the hash of the content of a file.
+ *  The file is read in chunks, such that big files (e.g. the
+ *  executable of the compiler) need not fit into memory.
+ *  @param hash Place to return the hash of the file content.
+ *  @return TRUE if the file could be read, FALSE otherwise.
+ */
+static boolType fileContentHash (const const_striType path, uintType *hash)
+
+  {
+    striType mode;
+    fileType aFile;
+    striType buffer;
+    boolType okay = FALSE;
+
+  /* fileContentHash */
+    *hash = FNV_OFFSET_BASIS;
+    mode = CSTRI_LITERAL_TO_STRI("r");
+    aFile = filOpen(path, mode);
+    strDestr(mode);
+    if (aFile != NULL && aFile->cFile != NULL) {
+      okay = TRUE;
+      while (okay && !filEof(aFile)) {
+        buffer = filGets(aFile, HASH_CHUNK_SIZE);
+        if (buffer == NULL || fail_flag) {
+          okay = FALSE;
+        } else {
+          *hash = fnvHash(buffer, *hash);
+          FREE_STRI(buffer, buffer->size);
+        } /* if */
+      } /* while */
+      filClose(aFile);
+    } /* if */
+    if (aFile != NULL) {
+      filDestr(aFile);
+    } /* if */
+    return okay;
+  } /* fileContentHash */
+
+
+
+static boolType appendCStri (striType *const destination,
+    const const_cstriType cstri)
+
+  {
+    striType stri;
+    boolType okay = FALSE;
+
+  /* appendCStri */
+    stri = cstri_to_stri(cstri);
+    if (stri != NULL) {
+      strAppend(destination, stri);
+      FREE_STRI(stri, stri->size);
+      okay = !fail_flag;
+    } /* if */
+    return okay;
+  } /* appendCStri */
+
+
+
+/**
+ *  Determine the source files of the analyzed program.
+ *  The list contains the absolute paths of the main source file
+ *  and of all include files. Every path is terminated with '\n'.
+ *  @return the list of source files, or NULL if it could not be
+ *          determined.
+ */
+static striType programFileList (void)
+
+  {
+    fileNumType fileNum;
+    fileNumType fileCount;
+    striType fileName;
+    striType absolutePath;
+    striType fileList;
+
+  /* programFileList */
+    if (ALLOC_STRI_SIZE_OK(fileList, 0)) {
+      fileList->size = 0;
+      fileCount = get_file_count();
+      for (fileNum = 1; fileNum <= fileCount && !fail_flag; fileNum++) {
+        fileName = get_file_name(fileNum);
+        if (cmdFileType(fileName) == FILE_REGULAR) {
+          absolutePath = getAbsolutePath(fileName);
+          if (absolutePath != NULL) {
+            strAppend(&fileList, absolutePath);
+            FREE_STRI(absolutePath, absolutePath->size);
+            appendCStri(&fileList, "\n");
+          } /* if */
+        } /* if */
+      } /* for */
+      if (fail_flag) {
+        FREE_STRI(fileList, fileList->size);
+        fileList = NULL;
+      } /* if */
+    } /* if */
+    return fileList;
+  } /* programFileList */
+
+
+
+/**
+ *  Create the manifest of a native executable.
+ *  The manifest contains the version of the interpreter, a hash of
+ *  the compiler s7c and content hashes of all source files of the
+ *  program. The native executable in the cache is only used, if its
+ *  manifest is equal to the current manifest.
+ *  @param fileList List of source files (see programFileList()).
+ *  @param compiler Path of the compiler s7c.
+ *  @return the manifest, or NULL if a file could not be read.
+ */
+static striType nativeManifest (const const_striType fileList,
+    const const_striType compiler)
+
+  {
+    char buffer[128];
+    uintType hash;
+    memSizeType start = 0;
+    memSizeType pos;
+    striType path;
+    striType manifest;
+    boolType okay;
+
+  /* nativeManifest */
+    sprintf(buffer, VERSION_INFO, LEVEL);
+    manifest = cstri_to_stri(buffer);
+    okay = manifest != NULL && fileContentHash(compiler, &hash);
+    if (okay) {
+      sprintf(buffer, "s7c " F_X(016) "\n", hash);
+      okay = appendCStri(&manifest, buffer);
+    } /* if */
+    for (pos = 0; okay && pos < fileList->size; pos++) {
+      if (fileList->mem[pos] == '\n') {
+        path = strSubstr(fileList, (intType) start + 1, (intType) (pos - start));
+        okay = path != NULL && !fail_flag && fileContentHash(path, &hash);
+        if (okay) {
+          sprintf(buffer, F_X(016) " ", hash);
+          okay = appendCStri(&manifest, buffer);
+          strAppend(&manifest, path);
+          okay = okay && appendCStri(&manifest, "\n");
+        } /* if */
+        strDestr(path);
+        start = pos + 1;
+      } /* if */
+    } /* for */
+    if (!okay && manifest != NULL) {
+      FREE_STRI(manifest, manifest->size);
+      manifest = NULL;
+    } /* if */
+    return manifest;
+  } /* nativeManifest */
+
+
+
+/**
+ *  Extract the list of source files from a manifest.
+ *  The lines of the manifest, that describe source files, start
+ *  with 16 hexadecimal digits of the hash and a space.
+ *  @return the list of source files, or NULL if the manifest is
+ *          not valid.
+ */
+static striType manifestFileList (const const_striType manifest)
+
+  {
+    memSizeType start = 0;
+    memSizeType pos;
+    unsigned int lineNum = 0;
+    striType path;
+    striType fileList;
+
+  /* manifestFileList */
+    if (ALLOC_STRI_SIZE_OK(fileList, 0)) {
+      fileList->size = 0;
+      for (pos = 0; fileList != NULL && pos < manifest->size; pos++) {
+        if (manifest->mem[pos] == '\n') {
+          lineNum++;
+          if (lineNum <= 2) {
+            /* The version of s7 and the hash of s7c are skipped. */
+          } else if (pos - start < 18 || manifest->mem[start + 16] != ' ') {
+            FREE_STRI(fileList, fileList->size);
+            fileList = NULL;
+          } else {
+            path = strRange(manifest, (intType) start + 18, (intType) pos + 1);
+            if (path != NULL) {
+              strAppend(&fileList, path);
+              FREE_STRI(path, path->size);
+            } /* if */
+          } /* if */
+          start = pos + 1;
+        } /* if */
+      } /* for */
+      if (fileList != NULL && fail_flag) {
+        FREE_STRI(fileList, fileList->size);
+        fileList = NULL;
+      } /* if */
+    } /* if */
+    return fileList;
+  } /* manifestFileList */
+
+
+
+/**
+ *  Create the manifest of the analyzed program.
+ *  This is done directly after the analysis, such that changes of
+ *  source files during the execution are detected later.
+ *  @return the manifest, or NULL if it could not be created.
+ */
+static striType programManifest (const const_striType arg_0)
+
+  {
+    striType fileList;
+    striType compiler;
+    striType manifest = NULL;
+
+  /* programManifest */
+    fileList = programFileList();
+    compiler = nativeCompilerPath(arg_0);
+    if (fileList != NULL && compiler != NULL) {
+      manifest = nativeManifest(fileList, compiler);
+    } /* if */
+    strDestr(fileList);
+    strDestr(compiler);
+    set_fail_flag(FALSE);
+    return manifest;
+  } /* programManifest */
+
+
+
+/**
+ *  Execute the native executable of the program from the cache.
+ *  The native executable is used, if a previous run of the program
+ *  found it hot and its manifest is still valid. The manifest is
+ *  invalid, if the version of s7, the compiler s7c or the content
+ *  of a source file (including all include files) changed.
+ *  @param exitValue Place to return the exit value of the program.
+ *  @return TRUE if the native executable has been executed,
+ *          FALSE otherwise.
+ */
+static boolType runNativeProgram (const optionType option,
+    const const_striType arg_0, intType *exitValue)
+
+  {
+    striType sourcePath;
+    striType manifestPath = NULL;
+    striType executable = NULL;
+    striType compiler = NULL;
+    striType cachedManifest = NULL;
+    striType fileList = NULL;
+    striType manifest = NULL;
+    striType programName = NULL;
+    striType nameVariable;
+    striType pathVariable;
+    rtlArrayType parameters;
+    memSizeType numParameters = 0;
+    memSizeType pos;
+    processType process;
+    boolType done = FALSE;
+
+  /* runNativeProgram */
+    logFunction(printf("runNativeProgram\n"););
+    sourcePath = nativeSourcePath(option->sourceFileArgument);
+    if (sourcePath != NULL) {
+      manifestPath = nativeCachePath(sourcePath, ".dep");
+      executable = nativeCachePath(sourcePath, EXECUTABLE_EXTENSION);
+      compiler = nativeCompilerPath(arg_0);
+    } /* if */
+    if (manifestPath != NULL && executable != NULL && compiler != NULL &&
+        !fail_flag && cmdFileType(executable) == FILE_REGULAR &&
+        cmdFileType(manifestPath) == FILE_REGULAR) {
+      cachedManifest = readFileContent(manifestPath);
+      if (cachedManifest != NULL) {
+        fileList = manifestFileList(cachedManifest);
+        if (fileList != NULL) {
+          manifest = nativeManifest(fileList, compiler);
+        } /* if */
+      } /* if */
+    } /* if */
+    if (manifest != NULL && manifest->size == cachedManifest->size &&
+        memcmp(manifest->mem, cachedManifest->mem,
+               manifest->size * sizeof(strElemType)) == 0) {
+      if (option->argv != NULL) {
+        numParameters = arraySize(option->argv) - option->argvStart;
+      } /* if */
+      if (ALLOC_RTL_ARRAY(parameters, numParameters)) {
+        parameters->min_position = 1;
+        parameters->max_position = (intType) numParameters;
+        for (pos = 0; pos < numParameters; pos++) {
+          parameters->arr[pos].value.striValue =
+              option->argv->arr[option->argvStart + pos].value.striValue;
+        } /* for */
+        /* The native executable takes name(PROGRAM) and path(PROGRAM) */
+        /* from these environment variables (see getArgv()).            */
+        nameVariable = CSTRI_LITERAL_TO_STRI("SEED7_PROGRAM_NAME");
+        pathVariable = CSTRI_LITERAL_TO_STRI("SEED7_PROGRAM_PATH");
+        programName = getProgramName(option->sourceFileArgument);
+        if (nameVariable != NULL && pathVariable != NULL &&
+            programName != NULL) {
+          cmdSetenv(nameVariable, programName);
+          cmdSetenv(pathVariable, sourcePath);
+        } /* if */
+        process = pcsStart(executable, parameters, &stdinFileRecord,
+                           &stdoutFileRecord, &stderrFileRecord);
+        FREE_RTL_ARRAY(parameters, numParameters);
+        if (nameVariable != NULL && pathVariable != NULL &&
+            programName != NULL) {
+          cmdUnsetenv(nameVariable);
+          cmdUnsetenv(pathVariable);
+        } /* if */
+        strDestr(nameVariable);
+        strDestr(pathVariable);
+        if (process != NULL && !fail_flag) {
+          pcsWaitFor(process);
+          *exitValue = pcsExitValue(process);
+          pcsDestr(process);
+          done = TRUE;
+        } /* if */
+      } /* if */
+    } /* if */
+    strDestr(sourcePath);
+    strDestr(manifestPath);
+    strDestr(executable);
+    strDestr(compiler);
+    strDestr(cachedManifest);
+    strDestr(fileList);
+    strDestr(manifest);
+    strDestr(programName);
+    /* Problems with the cache are not reported. */
+    set_fail_flag(FALSE);
+    logFunction(printf("runNativeProgram --> %d\n", done););
+    return done;
+  } /* runNativeProgram */
+
+
+
+/**
+ *  Compile a hot program with s7c and put the executable into the cache.
+ *  A copy of the source file is compiled in the cache directory. The
+ *  directory of the original source file and the directories of the
+ *  option -l are added to the include library search path, such that
+ *  s7c finds the same include files as s7. The manifest is written
+ *  after the executable has been created successfully.
+ *  @param manifest Manifest of the program (see programManifest()).
+ */
+static void compileHotProgram (const optionType option,
+    const const_striType arg_0, const const_striType manifest)
+
+  {
+    striType sourcePath;
+    striType sourceDir = NULL;
+    striType cachedSource = NULL;
+    striType manifestPath = NULL;
+    striType executable = NULL;
+    striType compiler = NULL;
+    intType lastSlashPos;
+    memSizeType numLibraryDirs = 0;
+    memSizeType numParameters;
+    memSizeType pos;
+    rtlArrayType parameters;
+    processType process;
+
+  /* compileHotProgram */
+    logFunction(printf("compileHotProgram\n"););
+    sourcePath = nativeSourcePath(option->sourceFileArgument);
+    if (sourcePath != NULL) {
+      lastSlashPos = strRChPos(sourcePath, (charType) '/');
+      sourceDir = strHead(sourcePath, lastSlashPos - 1);
+      cachedSource = nativeCachePath(sourcePath, ".sd7");
+      manifestPath = nativeCachePath(sourcePath, ".dep");
+      executable = nativeCachePath(sourcePath, EXECUTABLE_EXTENSION);
+      compiler = nativeCompilerPath(arg_0);
+    } /* if */
+    if (option->libraryDirs != NULL) {
+      numLibraryDirs = arraySize(option->libraryDirs);
+    } /* if */
+    if (sourceDir != NULL && cachedSource != NULL && manifestPath != NULL &&
+        executable != NULL && compiler != NULL && !fail_flag) {
+      if (cmdFileType(manifestPath) != FILE_ABSENT) {
+        cmdRemoveFile(manifestPath);
+      } /* if */
+      if (!fail_flag && cmdFileType(cachedSource) != FILE_ABSENT) {
+        cmdRemoveFile(cachedSource);
+      } /* if */
+      if (!fail_flag && cmdFileType(executable) != FILE_ABSENT) {
+        cmdRemoveFile(executable);
+      } /* if */
+      if (!fail_flag) {
+        cmdCopyFile(sourcePath, cachedSource);
+      } /* if */
+      numParameters = 4 + 2 * numLibraryDirs;
+      if (!fail_flag && ALLOC_RTL_ARRAY(parameters, numParameters)) {
+        parameters->min_position = 1;
+        parameters->max_position = (intType) numParameters;
+        parameters->arr[0].value.striValue = CSTRI_LITERAL_TO_STRI("-O2");
+        parameters->arr[1].value.striValue = CSTRI_LITERAL_TO_STRI("-l");
+        parameters->arr[2].value.striValue = sourceDir;
+        for (pos = 0; pos < numLibraryDirs; pos++) {
+          parameters->arr[3 + 2 * pos].value.striValue =
+              parameters->arr[1].value.striValue;
+          parameters->arr[4 + 2 * pos].value.striValue =
+              option->libraryDirs->arr[pos].value.striValue;
+        } /* for */
+        parameters->arr[numParameters - 1].value.striValue = cachedSource;
+        if (parameters->arr[0].value.striValue != NULL &&
+            parameters->arr[1].value.striValue != NULL) {
+          /* The null file lets pcsStart() open the null device for */
+          /* every standard file of the compiler separately.          */
+          process = pcsStart(compiler, parameters, &nullFileRecord,
+                             &nullFileRecord, &nullFileRecord);
+          if (process != NULL && !fail_flag) {
+            pcsWaitFor(process);
+            pcsDestr(process);
+          } /* if */
+        } /* if */
+        strDestr(parameters->arr[0].value.striValue);
+        strDestr(parameters->arr[1].value.striValue);
+        FREE_RTL_ARRAY(parameters, numParameters);
+      } /* if */
+      if (!fail_flag && cmdFileType(executable) == FILE_REGULAR) {
+        writeFileContent(manifestPath, manifest);
+      } /* if */
+    } /* if */
+    strDestr(sourcePath);
+    strDestr(sourceDir);
+    strDestr(cachedSource);
+    strDestr(manifestPath);
+    strDestr(executable);
+    strDestr(compiler);
+    set_fail_flag(FALSE);
+    logFunction(printf("compileHotProgram -->\n"););
+  } /* compileHotProgram */
+
+
+
+/**
+ *  Compile the program to native code and put it into the cache.
+ *  This is done by the process with the option -c, which is started
+ *  by startNativeCompilation(). The program is analyzed to get the
+ *  include files for the manifest. At the end the lock file of the
+ *  compilation is removed, even if the compilation failed.
+ */
+static void compileNativeProgram (const optionType option,
+    const const_striType arg_0)
+
+  {
+    progType currentProg;
+    striType manifest = NULL;
+    striType sourcePath;
+    striType lockPath = NULL;
+
+  /* compileNativeProgram */
+    logFunction(printf("compileNativeProgram\n"););
+    currentProg = analyze(option->sourceFileArgument, option->parserOptions,
+                          option->libraryDirs, option->protFileName);
+    if (currentProg != NULL && currentProg->error_count == 0) {
+      manifest = programManifest(arg_0);
+      if (manifest != NULL) {
+        compileHotProgram(option, arg_0, manifest);
+        FREE_STRI(manifest, manifest->size);
+      } /* if */
+    } /* if */
+    sourcePath = nativeSourcePath(option->sourceFileArgument);
+    if (sourcePath != NULL) {
+      lockPath = nativeCachePath(sourcePath, ".lck");
+      if (lockPath != NULL && !fail_flag &&
+          cmdFileType(lockPath) != FILE_ABSENT) {
+        cmdRemoveFile(lockPath);
+      } /* if */
+    } /* if */
+    strDestr(sourcePath);
+    strDestr(lockPath);
+    set_fail_flag(FALSE);
+    logFunction(printf("compileNativeProgram -->\n"););
+  } /* compileNativeProgram */
+
+
+
+/**
+ *  Determine if another process currently compiles the program.
+ *  A lock file, which is older than NATIVE_LOCK_TIMEOUT seconds,
+ *  is left over from a compilation that was interrupted.
+ *  @return TRUE if the lock file exists and is not outdated,
+ *          FALSE otherwise.
+ */
+static boolType nativeLockActive (const const_striType lockPath)
+
+  {
+    intType year;
+    intType month;
+    intType day;
+    intType hour;
+    intType minute;
+    intType second;
+    intType micro_sec;
+    intType timeZone;
+    boolType isDst;
+    timeStampType lockTime;
+    boolType active = FALSE;
+
+  /* nativeLockActive */
+    if (cmdFileType(lockPath) != FILE_ABSENT && !fail_flag) {
+      cmdGetMTime(lockPath, &year, &month, &day, &hour, &minute, &second,
+                  &micro_sec, &timeZone, &isDst);
+      if (!fail_flag) {
+        lockTime = timToTimestamp(year, month, day, hour, minute, second,
+                                  timeZone);
+        active = (timeStampType) time(NULL) - lockTime < NATIVE_LOCK_TIMEOUT;
+      } /* if */
+    } /* if */
+    return active;
+  } /* nativeLockActive */
+
+
+
+static optionType hotOption = NULL;
+static const_striType hotArg0 = NULL;
+
+
+
+/**
+ *  Start the compilation of the program to native code in the background.
+ *  This function is called by the interpreter, when the first block of
+ *  the program turns hot. It starts s7 with the option -c and does not
+ *  wait for it. The interpreted program continues, such that programs
+ *  which end with exit() are compiled as well. A lock file in the cache
+ *  prevents that several processes compile the same program at once.
+ */
+static void startNativeCompilation (void)
+
+  {
+    striType sourcePath;
+    striType lockPath = NULL;
+    striType interpreter = NULL;
+    memSizeType numLibraryDirs = 0;
+    memSizeType numParameters;
+    striType libraryOption;
+    memSizeType pos;
+    rtlArrayType parameters;
+    processType process = NULL;
+
+  /* startNativeCompilation */
+    logFunction(printf("startNativeCompilation\n"););
+    sourcePath = nativeSourcePath(hotOption->sourceFileArgument);
+    if (sourcePath != NULL) {
+      lockPath = nativeCachePath(sourcePath, ".lck");
+      interpreter = getExecutablePath(hotArg0);
+    } /* if */
+    if (hotOption->libraryDirs != NULL) {
+      numLibraryDirs = arraySize(hotOption->libraryDirs);
+    } /* if */
+    if (lockPath != NULL && interpreter != NULL && !fail_flag &&
+        !nativeLockActive(lockPath)) {
+      writeFileContent(lockPath, sourcePath);
+      numParameters = 3 + 2 * numLibraryDirs;
+      if (!fail_flag && ALLOC_RTL_ARRAY(parameters, numParameters)) {
+        parameters->min_position = 1;
+        parameters->max_position = (intType) numParameters;
+        parameters->arr[0].value.striValue = CSTRI_LITERAL_TO_STRI("-q");
+        parameters->arr[1].value.striValue = CSTRI_LITERAL_TO_STRI("-c");
+        libraryOption = CSTRI_LITERAL_TO_STRI("-l");
+        for (pos = 0; pos < numLibraryDirs; pos++) {
+          parameters->arr[2 + 2 * pos].value.striValue = libraryOption;
+          parameters->arr[3 + 2 * pos].value.striValue =
+              hotOption->libraryDirs->arr[pos].value.striValue;
+        } /* for */
+        parameters->arr[numParameters - 1].value.striValue = sourcePath;
+        if (parameters->arr[0].value.striValue != NULL &&
+            parameters->arr[1].value.striValue != NULL &&
+            libraryOption != NULL) {
+          /* The process is not waited for. It removes the lock file. */
+          process = pcsStart(interpreter, parameters, &nullFileRecord,
+                             &nullFileRecord, &nullFileRecord);
+        } /* if */
+        strDestr(parameters->arr[0].value.striValue);
+        strDestr(parameters->arr[1].value.striValue);
+        strDestr(libraryOption);
+        FREE_RTL_ARRAY(parameters, numParameters);
+      } /* if */
+      if (process != NULL && !fail_flag) {
+        pcsDestr(process);
+      } else {
+        set_fail_flag(FALSE);
+        if (process != NULL) {
+          pcsDestr(process);
+        } /* if */
+        if (cmdFileType(lockPath) != FILE_ABSENT) {
+          cmdRemoveFile(lockPath);
+        } /* if */
+      } /* if */
+    } /* if */
+    strDestr(sourcePath);
+    strDestr(lockPath);
+    strDestr(interpreter);
+    set_fail_flag(FALSE);
+    logFunction(printf("startNativeCompilation -->\n"););
+  } /* startNativeCompilation */
+
+
+
 #ifdef USE_WMAIN
 int wmain (int argc, wchar_t **argv)
 #elif defined USE_WINMAIN
@@ -392,13 +1256,17 @@ int main (int argc, char **argv)
 
   {
     rtlArrayType arg_v;
+    striType arg_0 = NULL;
     progType currentProg;
+    intType exitValue = 0;
     optionRecord option = {
         NULL,  /* sourceFileArgument */
         NULL,  /* protFileName       */
         FALSE, /* writeHelp          */
         FALSE, /* analyzeOnly        */
         FALSE, /* executeAlways      */
+        FALSE, /* compileHot         */
+        FALSE, /* compileNative      */
         0,     /* parserOptions      */
         0,     /* execOptions        */
         NULL,  /* libraryDirs        */
@@ -413,9 +1281,9 @@ int main (int argc, char **argv)
     setupFiles();
     set_protfile_name(NULL);
 #ifdef USE_WINMAIN
-    arg_v = getArgv(0, NULL, NULL, NULL, NULL);
+    arg_v = getArgv(0, NULL, &arg_0, NULL, NULL);
 #else
-    arg_v = getArgv(argc, argv, NULL, NULL, NULL);
+    arg_v = getArgv(argc, argv, &arg_0, NULL, NULL);
 #endif
     if (arg_v == NULL) {
       printf(VERSION_INFO, LEVEL);
@@ -446,7 +1314,18 @@ int main (int argc, char **argv)
              printf("protFileName: \"%s\"\n", option.protFileName); */
           if (option.sourceFileArgument == NULL) {
             printf("*** Sourcefile missing\n");
+          } else if (option.compileNative) {
+            compileNativeProgram(&option, arg_0);
+          } else if (option.compileHot && !option.analyzeOnly &&
+                     runNativeProgram(&option, arg_0, &exitValue)) {
+            /* The native executable from the cache has been executed. */
           } else {
+            if (option.compileHot) {
+              hotOption = &option;
+              hotArg0 = arg_0;
+              hot_call_threshold = HOT_CALL_THRESHOLD;
+              hot_program_handler = startNativeCompilation;
+            } /* if */
             currentProg = analyze(option.sourceFileArgument, option.parserOptions,
                                   option.libraryDirs, option.protFileName);
             if (!option.analyzeOnly && currentProg != NULL &&
@@ -483,14 +1362,15 @@ int main (int argc, char **argv)
         freeOptions(&option);
       } /* if */
     } /* if */
+    strDestr(arg_0);
     /* getchar(); */
     /* heapStatistic(); */
 #if CHECK_STACK
     printf("max_stack_size: " FMT_U_MEM "\n", getMaxStackSize());
 #endif
-    logFunction(printf("main --> 0\n"););
+    logFunction(printf("main --> " FMT_D "\n", exitValue););
 #ifdef USE_DO_EXIT
-    doExit(0);
+    doExit((int) exitValue);
 #endif
-    return 0;
+    return (int) exitValue;
   } /* main */
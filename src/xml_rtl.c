@@ -0,0 +1,398 @@
+/********************************************************************/
+/*                                                                  */
+/*  xml_rtl.c     Primitive actions for XML markup.                 */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/xml_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for XML markup.                      */
+/*                                                                  */
+/*  The functions find the end of XML markup and split XML tags     */
+/*  into the element name and the attributes. The text between the  */
+/*  markup is not processed here. It can be found with strChIPos.   */
+/*  Searching for delimiters uses memchr_strelem, such that long    */
+/*  comments, CDATA sections and attribute values are skipped fast. */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "wchar.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "xml_rtl.h"
+
+
+typedef enum {
+    NO_MATCH,
+    PARTIAL_MATCH,
+    FULL_MATCH
+  } matchType;
+
+typedef struct {
+    memSizeType start;
+    memSizeType length;
+  } xmlPartType;
+
+#define isXmlWhiteSpace(ch) ((ch) == ' ' || (ch) == '\t' || \
+                             (ch) == '\n' || (ch) == '\r')
+
+
+
+/**
+ *  Compare the start of mem with an ASCII string.
+ *  @return FULL_MATCH if mem starts with ascii, PARTIAL_MATCH if
+ *          mem is shorter than ascii and mem is a prefix of ascii
+ *          and NO_MATCH otherwise.
+ */
+static matchType matchAscii (const strElemType *mem, memSizeType length,
+    const char *ascii)
+
+  {
+    memSizeType pos = 0;
+
+  /* matchAscii */
+    while (ascii[pos] != '\0' && pos < length &&
+           mem[pos] == (strElemType) (unsigned char) ascii[pos]) {
+      pos++;
+    } /* while */
+    if (ascii[pos] == '\0') {
+      return FULL_MATCH;
+    } else if (pos == length) {
+      return PARTIAL_MATCH;
+    } else {
+      return NO_MATCH;
+    } /* if */
+  } /* matchAscii */
+
+
+
+/**
+ *  Search an ASCII string, which consists of at least two characters.
+ *  The first character of the ASCII string is searched with
+ *  memchr_strelem.
+ *  @return the index after the found ASCII string, or 0 if the
+ *          ASCII string is not found.
+ */
+static memSizeType searchAscii (const strElemType *mem, memSizeType start,
+    memSizeType length, const char *ascii)
+
+  {
+    const strElemType *found;
+    memSizeType pos;
+    memSizeType asciiLength;
+
+  /* searchAscii */
+    asciiLength = strlen(ascii);
+    while (start + asciiLength <= length) {
+      found = memchr_strelem(&mem[start], (strElemType) (unsigned char) ascii[0],
+                             length - asciiLength + 1 - start);
+      if (found == NULL) {
+        return 0;
+      } else {
+        pos = (memSizeType) (found - mem);
+        if (matchAscii(&mem[pos], length - pos, ascii) == FULL_MATCH) {
+          return pos + asciiLength;
+        } /* if */
+        start = pos + 1;
+      } /* if */
+    } /* while */
+    return 0;
+  } /* searchAscii */
+
+
+
+/**
+ *  Search the closing '>' of a tag or declaration.
+ *  Characters enclosed in double or single quotes are skipped.
+ *  If allowBrackets is TRUE a '>' between '[' and ']' is also skipped
+ *  (as used by the internal subset of a document type declaration).
+ *  @return the index after the closing '>', or 0 if it is not found.
+ */
+static memSizeType searchTagEnd (const strElemType *mem, memSizeType start,
+    memSizeType length, boolType allowBrackets)
+
+  {
+    const strElemType *found;
+    memSizeType pos;
+    memSizeType depth = 0;
+    strElemType ch;
+
+  /* searchTagEnd */
+    for (pos = start; pos < length; pos++) {
+      ch = mem[pos];
+      if (ch == '>') {
+        if (depth == 0) {
+          return pos + 1;
+        } /* if */
+      } else if (ch == '"' || ch == '\'') {
+        found = memchr_strelem(&mem[pos + 1], ch, length - pos - 1);
+        if (found == NULL) {
+          return 0;
+        } /* if */
+        pos = (memSizeType) (found - mem);
+      } else if (allowBrackets) {
+        if (ch == '[') {
+          depth++;
+        } else if (ch == ']' && depth != 0) {
+          depth--;
+        } /* if */
+      } /* if */
+    } /* for */
+    return 0;
+  } /* searchTagEnd */
+
+
+
+/**
+ *  Split an XML tag into the element name and the attributes.
+ *  The tag starts with '<' or "</" and usually ends with ">" or "/>".
+ *  The scanning stops at the first syntax error. Attribute values
+ *  must be quoted with double or single quotes.
+ *  @param parts Destination for the parts or NULL, if the parts
+ *         should just be counted.
+ *  @return the number of parts found (the name and pairs of attribute
+ *          names and attribute values).
+ */
+static memSizeType scanTag (const strElemType *mem, memSizeType length,
+    xmlPartType *parts)
+
+  {
+    const strElemType *found;
+    memSizeType pos = 1;
+    memSizeType nameStart;
+    memSizeType nameLength;
+    memSizeType numParts = 0;
+    strElemType ch;
+
+  /* scanTag */
+    if (pos < length && mem[pos] == '/') {
+      pos++;
+    } /* if */
+    nameStart = pos;
+    while (pos < length && !isXmlWhiteSpace(mem[pos]) &&
+           mem[pos] != '/' && mem[pos] != '>') {
+      pos++;
+    } /* while */
+    if (parts != NULL) {
+      parts[0].start = nameStart;
+      parts[0].length = pos - nameStart;
+    } /* if */
+    numParts = 1;
+    while (pos < length) {
+      while (pos < length && isXmlWhiteSpace(mem[pos])) {
+        pos++;
+      } /* while */
+      nameStart = pos;
+      while (pos < length && !isXmlWhiteSpace(mem[pos]) &&
+             mem[pos] != '=' && mem[pos] != '/' && mem[pos] != '>') {
+        pos++;
+      } /* while */
+      nameLength = pos - nameStart;
+      while (pos < length && isXmlWhiteSpace(mem[pos])) {
+        pos++;
+      } /* while */
+      if (nameLength == 0 || pos >= length || mem[pos] != '=') {
+        break;
+      } /* if */
+      do {
+        pos++;
+      } while (pos < length && isXmlWhiteSpace(mem[pos]));
+      if (pos >= length || (mem[pos] != '"' && mem[pos] != '\'')) {
+        break;
+      } /* if */
+      ch = mem[pos];
+      pos++;
+      found = memchr_strelem(&mem[pos], ch, length - pos);
+      if (found == NULL) {
+        break;
+      } /* if */
+      if (parts != NULL) {
+        parts[numParts].start = nameStart;
+        parts[numParts].length = nameLength;
+        parts[numParts + 1].start = pos;
+        parts[numParts + 1].length = (memSizeType) (found - mem) - pos;
+      } /* if */
+      numParts += 2;
+      pos = (memSizeType) (found - mem) + 1;
+    } /* while */
+    return numParts;
+  } /* scanTag */
+
+
+
+/**
+ *  Determine the end of the XML markup, which starts at position.
+ *  The markup can be a start-tag, an end-tag, an empty-element tag,
+ *  a comment (<!-- ... -->), a CDATA section (<![CDATA[ ... ]]>),
+ *  a processing instruction (<? ... ?>) or a declaration like
+ *  <!DOCTYPE ... >. A '>' inside quotes of a tag or declaration and
+ *  a '>' inside the internal subset of a document type declaration
+ *  does not end the markup.
+ *  @param buffer String with XML data.
+ *  @param position Position of the '<' that starts the markup.
+ *  @return the position after the end of the markup, or 0 if the
+ *          markup does not end inside the buffer.
+ *  @exception RANGE_ERROR If position is not in the buffer or if
+ *             there is no '<' at position.
+ */
+intType xmlMarkupEnd (const const_striType buffer, intType position)
+
+  {
+    const strElemType *mem;
+    memSizeType length;
+    matchType match;
+    memSizeType endIndex;
+
+  /* xmlMarkupEnd */
+    logFunction(printf("xmlMarkupEnd(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(buffer), position););
+    if (unlikely(position < 1 || (uintType) position > buffer->size ||
+                 buffer->mem[position - 1] != '<')) {
+      logError(printf("xmlMarkupEnd(\"%s\", " FMT_D "): "
+                      "No '<' at position.\n",
+                      striAsUnquotedCStri(buffer), position););
+      raise_error(RANGE_ERROR);
+      endIndex = 0;
+    } else {
+      mem = &buffer->mem[position - 1];
+      length = buffer->size - (memSizeType) (position - 1);
+      if (length < 2) {
+        endIndex = 0;
+      } else if (mem[1] == '!') {
+        if ((match = matchAscii(mem, length, "<!--")) == FULL_MATCH) {
+          endIndex = searchAscii(mem, 4, length, "-->");
+        } else if (match == PARTIAL_MATCH) {
+          endIndex = 0;
+        } else if ((match = matchAscii(mem, length, "<![CDATA[")) == FULL_MATCH) {
+          endIndex = searchAscii(mem, 9, length, "]]>");
+        } else if (match == PARTIAL_MATCH) {
+          endIndex = 0;
+        } else {
+          endIndex = searchTagEnd(mem, 2, length, TRUE);
+        } /* if */
+      } else if (mem[1] == '?') {
+        endIndex = searchAscii(mem, 2, length, "?>");
+      } else {
+        endIndex = searchTagEnd(mem, 1, length, FALSE);
+      } /* if */
+      if (endIndex != 0) {
+        endIndex += (memSizeType) (position - 1) + 1;
+      } /* if */
+    } /* if */
+    logFunction(printf("xmlMarkupEnd --> " FMT_U_MEM "\n", endIndex););
+    return (intType) endIndex;
+  } /* xmlMarkupEnd */
+
+
+
+/**
+ *  Split the XML tag between startPos and endPos into its parts.
+ *  The tag can be a start-tag, an end-tag or an empty-element tag.
+ *  Entities in the attribute values are not decoded. The splitting
+ *  stops at the first syntax error (e.g. an attribute value without
+ *  quotes). Attributes before the syntax error are returned.
+ *  @param buffer String with XML data.
+ *  @param startPos Position of the '<' that starts the tag.
+ *  @param endPos Position after the end of the tag.
+ *  @return an array with the element name followed by pairs of
+ *          attribute names and attribute values.
+ *  @exception RANGE_ERROR If startPos or endPos are not in the buffer
+ *             or if startPos is not less than endPos.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType xmlTagParts (const const_striType buffer, intType startPos,
+    intType endPos)
+
+  {
+    const strElemType *mem;
+    memSizeType length;
+    memSizeType numParts;
+    xmlPartType *parts;
+    memSizeType index;
+    striType part;
+    rtlArrayType result;
+
+  /* xmlTagParts */
+    logFunction(printf("xmlTagParts(\"%s\", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(buffer), startPos, endPos););
+    if (unlikely(startPos < 1 || startPos >= endPos ||
+                 (uintType) endPos - 1 > buffer->size)) {
+      logError(printf("xmlTagParts(\"%s\", " FMT_D ", " FMT_D "): "
+                      "Illegal positions.\n",
+                      striAsUnquotedCStri(buffer), startPos, endPos););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      mem = &buffer->mem[startPos - 1];
+      length = (memSizeType) (endPos - startPos);
+      numParts = scanTag(mem, length, NULL);
+      parts = (xmlPartType *) malloc(numParts * sizeof(xmlPartType));
+      if (unlikely(parts == NULL)) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        scanTag(mem, length, parts);
+        if (unlikely(!ALLOC_RTL_ARRAY(result, numParts))) {
+          raise_error(MEMORY_ERROR);
+        } else {
+          result->min_position = 1;
+          result->max_position = (intType) numParts;
+          for (index = 0; index < numParts; index++) {
+            if (unlikely(!ALLOC_STRI_SIZE_OK(part, parts[index].length))) {
+              while (index != 0) {
+                index--;
+                FREE_STRI(result->arr[index].value.striValue,
+                          result->arr[index].value.striValue->size);
+              } /* while */
+              FREE_RTL_ARRAY(result, numParts);
+              raise_error(MEMORY_ERROR);
+              result = NULL;
+              break;
+            } /* if */
+            part->size = parts[index].length;
+            memcpy(part->mem, &mem[parts[index].start],
+                   parts[index].length * sizeof(strElemType));
+            result->arr[index].value.striValue = part;
+          } /* for */
+        } /* if */
+        free(parts);
+      } /* if */
+    } /* if */
+    logFunction(printf("xmlTagParts --> " FMT_U_MEM " parts\n",
+                       result == NULL ? 0 : arraySize(result)););
+    return result;
+  } /* xmlTagParts */
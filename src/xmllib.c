@@ -0,0 +1,123 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/xmllib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for XML markup.                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "str_rtl.h"
+#include "xml_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "xmllib.h"
+
+
+
+/**
+ *  Determine the end of the XML markup, which starts at position/arg_2.
+ *  The markup can be a tag, a comment, a CDATA section, a processing
+ *  instruction or a declaration.
+ *  @return the position after the end of the markup, or 0 if the
+ *          markup does not end inside buffer/arg_1.
+ *  @exception RANGE_ERROR If position/arg_2 is not in buffer/arg_1 or
+ *             if there is no '<' at position/arg_2.
+ */
+objectType xml_markup_end (listType arguments)
+
+  { /* xml_markup_end */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        xmlMarkupEnd(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* xml_markup_end */
+
+
+
+/**
+ *  Split the XML tag between startPos/arg_2 and endPos/arg_3 into its parts.
+ *  @return an array with the element name followed by pairs of
+ *          attribute names and (not decoded) attribute values.
+ *  @exception RANGE_ERROR If startPos/arg_2 or endPos/arg_3 are not
+ *             in buffer/arg_1 or if startPos/arg_2 is not less than
+ *             endPos/arg_3.
+ */
+objectType xml_tag_parts (listType arguments)
+
+  {
+    rtlArrayType parts;
+    memSizeType arraySize;
+    memSizeType pos;
+    arrayType anArray;
+    typeType typeOfElement;
+    objectType result;
+
+  /* xml_tag_parts */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    parts = xmlTagParts(take_stri(arg_1(arguments)),
+                        take_int(arg_2(arguments)),
+                        take_int(arg_3(arguments)));
+    if (unlikely(parts == NULL)) {
+      /* An exception has already been raised. */
+      result = NULL;
+    } else {
+      arraySize = arraySize(parts);
+      if (unlikely(!ALLOC_ARRAY(anArray, arraySize))) {
+        for (pos = 0; pos < arraySize; pos++) {
+          strDestr(parts->arr[pos].value.striValue);
+        } /* for */
+        FREE_RTL_ARRAY(parts, arraySize);
+        result = raise_exception(SYS_MEM_EXCEPTION);
+      } else {
+        anArray->min_position = parts->min_position;
+        anArray->max_position = parts->max_position;
+        typeOfElement = take_type(SYS_STRI_TYPE);
+        for (pos = 0; pos < arraySize; pos++) {
+          anArray->arr[pos].type_of = typeOfElement;
+          anArray->arr[pos].descriptor.property = NULL;
+          anArray->arr[pos].value.striValue = parts->arr[pos].value.striValue;
+          INIT_CATEGORY_OF_VAR(&anArray->arr[pos], STRIOBJECT);
+        } /* for */
+        FREE_RTL_ARRAY(parts, arraySize);
+        result = bld_array_temp(anArray);
+      } /* if */
+    } /* if */
+    return result;
+  } /* xml_tag_parts */
@@ -0,0 +1,3581 @@
+/********************************************************************/
+/*                                                                  */
+/*  zst_rtl.c     Primitive actions for Zstandard compression.      */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/zst_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for Zstandard compression.           */
+/*                                                                  */
+/*  The decoder (RFC 8878) processes the blocks of one frame. The   */
+/*  state keeps the window of the frame and the entropy tables of   */
+/*  the previous block. Literals are decoded with a single lookup   */
+/*  Huffman table. The FSE tables of the sequences contain the base */
+/*  values and the number of extra bits, such that a sequence is    */
+/*  decoded with three lookups. A block is decoded when it is       */
+/*  complete in the input. The decoded data is delivered in pieces  */
+/*  of any size. The compressor searches matches with hash chains.  */
+/*  Depending on the level it uses greedy or lazy matching. The     */
+/*  literals are Huffman coded and the sequences use predefined,    */
+/*  RLE or custom FSE tables, whatever needs the fewest bits.       */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+#include "dfl_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "zst_rtl.h"
+
+
+#define DECOMPRESS_MAGIC  0x7a737464
+#define BLOCK_SIZE_MAX    131072
+#define COPY_SLACK        32  /* Matches and literals are copied in chunks of 16 bytes. */
+#define MAX_WINDOW_SIZE   0x80000000
+#define MAX_HUFFMAN_BITS  11
+#define MAX_WEIGHT_SYMBOL 12
+#define WEIGHT_MAX_LOG    6
+#define MAX_LL_SYMBOL     35
+#define MAX_ML_SYMBOL     52
+#define MAX_OF_SYMBOL     31
+#define LL_MAX_LOG        9
+#define ML_MAX_LOG        9
+#define OF_MAX_LOG        8
+#define LL_DEFAULT_LOG    6
+#define ML_DEFAULT_LOG    6
+#define OF_DEFAULT_LOG    5
+#define MAX_FSE_SYMBOLS   64
+
+#define BLOCK_RAW         0
+#define BLOCK_RLE         1
+#define BLOCK_COMPRESSED  2
+
+#define LITERALS_RAW        0
+#define LITERALS_RLE        1
+#define LITERALS_COMPRESSED 2
+#define LITERALS_TREELESS   3
+
+#define MODE_PREDEFINED   0
+#define MODE_RLE          1
+#define MODE_FSE          2
+#define MODE_REPEAT       3
+
+#define TABLE_LITERAL_LENGTH 0
+#define TABLE_OFFSET         1
+#define TABLE_MATCH_LENGTH   2
+
+#define PRIME64_1 UINT64_SUFFIX(0x9e3779b185ebca87)
+#define PRIME64_2 UINT64_SUFFIX(0xc2b2ae3d27d4eb4f)
+#define PRIME64_3 UINT64_SUFFIX(0x165667b19e3779f9)
+#define PRIME64_4 UINT64_SUFFIX(0x85ebca77c2b2ae63)
+#define PRIME64_5 UINT64_SUFFIX(0x27d4eb2f165667c5)
+
+#define ROTATE_LEFT64(x, n) ((x) << (n) | (x) >> (64 - (n)))
+
+/**
+ *  State of an XXH64 computation with the seed 0.
+ *  The content checksum of a frame is the low half of the XXH64.
+ */
+typedef struct {
+    uint64Type accumulator[4];
+    uint64Type totalLength;
+    ucharType buffer[32];
+    unsigned int bufferFill;
+  } xxh64Record, *xxh64Type;
+
+/**
+ *  Reader for a bitstream that is read backward. The last byte of
+ *  the stream contains a marker bit. The bits above the container
+ *  position have been consumed.
+ */
+typedef struct {
+    uint64Type container;
+    unsigned int consumed;
+    const ucharType *pos;
+    const ucharType *start;
+  } backwardReaderRecord, *backwardReaderType;
+
+typedef struct {
+    uint8Type symbol;
+    uint8Type bits;
+  } huffmanEntryType;
+
+typedef struct {
+    uint16Type nextState;
+    uint8Type symbol;
+    uint8Type bits;
+  } fseEntryType;
+
+/* An FSE table entry for sequences with the value of the symbol. */
+typedef struct {
+    uint32Type baseValue;
+    uint16Type nextState;
+    uint8Type extraBits;
+    uint8Type bits;
+  } sequenceEntryType;
+
+typedef struct {
+    uint32Type magic;
+    boolType lastBlock;
+    boolType finished;
+    boolType checksumFlag;
+    boolType huffmanValid;
+    unsigned int huffmanBits;
+    boolType tableValid[3];
+    unsigned int tableLog[3];
+    uint32Type repeatOffset[3];
+    intType contentSize;  /* -1 if the content size is unknown. */
+    uint64Type produced;
+    memSizeType windowSize;
+    memSizeType bufferSize;
+    memSizeType outputPos;
+    memSizeType deliverPos;
+    xxh64Record checksum;
+    huffmanEntryType huffmanTable[1 << MAX_HUFFMAN_BITS];
+    sequenceEntryType literalLengthTable[1 << LL_MAX_LOG];
+    sequenceEntryType offsetTable[1 << OF_MAX_LOG];
+    sequenceEntryType matchLengthTable[1 << ML_MAX_LOG];
+    ucharType literals[BLOCK_SIZE_MAX + COPY_SLACK];
+    ucharType blockData[BLOCK_SIZE_MAX];
+    /* The window with bufferSize + COPY_SLACK bytes follows. */
+  } decompressStateRecord, *decompressStateType;
+
+typedef const decompressStateRecord *const_decompressStateType;
+
+#define WINDOW(state) ((ucharType *) &(state)[1])
+
+/**
+ *  Output of a call. The string grows as needed up to limit.
+ */
+typedef struct {
+    striType stri;
+    memSizeType pos;
+    memSizeType capacity;
+    memSizeType limit;
+  } outputRecord, *outputType;
+
+static const uint32Type literalLengthBase[MAX_LL_SYMBOL + 1] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512,
+    1024, 2048, 4096, 8192, 16384, 32768, 65536
+  };
+
+static const uint8Type literalLengthExtra[MAX_LL_SYMBOL + 1] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+  };
+
+static const uint32Type matchLengthBase[MAX_ML_SYMBOL + 1] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515,
+    1027, 2051, 4099, 8195, 16387, 32771, 65539
+  };
+
+static const uint8Type matchLengthExtra[MAX_ML_SYMBOL + 1] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16
+  };
+
+/* Predefined distributions. A probability of -1 means less than 1. */
+static const int16Type literalLengthDefaultNorm[MAX_LL_SYMBOL + 1] = {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1
+  };
+
+static const int16Type matchLengthDefaultNorm[MAX_ML_SYMBOL + 1] = {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1
+  };
+
+static const int16Type offsetDefaultNorm[29] = {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+  };
+
+static const struct {
+    const int16Type *defaultNorm;
+    unsigned int defaultMaxSymbol;
+    unsigned int defaultLog;
+    unsigned int maxSymbol;
+    unsigned int maxLog;
+  } tableKind[] = {
+    {literalLengthDefaultNorm, MAX_LL_SYMBOL, LL_DEFAULT_LOG, MAX_LL_SYMBOL, LL_MAX_LOG},
+    {offsetDefaultNorm,        28,            OF_DEFAULT_LOG, MAX_OF_SYMBOL, OF_MAX_LOG},
+    {matchLengthDefaultNorm,   MAX_ML_SYMBOL, ML_DEFAULT_LOG, MAX_ML_SYMBOL, ML_MAX_LOG}
+  };
+
+static boolType defaultTablesBuilt = FALSE;
+static sequenceEntryType defaultTable[3][1 << LL_DEFAULT_LOG];
+
+
+
+static inline uint32Type readLittleEndian16 (const ucharType *bytes)
+
+  { /* readLittleEndian16 */
+    return (uint32Type) bytes[0] | (uint32Type) bytes[1] << 8;
+  } /* readLittleEndian16 */
+
+
+
+static inline uint32Type readLittleEndian24 (const ucharType *bytes)
+
+  { /* readLittleEndian24 */
+    return (uint32Type) bytes[0] | (uint32Type) bytes[1] << 8 |
+           (uint32Type) bytes[2] << 16;
+  } /* readLittleEndian24 */
+
+
+
+static inline uint32Type readLittleEndian32 (const ucharType *bytes)
+
+  { /* readLittleEndian32 */
+    return (uint32Type) bytes[0] | (uint32Type) bytes[1] << 8 |
+           (uint32Type) bytes[2] << 16 | (uint32Type) bytes[3] << 24;
+  } /* readLittleEndian32 */
+
+
+
+static inline uint64Type readLittleEndian64 (const ucharType *bytes)
+
+  { /* readLittleEndian64 */
+    return (uint64Type) bytes[0]       | (uint64Type) bytes[1] <<  8 |
+           (uint64Type) bytes[2] << 16 | (uint64Type) bytes[3] << 24 |
+           (uint64Type) bytes[4] << 32 | (uint64Type) bytes[5] << 40 |
+           (uint64Type) bytes[6] << 48 | (uint64Type) bytes[7] << 56;
+  } /* readLittleEndian64 */
+
+
+
+static inline void writeLittleEndian64 (ucharType *bytes, uint64Type value)
+
+  {
+    int index;
+
+  /* writeLittleEndian64 */
+    for (index = 0; index < 8; index++) {
+      bytes[index] = (ucharType) (value & 0xff);
+      value >>= 8;
+    } /* for */
+  } /* writeLittleEndian64 */
+
+
+
+/**
+ *  Determine the index of the highest one bit of a number.
+ *  The number must not be zero.
+ */
+static inline unsigned int highBit (uint32Type number)
+
+  {
+    unsigned int result = 0;
+
+  /* highBit */
+    if (number >= 0x10000) { number >>= 16; result += 16; }
+    if (number >= 0x100)   { number >>= 8;  result += 8;  }
+    if (number >= 0x10)    { number >>= 4;  result += 4;  }
+    if (number >= 0x4)     { number >>= 2;  result += 2;  }
+    if (number >= 0x2)     {                result += 1;  }
+    return result;
+  } /* highBit */
+
+
+
+static inline uint64Type xxh64Round (uint64Type accumulator, uint64Type input)
+
+  { /* xxh64Round */
+    accumulator += input * PRIME64_2;
+    accumulator = ROTATE_LEFT64(accumulator, 31);
+    return accumulator * PRIME64_1;
+  } /* xxh64Round */
+
+
+
+static inline uint64Type xxh64Merge (uint64Type hash, uint64Type accumulator)
+
+  { /* xxh64Merge */
+    hash ^= xxh64Round(0, accumulator);
+    return hash * PRIME64_1 + PRIME64_4;
+  } /* xxh64Merge */
+
+
+
+static void xxh64Init (xxh64Type hash)
+
+  { /* xxh64Init */
+    memset(hash, 0, sizeof(xxh64Record));
+    hash->accumulator[0] = PRIME64_1 + PRIME64_2;
+    hash->accumulator[1] = PRIME64_2;
+    hash->accumulator[2] = 0;
+    hash->accumulator[3] = 0 - PRIME64_1;
+  } /* xxh64Init */
+
+
+
+static void xxh64Stripe (xxh64Type hash, const ucharType *stripe)
+
+  { /* xxh64Stripe */
+    hash->accumulator[0] = xxh64Round(hash->accumulator[0], readLittleEndian64(stripe));
+    hash->accumulator[1] = xxh64Round(hash->accumulator[1], readLittleEndian64(&stripe[8]));
+    hash->accumulator[2] = xxh64Round(hash->accumulator[2], readLittleEndian64(&stripe[16]));
+    hash->accumulator[3] = xxh64Round(hash->accumulator[3], readLittleEndian64(&stripe[24]));
+  } /* xxh64Stripe */
+
+
+
+static void xxh64Update (xxh64Type hash, const ucharType *data, memSizeType length)
+
+  {
+    memSizeType count;
+
+  /* xxh64Update */
+    hash->totalLength += length;
+    if (hash->bufferFill != 0) {
+      count = 32 - hash->bufferFill;
+      if (count > length) {
+        count = length;
+      } /* if */
+      memcpy(&hash->buffer[hash->bufferFill], data, count);
+      hash->bufferFill += (unsigned int) count;
+      data += count;
+      length -= count;
+      if (hash->bufferFill == 32) {
+        xxh64Stripe(hash, hash->buffer);
+        hash->bufferFill = 0;
+      } /* if */
+    } /* if */
+    while (length >= 32) {
+      xxh64Stripe(hash, data);
+      data += 32;
+      length -= 32;
+    } /* while */
+    if (length != 0) {
+      memcpy(hash->buffer, data, length);
+      hash->bufferFill = (unsigned int) length;
+    } /* if */
+  } /* xxh64Update */
+
+
+
+static uint64Type xxh64Digest (const xxh64Record *hash)
+
+  {
+    uint64Type digest;
+    const ucharType *data;
+    unsigned int length;
+
+  /* xxh64Digest */
+    if (hash->totalLength >= 32) {
+      digest = ROTATE_LEFT64(hash->accumulator[0], 1) +
+               ROTATE_LEFT64(hash->accumulator[1], 7) +
+               ROTATE_LEFT64(hash->accumulator[2], 12) +
+               ROTATE_LEFT64(hash->accumulator[3], 18);
+      digest = xxh64Merge(digest, hash->accumulator[0]);
+      digest = xxh64Merge(digest, hash->accumulator[1]);
+      digest = xxh64Merge(digest, hash->accumulator[2]);
+      digest = xxh64Merge(digest, hash->accumulator[3]);
+    } else {
+      digest = PRIME64_5;
+    } /* if */
+    digest += hash->totalLength;
+    data = hash->buffer;
+    length = hash->bufferFill;
+    while (length >= 8) {
+      digest ^= xxh64Round(0, readLittleEndian64(data));
+      digest = ROTATE_LEFT64(digest, 27) * PRIME64_1 + PRIME64_4;
+      data += 8;
+      length -= 8;
+    } /* while */
+    if (length >= 4) {
+      digest ^= (uint64Type) readLittleEndian32(data) * PRIME64_1;
+      digest = ROTATE_LEFT64(digest, 23) * PRIME64_2 + PRIME64_3;
+      data += 4;
+      length -= 4;
+    } /* if */
+    while (length != 0) {
+      digest ^= (uint64Type) *data * PRIME64_5;
+      digest = ROTATE_LEFT64(digest, 11) * PRIME64_1;
+      data++;
+      length--;
+    } /* while */
+    digest ^= digest >> 33;
+    digest *= PRIME64_2;
+    digest ^= digest >> 29;
+    digest *= PRIME64_3;
+    digest ^= digest >> 32;
+    return digest;
+  } /* xxh64Digest */
+
+
+
+/**
+ *  Make sure that the output string has room for at least minimum
+ *  characters (but not more than allowed by the limit).
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType growOutput (outputType output, memSizeType minimum)
+
+  {
+    memSizeType newCapacity;
+    striType resized;
+
+  /* growOutput */
+    if (minimum > output->limit - output->pos) {
+      minimum = output->limit - output->pos;
+    } /* if */
+    if (output->capacity - output->pos < minimum) {
+      if (output->capacity > output->limit / 2) {
+        newCapacity = output->limit;
+      } else {
+        newCapacity = 2 * output->capacity;
+      } /* if */
+      if (newCapacity - output->pos < minimum) {
+        newCapacity = output->pos + minimum;
+      } /* if */
+      REALLOC_STRI_CHECK_SIZE(resized, output->stri, output->capacity, newCapacity);
+      if (unlikely(resized == NULL)) {
+        return FALSE;
+      } /* if */
+      COUNT3_STRI(output->capacity, newCapacity);
+      output->stri = resized;
+      output->capacity = newCapacity;
+    } /* if */
+    return TRUE;
+  } /* growOutput */
+
+
+
+/**
+ *  Shrink the output string to its actual size.
+ *  @return the output string, or NULL if there is not enough memory.
+ */
+static striType finishOutput (outputType output)
+
+  {
+    striType resized;
+
+  /* finishOutput */
+    if (output->pos != output->capacity) {
+      REALLOC_STRI_SIZE_OK(resized, output->stri, output->capacity, output->pos);
+      if (unlikely(resized == NULL)) {
+        FREE_STRI(output->stri, output->capacity);
+        return NULL;
+      } /* if */
+      COUNT3_STRI(output->capacity, output->pos);
+      output->stri = resized;
+    } /* if */
+    output->stri->size = output->pos;
+    return output->stri;
+  } /* finishOutput */
+
+
+
+/**
+ *  Initialize a reader for a backward bitstream.
+ *  @return FALSE if the stream is empty or the last byte is zero.
+ */
+static boolType initBackwardReader (backwardReaderType reader,
+    const ucharType *start, memSizeType size)
+
+  {
+    memSizeType index;
+
+  /* initBackwardReader */
+    if (unlikely(size == 0 || start[size - 1] == 0)) {
+      return FALSE;
+    } /* if */
+    reader->start = start;
+    /* The marker bit and the zero bits above it are consumed. */
+    reader->consumed = 8 - highBit(start[size - 1]);
+    if (size >= 8) {
+      reader->pos = &start[size - 8];
+      reader->container = readLittleEndian64(reader->pos);
+    } else {
+      reader->pos = start;
+      reader->container = 0;
+      for (index = 0; index < size; index++) {
+        reader->container |= (uint64Type) start[index] << (8 * index);
+      } /* for */
+      reader->consumed += (unsigned int) (8 - size) * 8;
+    } /* if */
+    return TRUE;
+  } /* initBackwardReader */
+
+
+
+/* Get the next count bits (count from 0 to 56) without consuming them. */
+#define PEEK_BITS(reader, count) \
+    ((((reader)->container << ((reader)->consumed & 63)) >> 1) >> (63 - (count)))
+
+#define SKIP_BITS(reader, count) (reader)->consumed += (count)
+
+
+
+static inline uint32Type readBits (backwardReaderType reader, unsigned int count)
+
+  {
+    uint32Type bits;
+
+  /* readBits */
+    bits = (uint32Type) PEEK_BITS(reader, count);
+    reader->consumed += count;
+    return bits;
+  } /* readBits */
+
+
+
+/**
+ *  Load the next bytes into the container. Afterwards at least 57
+ *  bits are available, except at the beginning of the stream.
+ *  Nothing is loaded if more bits have been consumed than
+ *  available (overflow) or if the beginning has been reached.
+ */
+static inline void reloadReader (backwardReaderType reader)
+
+  {
+    memSizeType numBytes;
+
+  /* reloadReader */
+    if (reader->consumed <= 64 && reader->pos != reader->start) {
+      numBytes = reader->consumed >> 3;
+      if ((memSizeType) (reader->pos - reader->start) < numBytes) {
+        numBytes = (memSizeType) (reader->pos - reader->start);
+      } /* if */
+      reader->pos -= numBytes;
+      reader->consumed -= (unsigned int) numBytes * 8;
+      reader->container = readLittleEndian64(reader->pos);
+    } /* if */
+  } /* reloadReader */
+
+
+
+static inline boolType readerFinished (const backwardReaderRecord *reader)
+
+  { /* readerFinished */
+    return reader->pos == reader->start && reader->consumed == 64;
+  } /* readerFinished */
+
+
+
+static inline boolType readerOverflow (const backwardReaderRecord *reader)
+
+  { /* readerOverflow */
+    return reader->consumed > 64;
+  } /* readerOverflow */
+
+
+
+/**
+ *  Read count bits (up to 25) starting at the bit position bitPos
+ *  of a forward bitstream. Bits after the end of src are zero.
+ */
+static uint32Type peekForward (const ucharType *src, memSizeType srcSize,
+    memSizeType bitPos, unsigned int count)
+
+  {
+    memSizeType bytePos;
+    uint32Type value = 0;
+    unsigned int index;
+
+  /* peekForward */
+    bytePos = bitPos >> 3;
+    for (index = 0; index < 4 && bytePos + index < srcSize; index++) {
+      value |= (uint32Type) src[bytePos + index] << (8 * index);
+    } /* for */
+    return (value >> (bitPos & 7)) & ((1U << count) - 1);
+  } /* peekForward */
+
+
+
+/**
+ *  Read the description of an FSE distribution (the normalized
+ *  probabilities of the symbols). A probability of -1 means that
+ *  the probability of the symbol is less than 1.
+ *  @param used Number of bytes used by the description.
+ *  @return FALSE if the description is not valid.
+ */
+static boolType readProbabilities (const ucharType *src, memSizeType srcSize,
+    unsigned int maxSymbol, unsigned int maxLog, int16Type *norm,
+    unsigned int *numSymbols, unsigned int *accuracyLog, memSizeType *used)
+
+  {
+    memSizeType bitPos;
+    uint32Type value;
+    int remaining;
+    int threshold;
+    int maxValue;
+    int count;
+    unsigned int numBits;
+    unsigned int symbol = 0;
+    unsigned int repeat;
+
+  /* readProbabilities */
+    if (unlikely(srcSize == 0)) {
+      return FALSE;
+    } /* if */
+    *accuracyLog = (src[0] & 0x0f) + 5;
+    if (unlikely(*accuracyLog > maxLog)) {
+      return FALSE;
+    } /* if */
+    bitPos = 4;
+    threshold = 1 << *accuracyLog;
+    remaining = threshold + 1;
+    numBits = *accuracyLog + 1;
+    while (remaining > 1) {
+      if (unlikely(symbol > maxSymbol || bitPos >= 8 * srcSize)) {
+        return FALSE;
+      } /* if */
+      value = peekForward(src, srcSize, bitPos, numBits);
+      maxValue = 2 * threshold - 1 - remaining;
+      if ((int) (value & (uint32Type) (threshold - 1)) < maxValue) {
+        count = (int) (value & (uint32Type) (threshold - 1));
+        bitPos += numBits - 1;
+      } else {
+        count = (int) value;
+        if (count >= threshold) {
+          count -= maxValue;
+        } /* if */
+        bitPos += numBits;
+      } /* if */
+      count--;
+      remaining -= count < 0 ? -count : count;
+      norm[symbol++] = (int16Type) count;
+      if (unlikely(remaining < 1)) {
+        return FALSE;
+      } /* if */
+      if (count == 0) {
+        /* Repeat flags of 2 bits tell how many zero probabilities follow. */
+        do {
+          repeat = peekForward(src, srcSize, bitPos, 2);
+          bitPos += 2;
+          if (unlikely(symbol + repeat > maxSymbol + 1)) {
+            return FALSE;
+          } /* if */
+          for (; repeat != 0; repeat--) {
+            norm[symbol++] = 0;
+          } /* for */
+        } while (peekForward(src, srcSize, bitPos - 2, 2) == 3);
+      } /* if */
+      while (remaining < threshold) {
+        numBits--;
+        threshold >>= 1;
+      } /* while */
+    } /* while */
+    *used = (bitPos + 7) >> 3;
+    if (unlikely(remaining != 1 || *used > srcSize)) {
+      return FALSE;
+    } /* if */
+    *numSymbols = symbol;
+    return TRUE;
+  } /* readProbabilities */
+
+
+
+/**
+ *  Build an FSE decoding table from the normalized probabilities.
+ *  The symbols are spread over the table and the symbols with a
+ *  probability of less than 1 get the last entries of the table.
+ *  @return FALSE if the probabilities do not fill the table.
+ */
+static boolType buildFseTable (const int16Type *norm, unsigned int numSymbols,
+    unsigned int accuracyLog, fseEntryType *table)
+
+  {
+    unsigned int tableSize;
+    unsigned int highThreshold;
+    unsigned int step;
+    unsigned int mask;
+    unsigned int position = 0;
+    unsigned int symbol;
+    unsigned int index;
+    uint16Type symbolNext[256];
+    unsigned int nextState;
+
+  /* buildFseTable */
+    tableSize = 1U << accuracyLog;
+    highThreshold = tableSize - 1;
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (norm[symbol] == -1) {
+        table[highThreshold].symbol = (uint8Type) symbol;
+        highThreshold--;
+        symbolNext[symbol] = 1;
+      } else {
+        symbolNext[symbol] = (uint16Type) norm[symbol];
+      } /* if */
+    } /* for */
+    step = (tableSize >> 1) + (tableSize >> 3) + 3;
+    mask = tableSize - 1;
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      for (index = 0; index < (unsigned int) (norm[symbol] > 0 ? norm[symbol] : 0); index++) {
+        table[position].symbol = (uint8Type) symbol;
+        do {
+          position = (position + step) & mask;
+        } while (position > highThreshold);
+      } /* for */
+    } /* for */
+    if (unlikely(position != 0)) {
+      return FALSE;
+    } /* if */
+    for (index = 0; index < tableSize; index++) {
+      nextState = symbolNext[table[index].symbol]++;
+      table[index].bits = (uint8Type) (accuracyLog - highBit(nextState));
+      table[index].nextState = (uint16Type) ((nextState << table[index].bits) - tableSize);
+    } /* for */
+    return TRUE;
+  } /* buildFseTable */
+
+
+
+/**
+ *  Build a decoding table for a sequence field (literal length,
+ *  offset or match length). The entries contain the base value and
+ *  the number of extra bits of the symbol.
+ */
+static boolType buildSequenceTable (const int16Type *norm, unsigned int numSymbols,
+    unsigned int accuracyLog, unsigned int kind, sequenceEntryType *table)
+
+  {
+    fseEntryType fseTable[1 << LL_MAX_LOG];
+    unsigned int index;
+    unsigned int symbol;
+
+  /* buildSequenceTable */
+    if (unlikely(!buildFseTable(norm, numSymbols, accuracyLog, fseTable))) {
+      return FALSE;
+    } /* if */
+    for (index = 0; index < 1U << accuracyLog; index++) {
+      symbol = fseTable[index].symbol;
+      if (kind == TABLE_LITERAL_LENGTH) {
+        table[index].baseValue = literalLengthBase[symbol];
+        table[index].extraBits = literalLengthExtra[symbol];
+      } else if (kind == TABLE_MATCH_LENGTH) {
+        table[index].baseValue = matchLengthBase[symbol];
+        table[index].extraBits = matchLengthExtra[symbol];
+      } else {
+        /* The offset code is the number of extra bits. */
+        table[index].baseValue = (uint32Type) 1 << symbol;
+        table[index].extraBits = (uint8Type) symbol;
+      } /* if */
+      table[index].nextState = fseTable[index].nextState;
+      table[index].bits = fseTable[index].bits;
+    } /* for */
+    return TRUE;
+  } /* buildSequenceTable */
+
+
+
+static void buildDefaultTables (void)
+
+  {
+    unsigned int kind;
+
+  /* buildDefaultTables */
+    for (kind = TABLE_LITERAL_LENGTH; kind <= TABLE_MATCH_LENGTH; kind++) {
+      buildSequenceTable(tableKind[kind].defaultNorm,
+                         tableKind[kind].defaultMaxSymbol + 1,
+                         tableKind[kind].defaultLog, kind, defaultTable[kind]);
+    } /* for */
+    defaultTablesBuilt = TRUE;
+  } /* buildDefaultTables */
+
+
+
+/**
+ *  Read the Huffman weights, which are compressed with FSE.
+ *  Two interleaved FSE states are used, which share one bitstream.
+ *  @return the number of weights or 0 if the data is not valid.
+ */
+static unsigned int readFseWeights (const ucharType *src, memSizeType srcSize,
+    uint8Type *weights)
+
+  {
+    int16Type norm[MAX_WEIGHT_SYMBOL + 1];
+    unsigned int numSymbols;
+    unsigned int accuracyLog;
+    memSizeType used;
+    fseEntryType table[1 << WEIGHT_MAX_LOG];
+    backwardReaderRecord reader;
+    unsigned int state[2];
+    unsigned int current = 0;
+    unsigned int numWeights = 0;
+    const fseEntryType *entry;
+
+  /* readFseWeights */
+    if (!readProbabilities(src, srcSize, MAX_WEIGHT_SYMBOL, WEIGHT_MAX_LOG, norm,
+                           &numSymbols, &accuracyLog, &used) ||
+        !buildFseTable(norm, numSymbols, accuracyLog, table) ||
+        !initBackwardReader(&reader, &src[used], srcSize - used)) {
+      return 0;
+    } /* if */
+    state[0] = readBits(&reader, accuracyLog);
+    state[1] = readBits(&reader, accuracyLog);
+    while (TRUE) {
+      /* The stream ends when the update of a state overflows. */
+      if (unlikely(numWeights >= 254)) {
+        return 0;
+      } /* if */
+      entry = &table[state[current]];
+      weights[numWeights++] = entry->symbol;
+      state[current] = entry->nextState + readBits(&reader, entry->bits);
+      reloadReader(&reader);
+      current = 1 - current;
+      if (readerOverflow(&reader)) {
+        weights[numWeights++] = table[state[current]].symbol;
+        return numWeights;
+      } /* if */
+    } /* while */
+  } /* readFseWeights */
+
+
+
+/**
+ *  Read the Huffman tree description and build the decoding table.
+ *  @param used Number of bytes used by the description.
+ *  @return FALSE if the description is not valid.
+ */
+static boolType readHuffmanTree (decompressStateType state,
+    const ucharType *src, memSizeType srcSize, memSizeType *used)
+
+  {
+    uint8Type weights[256];
+    unsigned int numWeights;
+    unsigned int index;
+    uint32Type weightSum = 0;
+    uint32Type rest;
+    unsigned int maxBits;
+    unsigned int weight;
+    unsigned int position = 0;
+    unsigned int count;
+    huffmanEntryType entry;
+
+  /* readHuffmanTree */
+    if (unlikely(srcSize == 0)) {
+      return FALSE;
+    } /* if */
+    if (src[0] >= 128) {
+      numWeights = src[0] - 127U;
+      *used = 1 + (numWeights + 1) / 2;
+      if (unlikely(*used > srcSize)) {
+        return FALSE;
+      } /* if */
+      for (index = 0; index < numWeights; index++) {
+        weights[index] = (uint8Type) ((index & 1) == 0 ?
+            src[1 + index / 2] >> 4 : src[1 + index / 2] & 0x0f);
+      } /* for */
+    } else {
+      *used = 1 + (memSizeType) src[0];
+      if (unlikely(*used > srcSize)) {
+        return FALSE;
+      } /* if */
+      numWeights = readFseWeights(&src[1], src[0], weights);
+      if (unlikely(numWeights == 0)) {
+        return FALSE;
+      } /* if */
+    } /* if */
+    for (index = 0; index < numWeights; index++) {
+      if (unlikely(weights[index] > MAX_HUFFMAN_BITS)) {
+        return FALSE;
+      } /* if */
+      if (weights[index] != 0) {
+        weightSum += (uint32Type) 1 << (weights[index] - 1);
+      } /* if */
+    } /* for */
+    if (unlikely(weightSum == 0)) {
+      return FALSE;
+    } /* if */
+    /* The weight of the last symbol fills the sum to a power of two. */
+    maxBits = highBit(weightSum) + 1;
+    rest = ((uint32Type) 1 << maxBits) - weightSum;
+    if (unlikely(maxBits > MAX_HUFFMAN_BITS || (rest & (rest - 1)) != 0)) {
+      return FALSE;
+    } /* if */
+    weights[numWeights++] = (uint8Type) (highBit(rest) + 1);
+    /* Codes are assigned by increasing weight and then by symbol. */
+    for (weight = 1; weight <= maxBits; weight++) {
+      entry.bits = (uint8Type) (maxBits + 1 - weight);
+      for (index = 0; index < numWeights; index++) {
+        if (weights[index] == weight) {
+          entry.symbol = (uint8Type) index;
+          for (count = 1U << (weight - 1); count != 0; count--) {
+            state->huffmanTable[position++] = entry;
+          } /* for */
+        } /* if */
+      } /* for */
+    } /* for */
+    state->huffmanBits = maxBits;
+    state->huffmanValid = TRUE;
+    return TRUE;
+  } /* readHuffmanTree */
+
+
+
+#define DECODE_SYMBOL(reader, table, maxBits, dest) { \
+    const huffmanEntryType *entry_ = &(table)[PEEK_BITS(reader, maxBits)]; \
+    (dest) = entry_->symbol; \
+    SKIP_BITS(reader, entry_->bits); }
+
+
+
+/**
+ *  Decode one Huffman coded stream of literals.
+ *  @return FALSE if the stream does not end after count symbols.
+ */
+static boolType decodeHuffmanStream (const_decompressStateType state,
+    const ucharType *src, memSizeType srcSize, ucharType *dest,
+    memSizeType count)
+
+  {
+    backwardReaderRecord reader;
+    const huffmanEntryType *table;
+    unsigned int maxBits;
+    ucharType *end;
+
+  /* decodeHuffmanStream */
+    if (unlikely(!initBackwardReader(&reader, src, srcSize))) {
+      return FALSE;
+    } /* if */
+    table = state->huffmanTable;
+    maxBits = state->huffmanBits;
+    end = &dest[count];
+    /* After a reload at least 57 bits are available. */
+    while (end - dest >= 4) {
+      reloadReader(&reader);
+      DECODE_SYMBOL(&reader, table, maxBits, dest[0]);
+      DECODE_SYMBOL(&reader, table, maxBits, dest[1]);
+      DECODE_SYMBOL(&reader, table, maxBits, dest[2]);
+      DECODE_SYMBOL(&reader, table, maxBits, dest[3]);
+      dest += 4;
+    } /* while */
+    reloadReader(&reader);
+    while (dest < end) {
+      DECODE_SYMBOL(&reader, table, maxBits, *dest);
+      dest++;
+    } /* while */
+    reloadReader(&reader);
+    return readerFinished(&reader);
+  } /* decodeHuffmanStream */
+
+
+
+/**
+ *  Decode the literals section of a compressed block into
+ *  state->literals.
+ *  @param used Number of bytes used by the literals section.
+ *  @return the number of literals or -1 if the section is not valid.
+ */
+static intType decodeLiterals (decompressStateType state, const ucharType *src,
+    memSizeType srcSize, memSizeType *used)
+
+  {
+    unsigned int type;
+    unsigned int sizeFormat;
+    memSizeType headerSize;
+    memSizeType regenerated;
+    memSizeType compressedSize = 0;
+    boolType fourStreams = FALSE;
+    memSizeType treeSize = 0;
+    memSizeType streamSize[4];
+    memSizeType segment;
+    const ucharType *stream;
+    memSizeType index;
+
+  /* decodeLiterals */
+    if (unlikely(srcSize == 0)) {
+      return -1;
+    } /* if */
+    type = src[0] & 3;
+    sizeFormat = (src[0] >> 2) & 3;
+    if (type == LITERALS_RAW || type == LITERALS_RLE) {
+      if ((sizeFormat & 1) == 0) {
+        headerSize = 1;
+        regenerated = src[0] >> 3;
+      } else if (sizeFormat == 1) {
+        headerSize = 2;
+        if (unlikely(srcSize < 2)) {
+          return -1;
+        } /* if */
+        regenerated = readLittleEndian16(src) >> 4;
+      } else {
+        headerSize = 3;
+        if (unlikely(srcSize < 3)) {
+          return -1;
+        } /* if */
+        regenerated = readLittleEndian24(src) >> 4;
+      } /* if */
+      if (unlikely(regenerated > BLOCK_SIZE_MAX)) {
+        return -1;
+      } /* if */
+      if (type == LITERALS_RAW) {
+        if (unlikely(srcSize - headerSize < regenerated)) {
+          return -1;
+        } /* if */
+        memcpy(state->literals, &src[headerSize], regenerated);
+        *used = headerSize + regenerated;
+      } else {
+        if (unlikely(srcSize - headerSize < 1)) {
+          return -1;
+        } /* if */
+        memset(state->literals, src[headerSize], regenerated);
+        *used = headerSize + 1;
+      } /* if */
+    } else {
+      if (unlikely(srcSize < 5)) {
+        return -1;
+      } /* if */
+      if (sizeFormat <= 1) {
+        headerSize = 3;
+        fourStreams = sizeFormat == 1;
+        regenerated = (readLittleEndian24(src) >> 4) & 0x3ff;
+        compressedSize = readLittleEndian24(src) >> 14;
+      } else if (sizeFormat == 2) {
+        headerSize = 4;
+        fourStreams = TRUE;
+        regenerated = (readLittleEndian32(src) >> 4) & 0x3fff;
+        compressedSize = readLittleEndian32(src) >> 18;
+      } else {
+        headerSize = 5;
+        fourStreams = TRUE;
+        regenerated = (readLittleEndian32(src) >> 4) & 0x3ffff;
+        compressedSize = (readLittleEndian32(src) >> 22) | (memSizeType) src[4] << 10;
+      } /* if */
+      if (unlikely(regenerated > BLOCK_SIZE_MAX ||
+                   compressedSize > srcSize - headerSize)) {
+        return -1;
+      } /* if */
+      src += headerSize;
+      if (type == LITERALS_COMPRESSED) {
+        if (unlikely(!readHuffmanTree(state, src, compressedSize, &treeSize))) {
+          return -1;
+        } /* if */
+      } else if (unlikely(!state->huffmanValid)) {
+        return -1;
+      } /* if */
+      stream = &src[treeSize];
+      if (!fourStreams) {
+        if (unlikely(!decodeHuffmanStream(state, stream, compressedSize - treeSize,
+                                          state->literals, regenerated))) {
+          return -1;
+        } /* if */
+      } else {
+        if (unlikely(compressedSize - treeSize < 6)) {
+          return -1;
+        } /* if */
+        streamSize[0] = readLittleEndian16(stream);
+        streamSize[1] = readLittleEndian16(&stream[2]);
+        streamSize[2] = readLittleEndian16(&stream[4]);
+        if (unlikely(streamSize[0] + streamSize[1] + streamSize[2] >
+                     compressedSize - treeSize - 6)) {
+          return -1;
+        } /* if */
+        streamSize[3] = compressedSize - treeSize - 6 -
+            streamSize[0] - streamSize[1] - streamSize[2];
+        segment = (regenerated + 3) / 4;
+        if (unlikely(3 * segment > regenerated)) {
+          return -1;
+        } /* if */
+        stream += 6;
+        for (index = 0; index < 4; index++) {
+          if (unlikely(!decodeHuffmanStream(state, stream, streamSize[index],
+              &state->literals[index * segment],
+              index == 3 ? regenerated - 3 * segment : segment))) {
+            return -1;
+          } /* if */
+          stream += streamSize[index];
+        } /* for */
+      } /* if */
+      *used = headerSize + compressedSize;
+    } /* if */
+    return (intType) regenerated;
+  } /* decodeLiterals */
+
+
+
+/**
+ *  Read the mode and the table description of a sequence field.
+ *  @param used Number of bytes used by the table description.
+ *  @return a pointer to the decoding table, or NULL if the table
+ *          description is not valid.
+ */
+static const sequenceEntryType *readSequenceTable (decompressStateType state,
+    unsigned int kind, unsigned int mode, const ucharType *src,
+    memSizeType srcSize, unsigned int *accuracyLog, memSizeType *used)
+
+  {
+    sequenceEntryType *table;
+    int16Type norm[MAX_FSE_SYMBOLS];
+    unsigned int numSymbols;
+
+  /* readSequenceTable */
+    if (kind == TABLE_LITERAL_LENGTH) {
+      table = state->literalLengthTable;
+    } else if (kind == TABLE_OFFSET) {
+      table = state->offsetTable;
+    } else {
+      table = state->matchLengthTable;
+    } /* if */
+    *used = 0;
+    switch (mode) {
+      case MODE_PREDEFINED:
+        *accuracyLog = tableKind[kind].defaultLog;
+        memcpy(table, defaultTable[kind],
+               sizeof(sequenceEntryType) << tableKind[kind].defaultLog);
+        break;
+      case MODE_RLE:
+        if (unlikely(srcSize < 1 || src[0] > tableKind[kind].maxSymbol)) {
+          return NULL;
+        } /* if */
+        /* A single entry, which does not use bits to change the state. */
+        *accuracyLog = 0;
+        if (kind == TABLE_LITERAL_LENGTH) {
+          table[0].baseValue = literalLengthBase[src[0]];
+          table[0].extraBits = literalLengthExtra[src[0]];
+        } else if (kind == TABLE_MATCH_LENGTH) {
+          table[0].baseValue = matchLengthBase[src[0]];
+          table[0].extraBits = matchLengthExtra[src[0]];
+        } else {
+          table[0].baseValue = (uint32Type) 1 << src[0];
+          table[0].extraBits = src[0];
+        } /* if */
+        table[0].nextState = 0;
+        table[0].bits = 0;
+        *used = 1;
+        break;
+      case MODE_FSE:
+        if (unlikely(!readProbabilities(src, srcSize, tableKind[kind].maxSymbol,
+                                        tableKind[kind].maxLog, norm, &numSymbols,
+                                        accuracyLog, used) ||
+                     !buildSequenceTable(norm, numSymbols, *accuracyLog,
+                                         kind, table))) {
+          return NULL;
+        } /* if */
+        break;
+      default: /* MODE_REPEAT */
+        if (unlikely(!state->tableValid[kind])) {
+          return NULL;
+        } /* if */
+        *accuracyLog = state->tableLog[kind];
+        break;
+    } /* switch */
+    state->tableValid[kind] = TRUE;
+    state->tableLog[kind] = *accuracyLog;
+    return table;
+  } /* readSequenceTable */
+
+
+
+/**
+ *  Copy a match of the window. The copy is done in chunks, which
+ *  may write up to 15 bytes after the end of the match.
+ */
+static inline void copyMatch (ucharType *dest, memSizeType offset,
+    memSizeType length)
+
+  {
+    const ucharType *source;
+    ucharType *end;
+
+  /* copyMatch */
+    source = dest - offset;
+    end = &dest[length];
+    if (offset >= 16) {
+      do {
+        memcpy(dest, source, 16);
+        dest += 16;
+        source += 16;
+      } while (dest < end);
+    } else if (offset >= 8) {
+      do {
+        memcpy(dest, source, 8);
+        dest += 8;
+        source += 8;
+      } while (dest < end);
+    } else {
+      while (dest < end) {
+        *dest++ = *source++;
+      } /* while */
+    } /* if */
+  } /* copyMatch */
+
+
+
+/**
+ *  Decode the sequences section and execute the sequences.
+ *  The literals and matches are written to the window starting at
+ *  state->outputPos.
+ *  @return the number of bytes produced or -1 if the section is
+ *          not valid.
+ */
+static intType decodeSequences (decompressStateType state, const ucharType *src,
+    memSizeType srcSize, memSizeType numLiterals)
+
+  {
+    memSizeType numSequences;
+    memSizeType headerSize;
+    unsigned int modes;
+    unsigned int kind;
+    memSizeType used;
+    const sequenceEntryType *table[3];
+    unsigned int accuracyLog[3];
+    unsigned int fieldState[3];
+    const sequenceEntryType *literalLengthEntry;
+    const sequenceEntryType *offsetEntry;
+    const sequenceEntryType *matchLengthEntry;
+    backwardReaderRecord reader;
+    ucharType *window;
+    ucharType *dest;
+    ucharType *destLimit;
+    const ucharType *literal;
+    const ucharType *literalEnd;
+    memSizeType literalLength;
+    memSizeType matchLength;
+    memSizeType offset;
+    unsigned int repeatIndex;
+    unsigned int extraBits;
+
+  /* decodeSequences */
+    if (unlikely(srcSize == 0)) {
+      return -1;
+    } /* if */
+    if (src[0] < 128) {
+      numSequences = src[0];
+      headerSize = 1;
+    } else if (src[0] < 255) {
+      if (unlikely(srcSize < 2)) {
+        return -1;
+      } /* if */
+      numSequences = ((memSizeType) (src[0] - 128) << 8) + src[1];
+      headerSize = 2;
+    } else {
+      if (unlikely(srcSize < 3)) {
+        return -1;
+      } /* if */
+      numSequences = readLittleEndian16(&src[1]) + 0x7f00;
+      headerSize = 3;
+    } /* if */
+    window = WINDOW(state);
+    dest = &window[state->outputPos];
+    destLimit = &window[state->outputPos + BLOCK_SIZE_MAX];
+    if (destLimit > &window[state->bufferSize]) {
+      destLimit = &window[state->bufferSize];
+    } /* if */
+    literal = state->literals;
+    literalEnd = &state->literals[numLiterals];
+    if (numSequences != 0) {
+      if (unlikely(srcSize < headerSize + 1)) {
+        return -1;
+      } /* if */
+      modes = src[headerSize];
+      if (unlikely((modes & 3) != 0)) {
+        return -1;
+      } /* if */
+      src += headerSize + 1;
+      srcSize -= headerSize + 1;
+      if (!defaultTablesBuilt) {
+        buildDefaultTables();
+      } /* if */
+      for (kind = TABLE_LITERAL_LENGTH; kind <= TABLE_MATCH_LENGTH; kind++) {
+        table[kind] = readSequenceTable(state, kind, (modes >> (6 - 2 * kind)) & 3,
+                                        src, srcSize, &accuracyLog[kind], &used);
+        if (unlikely(table[kind] == NULL)) {
+          return -1;
+        } /* if */
+        src += used;
+        srcSize -= used;
+      } /* for */
+      if (unlikely(!initBackwardReader(&reader, src, srcSize))) {
+        return -1;
+      } /* if */
+      fieldState[TABLE_LITERAL_LENGTH] = readBits(&reader, accuracyLog[TABLE_LITERAL_LENGTH]);
+      fieldState[TABLE_OFFSET] = readBits(&reader, accuracyLog[TABLE_OFFSET]);
+      fieldState[TABLE_MATCH_LENGTH] = readBits(&reader, accuracyLog[TABLE_MATCH_LENGTH]);
+      while (TRUE) {
+        reloadReader(&reader);
+        literalLengthEntry = &table[TABLE_LITERAL_LENGTH][fieldState[TABLE_LITERAL_LENGTH]];
+        offsetEntry = &table[TABLE_OFFSET][fieldState[TABLE_OFFSET]];
+        matchLengthEntry = &table[TABLE_MATCH_LENGTH][fieldState[TABLE_MATCH_LENGTH]];
+        offset = offsetEntry->baseValue + readBits(&reader, offsetEntry->extraBits);
+        extraBits = (unsigned int) offsetEntry->extraBits +
+            matchLengthEntry->extraBits + literalLengthEntry->extraBits;
+        /* Usually the extra bits and the state updates fit into 56 bits. */
+        if (extraBits > 56 - LL_MAX_LOG - ML_MAX_LOG - OF_MAX_LOG) {
+          reloadReader(&reader);
+        } /* if */
+        matchLength = matchLengthEntry->baseValue +
+            readBits(&reader, matchLengthEntry->extraBits);
+        literalLength = literalLengthEntry->baseValue +
+            readBits(&reader, literalLengthEntry->extraBits);
+        if (offset > 3) {
+          offset -= 3;
+          state->repeatOffset[2] = state->repeatOffset[1];
+          state->repeatOffset[1] = state->repeatOffset[0];
+          state->repeatOffset[0] = (uint32Type) offset;
+        } else {
+          /* Repeat offset. Without literals the index is shifted by 1. */
+          repeatIndex = (unsigned int) offset - 1 + (literalLength == 0);
+          if (repeatIndex == 3) {
+            offset = state->repeatOffset[0] - 1;
+          } else {
+            offset = state->repeatOffset[repeatIndex];
+          } /* if */
+          if (repeatIndex != 0) {
+            if (repeatIndex != 1) {
+              state->repeatOffset[2] = state->repeatOffset[1];
+            } /* if */
+            state->repeatOffset[1] = state->repeatOffset[0];
+            state->repeatOffset[0] = (uint32Type) offset;
+          } /* if */
+        } /* if */
+        if (unlikely(literalLength > (memSizeType) (literalEnd - literal) ||
+                     literalLength + matchLength > (memSizeType) (destLimit - dest) ||
+                     offset == 0 ||
+                     offset > (memSizeType) (dest - window) + literalLength ||
+                     offset > state->windowSize)) {
+          return -1;
+        } /* if */
+        /* The buffers have room for copies in chunks of 16 bytes. */
+        memcpy(dest, literal, 16);
+        if (literalLength > 16) {
+          memcpy(&dest[16], &literal[16], literalLength - 16);
+        } /* if */
+        dest += literalLength;
+        literal += literalLength;
+        copyMatch(dest, offset, matchLength);
+        dest += matchLength;
+        numSequences--;
+        if (numSequences == 0) {
+          break;
+        } /* if */
+        if (extraBits > 56 - LL_MAX_LOG - ML_MAX_LOG - OF_MAX_LOG) {
+          reloadReader(&reader);
+        } /* if */
+        fieldState[TABLE_LITERAL_LENGTH] = literalLengthEntry->nextState +
+            readBits(&reader, literalLengthEntry->bits);
+        fieldState[TABLE_MATCH_LENGTH] = matchLengthEntry->nextState +
+            readBits(&reader, matchLengthEntry->bits);
+        fieldState[TABLE_OFFSET] = offsetEntry->nextState +
+            readBits(&reader, offsetEntry->bits);
+      } /* while */
+      reloadReader(&reader);
+      if (unlikely(!readerFinished(&reader))) {
+        return -1;
+      } /* if */
+    } else if (unlikely(headerSize != srcSize)) {
+      return -1;
+    } /* if */
+    /* The remaining literals follow the last sequence. */
+    literalLength = (memSizeType) (literalEnd - literal);
+    if (unlikely(literalLength > (memSizeType) (destLimit - dest))) {
+      return -1;
+    } /* if */
+    memcpy(dest, literal, literalLength);
+    dest += literalLength;
+    return (intType) (dest - &window[state->outputPos]);
+  } /* decodeSequences */
+
+
+
+/**
+ *  Decode a compressed block from state->blockData.
+ *  @return the number of bytes produced or -1 if the block is not
+ *          valid.
+ */
+static intType decodeCompressedBlock (decompressStateType state,
+    memSizeType blockSize)
+
+  {
+    intType numLiterals;
+    memSizeType used;
+
+  /* decodeCompressedBlock */
+    numLiterals = decodeLiterals(state, state->blockData, blockSize, &used);
+    if (unlikely(numLiterals < 0)) {
+      return -1;
+    } /* if */
+    /* Literal copies in chunks of 16 bytes may read after the end. */
+    memset(&state->literals[numLiterals], 0, COPY_SLACK);
+    return decodeSequences(state, &state->blockData[used], blockSize - used,
+                           (memSizeType) numLiterals);
+  } /* decodeCompressedBlock */
+
+
+
+/**
+ *  Make room for the next block. The window keeps the last
+ *  windowSize bytes, which can be referred by matches.
+ */
+static void slideWindow (decompressStateType state)
+
+  {
+    memSizeType keep;
+
+  /* slideWindow */
+    if (state->bufferSize - state->outputPos < BLOCK_SIZE_MAX) {
+      keep = state->outputPos < state->windowSize ?
+          state->outputPos : state->windowSize;
+      if (keep != state->outputPos) {
+        memmove(WINDOW(state), &WINDOW(state)[state->outputPos - keep], keep);
+        state->outputPos = keep;
+        state->deliverPos = keep;
+      } /* if */
+    } /* if */
+  } /* slideWindow */
+
+
+
+/**
+ *  Decode the next block or the checksum at the end of the frame.
+ *  @return the number of input bytes used, 0 if the block is not
+ *          complete in the input or -1 if the data is not valid.
+ */
+static intType decodeBlock (decompressStateType state,
+    const strElemType *input, memSizeType inputSize)
+
+  {
+    uint32Type header;
+    unsigned int blockType;
+    memSizeType blockSize;
+    memSizeType index;
+    ucharType *dest;
+    intType produced;
+
+  /* decodeBlock */
+    if (state->lastBlock) {
+      if (state->checksumFlag) {
+        if (inputSize < 4) {
+          return 0;
+        } /* if */
+        header = 0;
+        for (index = 0; index < 4; index++) {
+          if (unlikely(input[index] > 255)) {
+            return -1;
+          } /* if */
+          header |= (uint32Type) input[index] << (8 * index);
+        } /* for */
+        if (unlikely(header != (uint32Type) (xxh64Digest(&state->checksum) & 0xffffffff))) {
+          logError(printf("zstDecompress: Checksum error.\n"););
+          return -1;
+        } /* if */
+      } /* if */
+      if (unlikely(state->contentSize >= 0 &&
+                   state->produced != (uint64Type) state->contentSize)) {
+        return -1;
+      } /* if */
+      state->finished = TRUE;
+      return state->checksumFlag ? 4 : 0;
+    } /* if */
+    if (inputSize < 3) {
+      return 0;
+    } /* if */
+    if (unlikely(input[0] > 255 || input[1] > 255 || input[2] > 255)) {
+      return -1;
+    } /* if */
+    header = (uint32Type) input[0] | (uint32Type) input[1] << 8 |
+             (uint32Type) input[2] << 16;
+    blockType = (header >> 1) & 3;
+    blockSize = header >> 3;
+    if (unlikely(blockType == 3 || blockSize > BLOCK_SIZE_MAX)) {
+      return -1;
+    } /* if */
+    if (inputSize - 3 < (blockType == BLOCK_RLE ? 1 : blockSize)) {
+      return 0;
+    } /* if */
+    slideWindow(state);
+    dest = &WINDOW(state)[state->outputPos];
+    if (blockType == BLOCK_COMPRESSED) {
+      for (index = 0; index < blockSize; index++) {
+        if (unlikely(input[3 + index] > 255)) {
+          return -1;
+        } /* if */
+        state->blockData[index] = (ucharType) input[3 + index];
+      } /* for */
+      produced = decodeCompressedBlock(state, blockSize);
+      if (unlikely(produced < 0)) {
+        return -1;
+      } /* if */
+    } else {
+      if (unlikely(blockSize > state->bufferSize - state->outputPos)) {
+        return -1;
+      } /* if */
+      if (blockType == BLOCK_RAW) {
+        for (index = 0; index < blockSize; index++) {
+          if (unlikely(input[3 + index] > 255)) {
+            return -1;
+          } /* if */
+          dest[index] = (ucharType) input[3 + index];
+        } /* for */
+      } else {
+        if (unlikely(input[3] > 255)) {
+          return -1;
+        } /* if */
+        memset(dest, (int) input[3], blockSize);
+        blockSize = 1;
+      } /* if */
+      produced = (intType) (header >> 3);
+    } /* if */
+    state->outputPos += (memSizeType) produced;
+    state->produced += (uint64Type) produced;
+    if (unlikely(state->contentSize >= 0 &&
+                 state->produced > (uint64Type) state->contentSize)) {
+      return -1;
+    } /* if */
+    if (state->checksumFlag) {
+      xxh64Update(&state->checksum, dest, (memSizeType) produced);
+    } /* if */
+    state->lastBlock = header & 1;
+    return (intType) (3 + blockSize);
+  } /* decodeBlock */
+
+
+
+static boolType isDecompressState (const const_bstriType state)
+
+  { /* isDecompressState */
+    return state->size >= sizeof(decompressStateRecord) &&
+        ((const_decompressStateType) state->mem)->magic == DECOMPRESS_MAGIC &&
+        state->size == sizeof(decompressStateRecord) +
+        ((const_decompressStateType) state->mem)->bufferSize + COPY_SLACK;
+  } /* isDecompressState */
+
+
+
+/**
+ *  Decompress the blocks of a Zstandard frame from compressed[*position].
+ *  The frame header must have been read before and its values must
+ *  have been used to create the state. The decompression stops if
+ *  maxLength characters have been produced, if the frame is finished
+ *  or if the rest of the compressed data does not contain a complete
+ *  block. Afterwards *position refers to the first byte that has not
+ *  been processed. To continue with more data the unprocessed bytes
+ *  must be passed again. At the end of the frame the content
+ *  checksum is verified.
+ *  @param state Decompress state created with zstDecompressInit.
+ *  @param compressed Compressed data (only bytes are allowed).
+ *  @param position Position (starting with 1) in compressed.
+ *  @param maxLength Maximum number of characters to be produced.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid decompress state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in Zstandard format.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType zstDecompress (bstriType state, const const_striType compressed,
+    intType *const position, intType maxLength)
+
+  {
+    decompressStateType decompressState;
+    memSizeType inPos;
+    outputRecord output;
+    memSizeType available;
+    memSizeType index;
+    const ucharType *source;
+    intType used;
+    striType result;
+
+  /* zstDecompress */
+    logFunction(printf("zstDecompress(*, \"%s\", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *position, maxLength););
+    if (unlikely(!isDecompressState(state) || maxLength < 0 || *position <= 0)) {
+      logError(printf("zstDecompress: Illegal state, maxLength (" FMT_D
+                      ") or position (" FMT_D ").\n", maxLength, *position););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* The memory of a bstring is aligned like memSizeType. */
+    decompressState = (decompressStateType) state->mem;
+    if ((uintType) *position > compressed->size) {
+      inPos = compressed->size;
+    } else {
+      inPos = (memSizeType) *position - 1;
+    } /* if */
+    if ((uintType) maxLength > MAX_STRI_LEN) {
+      output.limit = MAX_STRI_LEN;
+    } else {
+      output.limit = (memSizeType) maxLength;
+    } /* if */
+    output.capacity = output.limit < BLOCK_SIZE_MAX ? output.limit : BLOCK_SIZE_MAX;
+    output.pos = 0;
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(output.stri, output.capacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    while (output.pos < output.limit) {
+      if (decompressState->deliverPos < decompressState->outputPos) {
+        available = decompressState->outputPos - decompressState->deliverPos;
+        if (unlikely(!growOutput(&output, available))) {
+          FREE_STRI(output.stri, output.capacity);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+        if (available > output.capacity - output.pos) {
+          available = output.capacity - output.pos;
+        } /* if */
+        source = &WINDOW(decompressState)[decompressState->deliverPos];
+        for (index = 0; index < available; index++) {
+          output.stri->mem[output.pos + index] = source[index];
+        } /* for */
+        output.pos += available;
+        decompressState->deliverPos += available;
+      } else if (decompressState->finished) {
+        break;
+      } else {
+        used = decodeBlock(decompressState, &compressed->mem[inPos],
+                           compressed->size - inPos);
+        if (unlikely(used < 0)) {
+          FREE_STRI(output.stri, output.capacity);
+          logError(printf("zstDecompress: Data not in Zstandard format.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } else if (used == 0 && !decompressState->finished) {
+          break;
+        } /* if */
+        inPos += (memSizeType) used;
+      } /* if */
+    } /* while */
+    *position = (intType) inPos + 1;
+    result = finishOutput(&output);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    logFunction(printf("zstDecompress --> \"%s\" (position=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *position););
+    return result;
+  } /* zstDecompress */
+
+
+
+/**
+ *  Determine if a Zstandard frame has been decompressed completely.
+ *  @param state Decompress state created with zstDecompressInit.
+ *  @return TRUE if the frame is finished and all data has been
+ *          delivered, FALSE otherwise.
+ *  @exception RANGE_ERROR The state is not a valid decompress state.
+ */
+boolType zstDecompressFinished (const const_bstriType state)
+
+  {
+    const_decompressStateType decompressState;
+
+  /* zstDecompressFinished */
+    if (unlikely(!isDecompressState(state))) {
+      logError(printf("zstDecompressFinished: Illegal state.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    decompressState = (const_decompressStateType) state->mem;
+    return decompressState->finished &&
+        decompressState->deliverPos == decompressState->outputPos;
+  } /* zstDecompressFinished */
+
+
+
+/**
+ *  Create a state for the decompression of a Zstandard frame.
+ *  The parameters are taken from the frame header. The state keeps
+ *  a buffer with the window and space to decode further blocks.
+ *  If the content size is known the buffer is not larger than the
+ *  content.
+ *  @param windowSize Window size of the frame or 0 for a single
+ *         segment frame (the window size is the content size).
+ *  @param frameContentSize Content size of the frame or -1 if the
+ *         content size is unknown.
+ *  @param checksumFlag TRUE if the frame ends with a content checksum.
+ *  @return the initial decompress state.
+ *  @exception RANGE_ERROR The window size is negative or too big,
+ *             or a single segment frame has no content size.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType zstDecompressInit (intType windowSize, intType frameContentSize,
+    boolType checksumFlag)
+
+  {
+    decompressStateType decompressState;
+    memSizeType bufferSize;
+    memSizeType extra;
+    bstriType result;
+
+  /* zstDecompressInit */
+    logFunction(printf("zstDecompressInit(" FMT_D ", " FMT_D ", %d)\n",
+                       windowSize, frameContentSize, checksumFlag););
+    if (windowSize == 0) {
+      windowSize = frameContentSize;
+    } /* if */
+    if (unlikely(windowSize < 0 || windowSize > MAX_WINDOW_SIZE ||
+                 frameContentSize < -1)) {
+      logError(printf("zstDecompressInit: Illegal windowSize (" FMT_D
+                      ") or frameContentSize (" FMT_D ").\n",
+                      windowSize, frameContentSize););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* Room for at least four blocks after the window. */
+    extra = (memSizeType) windowSize / 2;
+    if (extra < 4 * BLOCK_SIZE_MAX) {
+      extra = 4 * BLOCK_SIZE_MAX;
+    } /* if */
+    bufferSize = (memSizeType) windowSize + extra;
+    if (frameContentSize >= 0 && (uintType) frameContentSize < bufferSize) {
+      bufferSize = (memSizeType) frameContentSize;
+    } /* if */
+    if (unlikely(bufferSize > MAX_BSTRI_LEN - sizeof(decompressStateRecord) - COPY_SLACK ||
+                 !ALLOC_BSTRI_SIZE_OK(result, sizeof(decompressStateRecord) +
+                                      bufferSize + COPY_SLACK))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result->size = sizeof(decompressStateRecord) + bufferSize + COPY_SLACK;
+    decompressState = (decompressStateType) result->mem;
+    memset(decompressState, 0, sizeof(decompressStateRecord));
+    decompressState->magic = DECOMPRESS_MAGIC;
+    decompressState->checksumFlag = checksumFlag;
+    decompressState->repeatOffset[0] = 1;
+    decompressState->repeatOffset[1] = 4;
+    decompressState->repeatOffset[2] = 8;
+    decompressState->contentSize = frameContentSize;
+    decompressState->windowSize = (memSizeType) windowSize;
+    decompressState->bufferSize = bufferSize;
+    xxh64Init(&decompressState->checksum);
+    return result;
+  } /* zstDecompressInit */
+
+
+
+/* The compressor writes frames, which can be read by the decoder above. */
+
+#define COMPRESS_MAGIC     0x7a737463
+#define MIN_LEVEL          1
+#define MAX_LEVEL          19
+#define MIN_WINDOW_LOG     10
+#define MAX_SEQUENCES      (BLOCK_SIZE_MAX / 3 + 1)
+#define MIN_HUFFMAN_INPUT  64
+#define WEIGHT_TABLE_LOG   6
+#define HASH_SLACK         8   /* The hash of a position reads 8 bytes. */
+#define RESCALE_LIMIT      0x70000000
+
+#define FLUSH_NONE   0
+#define FLUSH_BLOCK  1
+#define FLUSH_FINISH 2
+
+#define GREEDY 0
+#define LAZY   1
+#define LAZY2  2
+
+/* Parameters of the compression levels. */
+static const struct {
+    unsigned int windowLog;
+    unsigned int chainLog;
+    unsigned int hashLog;
+    unsigned int searchLog;
+    unsigned int minMatch;
+    unsigned int niceLength;
+    unsigned int strategy;
+  } levelConfig[MAX_LEVEL + 1] = {
+    { 0,  0,  0,  0, 0,    0, GREEDY},
+    {19, 16, 17,  0, 6,   16, GREEDY},
+    {20, 17, 18,  1, 5,   24, GREEDY},
+    {21, 17, 18,  2, 5,   32, GREEDY},
+    {21, 18, 18,  3, 5,   32, GREEDY},
+    {21, 18, 19,  3, 5,   32, LAZY},
+    {21, 18, 19,  4, 5,   64, LAZY},
+    {21, 19, 20,  4, 5,   64, LAZY},
+    {21, 19, 20,  5, 5,  128, LAZY2},
+    {22, 20, 21,  5, 5,  128, LAZY2},
+    {22, 20, 21,  6, 5,  128, LAZY2},
+    {22, 21, 22,  6, 5,  256, LAZY2},
+    {22, 21, 22,  7, 5,  256, LAZY2},
+    {22, 21, 22,  7, 4,  256, LAZY2},
+    {22, 22, 22,  8, 4,  512, LAZY2},
+    {22, 22, 22,  8, 4,  512, LAZY2},
+    {23, 22, 22,  9, 4, 1024, LAZY2},
+    {23, 22, 22,  9, 4, 2048, LAZY2},
+    {23, 22, 22, 10, 4, 2048, LAZY2},
+    {23, 22, 22, 10, 4, 4096, LAZY2}
+  };
+
+typedef struct {
+    uint32Type literalLength;
+    uint32Type matchLength;
+    uint32Type offsetValue;
+  } sequenceType;
+
+typedef struct {
+    uint64Type container;
+    unsigned int bitCount;
+    ucharType *pos;
+    ucharType *end;
+    boolType overflow;
+  } bitWriterRecord, *bitWriterType;
+
+/* Encoding table of an FSE distribution. */
+typedef struct {
+    unsigned int accuracyLog;
+    uint16Type stateTable[1 << LL_MAX_LOG];
+    int32Type deltaFindState[256];
+    uint32Type deltaNbBits[256];
+  } fseEncoderRecord, *fseEncoderType;
+
+typedef struct {
+    uint32Type magic;
+    boolType finished;
+    boolType headerWritten;
+    unsigned int windowLog;
+    unsigned int hashLog;
+    unsigned int chainLog;
+    unsigned int searchDepth;
+    unsigned int minMatch;
+    unsigned int niceLength;
+    unsigned int strategy;
+    intType contentSize;  /* -1 if the content size is unknown. */
+    uint64Type consumed;
+    xxh64Record checksum;
+    memSizeType windowSize;
+    memSizeType bufferSize;
+    memSizeType fill;
+    memSizeType blockStart;
+    uint32Type base;  /* Index of the first byte of the window. */
+    uint32Type nextToUpdate;
+    uint32Type repeatOffset[3];
+    memSizeType numSequences;
+    memSizeType numLiterals;
+    sequenceType sequences[MAX_SEQUENCES];
+    uint8Type literalLengthCode[MAX_SEQUENCES];
+    uint8Type matchLengthCode[MAX_SEQUENCES];
+    uint8Type offsetCode[MAX_SEQUENCES];
+    ucharType literals[BLOCK_SIZE_MAX];
+    ucharType blockOutput[BLOCK_SIZE_MAX];
+    /* The hash table, the chain table and the window follow. */
+  } compressStateRecord, *compressStateType;
+
+typedef const compressStateRecord *const_compressStateType;
+
+#define HASH_TABLE(state)  ((uint32Type *) &(state)[1])
+#define CHAIN_TABLE(state) (&HASH_TABLE(state)[(memSizeType) 1 << (state)->hashLog])
+#define INPUT_WINDOW(state) \
+    ((ucharType *) &CHAIN_TABLE(state)[(memSizeType) 1 << (state)->chainLog])
+
+static boolType codeTablesBuilt = FALSE;
+static uint8Type literalLengthCodeTable[64];
+static uint8Type matchLengthCodeTable[128];
+
+
+
+static void buildCodeTables (void)
+
+  {
+    unsigned int value;
+    unsigned int code = 0;
+
+  /* buildCodeTables */
+    for (value = 0; value < 64; value++) {
+      while (code < MAX_LL_SYMBOL && literalLengthBase[code + 1] <= value) {
+        code++;
+      } /* while */
+      literalLengthCodeTable[value] = (uint8Type) code;
+    } /* for */
+    code = 0;
+    for (value = 0; value < 128; value++) {
+      while (code < MAX_ML_SYMBOL && matchLengthBase[code + 1] - 3 <= value) {
+        code++;
+      } /* while */
+      matchLengthCodeTable[value] = (uint8Type) code;
+    } /* for */
+    codeTablesBuilt = TRUE;
+  } /* buildCodeTables */
+
+
+
+static inline unsigned int literalLengthToCode (uint32Type literalLength)
+
+  { /* literalLengthToCode */
+    return literalLength < 64 ? literalLengthCodeTable[literalLength] :
+        highBit(literalLength) + 19;
+  } /* literalLengthToCode */
+
+
+
+static inline unsigned int matchLengthToCode (uint32Type matchLength)
+
+  {
+    uint32Type lengthBase;
+
+  /* matchLengthToCode */
+    lengthBase = matchLength - 3;
+    return lengthBase < 128 ? matchLengthCodeTable[lengthBase] :
+        highBit(lengthBase) + 36;
+  } /* matchLengthToCode */
+
+
+
+static inline void initBitWriter (bitWriterType writer, ucharType *dest,
+    memSizeType destSize)
+
+  { /* initBitWriter */
+    writer->container = 0;
+    writer->bitCount = 0;
+    writer->pos = dest;
+    writer->end = &dest[destSize];
+    writer->overflow = FALSE;
+  } /* initBitWriter */
+
+
+
+/**
+ *  Write the complete bytes of the bit container. If the destination
+ *  is full the bytes are dropped and the overflow flag is set.
+ */
+static inline void flushBitWriter (bitWriterType writer)
+
+  { /* flushBitWriter */
+    while (writer->bitCount >= 8) {
+      if (writer->pos < writer->end) {
+        *writer->pos = (ucharType) (writer->container & 0xff);
+        writer->pos++;
+      } else {
+        writer->overflow = TRUE;
+      } /* if */
+      writer->container >>= 8;
+      writer->bitCount -= 8;
+    } /* while */
+  } /* flushBitWriter */
+
+
+
+/**
+ *  Write the lowest count bits (up to 56) of value.
+ */
+static inline void putBits (bitWriterType writer, uint64Type value,
+    unsigned int count)
+
+  { /* putBits */
+    if (count != 0) {
+      if (writer->bitCount + count > 64) {
+        flushBitWriter(writer);
+      } /* if */
+      writer->container |= (value & (((uint64Type) 1 << count) - 1)) << writer->bitCount;
+      writer->bitCount += count;
+    } /* if */
+  } /* putBits */
+
+
+
+/**
+ *  Close a bitstream, which is read backward. A marker bit is
+ *  written and the last byte is padded with zero bits.
+ *  @return the size of the stream or 0 if the destination is full.
+ */
+static memSizeType closeBitWriter (bitWriterType writer, const ucharType *start)
+
+  { /* closeBitWriter */
+    putBits(writer, 1, 1);
+    writer->bitCount = (writer->bitCount + 7) & ~7U;
+    flushBitWriter(writer);
+    if (writer->overflow) {
+      return 0;
+    } /* if */
+    return (memSizeType) (writer->pos - start);
+  } /* closeBitWriter */
+
+
+
+/**
+ *  Choose the accuracy log of an FSE distribution. Few symbols allow
+ *  a smaller table and many different symbols need a bigger table.
+ */
+static unsigned int optimalTableLog (unsigned int maxLog, memSizeType total,
+    unsigned int maxSymbol)
+
+  {
+    int tableLog;
+    int maxBitsSource;
+    int minBitsSource;
+    int minBitsSymbols;
+
+  /* optimalTableLog */
+    tableLog = (int) maxLog;
+    maxBitsSource = (int) highBit((uint32Type) (total - 1)) - 2;
+    minBitsSource = (int) highBit((uint32Type) total) + 1;
+    minBitsSymbols = (int) highBit(maxSymbol) + 2;
+    if (maxBitsSource < tableLog) {
+      tableLog = maxBitsSource;
+    } /* if */
+    if (minBitsSource < minBitsSymbols) {
+      minBitsSymbols = minBitsSource;
+    } /* if */
+    if (minBitsSymbols > tableLog) {
+      tableLog = minBitsSymbols;
+    } /* if */
+    if (tableLog < 5) {
+      tableLog = 5;
+    } else if (tableLog > (int) maxLog) {
+      tableLog = (int) maxLog;
+    } /* if */
+    return (unsigned int) tableLog;
+  } /* optimalTableLog */
+
+
+
+/**
+ *  Scale the counts of the symbols to probabilities, which sum up
+ *  to the table size. Every symbol that occurs gets at least 1.
+ *  @return the accuracy log of the distribution.
+ */
+static unsigned int normalizeCounts (const unsigned int *count, unsigned int maxSymbol,
+    memSizeType total, unsigned int maxLog, int16Type *norm)
+
+  {
+    unsigned int tableLog;
+    int tableSize;
+    int sum = 0;
+    unsigned int symbol;
+    unsigned int largest = 0;
+    unsigned int biggestNorm;
+    int value;
+
+  /* normalizeCounts */
+    tableLog = optimalTableLog(maxLog, total, maxSymbol);
+    tableSize = 1 << tableLog;
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (count[symbol] == 0) {
+        norm[symbol] = 0;
+      } else {
+        value = (int) (((uint64Type) count[symbol] * (uint64Type) tableSize +
+                        total / 2) / total);
+        if (value < 1) {
+          value = 1;
+        } /* if */
+        norm[symbol] = (int16Type) value;
+        sum += value;
+        if (count[symbol] > count[largest]) {
+          largest = symbol;
+        } /* if */
+      } /* if */
+    } /* for */
+    while (sum > tableSize) {
+      biggestNorm = largest;
+      for (symbol = 0; symbol <= maxSymbol; symbol++) {
+        if (norm[symbol] > norm[biggestNorm]) {
+          biggestNorm = symbol;
+        } /* if */
+      } /* for */
+      norm[biggestNorm]--;
+      sum--;
+    } /* while */
+    norm[largest] = (int16Type) (norm[largest] + tableSize - sum);
+    return tableLog;
+  } /* normalizeCounts */
+
+
+
+/**
+ *  Write the description of an FSE distribution. This is the
+ *  counterpart of readProbabilities.
+ *  @return the number of bytes written or 0 if the destination is
+ *          too small.
+ */
+static memSizeType writeProbabilities (const int16Type *norm, unsigned int maxSymbol,
+    unsigned int tableLog, ucharType *dest, memSizeType destSize)
+
+  {
+    bitWriterRecord writer;
+    int remaining;
+    int threshold;
+    int maxValue;
+    int count;
+    unsigned int numBits;
+    unsigned int symbol = 0;
+    unsigned int start;
+    boolType previousZero = FALSE;
+
+  /* writeProbabilities */
+    initBitWriter(&writer, dest, destSize);
+    putBits(&writer, tableLog - 5, 4);
+    threshold = 1 << tableLog;
+    remaining = threshold + 1;
+    numBits = tableLog + 1;
+    while (symbol <= maxSymbol && remaining > 1) {
+      if (previousZero) {
+        start = symbol;
+        while (norm[symbol] == 0) {
+          symbol++;
+        } /* while */
+        while (symbol >= start + 3) {
+          putBits(&writer, 3, 2);
+          start += 3;
+        } /* while */
+        putBits(&writer, symbol - start, 2);
+      } /* if */
+      count = norm[symbol++];
+      maxValue = 2 * threshold - 1 - remaining;
+      remaining -= count < 0 ? -count : count;
+      count++;
+      if (count >= threshold) {
+        count += maxValue;
+      } /* if */
+      putBits(&writer, (uint64Type) count, numBits - (count < maxValue));
+      previousZero = count == 1;
+      while (remaining < threshold) {
+        numBits--;
+        threshold >>= 1;
+      } /* while */
+    } /* while */
+    writer.bitCount = (writer.bitCount + 7) & ~7U;
+    flushBitWriter(&writer);
+    if (writer.overflow) {
+      return 0;
+    } /* if */
+    return (memSizeType) (writer.pos - dest);
+  } /* writeProbabilities */
+
+
+
+/**
+ *  Build the FSE encoding table of a distribution. The states are
+ *  spread like in buildFseTable.
+ */
+static void buildFseEncoder (const int16Type *norm, unsigned int maxSymbol,
+    unsigned int tableLog, fseEncoderType encoder)
+
+  {
+    unsigned int tableSize;
+    unsigned int highThreshold;
+    unsigned int step;
+    unsigned int mask;
+    unsigned int position = 0;
+    unsigned int symbol;
+    unsigned int index;
+    unsigned int cumulative[257];
+    uint8Type tableSymbol[1 << LL_MAX_LOG];
+    int total = 0;
+    unsigned int maxBitsOut;
+
+  /* buildFseEncoder */
+    tableSize = 1U << tableLog;
+    highThreshold = tableSize - 1;
+    cumulative[0] = 0;
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (norm[symbol] == -1) {
+        cumulative[symbol + 1] = cumulative[symbol] + 1;
+        tableSymbol[highThreshold--] = (uint8Type) symbol;
+      } else {
+        cumulative[symbol + 1] = cumulative[symbol] + (unsigned int) norm[symbol];
+      } /* if */
+    } /* for */
+    step = (tableSize >> 1) + (tableSize >> 3) + 3;
+    mask = tableSize - 1;
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      for (index = 0; (int) index < norm[symbol]; index++) {
+        tableSymbol[position] = (uint8Type) symbol;
+        do {
+          position = (position + step) & mask;
+        } while (position > highThreshold);
+      } /* for */
+    } /* for */
+    for (index = 0; index < tableSize; index++) {
+      encoder->stateTable[cumulative[tableSymbol[index]]++] =
+          (uint16Type) (tableSize + index);
+    } /* for */
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (norm[symbol] == -1 || norm[symbol] == 1) {
+        encoder->deltaNbBits[symbol] = (tableLog << 16) - tableSize;
+        encoder->deltaFindState[symbol] = total - 1;
+        total++;
+      } else if (norm[symbol] > 1) {
+        maxBitsOut = tableLog - highBit((uint32Type) norm[symbol] - 1);
+        encoder->deltaNbBits[symbol] = (maxBitsOut << 16) -
+            ((uint32Type) norm[symbol] << maxBitsOut);
+        encoder->deltaFindState[symbol] = total - norm[symbol];
+        total += norm[symbol];
+      } else {
+        encoder->deltaNbBits[symbol] = ((tableLog + 1) << 16) - tableSize;
+        encoder->deltaFindState[symbol] = 0;
+      } /* if */
+    } /* for */
+    encoder->accuracyLog = tableLog;
+  } /* buildFseEncoder */
+
+
+
+/**
+ *  Determine the first state of an FSE encoding, which ends with
+ *  the given symbol. No bits are written.
+ */
+static inline unsigned int initFseState (const fseEncoderRecord *encoder,
+    unsigned int symbol)
+
+  {
+    unsigned int numBits;
+    uint32Type value;
+
+  /* initFseState */
+    numBits = (encoder->deltaNbBits[symbol] + (1 << 15)) >> 16;
+    value = (numBits << 16) - encoder->deltaNbBits[symbol];
+    return encoder->stateTable[(int) (value >> numBits) +
+                               encoder->deltaFindState[symbol]];
+  } /* initFseState */
+
+
+
+static inline void encodeFseSymbol (bitWriterType writer,
+    const fseEncoderRecord *encoder, unsigned int *state, unsigned int symbol)
+
+  {
+    unsigned int numBits;
+
+  /* encodeFseSymbol */
+    numBits = (*state + encoder->deltaNbBits[symbol]) >> 16;
+    putBits(writer, *state, numBits);
+    *state = encoder->stateTable[(int) (*state >> numBits) +
+                                 encoder->deltaFindState[symbol]];
+  } /* encodeFseSymbol */
+
+
+
+/**
+ *  Compress the Huffman weights with FSE. This is the counterpart
+ *  of readFseWeights.
+ *  @return the compressed size or 0 if the weights cannot be
+ *          compressed into less than 128 bytes.
+ */
+static memSizeType compressWeights (const uint8Type *weights, unsigned int numWeights,
+    ucharType *dest)
+
+  {
+    unsigned int count[MAX_WEIGHT_SYMBOL + 1];
+    unsigned int maxSymbol = 0;
+    unsigned int distinct = 0;
+    unsigned int index;
+    int16Type norm[MAX_WEIGHT_SYMBOL + 1];
+    unsigned int tableLog;
+    fseEncoderRecord encoder;
+    bitWriterRecord writer;
+    memSizeType headerSize;
+    memSizeType streamSize;
+    unsigned int state1;
+    unsigned int state2;
+    int pos;
+
+  /* compressWeights */
+    memset(count, 0, sizeof(count));
+    for (index = 0; index < numWeights; index++) {
+      if (count[weights[index]] == 0) {
+        distinct++;
+      } /* if */
+      count[weights[index]]++;
+      if (weights[index] > maxSymbol) {
+        maxSymbol = weights[index];
+      } /* if */
+    } /* for */
+    if (distinct <= 1 || numWeights < 2) {
+      return 0;
+    } /* if */
+    tableLog = normalizeCounts(count, maxSymbol, numWeights, WEIGHT_TABLE_LOG, norm);
+    headerSize = writeProbabilities(norm, maxSymbol, tableLog, dest, 127);
+    if (headerSize == 0) {
+      return 0;
+    } /* if */
+    buildFseEncoder(norm, maxSymbol, tableLog, &encoder);
+    initBitWriter(&writer, &dest[headerSize], 127 - headerSize);
+    /* Two interleaved states. The first weight is decoded by state1. */
+    pos = (int) numWeights;
+    if ((numWeights & 1) != 0) {
+      state1 = initFseState(&encoder, weights[--pos]);
+      state2 = initFseState(&encoder, weights[--pos]);
+      encodeFseSymbol(&writer, &encoder, &state1, weights[--pos]);
+    } else {
+      state2 = initFseState(&encoder, weights[--pos]);
+      state1 = initFseState(&encoder, weights[--pos]);
+    } /* if */
+    while (pos > 0) {
+      encodeFseSymbol(&writer, &encoder, &state2, weights[--pos]);
+      encodeFseSymbol(&writer, &encoder, &state1, weights[--pos]);
+    } /* while */
+    putBits(&writer, state2, tableLog);
+    putBits(&writer, state1, tableLog);
+    streamSize = closeBitWriter(&writer, &dest[headerSize]);
+    if (streamSize == 0) {
+      return 0;
+    } /* if */
+    return headerSize + streamSize;
+  } /* compressWeights */
+
+
+
+/**
+ *  Write the header of a raw or RLE literals section.
+ *  @return the size of the header.
+ */
+static memSizeType writeLiteralsHeader (ucharType *dest, unsigned int type,
+    memSizeType size)
+
+  { /* writeLiteralsHeader */
+    if (size < 32) {
+      dest[0] = (ucharType) (type | size << 3);
+      return 1;
+    } else if (size < 4096) {
+      dest[0] = (ucharType) (type | 1 << 2 | (size & 0x0f) << 4);
+      dest[1] = (ucharType) (size >> 4);
+      return 2;
+    } else {
+      dest[0] = (ucharType) (type | 3 << 2 | (size & 0x0f) << 4);
+      dest[1] = (ucharType) ((size >> 4) & 0xff);
+      dest[2] = (ucharType) (size >> 12);
+      return 3;
+    } /* if */
+  } /* writeLiteralsHeader */
+
+
+
+/**
+ *  Encode one stream of literals with Huffman codes. The symbols
+ *  are written from the last to the first, because the stream is
+ *  read backward.
+ */
+static memSizeType encodeHuffmanStream (const ucharType *literals, memSizeType count,
+    const uint16Type *code, const uint8Type *length, ucharType *dest,
+    memSizeType destSize)
+
+  {
+    bitWriterRecord writer;
+    memSizeType index;
+
+  /* encodeHuffmanStream */
+    initBitWriter(&writer, dest, destSize);
+    index = count;
+    while (index >= 4) {
+      putBits(&writer, code[literals[index - 1]], length[literals[index - 1]]);
+      putBits(&writer, code[literals[index - 2]], length[literals[index - 2]]);
+      putBits(&writer, code[literals[index - 3]], length[literals[index - 3]]);
+      putBits(&writer, code[literals[index - 4]], length[literals[index - 4]]);
+      index -= 4;
+    } /* while */
+    while (index > 0) {
+      index--;
+      putBits(&writer, code[literals[index]], length[literals[index]]);
+    } /* while */
+    return closeBitWriter(&writer, dest);
+  } /* encodeHuffmanStream */
+
+
+
+/**
+ *  Write the literals of a block as Huffman coded literals section.
+ *  @return the size of the section or 0 if it is not smaller than
+ *          the raw literals.
+ */
+static memSizeType compressHuffmanLiterals (const_compressStateType state,
+    const unsigned int *count, unsigned int maxSymbol, ucharType *dest,
+    memSizeType destSize)
+
+  {
+    memSizeType numLiterals;
+    uint8Type length[256];
+    uint8Type weights[256];
+    uint16Type code[256];
+    uint32Type rankStart[MAX_HUFFMAN_BITS + 2];
+    unsigned int maxBits = 0;
+    unsigned int symbol;
+    unsigned int weight;
+    ucharType weightData[128];
+    memSizeType treeSize;
+    memSizeType headerSize;
+    memSizeType compressedSize;
+    memSizeType streamSize[4];
+    memSizeType segment;
+    memSizeType limit;
+    ucharType *pos;
+    int index;
+
+  /* compressHuffmanLiterals */
+    numLiterals = state->numLiterals;
+    dflCodeLengths(count, maxSymbol + 1, MAX_HUFFMAN_BITS, length);
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (length[symbol] > maxBits) {
+        maxBits = length[symbol];
+      } /* if */
+    } /* for */
+    memset(rankStart, 0, sizeof(rankStart));
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      weights[symbol] = (uint8Type) (length[symbol] == 0 ? 0 : maxBits + 1 - length[symbol]);
+      if (weights[symbol] != 0) {
+        rankStart[weights[symbol] + 1] += (uint32Type) 1 << (weights[symbol] - 1);
+      } /* if */
+    } /* for */
+    for (weight = 2; weight <= maxBits + 1; weight++) {
+      rankStart[weight] += rankStart[weight - 1];
+    } /* for */
+    /* Like the decoding table: By increasing weight and then by symbol. */
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      weight = weights[symbol];
+      if (weight != 0) {
+        code[symbol] = (uint16Type) (rankStart[weight] >> (weight - 1));
+        rankStart[weight] += (uint32Type) 1 << (weight - 1);
+      } else {
+        code[symbol] = 0;
+      } /* if */
+    } /* for */
+    for (symbol = maxSymbol + 1; symbol < 256; symbol++) {
+      code[symbol] = 0;
+      length[symbol] = 0;
+    } /* for */
+    /* The weight of the last symbol is implied. */
+    treeSize = compressWeights(weights, maxSymbol, &weightData[1]);
+    if (treeSize != 0 && (maxSymbol > 128 || treeSize < (maxSymbol + 1) / 2)) {
+      weightData[0] = (ucharType) treeSize;
+      treeSize++;
+    } else if (maxSymbol <= 128) {
+      weightData[0] = (ucharType) (127 + maxSymbol);
+      for (symbol = 0; symbol < maxSymbol; symbol += 2) {
+        weightData[1 + symbol / 2] = (ucharType) (weights[symbol] << 4 |
+            (symbol + 1 < maxSymbol ? weights[symbol + 1] : 0));
+      } /* for */
+      treeSize = 1 + (maxSymbol + 1) / 2;
+    } else {
+      return 0;
+    } /* if */
+    headerSize = numLiterals < 256 ? 3 : numLiterals < 16384 ? 4 : 5;
+    /* The result must be smaller than the raw literals section. */
+    limit = numLiterals + (numLiterals < 32 ? 1 : numLiterals < 4096 ? 2 : 3) - 1;
+    if (limit > destSize) {
+      limit = destSize;
+    } /* if */
+    if (headerSize + treeSize + 6 >= limit) {
+      return 0;
+    } /* if */
+    pos = &dest[headerSize];
+    memcpy(pos, weightData, treeSize);
+    pos += treeSize;
+    if (numLiterals < 256) {
+      streamSize[0] = encodeHuffmanStream(state->literals, numLiterals, code,
+          length, pos, (memSizeType) (&dest[limit] - pos));
+      if (streamSize[0] == 0) {
+        return 0;
+      } /* if */
+      compressedSize = treeSize + streamSize[0];
+      /* One stream with 10 bit sizes. */
+      dest[0] = (ucharType) (LITERALS_COMPRESSED | (numLiterals & 0x0f) << 4);
+      dest[1] = (ucharType) (numLiterals >> 4 | (compressedSize & 0x03) << 6);
+      dest[2] = (ucharType) (compressedSize >> 2);
+      headerSize = 3;
+    } else {
+      segment = (numLiterals + 3) / 4;
+      pos += 6;
+      for (index = 0; index < 4; index++) {
+        if (pos >= &dest[limit]) {
+          return 0;
+        } /* if */
+        streamSize[index] = encodeHuffmanStream(&state->literals[(memSizeType) index * segment],
+            index == 3 ? numLiterals - 3 * segment : segment, code, length,
+            pos, (memSizeType) (&dest[limit] - pos));
+        if (streamSize[index] == 0 || (index != 3 && streamSize[index] > 0xffff)) {
+          return 0;
+        } /* if */
+        pos += streamSize[index];
+      } /* for */
+      pos = &dest[headerSize + treeSize];
+      for (index = 0; index < 3; index++) {
+        pos[2 * index] = (ucharType) (streamSize[index] & 0xff);
+        pos[2 * index + 1] = (ucharType) (streamSize[index] >> 8);
+      } /* for */
+      compressedSize = treeSize + 6 + streamSize[0] + streamSize[1] +
+          streamSize[2] + streamSize[3];
+      if (numLiterals < 1024 && compressedSize < 1024) {
+        /* The header with 10 bit sizes is one byte shorter. */
+        memmove(&dest[3], &dest[headerSize], compressedSize);
+        headerSize = 3;
+        dest[0] = (ucharType) (LITERALS_COMPRESSED | 1 << 2 | (numLiterals & 0x0f) << 4);
+        dest[1] = (ucharType) (numLiterals >> 4 | (compressedSize & 0x03) << 6);
+        dest[2] = (ucharType) (compressedSize >> 2);
+      } else if (headerSize == 4) {
+        dest[0] = (ucharType) (LITERALS_COMPRESSED | 2 << 2 | (numLiterals & 0x0f) << 4);
+        dest[1] = (ucharType) ((numLiterals >> 4) & 0xff);
+        dest[2] = (ucharType) (numLiterals >> 12 | (compressedSize & 0x3f) << 2);
+        dest[3] = (ucharType) (compressedSize >> 6);
+      } else {
+        dest[0] = (ucharType) (LITERALS_COMPRESSED | 3 << 2 | (numLiterals & 0x0f) << 4);
+        dest[1] = (ucharType) (numLiterals >> 4);
+        dest[2] = (ucharType) (numLiterals >> 12 | (compressedSize & 0x03) << 6);
+        dest[3] = (ucharType) (compressedSize >> 2);
+        dest[4] = (ucharType) (compressedSize >> 10);
+      } /* if */
+    } /* if */
+    if (headerSize + compressedSize > limit) {
+      return 0;
+    } /* if */
+    return headerSize + compressedSize;
+  } /* compressHuffmanLiterals */
+
+
+
+/**
+ *  Write the literals section of a block. Huffman coding is used if
+ *  the result is smaller than the raw literals.
+ *  @return the size of the section or 0 if the destination is too small.
+ */
+static memSizeType writeLiterals (const_compressStateType state,
+    ucharType *dest, memSizeType destSize)
+
+  {
+    unsigned int count[256];
+    unsigned int maxSymbol = 0;
+    unsigned int distinct = 0;
+    memSizeType numLiterals;
+    memSizeType index;
+    memSizeType size;
+
+  /* writeLiterals */
+    numLiterals = state->numLiterals;
+    memset(count, 0, sizeof(count));
+    for (index = 0; index < numLiterals; index++) {
+      count[state->literals[index]]++;
+    } /* for */
+    for (index = 0; index < 256; index++) {
+      if (count[index] != 0) {
+        distinct++;
+        maxSymbol = (unsigned int) index;
+      } /* if */
+    } /* for */
+    if (destSize < numLiterals + 4) {
+      return 0;
+    } else if (distinct == 1 && numLiterals > 1) {
+      size = writeLiteralsHeader(dest, LITERALS_RLE, numLiterals);
+      dest[size] = state->literals[0];
+      return size + 1;
+    } else if (numLiterals >= MIN_HUFFMAN_INPUT) {
+      size = compressHuffmanLiterals(state, count, maxSymbol, dest, destSize);
+      if (size != 0) {
+        return size;
+      } /* if */
+    } /* if */
+    size = writeLiteralsHeader(dest, LITERALS_RAW, numLiterals);
+    memcpy(&dest[size], state->literals, numLiterals);
+    return size + numLiterals;
+  } /* writeLiterals */
+
+
+
+/**
+ *  Approximate 256 * log2(number) with a linear interpolation
+ *  between powers of two. The error is below 0.09 bits.
+ */
+static inline unsigned int log2Fixed (uint32Type number)
+
+  {
+    unsigned int exponent;
+
+  /* log2Fixed */
+    exponent = highBit(number);
+    return (exponent << 8) + (unsigned int) ((number << 8) >> exponent) - 256;
+  } /* log2Fixed */
+
+
+
+/**
+ *  Estimate the number of bits needed to encode the symbols with
+ *  a distribution. The estimate is measured in 1/256 bits.
+ *  @return the estimated cost or -1 if a symbol cannot be encoded.
+ */
+static long distributionCost (const unsigned int *count, unsigned int maxSymbol,
+    const int16Type *norm, unsigned int normMaxSymbol, unsigned int tableLog)
+
+  {
+    unsigned int symbol;
+    int probability;
+    long cost = 0;
+
+  /* distributionCost */
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (count[symbol] != 0) {
+        if (symbol > normMaxSymbol || norm[symbol] == 0) {
+          return -1;
+        } /* if */
+        probability = norm[symbol] == -1 ? 1 : norm[symbol];
+        cost += (long) count[symbol] *
+            (long) ((tableLog << 8) - log2Fixed((uint32Type) probability));
+      } /* if */
+    } /* for */
+    return cost;
+  } /* distributionCost */
+
+
+
+/**
+ *  Choose the mode of a sequence field and write its table
+ *  description. The mode with the smallest estimated size is used.
+ *  @return the size of the table description or -1 if the
+ *          destination is too small.
+ */
+static int prepareSequenceField (const uint8Type *codes, memSizeType numSequences,
+    unsigned int kind, unsigned int *mode, fseEncoderType encoder,
+    ucharType *dest, memSizeType destSize)
+
+  {
+    unsigned int count[MAX_FSE_SYMBOLS];
+    unsigned int maxSymbol = 0;
+    unsigned int distinct = 0;
+    memSizeType index;
+    int16Type norm[MAX_FSE_SYMBOLS];
+    unsigned int tableLog;
+    ucharType header[MAX_FSE_SYMBOLS * 2];
+    memSizeType headerSize;
+    long predefinedCost;
+    long customCost;
+
+  /* prepareSequenceField */
+    memset(count, 0, sizeof(count));
+    for (index = 0; index < numSequences; index++) {
+      if (count[codes[index]] == 0) {
+        distinct++;
+      } /* if */
+      count[codes[index]]++;
+      if (codes[index] > maxSymbol) {
+        maxSymbol = codes[index];
+      } /* if */
+    } /* for */
+    if (distinct == 1) {
+      if (destSize < 1) {
+        return -1;
+      } /* if */
+      *mode = MODE_RLE;
+      dest[0] = (ucharType) maxSymbol;
+      return 1;
+    } /* if */
+    predefinedCost = distributionCost(count, maxSymbol, tableKind[kind].defaultNorm,
+        tableKind[kind].defaultMaxSymbol, tableKind[kind].defaultLog);
+    tableLog = normalizeCounts(count, maxSymbol, numSequences,
+                               tableKind[kind].maxLog, norm);
+    headerSize = writeProbabilities(norm, maxSymbol, tableLog, header, sizeof(header));
+    customCost = distributionCost(count, maxSymbol, norm, maxSymbol, tableLog) +
+        (long) headerSize * 8 * 256;
+    if (headerSize == 0 || (predefinedCost >= 0 && predefinedCost <= customCost)) {
+      *mode = MODE_PREDEFINED;
+      buildFseEncoder(tableKind[kind].defaultNorm, tableKind[kind].defaultMaxSymbol,
+                      tableKind[kind].defaultLog, encoder);
+      return 0;
+    } else {
+      if (destSize < headerSize) {
+        return -1;
+      } /* if */
+      *mode = MODE_FSE;
+      buildFseEncoder(norm, maxSymbol, tableLog, encoder);
+      memcpy(dest, header, headerSize);
+      return (int) headerSize;
+    } /* if */
+  } /* prepareSequenceField */
+
+
+
+/**
+ *  Write the sequences section of a block.
+ *  @return the size of the section or 0 if the destination is too small.
+ */
+static memSizeType writeSequences (compressStateType state, ucharType *dest,
+    memSizeType destSize)
+
+  {
+    memSizeType numSequences;
+    memSizeType pos;
+    memSizeType modesPos;
+    memSizeType index;
+    const sequenceType *sequence;
+    unsigned int mode[3];
+    fseEncoderRecord encoder[3];
+    const uint8Type *codes[3];
+    unsigned int fieldState[3] = {0, 0, 0};
+    unsigned int kind;
+    int tableSize;
+    bitWriterRecord writer;
+    memSizeType streamSize;
+    unsigned int code;
+
+  /* writeSequences */
+    numSequences = state->numSequences;
+    if (destSize < 4) {
+      return 0;
+    } else if (numSequences < 128) {
+      dest[0] = (ucharType) numSequences;
+      pos = 1;
+    } else if (numSequences < 0x7f00) {
+      dest[0] = (ucharType) ((numSequences >> 8) + 128);
+      dest[1] = (ucharType) (numSequences & 0xff);
+      pos = 2;
+    } else {
+      dest[0] = 255;
+      dest[1] = (ucharType) ((numSequences - 0x7f00) & 0xff);
+      dest[2] = (ucharType) ((numSequences - 0x7f00) >> 8);
+      pos = 3;
+    } /* if */
+    if (numSequences == 0) {
+      return pos;
+    } /* if */
+    for (index = 0; index < numSequences; index++) {
+      sequence = &state->sequences[index];
+      state->literalLengthCode[index] = (uint8Type) literalLengthToCode(sequence->literalLength);
+      state->matchLengthCode[index] = (uint8Type) matchLengthToCode(sequence->matchLength);
+      state->offsetCode[index] = (uint8Type) highBit(sequence->offsetValue);
+    } /* for */
+    codes[TABLE_LITERAL_LENGTH] = state->literalLengthCode;
+    codes[TABLE_OFFSET] = state->offsetCode;
+    codes[TABLE_MATCH_LENGTH] = state->matchLengthCode;
+    modesPos = pos;
+    pos++;
+    for (kind = TABLE_LITERAL_LENGTH; kind <= TABLE_MATCH_LENGTH; kind++) {
+      tableSize = prepareSequenceField(codes[kind], numSequences, kind, &mode[kind],
+                                       &encoder[kind], &dest[pos], destSize - pos);
+      if (tableSize < 0) {
+        return 0;
+      } /* if */
+      pos += (memSizeType) tableSize;
+    } /* for */
+    dest[modesPos] = (ucharType) (mode[TABLE_LITERAL_LENGTH] << 6 |
+        mode[TABLE_OFFSET] << 4 | mode[TABLE_MATCH_LENGTH] << 2);
+    initBitWriter(&writer, &dest[pos], destSize - pos);
+    /* The last sequence is decoded last, so it is encoded first. */
+    index = numSequences - 1;
+    for (kind = TABLE_LITERAL_LENGTH; kind <= TABLE_MATCH_LENGTH; kind++) {
+      if (mode[kind] != MODE_RLE) {
+        fieldState[kind] = initFseState(&encoder[kind], codes[kind][index]);
+      } /* if */
+    } /* for */
+    while (TRUE) {
+      sequence = &state->sequences[index];
+      code = codes[TABLE_LITERAL_LENGTH][index];
+      putBits(&writer, sequence->literalLength - literalLengthBase[code],
+              literalLengthExtra[code]);
+      code = codes[TABLE_MATCH_LENGTH][index];
+      putBits(&writer, sequence->matchLength - matchLengthBase[code],
+              matchLengthExtra[code]);
+      code = codes[TABLE_OFFSET][index];
+      putBits(&writer, sequence->offsetValue, code);
+      if (index == 0) {
+        break;
+      } /* if */
+      index--;
+      if (mode[TABLE_OFFSET] != MODE_RLE) {
+        encodeFseSymbol(&writer, &encoder[TABLE_OFFSET], &fieldState[TABLE_OFFSET],
+                        codes[TABLE_OFFSET][index]);
+      } /* if */
+      if (mode[TABLE_MATCH_LENGTH] != MODE_RLE) {
+        encodeFseSymbol(&writer, &encoder[TABLE_MATCH_LENGTH],
+                        &fieldState[TABLE_MATCH_LENGTH], codes[TABLE_MATCH_LENGTH][index]);
+      } /* if */
+      if (mode[TABLE_LITERAL_LENGTH] != MODE_RLE) {
+        encodeFseSymbol(&writer, &encoder[TABLE_LITERAL_LENGTH],
+                        &fieldState[TABLE_LITERAL_LENGTH], codes[TABLE_LITERAL_LENGTH][index]);
+      } /* if */
+      if (writer.overflow) {
+        return 0;
+      } /* if */
+    } /* while */
+    if (mode[TABLE_MATCH_LENGTH] != MODE_RLE) {
+      putBits(&writer, fieldState[TABLE_MATCH_LENGTH], encoder[TABLE_MATCH_LENGTH].accuracyLog);
+    } /* if */
+    if (mode[TABLE_OFFSET] != MODE_RLE) {
+      putBits(&writer, fieldState[TABLE_OFFSET], encoder[TABLE_OFFSET].accuracyLog);
+    } /* if */
+    if (mode[TABLE_LITERAL_LENGTH] != MODE_RLE) {
+      putBits(&writer, fieldState[TABLE_LITERAL_LENGTH], encoder[TABLE_LITERAL_LENGTH].accuracyLog);
+    } /* if */
+    streamSize = closeBitWriter(&writer, &dest[pos]);
+    if (streamSize == 0) {
+      return 0;
+    } /* if */
+    return pos + streamSize;
+  } /* writeSequences */
+
+
+
+/**
+ *  Determine the length of the common prefix of two strings.
+ *  The comparison stops at limit.
+ */
+static inline memSizeType countMatch (const ucharType *pos, const ucharType *match,
+    const ucharType *limit)
+
+  {
+    const ucharType *start;
+    uint64Type difference;
+
+  /* countMatch */
+    start = pos;
+    while (pos + 8 <= limit) {
+      difference = readLittleEndian64(pos) ^ readLittleEndian64(match);
+      if (difference != 0) {
+        while ((difference & 0xff) == 0) {
+          difference >>= 8;
+          pos++;
+        } /* while */
+        return (memSizeType) (pos - start);
+      } /* if */
+      pos += 8;
+      match += 8;
+    } /* while */
+    while (pos < limit && *pos == *match) {
+      pos++;
+      match++;
+    } /* while */
+    return (memSizeType) (pos - start);
+  } /* countMatch */
+
+
+
+static inline uint32Type hashPosition (const_compressStateType state,
+    const ucharType *pos)
+
+  { /* hashPosition */
+    return (uint32Type) (((readLittleEndian64(pos) << (64 - 8 * state->minMatch)) *
+                          PRIME64_1) >> (64 - state->hashLog));
+  } /* hashPosition */
+
+
+
+/**
+ *  Insert the positions up to pos into the hash chains and search
+ *  the longest match for pos. The search follows the hash chain
+ *  for searchDepth candidates.
+ *  @param distance The distance of the match found.
+ *  @return the length of the match or 0 if no match was found.
+ */
+static memSizeType findMatch (compressStateType state, const ucharType *pos,
+    const ucharType *limit, memSizeType *distance)
+
+  {
+    ucharType *window;
+    uint32Type *hashTable;
+    uint32Type *chainTable;
+    uint32Type chainMask;
+    uint32Type currentIndex;
+    uint32Type index;
+    uint32Type matchIndex;
+    uint32Type lowLimit;
+    uint32Type minChain;
+    uint32Type hash;
+    const ucharType *match;
+    memSizeType bestLength;
+    memSizeType length;
+    memSizeType niceLength;
+    unsigned int attempts;
+
+  /* findMatch */
+    window = INPUT_WINDOW(state);
+    hashTable = HASH_TABLE(state);
+    chainTable = CHAIN_TABLE(state);
+    chainMask = ((uint32Type) 1 << state->chainLog) - 1;
+    currentIndex = state->base + (uint32Type) (pos - window);
+    for (index = state->nextToUpdate; index < currentIndex; index++) {
+      hash = hashPosition(state, &window[index - state->base]);
+      chainTable[index & chainMask] = hashTable[hash];
+      hashTable[hash] = index;
+    } /* for */
+    state->nextToUpdate = currentIndex;
+    if ((memSizeType) (pos - window) > state->windowSize) {
+      lowLimit = currentIndex - (uint32Type) state->windowSize;
+    } else {
+      lowLimit = state->base;
+    } /* if */
+    minChain = currentIndex > chainMask ? currentIndex - chainMask : 0;
+    niceLength = state->niceLength;
+    bestLength = state->minMatch - 1;
+    attempts = state->searchDepth;
+    matchIndex = hashTable[hashPosition(state, pos)];
+    while (matchIndex >= lowLimit && matchIndex != 0 && attempts != 0) {
+      match = &window[matchIndex - state->base];
+      /* A longer match must differ at bestLength. */
+      if (match[bestLength] == pos[bestLength]) {
+        length = countMatch(pos, match, limit);
+        if (length > bestLength) {
+          bestLength = length;
+          *distance = currentIndex - matchIndex;
+          if (length >= niceLength || &pos[length] == limit) {
+            break;
+          } /* if */
+        } /* if */
+      } /* if */
+      if (matchIndex <= minChain) {
+        break;
+      } /* if */
+      matchIndex = chainTable[matchIndex & chainMask];
+      attempts--;
+    } /* while */
+    return bestLength >= state->minMatch ? bestLength : 0;
+  } /* findMatch */
+
+
+
+/**
+ *  Determine the offset value of a sequence and update the repeat
+ *  offsets like the decoder does.
+ */
+static uint32Type encodeOffset (uint32Type *repeatOffset, uint32Type distance,
+    uint32Type literalLength)
+
+  {
+    uint32Type offsetValue;
+    unsigned int repeatIndex;
+
+  /* encodeOffset */
+    if (literalLength != 0 && distance == repeatOffset[0]) {
+      return 1;
+    } else if (distance == repeatOffset[1]) {
+      repeatIndex = 1;
+    } else if (distance == repeatOffset[2]) {
+      repeatIndex = 2;
+    } else if (literalLength == 0 && distance == repeatOffset[0] - 1) {
+      repeatIndex = 3;
+    } else {
+      repeatIndex = 4;
+    } /* if */
+    if (repeatIndex == 4) {
+      offsetValue = distance + 3;
+    } else {
+      /* Without literals the repeat offsets are shifted by 1. */
+      offsetValue = literalLength == 0 ? repeatIndex : repeatIndex + 1;
+    } /* if */
+    if (repeatIndex != 1) {
+      repeatOffset[2] = repeatOffset[1];
+    } /* if */
+    repeatOffset[1] = repeatOffset[0];
+    repeatOffset[0] = distance;
+    return offsetValue;
+  } /* encodeOffset */
+
+
+
+static void storeSequence (compressStateType state, const ucharType *literals,
+    memSizeType literalLength, memSizeType distance, memSizeType matchLength)
+
+  {
+    sequenceType *sequence;
+
+  /* storeSequence */
+    memcpy(&state->literals[state->numLiterals], literals, literalLength);
+    state->numLiterals += literalLength;
+    sequence = &state->sequences[state->numSequences++];
+    sequence->literalLength = (uint32Type) literalLength;
+    sequence->matchLength = (uint32Type) matchLength;
+    sequence->offsetValue = encodeOffset(state->repeatOffset, (uint32Type) distance,
+                                         (uint32Type) literalLength);
+  } /* storeSequence */
+
+
+
+/* Estimate of the bits for an offset. A repeated offset is cheap. */
+#define OFFSET_COST(state, distance) \
+    ((long) ((distance) == (state)->repeatOffset[0] ? 0 : highBit((uint32Type) (distance) + 3)))
+
+#define REPEAT_MATCHES(state, window, pos, distance) \
+    ((distance) <= (memSizeType) ((pos) - (window)) && (distance) <= (state)->windowSize && \
+     readLittleEndian32(pos) == readLittleEndian32((pos) - (distance)))
+
+
+
+/**
+ *  Split a block into sequences of literals and matches. Greedy
+ *  matching takes the first match found. Lazy matching checks if
+ *  the next position (or the next two positions) has a better
+ *  match. A match with the last offset is preferred.
+ */
+static void parseBlock (compressStateType state, memSizeType blockSize)
+
+  {
+    ucharType *window;
+    const ucharType *pos;
+    const ucharType *anchor;
+    const ucharType *end;
+    const ucharType *limit;
+    const ucharType *start;
+    memSizeType matchLength;
+    memSizeType distance;
+    memSizeType length2;
+    memSizeType distance2;
+    memSizeType repeat;
+    long gain1;
+    long gain2;
+    boolType searchMore;
+
+  /* parseBlock */
+    window = INPUT_WINDOW(state);
+    state->numSequences = 0;
+    state->numLiterals = 0;
+    pos = &window[state->blockStart];
+    anchor = pos;
+    end = &pos[blockSize];
+    limit = blockSize > HASH_SLACK ? end - HASH_SLACK : pos;
+    while (pos < limit) {
+      matchLength = 0;
+      distance = 0;
+      start = pos;
+      searchMore = TRUE;
+      repeat = state->repeatOffset[0];
+      if (REPEAT_MATCHES(state, window, pos + 1, repeat)) {
+        matchLength = countMatch(pos + 5, pos + 5 - repeat, end) + 4;
+        distance = repeat;
+        start = pos + 1;
+        searchMore = state->strategy != GREEDY;
+      } /* if */
+      if (searchMore) {
+        length2 = findMatch(state, pos, end, &distance2);
+        if (length2 > matchLength) {
+          matchLength = length2;
+          distance = distance2;
+          start = pos;
+        } /* if */
+        if (matchLength < 4) {
+          /* Skip faster in data without matches. */
+          pos += ((pos - anchor) >> 8) + 1;
+          continue;
+        } /* if */
+        while (state->strategy != GREEDY && pos < limit) {
+          pos++;
+          if (REPEAT_MATCHES(state, window, pos, repeat)) {
+            length2 = countMatch(pos + 4, pos + 4 - repeat, end) + 4;
+            gain2 = (long) length2 * 3;
+            gain1 = (long) matchLength * 3 - OFFSET_COST(state, distance) + 1;
+            if (gain2 > gain1) {
+              matchLength = length2;
+              distance = repeat;
+              start = pos;
+            } /* if */
+          } /* if */
+          length2 = findMatch(state, pos, end, &distance2);
+          gain2 = (long) length2 * 4 - OFFSET_COST(state, distance2);
+          gain1 = (long) matchLength * 4 - OFFSET_COST(state, distance) + 4;
+          if (length2 != 0 && gain2 > gain1) {
+            matchLength = length2;
+            distance = distance2;
+            start = pos;
+            continue;
+          } /* if */
+          if (state->strategy == LAZY2 && pos < limit) {
+            pos++;
+            if (REPEAT_MATCHES(state, window, pos, repeat)) {
+              length2 = countMatch(pos + 4, pos + 4 - repeat, end) + 4;
+              gain2 = (long) length2 * 4;
+              gain1 = (long) matchLength * 4 - OFFSET_COST(state, distance) + 1;
+              if (gain2 > gain1) {
+                matchLength = length2;
+                distance = repeat;
+                start = pos;
+              } /* if */
+            } /* if */
+            length2 = findMatch(state, pos, end, &distance2);
+            gain2 = (long) length2 * 4 - OFFSET_COST(state, distance2);
+            gain1 = (long) matchLength * 4 - OFFSET_COST(state, distance) + 7;
+            if (length2 != 0 && gain2 > gain1) {
+              matchLength = length2;
+              distance = distance2;
+              start = pos;
+              continue;
+            } /* if */
+          } /* if */
+          break;
+        } /* while */
+        /* Extend the match backward. */
+        while (start > anchor && (memSizeType) (start - window) > distance &&
+               start[-1] == start[-1 - (long) distance]) {
+          start--;
+          matchLength++;
+        } /* while */
+      } /* if */
+      storeSequence(state, anchor, (memSizeType) (start - anchor), distance, matchLength);
+      pos = start + matchLength;
+      anchor = pos;
+      /* Immediate matches with the second last offset. */
+      repeat = state->repeatOffset[1];
+      while (pos < limit && REPEAT_MATCHES(state, window, pos, repeat)) {
+        matchLength = countMatch(pos + 4, pos + 4 - repeat, end) + 4;
+        storeSequence(state, anchor, 0, repeat, matchLength);
+        pos += matchLength;
+        anchor = pos;
+        repeat = state->repeatOffset[1];
+      } /* while */
+    } /* while */
+    memcpy(&state->literals[state->numLiterals], anchor, (memSizeType) (end - anchor));
+    state->numLiterals += (memSizeType) (end - anchor);
+  } /* parseBlock */
+
+
+
+/**
+ *  Append bytes to the output.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType putOutputBytes (outputType output, const ucharType *bytes,
+    memSizeType length)
+
+  {
+    memSizeType index;
+
+  /* putOutputBytes */
+    if (unlikely(!growOutput(output, length) ||
+                 output->capacity - output->pos < length)) {
+      return FALSE;
+    } /* if */
+    for (index = 0; index < length; index++) {
+      output->stri->mem[output->pos + index] = bytes[index];
+    } /* for */
+    output->pos += length;
+    return TRUE;
+  } /* putOutputBytes */
+
+
+
+static boolType putBlockHeader (outputType output, unsigned int blockType,
+    memSizeType blockSize, boolType lastBlock)
+
+  {
+    uint32Type header;
+    ucharType bytes[3];
+
+  /* putBlockHeader */
+    header = (uint32Type) lastBlock | (uint32Type) blockType << 1 |
+             (uint32Type) blockSize << 3;
+    bytes[0] = (ucharType) (header & 0xff);
+    bytes[1] = (ucharType) ((header >> 8) & 0xff);
+    bytes[2] = (ucharType) (header >> 16);
+    return putOutputBytes(output, bytes, 3);
+  } /* putBlockHeader */
+
+
+
+/**
+ *  Compress the next blockSize bytes of the window into one block.
+ *  If the compressed block is not smaller, a raw block is written.
+ *  @return FALSE if there is not enough memory.
+ */
+static boolType compressBlock (compressStateType state, outputType output,
+    memSizeType blockSize, boolType lastBlock)
+
+  {
+    const ucharType *block;
+    memSizeType index;
+    uint32Type savedRepeatOffset[3];
+    memSizeType literalsSize;
+    memSizeType sequencesSize = 0;
+    boolType okay;
+
+  /* compressBlock */
+    block = &INPUT_WINDOW(state)[state->blockStart];
+    index = 1;
+    while (index < blockSize && block[index] == block[0]) {
+      index++;
+    } /* while */
+    if (blockSize > 1 && index == blockSize) {
+      okay = putBlockHeader(output, BLOCK_RLE, blockSize, lastBlock) &&
+             putOutputBytes(output, block, 1);
+    } else {
+      memcpy(savedRepeatOffset, state->repeatOffset, sizeof(savedRepeatOffset));
+      parseBlock(state, blockSize);
+      literalsSize = writeLiterals(state, state->blockOutput, blockSize);
+      if (literalsSize != 0) {
+        sequencesSize = writeSequences(state, &state->blockOutput[literalsSize],
+                                       blockSize - literalsSize);
+      } /* if */
+      if (literalsSize != 0 && sequencesSize != 0 &&
+          literalsSize + sequencesSize < blockSize) {
+        okay = putBlockHeader(output, BLOCK_COMPRESSED, literalsSize + sequencesSize,
+                              lastBlock) &&
+               putOutputBytes(output, state->blockOutput, literalsSize + sequencesSize);
+      } else {
+        /* The decoder does not change the offsets for a raw block. */
+        memcpy(state->repeatOffset, savedRepeatOffset, sizeof(savedRepeatOffset));
+        okay = putBlockHeader(output, BLOCK_RAW, blockSize, lastBlock) &&
+               putOutputBytes(output, block, blockSize);
+      } /* if */
+    } /* if */
+    state->blockStart += blockSize;
+    return okay;
+  } /* compressBlock */
+
+
+
+static boolType putFrameHeader (const_compressStateType state, outputType output)
+
+  {
+    ucharType header[14];
+    memSizeType length = 5;
+    uint64Type contentSize;
+    unsigned int fieldSize;
+    unsigned int index;
+
+  /* putFrameHeader */
+    header[0] = 0x28;
+    header[1] = 0xb5;
+    header[2] = 0x2f;
+    header[3] = 0xfd;
+    if (state->contentSize >= 0 &&
+        (uint64Type) state->contentSize <= (uint64Type) state->windowSize) {
+      /* Single segment: The window is the whole content. */
+      contentSize = (uint64Type) state->contentSize;
+      if (contentSize < 256) {
+        header[4] = 0x20 | 0x04;
+        fieldSize = 1;
+      } else if (contentSize < 65536 + 256) {
+        header[4] = 0x60 | 0x04;
+        fieldSize = 2;
+        contentSize -= 256;
+      } else if (contentSize <= 0xffffffff) {
+        header[4] = 0xa0 | 0x04;
+        fieldSize = 4;
+      } else {
+        header[4] = 0xe0 | 0x04;
+        fieldSize = 8;
+      } /* if */
+    } else {
+      header[length++] = (ucharType) ((state->windowLog - MIN_WINDOW_LOG) << 3);
+      if (state->contentSize < 0) {
+        header[4] = 0x04;
+        fieldSize = 0;
+        contentSize = 0;
+      } else {
+        contentSize = (uint64Type) state->contentSize;
+        if (contentSize < 65536 + 256) {
+          header[4] = 0x40 | 0x04;
+          fieldSize = 2;
+          contentSize -= 256;
+        } else if (contentSize <= 0xffffffff) {
+          header[4] = 0x80 | 0x04;
+          fieldSize = 4;
+        } else {
+          header[4] = 0xc0 | 0x04;
+          fieldSize = 8;
+        } /* if */
+      } /* if */
+    } /* if */
+    for (index = 0; index < fieldSize; index++) {
+      header[length++] = (ucharType) (contentSize & 0xff);
+      contentSize >>= 8;
+    } /* for */
+    return putOutputBytes(output, header, length);
+  } /* putFrameHeader */
+
+
+
+/**
+ *  Move the window to make room for more input. The data after
+ *  blockStart and up to windowSize bytes before it are kept.
+ *  The indices in the hash and chain tables stay valid, because
+ *  the index of the first byte (base) is increased.
+ */
+static void slideInputWindow (compressStateType state)
+
+  {
+    ucharType *window;
+    memSizeType keep;
+    memSizeType shift;
+    uint32Type reduce;
+    uint32Type *table;
+    memSizeType tableSize;
+    memSizeType index;
+
+  /* slideInputWindow */
+    window = INPUT_WINDOW(state);
+    keep = state->blockStart < state->windowSize ? state->blockStart : state->windowSize;
+    shift = state->blockStart - keep;
+    if (shift != 0) {
+      memmove(window, &window[shift], state->fill - shift);
+      state->fill -= shift;
+      state->blockStart -= shift;
+      state->base += (uint32Type) shift;
+      if (state->nextToUpdate < state->base) {
+        state->nextToUpdate = state->base;
+      } /* if */
+      if (state->base > RESCALE_LIMIT) {
+        /* Indices below base refer to data that left the window. */
+        reduce = state->base - 1;
+        table = HASH_TABLE(state);
+        tableSize = ((memSizeType) 1 << state->hashLog) +
+                    ((memSizeType) 1 << state->chainLog);
+        for (index = 0; index < tableSize; index++) {
+          table[index] = table[index] > reduce ? table[index] - reduce : 0;
+        } /* for */
+        state->base -= reduce;
+        state->nextToUpdate -= reduce;
+      } /* if */
+    } /* if */
+  } /* slideInputWindow */
+
+
+
+static boolType isCompressState (const const_bstriType state)
+
+  {
+    const_compressStateType compressState;
+
+  /* isCompressState */
+    compressState = (const_compressStateType) state->mem;
+    return state->size >= sizeof(compressStateRecord) &&
+        compressState->magic == COMPRESS_MAGIC &&
+        state->size == sizeof(compressStateRecord) +
+        sizeof(uint32Type) * (((memSizeType) 1 << compressState->hashLog) +
+                              ((memSizeType) 1 << compressState->chainLog)) +
+        compressState->bufferSize + HASH_SLACK;
+  } /* isCompressState */
+
+
+
+/**
+ *  Compress data with Zstandard (RFC 8878). The first call writes
+ *  the frame header. The data is processed in blocks of 128 KiB.
+ *  The flushMode allows to write all pending data:
+ *  - 0: No flush. Only complete blocks are written.
+ *  - 1: Flush. The pending data is written as block, such that all
+ *       data so far can be decompressed.
+ *  - 2: Finish. The last block and the content checksum are
+ *       written. Afterwards the state cannot be used any more.
+ *  @param state Compress state created with zstCompressInit.
+ *  @param uncompressed Data to be compressed (only bytes are allowed).
+ *  @param flushMode Flush mode from 0 to 2 (see above).
+ *  @return the compressed data produced by this call.
+ *  @exception RANGE_ERROR The state is not a valid compress state,
+ *             the compression is already finished, the flushMode
+ *             is not in the allowed range, uncompressed contains
+ *             a character beyond '\255;' or the data does not fit
+ *             to the content size of the state.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType zstCompress (bstriType state, const const_striType uncompressed,
+    intType flushMode)
+
+  {
+    compressStateType compressState;
+    ucharType *window;
+    memSizeType inPos = 0;
+    memSizeType count;
+    memSizeType index;
+    memSizeType blockSize;
+    outputRecord output;
+    boolType lastBlockWritten = FALSE;
+    boolType okay = TRUE;
+    ucharType trailer[4];
+    uint64Type digest;
+    striType result;
+
+  /* zstCompress */
+    logFunction(printf("zstCompress(*, \"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(uncompressed), flushMode););
+    if (unlikely(!isCompressState(state) ||
+                 ((compressStateType) state->mem)->finished ||
+                 flushMode < FLUSH_NONE || flushMode > FLUSH_FINISH)) {
+      logError(printf("zstCompress: Illegal state or flushMode (" FMT_D ").\n",
+                      flushMode););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    /* The memory of a bstring is aligned like memSizeType. */
+    compressState = (compressStateType) state->mem;
+    if (unlikely(compressState->contentSize >= 0 &&
+                 (uncompressed->size > (uint64Type) compressState->contentSize -
+                                       compressState->consumed ||
+                  (flushMode == FLUSH_FINISH &&
+                   compressState->consumed + uncompressed->size !=
+                   (uint64Type) compressState->contentSize)))) {
+      logError(printf("zstCompress: Data does not fit to the content size.\n"););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    window = INPUT_WINDOW(compressState);
+    output.limit = MAX_STRI_LEN;
+    output.capacity = uncompressed->size / 4 + 64;
+    output.pos = 0;
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(output.stri, output.capacity))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    if (!compressState->headerWritten) {
+      okay = putFrameHeader(compressState, &output);
+      compressState->headerWritten = TRUE;
+    } /* if */
+    while (okay && inPos < uncompressed->size) {
+      if (compressState->fill == compressState->bufferSize) {
+        slideInputWindow(compressState);
+      } /* if */
+      count = compressState->bufferSize - compressState->fill;
+      if (count > uncompressed->size - inPos) {
+        count = uncompressed->size - inPos;
+      } /* if */
+      for (index = 0; index < count; index++) {
+        if (unlikely(uncompressed->mem[inPos + index] > 255)) {
+          FREE_STRI(output.stri, output.capacity);
+          logError(printf("zstCompress: Character beyond '\\255;'.\n"););
+          raise_error(RANGE_ERROR);
+          return NULL;
+        } /* if */
+        window[compressState->fill + index] = (ucharType) uncompressed->mem[inPos + index];
+      } /* for */
+      xxh64Update(&compressState->checksum, &window[compressState->fill], count);
+      compressState->fill += count;
+      compressState->consumed += count;
+      inPos += count;
+      /* A full block is kept, such that the last block has data. */
+      while (okay && compressState->fill - compressState->blockStart > BLOCK_SIZE_MAX) {
+        okay = compressBlock(compressState, &output, BLOCK_SIZE_MAX, FALSE);
+      } /* while */
+    } /* while */
+    if (okay && flushMode != FLUSH_NONE) {
+      while (okay && compressState->fill != compressState->blockStart) {
+        blockSize = compressState->fill - compressState->blockStart;
+        if (blockSize > BLOCK_SIZE_MAX) {
+          blockSize = BLOCK_SIZE_MAX;
+        } /* if */
+        lastBlockWritten = flushMode == FLUSH_FINISH &&
+            compressState->blockStart + blockSize == compressState->fill;
+        okay = compressBlock(compressState, &output, blockSize, lastBlockWritten);
+      } /* while */
+      if (okay && flushMode == FLUSH_FINISH) {
+        if (!lastBlockWritten) {
+          okay = putBlockHeader(&output, BLOCK_RAW, 0, TRUE);
+        } /* if */
+        digest = xxh64Digest(&compressState->checksum);
+        for (index = 0; index < 4; index++) {
+          trailer[index] = (ucharType) (digest & 0xff);
+          digest >>= 8;
+        } /* for */
+        okay = okay && putOutputBytes(&output, trailer, 4);
+        compressState->finished = TRUE;
+      } /* if */
+    } /* if */
+    if (unlikely(!okay)) {
+      FREE_STRI(output.stri, output.capacity);
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    result = finishOutput(&output);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    logFunction(printf("zstCompress --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* zstCompress */
+
+
+
+/**
+ *  Create a state for the compression of data with Zstandard.
+ *  Level 1 is the fastest and level 19 gives the best compression.
+ *  Higher levels search more matches and use a bigger window.
+ *  If the content size is known it is written to the frame header
+ *  and the window is not larger than the content.
+ *  @param level Compression level from 1 to 19.
+ *  @param contentSize Size of the data or -1 if it is unknown.
+ *  @return the initial compress state.
+ *  @exception RANGE_ERROR The level is not in the range 1 to 19 or
+ *             the content size is less than -1.
+ *  @exception MEMORY_ERROR Not enough memory to create the state.
+ */
+bstriType zstCompressInit (intType level, intType contentSize)
+
+  {
+    compressStateType compressState;
+    unsigned int windowLog;
+    unsigned int hashLog;
+    unsigned int chainLog;
+    memSizeType windowSize;
+    memSizeType bufferSize;
+    memSizeType stateSize;
+    bstriType result;
+
+  /* zstCompressInit */
+    logFunction(printf("zstCompressInit(" FMT_D ", " FMT_D ")\n",
+                       level, contentSize););
+    if (unlikely(level < MIN_LEVEL || level > MAX_LEVEL || contentSize < -1)) {
+      logError(printf("zstCompressInit: Illegal level (" FMT_D
+                      ") or contentSize (" FMT_D ").\n", level, contentSize););
+      raise_error(RANGE_ERROR);
+      return NULL;
+    } /* if */
+    windowLog = levelConfig[level].windowLog;
+    hashLog = levelConfig[level].hashLog;
+    chainLog = levelConfig[level].chainLog;
+    if (contentSize >= 0 && contentSize < (intType) 1 << windowLog) {
+      /* A window bigger than the content is not needed. */
+      windowLog = MIN_WINDOW_LOG;
+      while ((intType) 1 << windowLog < contentSize) {
+        windowLog++;
+      } /* while */
+      if (hashLog > windowLog + 1) {
+        hashLog = windowLog + 1;
+      } /* if */
+      if (chainLog > windowLog) {
+        chainLog = windowLog;
+      } /* if */
+    } /* if */
+    windowSize = (memSizeType) 1 << windowLog;
+    bufferSize = windowSize + (windowSize > 4 * BLOCK_SIZE_MAX ?
+                               windowSize : 4 * BLOCK_SIZE_MAX);
+    if (contentSize >= 0 && (uintType) contentSize < bufferSize) {
+      bufferSize = (memSizeType) contentSize;
+    } /* if */
+    stateSize = sizeof(compressStateRecord) +
+        sizeof(uint32Type) * (((memSizeType) 1 << hashLog) + ((memSizeType) 1 << chainLog)) +
+        bufferSize + HASH_SLACK;
+    if (unlikely(stateSize > MAX_BSTRI_LEN ||
+                 !ALLOC_BSTRI_SIZE_OK(result, stateSize))) {
+      raise_error(MEMORY_ERROR);
+      return NULL;
+    } /* if */
+    if (!codeTablesBuilt) {
+      buildCodeTables();
+    } /* if */
+    result->size = stateSize;
+    compressState = (compressStateType) result->mem;
+    memset(compressState, 0, stateSize);
+    compressState->magic = COMPRESS_MAGIC;
+    compressState->windowLog = windowLog;
+    compressState->hashLog = hashLog;
+    compressState->chainLog = chainLog;
+    compressState->searchDepth = 1U << levelConfig[level].searchLog;
+    compressState->minMatch = levelConfig[level].minMatch;
+    compressState->niceLength = levelConfig[level].niceLength;
+    compressState->strategy = levelConfig[level].strategy;
+    compressState->contentSize = contentSize;
+    compressState->windowSize = windowSize;
+    compressState->bufferSize = bufferSize;
+    compressState->base = 1;
+    compressState->nextToUpdate = 1;
+    compressState->repeatOffset[0] = 1;
+    compressState->repeatOffset[1] = 4;
+    compressState->repeatOffset[2] = 8;
+    xxh64Init(&compressState->checksum);
+    return result;
+  } /* zstCompressInit */
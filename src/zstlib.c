@@ -0,0 +1,166 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/zstlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for Zstandard compression.       */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "zst_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "zstlib.h"
+
+
+
+/**
+ *  Compress uncompressed/arg_2 with Zstandard.
+ *  Depending on flushMode/arg_3 pending data is written (1: flush,
+ *  2: finish). The compress state/arg_1 is updated.
+ *  @return the compressed data produced by this call.
+ *  @exception RANGE_ERROR The state is not a valid compress state,
+ *             the compression is already finished, the flushMode
+ *             is not in the allowed range, uncompressed contains
+ *             a character beyond '\255;' or the data does not fit
+ *             to the content size of the state.
+ */
+objectType zst_compress (listType arguments)
+
+  {
+    objectType state_variable;
+
+  /* zst_compress */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_stri_temp(
+        zstCompress(take_bstri(state_variable),
+                    take_stri(arg_2(arguments)),
+                    take_int(arg_3(arguments))));
+  } /* zst_compress */
+
+
+
+/**
+ *  Create a state for the compression of data with Zstandard.
+ *  @return the initial compress state for the level/arg_1 and the
+ *          content size/arg_2 (-1 if unknown).
+ *  @exception RANGE_ERROR The level is not in the range 1 to 19 or
+ *             the content size is less than -1.
+ */
+objectType zst_compress_init (listType arguments)
+
+  { /* zst_compress_init */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_bstri_temp(zstCompressInit(take_int(arg_1(arguments)),
+                                          take_int(arg_2(arguments))));
+  } /* zst_compress_init */
+
+
+
+/**
+ *  Decompress Zstandard blocks from compressed/arg_2 starting at position/arg_3.
+ *  The decompression stops if maxLength/arg_4 characters have been
+ *  produced, if the frame is finished or if the rest of the
+ *  compressed data does not contain a complete block. The
+ *  decompress state/arg_1 and position/arg_3 are updated.
+ *  @return the decompressed data.
+ *  @exception RANGE_ERROR The state is not a valid decompress state,
+ *             maxLength is negative, position is not positive or the
+ *             compressed data is not in Zstandard format.
+ */
+objectType zst_decompress (listType arguments)
+
+  {
+    objectType state_variable;
+    objectType position_variable;
+
+  /* zst_decompress */
+    state_variable = arg_1(arguments);
+    isit_bstri(state_variable);
+    is_variable(state_variable);
+    isit_stri(arg_2(arguments));
+    position_variable = arg_3(arguments);
+    isit_int(position_variable);
+    is_variable(position_variable);
+    isit_int(arg_4(arguments));
+    return bld_stri_temp(
+        zstDecompress(take_bstri(state_variable),
+                      take_stri(arg_2(arguments)),
+                      &position_variable->value.intValue,
+                      take_int(arg_4(arguments))));
+  } /* zst_decompress */
+
+
+
+/**
+ *  Determine if a Zstandard frame has been decompressed completely.
+ *  @return TRUE if all data has been decompressed, FALSE otherwise.
+ *  @exception RANGE_ERROR The state/arg_1 is not a valid decompress state.
+ */
+objectType zst_decompress_finished (listType arguments)
+
+  { /* zst_decompress_finished */
+    isit_bstri(arg_1(arguments));
+    if (zstDecompressFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* zst_decompress_finished */
+
+
+
+/**
+ *  Create a state for the decompression of a Zstandard frame.
+ *  @return the initial decompress state for the windowSize/arg_1,
+ *          the frameContentSize/arg_2 and the checksumFlag/arg_3.
+ *  @exception RANGE_ERROR The window size is negative or too big,
+ *             or a single segment frame has no content size.
+ */
+objectType zst_decompress_init (listType arguments)
+
+  { /* zst_decompress_init */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_bool(arg_3(arguments));
+    return bld_bstri_temp(zstDecompressInit(take_int(arg_1(arguments)),
+                                            take_int(arg_2(arguments)),
+                                            take_bool(arg_3(arguments)) == SYS_TRUE_OBJECT));
+  } /* zst_decompress_init */